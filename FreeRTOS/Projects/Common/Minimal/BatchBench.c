@@ -0,0 +1,315 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Measures the cost per item of passing characters through a queue in batches
+ * of 1 to batchbenchMAX_BATCH items, as a UART driver does when it posts a
+ * line of text or empties a receive FIFO.
+ *
+ * For each batch size the batch is first sent with one call to xQueueSend()
+ * per item and received with one call to xQueueReceive() per item, then sent
+ * with one call to xQueueSendMultiple() and received with one call to
+ * xQueueReceiveMultiple().  The queue length is not a multiple of any batch
+ * size, so the batches regularly wrap around the end of the queue storage
+ * area.  Every item received is checked.  The items are sent and received by
+ * the same task so only the queue operations are timed.
+ *
+ * Finally batches three times the length of the queue are sent to a lower
+ * priority task, so the sender blocks part way through each batch and the
+ * receiver blocks whenever it empties the queue.  This is timed with single
+ * item calls on both sides, then with batch calls on both sides.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "BatchBench.h"
+
+/* The number of items passed for each measurement. */
+#define batchbenchITEMS					( 64000UL )
+
+/* The largest batch measured. */
+#define batchbenchMAX_BATCH				( 64 )
+
+/* The length of the queue, chosen so batches wrap at different offsets. */
+#define batchbenchQUEUE_LENGTH			( batchbenchMAX_BATCH + 13 )
+
+/* The batch sent to the receiving task, which does not fit in the queue. */
+#define batchbenchLARGE_BATCH			( 3 * batchbenchQUEUE_LENGTH )
+
+/* Used to select the calls used by the sending and receiving tasks. */
+#define batchbenchUSE_SINGLE			( ( void * ) 0 )
+#define batchbenchUSE_MULTIPLE			( ( void * ) 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Time batchbenchITEMS items sent and received in batches of uxBatchSize,
+ * either one item per call or one batch per call.
+ */
+static unsigned long prvTimeSingleItems( xQueueHandle xQueue, unsigned portBASE_TYPE uxBatchSize );
+static unsigned long prvTimeBatches( xQueueHandle xQueue, unsigned portBASE_TYPE uxBatchSize );
+
+/*
+ * Time batchbenchITEMS items sent in batches of batchbenchLARGE_BATCH to a
+ * receiving task that has a lower priority than the calling task.
+ */
+static unsigned long prvTimeToTask( void *pvMechanism );
+
+/*
+ * The task that receives the items when they are sent to another task.  Its
+ * parameter selects the calls used.
+ */
+static void prvBatchBenchReceiver( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static xQueueHandle xBenchQueue = NULL;
+static volatile unsigned long ulItemsReceived = 0UL;
+
+/*-----------------------------------------------------------*/
+
+void vRunBatchBenchmark( void )
+{
+xQueueHandle xQueue;
+unsigned portBASE_TYPE uxBatchSize;
+unsigned long ulSingleTime, ulBatchTime;
+
+	benchPRINTF( "Batch queue benchmark: times in %s per item\r\n", benchTIMESTAMP_UNITS );
+
+	xQueue = xQueueCreate( batchbenchQUEUE_LENGTH, sizeof( char ) );
+	configASSERT( xQueue );
+
+	for( uxBatchSize = 1; uxBatchSize <= batchbenchMAX_BATCH; uxBatchSize *= 2 )
+	{
+		ulSingleTime = prvTimeSingleItems( xQueue, uxBatchSize );
+		ulBatchTime = prvTimeBatches( xQueue, uxBatchSize );
+		benchPRINTF( "  batch of %2u: send/receive per item %6lu, send/receive multiple %6lu\r\n", ( unsigned int ) uxBatchSize, ulSingleTime, ulBatchTime );
+	}
+
+	vQueueDelete( xQueue );
+
+	ulSingleTime = prvTimeToTask( batchbenchUSE_SINGLE );
+	ulBatchTime = prvTimeToTask( batchbenchUSE_MULTIPLE );
+	benchPRINTF( "  batch of %u to a blocked task: send/receive per item %6lu, send/receive multiple %6lu\r\n", ( unsigned int ) batchbenchLARGE_BATCH, ulSingleTime, ulBatchTime );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeSingleItems( xQueueHandle xQueue, unsigned portBASE_TYPE uxBatchSize )
+{
+unsigned long ulItems, ulStart, ulElapsed;
+unsigned portBASE_TYPE uxItem;
+char cSent[ batchbenchMAX_BATCH ], cReceived[ batchbenchMAX_BATCH ];
+char cNext = 0;
+
+	ulStart = benchGET_TIMESTAMP();
+
+	for( ulItems = 0UL; ulItems < batchbenchITEMS; ulItems += uxBatchSize )
+	{
+		for( uxItem = 0; uxItem < uxBatchSize; uxItem++ )
+		{
+			cSent[ uxItem ] = cNext++;
+			( void ) xQueueSend( xQueue, &( cSent[ uxItem ] ), 0 );
+		}
+
+		for( uxItem = 0; uxItem < uxBatchSize; uxItem++ )
+		{
+			( void ) xQueueReceive( xQueue, &( cReceived[ uxItem ] ), 0 );
+			configASSERT( cReceived[ uxItem ] == cSent[ uxItem ] );
+		}
+	}
+
+	ulElapsed = benchGET_TIMESTAMP() - ulStart;
+
+	return ulElapsed / batchbenchITEMS;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeBatches( xQueueHandle xQueue, unsigned portBASE_TYPE uxBatchSize )
+{
+unsigned long ulItems, ulStart, ulElapsed;
+unsigned portBASE_TYPE uxItem, uxSent, uxReceived;
+char cSent[ batchbenchMAX_BATCH ], cReceived[ batchbenchMAX_BATCH ];
+char cNext = 0;
+
+	ulStart = benchGET_TIMESTAMP();
+
+	for( ulItems = 0UL; ulItems < batchbenchITEMS; ulItems += uxBatchSize )
+	{
+		for( uxItem = 0; uxItem < uxBatchSize; uxItem++ )
+		{
+			cSent[ uxItem ] = cNext++;
+		}
+
+		uxSent = xQueueSendMultiple( xQueue, cSent, uxBatchSize, 0 );
+		uxReceived = xQueueReceiveMultiple( xQueue, cReceived, uxBatchSize, 0 );
+		configASSERT( uxSent == uxBatchSize );
+		configASSERT( uxReceived == uxBatchSize );
+
+		for( uxItem = 0; uxItem < uxBatchSize; uxItem++ )
+		{
+			configASSERT( cReceived[ uxItem ] == cSent[ uxItem ] );
+		}
+	}
+
+	ulElapsed = benchGET_TIMESTAMP() - ulStart;
+
+	/* Nothing should be left in the queue. */
+	configASSERT( uxQueueMessagesWaiting( xQueue ) == 0 );
+
+	return ulElapsed / batchbenchITEMS;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeToTask( void *pvMechanism )
+{
+unsigned long ulItems, ulStart, ulElapsed;
+unsigned portBASE_TYPE uxItem, uxPriority;
+xTaskHandle xReceiver = NULL;
+static char cSent[ batchbenchLARGE_BATCH ];
+char cNext = 0;
+
+	xBenchQueue = xQueueCreate( batchbenchQUEUE_LENGTH, sizeof( char ) );
+	configASSERT( xBenchQueue );
+
+	/* The receiver only runs when this task blocks. */
+	uxPriority = uxTaskPriorityGet( NULL );
+	configASSERT( uxPriority > ( tskIDLE_PRIORITY + 1 ) );
+
+	ulItemsReceived = 0UL;
+	xTaskCreate( prvBatchBenchReceiver, ( signed char * ) "BBRx", configMINIMAL_STACK_SIZE, pvMechanism, uxPriority - 1, &xReceiver );
+	configASSERT( xReceiver );
+
+	ulStart = benchGET_TIMESTAMP();
+
+	for( ulItems = 0UL; ulItems < batchbenchITEMS; ulItems += batchbenchLARGE_BATCH )
+	{
+		for( uxItem = 0; uxItem < batchbenchLARGE_BATCH; uxItem++ )
+		{
+			cSent[ uxItem ] = cNext++;
+		}
+
+		if( pvMechanism == batchbenchUSE_SINGLE )
+		{
+			for( uxItem = 0; uxItem < batchbenchLARGE_BATCH; uxItem++ )
+			{
+				( void ) xQueueSend( xBenchQueue, &( cSent[ uxItem ] ), portMAX_DELAY );
+			}
+		}
+		else
+		{
+			uxItem = xQueueSendMultiple( xBenchQueue, cSent, batchbenchLARGE_BATCH, portMAX_DELAY );
+			configASSERT( uxItem == batchbenchLARGE_BATCH );
+		}
+	}
+
+	/* Wait for the receiver to empty the queue. */
+	while( ulItemsReceived < ulItems )
+	{
+		vTaskDelay( ( portTickType ) 1 );
+	}
+
+	ulElapsed = benchGET_TIMESTAMP() - ulStart;
+
+	vTaskDelete( xReceiver );
+	vQueueDelete( xBenchQueue );
+	xBenchQueue = NULL;
+
+	return ulElapsed / ulItems;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBatchBenchReceiver( void *pvParameters )
+{
+char cReceived[ batchbenchMAX_BATCH ];
+char cExpected = 0;
+unsigned portBASE_TYPE uxReceived, uxItem;
+
+	for( ;; )
+	{
+		if( pvParameters == batchbenchUSE_SINGLE )
+		{
+			uxReceived = ( unsigned portBASE_TYPE ) xQueueReceive( xBenchQueue, cReceived, portMAX_DELAY );
+		}
+		else
+		{
+			uxReceived = xQueueReceiveMultiple( xBenchQueue, cReceived, batchbenchMAX_BATCH, portMAX_DELAY );
+		}
+
+		/* The items must arrive in the order they were sent. */
+		for( uxItem = 0; uxItem < uxReceived; uxItem++ )
+		{
+			configASSERT( cReceived[ uxItem ] == cExpected );
+			cExpected++;
+		}
+
+		ulItemsReceived += uxReceived;
+	}
+}
+/*-----------------------------------------------------------*/
+
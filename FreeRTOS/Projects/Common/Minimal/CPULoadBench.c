@@ -0,0 +1,225 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Checks the processor load averages and longest run times kept by the kernel
+ * when configUSE_CPU_LOAD is set to 1, and measures the time taken to read
+ * them.
+ *
+ * A task that uses the processor for clbenchBUSY_TICKS of every
+ * clbenchPERIOD_TICKS is run for a few seconds, so its load over the 1 second
+ * window should approach the fraction of the processor it uses, and its
+ * longest run time should be about clbenchBUSY_TICKS.  The task is then
+ * suspended, so its load over the 1 second window should fall back towards
+ * zero while its load over the 60 second window still shows it was busy.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "CPULoadBench.h"
+
+#if ( configUSE_CPU_LOAD == 1 )
+
+/* The busy task uses the processor for clbenchBUSY_TICKS ticks of every
+clbenchPERIOD_TICKS ticks, which is a load of 300 tenths of a percent. */
+#define clbenchBUSY_TICKS			( ( portTickType ) 30 * configTICK_RATE_HZ / ( portTickType ) 1000 )
+#define clbenchPERIOD_TICKS			( ( portTickType ) 100 * configTICK_RATE_HZ / ( portTickType ) 1000 )
+#define clbenchEXPECTED_LOAD		( 300U )
+
+/* How long the busy task runs, then how long it is suspended, before the
+loads are read. */
+#define clbenchBUSY_TIME			( ( portTickType ) 3000 * configTICK_RATE_HZ / ( portTickType ) 1000 )
+#define clbenchIDLE_TIME			( ( portTickType ) 3000 * configTICK_RATE_HZ / ( portTickType ) 1000 )
+
+/* The 1 second load must be within this many tenths of a percent of the
+expected load after the busy task has run for clbenchBUSY_TIME.  Anything else
+running on the host can move it. */
+#define clbenchLOAD_TOLERANCE		( 100U )
+
+/* The number of times uxTaskGetSystemState() is timed. */
+#define clbenchREADS				( 100UL )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Reads the state of every task, timing the read, then reports the state of
+ * xBusyTask and copies it to *pxStatus.
+ */
+static void prvReadBusyTask( const char *pcWhen, xTaskStatusType *pxStatus );
+
+/*
+ * The task that uses a fixed share of the processor.
+ */
+static void prvBusyTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static xTaskHandle xBusyTask = NULL;
+
+/*-----------------------------------------------------------*/
+
+void vRunCPULoadBenchmark( void )
+{
+xTaskStatusType xStatus;
+
+	benchPRINTF( "CPU load benchmark: loads in tenths of a percent over 1s, 10s and 60s, longest run in run time counts\r\n" );
+
+	xTaskCreate( prvBusyTask, ( signed char * ) "CLBusy", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xBusyTask );
+	configASSERT( xBusyTask );
+
+	vTaskDelay( clbenchBUSY_TIME );
+	prvReadBusyTask( "while busy", &xStatus );
+
+	configASSERT( xStatus.usCPULoad[ 0 ] > ( clbenchEXPECTED_LOAD - clbenchLOAD_TOLERANCE ) );
+	configASSERT( xStatus.usCPULoad[ 0 ] < ( clbenchEXPECTED_LOAD + clbenchLOAD_TOLERANCE ) );
+
+	/* The shorter windows respond faster. */
+	configASSERT( xStatus.usCPULoad[ 0 ] > xStatus.usCPULoad[ 1 ] );
+	configASSERT( xStatus.usCPULoad[ 1 ] > xStatus.usCPULoad[ 2 ] );
+
+	vTaskSuspend( xBusyTask );
+	vTaskDelay( clbenchIDLE_TIME );
+	prvReadBusyTask( "after idle", &xStatus );
+
+	/* The task no longer uses the processor now, but did recently. */
+	configASSERT( xStatus.usCPULoad[ 0 ] < xStatus.usCPULoad[ 2 ] );
+
+	vTaskDelete( xBusyTask );
+	xBusyTask = NULL;
+
+	/* Let the idle task free the deleted task. */
+	vTaskDelay( 2 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReadBusyTask( const char *pcWhen, xTaskStatusType *pxStatus )
+{
+xTaskStatusType *pxStatusArray;
+unsigned portBASE_TYPE uxArraySize, uxTasks = 0U, x;
+unsigned long ulRead, ulStart, ulElapsed = 0UL;
+portBASE_TYPE xFound = pdFALSE;
+
+	uxArraySize = uxTaskGetNumberOfTasks();
+	pxStatusArray = pvPortMalloc( uxArraySize * sizeof( xTaskStatusType ) );
+	configASSERT( pxStatusArray );
+
+	for( ulRead = 0UL; ulRead < clbenchREADS; ulRead++ )
+	{
+		ulStart = benchGET_TIMESTAMP();
+		uxTasks = uxTaskGetSystemState( pxStatusArray, uxArraySize, NULL );
+		ulElapsed += benchGET_TIMESTAMP() - ulStart;
+	}
+
+	for( x = 0U; x < uxTasks; x++ )
+	{
+		if( pxStatusArray[ x ].xHandle == xBusyTask )
+		{
+			*pxStatus = pxStatusArray[ x ];
+			xFound = pdTRUE;
+		}
+	}
+
+	configASSERT( xFound == pdTRUE );
+	( void ) xFound;
+
+	benchPRINTF( "  %-10s load %4u %4u %4u, longest run %8lu, %u tasks read in %lu %s\r\n", pcWhen, ( unsigned ) pxStatus->usCPULoad[ 0 ], ( unsigned ) pxStatus->usCPULoad[ 1 ], ( unsigned ) pxStatus->usCPULoad[ 2 ], pxStatus->ulLongestRunTime, ( unsigned ) uxTasks, ulElapsed / clbenchREADS, benchTIMESTAMP_UNITS );
+
+	vPortFree( pxStatusArray );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBusyTask( void *pvParameters )
+{
+portTickType xLastWakeTime, xStart;
+
+	( void ) pvParameters;
+
+	xLastWakeTime = xTaskGetTickCount();
+
+	for( ;; )
+	{
+		xStart = xTaskGetTickCount();
+		while( ( xTaskGetTickCount() - xStart ) < clbenchBUSY_TICKS )
+		{
+			/* Use the processor. */
+		}
+
+		vTaskDelayUntil( &xLastWakeTime, clbenchPERIOD_TICKS );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#else /* configUSE_CPU_LOAD */
+
+void vRunCPULoadBenchmark( void )
+{
+	benchPRINTF( "CPU load benchmark: configUSE_CPU_LOAD is 0\r\n" );
+}
+
+#endif /* configUSE_CPU_LOAD */
+
@@ -0,0 +1,403 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Compares a mutex that uses priority inheritance with one that uses the
+ * immediate priority ceiling protocol, in a case priority inheritance does
+ * not bound, then measures the cost of taking and giving each type of mutex.
+ *
+ * Four tasks are used.  The low priority task takes the first mutex and uses
+ * the processor for cmbenchLOW_TICKS.  While it does so the medium task takes
+ * the second mutex then waits for the first, and the high task waits for the
+ * second.  Priority inheritance raises the medium task to the priority of the
+ * high task, but the low task is only raised to the priority of the medium
+ * task, so the hog task, which has a priority between the medium and high
+ * tasks and takes neither mutex, delays the high task for as long as it runs.
+ * With ceiling mutexes the low task runs at the ceiling while it holds the
+ * first mutex, the medium task cannot run to take the second, and the high
+ * task takes the second mutex as soon as it is released.
+ *
+ * configMAX_PRIORITIES must be at least 5, as the task that runs the
+ * benchmark must have a priority above the four tasks.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "CeilingMutexBench.h"
+
+#if ( configUSE_CEILING_MUTEXES == 1 )
+
+/* The priorities of the tasks.  The ceiling of both ceiling mutexes is the
+priority of the high task, which is the highest priority of the tasks that
+take them. */
+#define cmbenchLOW_PRIORITY			( tskIDLE_PRIORITY )
+#define cmbenchMEDIUM_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define cmbenchHOG_PRIORITY			( tskIDLE_PRIORITY + 2 )
+#define cmbenchHIGH_PRIORITY		( tskIDLE_PRIORITY + 3 )
+
+/* How long the low task holds the first mutex, and how long the hog task
+uses the processor. */
+#define cmbenchLOW_TICKS			( ( portTickType ) 20 * configTICK_RATE_HZ / ( portTickType ) 1000 )
+#define cmbenchHOG_TICKS			( ( portTickType ) 40 * configTICK_RATE_HZ / ( portTickType ) 1000 )
+
+/* The time allowed between readying each task and the next, so each task
+that can run reaches the point at which it holds or waits for a mutex. */
+#define cmbenchSTEP_TICKS			( ( portTickType ) 2 )
+
+/* The time allowed for all four tasks to complete. */
+#define cmbenchDONE_TICKS			( ( portTickType ) 1000 * configTICK_RATE_HZ / ( portTickType ) 1000 )
+
+/* The number of uncontended takes and gives timed for each type of mutex. */
+#define cmbenchTAKES				( 10000UL )
+
+/* The index of each task into xStartSemaphores[]. */
+#define cmbenchLOW					( 0U )
+#define cmbenchMEDIUM				( 1U )
+#define cmbenchHIGH					( 2U )
+#define cmbenchHOG					( 3U )
+#define cmbenchTASKS				( 4U )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs the four tasks once using xFirst and xSecond as the two mutexes, and
+ * reports how long the high task was blocked.
+ */
+static void prvRunScenario( const char *pcType, xSemaphoreHandle xFirst, xSemaphoreHandle xSecond );
+
+/*
+ * Returns the average time taken to take and give xMutex when no other task
+ * holds it.
+ */
+static unsigned long prvTimeTakeAndGive( xSemaphoreHandle xMutex );
+
+/*
+ * Uses the processor for xTicks ticks.
+ */
+static void prvUseProcessor( portTickType xTicks );
+
+/*
+ * The four tasks.  Each task runs once each time its start semaphore is
+ * given, then reports to xDoneQueue.
+ */
+static void prvLowTask( void *pvParameters );
+static void prvMediumTask( void *pvParameters );
+static void prvHighTask( void *pvParameters );
+static void prvHogTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static xTaskHandle xLowTask = NULL, xMediumTask = NULL, xHighTask = NULL, xHogTask = NULL;
+static xQueueHandle xDoneQueue = NULL;
+static xSemaphoreHandle xStartSemaphores[ cmbenchTASKS ] = { NULL };
+static xSemaphoreHandle xFirstMutex = NULL, xSecondMutex = NULL;
+
+/* The time at which the high task was readied, and the time it then took to
+obtain the second mutex, as timestamps and in ticks. */
+static unsigned long ulHighReadied = 0UL, ulHighBlocked = 0UL;
+static portTickType xHighReadied = 0, xHighBlocked = 0;
+
+/*-----------------------------------------------------------*/
+
+void vRunCeilingMutexBenchmark( void )
+{
+xSemaphoreHandle xFirst, xSecond;
+unsigned portBASE_TYPE uxOriginalPriority, uxTask;
+
+	benchPRINTF( "Ceiling mutex benchmark: times in %s, mutex statistics in %s\r\n", benchTIMESTAMP_UNITS, ( configGENERATE_RUN_TIME_STATS == 1 ) ? "run time counts" : "ticks" );
+
+	configASSERT( uxTaskPriorityGet( NULL ) > cmbenchHIGH_PRIORITY );
+
+	xDoneQueue = xQueueCreate( cmbenchTASKS, sizeof( unsigned char ) );
+	configASSERT( xDoneQueue );
+
+	for( uxTask = 0U; uxTask < cmbenchTASKS; uxTask++ )
+	{
+		xStartSemaphores[ uxTask ] = xSemaphoreCreateCounting( 1, 0 );
+		configASSERT( xStartSemaphores[ uxTask ] );
+	}
+
+	xTaskCreate( prvLowTask, ( signed char * ) "CMLow", configMINIMAL_STACK_SIZE, NULL, cmbenchLOW_PRIORITY, &xLowTask );
+	xTaskCreate( prvMediumTask, ( signed char * ) "CMMed", configMINIMAL_STACK_SIZE, NULL, cmbenchMEDIUM_PRIORITY, &xMediumTask );
+	xTaskCreate( prvHighTask, ( signed char * ) "CMHigh", configMINIMAL_STACK_SIZE, NULL, cmbenchHIGH_PRIORITY, &xHighTask );
+	xTaskCreate( prvHogTask, ( signed char * ) "CMHog", configMINIMAL_STACK_SIZE, NULL, cmbenchHOG_PRIORITY, &xHogTask );
+	configASSERT( xLowTask && xMediumTask && xHighTask && xHogTask );
+
+	xFirst = xSemaphoreCreateMutex();
+	xSecond = xSemaphoreCreateMutex();
+	configASSERT( xFirst && xSecond );
+	prvRunScenario( "inheritance", xFirst, xSecond );
+	vSemaphoreDelete( xFirst );
+	vSemaphoreDelete( xSecond );
+
+	xFirst = xSemaphoreCreateCeilingMutex( cmbenchHIGH_PRIORITY );
+	xSecond = xSemaphoreCreateCeilingMutex( cmbenchHIGH_PRIORITY );
+	configASSERT( xFirst && xSecond );
+	prvRunScenario( "ceiling", xFirst, xSecond );
+
+	/* The high task cannot be delayed by the hog task, which takes neither
+	mutex. */
+	configASSERT( xHighBlocked < cmbenchHOG_TICKS );
+
+	vSemaphoreDelete( xFirst );
+	vSemaphoreDelete( xSecond );
+
+	/* Time the mutexes from below the ceiling, so a ceiling mutex raises and
+	lowers the priority of this task each time it is taken and given. */
+	uxOriginalPriority = uxTaskPriorityGet( NULL );
+	vTaskPrioritySet( NULL, tskIDLE_PRIORITY + 1 );
+
+	xFirst = xSemaphoreCreateMutex();
+	xSecond = xSemaphoreCreateCeilingMutex( configMAX_PRIORITIES - 1 );
+	configASSERT( xFirst && xSecond );
+
+	benchPRINTF( "  take and give, inheritance mutex: %8lu\r\n", prvTimeTakeAndGive( xFirst ) );
+	benchPRINTF( "  take and give, ceiling mutex:     %8lu\r\n", prvTimeTakeAndGive( xSecond ) );
+
+	configASSERT( uxTaskPriorityGet( NULL ) == ( tskIDLE_PRIORITY + 1 ) );
+	vTaskPrioritySet( NULL, uxOriginalPriority );
+
+	vSemaphoreDelete( xFirst );
+	vSemaphoreDelete( xSecond );
+
+	vTaskDelete( xLowTask );
+	vTaskDelete( xMediumTask );
+	vTaskDelete( xHighTask );
+	vTaskDelete( xHogTask );
+	xLowTask = xMediumTask = xHighTask = xHogTask = NULL;
+
+	for( uxTask = 0U; uxTask < cmbenchTASKS; uxTask++ )
+	{
+		vSemaphoreDelete( xStartSemaphores[ uxTask ] );
+		xStartSemaphores[ uxTask ] = NULL;
+	}
+
+	vQueueDelete( xDoneQueue );
+	xDoneQueue = NULL;
+
+	/* Let the idle task free the deleted tasks. */
+	vTaskDelay( 2 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunScenario( const char *pcType, xSemaphoreHandle xFirst, xSemaphoreHandle xSecond )
+{
+xMutexStatsType xFirstStats, xSecondStats;
+unsigned portBASE_TYPE uxTask;
+unsigned char ucTask;
+
+	xFirstMutex = xFirst;
+	xSecondMutex = xSecond;
+
+	/* The low task takes the first mutex, then the medium task takes the
+	second mutex, if it can run, and waits for the first. */
+	( void ) xSemaphoreGive( xStartSemaphores[ cmbenchLOW ] );
+	vTaskDelay( cmbenchSTEP_TICKS );
+	( void ) xSemaphoreGive( xStartSemaphores[ cmbenchMEDIUM ] );
+	vTaskDelay( cmbenchSTEP_TICKS );
+
+	/* The high task waits for the second mutex if the medium task holds it. */
+	xHighReadied = xTaskGetTickCount();
+	ulHighReadied = benchGET_TIMESTAMP();
+	( void ) xSemaphoreGive( xStartSemaphores[ cmbenchHIGH ] );
+	vTaskDelay( cmbenchSTEP_TICKS );
+
+	( void ) xSemaphoreGive( xStartSemaphores[ cmbenchHOG ] );
+
+	for( uxTask = 0U; uxTask < cmbenchTASKS; uxTask++ )
+	{
+		if( xQueueReceive( xDoneQueue, &ucTask, cmbenchDONE_TICKS ) != pdPASS )
+		{
+			configASSERT( pdFALSE );
+		}
+	}
+
+	vSemaphoreGetMutexStats( xFirst, &xFirstStats, pdTRUE );
+	vSemaphoreGetMutexStats( xSecond, &xSecondStats, pdTRUE );
+
+	benchPRINTF( "  %-11s high task blocked %10lu, first mutex held %8lu, second mutex waited for %8lu\r\n", pcType, ulHighBlocked, xFirstStats.ulMaxHoldTime, xSecondStats.ulMaxWaitTime );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeTakeAndGive( xSemaphoreHandle xMutex )
+{
+unsigned long ulTake, ulStart;
+
+	ulStart = benchGET_TIMESTAMP();
+
+	for( ulTake = 0UL; ulTake < cmbenchTAKES; ulTake++ )
+	{
+		( void ) xSemaphoreTake( xMutex, 0 );
+		( void ) xSemaphoreGive( xMutex );
+	}
+
+	return ( benchGET_TIMESTAMP() - ulStart ) / cmbenchTAKES;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUseProcessor( portTickType xTicks )
+{
+portTickType xStart;
+
+	xStart = xTaskGetTickCount();
+
+	while( ( xTaskGetTickCount() - xStart ) < xTicks )
+	{
+		/* Use the processor. */
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvLowTask( void *pvParameters )
+{
+unsigned char ucTask = ( unsigned char ) cmbenchLOW;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) xSemaphoreTake( xStartSemaphores[ ucTask ], portMAX_DELAY );
+
+		( void ) xSemaphoreTake( xFirstMutex, portMAX_DELAY );
+		prvUseProcessor( cmbenchLOW_TICKS );
+		( void ) xSemaphoreGive( xFirstMutex );
+
+		( void ) xQueueSend( xDoneQueue, &ucTask, portMAX_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMediumTask( void *pvParameters )
+{
+unsigned char ucTask = ( unsigned char ) cmbenchMEDIUM;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) xSemaphoreTake( xStartSemaphores[ ucTask ], portMAX_DELAY );
+
+		/* The mutexes are given in the reverse of the order they are taken,
+		as ceiling mutexes must be. */
+		( void ) xSemaphoreTake( xSecondMutex, portMAX_DELAY );
+		( void ) xSemaphoreTake( xFirstMutex, portMAX_DELAY );
+		( void ) xSemaphoreGive( xFirstMutex );
+		( void ) xSemaphoreGive( xSecondMutex );
+
+		( void ) xQueueSend( xDoneQueue, &ucTask, portMAX_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvHighTask( void *pvParameters )
+{
+unsigned char ucTask = ( unsigned char ) cmbenchHIGH;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) xSemaphoreTake( xStartSemaphores[ ucTask ], portMAX_DELAY );
+
+		( void ) xSemaphoreTake( xSecondMutex, portMAX_DELAY );
+		ulHighBlocked = benchGET_TIMESTAMP() - ulHighReadied;
+		xHighBlocked = xTaskGetTickCount() - xHighReadied;
+		( void ) xSemaphoreGive( xSecondMutex );
+
+		( void ) xQueueSend( xDoneQueue, &ucTask, portMAX_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvHogTask( void *pvParameters )
+{
+unsigned char ucTask = ( unsigned char ) cmbenchHOG;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) xSemaphoreTake( xStartSemaphores[ ucTask ], portMAX_DELAY );
+
+		prvUseProcessor( cmbenchHOG_TICKS );
+
+		( void ) xQueueSend( xDoneQueue, &ucTask, portMAX_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#else /* configUSE_CEILING_MUTEXES */
+
+void vRunCeilingMutexBenchmark( void )
+{
+	benchPRINTF( "Ceiling mutex benchmark: configUSE_CEILING_MUTEXES is 0\r\n" );
+}
+
+#endif /* configUSE_CEILING_MUTEXES */
@@ -0,0 +1,147 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Measures the cost of a critical section, and of the queue send and receive
+ * functions that each use one, with whichever critical section implementation
+ * the port was built with.  Build with portCRITICAL_NESTING_IN_TCB set to 1
+ * and to 0 to compare the kernel's out of line functions, which hold the
+ * nesting depth in the TCB of the running task, with the port's inlined
+ * macros.
+ *
+ * The queue is never full when it is written and never empty when it is read,
+ * so neither call blocks and no other task is involved.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "CriticalBench.h"
+
+/* The number of items sent to, then received from, the queue in each
+batch. */
+#define cbenchQUEUE_LENGTH			( 100UL )
+
+/* The number of batches timed. */
+#define cbenchBATCHES				( 100UL )
+
+/* The number of empty critical sections timed. */
+#define cbenchCRITICAL_SECTIONS		( cbenchQUEUE_LENGTH * cbenchBATCHES )
+
+/*-----------------------------------------------------------*/
+
+void vRunCriticalBenchmark( void )
+{
+xQueueHandle xQueue;
+unsigned long ulBatch, ulItem, ulStart, ulCritical, ulSend = 0UL, ulReceive = 0UL;
+
+	benchPRINTF( "Critical section benchmark: %s, times in %s\r\n", ( portCRITICAL_NESTING_IN_TCB == 1 ) ? "kernel functions with nesting in the TCB" : "inlined with nesting in the port", benchTIMESTAMP_UNITS );
+
+	xQueue = xQueueCreate( cbenchQUEUE_LENGTH, sizeof( unsigned long ) );
+	configASSERT( xQueue );
+
+	ulStart = benchGET_TIMESTAMP();
+
+	for( ulItem = 0UL; ulItem < cbenchCRITICAL_SECTIONS; ulItem++ )
+	{
+		taskENTER_CRITICAL();
+		taskEXIT_CRITICAL();
+	}
+
+	ulCritical = benchGET_TIMESTAMP() - ulStart;
+
+	for( ulBatch = 0UL; ulBatch < cbenchBATCHES; ulBatch++ )
+	{
+		ulStart = benchGET_TIMESTAMP();
+
+		for( ulItem = 0UL; ulItem < cbenchQUEUE_LENGTH; ulItem++ )
+		{
+			( void ) xQueueSend( xQueue, &ulItem, 0 );
+		}
+
+		ulSend += benchGET_TIMESTAMP() - ulStart;
+		ulStart = benchGET_TIMESTAMP();
+
+		for( ulItem = 0UL; ulItem < cbenchQUEUE_LENGTH; ulItem++ )
+		{
+			( void ) xQueueReceive( xQueue, &ulItem, 0 );
+		}
+
+		ulReceive += benchGET_TIMESTAMP() - ulStart;
+
+		/* Every item sent was received. */
+		configASSERT( uxQueueMessagesWaiting( xQueue ) == 0 );
+	}
+
+	benchPRINTF( "  enter and exit critical section: %6lu\r\n", ulCritical / cbenchCRITICAL_SECTIONS );
+	benchPRINTF( "  xQueueSend():                    %6lu\r\n", ulSend / ( cbenchQUEUE_LENGTH * cbenchBATCHES ) );
+	benchPRINTF( "  xQueueReceive():                 %6lu\r\n", ulReceive / ( cbenchQUEUE_LENGTH * cbenchBATCHES ) );
+
+	vQueueDelete( xQueue );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,344 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Measures the deferred calls of deferred.c, which move the processing of an
+ * interrupt into a task, as the UART interrupt of rd9 uses them.  A simulated
+ * interrupt is raised by the benchmark task, and pends calls from within the
+ * interrupt handler:
+ *
+ * + Latency: each interrupt pends a call to tier 1, then a call to tier 0, then
+ *   a call to the RTOS daemon task using xTimerPendFunctionCallFromISR().  The
+ *   time from each call being pended to it executing is compared between the
+ *   two tiers and the daemon task.  The tier 0 call must execute before the
+ *   tier 1 call pended before it.
+ * + Burst: a single interrupt pends more calls to tier 1 than its ring holds.
+ *   The calls that fit must execute in order, and the rest must be counted as
+ *   dropped.
+ * + Task: the benchmark task pends calls using xDeferredCallPend().
+ *
+ * The calls pended to each tier carry a sequence number, which the called
+ * function checks to make sure no call is lost, repeated or reordered.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "deferred.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "DeferredCallBench.h"
+
+#if ( configUSE_DEFERRED_CALLS == 1 )
+
+/* The simulated interrupt used by the benchmark. */
+#define dcbenchINTERRUPT				( 3UL )
+
+/* The number of interrupts raised to measure the latency. */
+#define dcbenchLATENCY_INTERRUPTS		( 500UL )
+
+/* The number of calls a single interrupt pends in the burst, which overflows
+the ring of tier 1. */
+#define dcbenchBURST_CALLS				( ( unsigned long ) configDEFERRED_CALL_QUEUE_LENGTH + 4UL )
+
+/* The number of calls pended by the benchmark task. */
+#define dcbenchTASK_CALLS				( 200UL )
+
+/* What the interrupt handler pends when it is next raised. */
+#define dcbenchMODE_LATENCY				( 0 )
+#define dcbenchMODE_BURST				( 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The simulated interrupt handler, which pends calls as set by xMode.
+ */
+static portBASE_TYPE prvDeferringISR( void );
+
+/*
+ * The functions pended to each tier, and to the daemon task.  ulParameter2 is
+ * the sequence number of the call, or the time at which the call was pended
+ * to the daemon task.
+ */
+static void prvTier0Call( void *pvParameter1, unsigned long ulParameter2 );
+static void prvTier1Call( void *pvParameter1, unsigned long ulParameter2 );
+static void prvDaemonCall( void *pvParameter1, unsigned long ulParameter2 );
+
+/*
+ * Print the statistics of a tier, after the calls pended to it have executed,
+ * and reset them.
+ */
+static void prvReportTier( const char *pcName, unsigned portBASE_TYPE uxTier, xDeferredCallStats *pxStats );
+
+/*-----------------------------------------------------------*/
+
+static volatile portBASE_TYPE xMode = dcbenchMODE_LATENCY;
+
+/* The sequence numbers of the next call pended to, and expected by, each
+tier. */
+static volatile unsigned long ulNextPended[ configDEFERRED_CALL_TIERS ], ulNextExpected[ configDEFERRED_CALL_TIERS ];
+static volatile unsigned long ulOutOfOrder, ulTierInversions, ulPendFailures;
+
+/* The latency of the calls pended to the daemon task. */
+static volatile unsigned long ulDaemonCalls, ulDaemonTotalLatency, ulDaemonMaxLatency;
+
+/*-----------------------------------------------------------*/
+
+void vRunDeferredCallBenchmark( void )
+{
+xDeferredCallStats xStats;
+unsigned long ulInterrupt, ulCall;
+unsigned portBASE_TYPE uxTier;
+
+	benchPRINTF( "Deferred call benchmark: times in us\r\n" );
+
+	vPortSetInterruptHandler( dcbenchINTERRUPT, prvDeferringISR );
+
+	for( uxTier = 0; uxTier < ( unsigned portBASE_TYPE ) configDEFERRED_CALL_TIERS; uxTier++ )
+	{
+		ulNextPended[ uxTier ] = 0UL;
+		ulNextExpected[ uxTier ] = 0UL;
+		vDeferredCallGetStats( uxTier, &xStats, pdTRUE );
+	}
+	ulOutOfOrder = 0UL;
+	ulTierInversions = 0UL;
+	ulPendFailures = 0UL;
+	ulDaemonCalls = 0UL;
+	ulDaemonTotalLatency = 0UL;
+	ulDaemonMaxLatency = 0UL;
+
+	/* Latency.  The calls pended by each interrupt execute while the
+	benchmark task is delayed. */
+	xMode = dcbenchMODE_LATENCY;
+	for( ulInterrupt = 0UL; ulInterrupt < dcbenchLATENCY_INTERRUPTS; ulInterrupt++ )
+	{
+		vPortGenerateSimulatedInterrupt( dcbenchINTERRUPT );
+		vTaskDelay( ( portTickType ) 1 );
+	}
+	vTaskDelay( ( portTickType ) 10 / portTICK_RATE_MS );
+
+	prvReportTier( "latency, tier 0:", 0, &xStats );
+	configASSERT( xStats.ulCalls == dcbenchLATENCY_INTERRUPTS );
+	prvReportTier( "latency, tier 1:", 1, &xStats );
+	configASSERT( xStats.ulCalls == dcbenchLATENCY_INTERRUPTS );
+	benchPRINTF( "  latency, daemon: calls %4lu latency avg %4lu max %5lu\r\n", ulDaemonCalls, ulDaemonTotalLatency / ulDaemonCalls, ulDaemonMaxLatency );
+	configASSERT( ulDaemonCalls == dcbenchLATENCY_INTERRUPTS );
+
+	/* Burst.  Every slot of the ring of tier 1 is filled before the worker
+	can run. */
+	xMode = dcbenchMODE_BURST;
+	vPortGenerateSimulatedInterrupt( dcbenchINTERRUPT );
+	vTaskDelay( ( portTickType ) 10 / portTICK_RATE_MS );
+
+	prvReportTier( "burst, tier 1:  ", 1, &xStats );
+	configASSERT( xStats.ulCalls == ( unsigned long ) configDEFERRED_CALL_QUEUE_LENGTH );
+	configASSERT( xStats.ulDropped == ( dcbenchBURST_CALLS - ( unsigned long ) configDEFERRED_CALL_QUEUE_LENGTH ) );
+	configASSERT( xStats.ulMaxWaiting == ( unsigned long ) configDEFERRED_CALL_QUEUE_LENGTH );
+	configASSERT( ulPendFailures == xStats.ulDropped );
+	ulPendFailures = 0UL;
+
+	/* Task.  The worker runs at the priority of the benchmark task, so the
+	calls execute when the benchmark task yields. */
+	for( ulCall = 0UL; ulCall < dcbenchTASK_CALLS; ulCall++ )
+	{
+		if( xDeferredCallPend( 0, prvTier0Call, NULL, ulNextPended[ 0 ] ) == pdPASS )
+		{
+			ulNextPended[ 0 ]++;
+		}
+		else
+		{
+			ulPendFailures++;
+		}
+
+		taskYIELD();
+	}
+	vTaskDelay( ( portTickType ) 10 / portTICK_RATE_MS );
+
+	prvReportTier( "task, tier 0:   ", 0, &xStats );
+	configASSERT( xStats.ulCalls == dcbenchTASK_CALLS );
+
+	benchPRINTF( "  out of order %lu, tier inversions %lu, failed task pends %lu\r\n", ulOutOfOrder, ulTierInversions, ulPendFailures );
+	configASSERT( ulOutOfOrder == 0UL );
+	configASSERT( ulTierInversions == 0UL );
+	configASSERT( ulPendFailures == 0UL );
+
+	vPortSetInterruptHandler( dcbenchINTERRUPT, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvDeferringISR( void )
+{
+signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+unsigned long ulCall;
+
+	if( xMode == dcbenchMODE_LATENCY )
+	{
+		/* Tier 1 is pended first, but tier 0 runs at the higher priority. */
+		if( xDeferredCallPendFromISR( 1, prvTier1Call, NULL, ulNextPended[ 1 ], &xHigherPriorityTaskWoken ) == pdPASS )
+		{
+			ulNextPended[ 1 ]++;
+		}
+
+		if( xDeferredCallPendFromISR( 0, prvTier0Call, NULL, ulNextPended[ 0 ], &xHigherPriorityTaskWoken ) == pdPASS )
+		{
+			ulNextPended[ 0 ]++;
+		}
+
+		( void ) xTimerPendFunctionCallFromISR( prvDaemonCall, NULL, ( unsigned long ) portGET_RUN_TIME_COUNTER_VALUE(), &xHigherPriorityTaskWoken );
+	}
+	else
+	{
+		for( ulCall = 0UL; ulCall < dcbenchBURST_CALLS; ulCall++ )
+		{
+			if( xDeferredCallPendFromISR( 1, prvTier1Call, NULL, ulNextPended[ 1 ], &xHigherPriorityTaskWoken ) == pdPASS )
+			{
+				ulNextPended[ 1 ]++;
+			}
+			else
+			{
+				ulPendFailures++;
+			}
+		}
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTier0Call( void *pvParameter1, unsigned long ulParameter2 )
+{
+	( void ) pvParameter1;
+
+	if( ulParameter2 != ulNextExpected[ 0 ] )
+	{
+		ulOutOfOrder++;
+	}
+	ulNextExpected[ 0 ] = ulParameter2 + 1UL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTier1Call( void *pvParameter1, unsigned long ulParameter2 )
+{
+	( void ) pvParameter1;
+
+	if( ulParameter2 != ulNextExpected[ 1 ] )
+	{
+		ulOutOfOrder++;
+	}
+	ulNextExpected[ 1 ] = ulParameter2 + 1UL;
+
+	/* In the latency measurement each interrupt pends one call to each tier,
+	and the tier 0 call must already have executed. */
+	if( ( xMode == dcbenchMODE_LATENCY ) && ( ulNextExpected[ 0 ] < ulNextExpected[ 1 ] ) )
+	{
+		ulTierInversions++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvDaemonCall( void *pvParameter1, unsigned long ulParameter2 )
+{
+unsigned long ulLatency;
+
+	( void ) pvParameter1;
+
+	ulLatency = ( unsigned long ) portGET_RUN_TIME_COUNTER_VALUE() - ulParameter2;
+	ulDaemonTotalLatency += ulLatency;
+
+	if( ulLatency > ulDaemonMaxLatency )
+	{
+		ulDaemonMaxLatency = ulLatency;
+	}
+
+	ulDaemonCalls++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReportTier( const char *pcName, unsigned portBASE_TYPE uxTier, xDeferredCallStats *pxStats )
+{
+	vDeferredCallGetStats( uxTier, pxStats, pdTRUE );
+
+	benchPRINTF( "  %s calls %4lu latency avg %4lu max %5lu  execution avg %lu max %lu  waiting max %lu  dropped %lu\r\n",
+				 pcName,
+				 pxStats->ulCalls,
+				 ( pxStats->ulCalls != 0UL ) ? ( pxStats->ulTotalLatency / pxStats->ulCalls ) : 0UL,
+				 pxStats->ulMaxLatency,
+				 ( pxStats->ulCalls != 0UL ) ? ( pxStats->ulTotalExecution / pxStats->ulCalls ) : 0UL,
+				 pxStats->ulMaxExecution,
+				 pxStats->ulMaxWaiting,
+				 pxStats->ulDropped );
+}
+/*-----------------------------------------------------------*/
+
+#else /* configUSE_DEFERRED_CALLS */
+
+void vRunDeferredCallBenchmark( void )
+{
+	benchPRINTF( "Deferred call benchmark: configUSE_DEFERRED_CALLS is 0\r\n" );
+}
+
+#endif /* configUSE_DEFERRED_CALLS */
+
@@ -0,0 +1,388 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Compares the CPU utilisation at which a set of periodic tasks starts to miss
+ * deadlines when the tasks are scheduled earliest deadline first with the
+ * utilisation at which they start to miss deadlines when they are given rate
+ * monotonic priorities.
+ *
+ * Three tasks with periods of 4, 6 and 10 ticks, each with a deadline equal to
+ * its period, share the utilisation equally.  Each job performs an amount of
+ * work calibrated against the tick period.  The task set is run at
+ * utilisations from ebenchMIN_UTILISATION to 100% in steps of
+ * ebenchUTILISATION_STEP, first with rate monotonic priorities then with all
+ * the tasks at configEDF_PRIORITY and given deadlines, and the deadlines
+ * missed in each run are counted.
+ *
+ * Response time analysis shows rate monotonic priorities can schedule this
+ * task set at 85% utilisation but not at 90%, as the 10 tick task then misses
+ * the deadline of the job released with the other two.  Earliest deadline
+ * first can schedule any task set with deadlines equal to periods up to 100%,
+ * less the time taken by the kernel.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "EDFBench.h"
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+/* The number of periodic tasks, and their periods in ticks. */
+#define ebenchNUM_TASKS				( 3 )
+#define ebenchHYPERPERIOD			( ( portTickType ) 60 )
+
+/* The utilisations tested, in percent. */
+#define ebenchMIN_UTILISATION		( 60UL )
+#define ebenchUTILISATION_STEP		( 5UL )
+
+/* Each run lasts this many hyperperiods.  Each configuration is run
+ebenchREPEATS times and the lowest number of misses is reported, as anything
+else running on the processor, such as the host operating system when the
+hosted port is used, can only add misses. */
+#define ebenchHYPERPERIODS			( 3 )
+#define ebenchREPEATS				( 2 )
+
+/* The number of ticks over which the work done in a tick is measured. */
+#define ebenchCALIBRATION_TICKS		( 20UL )
+
+/* The work is done in blocks of this many iterations.  The calibration reads
+the tick count after every ebenchCALIBRATION_BATCH blocks, so the time taken
+to read it is small compared to the work measured. */
+#define ebenchWORK_BLOCK			( 64UL )
+#define ebenchCALIBRATION_BATCH		( 256UL )
+
+/* One periodic task. */
+typedef struct xEBENCH_TASK
+{
+	portTickType xPeriod;					/* The period and deadline of the task. */
+	unsigned portBASE_TYPE uxRMPriority;	/* The rate monotonic priority of the task. */
+	unsigned long ulWork;					/* The work done by each job, in blocks. */
+	portTickType xFirstRelease;				/* The tick at which the first job is released. */
+	portBASE_TYPE xUseEDF;					/* pdTRUE if the task is scheduled by deadline. */
+	volatile unsigned long ulJobs;			/* The number of jobs completed. */
+	volatile unsigned long ulMisses;		/* The number of jobs completed late, when not scheduled by deadline. */
+	xTaskHandle xHandle;
+} xEbenchTask;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Measure the number of work blocks that can be done in one tick while no
+ * other task is running.
+ */
+static unsigned long prvCalibrate( void );
+
+/*
+ * Perform ulBlocks blocks of work.
+ */
+static void prvWork( unsigned long ulBlocks );
+
+/*
+ * Run the task set at ulUtilisation percent ebenchREPEATS times, and return
+ * the lowest number of deadlines missed in a run.
+ */
+static unsigned long prvLeastMisses( unsigned long ulUtilisation, unsigned long ulBlocksPerTick, portBASE_TYPE xUseEDF );
+
+/*
+ * Run the task set at ulUtilisation percent for ebenchHYPERPERIODS
+ * hyperperiods, and return the number of deadlines missed.
+ */
+static unsigned long prvRunTaskSet( unsigned long ulUtilisation, unsigned long ulBlocksPerTick, portBASE_TYPE xUseEDF );
+
+/*
+ * The periodic task.
+ */
+static void prvPeriodicTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+/* Rate monotonic priorities are assigned in period order, leaving the highest
+priority for the task running the benchmark. */
+static xEbenchTask xTasks[ ebenchNUM_TASKS ] =
+{
+	{ 4, tskIDLE_PRIORITY + 3, 0, 0, pdFALSE, 0, 0, NULL },
+	{ 6, tskIDLE_PRIORITY + 2, 0, 0, pdFALSE, 0, 0, NULL },
+	{ 10, tskIDLE_PRIORITY + 1, 0, 0, pdFALSE, 0, 0, NULL }
+};
+
+/* Written by the work loop so it is not optimised away. */
+static volatile unsigned long ulWorkSink = 0UL;
+
+/*-----------------------------------------------------------*/
+
+void vRunEDFBenchmark( void )
+{
+unsigned long ulBlocksPerTick, ulUtilisation, ulRMMisses, ulEDFMisses;
+unsigned long ulRMBest = 0UL, ulEDFBest = 0UL;
+portBASE_TYPE xRMFailed = pdFALSE, xEDFFailed = pdFALSE;
+
+	/* The benchmark task must be able to preempt every periodic task. */
+	configASSERT( uxTaskPriorityGet( NULL ) > ( tskIDLE_PRIORITY + 3 ) );
+	configASSERT( uxTaskPriorityGet( NULL ) > configEDF_PRIORITY );
+
+	ulBlocksPerTick = prvCalibrate();
+
+	benchPRINTF( "EDF benchmark: periods 4, 6 and 10 ticks, %lu work blocks per tick\r\n", ulBlocksPerTick );
+	benchPRINTF( "  utilisation  RM misses  EDF misses\r\n" );
+
+	for( ulUtilisation = ebenchMIN_UTILISATION; ulUtilisation <= 100UL; ulUtilisation += ebenchUTILISATION_STEP )
+	{
+		ulRMMisses = prvLeastMisses( ulUtilisation, ulBlocksPerTick, pdFALSE );
+		ulEDFMisses = prvLeastMisses( ulUtilisation, ulBlocksPerTick, pdTRUE );
+
+		benchPRINTF( "  %10lu%% %10lu %11lu\r\n", ulUtilisation, ulRMMisses, ulEDFMisses );
+
+		/* Record the highest utilisation reached before the first miss. */
+		if( ulRMMisses != 0UL )
+		{
+			xRMFailed = pdTRUE;
+		}
+		else if( xRMFailed == pdFALSE )
+		{
+			ulRMBest = ulUtilisation;
+		}
+
+		if( ulEDFMisses != 0UL )
+		{
+			xEDFFailed = pdTRUE;
+		}
+		else if( xEDFFailed == pdFALSE )
+		{
+			ulEDFBest = ulUtilisation;
+		}
+	}
+
+	benchPRINTF( "  highest utilisation without a miss: RM %lu%% EDF %lu%%\r\n", ulRMBest, ulEDFBest );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvCalibrate( void )
+{
+unsigned long ulBlocks = 0UL;
+portTickType xStart;
+
+	/* Start at the beginning of a tick. */
+	xStart = xTaskGetTickCount();
+	while( xTaskGetTickCount() == xStart )
+	{
+	}
+
+	xStart = xTaskGetTickCount();
+	while( ( xTaskGetTickCount() - xStart ) < ( portTickType ) ebenchCALIBRATION_TICKS )
+	{
+		prvWork( ebenchCALIBRATION_BATCH );
+		ulBlocks += ebenchCALIBRATION_BATCH;
+	}
+
+	return ulBlocks / ebenchCALIBRATION_TICKS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWork( unsigned long ulBlocks )
+{
+unsigned long ulBlock, ulIteration;
+
+	for( ulBlock = 0UL; ulBlock < ulBlocks; ulBlock++ )
+	{
+		for( ulIteration = 0UL; ulIteration < ebenchWORK_BLOCK; ulIteration++ )
+		{
+			ulWorkSink++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvLeastMisses( unsigned long ulUtilisation, unsigned long ulBlocksPerTick, portBASE_TYPE xUseEDF )
+{
+unsigned long ulMisses, ulLeast = ~0UL;
+unsigned portBASE_TYPE uxRun;
+
+	for( uxRun = 0; uxRun < ebenchREPEATS; uxRun++ )
+	{
+		ulMisses = prvRunTaskSet( ulUtilisation, ulBlocksPerTick, xUseEDF );
+
+		if( ulMisses < ulLeast )
+		{
+			ulLeast = ulMisses;
+		}
+	}
+
+	return ulLeast;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRunTaskSet( unsigned long ulUtilisation, unsigned long ulBlocksPerTick, portBASE_TYPE xUseEDF )
+{
+unsigned portBASE_TYPE uxTask, uxPriority;
+unsigned long ulMisses = 0UL;
+portTickType xStart;
+
+	for( uxTask = 0; uxTask < ebenchNUM_TASKS; uxTask++ )
+	{
+		/* Each task uses an equal share of the utilisation. */
+		xTasks[ uxTask ].ulWork = ( ( ulBlocksPerTick * ulUtilisation * ( unsigned long ) xTasks[ uxTask ].xPeriod ) / 100UL ) / ebenchNUM_TASKS;
+		xTasks[ uxTask ].xUseEDF = xUseEDF;
+		xTasks[ uxTask ].ulJobs = 0UL;
+		xTasks[ uxTask ].ulMisses = 0UL;
+
+		uxPriority = ( xUseEDF != pdFALSE ) ? configEDF_PRIORITY : xTasks[ uxTask ].uxRMPriority;
+		xTasks[ uxTask ].xHandle = NULL;
+		xTaskCreate( prvPeriodicTask, ( signed char * ) "EDFp", configMINIMAL_STACK_SIZE, &( xTasks[ uxTask ] ), uxPriority, &( xTasks[ uxTask ].xHandle ) );
+		configASSERT( xTasks[ uxTask ].xHandle );
+	}
+
+	/* Start on a tick boundary, then release the first job of every task in
+	the same tick.  The tick count does not change while the scheduler is
+	suspended. */
+	vTaskDelay( 1 );
+	vTaskSuspendAll();
+	{
+		xStart = xTaskGetTickCount();
+
+		for( uxTask = 0; uxTask < ebenchNUM_TASKS; uxTask++ )
+		{
+			xTasks[ uxTask ].xFirstRelease = xStart;
+
+			if( xUseEDF != pdFALSE )
+			{
+				vTaskSetPeriodicDeadline( xTasks[ uxTask ].xHandle, xTasks[ uxTask ].xPeriod, xTasks[ uxTask ].xPeriod );
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	vTaskDelay( ebenchHYPERPERIOD * ebenchHYPERPERIODS );
+
+	for( uxTask = 0; uxTask < ebenchNUM_TASKS; uxTask++ )
+	{
+		if( xUseEDF != pdFALSE )
+		{
+			ulMisses += ( unsigned long ) uxTaskGetDeadlineMisses( xTasks[ uxTask ].xHandle );
+		}
+		else
+		{
+			ulMisses += xTasks[ uxTask ].ulMisses;
+		}
+
+		/* Every task must have run, even if it missed deadlines. */
+		configASSERT( xTasks[ uxTask ].ulJobs > 0UL );
+		vTaskDelete( xTasks[ uxTask ].xHandle );
+	}
+
+	/* Let the idle task free the deleted tasks. */
+	vTaskDelay( 2 );
+
+	return ulMisses;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeriodicTask( void *pvParameters )
+{
+xEbenchTask *pxTask = ( xEbenchTask * ) pvParameters;
+portTickType xRelease;
+
+	/* Wait for the first release, which is set by the benchmark task after
+	the periodic tasks have been created. */
+	vTaskDelay( 1 );
+	xRelease = pxTask->xFirstRelease;
+
+	for( ;; )
+	{
+		prvWork( pxTask->ulWork );
+		pxTask->ulJobs++;
+
+		if( pxTask->xUseEDF != pdFALSE )
+		{
+			/* The kernel counts the missed deadlines. */
+			vTaskWaitForNextPeriod();
+		}
+		else
+		{
+			/* The job is late if the tick in which it had to complete has
+			ended, as is checked by vTaskWaitForNextPeriod(). */
+			if( ( xTaskGetTickCount() - xRelease ) >= pxTask->xPeriod )
+			{
+				pxTask->ulMisses++;
+			}
+
+			vTaskDelayUntil( &xRelease, pxTask->xPeriod );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+#else /* configUSE_EDF_SCHEDULING */
+
+void vRunEDFBenchmark( void )
+{
+	benchPRINTF( "EDF benchmark: configUSE_EDF_SCHEDULING is 0\r\n" );
+}
+
+#endif /* configUSE_EDF_SCHEDULING */
+
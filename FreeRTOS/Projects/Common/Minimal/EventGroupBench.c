@@ -0,0 +1,338 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Measures the cost of the deferred interrupt side of an event group.
+ *
+ * Setting bits from a task checks every task that is waiting on the event
+ * group, so its cost grows with the number of waiting tasks.
+ * xEventGroupSetBitsFromISR() only posts the request to the RTOS daemon task,
+ * so the time spent in the (simulated) interrupt should not change with the
+ * number of waiting tasks.  Both are measured with 0 to ebenchMAX_WAITERS
+ * tasks waiting for bits that are never all set.
+ *
+ * The time from the simulated interrupt to a blocked task is also measured,
+ * and compared with giving a binary semaphore from the interrupt.  The event
+ * group pays for the extra switch to the daemon task.
+ *
+ * The behaviour of event groups is checked by the tasks in EventGroupsDemo.c,
+ * not here.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "event_groups.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "EventGroupBench.h"
+
+#if ( INCLUDE_xTimerPendFunctionCall == 1 )
+
+/* The largest number of tasks waiting on the event group. */
+#define ebenchMAX_WAITERS			( 64 )
+
+/* The number of times the bits are set for each measurement. */
+#define ebenchSETS					( 2000UL )
+
+/* The bit set by the simulated interrupt, and a bit that is never set.  The
+waiting tasks wait for both, so are checked but never unblocked. */
+#define ebenchBIT_EVENT				( ( xEventBitsType ) 0x01 )
+#if ( configUSE_16_BIT_TICKS == 1 )
+	#define ebenchBIT_NEVER			( ( xEventBitsType ) 0x80 )
+#else
+	#define ebenchBIT_NEVER			( ( xEventBitsType ) 0x800000UL )
+#endif
+
+/* Used to select the mechanism used by the receiving task. */
+#define ebenchUSE_SEMAPHORE			( ( void * ) 0 )
+#define ebenchUSE_EVENT_GROUP		( ( void * ) 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Time setting ebenchBIT_EVENT ebenchSETS times with uxWaiters tasks waiting
+ * on the event group, either directly or from the simulated interrupt.  Only
+ * the call that sets the bits is timed.
+ */
+static unsigned long prvTimeSetBits( unsigned portBASE_TYPE uxWaiters, portBASE_TYPE xFromISR );
+
+/*
+ * Time ebenchSETS events sent from the simulated interrupt to a task that is
+ * blocked waiting for them.
+ */
+static unsigned long prvTimeToTask( void *pvMechanism );
+
+/*
+ * Tasks that wait on the event group.
+ */
+static void prvWaiterTask( void *pvParameters );
+static void prvReceiverTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static xEventGroupHandle xBenchEventGroup = NULL;
+static xSemaphoreHandle xBenchSemaphore = NULL;
+static volatile unsigned long ulEventsReceived = 0UL;
+static xTaskHandle xWaiters[ ebenchMAX_WAITERS ];
+
+/*-----------------------------------------------------------*/
+
+void vRunEventGroupBenchmark( void )
+{
+unsigned portBASE_TYPE uxWaiters, uxOriginalPriority;
+unsigned long ulTaskTime, ulISRTime;
+
+	benchPRINTF( "Event group benchmark: times in %s\r\n", benchTIMESTAMP_UNITS );
+
+	/* Run below the daemon task, so the daemon task cannot be time sliced
+	with this task part way through setting bits on its behalf. */
+	configASSERT( configTIMER_TASK_PRIORITY > ( tskIDLE_PRIORITY + 1 ) );
+	uxOriginalPriority = uxTaskPriorityGet( NULL );
+	vTaskPrioritySet( NULL, configTIMER_TASK_PRIORITY - 1 );
+
+	xBenchEventGroup = xEventGroupCreate();
+	vSemaphoreCreateBinary( xBenchSemaphore );
+	configASSERT( xBenchEventGroup );
+	configASSERT( xBenchSemaphore );
+
+	/* A binary semaphore is created available. */
+	( void ) xSemaphoreTake( xBenchSemaphore, 0 );
+
+	for( uxWaiters = 0; uxWaiters <= ebenchMAX_WAITERS; uxWaiters = ( uxWaiters == 0 ) ? 1 : uxWaiters * 4 )
+	{
+		ulTaskTime = prvTimeSetBits( uxWaiters, pdFALSE );
+		ulISRTime = prvTimeSetBits( uxWaiters, pdTRUE );
+		benchPRINTF( "  set bits with %2u waiting: from task %6lu from interrupt %6lu\r\n", ( unsigned ) uxWaiters, ulTaskTime, ulISRTime );
+	}
+
+	ulISRTime = prvTimeToTask( ebenchUSE_SEMAPHORE );
+	ulTaskTime = prvTimeToTask( ebenchUSE_EVENT_GROUP );
+	benchPRINTF( "  interrupt to blocked task: semaphore %6lu event group %6lu\r\n", ulISRTime, ulTaskTime );
+
+	vEventGroupDelete( xBenchEventGroup );
+	vQueueDelete( xBenchSemaphore );
+	xBenchEventGroup = NULL;
+	xBenchSemaphore = NULL;
+
+	vTaskPrioritySet( NULL, uxOriginalPriority );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeSetBits( unsigned portBASE_TYPE uxWaiters, portBASE_TYPE xFromISR )
+{
+unsigned long ulSets, ulStart, ulTotal = 0UL;
+unsigned portBASE_TYPE uxWaiter;
+portBASE_TYPE xHigherPriorityTaskWoken;
+
+	for( uxWaiter = 0; uxWaiter < uxWaiters; uxWaiter++ )
+	{
+		xWaiters[ uxWaiter ] = NULL;
+		xTaskCreate( prvWaiterTask, ( signed char * ) "EGWt", configMINIMAL_STACK_SIZE, NULL, uxTaskPriorityGet( NULL ), &( xWaiters[ uxWaiter ] ) );
+		configASSERT( xWaiters[ uxWaiter ] );
+	}
+
+	/* Let every waiter run and block on the event group. */
+	vTaskDelay( 2 );
+
+	for( ulSets = 0UL; ulSets < ebenchSETS; ulSets++ )
+	{
+		if( xFromISR == pdFALSE )
+		{
+			ulStart = benchGET_TIMESTAMP();
+			( void ) xEventGroupSetBits( xBenchEventGroup, ebenchBIT_EVENT );
+			ulTotal += benchGET_TIMESTAMP() - ulStart;
+		}
+		else
+		{
+			xHigherPriorityTaskWoken = pdFALSE;
+			ulStart = benchGET_TIMESTAMP();
+			( void ) xEventGroupSetBitsFromISR( xBenchEventGroup, ebenchBIT_EVENT, &xHigherPriorityTaskWoken );
+			ulTotal += benchGET_TIMESTAMP() - ulStart;
+
+			/* As portEND_SWITCHING_ISR() at the end of an interrupt.  The
+			daemon task has the higher priority, so sets the bits before this
+			task runs again. */
+			if( xHigherPriorityTaskWoken != pdFALSE )
+			{
+				taskYIELD();
+			}
+		}
+
+		configASSERT( ( xEventGroupGetBits( xBenchEventGroup ) & ebenchBIT_EVENT ) != 0 );
+		( void ) xEventGroupClearBits( xBenchEventGroup, ebenchBIT_EVENT );
+	}
+
+	for( uxWaiter = 0; uxWaiter < uxWaiters; uxWaiter++ )
+	{
+		vTaskDelete( xWaiters[ uxWaiter ] );
+	}
+
+	/* Let the idle task free the deleted waiters. */
+	vTaskDelay( 2 );
+
+	return ulTotal / ebenchSETS;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeToTask( void *pvMechanism )
+{
+unsigned long ulSets, ulStart, ulElapsed;
+unsigned portBASE_TYPE uxOriginalPriority;
+portBASE_TYPE xHigherPriorityTaskWoken;
+xTaskHandle xReceiver = NULL;
+
+	/* The receiver is created at the priority of this task so it blocks on
+	the semaphore or event group straight away.  Dropping below it means each
+	event, including one passed through the daemon task, has reached the
+	receiver by the time this task runs again. */
+	uxOriginalPriority = uxTaskPriorityGet( NULL );
+	configASSERT( uxOriginalPriority > tskIDLE_PRIORITY );
+
+	ulEventsReceived = 0UL;
+	xTaskCreate( prvReceiverTask, ( signed char * ) "EGRx", configMINIMAL_STACK_SIZE, pvMechanism, uxOriginalPriority, &xReceiver );
+	configASSERT( xReceiver );
+	vTaskPrioritySet( NULL, uxOriginalPriority - 1 );
+
+	/* The receiver has run and is now blocked. */
+	ulStart = benchGET_TIMESTAMP();
+
+	for( ulSets = 0UL; ulSets < ebenchSETS; ulSets++ )
+	{
+		xHigherPriorityTaskWoken = pdFALSE;
+
+		if( pvMechanism == ebenchUSE_SEMAPHORE )
+		{
+			( void ) xSemaphoreGiveFromISR( xBenchSemaphore, &xHigherPriorityTaskWoken );
+		}
+		else
+		{
+			( void ) xEventGroupSetBitsFromISR( xBenchEventGroup, ebenchBIT_EVENT, &xHigherPriorityTaskWoken );
+		}
+
+		/* As portEND_SWITCHING_ISR() at the end of an interrupt. */
+		if( xHigherPriorityTaskWoken != pdFALSE )
+		{
+			taskYIELD();
+		}
+	}
+
+	ulElapsed = benchGET_TIMESTAMP() - ulStart;
+
+	/* Both the daemon task and the receiver have a higher priority than this
+	task, so every event should have been received before this task ran
+	again. */
+	configASSERT( ulEventsReceived == ebenchSETS );
+
+	vTaskDelete( xReceiver );
+	vTaskPrioritySet( NULL, uxOriginalPriority );
+
+	return ulElapsed / ebenchSETS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaiterTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) xEventGroupWaitBits( xBenchEventGroup, ebenchBIT_EVENT | ebenchBIT_NEVER, pdFALSE, pdTRUE, portMAX_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceiverTask( void *pvParameters )
+{
+	for( ;; )
+	{
+		if( pvParameters == ebenchUSE_SEMAPHORE )
+		{
+			if( xSemaphoreTake( xBenchSemaphore, portMAX_DELAY ) == pdPASS )
+			{
+				ulEventsReceived++;
+			}
+		}
+		else
+		{
+			if( ( xEventGroupWaitBits( xBenchEventGroup, ebenchBIT_EVENT, pdTRUE, pdFALSE, portMAX_DELAY ) & ebenchBIT_EVENT ) != 0 )
+			{
+				ulEventsReceived++;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+#else /* INCLUDE_xTimerPendFunctionCall */
+
+void vRunEventGroupBenchmark( void )
+{
+	benchPRINTF( "Event group benchmark: INCLUDE_xTimerPendFunctionCall is 0\r\n" );
+}
+
+#endif /* INCLUDE_xTimerPendFunctionCall */
+
@@ -0,0 +1,319 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Checks the behaviour of event groups from two tasks that share one group.
+ *
+ * The waiting task has the higher priority, so it runs as soon as it is
+ * unblocked.  The controlling task can therefore tell whether a call that sets
+ * bits unblocked the waiting task by checking the waiting task's cycle count
+ * as soon as the call returns.  Each cycle has three steps:
+ *
+ * + Wait for any bit.  The waiting task waits for either of egdANY_BITS, and
+ *   clears them on exit.  Setting an unrelated bit must not unblock it.
+ *   Setting one of the bits must, and only the bit waited for must then be
+ *   cleared.
+ * + Wait for all bits.  The waiting task waits for both of egdALL_BITS, and
+ *   does not clear them.  Setting one of them must not unblock it.  Setting
+ *   the other must, and both bits must then still be set.
+ * + Set from an interrupt.  The controlling task calls
+ *   xEventGroupSetBitsFromISR() as an interrupt would, with the scheduler
+ *   suspended so that the daemon task cannot run.  The bit must not be set
+ *   until the daemon task runs, which then unblocks the waiting task.
+ *
+ * Finally the controlling task meets itself at a rendezvous, which must set
+ * and then clear its bit without blocking.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+
+/* Demo program include files. */
+#include "EventGroupsDemo.h"
+
+/* Priorities of the two tasks.  The waiting task must have the higher
+priority. */
+#define egdCONTROLLING_TASK_PRIORITY	( tskIDLE_PRIORITY + 1 )
+#define egdWAITING_TASK_PRIORITY		( tskIDLE_PRIORITY + 2 )
+
+/* The bits used by each step.  egdOTHER_BIT is not waited for. */
+#define egdANY_BITS						( ( xEventBitsType ) 0x03 )
+#define egdANY_BIT_SET					( ( xEventBitsType ) 0x02 )
+#define egdALL_BITS						( ( xEventBitsType ) 0x0c )
+#define egdALL_FIRST_BIT				( ( xEventBitsType ) 0x04 )
+#define egdALL_SECOND_BIT				( ( xEventBitsType ) 0x08 )
+#define egdISR_BIT						( ( xEventBitsType ) 0x20 )
+#define egdOTHER_BIT					( ( xEventBitsType ) 0x40 )
+
+/* The waiting task only times out if the controlling task has failed. */
+#define egdMAX_WAIT						( ( portTickType ) 1000 / portTICK_RATE_MS )
+
+/* The time the controlling task waits between cycles, and for the daemon task
+to set a bit on behalf of the simulated interrupt. */
+#define egdCYCLE_DELAY					( ( portTickType ) 10 / portTICK_RATE_MS )
+#define egdDAEMON_DELAY					( ( portTickType ) 2 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The two tasks as described at the top of this file.
+ */
+static void prvControllingTask( void *pvParameters );
+static void prvWaitingTask( void *pvParameters );
+
+/*
+ * Sets uxBits from the controlling task, and checks whether the waiting task
+ * ran as a result.  Returns the bits set in the event group afterwards.
+ */
+static xEventBitsType prvSetAndCheck( xEventBitsType uxBits, portBASE_TYPE xShouldUnblock );
+
+/*-----------------------------------------------------------*/
+
+static xEventGroupHandle xEventGroup = NULL;
+
+/* Latched if anything unexpected happens. */
+static volatile portBASE_TYPE xErrorDetected = pdFALSE;
+
+/* Incremented each time the waiting task returns from a wait, and each time
+the controlling task completes a cycle. */
+static volatile unsigned long ulWaitingCycles = 0UL, ulControllingCycles = 0UL;
+
+/*-----------------------------------------------------------*/
+
+void vStartEventGroupTasks( void )
+{
+	xEventGroup = xEventGroupCreate();
+
+	if( xEventGroup != NULL )
+	{
+		xTaskCreate( prvControllingTask, ( signed char * ) "EGCtl", configMINIMAL_STACK_SIZE, NULL, egdCONTROLLING_TASK_PRIORITY, NULL );
+		xTaskCreate( prvWaitingTask, ( signed char * ) "EGWait", configMINIMAL_STACK_SIZE, NULL, egdWAITING_TASK_PRIORITY, NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitingTask( void *pvParameters )
+{
+xEventBitsType uxBits;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* Wait for any bit, clearing the bits waited for on exit.  The value
+		returned is that before the bits were cleared. */
+		uxBits = xEventGroupWaitBits( xEventGroup, egdANY_BITS, pdTRUE, pdFALSE, egdMAX_WAIT );
+		if( ( uxBits & ( egdANY_BITS | egdOTHER_BIT ) ) != ( egdANY_BIT_SET | egdOTHER_BIT ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+		ulWaitingCycles++;
+
+		/* Wait for all bits, leaving them set. */
+		uxBits = xEventGroupWaitBits( xEventGroup, egdALL_BITS, pdFALSE, pdTRUE, egdMAX_WAIT );
+		if( ( uxBits & egdALL_BITS ) != egdALL_BITS )
+		{
+			xErrorDetected = pdTRUE;
+		}
+		ulWaitingCycles++;
+
+		#if ( INCLUDE_xTimerPendFunctionCall == 1 )
+		{
+			/* Wait for the bit set by the simulated interrupt. */
+			uxBits = xEventGroupWaitBits( xEventGroup, egdISR_BIT, pdTRUE, pdFALSE, egdMAX_WAIT );
+			if( ( uxBits & egdISR_BIT ) == 0 )
+			{
+				xErrorDetected = pdTRUE;
+			}
+			ulWaitingCycles++;
+		}
+		#endif /* INCLUDE_xTimerPendFunctionCall */
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvControllingTask( void *pvParameters )
+{
+xEventBitsType uxBits;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* The waiting task has run, as it has the higher priority, so is now
+		blocked waiting for any of egdANY_BITS. */
+		( void ) prvSetAndCheck( egdOTHER_BIT, pdFALSE );
+		uxBits = prvSetAndCheck( egdANY_BIT_SET, pdTRUE );
+
+		/* Only the bit waited for was cleared. */
+		if( uxBits != egdOTHER_BIT )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		( void ) xEventGroupClearBits( xEventGroup, egdOTHER_BIT );
+
+		/* The waiting task is now waiting for all of egdALL_BITS. */
+		( void ) prvSetAndCheck( egdALL_FIRST_BIT, pdFALSE );
+		uxBits = prvSetAndCheck( egdALL_SECOND_BIT, pdTRUE );
+
+		/* The bits were not cleared on exit. */
+		if( uxBits != egdALL_BITS )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		( void ) xEventGroupClearBits( xEventGroup, egdALL_BITS );
+
+		#if ( INCLUDE_xTimerPendFunctionCall == 1 )
+		{
+		unsigned long ulCycles = ulWaitingCycles;
+		portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+			/* The waiting task is now waiting for egdISR_BIT.  Suspending the
+			scheduler stops the daemon task running until the end of the
+			simulated interrupt, so the bit must not be set before then. */
+			vTaskSuspendAll();
+			{
+				if( xEventGroupSetBitsFromISR( xEventGroup, egdISR_BIT, &xHigherPriorityTaskWoken ) != pdPASS )
+				{
+					xErrorDetected = pdTRUE;
+				}
+
+				if( xEventGroupGetBits( xEventGroup ) != 0 )
+				{
+					xErrorDetected = pdTRUE;
+				}
+			}
+			( void ) xTaskResumeAll();
+
+			/* Once the daemon task has set the bit the waiting task runs, and
+			clears the bit on exit. */
+			vTaskDelay( egdDAEMON_DELAY );
+
+			if( ( ulWaitingCycles != ( ulCycles + 1UL ) ) || ( xEventGroupGetBits( xEventGroup ) != 0 ) )
+			{
+				xErrorDetected = pdTRUE;
+			}
+		}
+		#endif /* INCLUDE_xTimerPendFunctionCall */
+
+		/* The waiting task is waiting for egdANY_BITS again, so is not
+		unblocked by the rendezvous. */
+		uxBits = xEventGroupSync( xEventGroup, egdOTHER_BIT, egdOTHER_BIT, 0 );
+		if( ( uxBits != egdOTHER_BIT ) || ( xEventGroupGetBits( xEventGroup ) != 0 ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		ulControllingCycles++;
+		vTaskDelay( egdCYCLE_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static xEventBitsType prvSetAndCheck( xEventBitsType uxBits, portBASE_TYPE xShouldUnblock )
+{
+unsigned long ulCycles = ulWaitingCycles;
+
+	( void ) xEventGroupSetBits( xEventGroup, uxBits );
+
+	/* If the waiting task was unblocked it has already run. */
+	if( xShouldUnblock != pdFALSE )
+	{
+		ulCycles++;
+	}
+
+	if( ulWaitingCycles != ulCycles )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	return xEventGroupGetBits( xEventGroup );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xAreEventGroupTasksStillRunning( void )
+{
+static unsigned long ulLastWaitingCycles = 0UL, ulLastControllingCycles = 0UL;
+portBASE_TYPE xReturn = pdTRUE;
+
+	/* Both tasks must have cycled since the last call. */
+	if( ( ulWaitingCycles == ulLastWaitingCycles ) || ( ulControllingCycles == ulLastControllingCycles ) )
+	{
+		xReturn = pdFALSE;
+	}
+
+	if( xErrorDetected != pdFALSE )
+	{
+		xReturn = pdFALSE;
+	}
+
+	ulLastWaitingCycles = ulWaitingCycles;
+	ulLastControllingCycles = ulControllingCycles;
+
+	return xReturn;
+}
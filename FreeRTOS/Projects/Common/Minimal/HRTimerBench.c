@@ -0,0 +1,333 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Measures how late the callbacks of high resolution timers execute, as the
+ * stepper motor of rd8a uses them.  Three timers are measured in turn:
+ *
+ * + A periodic timer whose callback executes from the compare interrupt.  Half
+ *   way through, the callback doubles the period, which must keep the phase of
+ *   the timer.
+ * + A one-shot timer that is restarted by a task each time it expires.
+ * + A periodic timer whose callback is deferred to the RTOS daemon task.
+ *
+ * The benchmark tracks the time at which each expiry should occur, and checks
+ * that no callback executes before it.  The counter of the Linux port starts
+ * shortly before it wraps, so the first timer runs across the wrap.  High
+ * resolution timers cannot be deleted, so the timers are only created the first
+ * time the benchmark runs.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "hrtimers.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "HRTimerBench.h"
+
+#if ( configUSE_HR_TIMERS == 1 )
+
+/* The period and number of expiries of the periodic timer that uses an ISR
+context callback.  The period is doubled half way through. */
+#define hrbenchPERIOD_US					( 250UL )
+#define hrbenchPERIODIC_EXPIRIES			( 800UL )
+
+/* The delay and number of starts of the one-shot timer. */
+#define hrbenchONE_SHOT_DELAY_US			( 200UL )
+#define hrbenchONE_SHOT_STARTS				( 100UL )
+
+/* The period and number of expiries of the timer that uses a deferred
+callback. */
+#define hrbenchDEFERRED_PERIOD_US			( 1000UL )
+#define hrbenchDEFERRED_EXPIRIES			( 200UL )
+
+/* The longest any of the timers is expected to take to finish. */
+#define hrbenchTIMEOUT						( ( portTickType ) 5000 / portTICK_RATE_MS )
+
+/* Counts are compared modulo the 32 bit range of the counter. */
+#define hrbenchCOUNT_MASK					( 0xffffffffUL )
+#define hrbenchHALF_RANGE					( 0x80000000UL )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The callbacks of the three timers.
+ */
+static void prvPeriodicCallback( xHRTimerHandle xTimer );
+static void prvOneShotCallback( xHRTimerHandle xTimer );
+static void prvDeferredCallback( xHRTimerHandle xTimer );
+
+/*
+ * Record how late a callback executed, or that it executed early.
+ */
+static void prvRecordExpiry( unsigned long ulNow, unsigned long ulExpiry );
+
+/*
+ * Clear the measurements before a timer is measured.
+ */
+static void prvResetMeasurements( unsigned long ulPeriod, unsigned long ulExpectedCallbacks );
+
+/*
+ * Print the measurements of a timer and check them.
+ */
+static void prvReportMeasurements( const char *pcName, xHRTimerHandle xTimer );
+
+/*-----------------------------------------------------------*/
+
+static xHRTimerHandle xPeriodicTimer = NULL, xOneShotTimer = NULL, xDeferredTimer = NULL;
+static xSemaphoreHandle xDoneSemaphore = NULL;
+
+/* The measurements of the timer being measured.  ulExpected is the count at
+which the timer should next expire. */
+static volatile unsigned long ulExpected, ulPeriodCounts, ulOverrunsSeen;
+static volatile unsigned long ulCallbacks, ulCallbackLimit, ulEarly, ulMaxLate, ulTotalLate;
+
+/*-----------------------------------------------------------*/
+
+void vRunHRTimerBenchmark( void )
+{
+unsigned long ulStart, ulStartCount, ulEndCount;
+portBASE_TYPE xResult;
+
+	benchPRINTF( "High resolution timer benchmark: lateness of the callbacks in us\r\n" );
+
+	if( xPeriodicTimer == NULL )
+	{
+		xPeriodicTimer = xHRTimerCreate( ( const signed char * ) "HRPer", prvPeriodicCallback, NULL, pdFALSE );
+		xOneShotTimer = xHRTimerCreate( ( const signed char * ) "HROne", prvOneShotCallback, NULL, pdFALSE );
+		xDeferredTimer = xHRTimerCreate( ( const signed char * ) "HRDef", prvDeferredCallback, NULL, pdTRUE );
+		configASSERT( xPeriodicTimer && xOneShotTimer && xDeferredTimer );
+	}
+
+	vSemaphoreCreateBinary( xDoneSemaphore );
+	configASSERT( xDoneSemaphore );
+	( void ) xSemaphoreTake( xDoneSemaphore, 0 );
+
+	/* The periodic timer with the ISR context callback.  The first expiry is
+	expected one period after the count is read, and the timer reads the count
+	later, so the timer can only appear late, not early. */
+	prvResetMeasurements( hrtUS_TO_COUNTS( hrbenchPERIOD_US ), hrbenchPERIODIC_EXPIRIES );
+	ulStartCount = ulHRTimerGetCount();
+	ulExpected = ( ulStartCount + ulPeriodCounts ) & hrbenchCOUNT_MASK;
+	xResult = xHRTimerStart( xPeriodicTimer, hrbenchPERIOD_US, hrbenchPERIOD_US );
+	configASSERT( xResult );
+	xResult = xSemaphoreTake( xDoneSemaphore, hrbenchTIMEOUT );
+	configASSERT( xResult );
+	ulEndCount = ulHRTimerGetCount();
+	prvReportMeasurements( "periodic, ISR callback:  ", xPeriodicTimer );
+	benchPRINTF( "  counter wrapped during the periodic timer: %s\r\n", ( ulEndCount < ulStartCount ) ? "yes" : "no" );
+
+	/* The one-shot timer, restarted each time it expires. */
+	prvResetMeasurements( 0UL, hrbenchONE_SHOT_STARTS );
+	for( ulStart = 0UL; ulStart < hrbenchONE_SHOT_STARTS; ulStart++ )
+	{
+		ulExpected = ( ulHRTimerGetCount() + hrtUS_TO_COUNTS( hrbenchONE_SHOT_DELAY_US ) ) & hrbenchCOUNT_MASK;
+		xResult = xHRTimerStart( xOneShotTimer, hrbenchONE_SHOT_DELAY_US, 0UL );
+		configASSERT( xResult );
+		xResult = xSemaphoreTake( xDoneSemaphore, hrbenchTIMEOUT );
+		configASSERT( xResult );
+		configASSERT( xHRTimerIsTimerActive( xOneShotTimer ) == pdFALSE );
+	}
+
+	/* A one-shot timer expires once per start. */
+	vTaskDelay( ( portTickType ) 10 / portTICK_RATE_MS );
+	prvReportMeasurements( "one-shot, ISR callback:  ", xOneShotTimer );
+
+	/* The periodic timer with the deferred callback. */
+	prvResetMeasurements( hrtUS_TO_COUNTS( hrbenchDEFERRED_PERIOD_US ), hrbenchDEFERRED_EXPIRIES );
+	ulExpected = ( ulHRTimerGetCount() + ulPeriodCounts ) & hrbenchCOUNT_MASK;
+	xResult = xHRTimerStart( xDeferredTimer, hrbenchDEFERRED_PERIOD_US, hrbenchDEFERRED_PERIOD_US );
+	configASSERT( xResult );
+	xResult = xSemaphoreTake( xDoneSemaphore, hrbenchTIMEOUT );
+	configASSERT( xResult );
+	prvReportMeasurements( "periodic, deferred:      ", xDeferredTimer );
+
+	( void ) xResult;
+	vSemaphoreDelete( xDoneSemaphore );
+	xDoneSemaphore = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeriodicCallback( xHRTimerHandle xTimer )
+{
+unsigned long ulNow = ulHRTimerGetCount(), ulOverruns, ulLastExpiry;
+signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	prvRecordExpiry( ulNow, ulExpected );
+
+	/* If this callback executed so late that whole periods were missed, the
+	missed expiries were skipped when the timer was reloaded. */
+	ulOverruns = ulHRTimerGetOverruns( xTimer );
+	ulLastExpiry = ( ulExpected + ( ( ulOverruns - ulOverrunsSeen ) * ulPeriodCounts ) ) & hrbenchCOUNT_MASK;
+	ulOverrunsSeen = ulOverruns;
+
+	if( ulCallbacks == ( hrbenchPERIODIC_EXPIRIES / 2UL ) )
+	{
+		/* The next expiry is measured from the last, not from now. */
+		ulPeriodCounts *= 2UL;
+		( void ) xHRTimerChangePeriodFromISR( xTimer, hrbenchPERIOD_US * 2UL );
+	}
+
+	ulExpected = ( ulLastExpiry + ulPeriodCounts ) & hrbenchCOUNT_MASK;
+
+	if( ulCallbacks >= ulCallbackLimit )
+	{
+		( void ) xHRTimerStopFromISR( xTimer );
+		( void ) xSemaphoreGiveFromISR( xDoneSemaphore, &xHigherPriorityTaskWoken );
+		portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvOneShotCallback( xHRTimerHandle xTimer )
+{
+unsigned long ulNow = ulHRTimerGetCount();
+signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	( void ) xTimer;
+
+	prvRecordExpiry( ulNow, ulExpected );
+
+	( void ) xSemaphoreGiveFromISR( xDoneSemaphore, &xHigherPriorityTaskWoken );
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+static void prvDeferredCallback( xHRTimerHandle xTimer )
+{
+unsigned long ulNow = ulHRTimerGetCount(), ulOverruns;
+
+	prvRecordExpiry( ulNow, ulExpected );
+
+	/* Expiries that occurred while this call was pended did not pend the
+	callback again, so the next call is for the expiry after them. */
+	ulOverruns = ulHRTimerGetOverruns( xTimer );
+	ulExpected = ( ulExpected + ( ( 1UL + ulOverruns - ulOverrunsSeen ) * ulPeriodCounts ) ) & hrbenchCOUNT_MASK;
+	ulOverrunsSeen = ulOverruns;
+
+	if( ulCallbacks >= ulCallbackLimit )
+	{
+		( void ) xHRTimerStop( xTimer );
+		( void ) xSemaphoreGive( xDoneSemaphore );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordExpiry( unsigned long ulNow, unsigned long ulExpiry )
+{
+unsigned long ulLate;
+
+	ulLate = ( ulNow - ulExpiry ) & hrbenchCOUNT_MASK;
+
+	if( ulLate >= hrbenchHALF_RANGE )
+	{
+		ulEarly++;
+	}
+	else
+	{
+		ulTotalLate += ulLate;
+
+		if( ulLate > ulMaxLate )
+		{
+			ulMaxLate = ulLate;
+		}
+	}
+
+	ulCallbacks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvResetMeasurements( unsigned long ulPeriod, unsigned long ulExpectedCallbacks )
+{
+	ulPeriodCounts = ulPeriod;
+	ulCallbackLimit = ulExpectedCallbacks;
+	ulCallbacks = 0UL;
+	ulEarly = 0UL;
+	ulMaxLate = 0UL;
+	ulTotalLate = 0UL;
+	ulOverrunsSeen = 0UL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReportMeasurements( const char *pcName, xHRTimerHandle xTimer )
+{
+	benchPRINTF( "  %savg %5lu max %6lu overruns %lu\r\n", pcName, hrtCOUNTS_TO_US( ulTotalLate / ulCallbacks ), hrtCOUNTS_TO_US( ulMaxLate ), ulHRTimerGetOverruns( xTimer ) );
+
+	configASSERT( ulEarly == 0UL );
+	configASSERT( ulCallbacks == ulCallbackLimit );
+}
+/*-----------------------------------------------------------*/
+
+#else /* configUSE_HR_TIMERS */
+
+void vRunHRTimerBenchmark( void )
+{
+	benchPRINTF( "High resolution timer benchmark: configUSE_HR_TIMERS is 0\r\n" );
+}
+
+#endif /* configUSE_HR_TIMERS */
+
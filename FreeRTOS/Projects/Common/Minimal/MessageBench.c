@@ -0,0 +1,224 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Compares a message buffer with a queue when they are used to pass text
+ * lines of varying length between tasks, as the UART line tasks do.
+ *
+ * A queue that passes lines of up to messagebenchMAX_LINE characters must be
+ * created with an item size of messagebenchMAX_LINE, so every line, however
+ * short, copies messagebenchMAX_LINE bytes in and out of the queue and
+ * occupies messagebenchMAX_LINE bytes of it.  A message buffer copies and
+ * stores only the characters of the line, plus the length of the line.
+ *
+ * The RAM used by each is reported first, for a queue that holds
+ * messagebenchQUEUE_LENGTH lines and a message buffer of the same number of
+ * bytes as holds messagebenchQUEUE_LENGTH short lines.  Then the time taken to
+ * send and receive one line is measured for several line lengths, with the
+ * line sent and received by the same task so only the copying and the API
+ * are timed.  Each line received is checked against the line sent.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "message_buffer.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "MessageBench.h"
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+/* The number of times each line is sent and received. */
+#define messagebenchITERATIONS			( 10000UL )
+
+/* The longest line, which sets the item size of the queue. */
+#define messagebenchMAX_LINE			( 120 )
+
+/* The number of lines the queue can hold. */
+#define messagebenchQUEUE_LENGTH		( 5 )
+
+/* The size of the message buffer, which is large enough to hold two of the
+longest lines, or many short ones. */
+#define messagebenchBUFFER_SIZE			( 2 * messagebenchMAX_LINE )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Time messagebenchITERATIONS lines of xLength characters sent to and
+ * received from a queue, or a message buffer, by the calling task.
+ */
+static unsigned long prvTimeQueue( xQueueHandle xQueue, size_t xLength );
+static unsigned long prvTimeMessageBuffer( xMessageBufferHandle xMessageBuffer, size_t xLength );
+
+/*-----------------------------------------------------------*/
+
+static const size_t xLineLengths[] = { 4, 16, 40, messagebenchMAX_LINE };
+static char cLine[ messagebenchMAX_LINE ];
+
+/*-----------------------------------------------------------*/
+
+void vRunMessageBenchmark( void )
+{
+size_t xHeapBefore, xQueueRAM, xMessageBufferRAM, xLength;
+xQueueHandle xQueue;
+xMessageBufferHandle xMessageBuffer;
+unsigned long ulQueueTime, ulMessageTime;
+unsigned portBASE_TYPE uxIndex;
+
+	benchPRINTF( "Message buffer benchmark: times in %s per line\r\n", benchTIMESTAMP_UNITS );
+
+	for( xLength = 0; xLength < sizeof( cLine ); xLength++ )
+	{
+		cLine[ xLength ] = ( char ) ( 'A' + ( xLength % 26 ) );
+	}
+
+	xHeapBefore = xPortGetFreeHeapSize();
+	xQueue = xQueueCreate( messagebenchQUEUE_LENGTH, messagebenchMAX_LINE );
+	xQueueRAM = xHeapBefore - xPortGetFreeHeapSize();
+
+	xHeapBefore = xPortGetFreeHeapSize();
+	xMessageBuffer = xMessageBufferCreate( messagebenchBUFFER_SIZE );
+	xMessageBufferRAM = xHeapBefore - xPortGetFreeHeapSize();
+
+	configASSERT( xQueue );
+	configASSERT( xMessageBuffer );
+
+	benchPRINTF( "  RAM: queue of %d lines %u bytes of heap, message buffer %u bytes of heap\r\n", messagebenchQUEUE_LENGTH, ( unsigned int ) xQueueRAM, ( unsigned int ) xMessageBufferRAM );
+
+	for( uxIndex = 0; uxIndex < ( sizeof( xLineLengths ) / sizeof( xLineLengths[ 0 ] ) ); uxIndex++ )
+	{
+		xLength = xLineLengths[ uxIndex ];
+		ulQueueTime = prvTimeQueue( xQueue, xLength );
+		ulMessageTime = prvTimeMessageBuffer( xMessageBuffer, xLength );
+		benchPRINTF( "  %3u character line, send then receive: queue %6lu message buffer %6lu\r\n", ( unsigned int ) xLength, ulQueueTime, ulMessageTime );
+	}
+
+	vQueueDelete( xQueue );
+	vMessageBufferDelete( xMessageBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeQueue( xQueueHandle xQueue, size_t xLength )
+{
+unsigned long ulIteration, ulStart, ulElapsed;
+char cReceived[ messagebenchMAX_LINE ];
+
+	ulStart = benchGET_TIMESTAMP();
+
+	for( ulIteration = 0UL; ulIteration < messagebenchITERATIONS; ulIteration++ )
+	{
+		/* The queue copies a whole item, whatever the length of the line. */
+		( void ) xQueueSend( xQueue, cLine, 0 );
+		( void ) xQueueReceive( xQueue, cReceived, 0 );
+	}
+
+	ulElapsed = benchGET_TIMESTAMP() - ulStart;
+
+	configASSERT( memcmp( cReceived, cLine, xLength ) == 0 );
+
+	return ulElapsed / messagebenchITERATIONS;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeMessageBuffer( xMessageBufferHandle xMessageBuffer, size_t xLength )
+{
+unsigned long ulIteration, ulStart, ulElapsed;
+char cReceived[ messagebenchMAX_LINE ];
+size_t xReceived = 0;
+
+	ulStart = benchGET_TIMESTAMP();
+
+	for( ulIteration = 0UL; ulIteration < messagebenchITERATIONS; ulIteration++ )
+	{
+		( void ) xMessageBufferSend( xMessageBuffer, cLine, xLength, 0 );
+		xReceived = xMessageBufferReceive( xMessageBuffer, cReceived, sizeof( cReceived ), 0 );
+	}
+
+	ulElapsed = benchGET_TIMESTAMP() - ulStart;
+
+	/* The messages wrap around the end of the buffer many times, so check
+	the last one arrived intact. */
+	configASSERT( xReceived == xLength );
+	configASSERT( memcmp( cReceived, cLine, xLength ) == 0 );
+	configASSERT( xMessageBufferNextLengthBytes( xMessageBuffer ) == 0 );
+
+	return ulElapsed / messagebenchITERATIONS;
+}
+/*-----------------------------------------------------------*/
+
+#else /* configUSE_TASK_NOTIFICATIONS */
+
+void vRunMessageBenchmark( void )
+{
+	benchPRINTF( "Message buffer benchmark: configUSE_TASK_NOTIFICATIONS is 0\r\n" );
+}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+
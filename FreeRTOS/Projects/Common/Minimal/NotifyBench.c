@@ -0,0 +1,264 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Compares direct to task notifications with binary semaphores when they are
+ * used to signal an event to a single task, as a timer callback does when it
+ * gives a semaphore to a task that is waiting to take it.
+ *
+ * The RAM used by each mechanism is reported first.  A semaphore is a queue
+ * with an item size of zero so the RAM it uses is the queue structure,
+ * measured as the heap consumed when one is created.  A notification uses the
+ * notification value and state held in every TCB, so costs nothing extra to
+ * create.
+ *
+ * The cost of each mechanism is then measured twice.  First when the event is
+ * sent and consumed by the same task, so no task changes state and only the
+ * API is timed.  Then when the event unblocks a higher priority task, so each
+ * iteration includes the receiving task being unblocked, a context switch to
+ * it, the receiving task blocking again, and a context switch back.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "NotifyBench.h"
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+/* The number of times each operation is repeated. */
+#define notifybenchITERATIONS		( 10000UL )
+
+/* Used to select the mechanism used by the receiving task. */
+#define notifybenchUSE_SEMAPHORE	( ( void * ) 0 )
+#define notifybenchUSE_NOTIFICATION	( ( void * ) 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task that receives the events when the cost of unblocking a task is
+ * being measured.  Its parameter selects the mechanism.
+ */
+static void prvNotifyBenchReceiver( void *pvParameters );
+
+/*
+ * Time notifybenchITERATIONS events sent to and consumed by the calling task.
+ */
+static unsigned long prvTimeSemaphoreNoBlock( void );
+static unsigned long prvTimeNotificationNoBlock( void );
+
+/*
+ * Time notifybenchITERATIONS events sent to a receiving task that has a
+ * higher priority than the calling task.
+ */
+static unsigned long prvTimeUnblock( void *pvMechanism );
+
+/*-----------------------------------------------------------*/
+
+static xSemaphoreHandle xBenchSemaphore = NULL;
+static volatile unsigned long ulReceived = 0UL;
+
+/*-----------------------------------------------------------*/
+
+void vRunNotifyBenchmark( void )
+{
+size_t xHeapBefore;
+unsigned long ulSemaphoreTime, ulNotifyTime;
+
+	benchPRINTF( "Notification benchmark: times in %s per event\r\n", benchTIMESTAMP_UNITS );
+
+	/* RAM used by a binary semaphore. */
+	xHeapBefore = xPortGetFreeHeapSize();
+	vSemaphoreCreateBinary( xBenchSemaphore );
+	configASSERT( xBenchSemaphore );
+
+	benchPRINTF( "  RAM: binary semaphore %u bytes of heap, notification %u bytes in each TCB\r\n", ( unsigned int ) ( xHeapBefore - xPortGetFreeHeapSize() ), ( unsigned int ) ( sizeof( unsigned long ) + sizeof( unsigned char ) ) );
+
+	/* vSemaphoreCreateBinary() leaves the semaphore available. */
+	( void ) xSemaphoreTake( xBenchSemaphore, 0 );
+
+	ulSemaphoreTime = prvTimeSemaphoreNoBlock();
+	ulNotifyTime = prvTimeNotificationNoBlock();
+	benchPRINTF( "  give then take, no task switch: semaphore %6lu notification %6lu\r\n", ulSemaphoreTime, ulNotifyTime );
+
+	ulSemaphoreTime = prvTimeUnblock( notifybenchUSE_SEMAPHORE );
+	ulNotifyTime = prvTimeUnblock( notifybenchUSE_NOTIFICATION );
+	benchPRINTF( "  give to blocked task, round trip: semaphore %6lu notification %6lu\r\n", ulSemaphoreTime, ulNotifyTime );
+
+	vQueueDelete( xBenchSemaphore );
+	xBenchSemaphore = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeSemaphoreNoBlock( void )
+{
+unsigned long ulIteration, ulStart;
+
+	ulStart = benchGET_TIMESTAMP();
+
+	for( ulIteration = 0UL; ulIteration < notifybenchITERATIONS; ulIteration++ )
+	{
+		( void ) xSemaphoreGive( xBenchSemaphore );
+		( void ) xSemaphoreTake( xBenchSemaphore, 0 );
+	}
+
+	return ( benchGET_TIMESTAMP() - ulStart ) / notifybenchITERATIONS;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeNotificationNoBlock( void )
+{
+unsigned long ulIteration, ulStart;
+xTaskHandle xThisTask = xTaskGetCurrentTaskHandle();
+
+	ulStart = benchGET_TIMESTAMP();
+
+	for( ulIteration = 0UL; ulIteration < notifybenchITERATIONS; ulIteration++ )
+	{
+		( void ) xTaskNotifyGive( xThisTask );
+		( void ) ulTaskNotifyTake( pdTRUE, 0 );
+	}
+
+	return ( benchGET_TIMESTAMP() - ulStart ) / notifybenchITERATIONS;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeUnblock( void *pvMechanism )
+{
+unsigned long ulIteration, ulStart, ulElapsed;
+unsigned portBASE_TYPE uxOriginalPriority;
+xTaskHandle xReceiver = NULL;
+
+	/* The receiver runs at the priority of this task, which then drops its
+	own priority so each event causes a switch to the receiver. */
+	uxOriginalPriority = uxTaskPriorityGet( NULL );
+	configASSERT( uxOriginalPriority > tskIDLE_PRIORITY );
+
+	ulReceived = 0UL;
+	xTaskCreate( prvNotifyBenchReceiver, ( signed char * ) "NBRx", configMINIMAL_STACK_SIZE, pvMechanism, uxOriginalPriority, &xReceiver );
+	configASSERT( xReceiver );
+	vTaskPrioritySet( NULL, uxOriginalPriority - 1 );
+
+	/* The receiver has run and is now blocked. */
+	ulStart = benchGET_TIMESTAMP();
+
+	for( ulIteration = 0UL; ulIteration < notifybenchITERATIONS; ulIteration++ )
+	{
+		if( pvMechanism == notifybenchUSE_SEMAPHORE )
+		{
+			( void ) xSemaphoreGive( xBenchSemaphore );
+		}
+		else
+		{
+			( void ) xTaskNotifyGive( xReceiver );
+		}
+	}
+
+	ulElapsed = benchGET_TIMESTAMP() - ulStart;
+
+	/* Every event should have been received before the give returned. */
+	configASSERT( ulReceived == notifybenchITERATIONS );
+
+	vTaskDelete( xReceiver );
+	vTaskPrioritySet( NULL, uxOriginalPriority );
+
+	return ulElapsed / notifybenchITERATIONS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyBenchReceiver( void *pvParameters )
+{
+	for( ;; )
+	{
+		if( pvParameters == notifybenchUSE_SEMAPHORE )
+		{
+			if( xSemaphoreTake( xBenchSemaphore, portMAX_DELAY ) == pdPASS )
+			{
+				ulReceived++;
+			}
+		}
+		else
+		{
+			if( ulTaskNotifyTake( pdTRUE, portMAX_DELAY ) != 0UL )
+			{
+				ulReceived++;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+#else /* configUSE_TASK_NOTIFICATIONS */
+
+void vRunNotifyBenchmark( void )
+{
+	benchPRINTF( "Notification benchmark: configUSE_TASK_NOTIFICATIONS is 0\r\n" );
+}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+
@@ -0,0 +1,431 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Compares two ways of servicing many input queues: one gatekeeper task per
+ * queue, each blocked on its own queue, and one task that blocks on all the
+ * queues at once with xQueueSelectFromSet().  Each is measured with 1 to
+ * qsetbenchMAX_MEMBERS queues.
+ *
+ * Three things are measured for each number of queues:
+ *
+ * + The heap used by the receiving task or tasks, once they have started.
+ *
+ * + The time to pass one item to a receiver that has a higher priority than
+ *   the sender, so every item unblocks the receiver.  The items are sent to
+ *   the queues in a scattered order.
+ *
+ * + The time per item to drain a burst of items from every queue, when the
+ *   receivers have a lower priority than the sender so all the queues are
+ *   full before the receivers run.
+ *
+ * The selecting task reads one item each time it selects a queue, so a queue
+ * that holds several items is selected several times.  Each item carries the
+ * index of the queue it was sent to, and every item received is checked.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "QueueSetBench.h"
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+/* The largest number of queues measured. */
+#ifndef qsetbenchMAX_MEMBERS
+	#define qsetbenchMAX_MEMBERS		( 64 )
+#endif
+
+/* The length of each queue, which is also the number of items sent to each
+queue in a burst. */
+#define qsetbenchQUEUE_LENGTH			( 4 )
+
+/* The number of items passed to a higher priority receiver for each
+measurement. */
+#define qsetbenchITEMS					( 8000UL )
+
+/* The number of bursts drained for each measurement. */
+#define qsetbenchBURSTS					( 100UL )
+
+/* Each item holds a sequence number for its queue above the queue index. */
+#define qsetbenchINDEX_BITS				( 8 )
+#define qsetbenchINDEX_MASK				( ( 1UL << qsetbenchINDEX_BITS ) - 1UL )
+
+/* Selects the receivers created by prvCreateReceivers(). */
+#define qsetbenchTASK_PER_QUEUE			( ( void * ) 0 )
+#define qsetbenchSELECT_FROM_SET		( ( void * ) 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Create the receiving tasks at uxPriority.  Returns the heap used.
+ */
+static size_t prvCreateReceivers( void *pvMechanism, unsigned portBASE_TYPE uxMembers, unsigned portBASE_TYPE uxPriority );
+
+/*
+ * Delete the receiving tasks, and wait for the idle task to free them.
+ */
+static void prvDeleteReceivers( void );
+
+/*
+ * Time qsetbenchITEMS items sent one at a time to higher priority receivers.
+ */
+static unsigned long prvTimeToBlockedReceivers( void *pvMechanism, unsigned portBASE_TYPE uxMembers, size_t *pxHeapUsed );
+
+/*
+ * Time qsetbenchBURSTS bursts that fill every queue, drained by lower
+ * priority receivers.
+ */
+static unsigned long prvTimeBursts( void *pvMechanism, unsigned portBASE_TYPE uxMembers );
+
+/*
+ * Receives from the queue whose index is passed in as the parameter.
+ */
+static void prvQueueReceiver( void *pvParameters );
+
+/*
+ * Receives from every queue by selecting from xSet.
+ */
+static void prvSetReceiver( void *pvParameters );
+
+/*
+ * Check an item received, and count it.  The last item of a burst records
+ * the time at which it was received.
+ */
+static void prvCheckItem( unsigned long ulItem );
+
+/*-----------------------------------------------------------*/
+
+static xQueueHandle xQueues[ qsetbenchMAX_MEMBERS ];
+static xTaskHandle xReceivers[ qsetbenchMAX_MEMBERS ];
+static xQueueSetHandle xSet = NULL;
+
+/* The value expected next from each queue, and the number of items received
+from all the queues. */
+static unsigned long ulExpected[ qsetbenchMAX_MEMBERS ];
+static volatile unsigned long ulItemsReceived = 0UL;
+static volatile unsigned long ulItemsExpected = 0UL;
+static volatile unsigned long ulLastItemTime = 0UL;
+
+/*-----------------------------------------------------------*/
+
+void vRunQueueSetBenchmark( void )
+{
+unsigned portBASE_TYPE uxMembers, uxQueue;
+unsigned long ulTaskTime, ulSetTime;
+size_t xTaskHeap, xSetHeap;
+
+	benchPRINTF( "Queue set benchmark: times in %s per item, heap in bytes\r\n", benchTIMESTAMP_UNITS );
+
+	/* Let the idle task free any tasks deleted before the benchmark, so the
+	heap measurements only include the receivers. */
+	vTaskDelay( ( portTickType ) 10 );
+
+	for( uxMembers = 1; uxMembers <= qsetbenchMAX_MEMBERS; uxMembers = ( uxMembers < 8 ) ? ( uxMembers * 8 ) : ( uxMembers * 2 ) )
+	{
+		for( uxQueue = 0; uxQueue < uxMembers; uxQueue++ )
+		{
+			xQueues[ uxQueue ] = xQueueCreate( qsetbenchQUEUE_LENGTH, sizeof( unsigned long ) );
+			configASSERT( xQueues[ uxQueue ] );
+		}
+
+		ulTaskTime = prvTimeToBlockedReceivers( qsetbenchTASK_PER_QUEUE, uxMembers, &xTaskHeap );
+		ulSetTime = prvTimeToBlockedReceivers( qsetbenchSELECT_FROM_SET, uxMembers, &xSetHeap );
+		benchPRINTF( "  %2u queues: heap task per queue %6u, select from set %6u\r\n", ( unsigned int ) uxMembers, ( unsigned int ) xTaskHeap, ( unsigned int ) xSetHeap );
+		benchPRINTF( "             to blocked receiver: task per queue %6lu, select from set %6lu\r\n", ulTaskTime, ulSetTime );
+
+		ulTaskTime = prvTimeBursts( qsetbenchTASK_PER_QUEUE, uxMembers );
+		ulSetTime = prvTimeBursts( qsetbenchSELECT_FROM_SET, uxMembers );
+		benchPRINTF( "             burst to every queue: task per queue %6lu, select from set %6lu\r\n", ulTaskTime, ulSetTime );
+
+		for( uxQueue = 0; uxQueue < uxMembers; uxQueue++ )
+		{
+			vQueueDelete( xQueues[ uxQueue ] );
+			xQueues[ uxQueue ] = NULL;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCreateReceivers( void *pvMechanism, unsigned portBASE_TYPE uxMembers, unsigned portBASE_TYPE uxPriority )
+{
+unsigned portBASE_TYPE uxQueue;
+size_t xFreeBefore;
+
+	xFreeBefore = xPortGetFreeHeapSize();
+
+	for( uxQueue = 0; uxQueue < uxMembers; uxQueue++ )
+	{
+		ulExpected[ uxQueue ] = 0UL;
+		xReceivers[ uxQueue ] = NULL;
+	}
+	ulItemsReceived = 0UL;
+	ulItemsExpected = 0UL;
+
+	if( pvMechanism == qsetbenchTASK_PER_QUEUE )
+	{
+		for( uxQueue = 0; uxQueue < uxMembers; uxQueue++ )
+		{
+			xTaskCreate( prvQueueReceiver, ( signed char * ) "QSRx", configMINIMAL_STACK_SIZE, ( void * ) uxQueue, uxPriority, &( xReceivers[ uxQueue ] ) );
+			configASSERT( xReceivers[ uxQueue ] );
+		}
+	}
+	else
+	{
+		/* The length is only needed by sets that hold an event per item. */
+		xSet = xQueueCreateSet( uxMembers * qsetbenchQUEUE_LENGTH );
+		configASSERT( xSet );
+
+		for( uxQueue = 0; uxQueue < uxMembers; uxQueue++ )
+		{
+			( void ) xQueueAddToSet( xQueues[ uxQueue ], xSet );
+		}
+
+		xTaskCreate( prvSetReceiver, ( signed char * ) "QSSel", configMINIMAL_STACK_SIZE, NULL, uxPriority, &( xReceivers[ 0 ] ) );
+		configASSERT( xReceivers[ 0 ] );
+	}
+
+	/* Let the receivers start and block. */
+	vTaskDelay( ( portTickType ) 2 );
+
+	return xFreeBefore - xPortGetFreeHeapSize();
+}
+/*-----------------------------------------------------------*/
+
+static void prvDeleteReceivers( void )
+{
+unsigned portBASE_TYPE uxQueue;
+
+	for( uxQueue = 0; uxQueue < qsetbenchMAX_MEMBERS; uxQueue++ )
+	{
+		if( xReceivers[ uxQueue ] != NULL )
+		{
+			vTaskDelete( xReceivers[ uxQueue ] );
+			xReceivers[ uxQueue ] = NULL;
+		}
+
+		/* A set must not be deleted while it has members. */
+		if( ( xSet != NULL ) && ( xQueues[ uxQueue ] != NULL ) )
+		{
+			( void ) xQueueRemoveFromSet( xQueues[ uxQueue ], xSet );
+		}
+	}
+
+	if( xSet != NULL )
+	{
+		vQueueDelete( xSet );
+		xSet = NULL;
+	}
+
+	vTaskDelay( ( portTickType ) 10 );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeToBlockedReceivers( void *pvMechanism, unsigned portBASE_TYPE uxMembers, size_t *pxHeapUsed )
+{
+unsigned long ulItem, ulValue, ulStart, ulElapsed;
+unsigned long ulNext[ qsetbenchMAX_MEMBERS ] = { 0UL };
+unsigned portBASE_TYPE uxQueue = 0, uxPriority;
+
+	/* The receivers run as soon as an item is sent, so this task runs below
+	them for the measurement. */
+	uxPriority = uxTaskPriorityGet( NULL );
+	vTaskPrioritySet( NULL, tskIDLE_PRIORITY + 1 );
+	*pxHeapUsed = prvCreateReceivers( pvMechanism, uxMembers, tskIDLE_PRIORITY + 2 );
+
+	ulStart = benchGET_TIMESTAMP();
+
+	for( ulItem = 0UL; ulItem < qsetbenchITEMS; ulItem++ )
+	{
+		/* Step through the queues in an order that is not the order in which
+		they were created. */
+		uxQueue = ( uxQueue + 7 ) % uxMembers;
+		ulValue = ( ulNext[ uxQueue ] << qsetbenchINDEX_BITS ) | ( unsigned long ) uxQueue;
+		( void ) xQueueSend( xQueues[ uxQueue ], &ulValue, portMAX_DELAY );
+		ulNext[ uxQueue ]++;
+	}
+
+	ulElapsed = benchGET_TIMESTAMP() - ulStart;
+	configASSERT( ulItemsReceived == qsetbenchITEMS );
+
+	vTaskPrioritySet( NULL, uxPriority );
+	prvDeleteReceivers();
+
+	return ulElapsed / qsetbenchITEMS;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeBursts( void *pvMechanism, unsigned portBASE_TYPE uxMembers )
+{
+unsigned long ulBurst, ulStart, ulElapsed = 0UL, ulValue, ulNext = 0UL, ulItems = 0UL;
+unsigned portBASE_TYPE uxQueue, uxItem;
+
+	( void ) prvCreateReceivers( pvMechanism, uxMembers, tskIDLE_PRIORITY + 1 );
+
+	for( ulBurst = 0UL; ulBurst < qsetbenchBURSTS; ulBurst++ )
+	{
+		ulItems += uxMembers * qsetbenchQUEUE_LENGTH;
+		ulItemsExpected = ulItems;
+
+		/* Time from the first item sent to the last item received, but not
+		the time this task spends waiting for a tick once it has blocked. */
+		ulStart = benchGET_TIMESTAMP();
+
+		for( uxItem = 0; uxItem < qsetbenchQUEUE_LENGTH; uxItem++ )
+		{
+			for( uxQueue = 0; uxQueue < uxMembers; uxQueue++ )
+			{
+				ulValue = ( ulNext << qsetbenchINDEX_BITS ) | ( unsigned long ) uxQueue;
+				( void ) xQueueSend( xQueues[ uxQueue ], &ulValue, 0 );
+			}
+
+			ulNext++;
+		}
+
+		/* Wait for the receivers to empty every queue. */
+		while( ulItemsReceived < ulItems )
+		{
+			vTaskDelay( ( portTickType ) 1 );
+		}
+
+		ulElapsed += ulLastItemTime - ulStart;
+	}
+
+	prvDeleteReceivers();
+
+	return ulElapsed / ulItems;
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueReceiver( void *pvParameters )
+{
+unsigned portBASE_TYPE uxQueue = ( unsigned portBASE_TYPE ) pvParameters;
+unsigned long ulItem;
+
+	for( ;; )
+	{
+		if( xQueueReceive( xQueues[ uxQueue ], &ulItem, portMAX_DELAY ) == pdPASS )
+		{
+			configASSERT( ( ulItem & qsetbenchINDEX_MASK ) == uxQueue );
+			prvCheckItem( ulItem );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetReceiver( void *pvParameters )
+{
+xQueueSetMemberHandle xMember;
+unsigned long ulItem;
+portBASE_TYPE xReceived;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		xMember = xQueueSelectFromSet( xSet, portMAX_DELAY );
+
+		if( xMember != NULL )
+		{
+			/* The member selected must contain data. */
+			xReceived = xQueueReceive( xMember, &ulItem, 0 );
+			configASSERT( xReceived == pdPASS );
+			( void ) xReceived;
+			configASSERT( xQueues[ ulItem & qsetbenchINDEX_MASK ] == xMember );
+			prvCheckItem( ulItem );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckItem( unsigned long ulItem )
+{
+unsigned long ulQueue = ulItem & qsetbenchINDEX_MASK;
+
+	/* The items from each queue must arrive in the order they were sent. */
+	configASSERT( ulQueue < qsetbenchMAX_MEMBERS );
+	configASSERT( ( ulItem >> qsetbenchINDEX_BITS ) == ulExpected[ ulQueue ] );
+	ulExpected[ ulQueue ]++;
+
+	ulItemsReceived++;
+	if( ulItemsReceived == ulItemsExpected )
+	{
+		ulLastItemTime = benchGET_TIMESTAMP();
+	}
+}
+/*-----------------------------------------------------------*/
+
+#else /* configUSE_QUEUE_SETS */
+
+void vRunQueueSetBenchmark( void )
+{
+	benchPRINTF( "Queue set benchmark: configUSE_QUEUE_SETS is 0\r\n" );
+}
+
+#endif /* configUSE_QUEUE_SETS */
+
@@ -0,0 +1,198 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Compares the time taken to read the statistics of every task with
+ * uxTaskGetSystemState(), which holds the scheduler suspended while it walks
+ * the task lists, and with uxTaskGetSnapshot(), which copies the table the
+ * kernel maintains as tasks are created, deleted, change priority and are
+ * switched out, and never suspends the scheduler.
+ *
+ * Build with configUSE_TASK_SNAPSHOT set to 0 to measure the cost the table
+ * adds to each context switch, using the stack check benchmark.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "SnapshotBench.h"
+
+/* The number of times each function is timed. */
+#define ssbenchREADS				( 1000UL )
+
+/* The number of suspended tasks created so there is more than the benchmark
+and idle tasks to report. */
+#define ssbenchEXTRA_TASKS			( 8 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The tasks created to be reported.  Each suspends itself.
+ */
+static void prvIdleReportedTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+void vRunSnapshotBenchmark( void )
+{
+xTaskStatusType *pxStatusArray;
+unsigned portBASE_TYPE uxTasks, uxArraySize;
+unsigned long ulRead, ulStart, ulSystemState = 0UL;
+configRUN_TIME_COUNTER_TYPE xTotalRunTime;
+xTaskHandle xExtraTasks[ ssbenchEXTRA_TASKS ];
+portBASE_TYPE xTask;
+
+	for( xTask = 0; xTask < ssbenchEXTRA_TASKS; xTask++ )
+	{
+		xTaskCreate( prvIdleReportedTask, ( signed char * ) "SSTsk", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &( xExtraTasks[ xTask ] ) );
+		configASSERT( xExtraTasks[ xTask ] );
+	}
+
+	uxTasks = uxTaskGetNumberOfTasks();
+	benchPRINTF( "Snapshot benchmark: %u tasks, times in %s\r\n", ( unsigned ) uxTasks, benchTIMESTAMP_UNITS );
+
+	/* Leave room for tasks created by the timer and test tasks while the
+	benchmark runs. */
+	uxArraySize = uxTasks + 8U;
+	pxStatusArray = pvPortMalloc( uxArraySize * sizeof( xTaskStatusType ) );
+	configASSERT( pxStatusArray );
+
+	for( ulRead = 0UL; ulRead < ssbenchREADS; ulRead++ )
+	{
+		ulStart = benchGET_TIMESTAMP();
+		( void ) uxTaskGetSystemState( pxStatusArray, uxArraySize, &xTotalRunTime );
+		ulSystemState += benchGET_TIMESTAMP() - ulStart;
+	}
+
+	benchPRINTF( "  uxTaskGetSystemState(), scheduler suspended: %6lu\r\n", ulSystemState / ssbenchREADS );
+
+	vPortFree( pxStatusArray );
+
+	#if ( configUSE_TASK_SNAPSHOT == 1 )
+	{
+	xTaskSnapshotType *pxSnapshotArray;
+	unsigned long ulSnapshot = 0UL;
+	unsigned portBASE_TYPE uxSnapshotTasks = 0U, x;
+	portBASE_TYPE xFoundSelf = pdFALSE;
+
+		pxSnapshotArray = pvPortMalloc( configTASK_SNAPSHOT_SLOTS * sizeof( xTaskSnapshotType ) );
+		configASSERT( pxSnapshotArray );
+
+		for( ulRead = 0UL; ulRead < ssbenchREADS; ulRead++ )
+		{
+			ulStart = benchGET_TIMESTAMP();
+			uxSnapshotTasks = uxTaskGetSnapshot( pxSnapshotArray, configTASK_SNAPSHOT_SLOTS, &xTotalRunTime );
+			ulSnapshot += benchGET_TIMESTAMP() - ulStart;
+		}
+
+		benchPRINTF( "  uxTaskGetSnapshot(), scheduler running:      %6lu\r\n", ulSnapshot / ssbenchREADS );
+
+		/* The table holds every task, as it has more entries than there are
+		tasks, and it holds this task at the priority this task is running
+		at. */
+		if( uxTasks < ( unsigned portBASE_TYPE ) configTASK_SNAPSHOT_SLOTS )
+		{
+			configASSERT( uxSnapshotTasks == uxTaskGetNumberOfTasks() );
+		}
+
+		for( x = 0U; x < uxSnapshotTasks; x++ )
+		{
+			if( pxSnapshotArray[ x ].xHandle == xTaskGetCurrentTaskHandle() )
+			{
+				configASSERT( pxSnapshotArray[ x ].uxCurrentPriority == uxTaskPriorityGet( NULL ) );
+				xFoundSelf = pdTRUE;
+			}
+		}
+
+		configASSERT( xFoundSelf == pdTRUE );
+		( void ) xFoundSelf;
+
+		vPortFree( pxSnapshotArray );
+	}
+	#endif /* configUSE_TASK_SNAPSHOT */
+
+	for( xTask = 0; xTask < ssbenchEXTRA_TASKS; xTask++ )
+	{
+		vTaskDelete( xExtraTasks[ xTask ] );
+	}
+
+	/* Let the idle task free the deleted tasks. */
+	vTaskDelay( 2 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvIdleReportedTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,128 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Measures the time vTaskSwitchContext() takes with whichever stack overflow
+ * check the kernel was built with.  Build with configCHECK_FOR_STACK_OVERFLOW
+ * set to each of 0 to 4 to compare the methods.  Methods 3 and 4 also check
+ * every stack from the idle task once each configSTACK_GUARD_SCAN_PERIOD
+ * ticks, which is not measured here as it only uses time that would otherwise
+ * be idle.
+ *
+ * vTaskSwitchContext() is called directly from a critical section while this
+ * task is the only task at its priority, so it is selected again.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "StackCheckBench.h"
+
+/* The number of times vTaskSwitchContext() is timed. */
+#define scbenchSWITCHES				( 10000UL )
+
+/* The priority of this task while it is measured.  No other task can run at
+this priority during the benchmark. */
+#define scbenchPRIORITY				( tskIDLE_PRIORITY + 1 )
+
+/*-----------------------------------------------------------*/
+
+void vRunStackCheckBenchmark( void )
+{
+unsigned portBASE_TYPE uxOriginalPriority;
+unsigned long ulSwitches, ulStart, ulTotal = 0UL, ulOverhead = 0UL;
+
+	benchPRINTF( "Stack check benchmark: configCHECK_FOR_STACK_OVERFLOW %d, times in %s\r\n", ( int ) configCHECK_FOR_STACK_OVERFLOW, benchTIMESTAMP_UNITS );
+
+	uxOriginalPriority = uxTaskPriorityGet( NULL );
+	vTaskPrioritySet( NULL, scbenchPRIORITY );
+
+	for( ulSwitches = 0UL; ulSwitches < scbenchSWITCHES; ulSwitches++ )
+	{
+		taskENTER_CRITICAL();
+		{
+			ulStart = benchGET_TIMESTAMP();
+			ulOverhead += benchGET_TIMESTAMP() - ulStart;
+
+			ulStart = benchGET_TIMESTAMP();
+			vTaskSwitchContext();
+			ulTotal += benchGET_TIMESTAMP() - ulStart;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	if( ulTotal < ulOverhead )
+	{
+		ulTotal = ulOverhead;
+	}
+
+	benchPRINTF( "  vTaskSwitchContext():            %6lu\r\n", ( ulTotal - ulOverhead ) / scbenchSWITCHES );
+
+	vTaskPrioritySet( NULL, uxOriginalPriority );
+}
+/*-----------------------------------------------------------*/
+
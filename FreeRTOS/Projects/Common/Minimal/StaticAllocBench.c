@@ -0,0 +1,419 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Compares creating and deleting kernel objects in memory provided by the
+ * application with creating and deleting them in memory allocated from the
+ * FreeRTOS heap.  Tasks, queues, mutexes, binary and counting semaphores and
+ * software timers are each created and deleted sabenchCYCLES times both ways,
+ * and the average and worst case times of the create and delete calls are
+ * reported.
+ *
+ * The free heap size is checked before and after the objects are created
+ * statically to show that doing so does not use the heap, and the heap used
+ * by one of each dynamically created object is reported.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "timers.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "StaticAllocBench.h"
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+/* The number of times each object is created and deleted. */
+#define sabenchCYCLES				( 100UL )
+
+/* The size of the queue that is created. */
+#define sabenchQUEUE_LENGTH			( 8 )
+#define sabenchQUEUE_ITEM_SIZE		( sizeof( unsigned long ) )
+
+/* The kinds of object that are created. */
+typedef enum
+{
+	eSabenchTask = 0,
+	eSabenchQueue,
+	eSabenchMutex,
+	eSabenchBinary,
+	eSabenchCounting,
+	eSabenchTimer,
+	eSabenchKinds
+} eSabenchKind;
+
+/* The times measured for one kind of object created one way. */
+typedef struct xSABENCH_TIMES
+{
+	unsigned long ulCreateTotal;
+	unsigned long ulCreateMax;
+	unsigned long ulDeleteTotal;
+	unsigned long ulDeleteMax;
+} xSabenchTimes;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Create an object of kind eKind, in the static buffers if xStatic is
+ * pdTRUE, otherwise from the heap.  Returns the handle of the object.
+ */
+static void *prvCreate( eSabenchKind eKind, portBASE_TYPE xStatic );
+
+/*
+ * Delete an object created by prvCreate().
+ */
+static void prvDelete( eSabenchKind eKind, void *pvObject );
+
+/*
+ * Time sabenchCYCLES creates and deletes of objects of kind eKind.
+ */
+static void prvTimeKind( eSabenchKind eKind, portBASE_TYPE xStatic, xSabenchTimes *pxTimes );
+
+/*
+ * Let the idle task clean up deleted tasks, and the timer task process
+ * commands, before the memory they use is used again.
+ */
+static void prvLetKernelTasksRun( void );
+
+/*
+ * The task and timer that are created.  Neither ever runs.
+ */
+static void prvTask( void *pvParameters );
+static void prvTimerCallback( xTimerHandle xTimer );
+
+/*-----------------------------------------------------------*/
+
+/* The memory in which the objects are created statically. */
+static xStaticTaskType xTaskBuffer;
+static portSTACK_TYPE uxTaskStack[ configMINIMAL_STACK_SIZE ];
+static xStaticQueueType xQueueBuffer;
+static unsigned char ucQueueStorage[ sabenchQUEUE_LENGTH * sabenchQUEUE_ITEM_SIZE ];
+static xStaticSemaphoreType xSemaphoreBuffer;
+static xStaticTimerType xTimerBuffer;
+
+static const char * const pcKindNames[ eSabenchKinds ] = { "task", "queue", "mutex", "binary", "counting", "timer" };
+
+/*-----------------------------------------------------------*/
+
+void vRunStaticAllocBenchmark( void )
+{
+xSabenchTimes xDynamic, xStatic;
+void *pvObjects[ eSabenchKinds ];
+size_t xFreeBefore, xFreeAfter;
+unsigned portBASE_TYPE uxKind;
+
+	benchPRINTF( "Static allocation benchmark: average/max times in %s over %lu cycles\r\n", benchTIMESTAMP_UNITS, sabenchCYCLES );
+
+	for( uxKind = 0; uxKind < eSabenchKinds; uxKind++ )
+	{
+		prvTimeKind( ( eSabenchKind ) uxKind, pdFALSE, &xDynamic );
+		prvTimeKind( ( eSabenchKind ) uxKind, pdTRUE, &xStatic );
+
+		benchPRINTF( "  %-8s create: heap %6lu/%6lu static %6lu/%6lu  delete: heap %6lu/%6lu static %6lu/%6lu\r\n",
+						pcKindNames[ uxKind ],
+						xDynamic.ulCreateTotal / sabenchCYCLES, xDynamic.ulCreateMax,
+						xStatic.ulCreateTotal / sabenchCYCLES, xStatic.ulCreateMax,
+						xDynamic.ulDeleteTotal / sabenchCYCLES, xDynamic.ulDeleteMax,
+						xStatic.ulDeleteTotal / sabenchCYCLES, xStatic.ulDeleteMax );
+	}
+
+	/* One of each object created statically must not use the heap.  The
+	objects have to share the one semaphore buffer, so the semaphores are
+	created and deleted in turn. */
+	xFreeBefore = xPortGetFreeHeapSize();
+
+	for( uxKind = 0; uxKind < eSabenchKinds; uxKind++ )
+	{
+		pvObjects[ uxKind ] = prvCreate( ( eSabenchKind ) uxKind, pdTRUE );
+
+		if( ( uxKind == eSabenchMutex ) || ( uxKind == eSabenchBinary ) || ( uxKind == eSabenchCounting ) )
+		{
+			configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+			prvDelete( ( eSabenchKind ) uxKind, pvObjects[ uxKind ] );
+		}
+	}
+
+	xFreeAfter = xPortGetFreeHeapSize();
+	configASSERT( xFreeAfter == xFreeBefore );
+	prvDelete( eSabenchTask, pvObjects[ eSabenchTask ] );
+	prvDelete( eSabenchQueue, pvObjects[ eSabenchQueue ] );
+	prvDelete( eSabenchTimer, pvObjects[ eSabenchTimer ] );
+	prvLetKernelTasksRun();
+
+	benchPRINTF( "  heap used by static objects: %lu bytes\r\n", ( unsigned long ) ( xFreeBefore - xFreeAfter ) );
+
+	/* The same objects created dynamically. */
+	for( uxKind = 0; uxKind < eSabenchKinds; uxKind++ )
+	{
+		pvObjects[ uxKind ] = prvCreate( ( eSabenchKind ) uxKind, pdFALSE );
+	}
+
+	xFreeAfter = xPortGetFreeHeapSize();
+
+	for( uxKind = 0; uxKind < eSabenchKinds; uxKind++ )
+	{
+		prvDelete( ( eSabenchKind ) uxKind, pvObjects[ uxKind ] );
+	}
+
+	prvLetKernelTasksRun();
+	configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+
+	benchPRINTF( "  heap used by dynamic objects: %lu bytes\r\n", ( unsigned long ) ( xFreeBefore - xFreeAfter ) );
+}
+/*-----------------------------------------------------------*/
+
+static void *prvCreate( eSabenchKind eKind, portBASE_TYPE xStatic )
+{
+void *pvObject = NULL;
+xTaskHandle xTask = NULL;
+
+	switch( eKind )
+	{
+		case eSabenchTask:
+			/* Created at the idle priority so it never runs before it is
+			deleted. */
+			if( xStatic != pdFALSE )
+			{
+				xTaskCreateStatic( prvTask, ( signed char * ) "SAtsk", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, &xTask, uxTaskStack, &xTaskBuffer );
+			}
+			else
+			{
+				xTaskCreate( prvTask, ( signed char * ) "SAtsk", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, &xTask );
+			}
+			pvObject = ( void * ) xTask;
+			break;
+
+		case eSabenchQueue:
+			if( xStatic != pdFALSE )
+			{
+				pvObject = ( void * ) xQueueCreateStatic( sabenchQUEUE_LENGTH, sabenchQUEUE_ITEM_SIZE, ucQueueStorage, &xQueueBuffer );
+			}
+			else
+			{
+				pvObject = ( void * ) xQueueCreate( sabenchQUEUE_LENGTH, sabenchQUEUE_ITEM_SIZE );
+			}
+			break;
+
+		case eSabenchMutex:
+			if( xStatic != pdFALSE )
+			{
+				pvObject = ( void * ) xSemaphoreCreateMutexStatic( &xSemaphoreBuffer );
+			}
+			else
+			{
+				pvObject = ( void * ) xSemaphoreCreateMutex();
+			}
+			break;
+
+		case eSabenchBinary:
+			{
+			xSemaphoreHandle xSemaphore;
+
+				if( xStatic != pdFALSE )
+				{
+					vSemaphoreCreateBinaryStatic( xSemaphore, &xSemaphoreBuffer );
+				}
+				else
+				{
+					vSemaphoreCreateBinary( xSemaphore );
+				}
+				pvObject = ( void * ) xSemaphore;
+			}
+			break;
+
+		case eSabenchCounting:
+			if( xStatic != pdFALSE )
+			{
+				pvObject = ( void * ) xSemaphoreCreateCountingStatic( sabenchQUEUE_LENGTH, 0, &xSemaphoreBuffer );
+			}
+			else
+			{
+				pvObject = ( void * ) xSemaphoreCreateCounting( sabenchQUEUE_LENGTH, 0 );
+			}
+			break;
+
+		case eSabenchTimer:
+			if( xStatic != pdFALSE )
+			{
+				pvObject = ( void * ) xTimerCreateStatic( ( signed char * ) "SAtmr", portMAX_DELAY, pdFALSE, NULL, prvTimerCallback, &xTimerBuffer );
+			}
+			else
+			{
+				pvObject = ( void * ) xTimerCreate( ( signed char * ) "SAtmr", portMAX_DELAY, pdFALSE, NULL, prvTimerCallback );
+			}
+			break;
+
+		default:
+			break;
+	}
+
+	configASSERT( pvObject );
+	return pvObject;
+}
+/*-----------------------------------------------------------*/
+
+static void prvDelete( eSabenchKind eKind, void *pvObject )
+{
+	switch( eKind )
+	{
+		case eSabenchTask:
+			vTaskDelete( ( xTaskHandle ) pvObject );
+			break;
+
+		case eSabenchTimer:
+			/* Deleting a timer posts a command to the timer task, so can only
+			fail if the timer command queue is full. */
+			if( xTimerDelete( ( xTimerHandle ) pvObject, portMAX_DELAY ) != pdPASS )
+			{
+				configASSERT( pdFALSE );
+			}
+			break;
+
+		default:
+			vQueueDelete( ( xQueueHandle ) pvObject );
+			break;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimeKind( eSabenchKind eKind, portBASE_TYPE xStatic, xSabenchTimes *pxTimes )
+{
+unsigned long ulCycle, ulStart, ulElapsed;
+void *pvObject;
+
+	pxTimes->ulCreateTotal = 0UL;
+	pxTimes->ulCreateMax = 0UL;
+	pxTimes->ulDeleteTotal = 0UL;
+	pxTimes->ulDeleteMax = 0UL;
+
+	for( ulCycle = 0UL; ulCycle < sabenchCYCLES; ulCycle++ )
+	{
+		ulStart = benchGET_TIMESTAMP();
+		pvObject = prvCreate( eKind, xStatic );
+		ulElapsed = benchGET_TIMESTAMP() - ulStart;
+
+		pxTimes->ulCreateTotal += ulElapsed;
+		if( ulElapsed > pxTimes->ulCreateMax )
+		{
+			pxTimes->ulCreateMax = ulElapsed;
+		}
+
+		ulStart = benchGET_TIMESTAMP();
+		prvDelete( eKind, pvObject );
+		ulElapsed = benchGET_TIMESTAMP() - ulStart;
+
+		pxTimes->ulDeleteTotal += ulElapsed;
+		if( ulElapsed > pxTimes->ulDeleteMax )
+		{
+			pxTimes->ulDeleteMax = ulElapsed;
+		}
+
+		/* A statically created task or timer is only finished with once the
+		idle task or timer task has processed its deletion. */
+		if( ( eKind == eSabenchTask ) || ( eKind == eSabenchTimer ) )
+		{
+			prvLetKernelTasksRun();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvLetKernelTasksRun( void )
+{
+	/* The timer task has the same priority as this task, so runs when this
+	task blocks.  The idle task then runs as nothing else is ready. */
+	vTaskDelay( 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( xTimerHandle xTimer )
+{
+	( void ) xTimer;
+}
+/*-----------------------------------------------------------*/
+
+#else /* configSUPPORT_STATIC_ALLOCATION */
+
+void vRunStaticAllocBenchmark( void )
+{
+	benchPRINTF( "Static allocation benchmark: configSUPPORT_STATIC_ALLOCATION is 0\r\n" );
+}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
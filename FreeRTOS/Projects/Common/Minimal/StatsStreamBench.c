@@ -0,0 +1,259 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Compares the report written by xTaskGetStatsStream() with the text tables
+ * written by vTaskList() and vTaskGetRunTimeStats(), in bytes and in the time
+ * taken to write them.  The first binary report holds the name of every task,
+ * later reports only the names of new tasks.
+ *
+ * The frames of each binary report are checked: every checksum must be
+ * correct, the report frame must count the task frames that follow it, and
+ * this task must be reported as running.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "StatsStreamBench.h"
+
+#if ( configUSE_STATS_STREAM == 1 )
+
+/* The number of times each report is timed. */
+#define xsbenchREPORTS				( 200UL )
+
+/* The number of suspended tasks created so there is more than the benchmark
+and idle tasks to report. */
+#define xsbenchEXTRA_TASKS			( 8 )
+
+/* The most tasks expected while the benchmark runs, which sizes the
+buffers. */
+#define xsbenchMAX_TASKS			( 48 )
+
+/* vTaskList() and vTaskGetRunTimeStats() each need about 40 bytes per
+task. */
+#define xsbenchTEXT_BUFFER_SIZE		( xsbenchMAX_TASKS * 40 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The tasks created to be reported.  Each suspends itself.
+ */
+static void prvIdleReportedTask( void *pvParameters );
+
+/*
+ * Checks the frames of the report in pucReport.  Returns the number of name
+ * frames it holds.
+ */
+static unsigned portBASE_TYPE prvCheckReport( const unsigned char *pucReport, size_t xLength );
+
+/*-----------------------------------------------------------*/
+
+static signed char cTextBuffer[ xsbenchTEXT_BUFFER_SIZE ];
+static unsigned char ucReport[ tskSTATS_STREAM_BUFFER_SIZE( xsbenchMAX_TASKS ) ];
+
+/*-----------------------------------------------------------*/
+
+void vRunStatsStreamBenchmark( void )
+{
+xTaskStatsStreamType xStream;
+xTaskHandle xExtraTasks[ xsbenchEXTRA_TASKS ];
+portBASE_TYPE xTask;
+unsigned portBASE_TYPE uxTasks;
+unsigned long ulReport, ulStart, ulText = 0UL, ulBinary = 0UL;
+size_t xTextLength = 0, xFirstLength, xLength = 0;
+
+	for( xTask = 0; xTask < xsbenchEXTRA_TASKS; xTask++ )
+	{
+		xTaskCreate( prvIdleReportedTask, ( signed char * ) "XSTsk", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &( xExtraTasks[ xTask ] ) );
+		configASSERT( xExtraTasks[ xTask ] );
+	}
+
+	uxTasks = uxTaskGetNumberOfTasks();
+	configASSERT( uxTasks <= xsbenchMAX_TASKS );
+	benchPRINTF( "Stats stream benchmark: %u tasks, times in %s\r\n", ( unsigned ) uxTasks, benchTIMESTAMP_UNITS );
+
+	for( ulReport = 0UL; ulReport < xsbenchREPORTS; ulReport++ )
+	{
+		ulStart = benchGET_TIMESTAMP();
+		vTaskList( cTextBuffer );
+		xTextLength = strlen( ( char * ) cTextBuffer );
+		vTaskGetRunTimeStats( cTextBuffer );
+		xTextLength += strlen( ( char * ) cTextBuffer );
+		ulText += benchGET_TIMESTAMP() - ulStart;
+	}
+
+	/* The first report names every task. */
+	memset( &xStream, 0x00, sizeof( xStream ) );
+	xFirstLength = xTaskGetStatsStream( &xStream, ucReport, sizeof( ucReport ) );
+	configASSERT( prvCheckReport( ucReport, xFirstLength ) == uxTaskGetNumberOfTasks() );
+
+	for( ulReport = 0UL; ulReport < xsbenchREPORTS; ulReport++ )
+	{
+		ulStart = benchGET_TIMESTAMP();
+		xLength = xTaskGetStatsStream( &xStream, ucReport, sizeof( ucReport ) );
+		ulBinary += benchGET_TIMESTAMP() - ulStart;
+	}
+
+	/* No task has been created since, so no names are sent. */
+	configASSERT( prvCheckReport( ucReport, xLength ) == 0U );
+	configASSERT( xStream.usSequence == ( unsigned short ) ( xsbenchREPORTS + 1UL ) );
+
+	/* Nothing is written if the buffer might be too small. */
+	configASSERT( xTaskGetStatsStream( &xStream, ucReport, tskSTATS_STREAM_BUFFER_SIZE( uxTaskGetNumberOfTasks() ) - 1U ) == 0U );
+
+	benchPRINTF( "  vTaskList() and vTaskGetRunTimeStats(): %5u bytes %8lu\r\n", ( unsigned ) xTextLength, ulText / xsbenchREPORTS );
+	benchPRINTF( "  xTaskGetStatsStream(), with names:      %5u bytes\r\n", ( unsigned ) xFirstLength );
+	benchPRINTF( "  xTaskGetStatsStream(), without names:   %5u bytes %8lu\r\n", ( unsigned ) xLength, ulBinary / xsbenchREPORTS );
+
+	for( xTask = 0; xTask < xsbenchEXTRA_TASKS; xTask++ )
+	{
+		vTaskDelete( xExtraTasks[ xTask ] );
+	}
+
+	/* Let the idle task free the deleted tasks. */
+	vTaskDelay( 2 );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned portBASE_TYPE prvCheckReport( const unsigned char *pucReport, size_t xLength )
+{
+size_t xOffset = 0, xByte;
+unsigned portBASE_TYPE uxTaskFrames = 0U, uxNameFrames = 0U, uxRunning = 0U;
+unsigned char ucSum;
+const unsigned char *pucFrame;
+
+	configASSERT( xLength > 0U );
+	configASSERT( pucReport[ 1 ] == tskSTATS_FRAME_REPORT );
+
+	while( xOffset < xLength )
+	{
+		pucFrame = &( pucReport[ xOffset ] );
+		configASSERT( pucFrame[ 0 ] == tskSTATS_FRAME_SYNC );
+
+		ucSum = 0U;
+
+		for( xByte = 1U; xByte < tskSTATS_FRAME_SIZE( pucFrame ); xByte++ )
+		{
+			ucSum = ( unsigned char ) ( ucSum + pucFrame[ xByte ] );
+		}
+
+		configASSERT( ucSum == 0U );
+
+		if( pucFrame[ 1 ] == tskSTATS_FRAME_TASK )
+		{
+			configASSERT( pucFrame[ 2 ] == tskSTATS_TASK_PAYLOAD );
+			uxTaskFrames++;
+
+			if( pucFrame[ 5 ] == ( unsigned char ) eRunning )
+			{
+				configASSERT( pucFrame[ 6 ] == ( unsigned char ) uxTaskPriorityGet( NULL ) );
+				uxRunning++;
+			}
+		}
+		else if( pucFrame[ 1 ] == tskSTATS_FRAME_NAME )
+		{
+			configASSERT( pucFrame[ 2 ] <= tskSTATS_NAME_PAYLOAD );
+			uxNameFrames++;
+		}
+
+		xOffset += tskSTATS_FRAME_SIZE( pucFrame );
+	}
+
+	configASSERT( xOffset == xLength );
+	configASSERT( uxTaskFrames == ( unsigned portBASE_TYPE ) pucReport[ 5 ] );
+	configASSERT( uxRunning == 1U );
+	( void ) uxTaskFrames;
+	( void ) uxRunning;
+
+	return uxNameFrames;
+}
+/*-----------------------------------------------------------*/
+
+static void prvIdleReportedTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#else /* configUSE_STATS_STREAM */
+
+void vRunStatsStreamBenchmark( void )
+{
+	benchPRINTF( "Stats stream benchmark: configUSE_STATS_STREAM is 0\r\n" );
+}
+
+#endif /* configUSE_STATS_STREAM */
+
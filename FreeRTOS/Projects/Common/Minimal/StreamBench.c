@@ -0,0 +1,291 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Compares a stream buffer with a queue of single characters when they are
+ * used to pass bytes from an interrupt to a task, as the UART drivers do.
+ *
+ * The interrupt is simulated by the task that runs the benchmark.  Each
+ * simulated interrupt delivers streambenchBURST_LENGTH bytes, the depth of a
+ * UART receive FIFO.  With the queue each byte is sent with its own call to
+ * xQueueSendFromISR() and received with its own call to xQueueReceive().  With
+ * the stream buffer the burst is sent with one call to
+ * xStreamBufferSendFromISR(), and the receiving task is only unblocked once
+ * streambenchTRIGGER_LEVEL bytes are waiting, then reads them all at once.
+ *
+ * The cost of each is measured twice.  First the interrupt side alone, with
+ * no task waiting for the data.  Then from the interrupt to a higher priority
+ * task that is blocked waiting for the data, which includes unblocking the
+ * task and switching to it.  All times are per byte.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "StreamBench.h"
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+/* The number of bytes passed for each measurement. */
+#define streambenchBYTES				( 64000UL )
+
+/* The number of bytes delivered by each simulated interrupt, and the number
+of bytes that must be waiting before the stream buffer unblocks the task. */
+#define streambenchBURST_LENGTH			( 8 )
+#define streambenchTRIGGER_LEVEL		( 16 )
+
+/* The capacity of both the queue and the stream buffer, in bytes. */
+#define streambenchBUFFER_LENGTH		( 128 )
+
+/* Used to select the mechanism used by the receiving task. */
+#define streambenchUSE_QUEUE			( ( void * ) 0 )
+#define streambenchUSE_STREAM_BUFFER	( ( void * ) 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task that receives the bytes when the cost of unblocking a task is
+ * being measured.  Its parameter selects the mechanism.
+ */
+static void prvStreamBenchReceiver( void *pvParameters );
+
+/*
+ * Simulate one receive interrupt by sending a burst of bytes with the
+ * selected mechanism.  Returns pdTRUE if a task was woken.
+ */
+static portBASE_TYPE prvSimulateInterrupt( void *pvMechanism );
+
+/*
+ * Time streambenchBYTES bytes sent from the simulated interrupt with no task
+ * waiting to receive them.  The bytes are drained between interrupts but the
+ * draining is not timed.
+ */
+static unsigned long prvTimeInterruptOnly( void *pvMechanism );
+
+/*
+ * Time streambenchBYTES bytes sent from the simulated interrupt to a receiving
+ * task that has a higher priority than the calling task.
+ */
+static unsigned long prvTimeToTask( void *pvMechanism );
+
+/*-----------------------------------------------------------*/
+
+static xQueueHandle xBenchQueue = NULL;
+static xStreamBufferHandle xBenchStreamBuffer = NULL;
+static volatile unsigned long ulBytesReceived = 0UL;
+
+/*-----------------------------------------------------------*/
+
+void vRunStreamBenchmark( void )
+{
+unsigned long ulQueueTime, ulStreamTime;
+
+	benchPRINTF( "Stream buffer benchmark: %d byte bursts, times in %s per byte\r\n", streambenchBURST_LENGTH, benchTIMESTAMP_UNITS );
+
+	xBenchQueue = xQueueCreate( streambenchBUFFER_LENGTH, sizeof( char ) );
+	xBenchStreamBuffer = xStreamBufferCreate( streambenchBUFFER_LENGTH, streambenchTRIGGER_LEVEL );
+	configASSERT( xBenchQueue );
+	configASSERT( xBenchStreamBuffer );
+
+	ulQueueTime = prvTimeInterruptOnly( streambenchUSE_QUEUE );
+	ulStreamTime = prvTimeInterruptOnly( streambenchUSE_STREAM_BUFFER );
+	benchPRINTF( "  interrupt side only: queue %6lu stream buffer %6lu\r\n", ulQueueTime, ulStreamTime );
+
+	ulQueueTime = prvTimeToTask( streambenchUSE_QUEUE );
+	ulStreamTime = prvTimeToTask( streambenchUSE_STREAM_BUFFER );
+	benchPRINTF( "  interrupt to blocked task: queue %6lu stream buffer %6lu\r\n", ulQueueTime, ulStreamTime );
+
+	vQueueDelete( xBenchQueue );
+	vStreamBufferDelete( xBenchStreamBuffer );
+	xBenchQueue = NULL;
+	xBenchStreamBuffer = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvSimulateInterrupt( void *pvMechanism )
+{
+static const char cBurst[ streambenchBURST_LENGTH ] = { 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h' };
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE, xByte;
+
+	if( pvMechanism == streambenchUSE_QUEUE )
+	{
+		for( xByte = 0; xByte < streambenchBURST_LENGTH; xByte++ )
+		{
+			( void ) xQueueSendFromISR( xBenchQueue, &( cBurst[ xByte ] ), &xHigherPriorityTaskWoken );
+		}
+	}
+	else
+	{
+		( void ) xStreamBufferSendFromISR( xBenchStreamBuffer, cBurst, sizeof( cBurst ), &xHigherPriorityTaskWoken );
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeInterruptOnly( void *pvMechanism )
+{
+unsigned long ulBytes, ulStart, ulTotal = 0UL;
+char cBuffer[ streambenchBURST_LENGTH ];
+portBASE_TYPE xByte;
+
+	for( ulBytes = 0UL; ulBytes < streambenchBYTES; ulBytes += streambenchBURST_LENGTH )
+	{
+		ulStart = benchGET_TIMESTAMP();
+		( void ) prvSimulateInterrupt( pvMechanism );
+		ulTotal += benchGET_TIMESTAMP() - ulStart;
+
+		if( pvMechanism == streambenchUSE_QUEUE )
+		{
+			for( xByte = 0; xByte < streambenchBURST_LENGTH; xByte++ )
+			{
+				( void ) xQueueReceive( xBenchQueue, &( cBuffer[ xByte ] ), 0 );
+			}
+		}
+		else
+		{
+			( void ) xStreamBufferReceive( xBenchStreamBuffer, cBuffer, sizeof( cBuffer ), 0 );
+		}
+	}
+
+	return ulTotal / streambenchBYTES;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeToTask( void *pvMechanism )
+{
+unsigned long ulBytes, ulStart, ulElapsed;
+unsigned portBASE_TYPE uxOriginalPriority;
+xTaskHandle xReceiver = NULL;
+
+	/* The receiver runs at the priority of this task, which then drops its
+	own priority so the receiver runs as soon as it is unblocked. */
+	uxOriginalPriority = uxTaskPriorityGet( NULL );
+	configASSERT( uxOriginalPriority > tskIDLE_PRIORITY );
+
+	ulBytesReceived = 0UL;
+	xTaskCreate( prvStreamBenchReceiver, ( signed char * ) "SBRx", configMINIMAL_STACK_SIZE, pvMechanism, uxOriginalPriority, &xReceiver );
+	configASSERT( xReceiver );
+	vTaskPrioritySet( NULL, uxOriginalPriority - 1 );
+
+	/* The receiver has run and is now blocked. */
+	ulStart = benchGET_TIMESTAMP();
+
+	for( ulBytes = 0UL; ulBytes < streambenchBYTES; ulBytes += streambenchBURST_LENGTH )
+	{
+		/* As portEND_SWITCHING_ISR() at the end of an interrupt. */
+		if( prvSimulateInterrupt( pvMechanism ) != pdFALSE )
+		{
+			taskYIELD();
+		}
+	}
+
+	ulElapsed = benchGET_TIMESTAMP() - ulStart;
+
+	/* streambenchBYTES is a multiple of the trigger level, so every byte
+	should have been received before the last interrupt returned. */
+	configASSERT( ulBytesReceived == streambenchBYTES );
+
+	vTaskDelete( xReceiver );
+	vTaskPrioritySet( NULL, uxOriginalPriority );
+
+	return ulElapsed / streambenchBYTES;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStreamBenchReceiver( void *pvParameters )
+{
+char cBuffer[ streambenchTRIGGER_LEVEL ];
+
+	for( ;; )
+	{
+		if( pvParameters == streambenchUSE_QUEUE )
+		{
+			if( xQueueReceive( xBenchQueue, cBuffer, portMAX_DELAY ) == pdPASS )
+			{
+				ulBytesReceived++;
+			}
+		}
+		else
+		{
+			ulBytesReceived += xStreamBufferReceive( xBenchStreamBuffer, cBuffer, sizeof( cBuffer ), portMAX_DELAY );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+#else /* configUSE_TASK_NOTIFICATIONS */
+
+void vRunStreamBenchmark( void )
+{
+	benchPRINTF( "Stream buffer benchmark: configUSE_TASK_NOTIFICATIONS is 0\r\n" );
+}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+
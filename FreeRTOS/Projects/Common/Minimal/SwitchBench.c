@@ -0,0 +1,208 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Measures the time vTaskSwitchContext() takes to select the next task, using
+ * whichever of the generic and the port optimised task selection the kernel
+ * was built with.
+ *
+ * The generic selection searches down from the highest priority that has had
+ * a ready task since the last search, so its time grows with the number of
+ * empty priorities it passes.  The port optimised selection counts the
+ * leading zeros of the ready priority bitmap, so its time should not depend
+ * on where the ready tasks are.
+ *
+ * Before each measurement a task above this task's priority is readied and
+ * suspended again, so the generic search starts at that task's priority.
+ * vTaskSwitchContext() is then called directly from a critical section.  This
+ * task is the only task at its priority, so it is selected again.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "SwitchBench.h"
+
+/* The number of times vTaskSwitchContext() is timed at each priority. */
+#define sbenchSWITCHES				( 2000UL )
+
+/* The priority of this task while it is measured.  No other task can run at
+this priority during the benchmark. */
+#define sbenchBASE_PRIORITY			( tskIDLE_PRIORITY + 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the average time taken by vTaskSwitchContext() when the generic
+ * search starts at the priority of xHighTask.  The time taken to read the
+ * timestamp is subtracted.
+ */
+static unsigned long prvTimeSwitch( void );
+
+/*
+ * The task that is readied and suspended before each measurement.
+ */
+static void prvHighTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static xTaskHandle xHighTask = NULL;
+
+/*-----------------------------------------------------------*/
+
+void vRunSwitchBenchmark( void )
+{
+unsigned portBASE_TYPE uxOriginalPriority, uxPriority;
+
+	benchPRINTF( "Task switch benchmark: %s task selection, %u priorities, times in %s\r\n", ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 ) ? "port optimised" : "generic", ( unsigned ) configMAX_PRIORITIES, benchTIMESTAMP_UNITS );
+
+	configASSERT( configMAX_PRIORITIES > ( sbenchBASE_PRIORITY + 1 ) );
+
+	uxOriginalPriority = uxTaskPriorityGet( NULL );
+	vTaskPrioritySet( NULL, sbenchBASE_PRIORITY );
+
+	/* The task runs as soon as it is created, and suspends itself. */
+	xTaskCreate( prvHighTask, ( signed char * ) "SBHi", configMINIMAL_STACK_SIZE, NULL, sbenchBASE_PRIORITY + 1, &xHighTask );
+	configASSERT( xHighTask );
+
+	/* Double the distance searched each time, finishing at the highest
+	priority. */
+	uxPriority = sbenchBASE_PRIORITY + 1;
+
+	for( ;; )
+	{
+		vTaskPrioritySet( xHighTask, uxPriority );
+		benchPRINTF( "  search from %4u priorities above: %6lu\r\n", ( unsigned ) ( uxPriority - sbenchBASE_PRIORITY ), prvTimeSwitch() );
+
+		if( uxPriority == ( configMAX_PRIORITIES - 1 ) )
+		{
+			break;
+		}
+
+		uxPriority = sbenchBASE_PRIORITY + ( ( uxPriority - sbenchBASE_PRIORITY ) * 2 );
+
+		if( uxPriority > ( configMAX_PRIORITIES - 1 ) )
+		{
+			uxPriority = configMAX_PRIORITIES - 1;
+		}
+	}
+
+	vTaskDelete( xHighTask );
+	xHighTask = NULL;
+	vTaskPrioritySet( NULL, uxOriginalPriority );
+
+	/* Let the idle task free the deleted task. */
+	vTaskDelay( 2 );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeSwitch( void )
+{
+unsigned long ulSwitches, ulStart, ulTotal = 0UL, ulOverhead = 0UL;
+
+	for( ulSwitches = 0UL; ulSwitches < sbenchSWITCHES; ulSwitches++ )
+	{
+		taskENTER_CRITICAL();
+		{
+			/* The generic selection only lowers the priority it searches from
+			when it searches, so the search starts at the priority of the high
+			task.  The port optimised selection clears the bit of the high
+			task's priority when the task is suspended.  The yield requested
+			by the resume is performed when the critical section is exited,
+			and selects this task again. */
+			vTaskResume( xHighTask );
+			vTaskSuspend( xHighTask );
+
+			ulStart = benchGET_TIMESTAMP();
+			ulOverhead += benchGET_TIMESTAMP() - ulStart;
+
+			ulStart = benchGET_TIMESTAMP();
+			vTaskSwitchContext();
+			ulTotal += benchGET_TIMESTAMP() - ulStart;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	if( ulTotal < ulOverhead )
+	{
+		ulTotal = ulOverhead;
+	}
+
+	return ( ulTotal - ulOverhead ) / sbenchSWITCHES;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHighTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
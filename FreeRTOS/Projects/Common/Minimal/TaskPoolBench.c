@@ -0,0 +1,248 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Measures the time taken to create and delete tasks in the pattern of an
+ * application that creates short lived worker tasks.  Each round creates
+ * tpbenchWORKERS tasks with stacks of two depths, deletes them, then lets the
+ * idle task reclaim them.  With configUSE_TASK_POOL set to 1 the tasks created
+ * after the first round reuse the TCBs and stacks of the deleted tasks, so the
+ * heap is not used.  Otherwise every task is allocated from, and returned to,
+ * the heap.
+ *
+ * Before the rounds the heap is fragmented, as it would be by an application
+ * that has run for some time, by allocating small blocks and freeing every
+ * other one.  heap_2 and heap_4 search their lists of free blocks for one
+ * that is large enough, so each allocation passes every hole.
+ *
+ * The workers have a lower priority than the task that runs the benchmark, so
+ * they are deleted before they run.
+ *
+ * At the end the pool is flushed, as pvPortMalloc() does when the heap runs
+ * out, which must give all the memory it held back to the heap.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "TaskPoolBench.h"
+
+/* The number of tasks created and deleted in each round.  Half have each
+stack depth. */
+#define tpbenchWORKERS				( 8U )
+
+/* The number of rounds timed, after the first. */
+#define tpbenchROUNDS				( 100UL )
+
+/* The two stack depths used. */
+#define tpbenchSMALL_STACK			( configMINIMAL_STACK_SIZE )
+#define tpbenchLARGE_STACK			( configMINIMAL_STACK_SIZE * 2 )
+
+/* The priority of the workers, below that of the task running the
+benchmark. */
+#define tpbenchWORKER_PRIORITY		( tskIDLE_PRIORITY )
+
+/* The time the idle task is given to reclaim the deleted workers. */
+#define tpbenchRECLAIM_TICKS		( ( portTickType ) 2 )
+
+/* The number and size of the blocks allocated to fragment the heap.  Half are
+freed again, leaving holes too small for a TCB or stack. */
+#define tpbenchFRAGMENTS			( 200U )
+#define tpbenchFRAGMENT_SIZE		( ( size_t ) 16 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Creates and deletes the workers once, adding the time taken to create and
+ * to delete each worker to the totals, and raising the maxima if needed.
+ */
+static void prvRunRound( unsigned long *pulCreateTotal, unsigned long *pulCreateMax, unsigned long *pulDeleteTotal );
+
+/*
+ * The worker task, which is deleted before it runs.
+ */
+static void prvWorkerTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+void vRunTaskPoolBenchmark( void )
+{
+static void *pvFragments[ tpbenchFRAGMENTS ];
+unsigned long ulRound, ulCreateTotal = 0UL, ulCreateMax = 0UL, ulDeleteTotal = 0UL, ulFirstMax = 0UL;
+unsigned portBASE_TYPE uxFragment;
+size_t xFreeBefore;
+
+	benchPRINTF( "Task pool benchmark: %s, times in %s\r\n", ( configUSE_TASK_POOL == 1 ) ? "deleted tasks reused" : "every task allocated from the heap", benchTIMESTAMP_UNITS );
+
+	/* Let the idle task reclaim any task deleted before the benchmark. */
+	vTaskDelay( tpbenchRECLAIM_TICKS );
+
+	#if ( configUSE_TASK_POOL == 1 )
+	{
+		/* Start with an empty pool, so only the workers are counted in the
+		heap it holds. */
+		( void ) xTaskFlushTaskPool();
+	}
+	#endif /* configUSE_TASK_POOL */
+
+	for( uxFragment = 0U; uxFragment < tpbenchFRAGMENTS; uxFragment++ )
+	{
+		pvFragments[ uxFragment ] = pvPortMalloc( tpbenchFRAGMENT_SIZE );
+		configASSERT( pvFragments[ uxFragment ] );
+	}
+
+	for( uxFragment = 0U; uxFragment < tpbenchFRAGMENTS; uxFragment += 2U )
+	{
+		vPortFree( pvFragments[ uxFragment ] );
+	}
+
+	xFreeBefore = xPortGetFreeHeapSize();
+
+	/* The first round allocates from the heap whether or not the pool is
+	used, so is not included in the averages. */
+	prvRunRound( &ulCreateTotal, &ulFirstMax, &ulDeleteTotal );
+	ulCreateTotal = 0UL;
+	ulDeleteTotal = 0UL;
+
+	for( ulRound = 0UL; ulRound < tpbenchROUNDS; ulRound++ )
+	{
+		prvRunRound( &ulCreateTotal, &ulCreateMax, &ulDeleteTotal );
+	}
+
+	benchPRINTF( "  xTaskCreate(), first round max:  %6lu\r\n", ulFirstMax );
+	benchPRINTF( "  xTaskCreate(), later rounds avg: %6lu\r\n", ulCreateTotal / ( tpbenchROUNDS * tpbenchWORKERS ) );
+	benchPRINTF( "  xTaskCreate(), later rounds max: %6lu\r\n", ulCreateMax );
+	benchPRINTF( "  vTaskDelete(), later rounds avg: %6lu\r\n", ulDeleteTotal / ( tpbenchROUNDS * tpbenchWORKERS ) );
+	benchPRINTF( "  heap held after the rounds:      %6lu bytes\r\n", ( unsigned long ) ( xFreeBefore - xPortGetFreeHeapSize() ) );
+
+	#if ( configUSE_TASK_POOL == 1 )
+	{
+		configASSERT( xTaskFlushTaskPool() == pdTRUE );
+		configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+		benchPRINTF( "  heap held after the pool flush:  %6lu bytes\r\n", ( unsigned long ) ( xFreeBefore - xPortGetFreeHeapSize() ) );
+	}
+	#endif /* configUSE_TASK_POOL */
+
+	for( uxFragment = 1U; uxFragment < tpbenchFRAGMENTS; uxFragment += 2U )
+	{
+		vPortFree( pvFragments[ uxFragment ] );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunRound( unsigned long *pulCreateTotal, unsigned long *pulCreateMax, unsigned long *pulDeleteTotal )
+{
+xTaskHandle xWorkers[ tpbenchWORKERS ];
+unsigned short usStackDepth;
+unsigned long ulStart, ulElapsed;
+unsigned portBASE_TYPE uxWorker;
+signed portBASE_TYPE xCreated;
+
+	for( uxWorker = 0U; uxWorker < tpbenchWORKERS; uxWorker++ )
+	{
+		usStackDepth = ( ( uxWorker & 1U ) == 0U ) ? tpbenchSMALL_STACK : tpbenchLARGE_STACK;
+
+		ulStart = benchGET_TIMESTAMP();
+		xCreated = xTaskCreate( prvWorkerTask, ( signed char * ) "TPWrk", usStackDepth, NULL, tpbenchWORKER_PRIORITY, &( xWorkers[ uxWorker ] ) );
+		ulElapsed = benchGET_TIMESTAMP() - ulStart;
+
+		configASSERT( xCreated == pdPASS );
+		( void ) xCreated;
+
+		*pulCreateTotal += ulElapsed;
+
+		if( ulElapsed > *pulCreateMax )
+		{
+			*pulCreateMax = ulElapsed;
+		}
+	}
+
+	for( uxWorker = 0U; uxWorker < tpbenchWORKERS; uxWorker++ )
+	{
+		ulStart = benchGET_TIMESTAMP();
+		vTaskDelete( xWorkers[ uxWorker ] );
+		*pulDeleteTotal += benchGET_TIMESTAMP() - ulStart;
+	}
+
+	vTaskDelay( tpbenchRECLAIM_TICKS );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	/* Not reached, as the worker is deleted before it runs. */
+	configASSERT( pdFALSE );
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,234 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Measures the cost of the tick interrupt as the number of tasks in the
+ * Blocked state grows.  Build with configUSE_TIMING_WHEEL set to 0 and then
+ * to 1 to compare the sorted delayed lists with the timing wheel.
+ *
+ * Worker tasks are created at a priority below the task that runs the
+ * benchmark.  Each worker repeatedly blocks for a pseudo random number of
+ * ticks, so the blocked tasks are spread over both short and long delays.
+ * The benchmark then calls xTaskIncrementTick() from a critical section - as
+ * xTaskResumeAll() does when it processes ticks that were held pending - and
+ * times each call.  Every few ticks it blocks itself so the workers that were
+ * unblocked can run and block again, keeping the number of blocked tasks
+ * constant.
+ *
+ * The tick count is advanced faster than real time while the benchmark runs,
+ * so it must not be run at the same time as the standard demo tasks.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "TickBench.h"
+
+/* The largest number of blocked tasks measured.  Each worker needs a TCB and
+a minimal stack, so this will need reducing on the target. */
+#ifndef tickbenchMAX_BLOCKED_TASKS
+	#define tickbenchMAX_BLOCKED_TASKS	( 256 )
+#endif
+
+/* The number of ticks timed for each number of blocked tasks. */
+#define tickbenchSAMPLES				( 4000UL )
+
+/* The benchmark blocks for one tick after this many simulated ticks so the
+workers that were unblocked can block again. */
+#define tickbenchTICKS_PER_BATCH		( 4UL )
+
+/* Range of the delays used by the workers, in ticks.  The upper limit is
+beyond the span of the default timing wheel so both the wheel and the
+delayed lists are used. */
+#define tickbenchMIN_DELAY				( 1UL )
+#define tickbenchMAX_DELAY				( 2000UL )
+
+#define tickbenchWORKER_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The worker tasks.  Each blocks for pseudo random periods until
+ * xStopWorkers is set, then deletes itself.
+ */
+static void prvTickBenchWorker( void *pvParameters );
+
+/*
+ * A simple linear congruential generator, so the benchmark is repeatable.
+ */
+static unsigned long prvRand( unsigned long *pulSeed );
+
+/*-----------------------------------------------------------*/
+
+static volatile portBASE_TYPE xStopWorkers = pdFALSE;
+static volatile unsigned portBASE_TYPE uxRunningWorkers = 0;
+
+/*-----------------------------------------------------------*/
+
+void vRunTickBenchmark( void )
+{
+unsigned portBASE_TYPE uxBlockedTasks = 0, uxTarget = 0;
+unsigned long ulSample, ulStart, ulElapsed, ulTotal, ulMax;
+
+	benchPRINTF( "Tick benchmark: timing wheel %s, times in %s\r\n", ( configUSE_TIMING_WHEEL == 1 ) ? "on" : "off", benchTIMESTAMP_UNITS );
+
+	xStopWorkers = pdFALSE;
+
+	for( ;; )
+	{
+		/* Top up the number of workers to the next population size. */
+		while( uxBlockedTasks < uxTarget )
+		{
+			if( xTaskCreate( prvTickBenchWorker, ( signed char * ) "TBWrk", configMINIMAL_STACK_SIZE, ( void * ) uxBlockedTasks, tickbenchWORKER_PRIORITY, NULL ) != pdPASS )
+			{
+				break;
+			}
+
+			uxBlockedTasks++;
+		}
+
+		/* Let every worker start and block. */
+		vTaskDelay( ( portTickType ) 2 );
+
+		ulTotal = 0UL;
+		ulMax = 0UL;
+
+		for( ulSample = 0UL; ulSample < tickbenchSAMPLES; ulSample++ )
+		{
+			taskENTER_CRITICAL();
+			{
+				ulStart = benchGET_TIMESTAMP();
+				( void ) xTaskIncrementTick();
+				ulElapsed = benchGET_TIMESTAMP() - ulStart;
+			}
+			taskEXIT_CRITICAL();
+
+			ulTotal += ulElapsed;
+			if( ulElapsed > ulMax )
+			{
+				ulMax = ulElapsed;
+			}
+
+			if( ( ulSample % tickbenchTICKS_PER_BATCH ) == ( tickbenchTICKS_PER_BATCH - 1UL ) )
+			{
+				vTaskDelay( ( portTickType ) 1 );
+			}
+		}
+
+		benchPRINTF( "  %4u blocked tasks: tick avg %6lu max %8lu\r\n", ( unsigned int ) uxBlockedTasks, ulTotal / tickbenchSAMPLES, ulMax );
+
+		if( ( uxTarget >= tickbenchMAX_BLOCKED_TASKS ) || ( uxBlockedTasks < uxTarget ) )
+		{
+			/* Finished, or out of heap. */
+			break;
+		}
+
+		uxTarget = ( uxTarget == 0 ) ? 1 : ( uxTarget * 4 );
+		if( uxTarget > tickbenchMAX_BLOCKED_TASKS )
+		{
+			uxTarget = tickbenchMAX_BLOCKED_TASKS;
+		}
+	}
+
+	/* Remove the workers, and wait for the idle task to free them. */
+	xStopWorkers = pdTRUE;
+	while( uxRunningWorkers > 0 )
+	{
+		vTaskDelay( ( portTickType ) 10 );
+	}
+	vTaskDelay( ( portTickType ) 10 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTickBenchWorker( void *pvParameters )
+{
+unsigned long ulSeed = ( unsigned long ) pvParameters + 1UL;
+
+	taskENTER_CRITICAL();
+	uxRunningWorkers++;
+	taskEXIT_CRITICAL();
+
+	while( xStopWorkers == pdFALSE )
+	{
+		vTaskDelay( ( portTickType ) ( tickbenchMIN_DELAY + ( prvRand( &ulSeed ) % ( tickbenchMAX_DELAY - tickbenchMIN_DELAY ) ) ) );
+	}
+
+	taskENTER_CRITICAL();
+	uxRunningWorkers--;
+	taskEXIT_CRITICAL();
+
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRand( unsigned long *pulSeed )
+{
+	*pulSeed = ( *pulSeed * 1103515245UL ) + 12345UL;
+	return ( *pulSeed >> 16 ) & 0x7fffUL;
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,399 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * A host model of the tickless idle timer arithmetic used by the PIC32MX
+ * port.  Timer1 is replaced by a model of its TMR1 and PR1 registers and its
+ * interrupt flag, and vPortSuppressTicksAndSleep() and the tick interrupt are
+ * replayed against the model with the same ulPortTicklessCompleteTicks()
+ * that the port uses.
+ *
+ * Each run suppresses the tick thousands of times, for pseudo random numbers
+ * of tick periods, starting at pseudo random points within a tick period.
+ * Some sleeps last the full time, and others are ended early by another
+ * interrupt, including some that arrive within a few counts of a tick
+ * boundary.  A few counts of pseudo random delay are inserted between each
+ * step to model the time taken by the instructions.
+ *
+ * The tick count is compared with the time that has really passed, in timer
+ * counts, after every sleep.  Any drift, however small, accumulates over a
+ * long run and is reported as an error.
+ */
+
+#include <stdlib.h>
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+
+/* Port include files.  This only contains arithmetic, so can be included
+without the PIC32MX headers. */
+#include "TicklessSupport.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "TicklessModel.h"
+
+/* The number of times the tick is suppressed in each run. */
+#define tmodelSLEEPS				( 20000UL )
+
+/* The longest idle time requested, in tick periods.  This is longer than fits
+in PR1 for most of the configurations, so the clamp is also exercised. */
+#define tmodelMAX_IDLE_TICKS		( 100UL )
+
+/* The largest number of counts inserted between two steps.  This must be
+less than portTICKLESS_MARGIN_COUNTS for the model to pass. */
+#define tmodelMAX_LATENCY			( 2UL )
+
+/* Timer1 is a 16-bit timer. */
+#define tmodelTIMER_MAX				( 0xffffUL )
+
+/*-----------------------------------------------------------*/
+
+/* The modelled state of Timer1 and of the kernel tick count. */
+typedef struct TICKLESS_MODEL
+{
+	unsigned long ulTMR;			/* TMR1. */
+	unsigned long ulPR;				/* PR1. */
+	portBASE_TYPE xIF;				/* IFS0bits.T1IF. */
+	portBASE_TYPE xWrapped;			/* Set if TMR1 ever passed PR1 and wrapped. */
+	unsigned long ulCountsPerTick;
+	unsigned long ulMaxSuppressed;
+	unsigned long ulTime;			/* Counts since the model started. */
+	unsigned long ulTicks;			/* The kernel tick count. */
+	unsigned long ulTickInterrupts;	/* The number of times the tick interrupt ran. */
+} xTICKLESS_MODEL;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Advance the timer by ulCounts counts.  If xInterruptsEnabled is pdTRUE the
+ * tick interrupt runs as soon as the flag is set, otherwise the flag is left
+ * set.
+ */
+static void prvAdvance( xTICKLESS_MODEL *pxModel, unsigned long ulCounts, portBASE_TYPE xInterruptsEnabled );
+
+/*
+ * The tick interrupt, as vPortIncrementTick().
+ */
+static void prvTickInterrupt( xTICKLESS_MODEL *pxModel );
+
+/*
+ * One call of vPortSuppressTicksAndSleep() with the interrupt that ends the
+ * sleep, if any, ulWakeCounts counts after the processor waits.
+ */
+static void prvSuppressTicksAndSleep( xTICKLESS_MODEL *pxModel, unsigned long ulExpectedIdleTime, unsigned long ulWakeCounts );
+
+/*
+ * Run the model with a tick period of ulCountsPerTick counts.  Returns the
+ * number of sleeps that ended so close to a tick boundary that the tick count
+ * was briefly one ahead, and sets *pxPassed to pdFALSE if the tick count ever
+ * drifted.
+ */
+static unsigned long prvRunModel( xTICKLESS_MODEL *pxModel, unsigned long ulCountsPerTick, portBASE_TYPE *pxPassed );
+
+/*
+ * A small pseudo random number generator, so every run is the same.
+ */
+static unsigned long prvRand( unsigned long ulRange );
+
+/*-----------------------------------------------------------*/
+
+static unsigned long ulNextRand = 1UL;
+
+/* The tick periods modelled, in Timer1 counts.  The first is the Timer1
+period of the PIC32MX demos (10 MHz peripheral clock, 1:8 prescale, 1 kHz
+tick), the others use faster peripheral clocks or slower ticks. */
+static const unsigned long ulTickPeriods[] = { 1250UL, 625UL, 5000UL, 10000UL, 1024UL, 250UL };
+
+/*-----------------------------------------------------------*/
+
+void vRunTicklessModel( void )
+{
+xTICKLESS_MODEL xModel;
+unsigned long ulPeriod, ulAhead;
+portBASE_TYPE xPassed;
+
+	benchPRINTF( "Tickless idle model: %lu sleeps per tick period\r\n", tmodelSLEEPS );
+
+	for( ulPeriod = 0UL; ulPeriod < ( sizeof( ulTickPeriods ) / sizeof( ulTickPeriods[ 0 ] ) ); ulPeriod++ )
+	{
+		xPassed = pdTRUE;
+		ulAhead = prvRunModel( &xModel, ulTickPeriods[ ulPeriod ], &xPassed );
+
+		benchPRINTF( "  %5lu counts per tick: %3lu max suppressed, %8lu ticks, %7lu tick interrupts, %4lu briefly ahead, drift %ld ticks %s\r\n",
+						ulTickPeriods[ ulPeriod ], xModel.ulMaxSuppressed, xModel.ulTicks, xModel.ulTickInterrupts, ulAhead,
+						( long ) xModel.ulTicks - ( long ) ( xModel.ulTime / xModel.ulCountsPerTick ),
+						( xPassed != pdFALSE ) ? "OK" : "FAIL" );
+
+		configASSERT( xPassed );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRunModel( xTICKLESS_MODEL *pxModel, unsigned long ulCountsPerTick, portBASE_TYPE *pxPassed )
+{
+unsigned long ulSleep, ulIdle, ulWake, ulExpectedTicks, ulCountsToBoundary, ulAhead = 0UL;
+
+	pxModel->ulTMR = 0UL;
+	pxModel->ulPR = ulCountsPerTick - 1UL;
+	pxModel->xIF = pdFALSE;
+	pxModel->xWrapped = pdFALSE;
+	pxModel->ulCountsPerTick = ulCountsPerTick;
+	pxModel->ulMaxSuppressed = ( tmodelTIMER_MAX + 1UL ) / ulCountsPerTick;
+	pxModel->ulTime = 0UL;
+	pxModel->ulTicks = 0UL;
+	pxModel->ulTickInterrupts = 0UL;
+	ulNextRand = ulCountsPerTick;
+
+	for( ulSleep = 0UL; ulSleep < tmodelSLEEPS; ulSleep++ )
+	{
+		/* Run for part of a tick period with the tick enabled, so the next
+		sleep starts at a different point in the tick period.  Half the time
+		the tick is suppressed again straight away, as happens when an
+		interrupt wakes the processor without unblocking a task, so the tick
+		period in progress was shortened by the last sleep and does not start
+		at 0. */
+		if( prvRand( 2UL ) == 0UL )
+		{
+			prvAdvance( pxModel, prvRand( ulCountsPerTick ), pdTRUE );
+		}
+
+		/* The idle time is clamped by the port if it does not fit. */
+		ulIdle = prvRand( tmodelMAX_IDLE_TICKS - 1UL ) + 2UL;
+
+		switch( prvRand( 4UL ) )
+		{
+			case 0:
+				/* Sleep for the full time. */
+				ulWake = tmodelTIMER_MAX + 1UL;
+				break;
+
+			case 1:
+				/* Woken a few counts either side of a tick boundary. */
+				ulCountsToBoundary = ( ( pxModel->ulPR - pxModel->ulTMR ) % ulCountsPerTick ) + 1UL + ( prvRand( ulIdle ) * ulCountsPerTick );
+				ulWake = ulCountsToBoundary + prvRand( 2UL * portTICKLESS_MARGIN_COUNTS );
+				ulWake = ( ulWake > portTICKLESS_MARGIN_COUNTS ) ? ulWake - portTICKLESS_MARGIN_COUNTS : 0UL;
+				break;
+
+			default:
+				/* Woken at any time. */
+				ulWake = prvRand( ulIdle * ulCountsPerTick );
+				break;
+		}
+
+		prvSuppressTicksAndSleep( pxModel, ulIdle, ulWake );
+
+		/* Once the tick interrupt has caught up, the tick count must match
+		the time that has passed.  It can be one ahead only if the sleep
+		ended within portTICKLESS_MARGIN_COUNTS of a tick boundary. */
+		ulExpectedTicks = pxModel->ulTime / ulCountsPerTick;
+
+		if( pxModel->ulTicks != ulExpectedTicks )
+		{
+			if( ( pxModel->ulTicks == ( ulExpectedTicks + 1UL ) ) && ( ( ulCountsPerTick - ( pxModel->ulTime % ulCountsPerTick ) ) <= ( portTICKLESS_MARGIN_COUNTS + tmodelMAX_LATENCY ) ) )
+			{
+				ulAhead++;
+			}
+			else
+			{
+				*pxPassed = pdFALSE;
+			}
+		}
+	}
+
+	/* Run until every tick has been counted. */
+	prvAdvance( pxModel, ( 2UL * ulCountsPerTick ) - ( pxModel->ulTime % ulCountsPerTick ), pdTRUE );
+	if( ( pxModel->ulTicks != ( pxModel->ulTime / ulCountsPerTick ) ) || ( pxModel->xWrapped != pdFALSE ) )
+	{
+		*pxPassed = pdFALSE;
+	}
+
+	return ulAhead;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSuppressTicksAndSleep( xTICKLESS_MODEL *pxModel, unsigned long ulExpectedIdleTime, unsigned long ulWakeCounts )
+{
+unsigned long ulTickStart, ulMaxTicks, ulTimerCount, ulCompleteTickPeriods, ulNewPeriod, ulCountsToMatch;
+
+	/* di. */
+	prvAdvance( pxModel, prvRand( tmodelMAX_LATENCY + 1UL ), pdFALSE );
+
+	if( pxModel->xIF != pdFALSE )
+	{
+		/* ei. */
+		prvAdvance( pxModel, 0UL, pdTRUE );
+		return;
+	}
+
+	ulTickStart = portTICKLESS_TICK_START( pxModel->ulPR, pxModel->ulCountsPerTick );
+	ulMaxTicks = portTICKLESS_MAX_TICKS( ulTickStart, pxModel->ulCountsPerTick );
+	if( ulExpectedIdleTime > ulMaxTicks )
+	{
+		ulExpectedIdleTime = ulMaxTicks;
+	}
+
+	pxModel->ulPR = portTICKLESS_PERIOD( ulTickStart, pxModel->ulCountsPerTick, ulExpectedIdleTime ) & tmodelTIMER_MAX;
+	prvAdvance( pxModel, prvRand( tmodelMAX_LATENCY + 1UL ), pdFALSE );
+
+	if( pxModel->xIF != pdFALSE )
+	{
+		pxModel->ulPR = pxModel->ulCountsPerTick - 1UL;
+		prvAdvance( pxModel, 0UL, pdTRUE );
+		return;
+	}
+
+	/* wait.  The processor wakes on the timer interrupt, or after
+	ulWakeCounts, whichever is first. */
+	ulCountsToMatch = ( pxModel->ulPR - pxModel->ulTMR ) + 1UL;
+	if( ulWakeCounts > ulCountsToMatch )
+	{
+		ulWakeCounts = ulCountsToMatch;
+	}
+	prvAdvance( pxModel, ulWakeCounts + prvRand( tmodelMAX_LATENCY + 1UL ), pdFALSE );
+
+	ulTimerCount = pxModel->ulTMR;
+	prvAdvance( pxModel, prvRand( tmodelMAX_LATENCY + 1UL ), pdFALSE );
+
+	if( pxModel->xIF != pdFALSE )
+	{
+		ulCompleteTickPeriods = ulExpectedIdleTime - 1UL;
+	}
+	else
+	{
+		ulCompleteTickPeriods = ulPortTicklessCompleteTicks( ulTimerCount, ulTickStart, pxModel->ulCountsPerTick, ulExpectedIdleTime, &ulNewPeriod );
+
+		if( ulNewPeriod != 0UL )
+		{
+			prvAdvance( pxModel, prvRand( tmodelMAX_LATENCY + 1UL ), pdFALSE );
+			pxModel->ulPR = ulNewPeriod & tmodelTIMER_MAX;
+		}
+	}
+
+	/* vTaskStepTick(), then ei. */
+	pxModel->ulTicks += ulCompleteTickPeriods;
+	prvAdvance( pxModel, 0UL, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvAdvance( xTICKLESS_MODEL *pxModel, unsigned long ulCounts, portBASE_TYPE xInterruptsEnabled )
+{
+unsigned long ulCountsToMatch;
+
+	for( ;; )
+	{
+		if( ( pxModel->xIF != pdFALSE ) && ( xInterruptsEnabled != pdFALSE ) )
+		{
+			prvTickInterrupt( pxModel );
+		}
+
+		if( ulCounts == 0UL )
+		{
+			break;
+		}
+
+		/* TMR1 only matches PR1 if it has not already passed it.  If it has,
+		it counts on to its maximum value and wraps first. */
+		if( pxModel->ulTMR <= pxModel->ulPR )
+		{
+			ulCountsToMatch = ( pxModel->ulPR - pxModel->ulTMR ) + 1UL;
+		}
+		else
+		{
+			ulCountsToMatch = ( tmodelTIMER_MAX - pxModel->ulTMR ) + pxModel->ulPR + 2UL;
+			pxModel->xWrapped = pdTRUE;
+		}
+
+		if( ulCounts < ulCountsToMatch )
+		{
+			pxModel->ulTMR = ( pxModel->ulTMR + ulCounts ) & tmodelTIMER_MAX;
+			pxModel->ulTime += ulCounts;
+			ulCounts = 0UL;
+		}
+		else
+		{
+			pxModel->ulTMR = 0UL;
+			pxModel->xIF = pdTRUE;
+			pxModel->ulTime += ulCountsToMatch;
+			ulCounts -= ulCountsToMatch;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTickInterrupt( xTICKLESS_MODEL *pxModel )
+{
+	pxModel->ulPR = pxModel->ulCountsPerTick - 1UL;
+	pxModel->ulTicks++;
+	pxModel->ulTickInterrupts++;
+	pxModel->xIF = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRand( unsigned long ulRange )
+{
+	ulNextRand = ( ( ulNextRand * 1664525UL ) + 1013904223UL ) & 0xffffffffUL;
+	return ( ulNextRand >> 8 ) % ulRange;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,181 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Measures the time xTimerChangePeriod() takes to change the period of an
+ * active auto reload timer, as the stepper motor task does each time the speed
+ * of the motor changes.  Build with configUSE_TIMER_WHEEL set to 1 and
+ * configUSE_TIMER_DIRECT_COMMANDS set to 0 and then to 1 to compare sending
+ * the command to the timer service task with applying it directly.
+ *
+ * The task running the benchmark is given a priority below the timer service
+ * task, so a command that is sent is processed before xTimerChangePeriod()
+ * returns.  The period is lengthened and shortened in turn, faster than the
+ * timer expires.  A command that is applied directly only unblocks the timer
+ * service task if the timer would otherwise expire before the task is due to
+ * unblock, which lengthening the period never does.
+ *
+ * The timer is then left to run, to check it expires at its new period.  The
+ * period it runs at is set while the timer service task is blocked until the
+ * timer expires at a much longer period, so the task has to be unblocked
+ * early.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "TimerCommandBench.h"
+
+/* The two periods the timer is switched between. */
+#define tcbenchLONG_PERIOD				( ( portTickType ) 40 * configTICK_RATE_HZ / ( portTickType ) 1000 )
+#define tcbenchSHORT_PERIOD				( ( portTickType ) 20 * configTICK_RATE_HZ / ( portTickType ) 1000 )
+
+/* The number of times the period is lengthened, and shortened. */
+#define tcbenchCHANGES					( 500UL )
+
+/* The number of periods for which the timer is left to run. */
+#define tcbenchCHECK_PERIODS			( 10UL )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The callback of the timer.  Counts the times the timer has expired.
+ */
+static void prvTimerCallback( xTimerHandle xTimer );
+
+/*-----------------------------------------------------------*/
+
+static volatile unsigned long ulCallbacks = 0UL;
+
+/*-----------------------------------------------------------*/
+
+void vRunTimerCommandBenchmark( void )
+{
+unsigned portBASE_TYPE uxOriginalPriority;
+unsigned long ulChange, ulStart, ulLonger = 0UL, ulShorter = 0UL, ulExpired;
+xTimerHandle xTimer;
+portBASE_TYPE xResult;
+
+	benchPRINTF( "Timer command benchmark: direct commands %s, times in %s\r\n", ( configUSE_TIMER_DIRECT_COMMANDS == 1 ) ? "on" : "off", benchTIMESTAMP_UNITS );
+
+	configASSERT( configTIMER_TASK_PRIORITY > tskIDLE_PRIORITY );
+
+	/* Let the timer service task process each command as it is sent. */
+	uxOriginalPriority = uxTaskPriorityGet( NULL );
+	vTaskPrioritySet( NULL, configTIMER_TASK_PRIORITY - 1 );
+
+	xTimer = xTimerCreate( ( const signed char * ) "TCTmr", tcbenchLONG_PERIOD, pdTRUE, NULL, prvTimerCallback );
+	configASSERT( xTimer );
+
+	xResult = xTimerStart( xTimer, portMAX_DELAY );
+	configASSERT( xResult );
+
+	for( ulChange = 0UL; ulChange < tcbenchCHANGES; ulChange++ )
+	{
+		ulStart = benchGET_TIMESTAMP();
+		( void ) xTimerChangePeriod( xTimer, tcbenchSHORT_PERIOD, portMAX_DELAY );
+		ulShorter += benchGET_TIMESTAMP() - ulStart;
+
+		ulStart = benchGET_TIMESTAMP();
+		( void ) xTimerChangePeriod( xTimer, tcbenchLONG_PERIOD, portMAX_DELAY );
+		ulLonger += benchGET_TIMESTAMP() - ulStart;
+	}
+
+	benchPRINTF( "  xTimerChangePeriod() longer:  %6lu\r\n", ulLonger / tcbenchCHANGES );
+	benchPRINTF( "  xTimerChangePeriod() shorter: %6lu\r\n", ulShorter / tcbenchCHANGES );
+
+	/* Leave the timer service task blocked until the timer expires at a much
+	longer period, then shorten the period again.  The timer should then
+	expire once per period. */
+	xResult = xTimerChangePeriod( xTimer, tcbenchLONG_PERIOD * tcbenchCHECK_PERIODS, portMAX_DELAY );
+	configASSERT( xResult );
+	vTaskDelay( tcbenchLONG_PERIOD );
+	xResult = xTimerChangePeriod( xTimer, tcbenchSHORT_PERIOD, portMAX_DELAY );
+	configASSERT( xResult );
+	ulCallbacks = 0UL;
+	vTaskDelay( ( tcbenchSHORT_PERIOD * tcbenchCHECK_PERIODS ) + ( tcbenchSHORT_PERIOD / 2 ) );
+	ulExpired = ulCallbacks;
+
+	benchPRINTF( "  expired %lu times in %lu periods\r\n", ulExpired, tcbenchCHECK_PERIODS );
+	configASSERT( ulExpired == tcbenchCHECK_PERIODS );
+
+	xResult = xTimerDelete( xTimer, portMAX_DELAY );
+	configASSERT( xResult );
+	( void ) xResult;
+
+	vTaskPrioritySet( NULL, uxOriginalPriority );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( xTimerHandle xTimer )
+{
+	( void ) xTimer;
+	ulCallbacks++;
+}
+/*-----------------------------------------------------------*/
+
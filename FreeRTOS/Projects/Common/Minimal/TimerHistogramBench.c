@@ -0,0 +1,449 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+/*
+ * Measures the histograms of how late software timer callbacks execute, and
+ * how long they take, that timers.c keeps when configUSE_TIMER_HISTOGRAMS is
+ * 1.  These are the software timers that drive the stepper motor of rd8a when
+ * it does not use the high resolution timers.
+ *
+ * + Jitter: the callback of a periodic timer takes 5ms, which delays the
+ *   callback of a second periodic timer that expires 1 tick later.  The
+ *   histograms are read while the timers run, and the number of callbacks they
+ *   count must match the number counted by the callbacks themselves.  Anything
+ *   else running on the host can shorten the delay of an odd callback, so only
+ *   most of the delayed callbacks must be counted as late.
+ * + Idle: a periodic timer runs alone, to show the latency of an undisturbed
+ *   callback.
+ * + Suspended: a one-shot timer expires 2 ticks after it is started, while the
+ *   scheduler is suspended, so its callback must be counted as late by at
+ *   least the time for which the scheduler was suspended less those 2 ticks.
+ * + Name: the timers are found by name, then deleted, after which they must no
+ *   longer be found.
+ *
+ * The real clock only allows these checks to be approximate.  The exact values
+ * recorded are checked by TimerHistogramDemo.c, which sets the time itself.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "semphr.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "TimerHistogramBench.h"
+
+#if ( configUSE_TIMER_HISTOGRAMS == 1 )
+
+/* The period of the periodic timers, and the number of times the timers
+measured together expire. */
+#define thbenchPERIOD					( ( portTickType ) 10 )
+#define thbenchIDLE_PERIOD				( ( portTickType ) 5 )
+#define thbenchEXPIRIES					( 20UL )
+
+/* How long the callback of the busy timer takes, and how long the scheduler is
+suspended for, in run time counter counts. */
+#define thbenchBUSY_COUNTS				( 5000UL )
+#define thbenchSUSPEND_COUNTS			( 20000UL )
+
+/* The lowest bucket that may count the execution time of the busy callback,
+which always takes at least thbenchBUSY_COUNTS, and the lowest bucket in which
+most of the latencies of the timer delayed by it must be counted.  Bucket n
+counts times from 2^(n-1) to 2^n - 1. */
+#define thbenchBUSY_BUCKET				( 13U )
+#define thbenchLATE_BUCKET				( 12U )
+
+/* The shortest maximum latency of the timer delayed by the busy callback, which
+expires 1 tick after the busy callback starts, and the shortest latency of the
+timer that expires 2 ticks after it is started, while the scheduler is
+suspended.  Each allows another tick for the host delaying the timers. */
+#define thbenchLATE_LATENCY				( thbenchBUSY_COUNTS - ( 2UL * configTIMER_HISTOGRAM_COUNTS_PER_TICK ) )
+#define thbenchSUSPENDED_LATENCY		( thbenchSUSPEND_COUNTS - ( 3UL * configTIMER_HISTOGRAM_COUNTS_PER_TICK ) )
+
+/* The longest any of the measurements is expected to take. */
+#define thbenchTIMEOUT					( ( portTickType ) 5000 / portTICK_RATE_MS )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The callbacks of the timers.  The busy callback waits for
+ * thbenchBUSY_COUNTS.  The late and idle callbacks stop their timer after
+ * thbenchEXPIRIES callbacks.
+ */
+static void prvBusyCallback( xTimerHandle xTimer );
+static void prvLateCallback( xTimerHandle xTimer );
+static void prvIdleCallback( xTimerHandle xTimer );
+static void prvOneShotCallback( xTimerHandle xTimer );
+
+/*
+ * Wait until the run time counter has advanced by ulCounts.
+ */
+static void prvBusyWait( unsigned long ulCounts );
+
+/*
+ * Read the histograms of a timer, check they agree with themselves, and with
+ * the number of callbacks counted by the callback.
+ */
+static void prvCheckHistogram( xTimerHandle xTimer, xTimerHistogram *pxHistogram, unsigned long ulCallbacks );
+
+/*
+ * Print the buckets of a histogram that have counted any callbacks.
+ */
+static void prvPrintBuckets( const char *pcName, const unsigned long *pulBuckets );
+
+/*
+ * Returns the lowest bucket of a histogram that has counted any callbacks.
+ */
+static unsigned portBASE_TYPE prvLowestBucket( const unsigned long *pulBuckets );
+
+/*
+ * Returns the number of callbacks a histogram counted in uxBucket and above.
+ */
+static unsigned long prvCountFromBucket( const unsigned long *pulBuckets, unsigned portBASE_TYPE uxBucket );
+
+/*-----------------------------------------------------------*/
+
+static xTimerHandle xBusyTimer = NULL, xLateTimer = NULL, xIdleTimer = NULL, xOneShotTimer = NULL;
+static xSemaphoreHandle xDoneSemaphore = NULL;
+
+/* The number of times each callback has executed. */
+static volatile unsigned long ulBusyCallbacks = 0UL, ulLateCallbacks = 0UL, ulIdleCallbacks = 0UL, ulOneShotCallbacks = 0UL;
+
+/*-----------------------------------------------------------*/
+
+void vRunTimerHistogramBenchmark( void )
+{
+xTimerHistogram xHistogram;
+portTickType xBusyStart, xLateStart;
+unsigned long ulReads = 0UL;
+portBASE_TYPE xResult;
+
+	benchPRINTF( "Timer histogram benchmark: callback latency and execution time in us\r\n" );
+
+	vSemaphoreCreateBinary( xDoneSemaphore );
+	configASSERT( xDoneSemaphore );
+	( void ) xSemaphoreTake( xDoneSemaphore, 0 );
+
+	xBusyTimer = xTimerCreate( ( const signed char * ) "HistBusy", thbenchPERIOD, pdTRUE, NULL, prvBusyCallback );
+	xLateTimer = xTimerCreate( ( const signed char * ) "HistLate", thbenchPERIOD, pdTRUE, NULL, prvLateCallback );
+	xIdleTimer = xTimerCreate( ( const signed char * ) "HistIdle", thbenchIDLE_PERIOD, pdTRUE, NULL, prvIdleCallback );
+	xOneShotTimer = xTimerCreate( ( const signed char * ) "HistOne", ( portTickType ) 2, pdFALSE, NULL, prvOneShotCallback );
+	configASSERT( xBusyTimer && xLateTimer && xIdleTimer && xOneShotTimer );
+
+	/* Jitter.  The late timer is started on the tick after the busy timer, so
+	always expires 1 tick after it, while its callback is still executing. */
+	ulBusyCallbacks = 0UL;
+	ulLateCallbacks = 0UL;
+	vTaskDelay( 1 );
+	xBusyStart = xTaskGetTickCount();
+	xResult = xTimerStart( xBusyTimer, 0 );
+	configASSERT( xResult );
+	vTaskDelay( 1 );
+	xLateStart = xTaskGetTickCount();
+	xResult = xTimerStart( xLateTimer, 0 );
+	configASSERT( xResult );
+	configASSERT( ( portTickType ) ( xLateStart - xBusyStart ) == ( portTickType ) 1 );
+
+	/* The histograms are read while the timer service task updates them. */
+	while( xSemaphoreTake( xDoneSemaphore, 1 ) != pdTRUE )
+	{
+		prvCheckHistogram( xBusyTimer, &xHistogram, ulBusyCallbacks );
+		ulReads++;
+		configASSERT( ulReads < ( unsigned long ) thbenchTIMEOUT );
+	}
+
+	/* The late callback stopped both timers. */
+	vTaskDelay( thbenchPERIOD * ( portTickType ) 2 );
+	configASSERT( ulBusyCallbacks == thbenchEXPIRIES );
+	configASSERT( ulLateCallbacks == thbenchEXPIRIES );
+
+	prvCheckHistogram( xBusyTimer, &xHistogram, ulBusyCallbacks );
+	benchPRINTF( "  HistBusy: %lu callbacks, max latency %lu, max execution %lu, %lu reads while running\r\n", xHistogram.ulCallbacks, xHistogram.ulMaxLatency, xHistogram.ulMaxExecution, ulReads );
+	prvPrintBuckets( "execution", xHistogram.ulExecution );
+	configASSERT( prvLowestBucket( xHistogram.ulExecution ) >= thbenchBUSY_BUCKET );
+
+	prvCheckHistogram( xLateTimer, &xHistogram, ulLateCallbacks );
+	benchPRINTF( "  HistLate: %lu callbacks, max latency %lu, max execution %lu\r\n", xHistogram.ulCallbacks, xHistogram.ulMaxLatency, xHistogram.ulMaxExecution );
+	prvPrintBuckets( "latency", xHistogram.ulLatency );
+	configASSERT( xHistogram.ulMaxLatency >= thbenchLATE_LATENCY );
+	configASSERT( ( prvCountFromBucket( xHistogram.ulLatency, thbenchLATE_BUCKET ) * 2UL ) > xHistogram.ulCallbacks );
+
+	/* Idle. */
+	ulIdleCallbacks = 0UL;
+	xResult = xTimerStart( xIdleTimer, 0 );
+	configASSERT( xResult );
+	xResult = xSemaphoreTake( xDoneSemaphore, thbenchTIMEOUT );
+	configASSERT( xResult );
+	vTaskDelay( thbenchIDLE_PERIOD * ( portTickType ) 2 );
+	configASSERT( ulIdleCallbacks == thbenchEXPIRIES );
+
+	prvCheckHistogram( xIdleTimer, &xHistogram, ulIdleCallbacks );
+	benchPRINTF( "  HistIdle: %lu callbacks, max latency %lu, max execution %lu\r\n", xHistogram.ulCallbacks, xHistogram.ulMaxLatency, xHistogram.ulMaxExecution );
+	prvPrintBuckets( "latency", xHistogram.ulLatency );
+
+	/* Suspended.  The timer service task cannot run until the scheduler is
+	resumed, long after the timer expired. */
+	ulOneShotCallbacks = 0UL;
+	xResult = xTimerStart( xOneShotTimer, 0 );
+	configASSERT( xResult );
+	vTaskSuspendAll();
+	{
+		prvBusyWait( thbenchSUSPEND_COUNTS );
+	}
+	( void ) xTaskResumeAll();
+	xResult = xSemaphoreTake( xDoneSemaphore, thbenchTIMEOUT );
+	configASSERT( xResult );
+
+	prvCheckHistogram( xOneShotTimer, &xHistogram, ulOneShotCallbacks );
+	benchPRINTF( "  HistOne:  %lu callbacks, latency %lu after the scheduler was suspended for %lu\r\n", xHistogram.ulCallbacks, xHistogram.ulMaxLatency, thbenchSUSPEND_COUNTS );
+	configASSERT( ulOneShotCallbacks == 1UL );
+	configASSERT( xHistogram.ulMaxLatency >= thbenchSUSPENDED_LATENCY );
+
+	/* Clearing a histogram does not affect the others. */
+	vTimerClearHistogram( xBusyTimer );
+	ulBusyCallbacks = 0UL;
+	prvCheckHistogram( xBusyTimer, &xHistogram, 0UL );
+	prvCheckHistogram( xLateTimer, &xHistogram, ulLateCallbacks );
+
+	#if ( INCLUDE_xTimerGetTimerByName == 1 )
+	{
+		configASSERT( xTimerGetTimerByName( ( const signed char * ) "HistBusy" ) == xBusyTimer );
+		configASSERT( xTimerGetTimerByName( ( const signed char * ) "HistLate" ) == xLateTimer );
+		configASSERT( xTimerGetTimerByName( ( const signed char * ) "HistIdle" ) == xIdleTimer );
+		configASSERT( xTimerGetTimerByName( ( const signed char * ) "HistOne" ) == xOneShotTimer );
+		configASSERT( xTimerGetTimerByName( ( const signed char * ) "HistNone" ) == NULL );
+	}
+	#endif /* INCLUDE_xTimerGetTimerByName */
+
+	xResult = xTimerDelete( xBusyTimer, 0 );
+	configASSERT( xResult );
+	xResult = xTimerDelete( xLateTimer, 0 );
+	configASSERT( xResult );
+	xResult = xTimerDelete( xIdleTimer, 0 );
+	configASSERT( xResult );
+	xResult = xTimerDelete( xOneShotTimer, 0 );
+	configASSERT( xResult );
+
+	/* Let the timer service task process the deletions. */
+	vTaskDelay( 2 );
+
+	#if ( INCLUDE_xTimerGetTimerByName == 1 )
+	{
+		configASSERT( xTimerGetTimerByName( ( const signed char * ) "HistBusy" ) == NULL );
+		configASSERT( xTimerGetTimerByName( ( const signed char * ) "HistOne" ) == NULL );
+		benchPRINTF( "  timers found by name until deleted\r\n" );
+	}
+	#endif /* INCLUDE_xTimerGetTimerByName */
+
+	( void ) xResult;
+	vSemaphoreDelete( xDoneSemaphore );
+	xDoneSemaphore = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBusyCallback( xTimerHandle xTimer )
+{
+	( void ) xTimer;
+
+	prvBusyWait( thbenchBUSY_COUNTS );
+	ulBusyCallbacks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvLateCallback( xTimerHandle xTimer )
+{
+	ulLateCallbacks++;
+
+	if( ulLateCallbacks >= thbenchEXPIRIES )
+	{
+		/* The busy timer expired last 1 tick before this one, so has also
+		executed thbenchEXPIRIES times. */
+		( void ) xTimerStop( xBusyTimer, 0 );
+		( void ) xTimerStop( xTimer, 0 );
+		( void ) xSemaphoreGive( xDoneSemaphore );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvIdleCallback( xTimerHandle xTimer )
+{
+	ulIdleCallbacks++;
+
+	if( ulIdleCallbacks >= thbenchEXPIRIES )
+	{
+		( void ) xTimerStop( xTimer, 0 );
+		( void ) xSemaphoreGive( xDoneSemaphore );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvOneShotCallback( xTimerHandle xTimer )
+{
+	( void ) xTimer;
+
+	ulOneShotCallbacks++;
+	( void ) xSemaphoreGive( xDoneSemaphore );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBusyWait( unsigned long ulCounts )
+{
+unsigned long ulStart = configTIMER_HISTOGRAM_TIMESTAMP();
+
+	while( ( configTIMER_HISTOGRAM_TIMESTAMP() - ulStart ) < ulCounts )
+	{
+		/* Spin. */
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckHistogram( xTimerHandle xTimer, xTimerHistogram *pxHistogram, unsigned long ulCallbacks )
+{
+unsigned long ulLatencyTotal = 0UL, ulExecutionTotal = 0UL;
+unsigned portBASE_TYPE uxBucket;
+portBASE_TYPE xResult;
+
+	xResult = xTimerGetHistogram( xTimer, pxHistogram );
+	configASSERT( xResult == pdPASS );
+	( void ) xResult;
+
+	/* The callback counts itself before the timer service task updates the
+	histograms, so the count kept by the callback can be one ahead while the
+	timer runs. */
+	configASSERT( ( pxHistogram->ulCallbacks == ulCallbacks ) || ( ( pxHistogram->ulCallbacks + 1UL ) == ulCallbacks ) );
+	( void ) ulCallbacks;
+
+	for( uxBucket = 0U; uxBucket < ( unsigned portBASE_TYPE ) configTIMER_HISTOGRAM_BUCKETS; uxBucket++ )
+	{
+		ulLatencyTotal += pxHistogram->ulLatency[ uxBucket ];
+		ulExecutionTotal += pxHistogram->ulExecution[ uxBucket ];
+	}
+
+	/* The copy is never torn, so each histogram counts every callback. */
+	configASSERT( ulLatencyTotal == pxHistogram->ulCallbacks );
+	configASSERT( ulExecutionTotal == pxHistogram->ulCallbacks );
+	( void ) ulLatencyTotal;
+	( void ) ulExecutionTotal;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintBuckets( const char *pcName, const unsigned long *pulBuckets )
+{
+unsigned portBASE_TYPE uxBucket;
+
+	for( uxBucket = 0U; uxBucket < ( unsigned portBASE_TYPE ) configTIMER_HISTOGRAM_BUCKETS; uxBucket++ )
+	{
+		if( pulBuckets[ uxBucket ] != 0UL )
+		{
+			if( uxBucket == 0U )
+			{
+				benchPRINTF( "    %s 0: %lu\r\n", pcName, pulBuckets[ uxBucket ] );
+			}
+			else
+			{
+				benchPRINTF( "    %s %lu+: %lu\r\n", pcName, 1UL << ( uxBucket - 1U ), pulBuckets[ uxBucket ] );
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static unsigned portBASE_TYPE prvLowestBucket( const unsigned long *pulBuckets )
+{
+unsigned portBASE_TYPE uxBucket;
+
+	for( uxBucket = 0U; uxBucket < ( unsigned portBASE_TYPE ) configTIMER_HISTOGRAM_BUCKETS; uxBucket++ )
+	{
+		if( pulBuckets[ uxBucket ] != 0UL )
+		{
+			break;
+		}
+	}
+
+	return uxBucket;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvCountFromBucket( const unsigned long *pulBuckets, unsigned portBASE_TYPE uxBucket )
+{
+unsigned long ulCount = 0UL;
+
+	for( ; uxBucket < ( unsigned portBASE_TYPE ) configTIMER_HISTOGRAM_BUCKETS; uxBucket++ )
+	{
+		ulCount += pulBuckets[ uxBucket ];
+	}
+
+	return ulCount;
+}
+/*-----------------------------------------------------------*/
+
+#else /* configUSE_TIMER_HISTOGRAMS */
+
+void vRunTimerHistogramBenchmark( void )
+{
+	benchPRINTF( "Timer histogram benchmark: configUSE_TIMER_HISTOGRAMS is 0\r\n" );
+}
+
+#endif /* configUSE_TIMER_HISTOGRAMS */
@@ -0,0 +1,342 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Checks the histograms of how late software timer callbacks execute, and how
+ * long they take, that timers.c keeps when configUSE_TIMER_HISTOGRAMS is 1.
+ * TimerHistogramBench.c measures them against the real clock.  This file
+ * checks the exact values recorded.
+ *
+ * For this to be possible configTIMER_HISTOGRAM_TIMESTAMP() must return
+ * ulTimerHistogramDemoClock, and configTIMER_HISTOGRAM_COUNTS_PER_TICK must
+ * be 0.  Only the timer callbacks in this file change the clock, and it does
+ * not advance with the tick, so the time recorded for each callback is
+ * known.  The clock starts just below the point at which it wraps, so the
+ * arithmetic in timers.c is also checked across the wrap.
+ *
+ * Each cycle two one-shot timers are started with the same period, and share
+ * a callback.  The callback that executes first advances the clock by
+ * thdFIRST_COUNTS, so that is how long it takes, and it is not late.  The
+ * callback that executes second is therefore late by thdFIRST_COUNTS, and
+ * advances the clock by thdSECOND_COUNTS, which is beyond the last bucket.
+ * The test task then checks the number of callbacks, every bucket, and the
+ * maximum latency and execution time of both histograms.
+ *
+ * The two timers might not expire on the same tick, or a tick might occur
+ * between the two callbacks.  In either case the second callback is not late
+ * by thdFIRST_COUNTS.  The callbacks detect this from the tick count, and the
+ * latency of the second callback is then not checked.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "semphr.h"
+
+/* Demo program include files. */
+#include "TimerHistogramDemo.h"
+
+#if ( configUSE_TIMER_HISTOGRAMS == 1 )
+
+#define thdTASK_PRIORITY			( tskIDLE_PRIORITY + 1 )
+
+/* The period of the timers, and the time between cycles. */
+#define thdPERIOD					( ( portTickType ) 2 )
+#define thdCYCLE_DELAY				( ( portTickType ) 10 / portTICK_RATE_MS )
+
+/* The timers only take longer than this if the timer service task has
+failed. */
+#define thdMAX_WAIT					( ( portTickType ) 1000 / portTICK_RATE_MS )
+
+/* How long the first and second callbacks take, and the buckets in which
+those times are counted.  Bucket n counts times from 2^(n-1) to 2^n - 1, and
+the last bucket counts anything longer. */
+#define thdFIRST_COUNTS				( 1000UL )
+#define thdFIRST_BUCKET				( 10U )
+#define thdSECOND_COUNTS			( 0x80000000UL )
+#define thdSECOND_BUCKET			( configTIMER_HISTOGRAM_BUCKETS - 1U )
+
+/* The initial value of the clock. */
+#define thdCLOCK_START				( 0xfffffc00UL )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The callback of both timers, and the task that starts them, as described at
+ * the top of this file.
+ */
+static void prvTimerCallback( xTimerHandle xTimer );
+static void prvHistogramTestTask( void *pvParameters );
+
+/*
+ * Check that the histograms of xTimer have counted exactly one callback, and
+ * that it took ulExecution, so was counted in uxExecutionBucket.  If
+ * xCheckLatency is pdTRUE also check that it was late by ulLatency, so was
+ * counted in uxLatencyBucket.
+ */
+static void prvCheckHistogram( xTimerHandle xTimer, portBASE_TYPE xCheckLatency, unsigned long ulLatency, unsigned portBASE_TYPE uxLatencyBucket, unsigned long ulExecution, unsigned portBASE_TYPE uxExecutionBucket );
+
+/*
+ * Check that the only bucket of a histogram to count a callback is uxBucket,
+ * and that it counted exactly one.
+ */
+static void prvCheckBuckets( const unsigned long *pulBuckets, unsigned portBASE_TYPE uxBucket );
+
+/*-----------------------------------------------------------*/
+
+/* Returned by configTIMER_HISTOGRAM_TIMESTAMP(). */
+volatile unsigned long ulTimerHistogramDemoClock = thdCLOCK_START;
+
+static xTimerHandle xTimers[ 2 ] = { NULL, NULL };
+static xSemaphoreHandle xDoneSemaphore = NULL;
+
+/* Set by the callback that executes first, and read by the callback that
+executes second. */
+static volatile xTimerHandle xFirstTimer = NULL;
+static volatile portTickType xFirstTick = ( portTickType ) 0;
+
+/* Set by the callback that executes second if the two executed on the same
+tick. */
+static volatile portBASE_TYPE xSameTick = pdFALSE;
+
+/* Latched if anything unexpected happens. */
+static volatile portBASE_TYPE xErrorDetected = pdFALSE;
+
+/* Incremented for each cycle, and for each cycle in which the latency of the
+second callback was checked. */
+static volatile unsigned long ulCycles = 0UL, ulLateCycles = 0UL;
+
+/*-----------------------------------------------------------*/
+
+void vStartTimerHistogramTasks( void )
+{
+	/* The clock must not advance with the tick, as described at the top of
+	this file. */
+	configASSERT( configTIMER_HISTOGRAM_COUNTS_PER_TICK == 0UL );
+
+	xTimers[ 0 ] = xTimerCreate( ( const signed char * ) "HistA", thdPERIOD, pdFALSE, NULL, prvTimerCallback );
+	xTimers[ 1 ] = xTimerCreate( ( const signed char * ) "HistB", thdPERIOD, pdFALSE, NULL, prvTimerCallback );
+	vSemaphoreCreateBinary( xDoneSemaphore );
+
+	if( ( xTimers[ 0 ] != NULL ) && ( xTimers[ 1 ] != NULL ) && ( xDoneSemaphore != NULL ) )
+	{
+		/* A binary semaphore is created available. */
+		( void ) xSemaphoreTake( xDoneSemaphore, 0 );
+
+		xTaskCreate( prvHistogramTestTask, ( signed char * ) "THist", configMINIMAL_STACK_SIZE, NULL, thdTASK_PRIORITY, NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( xTimerHandle xTimer )
+{
+	if( xFirstTimer == NULL )
+	{
+		/* The tick count is read before the clock is advanced.  If it were
+		read after, a tick in between would record the advanced clock as the
+		time of the tick without the second callback being able to tell. */
+		xFirstTick = xTaskGetTickCount();
+		xFirstTimer = xTimer;
+		ulTimerHistogramDemoClock += thdFIRST_COUNTS;
+	}
+	else
+	{
+		if( xTaskGetTickCount() == xFirstTick )
+		{
+			xSameTick = pdTRUE;
+		}
+
+		ulTimerHistogramDemoClock += thdSECOND_COUNTS;
+		( void ) xSemaphoreGive( xDoneSemaphore );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvHistogramTestTask( void *pvParameters )
+{
+xTimerHandle xSecondTimer;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		xFirstTimer = NULL;
+		xSameTick = pdFALSE;
+		vTimerClearHistogram( xTimers[ 0 ] );
+		vTimerClearHistogram( xTimers[ 1 ] );
+
+		if( ( xTimerStart( xTimers[ 0 ], thdMAX_WAIT ) != pdPASS ) || ( xTimerStart( xTimers[ 1 ], thdMAX_WAIT ) != pdPASS ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		/* The timer service task has a higher priority than this task, so
+		has recorded both histograms by the time this task runs again. */
+		if( xSemaphoreTake( xDoneSemaphore, thdMAX_WAIT ) != pdPASS )
+		{
+			xErrorDetected = pdTRUE;
+		}
+		else
+		{
+			xSecondTimer = ( xFirstTimer == xTimers[ 0 ] ) ? xTimers[ 1 ] : xTimers[ 0 ];
+
+			/* The clock only changes in the callbacks, and at least a tick
+			has passed since it last did, so the first callback is never
+			late. */
+			prvCheckHistogram( xFirstTimer, pdTRUE, 0UL, 0U, thdFIRST_COUNTS, thdFIRST_BUCKET );
+			prvCheckHistogram( xSecondTimer, xSameTick, thdFIRST_COUNTS, thdFIRST_BUCKET, thdSECOND_COUNTS, thdSECOND_BUCKET );
+
+			if( xSameTick != pdFALSE )
+			{
+				ulLateCycles++;
+			}
+
+			ulCycles++;
+		}
+
+		vTaskDelay( thdCYCLE_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckHistogram( xTimerHandle xTimer, portBASE_TYPE xCheckLatency, unsigned long ulLatency, unsigned portBASE_TYPE uxLatencyBucket, unsigned long ulExecution, unsigned portBASE_TYPE uxExecutionBucket )
+{
+static xTimerHistogram xHistogram;
+
+	( void ) xTimerGetHistogram( xTimer, &xHistogram );
+
+	if( ( xHistogram.ulCallbacks != 1UL ) || ( xHistogram.ulMaxExecution != ulExecution ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	prvCheckBuckets( xHistogram.ulExecution, uxExecutionBucket );
+
+	if( xCheckLatency != pdFALSE )
+	{
+		if( xHistogram.ulMaxLatency != ulLatency )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		prvCheckBuckets( xHistogram.ulLatency, uxLatencyBucket );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckBuckets( const unsigned long *pulBuckets, unsigned portBASE_TYPE uxBucket )
+{
+unsigned portBASE_TYPE ux;
+unsigned long ulExpected;
+
+	for( ux = 0U; ux < ( unsigned portBASE_TYPE ) configTIMER_HISTOGRAM_BUCKETS; ux++ )
+	{
+		ulExpected = ( ux == uxBucket ) ? 1UL : 0UL;
+
+		if( pulBuckets[ ux ] != ulExpected )
+		{
+			xErrorDetected = pdTRUE;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xAreTimerHistogramTasksStillRunning( void )
+{
+static unsigned long ulLastCycles = 0UL, ulLastLateCycles = 0UL;
+portBASE_TYPE xReturn = pdTRUE;
+
+	/* Cycles in which the second callback executes on a later tick are rare,
+	so the latency must also have been checked since the last call. */
+	if( ( ulCycles == ulLastCycles ) || ( ulLateCycles == ulLastLateCycles ) )
+	{
+		xReturn = pdFALSE;
+	}
+
+	if( xErrorDetected != pdFALSE )
+	{
+		xReturn = pdFALSE;
+	}
+
+	ulLastCycles = ulCycles;
+	ulLastLateCycles = ulLateCycles;
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#else /* configUSE_TIMER_HISTOGRAMS */
+
+void vStartTimerHistogramTasks( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xAreTimerHistogramTasksStillRunning( void )
+{
+	return pdTRUE;
+}
+
+#endif /* configUSE_TIMER_HISTOGRAMS */
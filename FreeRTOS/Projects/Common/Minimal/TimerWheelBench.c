@@ -0,0 +1,221 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Measures the cost of the timer service task as the number of active
+ * software timers grows from 1 to twbenchMAX_TIMERS.  Build with
+ * configUSE_TIMER_WHEEL set to 0 and then to 1 to compare the sorted active
+ * timer list with the timer wheel.
+ *
+ * For each number of timers two costs are measured:
+ *
+ * + The time taken by xTimerReset() when the timer goes behind every other
+ *   active timer.  The task running the benchmark is given a priority below
+ *   the timer service task, so the command is processed before xTimerReset()
+ *   returns, and the time includes inserting the timer into the active timers.
+ *
+ * + The time between the callbacks of auto reload timers that expire in the
+ *   same tick.  The timer service task processes them one after the other, so
+ *   this is the time taken to remove, reload and call each timer.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "TimerWheelBench.h"
+
+/* The largest number of active timers measured.  Each timer is allocated
+from the heap, so this will need reducing on the target. */
+#ifndef twbenchMAX_TIMERS
+	#define twbenchMAX_TIMERS			( 1000U )
+#endif
+
+/* The period of every timer.  Timers started in the same tick expire in the
+same tick. */
+#define twbenchPERIOD					( ( portTickType ) 100 * configTICK_RATE_HZ / ( portTickType ) 1000 )
+
+/* The number of times xTimerReset() is timed. */
+#define twbenchRESETS					( 200UL )
+
+/* The time for which the callbacks are timed. */
+#define twbenchRUN_TICKS				( ( portTickType ) 500 * configTICK_RATE_HZ / ( portTickType ) 1000 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The callback of every timer.  Adds the time since the previous callback to
+ * the total if both were in the same tick.
+ */
+static void prvTimerCallback( xTimerHandle xTimer );
+
+/*-----------------------------------------------------------*/
+
+static xTimerHandle xTimers[ twbenchMAX_TIMERS ];
+
+/* Written by the callback, read by the benchmark once the timers have been
+stopped. */
+static volatile portBASE_TYPE xTimingCallbacks = pdFALSE;
+static portTickType xLastCallbackTick = ( portTickType ) 0U;
+static unsigned long ulLastCallbackTime = 0UL, ulCallbackGaps = 0UL, ulCallbackGapTotal = 0UL;
+
+/*-----------------------------------------------------------*/
+
+void vRunTimerWheelBenchmark( void )
+{
+unsigned portBASE_TYPE uxOriginalPriority, uxTimers = 0U, uxTarget = 1U;
+unsigned long ulReset, ulStart, ulResetTotal;
+portBASE_TYPE xResult;
+
+	benchPRINTF( "Timer benchmark: timer wheel %s, times in %s\r\n", ( configUSE_TIMER_WHEEL == 1 ) ? "on" : "off", benchTIMESTAMP_UNITS );
+
+	configASSERT( configTIMER_TASK_PRIORITY > tskIDLE_PRIORITY );
+
+	/* Let the timer service task process each command as it is sent. */
+	uxOriginalPriority = uxTaskPriorityGet( NULL );
+	vTaskPrioritySet( NULL, configTIMER_TASK_PRIORITY - 1 );
+
+	for( ;; )
+	{
+		/* Top up the number of active timers. */
+		while( uxTimers < uxTarget )
+		{
+			xTimers[ uxTimers ] = xTimerCreate( ( const signed char * ) "TWTmr", twbenchPERIOD, pdTRUE, NULL, prvTimerCallback );
+
+			if( xTimers[ uxTimers ] == NULL )
+			{
+				break;
+			}
+
+			xResult = xTimerStart( xTimers[ uxTimers ], portMAX_DELAY );
+			configASSERT( xResult );
+			( void ) xResult;
+
+			uxTimers++;
+		}
+
+		/* Each reset moves the first timer behind all the others. */
+		ulResetTotal = 0UL;
+
+		for( ulReset = 0UL; ulReset < twbenchRESETS; ulReset++ )
+		{
+			ulStart = benchGET_TIMESTAMP();
+			( void ) xTimerReset( xTimers[ 0 ], portMAX_DELAY );
+			ulResetTotal += benchGET_TIMESTAMP() - ulStart;
+		}
+
+		ulCallbackGaps = 0UL;
+		ulCallbackGapTotal = 0UL;
+		xTimingCallbacks = pdTRUE;
+		vTaskDelay( twbenchRUN_TICKS );
+		xTimingCallbacks = pdFALSE;
+
+		benchPRINTF( "  %4u active timers: xTimerReset() %6lu, per expiry %6lu\r\n", ( unsigned int ) uxTimers, ulResetTotal / twbenchRESETS, ( ulCallbackGaps == 0UL ) ? 0UL : ( ulCallbackGapTotal / ulCallbackGaps ) );
+
+		if( ( uxTarget >= twbenchMAX_TIMERS ) || ( uxTimers < uxTarget ) )
+		{
+			/* Finished, or out of heap. */
+			break;
+		}
+
+		uxTarget *= 10U;
+		if( uxTarget > twbenchMAX_TIMERS )
+		{
+			uxTarget = twbenchMAX_TIMERS;
+		}
+	}
+
+	while( uxTimers > 0U )
+	{
+		uxTimers--;
+		xResult = xTimerDelete( xTimers[ uxTimers ], portMAX_DELAY );
+		configASSERT( xResult );
+		( void ) xResult;
+	}
+
+	vTaskPrioritySet( NULL, uxOriginalPriority );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( xTimerHandle xTimer )
+{
+const unsigned long ulNow = benchGET_TIMESTAMP();
+const portTickType xTickNow = xTaskGetTickCount();
+
+	( void ) xTimer;
+
+	if( ( xTimingCallbacks != pdFALSE ) && ( xTickNow == xLastCallbackTick ) )
+	{
+		ulCallbackGapTotal += ulNow - ulLastCallbackTime;
+		ulCallbackGaps++;
+	}
+
+	xLastCallbackTick = xTickNow;
+	ulLastCallbackTime = ulNow;
+}
+/*-----------------------------------------------------------*/
+
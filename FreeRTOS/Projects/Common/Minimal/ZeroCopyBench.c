@@ -0,0 +1,349 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Compares a zero copy queue with a queue that copies its items, when each is
+ * used to pass items of increasing size from a sender to a receiver.
+ *
+ * An item sent to a queue is copied into the queue, then copied out again by
+ * the receiver, so the time taken grows with the size of the item.  An item
+ * sent to a zero copy queue is written directly into a slot owned by the
+ * queue, and only a pointer to the slot is passed, so the time taken does not
+ * depend on the size of the item.
+ *
+ * The sender builds each item in a buffer (or slot) before it is sent, and the
+ * receiver reads each item (or slot) after it is received, so both methods do
+ * the same amount of work on the item itself.
+ *
+ * The cost of each is measured twice.  First with the item sent and received
+ * by the same task, so only the queue operations and the copying are timed.
+ * Then with the largest item sent to a higher priority task that is blocked
+ * waiting for it, which includes unblocking the task and switching to it, as
+ * when reference design 6a passes an EEPROM block to its check task.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+#include "ZeroCopyBench.h"
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+/* The number of times each item is sent and received. */
+#define zerocopybenchITERATIONS			( 10000UL )
+
+/* The largest item, which matches the EEPROM block of reference design 6a. */
+#define zerocopybenchMAX_ITEM			( 1024 )
+
+/* The number of items each queue can hold. */
+#define zerocopybenchQUEUE_LENGTH		( 2 )
+
+/* Used to select the mechanism used by the receiving task. */
+#define zerocopybenchUSE_QUEUE			( ( void * ) 0 )
+#define zerocopybenchUSE_ZERO_COPY		( ( void * ) 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Time zerocopybenchITERATIONS items of xItemSize bytes sent to and received
+ * from a queue, or a zero copy queue, by the calling task.
+ */
+static unsigned long prvTimeQueue( size_t xItemSize );
+static unsigned long prvTimeZeroCopyQueue( size_t xItemSize );
+
+/*
+ * Time zerocopybenchITERATIONS items of zerocopybenchMAX_ITEM bytes sent to a
+ * receiving task that has a higher priority than the calling task.
+ */
+static unsigned long prvTimeToTask( void *pvMechanism );
+
+/*
+ * The task that receives the items when the cost of unblocking a task is
+ * being measured.  Its parameter selects the mechanism.
+ */
+static void prvZeroCopyBenchReceiver( void *pvParameters );
+
+/*
+ * Write a pattern into, and check the pattern in, an item of xItemSize bytes.
+ */
+static void prvFillItem( unsigned char *pucItem, size_t xItemSize, unsigned long ulIteration );
+static unsigned long prvSumItem( const unsigned char *pucItem, size_t xItemSize );
+
+/*-----------------------------------------------------------*/
+
+static const size_t xItemSizes[] = { 16, 128, zerocopybenchMAX_ITEM };
+
+static xQueueHandle xBenchQueue = NULL;
+static xZeroCopyQueueHandle xBenchZeroCopyQueue = NULL;
+static volatile unsigned long ulItemsReceived = 0UL;
+
+/*-----------------------------------------------------------*/
+
+void vRunZeroCopyBenchmark( void )
+{
+unsigned long ulQueueTime, ulZeroCopyTime;
+unsigned portBASE_TYPE uxIndex;
+
+	benchPRINTF( "Zero copy queue benchmark: times in %s per item\r\n", benchTIMESTAMP_UNITS );
+
+	for( uxIndex = 0; uxIndex < ( sizeof( xItemSizes ) / sizeof( xItemSizes[ 0 ] ) ); uxIndex++ )
+	{
+		ulQueueTime = prvTimeQueue( xItemSizes[ uxIndex ] );
+		ulZeroCopyTime = prvTimeZeroCopyQueue( xItemSizes[ uxIndex ] );
+		benchPRINTF( "  %4u byte item, send then receive: queue %6lu zero copy queue %6lu\r\n", ( unsigned int ) xItemSizes[ uxIndex ], ulQueueTime, ulZeroCopyTime );
+	}
+
+	ulQueueTime = prvTimeToTask( zerocopybenchUSE_QUEUE );
+	ulZeroCopyTime = prvTimeToTask( zerocopybenchUSE_ZERO_COPY );
+	benchPRINTF( "  %4u byte item, to blocked task: queue %6lu zero copy queue %6lu\r\n", zerocopybenchMAX_ITEM, ulQueueTime, ulZeroCopyTime );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeQueue( size_t xItemSize )
+{
+xQueueHandle xQueue;
+unsigned long ulIteration, ulStart, ulElapsed, ulSum = 0UL;
+static unsigned char ucSent[ zerocopybenchMAX_ITEM ], ucReceived[ zerocopybenchMAX_ITEM ];
+
+	xQueue = xQueueCreate( zerocopybenchQUEUE_LENGTH, ( unsigned portBASE_TYPE ) xItemSize );
+	configASSERT( xQueue );
+
+	ulStart = benchGET_TIMESTAMP();
+
+	for( ulIteration = 0UL; ulIteration < zerocopybenchITERATIONS; ulIteration++ )
+	{
+		prvFillItem( ucSent, xItemSize, ulIteration );
+		( void ) xQueueSend( xQueue, ucSent, 0 );
+		( void ) xQueueReceive( xQueue, ucReceived, 0 );
+		ulSum += prvSumItem( ucReceived, xItemSize );
+	}
+
+	ulElapsed = benchGET_TIMESTAMP() - ulStart;
+
+	configASSERT( memcmp( ucSent, ucReceived, xItemSize ) == 0 );
+	configASSERT( ulSum != 0UL );
+
+	vQueueDelete( xQueue );
+
+	return ulElapsed / zerocopybenchITERATIONS;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeZeroCopyQueue( size_t xItemSize )
+{
+xZeroCopyQueueHandle xQueue;
+unsigned long ulIteration, ulStart, ulElapsed, ulSum = 0UL;
+unsigned char *pucSlot;
+
+	xQueue = xQueueCreateZeroCopy( zerocopybenchQUEUE_LENGTH, ( unsigned portBASE_TYPE ) xItemSize );
+	configASSERT( xQueue );
+
+	ulStart = benchGET_TIMESTAMP();
+
+	for( ulIteration = 0UL; ulIteration < zerocopybenchITERATIONS; ulIteration++ )
+	{
+		pucSlot = ( unsigned char * ) pvQueueAcquireSlot( xQueue, 0 );
+		configASSERT( pucSlot );
+		prvFillItem( pucSlot, xItemSize, ulIteration );
+		( void ) xQueueCommitSlot( xQueue, pucSlot );
+
+		pucSlot = ( unsigned char * ) pvQueueReceiveSlot( xQueue, 0 );
+		configASSERT( pucSlot );
+		ulSum += prvSumItem( pucSlot, xItemSize );
+		vQueueReleaseSlot( xQueue, pucSlot );
+	}
+
+	ulElapsed = benchGET_TIMESTAMP() - ulStart;
+
+	/* Every slot must have been returned to the pool. */
+	configASSERT( ulSum != 0UL );
+	configASSERT( uxQueueSlotsWaiting( xQueue ) == 0 );
+
+	vQueueDeleteZeroCopy( xQueue );
+
+	return ulElapsed / zerocopybenchITERATIONS;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeToTask( void *pvMechanism )
+{
+unsigned long ulIteration, ulStart, ulElapsed;
+unsigned portBASE_TYPE uxOriginalPriority;
+xTaskHandle xReceiver = NULL;
+unsigned char *pucSlot;
+static unsigned char ucSent[ zerocopybenchMAX_ITEM ];
+
+	xBenchQueue = xQueueCreate( zerocopybenchQUEUE_LENGTH, zerocopybenchMAX_ITEM );
+	xBenchZeroCopyQueue = xQueueCreateZeroCopy( zerocopybenchQUEUE_LENGTH, zerocopybenchMAX_ITEM );
+	configASSERT( xBenchQueue );
+	configASSERT( xBenchZeroCopyQueue );
+
+	/* The receiver runs at the priority of this task, which then drops its
+	own priority so the receiver runs as soon as it is unblocked. */
+	uxOriginalPriority = uxTaskPriorityGet( NULL );
+	configASSERT( uxOriginalPriority > tskIDLE_PRIORITY );
+
+	ulItemsReceived = 0UL;
+	xTaskCreate( prvZeroCopyBenchReceiver, ( signed char * ) "ZCRx", configMINIMAL_STACK_SIZE, pvMechanism, uxOriginalPriority, &xReceiver );
+	configASSERT( xReceiver );
+	vTaskPrioritySet( NULL, uxOriginalPriority - 1 );
+
+	/* The receiver has run and is now blocked. */
+	ulStart = benchGET_TIMESTAMP();
+
+	for( ulIteration = 0UL; ulIteration < zerocopybenchITERATIONS; ulIteration++ )
+	{
+		if( pvMechanism == zerocopybenchUSE_QUEUE )
+		{
+			prvFillItem( ucSent, zerocopybenchMAX_ITEM, ulIteration );
+			( void ) xQueueSend( xBenchQueue, ucSent, portMAX_DELAY );
+		}
+		else
+		{
+			pucSlot = ( unsigned char * ) pvQueueAcquireSlot( xBenchZeroCopyQueue, portMAX_DELAY );
+			configASSERT( pucSlot );
+			prvFillItem( pucSlot, zerocopybenchMAX_ITEM, ulIteration );
+			( void ) xQueueCommitSlot( xBenchZeroCopyQueue, pucSlot );
+		}
+	}
+
+	ulElapsed = benchGET_TIMESTAMP() - ulStart;
+
+	/* The receiver has the higher priority, so it has received every item
+	before the last send returned. */
+	configASSERT( ulItemsReceived == zerocopybenchITERATIONS );
+
+	vTaskDelete( xReceiver );
+	vTaskPrioritySet( NULL, uxOriginalPriority );
+
+	vQueueDelete( xBenchQueue );
+	vQueueDeleteZeroCopy( xBenchZeroCopyQueue );
+	xBenchQueue = NULL;
+	xBenchZeroCopyQueue = NULL;
+
+	return ulElapsed / zerocopybenchITERATIONS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvZeroCopyBenchReceiver( void *pvParameters )
+{
+unsigned char *pucSlot;
+static unsigned char ucReceived[ zerocopybenchMAX_ITEM ];
+
+	for( ;; )
+	{
+		if( pvParameters == zerocopybenchUSE_QUEUE )
+		{
+			if( xQueueReceive( xBenchQueue, ucReceived, portMAX_DELAY ) == pdPASS )
+			{
+				configASSERT( prvSumItem( ucReceived, zerocopybenchMAX_ITEM ) != 0UL );
+				ulItemsReceived++;
+			}
+		}
+		else
+		{
+			pucSlot = ( unsigned char * ) pvQueueReceiveSlot( xBenchZeroCopyQueue, portMAX_DELAY );
+
+			if( pucSlot != NULL )
+			{
+				configASSERT( prvSumItem( pucSlot, zerocopybenchMAX_ITEM ) != 0UL );
+				vQueueReleaseSlot( xBenchZeroCopyQueue, pucSlot );
+				ulItemsReceived++;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvFillItem( unsigned char *pucItem, size_t xItemSize, unsigned long ulIteration )
+{
+	/* Only the first and last bytes are written so the time taken to build
+	the item does not hide the cost of passing it. */
+	pucItem[ 0 ] = ( unsigned char ) ( ulIteration | 1UL );
+	pucItem[ xItemSize - 1 ] = ( unsigned char ) ulIteration;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvSumItem( const unsigned char *pucItem, size_t xItemSize )
+{
+	return ( unsigned long ) pucItem[ 0 ] + ( unsigned long ) pucItem[ xItemSize - 1 ];
+}
+/*-----------------------------------------------------------*/
+
+#else /* configUSE_ZERO_COPY_QUEUES */
+
+void vRunZeroCopyBenchmark( void )
+{
+	benchPRINTF( "Zero copy queue benchmark: configUSE_ZERO_COPY_QUEUES is 0\r\n" );
+}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+
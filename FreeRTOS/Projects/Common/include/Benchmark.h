@@ -0,0 +1,115 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+/*
+ * Definitions shared by the benchmark tasks.  Each benchmark is a function
+ * that is called from a task, runs to completion, and reports its results
+ * using benchPRINTF().  The timestamp source and the output function can be
+ * overridden by defining benchGET_TIMESTAMP(), benchTIMESTAMP_UNITS and
+ * benchPRINTF before this header is included.
+ */
+
+#ifndef benchGET_TIMESTAMP
+
+	#if defined( __PIC32MX__ )
+
+		/* The core timer counts at half the CPU clock. */
+		#include <xc.h>
+		#define benchGET_TIMESTAMP()	( ( unsigned long ) _CP0_GET_COUNT() )
+		#define benchTIMESTAMP_UNITS	"core timer counts"
+
+	#elif defined( __linux__ )
+
+		#include <time.h>
+
+		static inline unsigned long ulBenchGetTimestamp( void )
+		{
+		struct timespec xNow;
+
+			clock_gettime( CLOCK_MONOTONIC, &xNow );
+			return ( unsigned long ) ( ( xNow.tv_sec * 1000000000L ) + xNow.tv_nsec );
+		}
+
+		#define benchGET_TIMESTAMP()	ulBenchGetTimestamp()
+		#define benchTIMESTAMP_UNITS	"ns"
+
+	#else
+
+		#define benchGET_TIMESTAMP()	( ( unsigned long ) portGET_RUN_TIME_COUNTER_VALUE() )
+		#define benchTIMESTAMP_UNITS	"run time counts"
+
+	#endif
+
+#endif /* benchGET_TIMESTAMP */
+
+#ifndef benchPRINTF
+	#include <stdio.h>
+	#define benchPRINTF printf
+#endif
+
+#endif /* BENCHMARK_H */
+
@@ -0,0 +1,265 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+ * Application specific definitions.
+ *
+ * These definitions should be adjusted for your particular hardware and
+ * application requirements.
+ *
+ * THESE PARAMETERS ARE DESCRIBED WITHIN THE 'CONFIGURATION' SECTION OF THE
+ * FreeRTOS API DOCUMENTATION AVAILABLE ON THE FreeRTOS.org WEB SITE.
+ *
+ * See http://www.freertos.org/a00110.html.
+ *
+ * This configuration is for the Linux simulator port.  It follows the rd9
+ * Cerebot 32MX7cK settings wherever the host allows, so behaviour measured on
+ * the host is representative of the target.
+ *----------------------------------------------------------*/
+
+#define configUSE_PREEMPTION			1
+/* Task selection and the number of priorities can be set from the command
+line to compare the generic and port optimised task selection. */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION	0
+#endif
+#define configUSE_IDLE_HOOK			1
+#define configUSE_TICK_HOOK			0
+#define configTICK_RATE_HZ			( ( portTickType ) 1000 )
+#define configCPU_CLOCK_HZ			( ( unsigned long ) 80000000UL )
+#define configPERIPHERAL_CLOCK_HZ		( ( unsigned long ) 10000000UL )
+#ifndef configMAX_PRIORITIES
+	#define configMAX_PRIORITIES		( 5 )
+#endif
+#define configMINIMAL_STACK_SIZE		( 256 )
+#define configHOST_STACK_SIZE			( 64 * 1024 )
+#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 2 * 1024 * 1024 ) )
+#define configMAX_TASK_NAME_LEN			( 8 )
+/* 16 bit ticks can be selected from the command line to exercise tick count
+overflow within about a minute. */
+#ifndef configUSE_16_BIT_TICKS
+	#define configUSE_16_BIT_TICKS		0
+#endif
+#define configIDLE_SHOULD_YIELD			1
+#define configUSE_MUTEXES			1
+/* The stack overflow check can be selected from the command line to compare
+the cost of each method. */
+#ifndef configCHECK_FOR_STACK_OVERFLOW
+	#define configCHECK_FOR_STACK_OVERFLOW	3
+#endif
+#define configQUEUE_REGISTRY_SIZE		0
+
+#define configUSE_RECURSIVE_MUTEXES		1
+#define configUSE_MALLOC_FAILED_HOOK		1
+#define configUSE_APPLICATION_TASK_TAG		0
+#define configUSE_COUNTING_SEMAPHORES		1
+
+/* Ceiling mutexes are compared with priority inheritance mutexes by the
+ceiling mutex benchmark. */
+#ifndef configUSE_CEILING_MUTEXES
+	#define configUSE_CEILING_MUTEXES		1
+#endif
+
+/* The task pool benchmark compares reusing the TCBs and stacks of deleted
+tasks with allocating every task from the heap. */
+#ifndef configUSE_TASK_POOL
+	#define configUSE_TASK_POOL				1
+#endif
+
+/* Zero copy queues are used by the zero copy benchmark.  They need task
+notifications, so are left out when notifications are turned off from the
+command line. */
+#ifndef configUSE_ZERO_COPY_QUEUES
+	#ifdef configUSE_TASK_NOTIFICATIONS
+		#define configUSE_ZERO_COPY_QUEUES	configUSE_TASK_NOTIFICATIONS
+	#else
+		#define configUSE_ZERO_COPY_QUEUES	1
+	#endif
+#endif
+
+/* Queue sets are used by the queue set benchmark. */
+#ifndef configUSE_QUEUE_SETS
+	#define configUSE_QUEUE_SETS		1
+#endif
+
+/* Static allocation is used by the static allocation benchmark, and for the
+idle task, timer task and timer queue, so the demo starts without using the
+heap for kernel objects. */
+#ifndef configSUPPORT_STATIC_ALLOCATION
+	#define configSUPPORT_STATIC_ALLOCATION	1
+#endif
+
+/* Earliest deadline first scheduling is used by the EDF benchmark.  The test
+tasks that also run at configEDF_PRIORITY are not given deadlines, so are
+scheduled as normal. */
+#ifndef configUSE_EDF_SCHEDULING
+	#define configUSE_EDF_SCHEDULING		1
+#endif
+#define configEDF_PRIORITY				1
+
+/* Run time statistics use the microsecond clock provided by the port in
+place of the Timer 4 ulHighFrequencyTimerTicks count used on the target. */
+#define configGENERATE_RUN_TIME_STATS		1
+#define configUSE_TRACE_FACILITY                1
+#define configUSE_STATS_FORMATTING_FUNCTIONS    1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()	ulPortGetRunTimeCounterValue()
+
+/* A 32 bit microsecond counter wraps after about 71 minutes, so the run times
+are accumulated in 64 bits, as they would be on the target.  The processor load
+of each task is averaged over 1, 10 and 60 seconds for the CPU load
+benchmark. */
+#define configRUN_TIME_COUNTER_TYPE		unsigned long long
+#ifndef configUSE_CPU_LOAD
+	#define configUSE_CPU_LOAD				1
+#endif
+
+/* The snapshot table lets the statistics be read without suspending the
+scheduler.  It can be turned off from the command line for comparison. */
+#ifndef configUSE_TASK_SNAPSHOT
+	#define configUSE_TASK_SNAPSHOT			1
+#endif
+#define configTASK_SNAPSHOT_SLOTS		48
+
+/* The binary statistics stream is compared with the text tables by the stats
+stream benchmark. */
+#ifndef configUSE_STATS_STREAM
+	#define configUSE_STATS_STREAM			1
+#endif
+
+/* The high resolution timers are measured by the high resolution timer
+benchmark. */
+#ifndef configUSE_HR_TIMERS
+	#define configUSE_HR_TIMERS				1
+#endif
+
+/* Deferred calls are measured by the deferred call benchmark.  Like zero copy
+queues they need task notifications, so are left out when notifications are
+turned off from the command line. */
+#ifndef configUSE_DEFERRED_CALLS
+	#ifdef configUSE_TASK_NOTIFICATIONS
+		#define configUSE_DEFERRED_CALLS	configUSE_TASK_NOTIFICATIONS
+	#else
+		#define configUSE_DEFERRED_CALLS	1
+	#endif
+#endif
+
+/* The timer callback histograms are measured by the timer histogram benchmark,
+in microseconds from the run time statistics clock.  Otherwise they are checked
+by the timer histogram test task, which sets the time itself so knows exactly
+what each histogram should hold. */
+#ifndef configUSE_TIMER_HISTOGRAMS
+	#define configUSE_TIMER_HISTOGRAMS		1
+#endif
+#if defined( mainRUN_BENCHMARKS ) && ( mainRUN_BENCHMARKS == 1 )
+	#define configTIMER_HISTOGRAM_TIMESTAMP()	ulPortGetRunTimeCounterValue()
+	#define configTIMER_HISTOGRAM_COUNTS_PER_TICK	( 1000000UL / configTICK_RATE_HZ )
+#else
+	extern volatile unsigned long ulTimerHistogramDemoClock;
+	#define configTIMER_HISTOGRAM_TIMESTAMP()	ulTimerHistogramDemoClock
+	#define configTIMER_HISTOGRAM_COUNTS_PER_TICK	0UL
+#endif
+
+/* Co-routine definitions. */
+#define configUSE_CO_ROUTINES 			0
+#define configMAX_CO_ROUTINE_PRIORITIES         ( 2 )
+
+/* Software timer definitions. */
+#define configUSE_TIMERS			1
+#define configTIMER_TASK_PRIORITY		( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH		20
+#define configTIMER_TASK_STACK_DEPTH	( configMINIMAL_STACK_SIZE * 2 )
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+#define INCLUDE_vTaskPrioritySet		1
+#define INCLUDE_uxTaskPriorityGet		1
+#define INCLUDE_vTaskDelete			1
+#define INCLUDE_vTaskCleanUpResources		0
+#define INCLUDE_vTaskSuspend			1
+#define INCLUDE_vTaskDelayUntil			1
+#define INCLUDE_vTaskDelay			1
+#define INCLUDE_uxTaskGetStackHighWaterMark	1
+#define INCLUDE_xTaskGetSchedulerState		1
+#define INCLUDE_xTimerGetTimerDaemonTaskHandle	1
+#define INCLUDE_xTimerPendFunctionCall		1
+#define INCLUDE_xTimerGetTimerByName		1
+#define INCLUDE_xTaskGetIdleTaskHandle		1
+#define INCLUDE_xSemaphoreGetMutexHolder	1
+
+/* Abort on assert so a failure is reported by the test run. */
+void vAssertCalled( const char *pcFileName, unsigned long ulLine );
+#define configASSERT( x ) if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ )
+
+/* The priority at which the tick interrupt runs.  Interrupt priorities are
+not modelled by the simulator, which masks all simulated interrupts at once,
+but the values are kept for parity with the target configuration. */
+#define configKERNEL_INTERRUPT_PRIORITY		0x01
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY	0x03
+
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,432 @@
+/*  Linux simulator test harness
+ * Project:     Posix_GCC
+ * File name:   main
+ *
+ * Description: Runs the kernel on an x86 Linux host using the
+ *              portable/GCC/Linux port so tasks.c, queue.c and timers.c
+ *              can be exercised and measured without a chipKIT board.
+ *
+ *              The standard Common/Minimal test tasks are created together
+ *              with a check task.  Every mainCHECK_PERIOD_MS the check task
+ *              asks each group of test tasks whether it is still running
+ *              without error and prints the result.  When the run time
+ *              given on the command line (in seconds) has elapsed the
+ *              scheduler is stopped and the process exits with status 0 if
+ *              every check passed, or 1 if any check failed, so the build
+ *              can be run as a regression test.
+ *
+ *              Usage:  posix_demo [run time in seconds]
+ *                      A run time of 0, the default, runs forever.
+ *
+ *              When built with mainRUN_BENCHMARKS set to 1 (make bench) the
+ *              test tasks are not created.  Instead a single task runs each
+ *              benchmark in turn, prints the results and stops the
+ *              scheduler.
+ *
+ *****************************************************************************/
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Files to support FreeRTOS */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+
+/* Common/Minimal test tasks */
+#include "BlockQ.h"
+#include "blocktim.h"
+#include "countsem.h"
+#include "death.h"
+#include "dynamic.h"
+#include "EventGroupsDemo.h"
+#include "GenQTest.h"
+#include "integer.h"
+#include "PollQ.h"
+#include "QPeek.h"
+#include "recmutex.h"
+#include "semtest.h"
+#include "TimerDemo.h"
+#include "TimerHistogramDemo.h"
+
+/* Benchmarks */
+#include "TickBench.h"
+#include "NotifyBench.h"
+#include "StreamBench.h"
+#include "MessageBench.h"
+#include "ZeroCopyBench.h"
+#include "BatchBench.h"
+#include "QueueSetBench.h"
+#include "EventGroupBench.h"
+#include "TicklessModel.h"
+#include "StaticAllocBench.h"
+#include "EDFBench.h"
+#include "SwitchBench.h"
+#include "CriticalBench.h"
+#include "StackCheckBench.h"
+#include "SnapshotBench.h"
+#include "CPULoadBench.h"
+#include "StatsStreamBench.h"
+#include "CeilingMutexBench.h"
+#include "TaskPoolBench.h"
+#include "TimerWheelBench.h"
+#include "TimerCommandBench.h"
+#include "HRTimerBench.h"
+#include "DeferredCallBench.h"
+#include "TimerHistogramBench.h"
+
+/* Set to 1 to run the benchmarks instead of the standard test tasks. */
+#ifndef mainRUN_BENCHMARKS
+    #define mainRUN_BENCHMARKS  0
+#endif
+
+/* Task priorities. */
+#define mainQUEUE_POLL_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define mainSEM_TEST_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define mainBLOCK_Q_PRIORITY		( tskIDLE_PRIORITY + 2 )
+#define mainCREATOR_TASK_PRIORITY	( tskIDLE_PRIORITY + 3 )
+#define mainINTEGER_TASK_PRIORITY	( tskIDLE_PRIORITY )
+#define mainGEN_QUEUE_TASK_PRIORITY	( tskIDLE_PRIORITY )
+#define mainCHECK_TASK_PRIORITY		( configMAX_PRIORITIES - 1 )
+
+/* How often the check task runs, and the base period used by the software
+timer tests. */
+#define mainCHECK_PERIOD_MS		( 5000 / portTICK_RATE_MS )
+#define mainTIMER_TEST_PERIOD		( 50 )
+
+#if mainRUN_BENCHMARKS == 1
+    /* The task that runs the benchmarks. */
+    static void prvBenchmarkTask( void *pvParameters );
+#else
+    /* The check task. */
+    static void prvCheckTask( void *pvParameters );
+#endif
+
+/* Run time, in seconds, taken from the command line. */
+static unsigned long ulRunTimeSeconds = 0UL;
+
+/* Set by the check task if any test reports an error. */
+static volatile portBASE_TYPE xErrorDetected = pdFALSE;
+
+/* main Function Description ***************************************
+ * SYNTAX:		int main( int argc, char *argv[] );
+ * KEYWORDS:		Initialize, create, tasks, scheduler
+ * DESCRIPTION:         Creates the test tasks and the check task then
+ *                      starts the scheduler.
+ * PARAMETERS:		argv[1] - optional run time in seconds
+ * RETURN VALUE:	0 if every check passed, otherwise 1
+ * NOTES:		The scheduler only returns if the check task calls
+ *                      vTaskEndScheduler().
+ * END DESCRIPTION *****************************************************/
+int main( int argc, char *argv[] )
+{
+    if( argc > 1 )
+    {
+        ulRunTimeSeconds = strtoul( argv[ 1 ], NULL, 10 );
+    }
+
+#if mainRUN_BENCHMARKS == 1
+    xTaskCreate( prvBenchmarkTask, ( signed char * ) "Bench", configMINIMAL_STACK_SIZE,
+                    NULL, mainCHECK_TASK_PRIORITY, NULL );
+#else
+    /* Start the standard test tasks. */
+    vStartBlockingQueueTasks( mainBLOCK_Q_PRIORITY );
+    vCreateBlockTimeTasks();
+    vStartCountingSemaphoreTasks();
+    vStartDynamicPriorityTasks();
+    vStartEventGroupTasks();
+    vStartGenericQueueTasks( mainGEN_QUEUE_TASK_PRIORITY );
+    vStartIntegerMathTasks( mainINTEGER_TASK_PRIORITY );
+    vStartPolledQueueTasks( mainQUEUE_POLL_PRIORITY );
+    vStartQueuePeekTasks();
+    vStartRecursiveMutexTasks();
+    vStartSemaphoreTasks( mainSEM_TEST_PRIORITY );
+    vStartTimerDemoTask( mainTIMER_TEST_PERIOD );
+    vStartTimerHistogramTasks();
+
+    xTaskCreate( prvCheckTask, ( signed char * ) "Check", configMINIMAL_STACK_SIZE,
+                    NULL, mainCHECK_TASK_PRIORITY, NULL );
+
+    /* The suicide tasks must be created last as they need to know how many
+     * tasks were running prior to their creation. */
+    vCreateSuicidalTasks( mainCREATOR_TASK_PRIORITY );
+#endif /* mainRUN_BENCHMARKS */
+
+    vTaskStartScheduler();
+
+    /* Will only reach here if the check task ended the scheduler, or if
+     * there was insufficient heap to start it. */
+    if( xErrorDetected != pdFALSE )
+    {
+        printf( "FAIL\r\n" );
+        return 1;
+    }
+
+    printf( "PASS\r\n" );
+    return 0;
+}
+
+#if mainRUN_BENCHMARKS == 0
+
+/* prvCheckTask Function Description ***************************************
+ * SYNTAX:          static void prvCheckTask( void *pvParameters );
+ * KEYWORDS:        Check, status, regression
+ * DESCRIPTION:     Periodically queries each group of test tasks and prints
+ *                  the result.  Ends the scheduler once the requested run
+ *                  time has elapsed.
+ * PARAMETER 1:     void pointer - not used
+ * RETURN VALUE:    None (There is no returning from TASK functions)
+ * NOTES:           The software timer test is queried at the check period
+ *                  as it is the period at which it is called.
+ * END DESCRIPTION *****************************************************/
+static void prvCheckTask( void *pvParameters )
+{
+portTickType xLastWakeTime;
+unsigned long ulElapsedSeconds = 0UL;
+const char *pcStatus;
+
+    ( void ) pvParameters;
+
+    xLastWakeTime = xTaskGetTickCount();
+    for( ;; )
+    {
+        vTaskDelayUntil( &xLastWakeTime, mainCHECK_PERIOD_MS );
+        ulElapsedSeconds += ( mainCHECK_PERIOD_MS * portTICK_RATE_MS ) / 1000UL;
+        pcStatus = "OK";
+
+        if( xAreTimerDemoTasksStillRunning( mainCHECK_PERIOD_MS ) != pdTRUE )
+        {
+            pcStatus = "Error in timer test tasks";
+        }
+        else if( xAreTimerHistogramTasksStillRunning() != pdTRUE )
+        {
+            pcStatus = "Error in timer histogram tasks";
+        }
+        else if( xAreBlockingQueuesStillRunning() != pdTRUE )
+        {
+            pcStatus = "Error in blocking queue tasks";
+        }
+        else if( xAreBlockTimeTestTasksStillRunning() != pdTRUE )
+        {
+            pcStatus = "Error in block time test tasks";
+        }
+        else if( xAreCountingSemaphoreTasksStillRunning() != pdTRUE )
+        {
+            pcStatus = "Error in counting semaphore tasks";
+        }
+        else if( xAreDynamicPriorityTasksStillRunning() != pdTRUE )
+        {
+            pcStatus = "Error in dynamic priority tasks";
+        }
+        else if( xAreEventGroupTasksStillRunning() != pdTRUE )
+        {
+            pcStatus = "Error in event group tasks";
+        }
+        else if( xAreGenericQueueTasksStillRunning() != pdTRUE )
+        {
+            pcStatus = "Error in generic queue tasks";
+        }
+        else if( xAreIntegerMathsTaskStillRunning() != pdTRUE )
+        {
+            pcStatus = "Error in integer maths tasks";
+        }
+        else if( xArePollingQueuesStillRunning() != pdTRUE )
+        {
+            pcStatus = "Error in polling queue tasks";
+        }
+        else if( xAreQueuePeekTasksStillRunning() != pdTRUE )
+        {
+            pcStatus = "Error in queue peek tasks";
+        }
+        else if( xAreRecursiveMutexTasksStillRunning() != pdTRUE )
+        {
+            pcStatus = "Error in recursive mutex tasks";
+        }
+        else if( xAreSemaphoreTasksStillRunning() != pdTRUE )
+        {
+            pcStatus = "Error in semaphore tasks";
+        }
+        else if( xIsCreateTaskStillRunning() != pdTRUE )
+        {
+            pcStatus = "Error in suicidal tasks";
+        }
+
+        if( pcStatus[ 0 ] != 'O' )
+        {
+            xErrorDetected = pdTRUE;
+        }
+
+        printf( "%lus ticks=%lu %s\r\n", ulElapsedSeconds,
+                    ( unsigned long ) xTaskGetTickCount(), pcStatus );
+        fflush( stdout );
+
+        if( ( ulRunTimeSeconds != 0UL ) && ( ulElapsedSeconds >= ulRunTimeSeconds ) )
+        {
+            vTaskEndScheduler();
+        }
+    }
+}
+
+#endif /* mainRUN_BENCHMARKS == 0 */
+
+#if mainRUN_BENCHMARKS == 1
+
+/* prvBenchmarkTask Function Description ***********************************
+ * SYNTAX:          static void prvBenchmarkTask( void *pvParameters );
+ * KEYWORDS:        Benchmark, performance
+ * DESCRIPTION:     Runs each benchmark to completion in turn, then ends the
+ *                  scheduler.
+ * PARAMETER 1:     void pointer - not used
+ * RETURN VALUE:    None (There is no returning from TASK functions)
+ * NOTES:           The benchmarks print their own results.
+ * END DESCRIPTION *****************************************************/
+static void prvBenchmarkTask( void *pvParameters )
+{
+    ( void ) pvParameters;
+
+    vRunTickBenchmark();
+    vRunNotifyBenchmark();
+    vRunStreamBenchmark();
+    vRunMessageBenchmark();
+    vRunZeroCopyBenchmark();
+    vRunBatchBenchmark();
+    vRunQueueSetBenchmark();
+    vRunEventGroupBenchmark();
+    vRunTicklessModel();
+    vRunStaticAllocBenchmark();
+    vRunEDFBenchmark();
+    vRunSwitchBenchmark();
+    vRunCriticalBenchmark();
+    vRunStackCheckBenchmark();
+    vRunSnapshotBenchmark();
+    vRunCPULoadBenchmark();
+    vRunStatsStreamBenchmark();
+    vRunCeilingMutexBenchmark();
+    vRunTaskPoolBenchmark();
+    vRunTimerWheelBenchmark();
+    vRunTimerCommandBenchmark();
+    vRunHRTimerBenchmark();
+    vRunDeferredCallBenchmark();
+    vRunTimerHistogramBenchmark();
+
+    fflush( stdout );
+    vTaskEndScheduler();
+
+    for( ;; );
+}
+
+#endif /* mainRUN_BENCHMARKS == 1 */
+
+/* vApplicationIdleHook Function Description *******************************
+ * SYNTAX:          void vApplicationIdleHook( void );
+ * KEYWORDS:        Idle, hook
+ * DESCRIPTION:     Called on each iteration of the idle task.
+ * PARAMETERS:      None
+ * RETURN VALUE:    None
+ * NOTES:           Must never block.
+ * END DESCRIPTION *****************************************************/
+void vApplicationIdleHook( void )
+{
+}
+
+/* vApplicationMallocFailedHook Function Description ***********************
+ * SYNTAX:          void vApplicationMallocFailedHook( void );
+ * KEYWORDS:        Heap, error
+ * DESCRIPTION:     Called if pvPortMalloc() fails.
+ * PARAMETERS:      None
+ * RETURN VALUE:    None
+ * NOTES:           Treated as a test failure.
+ * END DESCRIPTION *****************************************************/
+void vApplicationMallocFailedHook( void )
+{
+    vAssertCalled( __FILE__, __LINE__ );
+}
+
+/* vApplicationStackOverflowHook Function Description **********************
+ * SYNTAX:          void vApplicationStackOverflowHook( xTaskHandle pxTask,
+ *                                          signed char *pcTaskName );
+ * KEYWORDS:        Stack, error
+ * DESCRIPTION:     Called if a stack overflow is detected.
+ * PARAMETERS:      pxTask - the offending task
+ *                  pcTaskName - its name
+ * RETURN VALUE:    None
+ * NOTES:           Treated as a test failure.
+ * END DESCRIPTION *****************************************************/
+void vApplicationStackOverflowHook( xTaskHandle pxTask, signed char *pcTaskName )
+{
+    ( void ) pxTask;
+    printf( "Stack overflow in %s\r\n", ( char * ) pcTaskName );
+    vAssertCalled( __FILE__, __LINE__ );
+}
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+/* vApplicationGetIdleTaskMemory Function Description **********************
+ * SYNTAX:          void vApplicationGetIdleTaskMemory(
+ *                          xStaticTaskType **ppxIdleTaskTCBBuffer,
+ *                          portSTACK_TYPE **ppxIdleTaskStackBuffer,
+ *                          unsigned short *pusIdleTaskStackSize );
+ * KEYWORDS:        Idle, static allocation
+ * DESCRIPTION:     Provides the memory used by the idle task.
+ * PARAMETERS:      ppxIdleTaskTCBBuffer - set to the task's TCB
+ *                  ppxIdleTaskStackBuffer - set to the task's stack
+ *                  pusIdleTaskStackSize - set to the stack size in words
+ * RETURN VALUE:    None
+ * NOTES:           Called once by vTaskStartScheduler().
+ * END DESCRIPTION *****************************************************/
+void vApplicationGetIdleTaskMemory( xStaticTaskType **ppxIdleTaskTCBBuffer, portSTACK_TYPE **ppxIdleTaskStackBuffer, unsigned short *pusIdleTaskStackSize )
+{
+static xStaticTaskType xIdleTaskTCB;
+static portSTACK_TYPE uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+    *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+    *ppxIdleTaskStackBuffer = uxIdleTaskStack;
+    *pusIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+/* vApplicationGetTimerTaskMemory Function Description *********************
+ * SYNTAX:          void vApplicationGetTimerTaskMemory(
+ *                          xStaticTaskType **ppxTimerTaskTCBBuffer,
+ *                          portSTACK_TYPE **ppxTimerTaskStackBuffer,
+ *                          unsigned short *pusTimerTaskStackSize );
+ * KEYWORDS:        Timer, static allocation
+ * DESCRIPTION:     Provides the memory used by the timer service task.
+ * PARAMETERS:      ppxTimerTaskTCBBuffer - set to the task's TCB
+ *                  ppxTimerTaskStackBuffer - set to the task's stack
+ *                  pusTimerTaskStackSize - set to the stack size in words
+ * RETURN VALUE:    None
+ * NOTES:           Called once by vTaskStartScheduler().
+ * END DESCRIPTION *****************************************************/
+void vApplicationGetTimerTaskMemory( xStaticTaskType **ppxTimerTaskTCBBuffer, portSTACK_TYPE **ppxTimerTaskStackBuffer, unsigned short *pusTimerTaskStackSize )
+{
+static xStaticTaskType xTimerTaskTCB;
+static portSTACK_TYPE uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+
+    *ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+    *ppxTimerTaskStackBuffer = uxTimerTaskStack;
+    *pusTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+/* vAssertCalled Function Description **************************************
+ * SYNTAX:          void vAssertCalled( const char *pcFileName,
+ *                                          unsigned long ulLine );
+ * KEYWORDS:        Assert, error
+ * DESCRIPTION:     Called by configASSERT() when an assertion fails.
+ * PARAMETERS:      pcFileName - source file of the assertion
+ *                  ulLine - line of the assertion
+ * RETURN VALUE:    None - the process exits
+ * NOTES:           Exits with status 2 so a CI run distinguishes an
+ *                  assertion from a failed check.
+ * END DESCRIPTION *****************************************************/
+void vAssertCalled( const char *pcFileName, unsigned long ulLine )
+{
+    printf( "ASSERT: %s:%lu\r\n", pcFileName, ulLine );
+    fflush( stdout );
+    exit( 2 );
+}
+
+/*--------------------------End of main for Posix_GCC -----------------------*/
@@ -0,0 +1,367 @@
+/*  Host decoder for the binary task statistics stream
+ * Project:     Posix_GCC
+ * File name:   statsdecode
+ *
+ * Description: Reads the frames written by xTaskGetStatsStream() on the
+ *              target, from a capture file or from standard input, and
+ *              prints each report as a table holding what vTaskList() and
+ *              vTaskGetRunTimeStats() would have written.  The target only
+ *              sends binary frames, so the text formatting, and the
+ *              percentage calculations, are done here instead.
+ *
+ *              Bytes that are not part of a frame with a correct checksum
+ *              are skipped, so the CR the rd9 line send task adds after each
+ *              frame, or any text sent on the same UART, is ignored.  Task
+ *              names are sent once, so the decoder remembers them from
+ *              report to report.  Start the decoder before the target, or
+ *              have the target set xResendNames, so every name is seen.
+ *
+ *              Usage:  statsdecode [capture file]
+ *                      Reads standard input if no file is given, for
+ *                      example from a serial port set to raw mode.
+ *
+ *****************************************************************************/
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* The frame definitions, and eTaskState, are taken from the kernel headers.
+Nothing in the kernel is linked. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The longest frame: the sync byte, type and length, a payload of up to 255
+bytes, and the checksum. */
+#define decodeMAX_FRAME         ( 3 + 255 + 1 )
+
+/* The number of task names, and of task frames in one report, held. */
+#define decodeMAX_TASKS         ( 256 )
+
+/* Task names longer than this are cut short in the table. */
+#define decodeMAX_NAME          ( 32 )
+
+typedef struct DECODE_TASK
+{
+    unsigned short usNumber;
+    unsigned char ucState;
+    unsigned char ucPriority;
+    unsigned short usStackHighWaterMark;
+    unsigned long ulRunTime;
+} xDecodeTask;
+
+typedef struct DECODE_NAME
+{
+    unsigned short usNumber;
+    char cName[ decodeMAX_NAME ];
+} xDecodeName;
+
+/* The names received so far. */
+static xDecodeName xNames[ decodeMAX_TASKS ];
+static int iNames = 0;
+
+/* The report being received. */
+static xDecodeTask xTasks[ decodeMAX_TASKS ];
+static int iTasks = 0;
+static int iExpectedTasks = -1;
+static unsigned short usSequence;
+static unsigned long ulTotalRunTime;
+
+/* For spotting lost reports and damaged frames. */
+static int iHaveSequence = 0;
+static unsigned short usLastSequence;
+static unsigned long ulBadFrames = 0UL;
+
+static void prvFrameReceived( const unsigned char *pucFrame );
+static void prvPrintReport( void );
+static const char *prvTaskName( unsigned short usNumber );
+static const char *prvStateName( unsigned char ucState );
+static unsigned short prvGet16( const unsigned char *pucField );
+static unsigned long prvGet32( const unsigned char *pucField );
+
+/* main Function Description **************************************************
+ * SYNTAX:      int main( int argc, char *argv[] );
+ * KEYWORDS:    Decode, frame, synchronise
+ * DESCRIPTION: Assembles frames from the input one byte at a time.  A frame
+ *              whose checksum is wrong is discarded from its sync byte only,
+ *              and the search for the next sync byte starts at the byte
+ *              after it, so a stray sync byte costs no real frame.
+ * PARAMETERS:  Optional name of a capture file to read
+ * RETURN VALUE: 0, or 1 if the file could not be opened
+ * NOTES:       None
+ * END DESCRIPTION ***********************************************************/
+int main( int argc, char *argv[] )
+{
+FILE *pxInput = stdin;
+unsigned char ucFrame[ decodeMAX_FRAME ];
+unsigned char ucSum;
+size_t xHave = 0, xNeed, xByte;
+int iChar;
+
+    if( argc > 1 )
+    {
+        pxInput = fopen( argv[ 1 ], "rb" );
+
+        if( pxInput == NULL )
+        {
+            perror( argv[ 1 ] );
+            return 1;
+        }
+    }
+
+    while( ( iChar = fgetc( pxInput ) ) != EOF )
+    {
+        ucFrame[ xHave++ ] = ( unsigned char ) iChar;
+
+        for( ;; )
+        {
+            /* Discard bytes until a frame starts with a sync byte. */
+            for( xByte = 0; ( xByte < xHave ) && ( ucFrame[ xByte ] != tskSTATS_FRAME_SYNC ); xByte++ )
+            {
+            }
+
+            if( xByte > 0 )
+            {
+                memmove( ucFrame, &( ucFrame[ xByte ] ), xHave - xByte );
+                xHave -= xByte;
+            }
+
+            /* Is the whole frame here yet? */
+            if( xHave < 3 )
+            {
+                break;
+            }
+
+            xNeed = tskSTATS_FRAME_SIZE( ucFrame );
+
+            if( xHave < xNeed )
+            {
+                break;
+            }
+
+            ucSum = 0;
+
+            for( xByte = 1; xByte < xNeed; xByte++ )
+            {
+                ucSum = ( unsigned char ) ( ucSum + ucFrame[ xByte ] );
+            }
+
+            if( ucSum == 0 )
+            {
+                prvFrameReceived( ucFrame );
+            }
+            else
+            {
+                /* Not a frame, or a damaged one.  Drop the sync byte only and
+                search again. */
+                ulBadFrames++;
+                xNeed = 1;
+            }
+
+            memmove( ucFrame, &( ucFrame[ xNeed ] ), xHave - xNeed );
+            xHave -= xNeed;
+        }
+    }
+
+    if( ( iExpectedTasks >= 0 ) && ( iTasks < iExpectedTasks ) )
+    {
+        printf( "Report %u ended after %d of %d tasks\n", ( unsigned ) usSequence, iTasks, iExpectedTasks );
+    }
+
+    if( ulBadFrames > 0UL )
+    {
+        printf( "%lu damaged frames skipped\n", ulBadFrames );
+    }
+
+    if( pxInput != stdin )
+    {
+        fclose( pxInput );
+    }
+
+    return 0;
+}
+
+/* prvFrameReceived Function Description **************************************
+ * SYNTAX:      static void prvFrameReceived( const unsigned char *pucFrame );
+ * KEYWORDS:    Decode, report, name, task
+ * DESCRIPTION: Acts on one frame whose checksum is correct.  A report frame
+ *              starts a new table, a name frame is remembered, and a task
+ *              frame adds a row.  The table is printed when the last task
+ *              frame of the report arrives.
+ * PARAMETERS:  The frame, starting at its sync byte
+ * RETURN VALUE: None
+ * NOTES:       Frames of a type or length this decoder does not know are
+ *              ignored, so frames can be added without breaking it.
+ * END DESCRIPTION ***********************************************************/
+static void prvFrameReceived( const unsigned char *pucFrame )
+{
+const unsigned char *pucPayload = &( pucFrame[ 3 ] );
+unsigned char ucLength = pucFrame[ 2 ];
+unsigned short usNumber;
+size_t xNameLength;
+int iName;
+
+    if( ( pucFrame[ 1 ] == tskSTATS_FRAME_REPORT ) && ( ucLength >= tskSTATS_REPORT_PAYLOAD ) )
+    {
+        if( ( iExpectedTasks >= 0 ) && ( iTasks < iExpectedTasks ) )
+        {
+            printf( "Report %u ended after %d of %d tasks\n\n", ( unsigned ) usSequence, iTasks, iExpectedTasks );
+        }
+
+        usSequence = prvGet16( &( pucPayload[ 0 ] ) );
+        iExpectedTasks = pucPayload[ 2 ];
+        ulTotalRunTime = prvGet32( &( pucPayload[ 3 ] ) );
+        iTasks = 0;
+
+        if( ( iHaveSequence != 0 ) && ( usSequence != ( unsigned short ) ( usLastSequence + 1U ) ) )
+        {
+            printf( "%u reports lost\n\n", ( unsigned ) ( unsigned short ) ( usSequence - usLastSequence - 1U ) );
+        }
+
+        iHaveSequence = 1;
+        usLastSequence = usSequence;
+    }
+    else if( ( pucFrame[ 1 ] == tskSTATS_FRAME_NAME ) && ( ucLength >= 2 ) )
+    {
+        usNumber = prvGet16( &( pucPayload[ 0 ] ) );
+
+        /* Replace the name already held for the task, if there is one. */
+        for( iName = 0; ( iName < iNames ) && ( xNames[ iName ].usNumber != usNumber ); iName++ )
+        {
+        }
+
+        if( iName == iNames )
+        {
+            if( iNames < decodeMAX_TASKS )
+            {
+                iNames++;
+            }
+            else
+            {
+                /* The table is full, so forget the oldest name. */
+                memmove( &( xNames[ 0 ] ), &( xNames[ 1 ] ), sizeof( xNames ) - sizeof( xNames[ 0 ] ) );
+                iName = decodeMAX_TASKS - 1;
+            }
+        }
+
+        xNameLength = ( size_t ) ucLength - 2;
+
+        if( xNameLength > ( decodeMAX_NAME - 1 ) )
+        {
+            xNameLength = decodeMAX_NAME - 1;
+        }
+
+        xNames[ iName ].usNumber = usNumber;
+        memcpy( xNames[ iName ].cName, &( pucPayload[ 2 ] ), xNameLength );
+        xNames[ iName ].cName[ xNameLength ] = '\0';
+    }
+    else if( ( pucFrame[ 1 ] == tskSTATS_FRAME_TASK ) && ( ucLength >= tskSTATS_TASK_PAYLOAD ) )
+    {
+        /* A task frame is only expected after its report frame. */
+        if( iTasks < iExpectedTasks )
+        {
+            xTasks[ iTasks ].usNumber = prvGet16( &( pucPayload[ 0 ] ) );
+            xTasks[ iTasks ].ucState = pucPayload[ 2 ];
+            xTasks[ iTasks ].ucPriority = pucPayload[ 3 ];
+            xTasks[ iTasks ].usStackHighWaterMark = prvGet16( &( pucPayload[ 4 ] ) );
+            xTasks[ iTasks ].ulRunTime = prvGet32( &( pucPayload[ 6 ] ) );
+            iTasks++;
+
+            if( iTasks == iExpectedTasks )
+            {
+                prvPrintReport();
+                iExpectedTasks = -1;
+            }
+        }
+    }
+}
+
+/* prvPrintReport Function Description ****************************************
+ * SYNTAX:      static void prvPrintReport( void );
+ * KEYWORDS:    Print, table, percentage
+ * DESCRIPTION: Prints the task frames of the report just received as a
+ *              table.  Each task's share of the processor is its run time
+ *              since the previous report as a percentage of the total run
+ *              time since the previous report.
+ * PARAMETERS:  None
+ * RETURN VALUE: None
+ * NOTES:       The run time in the first report is counted from when the
+ *              run time counter was started.
+ * END DESCRIPTION ***********************************************************/
+static void prvPrintReport( void )
+{
+int iTask;
+unsigned long ulPercent;
+
+    printf( "Report %u: %d tasks, run time %lu\n", ( unsigned ) usSequence, iTasks, ulTotalRunTime );
+    printf( "Task                     No. State     Prio Stack   Run time    %%\n" );
+
+    for( iTask = 0; iTask < iTasks; iTask++ )
+    {
+        printf( "%-24s %4u %-9s %4u %5u %10lu ", prvTaskName( xTasks[ iTask ].usNumber ), ( unsigned ) xTasks[ iTask ].usNumber,
+                prvStateName( xTasks[ iTask ].ucState ), ( unsigned ) xTasks[ iTask ].ucPriority,
+                ( unsigned ) xTasks[ iTask ].usStackHighWaterMark, xTasks[ iTask ].ulRunTime );
+
+        if( ulTotalRunTime == 0UL )
+        {
+            printf( "   -\n" );
+        }
+        else
+        {
+            ulPercent = ( unsigned long ) ( ( ( unsigned long long ) xTasks[ iTask ].ulRunTime * 100ULL ) / ( unsigned long long ) ulTotalRunTime );
+
+            if( ( ulPercent == 0UL ) && ( xTasks[ iTask ].ulRunTime != 0UL ) )
+            {
+                printf( "  <1\n" );
+            }
+            else
+            {
+                printf( "%4lu\n", ulPercent );
+            }
+        }
+    }
+
+    printf( "\n" );
+    fflush( stdout );
+}
+
+static const char *prvTaskName( unsigned short usNumber )
+{
+int iName;
+
+    for( iName = 0; iName < iNames; iName++ )
+    {
+        if( xNames[ iName ].usNumber == usNumber )
+        {
+            return xNames[ iName ].cName;
+        }
+    }
+
+    return "?";
+}
+
+static const char *prvStateName( unsigned char ucState )
+{
+    switch( ucState )
+    {
+        case eRunning:      return "Running";
+        case eReady:        return "Ready";
+        case eBlocked:      return "Blocked";
+        case eSuspended:    return "Suspended";
+        case eDeleted:      return "Deleted";
+        default:            return "?";
+    }
+}
+
+/* Multi-byte fields are sent least significant byte first. */
+static unsigned short prvGet16( const unsigned char *pucField )
+{
+    return ( unsigned short ) ( pucField[ 0 ] | ( pucField[ 1 ] << 8 ) );
+}
+
+static unsigned long prvGet32( const unsigned char *pucField )
+{
+    return ( unsigned long ) prvGet16( pucField ) | ( ( unsigned long ) prvGet16( &( pucField[ 2 ] ) ) << 16 );
+}
+
+/*------------------ End of statsdecode  --------------------------*/
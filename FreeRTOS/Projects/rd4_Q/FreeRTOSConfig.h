@@ -82,13 +82,13 @@
  *----------------------------------------------------------*/
 
 #define configUSE_PREEMPTION			1
-#define configUSE_PORT_OPTIMISED_TASK_SELECTION	0   /* Do not use for MPLAB X */
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION	1
 #define configUSE_IDLE_HOOK			1
 #define configUSE_TICK_HOOK			0
 #define configTICK_RATE_HZ			( ( portTickType ) 1000 )
 #define configCPU_CLOCK_HZ			( ( unsigned long ) 80000000UL )  
 #define configPERIPHERAL_CLOCK_HZ		( ( unsigned long ) 10000000UL )
-#define configMAX_PRIORITIES			( ( unsigned portBASE_TYPE ) 5 )
+#define configMAX_PRIORITIES			( 5 )	/* No cast, it is tested by the preprocessor. */
 #define configMINIMAL_STACK_SIZE		( 256 )
 #define configISR_STACK_SIZE			( 512 )
 #define configTOTAL_HEAP_SIZE			( ( size_t ) 28000 )
@@ -96,7 +96,7 @@
 #define configUSE_16_BIT_TICKS			0
 #define configIDLE_SHOULD_YIELD			1
 #define configUSE_MUTEXES			1
-#define configCHECK_FOR_STACK_OVERFLOW          2
+#define configCHECK_FOR_STACK_OVERFLOW          3
 #define configQUEUE_REGISTRY_SIZE		0
 
 /* **************** FreeRTOS V7.5.2 ************ */
@@ -0,0 +1,435 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "deferred.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+
+/* This entire source file will be skipped if the application is not configured
+to include deferred call functionality.  This #if is closed at the very bottom
+of this file.  If you want to include deferred call functionality then ensure
+configUSE_DEFERRED_CALLS is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_DEFERRED_CALLS == 1 )
+
+#if ( ( configDEFERRED_CALL_QUEUE_LENGTH & ( configDEFERRED_CALL_QUEUE_LENGTH - 1 ) ) != 0 )
+	#error configDEFERRED_CALL_QUEUE_LENGTH must be a power of 2.
+#endif
+
+/* Pended calls are timed with the run time stats clock if there is one. */
+#ifndef configDEFERRED_CALL_TIMESTAMP
+	#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		#define configDEFERRED_CALL_TIMESTAMP()	( ( unsigned long ) portGET_RUN_TIME_COUNTER_VALUE() )
+	#else
+		#define configDEFERRED_CALL_TIMESTAMP()	( ( unsigned long ) xTaskGetTickCountFromISR() )
+	#endif
+#endif
+
+/* Ports that have an atomic compare and swap instruction define
+portCOMPARE_AND_SWAP() in portmacro.h.  Other ports use prvCompareAndSwap(),
+which masks interrupts for the duration of the comparison. */
+#ifdef portCOMPARE_AND_SWAP
+	#define dcCOMPARE_AND_SWAP( pulTarget, ulExpected, ulNew )	portCOMPARE_AND_SWAP( ( pulTarget ), ( ulExpected ), ( ulNew ) )
+#else
+	#define dcCOMPARE_AND_SWAP( pulTarget, ulExpected, ulNew )	prvCompareAndSwap( ( pulTarget ), ( ulExpected ), ( ulNew ) )
+#endif
+
+#define dcINDEX_MASK		( ( unsigned long ) configDEFERRED_CALL_QUEUE_LENGTH - 1UL )
+
+/* One slot of a ring.  ulSequence holds the position at which the slot can
+next be reserved, which is one lap of the ring beyond the position of the call
+it last held.  Once a call has been written into the slot ulSequence is set to
+one beyond the position of the call, which tells the worker the call is ready
+to execute.  Sequence numbers and positions are compared by their signed
+difference, so both can wrap. */
+typedef struct xDEFERRED_CALL
+{
+	unsigned long			ulSequence;			/*<< Sequence number, as described above. */
+	dcDEFERRED_FUNCTION		xFunctionToPend;	/*<< The function to call. */
+	void					*pvParameter1;		/*<< The first parameter to pass to the function. */
+	unsigned long			ulParameter2;		/*<< The second parameter to pass to the function. */
+	unsigned long			ulPendTime;			/*<< configDEFERRED_CALL_TIMESTAMP() when the call was pended. */
+} dcCALL;
+
+/* The ring and worker task of a tier. */
+typedef struct xDEFERRED_CALL_TIER
+{
+	volatile dcCALL				xCalls[ configDEFERRED_CALL_QUEUE_LENGTH ];	/*<< The slots of the ring. */
+	volatile unsigned long		ulHead;			/*<< The position of the next slot to reserve.  Advanced by producers using dcCOMPARE_AND_SWAP(). */
+	volatile unsigned long		ulTail;			/*<< The position of the next call to execute.  Only written by the worker. */
+	volatile portBASE_TYPE		xWorkerIdle;	/*<< Set by the worker before it waits for a notification, cleared by the producer that notifies it. */
+	xTaskHandle					xWorker;		/*<< The worker task of the tier. */
+	xDeferredCallStats			xStats;			/*<< Only accessed from within critical sections. */
+} dcTIER;
+
+PRIVILEGED_DATA static dcTIER xTiers[ configDEFERRED_CALL_TIERS ];
+
+/*
+ * The worker task of each tier.  pvParameters points to the tier.
+ */
+static void prvDeferredCallWorker( void *pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Executes the call at the tail of the ring of pxTier, if it is ready to
+ * execute, and updates the statistics of the tier.  Returns pdFALSE if there
+ * was no call ready to execute.
+ */
+static portBASE_TYPE prvExecuteNextCall( dcTIER *pxTier ) PRIVILEGED_FUNCTION;
+
+#ifndef portCOMPARE_AND_SWAP
+	/*
+	 * Sets *pulTarget to ulNew if it holds ulExpected, with interrupts up to
+	 * configMAX_SYSCALL_INTERRUPT_PRIORITY masked.  Returns pdTRUE if
+	 * *pulTarget was set.
+	 */
+	static portBASE_TYPE prvCompareAndSwap( volatile unsigned long *pulTarget, unsigned long ulExpected, unsigned long ulNew ) PRIVILEGED_FUNCTION;
+#endif
+
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xDeferredCallCreateWorkers( void )
+{
+portBASE_TYPE xReturn = pdPASS;
+unsigned portBASE_TYPE uxTier;
+unsigned long ulSlot;
+signed char cWorkerName[] = "DCW0";
+
+	/* Every tier must run above the idle priority. */
+	configASSERT( ( unsigned portBASE_TYPE ) configDEFERRED_CALL_TOP_PRIORITY < ( unsigned portBASE_TYPE ) configMAX_PRIORITIES );
+	configASSERT( ( unsigned portBASE_TYPE ) configDEFERRED_CALL_TOP_PRIORITY >= ( unsigned portBASE_TYPE ) configDEFERRED_CALL_TIERS );
+
+	for( uxTier = 0; ( uxTier < ( unsigned portBASE_TYPE ) configDEFERRED_CALL_TIERS ) && ( xReturn == pdPASS ); uxTier++ )
+	{
+		/* Each slot can first be reserved at its own position. */
+		for( ulSlot = 0UL; ulSlot < ( unsigned long ) configDEFERRED_CALL_QUEUE_LENGTH; ulSlot++ )
+		{
+			xTiers[ uxTier ].xCalls[ ulSlot ].ulSequence = ulSlot;
+		}
+
+		/* The workers are named DCW0, DCW1 and so on, so the tier of each can
+		be seen in the run time stats. */
+		cWorkerName[ 3 ] = ( signed char ) ( '0' + uxTier );
+		xReturn = xTaskCreate( prvDeferredCallWorker, cWorkerName, configDEFERRED_CALL_STACK_DEPTH, ( void * ) &( xTiers[ uxTier ] ), ( ( unsigned portBASE_TYPE ) configDEFERRED_CALL_TOP_PRIORITY - uxTier ) | portPRIVILEGE_BIT, &( xTiers[ uxTier ].xWorker ) );
+	}
+
+	configASSERT( xReturn );
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xDeferredCallGenericPend( unsigned portBASE_TYPE uxTier, dcDEFERRED_FUNCTION xFunctionToPend, void *pvParameter1, unsigned long ulParameter2, signed portBASE_TYPE *pxHigherPriorityTaskWoken, portBASE_TYPE xFromISR )
+{
+dcTIER *pxTier;
+volatile dcCALL *pxCall;
+unsigned long ulPosition, ulPendTime;
+long lDifference;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+portBASE_TYPE xReturn, xNotifyWorker = pdFALSE;
+
+	configASSERT( uxTier < ( unsigned portBASE_TYPE ) configDEFERRED_CALL_TIERS );
+	configASSERT( xFunctionToPend );
+
+	pxTier = &( xTiers[ uxTier ] );
+
+	/* The rings are initialised when the workers are created, by
+	vTaskStartScheduler(). */
+	configASSERT( pxTier->xWorker );
+
+	ulPendTime = configDEFERRED_CALL_TIMESTAMP();
+
+	/* A task must not be preempted between reserving a slot and writing the
+	call into it, as the worker cannot execute the calls pended after it until
+	it has done so.  Interrupts run to completion, so do not need to mask each
+	other. */
+	if( xFromISR == pdFALSE )
+	{
+		taskENTER_CRITICAL();
+	}
+
+	for( ;; )
+	{
+		ulPosition = pxTier->ulHead;
+		pxCall = &( pxTier->xCalls[ ulPosition & dcINDEX_MASK ] );
+		lDifference = ( long ) ( pxCall->ulSequence - ulPosition );
+
+		if( lDifference == 0L )
+		{
+			/* The slot is free.  Reserve it, unless an interrupt that
+			preempted this one has reserved it first. */
+			if( dcCOMPARE_AND_SWAP( &( pxTier->ulHead ), ulPosition, ulPosition + 1UL ) )
+			{
+				break;
+			}
+		}
+		else if( lDifference < 0L )
+		{
+			/* The slot still holds a call from the previous lap of the ring,
+			so the ring is full. */
+			pxCall = NULL;
+			break;
+		}
+		else
+		{
+			/* The slot was reserved by an interrupt that preempted this one
+			after ulHead was read.  Try again at the new head. */
+		}
+	}
+
+	if( pxCall != NULL )
+	{
+		pxCall->xFunctionToPend = xFunctionToPend;
+		pxCall->pvParameter1 = pvParameter1;
+		pxCall->ulParameter2 = ulParameter2;
+		pxCall->ulPendTime = ulPendTime;
+
+		/* Publishing the call to the worker must be the last write. */
+		pxCall->ulSequence = ulPosition + 1UL;
+
+		/* The worker sets xWorkerIdle before looking at the ring for the last
+		time before it blocks, so if it is not set here the worker will find
+		the call without being notified. */
+		if( pxTier->xWorkerIdle != pdFALSE )
+		{
+			pxTier->xWorkerIdle = pdFALSE;
+			xNotifyWorker = pdTRUE;
+		}
+
+		xReturn = pdPASS;
+	}
+	else
+	{
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			( pxTier->xStats.ulDropped )++;
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		xReturn = pdFAIL;
+	}
+
+	if( xFromISR == pdFALSE )
+	{
+		taskEXIT_CRITICAL();
+
+		if( xNotifyWorker != pdFALSE )
+		{
+			( void ) xTaskNotifyGive( pxTier->xWorker );
+		}
+	}
+	else if( xNotifyWorker != pdFALSE )
+	{
+		vTaskNotifyGiveFromISR( pxTier->xWorker, pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		/* The worker is already running or ready to run. */
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vDeferredCallGetStats( unsigned portBASE_TYPE uxTier, xDeferredCallStats *pxStats, portBASE_TYPE xReset )
+{
+	configASSERT( uxTier < ( unsigned portBASE_TYPE ) configDEFERRED_CALL_TIERS );
+	configASSERT( pxStats );
+
+	taskENTER_CRITICAL();
+	{
+		*pxStats = xTiers[ uxTier ].xStats;
+
+		if( xReset != pdFALSE )
+		{
+			memset( ( void * ) &( xTiers[ uxTier ].xStats ), 0x00, sizeof( xDeferredCallStats ) );
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvDeferredCallWorker( void *pvParameters )
+{
+dcTIER * const pxTier = ( dcTIER * ) pvParameters;
+
+	for( ;; )
+	{
+		if( prvExecuteNextCall( pxTier ) == pdFALSE )
+		{
+			/* The ring is empty.  Ask the next producer for a notification,
+			then look once more in case a call was published before the
+			request was seen. */
+			pxTier->xWorkerIdle = pdTRUE;
+
+			if( prvExecuteNextCall( pxTier ) == pdFALSE )
+			{
+				( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+			}
+
+			/* Any notification that is still pending is only a spurious
+			wake up. */
+			pxTier->xWorkerIdle = pdFALSE;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvExecuteNextCall( dcTIER *pxTier )
+{
+volatile dcCALL *pxCall;
+dcDEFERRED_FUNCTION xFunctionToPend;
+void *pvParameter1;
+unsigned long ulParameter2, ulPosition, ulWaiting, ulPendTime, ulStartTime, ulExecution, ulLatency;
+portBASE_TYPE xReturn = pdFALSE;
+
+	ulPosition = pxTier->ulTail;
+	pxCall = &( pxTier->xCalls[ ulPosition & dcINDEX_MASK ] );
+
+	if( pxCall->ulSequence == ( ulPosition + 1UL ) )
+	{
+		ulWaiting = pxTier->ulHead - ulPosition;
+		xFunctionToPend = pxCall->xFunctionToPend;
+		pvParameter1 = pxCall->pvParameter1;
+		ulParameter2 = pxCall->ulParameter2;
+		ulPendTime = pxCall->ulPendTime;
+
+		/* Free the slot for the next lap of the ring before the function is
+		called, so the function can pend calls to its own tier. */
+		pxCall->ulSequence = ulPosition + ( unsigned long ) configDEFERRED_CALL_QUEUE_LENGTH;
+		pxTier->ulTail = ulPosition + 1UL;
+
+		ulStartTime = configDEFERRED_CALL_TIMESTAMP();
+		xFunctionToPend( pvParameter1, ulParameter2 );
+		ulExecution = configDEFERRED_CALL_TIMESTAMP() - ulStartTime;
+		ulLatency = ulStartTime - ulPendTime;
+
+		taskENTER_CRITICAL();
+		{
+			( pxTier->xStats.ulCalls )++;
+			pxTier->xStats.ulTotalLatency += ulLatency;
+			pxTier->xStats.ulTotalExecution += ulExecution;
+
+			if( ulLatency > pxTier->xStats.ulMaxLatency )
+			{
+				pxTier->xStats.ulMaxLatency = ulLatency;
+			}
+
+			if( ulExecution > pxTier->xStats.ulMaxExecution )
+			{
+				pxTier->xStats.ulMaxExecution = ulExecution;
+			}
+
+			if( ulWaiting > pxTier->xStats.ulMaxWaiting )
+			{
+				pxTier->xStats.ulMaxWaiting = ulWaiting;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		xReturn = pdTRUE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#ifndef portCOMPARE_AND_SWAP
+
+	static portBASE_TYPE prvCompareAndSwap( volatile unsigned long *pulTarget, unsigned long ulExpected, unsigned long ulNew )
+	{
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+	portBASE_TYPE xReturn = pdFALSE;
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( *pulTarget == ulExpected )
+			{
+				*pulTarget = ulNew;
+				xReturn = pdTRUE;
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif /* portCOMPARE_AND_SWAP */
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include deferred call functionality.  If you want to include deferred call
+functionality then ensure configUSE_DEFERRED_CALLS is set to 1 in
+FreeRTOSConfig.h. */
+#endif /* configUSE_DEFERRED_CALLS == 1 */
+
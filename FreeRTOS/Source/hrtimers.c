@@ -0,0 +1,508 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "hrtimers.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+
+/* This entire source file will be skipped if the application is not configured
+to include high resolution timer functionality.  This #if is closed at the very
+bottom of this file.  If you want to include high resolution timer
+functionality then ensure configUSE_HR_TIMERS is set to 1 in
+FreeRTOSConfig.h. */
+#if ( configUSE_HR_TIMERS == 1 )
+
+#ifndef portHRTIMER_COUNTS_PER_US
+	#error The port does not provide the high resolution timer hardware used when configUSE_HR_TIMERS is 1.
+#endif
+
+/* Deferred callbacks are pended to the RTOS daemon task. */
+#if ( configUSE_TIMERS == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 )
+	#define hrtDEFERRED_CALLBACKS	1
+#else
+	#define hrtDEFERRED_CALLBACKS	0
+#endif
+
+/* The counter is 32 bits wide whatever the width of an unsigned long.  Times
+are compared by the number of counts between them, so an expiry time is due
+when it is no more than half the counter range before the current count. */
+#define hrtCOUNT_MASK					( 0xffffffffUL )
+#define hrtHALF_RANGE					( 0x80000000UL )
+#define hrtDIFF( ulTo, ulFrom )			( ( ( ulTo ) - ( ulFrom ) ) & hrtCOUNT_MASK )
+#define hrtIS_DUE( ulExpiry, ulNow )	( hrtDIFF( ( ulNow ), ( ulExpiry ) ) < hrtHALF_RANGE )
+
+/* The key by which the compare queue is sorted.  Expiry times that are already
+due sort before those that are not, in the order in which they became due. */
+#define hrtSORT_KEY( ulExpiry, ulNow )	hrtDIFF( ( ulExpiry ) + hrtHALF_RANGE, ( ulNow ) )
+
+/* Bits within the ucFlags member of a timer. */
+#define hrtFLAG_ACTIVE					( ( unsigned char ) 0x01 )
+#define hrtFLAG_DEFERRED				( ( unsigned char ) 0x02 )
+#define hrtFLAG_PENDING					( ( unsigned char ) 0x04 )
+
+/* The definition of the high resolution timers themselves. */
+typedef struct tmrHRTimerControl
+{
+	const signed char			*pcTimerName;		/*<< Text name.  This is not used by the kernel, it is included simply to make debugging easier. */
+	struct tmrHRTimerControl	*pxNext;			/*<< The timer that expires next after this one, if this timer is active. */
+	unsigned long				ulExpiry;			/*<< The count at which the timer next expires. */
+	unsigned long				ulPeriod;			/*<< The period of the timer in counts, or 0 if the timer is a one-shot timer. */
+	void 						*pvTimerID;			/*<< An ID to identify the timer.  This allows the timer to be identified when the same callback is used for multiple timers. */
+	hrtTIMER_CALLBACK			pxCallbackFunction;	/*<< The function that will be called when the timer expires. */
+	volatile unsigned long		ulOverruns;			/*<< The number of expiries for which the callback was not executed. */
+	volatile unsigned char		ucFlags;			/*<< hrtFLAG_ bits. */
+} xHRTIMER;
+
+/* The active timers, in the order in which they expire.  The compare channel
+is always programmed with the expiry time of the timer at the head of the
+queue.  Only accessed with interrupts up to configMAX_SYSCALL_INTERRUPT_PRIORITY
+masked. */
+PRIVILEGED_DATA static xHRTIMER *pxCompareQueue = NULL;
+
+/* Set when the port has set up the counter and compare hardware. */
+PRIVILEGED_DATA static portBASE_TYPE xHardwareInitialised = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Insert a timer into the compare queue in the position determined by its
+ * expiry time.  Timers that expire at the same time expire in the order in
+ * which they were inserted.
+ */
+static void prvInsertTimerInCompareQueue( xHRTIMER * const pxTimer, const unsigned long ulNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove an active timer from the compare queue.
+ */
+static void prvRemoveTimerFromCompareQueue( xHRTIMER * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Program the compare channel with the expiry time of the timer at the head of
+ * the compare queue, or disable it if no timers are active.
+ */
+static void prvProgramCompare( void ) PRIVILEGED_FUNCTION;
+
+#if ( hrtDEFERRED_CALLBACKS == 1 )
+
+	/*
+	 * Executed by the RTOS daemon task to call the callback function of a timer
+	 * that was created with xDeferCallback set to pdTRUE.
+	 */
+	static void prvExecuteDeferredCallback( void *pvParameter1, unsigned long ulParameter2 ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+xHRTimerHandle xHRTimerCreate( const signed char * const pcTimerName, hrtTIMER_CALLBACK pxCallbackFunction, void *pvTimerID, portBASE_TYPE xDeferCallback )
+{
+xHRTIMER *pxNewTimer = NULL;
+
+	/* Deferred callbacks require the RTOS daemon task. */
+	configASSERT( ( xDeferCallback == pdFALSE ) || ( hrtDEFERRED_CALLBACKS == 1 ) );
+
+	if( ( xDeferCallback == pdFALSE ) || ( hrtDEFERRED_CALLBACKS == 1 ) )
+	{
+		pxNewTimer = ( xHRTIMER * ) pvPortMalloc( sizeof( xHRTIMER ) );
+	}
+
+	if( pxNewTimer != NULL )
+	{
+		pxNewTimer->pcTimerName = pcTimerName;
+		pxNewTimer->pxNext = NULL;
+		pxNewTimer->ulExpiry = 0UL;
+		pxNewTimer->ulPeriod = 0UL;
+		pxNewTimer->pvTimerID = pvTimerID;
+		pxNewTimer->pxCallbackFunction = pxCallbackFunction;
+		pxNewTimer->ulOverruns = 0UL;
+		pxNewTimer->ucFlags = ( xDeferCallback != pdFALSE ) ? hrtFLAG_DEFERRED : ( unsigned char ) 0;
+
+		taskENTER_CRITICAL();
+		{
+			if( xHardwareInitialised == pdFALSE )
+			{
+				vPortHRTimerSetup();
+				xHardwareInitialised = pdTRUE;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	return ( xHRTimerHandle ) pxNewTimer;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xHRTimerGenericCommand( xHRTimerHandle xTimer, portBASE_TYPE xCommandID, unsigned long ulDelay, unsigned long ulPeriod, portBASE_TYPE xFromISR )
+{
+xHRTIMER * const pxTimer = ( xHRTIMER * ) xTimer;
+xHRTIMER *pxPreviousHead;
+unsigned long ulNow, ulLastExpiry;
+unsigned portBASE_TYPE uxSavedInterruptStatus = 0;
+portBASE_TYPE xWasPeriodic, xReturn = pdFAIL;
+
+	configASSERT( pxTimer );
+
+	/* Times are compared across half the counter range, so a timer cannot be
+	set further into the future than that. */
+	if( ( ulDelay < hrtHALF_RANGE ) && ( ulPeriod < hrtHALF_RANGE ) && ( ( xCommandID != hrtCOMMAND_CHANGE_PERIOD ) || ( ulPeriod != 0UL ) ) )
+	{
+		if( xFromISR != pdFALSE )
+		{
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		}
+		else
+		{
+			taskENTER_CRITICAL();
+		}
+		{
+			/* The count is read with interrupts masked so the time is not
+			stale by the time the timer is inserted. */
+			ulNow = ulPortHRTimerGetCount();
+			pxPreviousHead = pxCompareQueue;
+			xWasPeriodic = pdFALSE;
+
+			if( ( pxTimer->ucFlags & hrtFLAG_ACTIVE ) != 0 )
+			{
+				xWasPeriodic = ( pxTimer->ulPeriod != 0UL ) ? pdTRUE : pdFALSE;
+				prvRemoveTimerFromCompareQueue( pxTimer );
+			}
+
+			switch( xCommandID )
+			{
+				case hrtCOMMAND_START :
+					pxTimer->ulExpiry = ( ulNow + ulDelay ) & hrtCOUNT_MASK;
+					pxTimer->ulPeriod = ulPeriod;
+					prvInsertTimerInCompareQueue( pxTimer, ulNow );
+					break;
+
+				case hrtCOMMAND_CHANGE_PERIOD :
+					if( xWasPeriodic != pdFALSE )
+					{
+						/* Keep the phase by measuring the new period from the
+						last expiry.  The last expiry was less than one old
+						period ago, so the new expiry time is within half the
+						counter range of now. */
+						ulLastExpiry = hrtDIFF( pxTimer->ulExpiry, pxTimer->ulPeriod );
+						pxTimer->ulExpiry = ( ulLastExpiry + ulPeriod ) & hrtCOUNT_MASK;
+					}
+					else
+					{
+						pxTimer->ulExpiry = ( ulNow + ulPeriod ) & hrtCOUNT_MASK;
+					}
+					pxTimer->ulPeriod = ulPeriod;
+					prvInsertTimerInCompareQueue( pxTimer, ulNow );
+					break;
+
+				case hrtCOMMAND_STOP :
+				default :
+					/* The timer has already been removed from the queue. */
+					break;
+			}
+
+			/* The compare channel only needs reprogramming if the timer at
+			the head of the queue, or its expiry time, changed. */
+			if( ( pxCompareQueue != pxPreviousHead ) || ( pxCompareQueue == pxTimer ) )
+			{
+				prvProgramCompare();
+			}
+
+			xReturn = pdPASS;
+		}
+		if( xFromISR != pdFALSE )
+		{
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			taskEXIT_CRITICAL();
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xHRTimerProcessCompare( void )
+{
+xHRTIMER *pxTimer;
+unsigned long ulNow, ulMissed;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+portBASE_TYPE xSwitchRequired = pdFALSE;
+#if ( hrtDEFERRED_CALLBACKS == 1 )
+	signed portBASE_TYPE xHigherPriorityTaskWoken;
+#endif
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		for( ;; )
+		{
+			/* The count is read again on each pass as the callbacks take time
+			to execute. */
+			ulNow = ulPortHRTimerGetCount();
+			pxTimer = pxCompareQueue;
+
+			if( ( pxTimer == NULL ) || !hrtIS_DUE( pxTimer->ulExpiry, ulNow ) )
+			{
+				break;
+			}
+
+			pxCompareQueue = pxTimer->pxNext;
+
+			if( pxTimer->ulPeriod != 0UL )
+			{
+				/* Reload the timer before its callback executes, so the
+				callback can stop it or change its period.  The next expiry
+				time is measured from this expiry time, not from now, so the
+				timer does not drift.  If that time has already passed then
+				whole periods were missed, and they are skipped rather than
+				executed back to back. */
+				pxTimer->ulExpiry = ( pxTimer->ulExpiry + pxTimer->ulPeriod ) & hrtCOUNT_MASK;
+
+				if( hrtIS_DUE( pxTimer->ulExpiry, ulNow ) )
+				{
+					ulMissed = ( hrtDIFF( ulNow, pxTimer->ulExpiry ) / pxTimer->ulPeriod ) + 1UL;
+					pxTimer->ulExpiry = ( pxTimer->ulExpiry + ( ulMissed * pxTimer->ulPeriod ) ) & hrtCOUNT_MASK;
+					pxTimer->ulOverruns += ulMissed;
+				}
+
+				prvInsertTimerInCompareQueue( pxTimer, ulNow );
+			}
+			else
+			{
+				pxTimer->ucFlags &= ( unsigned char ) ~hrtFLAG_ACTIVE;
+			}
+
+			#if ( hrtDEFERRED_CALLBACKS == 1 )
+			if( ( pxTimer->ucFlags & hrtFLAG_DEFERRED ) != 0 )
+			{
+				/* Only one call to the callback is pended at a time, so a
+				slow callback cannot fill the timer queue. */
+				if( ( pxTimer->ucFlags & hrtFLAG_PENDING ) != 0 )
+				{
+					( pxTimer->ulOverruns )++;
+				}
+				else
+				{
+					xHigherPriorityTaskWoken = pdFALSE;
+
+					if( xTimerPendFunctionCallFromISR( prvExecuteDeferredCallback, ( void * ) pxTimer, 0UL, &xHigherPriorityTaskWoken ) != pdFALSE )
+					{
+						pxTimer->ucFlags |= hrtFLAG_PENDING;
+
+						if( xHigherPriorityTaskWoken != pdFALSE )
+						{
+							xSwitchRequired = pdTRUE;
+						}
+					}
+					else
+					{
+						( pxTimer->ulOverruns )++;
+					}
+				}
+			}
+			else
+			#endif /* hrtDEFERRED_CALLBACKS */
+			{
+				/* The queue is consistent, so interrupts are unmasked while the
+				callback executes.  It can then use the interrupt safe API,
+				including the high resolution timer functions, and does not
+				hold off higher priority interrupts. */
+				portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+				{
+					pxTimer->pxCallbackFunction( ( xHRTimerHandle ) pxTimer );
+				}
+				uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			}
+		}
+
+		prvProgramCompare();
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertTimerInCompareQueue( xHRTIMER * const pxTimer, const unsigned long ulNow )
+{
+xHRTIMER **ppxNext;
+const unsigned long ulKey = hrtSORT_KEY( pxTimer->ulExpiry, ulNow );
+
+	for( ppxNext = &pxCompareQueue; *ppxNext != NULL; ppxNext = &( ( *ppxNext )->pxNext ) )
+	{
+		if( hrtSORT_KEY( ( *ppxNext )->ulExpiry, ulNow ) > ulKey )
+		{
+			break;
+		}
+	}
+
+	pxTimer->pxNext = *ppxNext;
+	*ppxNext = pxTimer;
+	pxTimer->ucFlags |= hrtFLAG_ACTIVE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveTimerFromCompareQueue( xHRTIMER * const pxTimer )
+{
+xHRTIMER **ppxNext;
+
+	for( ppxNext = &pxCompareQueue; *ppxNext != NULL; ppxNext = &( ( *ppxNext )->pxNext ) )
+	{
+		if( *ppxNext == pxTimer )
+		{
+			*ppxNext = pxTimer->pxNext;
+			break;
+		}
+	}
+
+	pxTimer->pxNext = NULL;
+	pxTimer->ucFlags &= ( unsigned char ) ~hrtFLAG_ACTIVE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProgramCompare( void )
+{
+	if( pxCompareQueue != NULL )
+	{
+		/* The port raises the interrupt straight away if the count has
+		already passed the compare value. */
+		vPortHRTimerSetCompare( pxCompareQueue->ulExpiry );
+	}
+	else
+	{
+		vPortHRTimerClearCompare();
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if ( hrtDEFERRED_CALLBACKS == 1 )
+
+	static void prvExecuteDeferredCallback( void *pvParameter1, unsigned long ulParameter2 )
+	{
+	xHRTIMER * const pxTimer = ( xHRTIMER * ) pvParameter1;
+
+		( void ) ulParameter2;
+
+		/* Cleared before the callback executes, so an expiry that occurs
+		while it is executing pends it again rather than being lost. */
+		taskENTER_CRITICAL();
+		{
+			pxTimer->ucFlags &= ( unsigned char ) ~hrtFLAG_PENDING;
+		}
+		taskEXIT_CRITICAL();
+
+		pxTimer->pxCallbackFunction( ( xHRTimerHandle ) pxTimer );
+	}
+
+#endif /* hrtDEFERRED_CALLBACKS */
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xHRTimerIsTimerActive( xHRTimerHandle xTimer )
+{
+xHRTIMER * const pxTimer = ( xHRTIMER * ) xTimer;
+
+	return ( ( pxTimer->ucFlags & hrtFLAG_ACTIVE ) != 0 ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void *pvHRTimerGetTimerID( xHRTimerHandle xTimer )
+{
+xHRTIMER * const pxTimer = ( xHRTIMER * ) xTimer;
+
+	return pxTimer->pvTimerID;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulHRTimerGetOverruns( xHRTimerHandle xTimer )
+{
+xHRTIMER * const pxTimer = ( xHRTIMER * ) xTimer;
+
+	return pxTimer->ulOverruns;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulHRTimerGetCount( void )
+{
+	return ulPortHRTimerGetCount() & hrtCOUNT_MASK;
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include high resolution timer functionality.  If you want to include high
+resolution timer functionality then ensure configUSE_HR_TIMERS is set to 1 in
+FreeRTOSConfig.h. */
+#endif /* configUSE_HR_TIMERS == 1 */
+
@@ -153,6 +153,14 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define INCLUDE_xTimerGetTimerDaemonTaskHandle 0
 #endif
 
+#ifndef INCLUDE_xTimerPendFunctionCall
+	#define INCLUDE_xTimerPendFunctionCall 0
+#endif
+
+#ifndef INCLUDE_xTimerGetTimerByName
+	#define INCLUDE_xTimerGetTimerByName 0
+#endif
+
 #ifndef INCLUDE_xQueueGetMutexHolder
 	#define INCLUDE_xQueueGetMutexHolder 0
 #endif
@@ -241,6 +249,11 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 
 #endif /* configUSE_TIMERS */
 
+/* Pended function calls are executed by the timer service (daemon) task. */
+#if ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 0 )
+	#error If INCLUDE_xTimerPendFunctionCall is set to 1 then configUSE_TIMERS must also be set to 1.
+#endif
+
 #ifndef INCLUDE_xTaskGetSchedulerState
 	#define INCLUDE_xTaskGetSchedulerState 0
 #endif
@@ -266,6 +279,12 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define portSETUP_TCB( pxTCB ) ( void ) pxTCB
 #endif
 
+#ifndef portREADY_PRIORITY_BITS
+	/* A port that provides optimised task selection without saying how many
+	priorities its bitmap holds records every priority in a single bitmap. */
+	#define portREADY_PRIORITY_BITS configMAX_PRIORITIES
+#endif
+
 #ifndef configQUEUE_REGISTRY_SIZE
 	#define configQUEUE_REGISTRY_SIZE 0U
 #endif
@@ -357,6 +376,14 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define configCHECK_FOR_STACK_OVERFLOW 0
 #endif
 
+/* With configCHECK_FOR_STACK_OVERFLOW set to 3 or 4 the idle task checks every
+guard word of every task once each configSTACK_GUARD_SCAN_PERIOD ticks.  The
+scan holds the scheduler suspended for a time that grows with the number of
+tasks.  Set to 0 to leave the scan out. */
+#ifndef configSTACK_GUARD_SCAN_PERIOD
+	#define configSTACK_GUARD_SCAN_PERIOD 100
+#endif
+
 /* The following event macros are embedded in the kernel API calls. */
 
 #ifndef traceMOVED_TASK_TO_READY_STATE
@@ -471,6 +498,12 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define traceTASK_DELAY()
 #endif
 
+#ifndef traceTASK_DEADLINE_MISSED
+	/* Called when a job of a task scheduled earliest deadline first completes
+	after its deadline.  pxTask is the task. */
+	#define traceTASK_DEADLINE_MISSED( pxTask )
+#endif
+
 #ifndef traceTASK_PRIORITY_SET
 	#define traceTASK_PRIORITY_SET( pxTask, uxNewPriority )
 #endif
@@ -511,6 +544,134 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define traceTIMER_COMMAND_RECEIVED( pxTimer, xMessageID, xMessageValue )
 #endif
 
+#ifndef traceTASK_NOTIFY
+	#define traceTASK_NOTIFY()
+#endif
+
+#ifndef traceTASK_NOTIFY_FROM_ISR
+	#define traceTASK_NOTIFY_FROM_ISR()
+#endif
+
+#ifndef traceTASK_NOTIFY_GIVE_FROM_ISR
+	#define traceTASK_NOTIFY_GIVE_FROM_ISR()
+#endif
+
+#ifndef traceTASK_NOTIFY_TAKE_BLOCK
+	#define traceTASK_NOTIFY_TAKE_BLOCK()
+#endif
+
+#ifndef traceTASK_NOTIFY_TAKE
+	#define traceTASK_NOTIFY_TAKE()
+#endif
+
+#ifndef traceTASK_NOTIFY_WAIT_BLOCK
+	#define traceTASK_NOTIFY_WAIT_BLOCK()
+#endif
+
+#ifndef traceTASK_NOTIFY_WAIT
+	#define traceTASK_NOTIFY_WAIT()
+#endif
+
+#ifndef traceSTREAM_BUFFER_CREATE
+	#define traceSTREAM_BUFFER_CREATE( pxStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_CREATE_FAILED
+	#define traceSTREAM_BUFFER_CREATE_FAILED()
+#endif
+
+#ifndef traceSTREAM_BUFFER_DELETE
+	#define traceSTREAM_BUFFER_DELETE( pxStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RESET
+	#define traceSTREAM_BUFFER_RESET( pxStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND
+	#define traceSTREAM_BUFFER_SEND( pxStreamBuffer, xBytesSent )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND_FAILED
+	#define traceSTREAM_BUFFER_SEND_FAILED( pxStreamBuffer )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_SEND
+	#define traceBLOCKING_ON_STREAM_BUFFER_SEND( pxStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND_FROM_ISR
+	#define traceSTREAM_BUFFER_SEND_FROM_ISR( pxStreamBuffer, xBytesSent )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE
+	#define traceSTREAM_BUFFER_RECEIVE( pxStreamBuffer, xReceivedLength )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE_FAILED
+	#define traceSTREAM_BUFFER_RECEIVE_FAILED( pxStreamBuffer )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_RECEIVE
+	#define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( pxStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE_FROM_ISR
+	#define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( pxStreamBuffer, xReceivedLength )
+#endif
+
+#ifndef traceEVENT_GROUP_CREATE
+	#define traceEVENT_GROUP_CREATE( xEventGroup )
+#endif
+
+#ifndef traceEVENT_GROUP_CREATE_FAILED
+	#define traceEVENT_GROUP_CREATE_FAILED()
+#endif
+
+#ifndef traceEVENT_GROUP_SYNC_BLOCK
+	#define traceEVENT_GROUP_SYNC_BLOCK( xEventGroup, uxBitsToSet, uxBitsToWaitFor )
+#endif
+
+#ifndef traceEVENT_GROUP_SYNC_END
+	#define traceEVENT_GROUP_SYNC_END( xEventGroup, uxBitsToSet, uxBitsToWaitFor, xTimeoutOccurred ) ( void ) xTimeoutOccurred
+#endif
+
+#ifndef traceEVENT_GROUP_WAIT_BITS_BLOCK
+	#define traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor )
+#endif
+
+#ifndef traceEVENT_GROUP_WAIT_BITS_END
+	#define traceEVENT_GROUP_WAIT_BITS_END( xEventGroup, uxBitsToWaitFor, xTimeoutOccurred ) ( void ) xTimeoutOccurred
+#endif
+
+#ifndef traceEVENT_GROUP_CLEAR_BITS
+	#define traceEVENT_GROUP_CLEAR_BITS( xEventGroup, uxBitsToClear )
+#endif
+
+#ifndef traceEVENT_GROUP_CLEAR_BITS_FROM_ISR
+	#define traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear )
+#endif
+
+#ifndef traceEVENT_GROUP_SET_BITS
+	#define traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet )
+#endif
+
+#ifndef traceEVENT_GROUP_SET_BITS_FROM_ISR
+	#define traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet )
+#endif
+
+#ifndef traceEVENT_GROUP_DELETE
+	#define traceEVENT_GROUP_DELETE( xEventGroup )
+#endif
+
+#ifndef tracePEND_FUNC_CALL
+	#define tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, ret )
+#endif
+
+#ifndef tracePEND_FUNC_CALL_FROM_ISR
+	#define tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, ret )
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
 	#define configGENERATE_RUN_TIME_STATS 0
 #endif
@@ -533,6 +694,22 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #endif
 
+/* The type in which the run time of each task, and the total run time, are
+accumulated.  The run time counter itself need only be as wide as an unsigned
+long, as the time between two reads of it is accumulated.  Set to unsigned long
+long to stop the accumulated times wrapping. */
+#ifndef configRUN_TIME_COUNTER_TYPE
+	#define configRUN_TIME_COUNTER_TYPE unsigned long
+#endif
+
+#ifndef configUSE_CPU_LOAD
+	#define configUSE_CPU_LOAD 0
+#endif
+
+#if ( ( configUSE_CPU_LOAD == 1 ) && ( configGENERATE_RUN_TIME_STATS == 0 ) )
+	#error configGENERATE_RUN_TIME_STATS must be set to 1 in FreeRTOSConfig.h to use configUSE_CPU_LOAD.
+#endif
+
 #ifndef configUSE_MALLOC_FAILED_HOOK
 	#define configUSE_MALLOC_FAILED_HOOK 0
 #endif
@@ -581,10 +758,22 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define configUSE_QUEUE_SETS 0
 #endif
 
+#ifndef configUSE_ZERO_COPY_QUEUES
+	#define configUSE_ZERO_COPY_QUEUES 0
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
 	#define portTASK_USES_FLOATING_POINT()
 #endif
 
+/* portMEMORY_BARRIER() stops the compiler, and the processor, from moving
+memory accesses across it.  stream_buffer.c uses it to make the bytes written
+to the ring visible before the index that publishes them.  Ports whose
+compiler or processor may reorder those accesses must define it. */
+#ifndef portMEMORY_BARRIER
+	#define portMEMORY_BARRIER()
+#endif
+
 #ifndef configUSE_TIME_SLICING
 	#define configUSE_TIME_SLICING 1
 #endif
@@ -601,10 +790,214 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define configUSE_STATS_FORMATTING_FUNCTIONS 0
 #endif
 
+/* Set configUSE_STATS_STREAM to 1 to include xTaskGetStatsStream(), which
+writes the state of each task as compact binary frames for a host to format,
+rather than as text.  Each stream remembers the run time of up to
+configSTATS_STREAM_TASKS tasks, so it can report the run time used since the
+previous report. */
+#ifndef configUSE_STATS_STREAM
+	#define configUSE_STATS_STREAM 0
+#endif
+
+#ifndef configSTATS_STREAM_TASKS
+	#define configSTATS_STREAM_TASKS 16
+#endif
+
+#if ( ( configUSE_STATS_STREAM == 1 ) && ( configUSE_TRACE_FACILITY != 1 ) )
+	#error configUSE_TRACE_FACILITY must be set to 1 in FreeRTOSConfig.h to use configUSE_STATS_STREAM.
+#endif
+
 #ifndef portASSERT_IF_INTERRUPT_PRIORITY_INVALID
 	#define portASSERT_IF_INTERRUPT_PRIORITY_INVALID()
 #endif
 
+#ifndef configUSE_TIMING_WHEEL
+	#define configUSE_TIMING_WHEEL 0
+#endif
+
+#ifndef configTIMING_WHEEL_SIZE
+	#define configTIMING_WHEEL_SIZE 32
+#endif
+
+/* Set configUSE_TIMER_WHEEL to 1 to hold active software timers in a two
+level timing wheel of configTIMER_WHEEL_SIZE slots per level, rather than in a
+sorted list, so starting, stopping and reloading a timer takes the same time
+however many timers are active. */
+#ifndef configUSE_TIMER_WHEEL
+	#define configUSE_TIMER_WHEEL 0
+#endif
+
+#ifndef configTIMER_WHEEL_SIZE
+	#define configTIMER_WHEEL_SIZE 32
+#endif
+
+/* Set configUSE_TIMER_DIRECT_COMMANDS to 1 to have xTimerStart(),
+xTimerReset(), xTimerStop(), xTimerChangePeriod() and their FromISR versions
+update the timer wheel directly, within a critical section, rather than send a
+command to the timer service task.  Requires configUSE_TIMER_WHEEL to be 1. */
+#ifndef configUSE_TIMER_DIRECT_COMMANDS
+	#define configUSE_TIMER_DIRECT_COMMANDS 0
+#endif
+
+/* Set configUSE_HR_TIMERS to 1 to include the high resolution timers of
+hrtimers.c, which are driven by a hardware counter and compare channel provided
+by the port rather than by the tick. */
+#ifndef configUSE_HR_TIMERS
+	#define configUSE_HR_TIMERS 0
+#endif
+
+/* Set configUSE_TIMER_HISTOGRAMS to 1 to have the timer service task record,
+for each software timer, how late the callback executes relative to the tick at
+which the timer expired, and how long the callback takes to execute, in
+histograms of configTIMER_HISTOGRAM_BUCKETS buckets whose bounds are powers of
+2.  Times are measured with configTIMER_HISTOGRAM_TIMESTAMP(), a free running
+count that advances by configTIMER_HISTOGRAM_COUNTS_PER_TICK each tick.  Unless
+both are defined the tick count is used, so times are in whole ticks. */
+#ifndef configUSE_TIMER_HISTOGRAMS
+	#define configUSE_TIMER_HISTOGRAMS 0
+#endif
+
+#ifndef configTIMER_HISTOGRAM_BUCKETS
+	#define configTIMER_HISTOGRAM_BUCKETS 16
+#endif
+
+#ifndef configTIMER_HISTOGRAM_TIMESTAMP
+	#ifdef configTIMER_HISTOGRAM_COUNTS_PER_TICK
+		#error configTIMER_HISTOGRAM_COUNTS_PER_TICK must only be defined together with configTIMER_HISTOGRAM_TIMESTAMP().
+	#endif
+	#define configTIMER_HISTOGRAM_TIMESTAMP() ( ( unsigned long ) xTaskGetTickCountFromISR() )
+	#define configTIMER_HISTOGRAM_COUNTS_PER_TICK 1UL
+#endif
+
+#ifndef configTIMER_HISTOGRAM_COUNTS_PER_TICK
+	#error configTIMER_HISTOGRAM_COUNTS_PER_TICK must be defined in FreeRTOSConfig.h when configTIMER_HISTOGRAM_TIMESTAMP() is.
+#endif
+
+/* Set configUSE_DEFERRED_CALLS to 1 to include the deferred calls of
+deferred.c, which let interrupt service routines pend functions to worker
+tasks.  There are configDEFERRED_CALL_TIERS workers, the first running at
+configDEFERRED_CALL_TOP_PRIORITY and each of the others one priority below the
+one before, and each has a ring of configDEFERRED_CALL_QUEUE_LENGTH pended
+calls, which must be a power of 2. */
+#ifndef configUSE_DEFERRED_CALLS
+	#define configUSE_DEFERRED_CALLS 0
+#endif
+
+#ifndef configDEFERRED_CALL_TIERS
+	#define configDEFERRED_CALL_TIERS 2
+#endif
+
+#ifndef configDEFERRED_CALL_TOP_PRIORITY
+	#define configDEFERRED_CALL_TOP_PRIORITY ( configMAX_PRIORITIES - 1 )
+#endif
+
+#ifndef configDEFERRED_CALL_QUEUE_LENGTH
+	#define configDEFERRED_CALL_QUEUE_LENGTH 16
+#endif
+
+#ifndef configDEFERRED_CALL_STACK_DEPTH
+	#define configDEFERRED_CALL_STACK_DEPTH configMINIMAL_STACK_SIZE
+#endif
+
+#ifndef configUSE_TASK_NOTIFICATIONS
+	#define configUSE_TASK_NOTIFICATIONS 1
+#endif
+
+/* Set to 1 to include the API functions that create tasks, queues, semaphores
+and software timers in memory provided by the application.  The idle task, the
+timer service task and the timer queue are then also created without using the
+heap, and the application must provide vApplicationGetIdleTaskMemory() and, if
+configUSE_TIMERS is 1, vApplicationGetTimerTaskMemory(). */
+#ifndef configSUPPORT_STATIC_ALLOCATION
+	#define configSUPPORT_STATIC_ALLOCATION 0
+#endif
+
+/* Set configUSE_EDF_SCHEDULING to 1 to run the tasks at configEDF_PRIORITY
+that have been given a period and deadline by vTaskSetPeriodicDeadline() in
+earliest deadline first order.  Those tasks always run before any other task
+at configEDF_PRIORITY.  Tasks at every other priority are unaffected. */
+#ifndef configUSE_EDF_SCHEDULING
+	#define configUSE_EDF_SCHEDULING 0
+#endif
+
+#ifndef configEDF_PRIORITY
+	#define configEDF_PRIORITY 1
+#endif
+
+#ifndef configUSE_TASK_SNAPSHOT
+	#define configUSE_TASK_SNAPSHOT 0
+#endif
+
+/* The number of tasks uxTaskGetSnapshot() can report.  Tasks created while
+every slot is in use are left out of the snapshot. */
+#ifndef configTASK_SNAPSHOT_SLOTS
+	#define configTASK_SNAPSHOT_SLOTS 16
+#endif
+
+/* The type used to hold the length of each message in a message buffer.  Set
+to unsigned char if no message is longer than 255 bytes to save RAM. */
+#ifndef configMESSAGE_BUFFER_LENGTH_TYPE
+	#define configMESSAGE_BUFFER_LENGTH_TYPE size_t
+#endif
+
+/* Set configUSE_CEILING_MUTEXES to 1 to include xSemaphoreCreateCeilingMutex(),
+which creates a mutex that runs the task holding it at a fixed ceiling priority
+for the whole time the mutex is held, and to record the longest time each mutex
+is held and waited for. */
+#ifndef configUSE_CEILING_MUTEXES
+	#define configUSE_CEILING_MUTEXES 0
+#endif
+
+/* Set configUSE_TASK_POOL to 1 to keep the TCBs and stacks of deleted tasks,
+and reuse them for tasks created later with stacks of the same depth instead of
+allocating from the heap.  The pool holds up to configTASK_POOL_LENGTH tasks for
+each of up to configTASK_POOL_DEPTHS different stack depths.  Tasks created
+with a stack or TCB provided by the application are never pooled.  The pool is
+freed if the heap runs out of memory (see xTaskFlushTaskPool()). */
+#ifndef configUSE_TASK_POOL
+	#define configUSE_TASK_POOL 0
+#endif
+
+#ifndef configTASK_POOL_DEPTHS
+	#define configTASK_POOL_DEPTHS 4
+#endif
+
+#ifndef configTASK_POOL_LENGTH
+	#define configTASK_POOL_LENGTH 4
+#endif
+
+/* The largest number of deleted tasks the idle task reclaims in one critical
+section. */
+#ifndef configIDLE_RECLAIM_BATCH
+	#define configIDLE_RECLAIM_BATCH 8
+#endif
+
+/* Zero copy queues block and unblock their sender and receiver using direct
+to task notifications. */
+#if ( ( configUSE_ZERO_COPY_QUEUES == 1 ) && ( configUSE_TASK_NOTIFICATIONS == 0 ) )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 in FreeRTOSConfig.h to use zero copy queues.
+#endif
+
+#if ( ( configUSE_DEFERRED_CALLS == 1 ) && ( configUSE_TASK_NOTIFICATIONS == 0 ) )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 in FreeRTOSConfig.h to use deferred calls.
+#endif
+
+#if ( ( configUSE_TASK_POOL == 1 ) && ( INCLUDE_vTaskDelete != 1 ) )
+	#error INCLUDE_vTaskDelete must be set to 1 in FreeRTOSConfig.h to use configUSE_TASK_POOL.
+#endif
+
+#if ( ( configUSE_CEILING_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error configUSE_MUTEXES must be set to 1 in FreeRTOSConfig.h to use configUSE_CEILING_MUTEXES.
+#endif
+
+/* Some FreeRTOSConfig.h files cast configMAX_PRIORITIES, so it can only be
+tested when it is used. */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+	#if ( ( configEDF_PRIORITY < 1 ) || ( configEDF_PRIORITY >= configMAX_PRIORITIES ) )
+		#error configEDF_PRIORITY must be above the idle priority and less than configMAX_PRIORITIES.
+	#endif
+#endif
+
 /* For backward compatability. */
 #define eTaskStateGet eTaskGetState
 
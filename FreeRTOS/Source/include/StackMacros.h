@@ -77,6 +77,17 @@
  * to which the bytes were set when the task was created have not been
  * overwritten.  Note this second test does not guarantee that an overflowed
  * stack will always be recognised.
+ *
+ * Setting configCHECK_FOR_STACK_OVERFLOW to 3 or 4 replaces the byte by byte
+ * compare of the second method with a compare of a single sentinel word.  The
+ * sentinel is the guard word nearest the used part of the stack, so it is the
+ * first guard word a growing stack overwrites.  Setting 3 checks the stack
+ * pointer and the sentinel of the task being swapped out.  Setting 4 checks
+ * nothing when a task is swapped out, and instead checks the sentinel of the
+ * running task on each tick.  With either setting the idle task also checks
+ * every guard word of every task once each configSTACK_GUARD_SCAN_PERIOD
+ * ticks, which finds an overflow that stepped over the sentinel, or that
+ * occurred in a task that has not been swapped out since.
  */
 
 /*-----------------------------------------------------------*/
@@ -90,16 +101,69 @@
 #endif /* configCHECK_FOR_STACK_OVERFLOW == 0 */
 /*-----------------------------------------------------------*/
 
-#if( configCHECK_FOR_STACK_OVERFLOW == 1 )
+#if( ( configCHECK_FOR_STACK_OVERFLOW == 1 ) || ( configCHECK_FOR_STACK_OVERFLOW == 4 ) )
 
 	/* FreeRTOSConfig.h is only set to use the first method of
-	overflow checking. */
+	overflow checking, or to check on the tick instead. */
 	#define taskSECOND_CHECK_FOR_STACK_OVERFLOW()
 
 #endif
 /*-----------------------------------------------------------*/
 
-#if( ( configCHECK_FOR_STACK_OVERFLOW > 0 ) && ( portSTACK_GROWTH < 0 ) )
+#if( configCHECK_FOR_STACK_OVERFLOW == 4 )
+
+	/* The stack is not checked when a task is swapped out. */
+	#define taskFIRST_CHECK_FOR_STACK_OVERFLOW()
+
+	/* The sentinel of the running task is checked on each tick. */
+	#define taskTICK_CHECK_FOR_STACK_OVERFLOW()		taskCHECK_STACK_SENTINEL()
+
+#else /* configCHECK_FOR_STACK_OVERFLOW */
+
+	#define taskTICK_CHECK_FOR_STACK_OVERFLOW()
+
+#endif /* configCHECK_FOR_STACK_OVERFLOW */
+/*-----------------------------------------------------------*/
+
+#if( configCHECK_FOR_STACK_OVERFLOW > 2 )
+
+	/* The number of words at the extremity of each stack that are checked by
+	the idle task. */
+	#define taskSTACK_GUARD_WORDS		( 4 )
+
+	/* The value of a stack word that has not been written since the stack was
+	filled with tskSTACK_FILL_BYTE. */
+	#define taskSTACK_FILL_WORD			( ( ( ( portSTACK_TYPE ) ~( portSTACK_TYPE ) 0 ) / ( portSTACK_TYPE ) 0xff ) * ( portSTACK_TYPE ) tskSTACK_FILL_BYTE )
+
+	/* The lowest addressed guard word, and the sentinel. */
+	#if( portSTACK_GROWTH < 0 )
+		#define taskSTACK_GUARD( pxTCB )		( ( pxTCB )->pxStack )
+		#define taskSTACK_SENTINEL( pxTCB )		( ( pxTCB )->pxStack[ taskSTACK_GUARD_WORDS - 1 ] )
+	#else
+		#define taskSTACK_GUARD( pxTCB )		( ( pxTCB )->pxEndOfStack - ( taskSTACK_GUARD_WORDS - 1 ) )
+		#define taskSTACK_SENTINEL( pxTCB )		( *taskSTACK_GUARD( pxTCB ) )
+	#endif
+
+	#define taskCHECK_STACK_SENTINEL()																	\
+	{																									\
+		/* Has the guard word nearest the used part of the stack been written? */						\
+		if( taskSTACK_SENTINEL( pxCurrentTCB ) != taskSTACK_FILL_WORD )									\
+		{																								\
+			vApplicationStackOverflowHook( ( xTaskHandle ) pxCurrentTCB, pxCurrentTCB->pcTaskName );	\
+		}																								\
+	}
+
+#endif /* configCHECK_FOR_STACK_OVERFLOW > 2 */
+/*-----------------------------------------------------------*/
+
+#if( configCHECK_FOR_STACK_OVERFLOW == 3 )
+
+	#define taskSECOND_CHECK_FOR_STACK_OVERFLOW()	taskCHECK_STACK_SENTINEL()
+
+#endif /* configCHECK_FOR_STACK_OVERFLOW == 3 */
+/*-----------------------------------------------------------*/
+
+#if( ( configCHECK_FOR_STACK_OVERFLOW > 0 ) && ( configCHECK_FOR_STACK_OVERFLOW < 4 ) && ( portSTACK_GROWTH < 0 ) )
 
 	/* Only the current stack state is to be checked. */
 	#define taskFIRST_CHECK_FOR_STACK_OVERFLOW()														\
@@ -114,7 +178,7 @@
 #endif /* configCHECK_FOR_STACK_OVERFLOW > 0 */
 /*-----------------------------------------------------------*/
 
-#if( ( configCHECK_FOR_STACK_OVERFLOW > 0 ) && ( portSTACK_GROWTH > 0 ) )
+#if( ( configCHECK_FOR_STACK_OVERFLOW > 0 ) && ( configCHECK_FOR_STACK_OVERFLOW < 4 ) && ( portSTACK_GROWTH > 0 ) )
 
 	/* Only the current stack state is to be checked. */
 	#define taskFIRST_CHECK_FOR_STACK_OVERFLOW()														\
@@ -130,7 +194,7 @@
 #endif /* configCHECK_FOR_STACK_OVERFLOW == 1 */
 /*-----------------------------------------------------------*/
 
-#if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) && ( portSTACK_GROWTH < 0 ) )
+#if( ( configCHECK_FOR_STACK_OVERFLOW == 2 ) && ( portSTACK_GROWTH < 0 ) )
 
 	#define taskSECOND_CHECK_FOR_STACK_OVERFLOW()																								\
 	{																																			\
@@ -148,10 +212,10 @@
 		}																																		\
 	}
 
-#endif /* #if( configCHECK_FOR_STACK_OVERFLOW > 1 ) */
+#endif /* #if( configCHECK_FOR_STACK_OVERFLOW == 2 ) */
 /*-----------------------------------------------------------*/
 
-#if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) && ( portSTACK_GROWTH > 0 ) )
+#if( ( configCHECK_FOR_STACK_OVERFLOW == 2 ) && ( portSTACK_GROWTH > 0 ) )
 
 	#define taskSECOND_CHECK_FOR_STACK_OVERFLOW()																								\
 	{																																			\
@@ -172,7 +236,7 @@
 		}																																		\
 	}
 
-#endif /* #if( configCHECK_FOR_STACK_OVERFLOW > 1 ) */
+#endif /* #if( configCHECK_FOR_STACK_OVERFLOW == 2 ) */
 /*-----------------------------------------------------------*/
 
 #endif /* STACK_MACROS_H */
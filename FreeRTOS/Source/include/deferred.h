@@ -0,0 +1,201 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef DEFERRED_H
+#define DEFERRED_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include deferred.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Deferred calls move the processing of an interrupt out of the interrupt
+ * service routine and into a task.  The ISR pends a function, and the two
+ * parameters to pass to it, to one of configDEFERRED_CALL_TIERS worker tasks,
+ * then returns.  Tier 0 is serviced by a worker that runs at priority
+ * configDEFERRED_CALL_TOP_PRIORITY, tier 1 by a worker one priority below that,
+ * and so on, so urgent work is not held up behind bulk processing.
+ *
+ * Each tier holds its pended calls in a ring of configDEFERRED_CALL_QUEUE_LENGTH
+ * slots.  Interrupts pend calls without entering a critical section: a slot is
+ * reserved with a compare and swap on the head of the ring, which lets
+ * interrupts of any priority up to configMAX_SYSCALL_INTERRUPT_PRIORITY
+ * preempt each other part way through pending a call.  The calls pended to a
+ * tier execute in the order in which their slots were reserved.
+ *
+ * The time from each call being pended to it starting to execute, and the
+ * time it took to execute, are accumulated for each tier and can be read with
+ * vDeferredCallGetStats().  Times are measured with
+ * configDEFERRED_CALL_TIMESTAMP(), which defaults to the run time stats clock
+ * if configGENERATE_RUN_TIME_STATS is 1, and to the tick count otherwise.
+ */
+
+/*-----------------------------------------------------------
+ * MACROS AND DEFINITIONS
+ *----------------------------------------------------------*/
+
+/* Define the prototype to which functions pended using xDeferredCallPend()
+and xDeferredCallPendFromISR() must conform.  It matches that of functions
+pended to the RTOS daemon task, so the two can be used interchangeably. */
+typedef void (*dcDEFERRED_FUNCTION)( void *pvParameter1, unsigned long ulParameter2 );
+
+/* The statistics kept for each tier, as returned by vDeferredCallGetStats().
+Times are in units of configDEFERRED_CALL_TIMESTAMP(). */
+typedef struct xDEFERRED_CALL_STATS
+{
+	unsigned long ulCalls;				/*<< The number of calls executed. */
+	unsigned long ulDropped;			/*<< The number of calls that could not be pended because the ring was full. */
+	unsigned long ulTotalLatency;		/*<< The sum of the times from the calls being pended to them starting to execute. */
+	unsigned long ulMaxLatency;			/*<< The longest time from a call being pended to it starting to execute. */
+	unsigned long ulTotalExecution;		/*<< The sum of the times the calls took to execute. */
+	unsigned long ulMaxExecution;		/*<< The longest time a call took to execute. */
+	unsigned long ulMaxWaiting;			/*<< The most calls that were waiting to execute at once. */
+} xDeferredCallStats;
+
+/**
+ * portBASE_TYPE xDeferredCallPendFromISR( unsigned portBASE_TYPE uxTier,
+ *                                         dcDEFERRED_FUNCTION xFunctionToPend,
+ *                                         void *pvParameter1,
+ *                                         unsigned long ulParameter2,
+ *                                         signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ *
+ * Pends xFunctionToPend to the worker task of tier uxTier, which calls it with
+ * pvParameter1 and ulParameter2 once every call pended to the tier before it
+ * has executed.  The function executes in the context of the worker task, so
+ * can use any API function that does not end in "FromISR", but it should not
+ * block for long as that delays every later call pended to the same tier.
+ *
+ * Can be called from interrupts at or below
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY.  xDeferredCallPend() is the version
+ * that can be called from a task.
+ *
+ * @param uxTier The tier to pend the call to, from 0, the most urgent, to
+ * configDEFERRED_CALL_TIERS - 1.
+ *
+ * @param xFunctionToPend The function to execute from the worker task.
+ *
+ * @param pvParameter1 The value of the function's first parameter.
+ *
+ * @param ulParameter2 The value of the function's second parameter.
+ *
+ * @param pxHigherPriorityTaskWoken *pxHigherPriorityTaskWoken is set to pdTRUE
+ * if pending the call unblocked a worker task that has a priority above that
+ * of the currently running task, in which case a context switch should be
+ * requested before the interrupt exits.
+ *
+ * @return pdPASS if the call was pended, or pdFAIL if the ring of the tier was
+ * full, in which case the call is counted as dropped.
+ */
+#define xDeferredCallPendFromISR( uxTier, xFunctionToPend, pvParameter1, ulParameter2, pxHigherPriorityTaskWoken ) xDeferredCallGenericPend( ( uxTier ), ( xFunctionToPend ), ( pvParameter1 ), ( ulParameter2 ), ( pxHigherPriorityTaskWoken ), pdTRUE )
+
+/**
+ * portBASE_TYPE xDeferredCallPend( unsigned portBASE_TYPE uxTier,
+ *                                  dcDEFERRED_FUNCTION xFunctionToPend,
+ *                                  void *pvParameter1,
+ *                                  unsigned long ulParameter2 );
+ *
+ * The version of xDeferredCallPendFromISR() that can be called from a task.
+ * The slot is reserved and filled within a critical section, so the task
+ * cannot be preempted while holding up the calls pended after it.  Never
+ * blocks.
+ *
+ * @return pdPASS if the call was pended, or pdFAIL if the ring of the tier was
+ * full.
+ */
+#define xDeferredCallPend( uxTier, xFunctionToPend, pvParameter1, ulParameter2 ) xDeferredCallGenericPend( ( uxTier ), ( xFunctionToPend ), ( pvParameter1 ), ( ulParameter2 ), NULL, pdFALSE )
+
+/**
+ * void vDeferredCallGetStats( unsigned portBASE_TYPE uxTier,
+ *                             xDeferredCallStats *pxStats,
+ *                             portBASE_TYPE xReset );
+ *
+ * Copies the statistics of tier uxTier into *pxStats.  The copy is taken
+ * within a short critical section, so the scheduler keeps running and the
+ * statistics are consistent with each other.  If xReset is pdTRUE the
+ * statistics are then cleared, so the next call returns the statistics of the
+ * calls that executed in between.  The totals wrap, so should be read, and
+ * reset, often enough to be divided by ulCalls to give averages.
+ */
+void vDeferredCallGetStats( unsigned portBASE_TYPE uxTier, xDeferredCallStats *pxStats, portBASE_TYPE xReset ) PRIVILEGED_FUNCTION;
+
+/*
+ * Functions beyond this part are not part of the public API and are intended
+ * for use by the kernel only.
+ */
+portBASE_TYPE xDeferredCallGenericPend( unsigned portBASE_TYPE uxTier, dcDEFERRED_FUNCTION xFunctionToPend, void *pvParameter1, unsigned long ulParameter2, signed portBASE_TYPE *pxHigherPriorityTaskWoken, portBASE_TYPE xFromISR ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by vTaskStartScheduler() to create the worker task of each tier.
+ */
+portBASE_TYPE xDeferredCallCreateWorkers( void ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* DEFERRED_H */
+
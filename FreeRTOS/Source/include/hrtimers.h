@@ -0,0 +1,252 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+#ifndef HR_TIMERS_H
+#define HR_TIMERS_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include hrtimers.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * High resolution timers are driven by a free running 32 bit hardware counter
+ * and a single compare channel provided by the port, rather than by the tick.
+ * Active timers are held in a queue sorted by expiry time, and the compare
+ * channel is always programmed with the expiry time of the timer at the head
+ * of the queue.  Their callbacks execute either directly from the compare
+ * interrupt or, if the timer was created with xDeferCallback set to pdTRUE,
+ * from the RTOS daemon (timer service) task.
+ *
+ * The port defines portHRTIMER_COUNTS_PER_US, the rate of the counter, in
+ * portmacro.h.  Times passed to and returned from the API macros are in
+ * microseconds, times passed to xHRTimerGenericCommand() are in counts.  A
+ * delay or period must be less than 0x80000000 counts.
+ */
+
+/* IDs for the commands applied by xHRTimerGenericCommand().  These are to be
+used solely through the macros that make up the public API, as defined
+below. */
+#define hrtCOMMAND_START					( ( portBASE_TYPE ) 0 )
+#define hrtCOMMAND_STOP						( ( portBASE_TYPE ) 1 )
+#define hrtCOMMAND_CHANGE_PERIOD			( ( portBASE_TYPE ) 2 )
+
+/*-----------------------------------------------------------
+ * MACROS AND DEFINITIONS
+ *----------------------------------------------------------*/
+
+/* Convert between microseconds and counts of the high resolution counter. */
+#define hrtUS_TO_COUNTS( ulMicroseconds )	( ( unsigned long ) ( ulMicroseconds ) * ( unsigned long ) portHRTIMER_COUNTS_PER_US )
+#define hrtCOUNTS_TO_US( ulCounts )			( ( unsigned long ) ( ulCounts ) / ( unsigned long ) portHRTIMER_COUNTS_PER_US )
+
+/**
+ * Type by which high resolution timers are referenced.
+ */
+typedef void * xHRTimerHandle;
+
+/* Define the prototype to which high resolution timer callback functions must
+conform. */
+typedef void (*hrtTIMER_CALLBACK)( xHRTimerHandle xTimer );
+
+/**
+ * xHRTimerHandle xHRTimerCreate( const signed char *pcTimerName,
+ *                                hrtTIMER_CALLBACK pxCallbackFunction,
+ *                                void *pvTimerID,
+ *                                portBASE_TYPE xDeferCallback );
+ *
+ * Creates a new high resolution timer in the dormant state.  The counter and
+ * compare hardware is set up by the port when the first timer is created.
+ * High resolution timers cannot be deleted.
+ *
+ * @param pcTimerName A text name that is assigned to the timer.  This is done
+ * purely to assist debugging.
+ *
+ * @param pxCallbackFunction The function to call when the timer expires.
+ *
+ * @param pvTimerID An identifier that is assigned to the timer being created,
+ * and can be obtained by the callback function using pvHRTimerGetTimerID().
+ *
+ * @param xDeferCallback If xDeferCallback is pdFALSE the callback function is
+ * called from the compare interrupt, so can only use API functions that end in
+ * "FromISR".  It should be kept very short, as it delays every other high
+ * resolution timer.  A callback that unblocks a task should request a context
+ * switch itself, using portEND_SWITCHING_ISR().  If xDeferCallback is pdTRUE the callback function is
+ * pended to the RTOS daemon task using xTimerPendFunctionCallFromISR(), which
+ * requires configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall to be 1.
+ * Expiries that occur while a deferred callback is still waiting to execute
+ * do not pend it again, but are counted as overruns.
+ *
+ * @return If the timer is successfully created then a handle to the newly
+ * created timer is returned, otherwise NULL is returned.
+ */
+xHRTimerHandle xHRTimerCreate( const signed char * const pcTimerName, hrtTIMER_CALLBACK pxCallbackFunction, void *pvTimerID, portBASE_TYPE xDeferCallback ) PRIVILEGED_FUNCTION;
+
+/**
+ * portBASE_TYPE xHRTimerStart( xHRTimerHandle xTimer,
+ *                              unsigned long ulDelayMicroseconds,
+ *                              unsigned long ulPeriodMicroseconds );
+ *
+ * Starts, or restarts, a timer so it first expires ulDelayMicroseconds after
+ * the call.  If ulPeriodMicroseconds is 0 the timer is a one-shot timer that
+ * returns to the dormant state when it expires, otherwise it then expires
+ * every ulPeriodMicroseconds, measured from the time at which it should have
+ * expired rather than from the time at which the callback executed.  If the
+ * callback executes so late that whole periods have been missed then the
+ * missed expiries are counted as overruns instead of being executed.
+ *
+ * The command is applied immediately, so xHRTimerStart() never blocks.
+ * xHRTimerStartFromISR() is the version that can be called from an interrupt
+ * service routine, including from the callback of an ISR context timer.
+ *
+ * @return pdPASS if the timer was started, or pdFAIL if the delay or the
+ * period was too long.
+ */
+#define xHRTimerStart( xTimer, ulDelayMicroseconds, ulPeriodMicroseconds ) xHRTimerGenericCommand( ( xTimer ), hrtCOMMAND_START, hrtUS_TO_COUNTS( ulDelayMicroseconds ), hrtUS_TO_COUNTS( ulPeriodMicroseconds ), pdFALSE )
+#define xHRTimerStartFromISR( xTimer, ulDelayMicroseconds, ulPeriodMicroseconds ) xHRTimerGenericCommand( ( xTimer ), hrtCOMMAND_START, hrtUS_TO_COUNTS( ulDelayMicroseconds ), hrtUS_TO_COUNTS( ulPeriodMicroseconds ), pdTRUE )
+
+/**
+ * portBASE_TYPE xHRTimerStop( xHRTimerHandle xTimer );
+ *
+ * Returns a timer to the dormant state.  A deferred callback that was already
+ * pended to the RTOS daemon task still executes.
+ *
+ * @return pdPASS.
+ */
+#define xHRTimerStop( xTimer ) xHRTimerGenericCommand( ( xTimer ), hrtCOMMAND_STOP, 0UL, 0UL, pdFALSE )
+#define xHRTimerStopFromISR( xTimer ) xHRTimerGenericCommand( ( xTimer ), hrtCOMMAND_STOP, 0UL, 0UL, pdTRUE )
+
+/**
+ * portBASE_TYPE xHRTimerChangePeriod( xHRTimerHandle xTimer,
+ *                                     unsigned long ulNewPeriodMicroseconds );
+ *
+ * Changes the period of a timer without losing its phase.  If the timer is an
+ * active periodic timer its next expiry is moved to ulNewPeriodMicroseconds
+ * after its last expiry, which, if that time has already passed, makes it
+ * expire immediately.  Otherwise the timer is started as a periodic timer that
+ * first expires ulNewPeriodMicroseconds after the call.  This is the function
+ * to use to change the rate of a timer that is generating a regular waveform,
+ * as no period is ever shorter than the shorter of the old and the new
+ * periods.
+ *
+ * @return pdPASS if the period was changed, or pdFAIL if it was 0 or too long.
+ */
+#define xHRTimerChangePeriod( xTimer, ulNewPeriodMicroseconds ) xHRTimerGenericCommand( ( xTimer ), hrtCOMMAND_CHANGE_PERIOD, 0UL, hrtUS_TO_COUNTS( ulNewPeriodMicroseconds ), pdFALSE )
+#define xHRTimerChangePeriodFromISR( xTimer, ulNewPeriodMicroseconds ) xHRTimerGenericCommand( ( xTimer ), hrtCOMMAND_CHANGE_PERIOD, 0UL, hrtUS_TO_COUNTS( ulNewPeriodMicroseconds ), pdTRUE )
+
+/**
+ * portBASE_TYPE xHRTimerIsTimerActive( xHRTimerHandle xTimer );
+ *
+ * @return pdFALSE if the timer is dormant, otherwise pdTRUE.
+ */
+portBASE_TYPE xHRTimerIsTimerActive( xHRTimerHandle xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * void *pvHRTimerGetTimerID( xHRTimerHandle xTimer );
+ *
+ * @return The ID assigned to the timer when it was created.
+ */
+void *pvHRTimerGetTimerID( xHRTimerHandle xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * unsigned long ulHRTimerGetOverruns( xHRTimerHandle xTimer );
+ *
+ * @return The number of expiries of the timer, since it was created, for
+ * which the callback function was not executed, either because whole periods
+ * were missed or because a deferred callback was still waiting to execute.
+ */
+unsigned long ulHRTimerGetOverruns( xHRTimerHandle xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * unsigned long ulHRTimerGetCount( void );
+ *
+ * @return The current value of the free running high resolution counter,
+ * which wraps from 0xffffffff to 0.  The difference between two values, masked
+ * to 32 bits, is the number of counts between them.
+ */
+unsigned long ulHRTimerGetCount( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Functions beyond this part are not part of the public API and are intended
+ * for use by the kernel only.
+ */
+portBASE_TYPE xHRTimerGenericCommand( xHRTimerHandle xTimer, portBASE_TYPE xCommandID, unsigned long ulDelay, unsigned long ulPeriod, portBASE_TYPE xFromISR ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the port from the compare interrupt, which must be at or below
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY, after it has cleared the interrupt.
+ * Executes or pends the callback of every timer that has expired then
+ * reprograms the compare channel.  Returns pdTRUE if a context switch should
+ * be performed before the interrupt returns.
+ */
+portBASE_TYPE xHRTimerProcessCompare( void ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* HR_TIMERS_H */
+
@@ -0,0 +1,281 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef MESSAGE_BUFFER_H
+#define MESSAGE_BUFFER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include message_buffer.h"
+#endif
+
+/* Message buffers are built on stream buffers. */
+#include "stream_buffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Message buffers pass variable length messages, such as text lines or
+ * command frames, from a single writer to a single reader.  Each message is
+ * held in the buffer as a configMESSAGE_BUFFER_LENGTH_TYPE length followed by
+ * the message itself, so only the bytes actually sent are copied and stored.
+ * A queue, by comparison, reserves and copies a whole item for every
+ * message, however short.
+ *
+ * Message buffers are stream buffers that are created with
+ * xMessageBufferCreate(), so the same rules apply: only one task or interrupt
+ * may write to, and only one task or interrupt may read from, a message
+ * buffer.  If several tasks write to the same message buffer then each write
+ * must be serialised, for example by a mutex.
+ *
+ * Type by which message buffers are referenced.  For example, a call to
+ * xMessageBufferCreate() returns an xMessageBufferHandle variable that can
+ * then be used as a parameter to xMessageBufferSend(),
+ * xMessageBufferReceive(), etc.
+ */
+typedef xStreamBufferHandle xMessageBufferHandle;
+
+/**
+ * message_buffer.h
+ * <pre>
+ xMessageBufferHandle xMessageBufferCreate( size_t xBufferSizeBytes );
+ </pre>
+ *
+ * Creates a new message buffer.
+ *
+ * @param xBufferSizeBytes The total number of bytes the message buffer will
+ * be able to hold at any one time.  Each message uses
+ * sizeof( configMESSAGE_BUFFER_LENGTH_TYPE ) bytes more than its length, so
+ * with a 4 byte length a 10 byte message uses 14 bytes of the buffer.
+ *
+ * @return If the message buffer is created successfully then a handle to the
+ * created message buffer is returned.  If there was not enough heap memory
+ * available to create the message buffer then NULL is returned.
+ *
+ * \defgroup xMessageBufferCreate xMessageBufferCreate
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferCreate( xBufferSizeBytes ) ( xMessageBufferHandle ) xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( size_t ) 0, pdTRUE )
+
+/**
+ * message_buffer.h
+ * <pre>
+ size_t xMessageBufferSend( xMessageBufferHandle xMessageBuffer, const void *pvTxData, size_t xDataLengthBytes, portTickType xTicksToWait );
+ </pre>
+ *
+ * Sends a message to a message buffer from a task.  Use
+ * xMessageBufferSendFromISR() to write to a message buffer from an interrupt
+ * service routine.
+ *
+ * A message is either written in full or not written at all.  If there is
+ * not enough space for the message the task blocks for up to xTicksToWait
+ * ticks for the reader to make space.
+ *
+ * @param xMessageBuffer The handle of the message buffer to which a message
+ * is being sent.
+ *
+ * @param pvTxData A pointer to the message that is to be copied into the
+ * message buffer.
+ *
+ * @param xDataLengthBytes The length of the message.  A message longer than
+ * the message buffer, less the length field, can never be sent.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in
+ * the Blocked state to wait for enough space to become available.
+ *
+ * @return xDataLengthBytes if the message was written, otherwise 0.
+ *
+ * \defgroup xMessageBufferSend xMessageBufferSend
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSend( xMessageBuffer, pvTxData, xDataLengthBytes, xTicksToWait ) xStreamBufferSend( ( xMessageBuffer ), ( pvTxData ), ( xDataLengthBytes ), ( xTicksToWait ) )
+
+/**
+ * message_buffer.h
+ * <pre>
+ size_t xMessageBufferSendFromISR( xMessageBufferHandle xMessageBuffer, const void *pvTxData, size_t xDataLengthBytes, portBASE_TYPE *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * Interrupt safe version of xMessageBufferSend().  Never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if writing the message
+ * unblocked a task that has a priority above the priority of the currently
+ * running task, in which case a context switch should be requested before
+ * the interrupt is exited.
+ *
+ * @return xDataLengthBytes if the message was written, or 0 if there was
+ * not enough free space for the whole message.
+ *
+ * \defgroup xMessageBufferSendFromISR xMessageBufferSendFromISR
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendFromISR( xMessageBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferSendFromISR( ( xMessageBuffer ), ( pvTxData ), ( xDataLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * message_buffer.h
+ * <pre>
+ size_t xMessageBufferReceive( xMessageBufferHandle xMessageBuffer, void *pvRxData, size_t xBufferLengthBytes, portTickType xTicksToWait );
+ </pre>
+ *
+ * Receives the next message from a message buffer.  Use
+ * xMessageBufferReceiveFromISR() to read from a message buffer from an
+ * interrupt service routine.
+ *
+ * If the message buffer is empty the task will block for up to xTicksToWait
+ * ticks for a message to arrive.
+ *
+ * @param xMessageBuffer The handle of the message buffer from which a message
+ * is being received.
+ *
+ * @param pvRxData A pointer to the buffer into which the message is copied.
+ *
+ * @param xBufferLengthBytes The length of the buffer pointed to by pvRxData.
+ * If the next message is longer than this it is left in the message buffer
+ * and 0 is returned.  Use xMessageBufferNextLengthBytes() to find the length
+ * of the next message before reading it.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in
+ * the Blocked state to wait for a message.
+ *
+ * @return The length of the message read, or 0 if no message was read.
+ *
+ * \defgroup xMessageBufferReceive xMessageBufferReceive
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReceive( xMessageBuffer, pvRxData, xBufferLengthBytes, xTicksToWait ) xStreamBufferReceive( ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( xTicksToWait ) )
+
+/**
+ * message_buffer.h
+ * <pre>
+ size_t xMessageBufferReceiveFromISR( xMessageBufferHandle xMessageBuffer, void *pvRxData, size_t xBufferLengthBytes, portBASE_TYPE *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * Interrupt safe version of xMessageBufferReceive().  Never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if reading the message made
+ * space for a task that was blocked waiting to write, and that task has a
+ * priority above the priority of the currently running task.
+ *
+ * @return The length of the message read, or 0 if no message was read.
+ *
+ * \defgroup xMessageBufferReceiveFromISR xMessageBufferReceiveFromISR
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReceiveFromISR( xMessageBuffer, pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferReceiveFromISR( ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * message_buffer.h
+ * <pre>
+ size_t xMessageBufferNextLengthBytes( xMessageBufferHandle xMessageBuffer );
+ </pre>
+ *
+ * Returns the length of the next message in the message buffer without
+ * removing it, or 0 if the message buffer is empty.  Can be called from
+ * tasks and interrupts.
+ *
+ * \defgroup xMessageBufferNextLengthBytes xMessageBufferNextLengthBytes
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferNextLengthBytes( xMessageBuffer ) xStreamBufferNextMessageLengthBytes( ( xMessageBuffer ) )
+
+/**
+ * message_buffer.h
+ * <pre>
+ void vMessageBufferDelete( xMessageBufferHandle xMessageBuffer );
+ portBASE_TYPE xMessageBufferReset( xMessageBufferHandle xMessageBuffer );
+ </pre>
+ *
+ * Delete a message buffer, or discard all the messages it holds.  See
+ * vStreamBufferDelete() and xStreamBufferReset().
+ *
+ * \defgroup vMessageBufferDelete vMessageBufferDelete
+ * \ingroup MessageBufferManagement
+ */
+#define vMessageBufferDelete( xMessageBuffer ) vStreamBufferDelete( ( xMessageBuffer ) )
+#define xMessageBufferReset( xMessageBuffer ) xStreamBufferReset( ( xMessageBuffer ) )
+
+/**
+ * message_buffer.h
+ * <pre>
+ size_t xMessageBufferSpaceAvailable( xMessageBufferHandle xMessageBuffer );
+ portBASE_TYPE xMessageBufferIsEmpty( xMessageBufferHandle xMessageBuffer );
+ </pre>
+ *
+ * Query the free space in, or whether there are any messages in, a message
+ * buffer.  The longest message that can be written is the free space less
+ * sizeof( configMESSAGE_BUFFER_LENGTH_TYPE ).
+ *
+ * \defgroup xMessageBufferSpaceAvailable xMessageBufferSpaceAvailable
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSpaceAvailable( xMessageBuffer ) xStreamBufferSpacesAvailable( ( xMessageBuffer ) )
+#define xMessageBufferIsEmpty( xMessageBuffer ) ( ( xStreamBufferBytesAvailable( ( xMessageBuffer ) ) == ( size_t ) 0 ) ? pdTRUE : pdFALSE )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !defined( MESSAGE_BUFFER_H ) */
+
@@ -393,6 +393,20 @@ void vPortEndScheduler( void ) PRIVILEGED_FUNCTION;
 	void vPortStoreTaskMPUSettings( xMPU_SETTINGS *xMPUSettings, const struct xMEMORY_REGION * const xRegions, portSTACK_TYPE *pxBottomOfStack, unsigned short usStackDepth ) PRIVILEGED_FUNCTION;
 #endif
 
+/*
+ * The hardware used by the high resolution timers of hrtimers.c: a free
+ * running 32 bit counter that increments portHRTIMER_COUNTS_PER_US times a
+ * microsecond, and a compare channel.  vPortHRTimerSetCompare() must raise the
+ * compare interrupt straight away if the count has already passed
+ * ulCompareCount.  The compare interrupt calls xHRTimerProcessCompare().
+ */
+#if( configUSE_HR_TIMERS == 1 )
+	void vPortHRTimerSetup( void ) PRIVILEGED_FUNCTION;
+	unsigned long ulPortHRTimerGetCount( void ) PRIVILEGED_FUNCTION;
+	void vPortHRTimerSetCompare( unsigned long ulCompareCount ) PRIVILEGED_FUNCTION;
+	void vPortHRTimerClearCompare( void ) PRIVILEGED_FUNCTION;
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -96,6 +96,24 @@ typedef void * xQueueSetHandle;
  */
 typedef void * xQueueSetMemberHandle;
 
+/**
+ * Type by which zero copy queues are referenced.  For example, a call to
+ * xQueueCreateZeroCopy() returns an xZeroCopyQueueHandle variable that can
+ * then be used as a parameter to pvQueueAcquireSlot(), xQueueCommitSlot(), etc.
+ */
+typedef void * xZeroCopyQueueHandle;
+
+/**
+ * The statistics vSemaphoreGetMutexStats() reads from a mutex.  Times are in
+ * the units of the run time stats counter if configGENERATE_RUN_TIME_STATS is
+ * set to 1, otherwise in ticks.
+ */
+typedef struct xMUTEX_STATS
+{
+	unsigned long ulMaxHoldTime;	/* The longest time the mutex has been held, from the take to the give. */
+	unsigned long ulMaxWaitTime;	/* The longest time a task has waited for the mutex, whether or not it then obtained the mutex. */
+} xMutexStatsType;
+
 /* For internal use only. */
 #define	queueSEND_TO_BACK		( ( portBASE_TYPE ) 0 )
 #define	queueSEND_TO_FRONT		( ( portBASE_TYPE ) 1 )
@@ -108,6 +126,45 @@ typedef void * xQueueSetMemberHandle;
 #define queueQUEUE_TYPE_COUNTING_SEMAPHORE	( ( unsigned char ) 2U )
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE	( ( unsigned char ) 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX		( ( unsigned char ) 4U )
+#define queueQUEUE_TYPE_CEILING_MUTEX		( ( unsigned char ) 5U )
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	#include "list.h"
+
+	/*
+	 * Memory in which xQueueCreateStatic() and the static semaphore creation
+	 * macros create a queue or semaphore.  The queue structure is private to
+	 * queue.c, so this structure only has the same size and alignment.  Its
+	 * members must not be accessed, and it must be updated whenever a member
+	 * is added to the queue structure.
+	 */
+	typedef struct xSTATIC_QUEUE
+	{
+		void *pvDummy1[ 3 ];
+		union
+		{
+			void *pvDummy2;
+			unsigned portBASE_TYPE uxDummy2;
+		} u;
+		xList xDummy3[ 2 ];
+		unsigned portBASE_TYPE uxDummy4[ 3 ];
+		signed portBASE_TYPE xDummy5[ 2 ];
+		#if ( configUSE_TRACE_FACILITY == 1 )
+			unsigned char ucDummy6[ 2 ];
+		#endif
+		#if ( configUSE_QUEUE_SETS == 1 )
+			void *pvDummy7;
+			xListItem xDummy8;
+		#endif
+		#if ( configUSE_CEILING_MUTEXES == 1 )
+			unsigned portBASE_TYPE uxDummy10[ 2 ];
+			unsigned long ulDummy11[ 3 ];
+		#endif
+		unsigned char ucDummy9;
+	} xStaticQueueType;
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
 
 /**
  * queue. h
@@ -167,6 +224,53 @@ typedef void * xQueueSetMemberHandle;
  */
 #define xQueueCreate( uxQueueLength, uxItemSize ) xQueueGenericCreate( uxQueueLength, uxItemSize, queueQUEUE_TYPE_BASE )
 
+/**
+ * queue. h
+ * <pre>
+ xQueueHandle xQueueCreateStatic(
+							  unsigned portBASE_TYPE uxQueueLength,
+							  unsigned portBASE_TYPE uxItemSize,
+							  unsigned char *pucQueueStorage,
+							  xStaticQueueType *pxQueueBuffer
+						  );
+ * </pre>
+ *
+ * As xQueueCreate(), but the queue is created in memory provided by the
+ * application, so the heap is not used.  configSUPPORT_STATIC_ALLOCATION must
+ * be set to 1 in FreeRTOSConfig.h for this macro to be available.
+ *
+ * @param pucQueueStorage An array of at least ( uxQueueLength * uxItemSize )
+ * bytes, in which the items in the queue are held.  Can be NULL if uxItemSize
+ * is 0.
+ *
+ * @param pxQueueBuffer The memory in which the queue structure is created.
+ *
+ * @return A handle to the created queue, or NULL if pxQueueBuffer is NULL or
+ * uxQueueLength is 0.
+ *
+ * Example usage:
+   <pre>
+ #define QUEUE_LENGTH 10
+
+ static xStaticQueueType xQueueBuffer;
+ static unsigned char ucQueueStorage[ QUEUE_LENGTH * sizeof( unsigned long ) ];
+
+ void vATask( void *pvParameters )
+ {
+ xQueueHandle xQueue;
+
+	// Create a queue capable of containing 10 unsigned long values without
+	// using the heap.
+	xQueue = xQueueCreateStatic( QUEUE_LENGTH, sizeof( unsigned long ), ucQueueStorage, &xQueueBuffer );
+ }
+ </pre>
+ * \defgroup xQueueCreateStatic xQueueCreateStatic
+ * \ingroup QueueManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#define xQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer ) xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), queueQUEUE_TYPE_BASE )
+#endif
+
 /**
  * queue. h
  * <pre>
@@ -1405,6 +1509,164 @@ signed portBASE_TYPE xQueueGenericSendFromISR( xQueueHandle xQueue, const void *
  */
 signed portBASE_TYPE xQueueReceiveFromISR( xQueueHandle xQueue, const void * const pvBuffer, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ unsigned portBASE_TYPE xQueueSendMultiple(
+										 xQueueHandle xQueue,
+										 const void * pvItemsToQueue,
+										 unsigned portBASE_TYPE uxItemCount,
+										 portTickType xTicksToWait
+									 );
+ * </pre>
+ *
+ * Post a number of items to the back of a queue.  The items are copied into
+ * the queue with a single critical section, and a single decision on whether
+ * a context switch is required, for each time the call finds space in the
+ * queue - rather than once for each item as when xQueueSend() is called in a
+ * loop.
+ *
+ * If the queue does not have space for all the items then as many as fit are
+ * posted, and the calling task blocks for up to xTicksToWait ticks for space to
+ * post the rest.  Items posted by other tasks or interrupts while the calling
+ * task is blocked can be placed between the items posted by this call.
+ *
+ * This function must not be used with a semaphore or a mutex.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to an array of uxItemCount items, each of the
+ * item size the queue was created with.
+ *
+ * @param uxItemCount The number of items to post.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue.
+ *
+ * @return The number of items posted, which is less than uxItemCount if the
+ * block time expired before all the items could be posted.
+ *
+ * Example usage:
+   <pre>
+ void vSendString( xQueueHandle xCharQueue, const char *pcString )
+ {
+	// Post every character of the string, blocking as necessary.
+	xQueueSendMultiple( xCharQueue, pcString, strlen( pcString ), portMAX_DELAY );
+ }
+ </pre>
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+unsigned portBASE_TYPE xQueueSendMultiple( xQueueHandle xQueue, const void * const pvItemsToQueue, unsigned portBASE_TYPE uxItemCount, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ unsigned portBASE_TYPE xQueueSendMultipleFromISR(
+										 xQueueHandle xQueue,
+										 const void * pvItemsToQueue,
+										 unsigned portBASE_TYPE uxItemCount,
+										 portBASE_TYPE *pxHigherPriorityTaskWoken
+									 );
+ * </pre>
+ *
+ * A version of xQueueSendMultiple() that can be used from an interrupt service
+ * routine.  As many of the items as fit are posted, and the function does not
+ * block.
+ *
+ * @param pxHigherPriorityTaskWoken *pxHigherPriorityTaskWoken is set to pdTRUE
+ * if posting the items unblocked a task that has a priority above the
+ * currently running task.
+ *
+ * @return The number of items posted.
+ *
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+unsigned portBASE_TYPE xQueueSendMultipleFromISR( xQueueHandle xQueue, const void * const pvItemsToQueue, unsigned portBASE_TYPE uxItemCount, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ unsigned portBASE_TYPE xQueueReceiveMultiple(
+										 xQueueHandle xQueue,
+										 void *pvBuffer,
+										 unsigned portBASE_TYPE uxMaxItems,
+										 portTickType xTicksToWait
+									 );
+ * </pre>
+ *
+ * Receive up to uxMaxItems items from a queue with a single critical section.
+ * If the queue is empty the calling task blocks for up to xTicksToWait ticks
+ * for an item to arrive, then receives as many items as are available, up to
+ * uxMaxItems.  The function does not wait for uxMaxItems items to arrive.
+ *
+ * This function must not be used with a semaphore or a mutex.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received items will be
+ * copied.  The buffer must have space for uxMaxItems items.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty at the time of the
+ * call.
+ *
+ * @return The number of items received, which is 0 if the block time expired
+ * before an item arrived.
+ *
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+unsigned portBASE_TYPE xQueueReceiveMultiple( xQueueHandle xQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ unsigned portBASE_TYPE xQueueReceiveMultipleFromISR(
+										 xQueueHandle xQueue,
+										 void *pvBuffer,
+										 unsigned portBASE_TYPE uxMaxItems,
+										 portBASE_TYPE *pxHigherPriorityTaskWoken
+									 );
+ * </pre>
+ *
+ * A version of xQueueReceiveMultiple() that can be used from an interrupt
+ * service routine.  The function does not block.
+ *
+ * @param pxHigherPriorityTaskWoken *pxHigherPriorityTaskWoken is set to pdTRUE
+ * if receiving the items unblocked a task that has a priority above the
+ * currently running task.
+ *
+ * @return The number of items received.
+ *
+ * Example usage:
+   <pre>
+ void vUARTTxISR( void )
+ {
+ char cChars[ 8 ];
+ unsigned portBASE_TYPE uxCount, uxIndex;
+ portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	// Fill the transmit FIFO from the queue of characters to send.
+	uxCount = xQueueReceiveMultipleFromISR( xTxQueue, cChars, sizeof( cChars ), &xHigherPriorityTaskWoken );
+
+	for( uxIndex = 0; uxIndex < uxCount; uxIndex++ )
+	{
+		vWriteToTxFIFO( cChars[ uxIndex ] );
+	}
+
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+ }
+ </pre>
+ * \defgroup xQueueReceiveMultipleFromISR xQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+unsigned portBASE_TYPE xQueueReceiveMultipleFromISR( xQueueHandle xQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from witin an ISR, or within a critical section.
@@ -1458,6 +1720,27 @@ xQueueHandle xQueueCreateMutex( unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
 xQueueHandle xQueueCreateCountingSemaphore( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount ) PRIVILEGED_FUNCTION;
 void* xQueueGetMutexHolder( xQueueHandle xSemaphore ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Use xSemaphoreCreateMutexStatic(),
+ * xSemaphoreCreateRecursiveMutexStatic() or xSemaphoreCreateCountingStatic()
+ * instead of calling these functions directly.
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xQueueHandle xQueueCreateMutexStatic( unsigned char ucQueueType, xStaticQueueType *pxStaticQueue ) PRIVILEGED_FUNCTION;
+	xQueueHandle xQueueCreateCountingSemaphoreStatic( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount, xStaticQueueType *pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * For internal use only.  Use xSemaphoreCreateCeilingMutex(),
+ * xSemaphoreCreateCeilingMutexStatic() or vSemaphoreGetMutexStats() instead of
+ * calling these functions directly.
+ */
+xQueueHandle xQueueCreateCeilingMutex( unsigned portBASE_TYPE uxCeilingPriority ) PRIVILEGED_FUNCTION;
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xQueueHandle xQueueCreateCeilingMutexStatic( unsigned portBASE_TYPE uxCeilingPriority, xStaticQueueType *pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+void vQueueGetMutexStats( xQueueHandle xMutex, xMutexStatsType *pxStats, portBASE_TYPE xReset ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Use xSemaphoreTakeMutexRecursive() or
  * xSemaphoreGiveMutexRecursive() instead of calling these functions directly.
@@ -1517,6 +1800,15 @@ portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle pxMutex ) PRIVILEGED_FUNCTI
  */
 xQueueHandle xQueueGenericCreate( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
 
+/*
+ * Generic version of the function that creates a queue in memory provided by
+ * the application, which is in turn called by xQueueCreateStatic() and the
+ * static semaphore creation macros.
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xQueueHandle xQueueGenericCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorage, xStaticQueueType *pxStaticQueue, unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Queue sets provide a mechanism to allow a task to block (pend) on a read
  * operation from multiple queues or semaphores simultaneously.
@@ -1531,6 +1823,13 @@ xQueueHandle xQueueGenericCreate( unsigned portBASE_TYPE uxQueueLength, unsigned
  * or semaphores contained in the set is in a state where a queue read or
  * semaphore take operation would be successful.
  *
+ * A queue set keeps a list of the members that are ready.  A member is added
+ * to the list when it goes from empty to containing data (or from taken to
+ * available), and is removed when xQueueSelectFromSet() finds it empty again.
+ * Posting further items to a member that is already ready costs nothing extra,
+ * and selecting a member does not depend on the number of members in the set,
+ * so a single task can service a large number of queues and semaphores.
+ *
  * Note 1:  See the documentation on http://wwwFreeRTOS.org/RTOS-queue-sets.html
  * for reasons why queue sets are very rarely needed in practice as there are
  * simpler methods of blocking on multiple objects.
@@ -1538,29 +1837,15 @@ xQueueHandle xQueueGenericCreate( unsigned portBASE_TYPE uxQueueLength, unsigned
  * Note 2:  Blocking on a queue set that contains a mutex will not cause the
  * mutex holder to inherit the priority of the blocked task.
  *
- * Note 3:  An additional 4 bytes of RAM is required for each space in a every
- * queue added to a queue set.  Therefore counting semaphores that have a high
- * maximum count value should not be added to a queue set.
- *
- * Note 4:  A receive (in the case of a queue) or take (in the case of a
- * semaphore) operation must not be performed on a member of a queue set unless
- * a call to xQueueSelectFromSet() has first returned a handle to that set member.
- *
- * @param uxEventQueueLength Queue sets store events that occur on
- * the queues and semaphores contained in the set.  uxEventQueueLength specifies
- * the maximum number of events that can be queued at once.  To be absolutely
- * certain that events are not lost uxEventQueueLength should be set to the
- * total sum of the length of the queues added to the set, where binary
- * semaphores and mutexes have a length of 1, and counting semaphores have a
- * length set by their maximum count value.  Examples:
- *  + If a queue set is to hold a queue of length 5, another queue of length 12,
- *    and a binary semaphore, then uxEventQueueLength should be set to
- *    (5 + 12 + 1), or 18.
- *  + If a queue set is to hold three binary semaphores then uxEventQueueLength
- *    should be set to (1 + 1 + 1 ), or 3.
- *  + If a queue set is to hold a counting semaphore that has a maximum count of
- *    5, and a counting semaphore that has a maximum count of 3, then
- *    uxEventQueueLength should be set to (5 + 3), or 8.
+ * Note 3:  Tasks that block on a member of a queue set are not unblocked when
+ * data is posted to the member, only tasks that block on the set are, so each
+ * member should only be read by the task (or tasks) that select from the set.
+ *
+ * Note 4:  A queue set must not be reset or deleted while it has members.
+ *
+ * @param uxEventQueueLength Not used.  Queue sets no longer store an event for
+ * each item posted to their members, so need no space that depends on the
+ * length of their members.  The parameter is retained for compatibility.
  *
  * @return If the queue set is created successfully then a handle to the created
  * queue set is returned.  Otherwise NULL is returned.
@@ -1574,9 +1859,8 @@ xQueueSetHandle xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength ) PRI
  * See FreeRTOS/Source/Demo/Common/Minimal/QueueSet.c for an example using this
  * function.
  *
- * Note 1:  A receive (in the case of a queue) or take (in the case of a
- * semaphore) operation must not be performed on a member of a queue set unless
- * a call to xQueueSelectFromSet() has first returned a handle to that set member.
+ * A queue that already contains data, or a semaphore that is already
+ * available, can be added to a set, and is ready as soon as it is added.
  *
  * @param xQueueOrSemaphore The handle of the queue or semaphore being added to
  * the queue set (cast to an xQueueSetMemberHandle type).
@@ -1592,8 +1876,8 @@ xQueueSetHandle xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength ) PRI
 portBASE_TYPE xQueueAddToSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet ) PRIVILEGED_FUNCTION;
 
 /*
- * Removes a queue or semaphore from a queue set.  A queue or semaphore can only
- * be removed from a set if the queue or semaphore is empty.
+ * Removes a queue or semaphore from a queue set.  Any data the queue contains
+ * is left in the queue.
  *
  * See FreeRTOS/Source/Demo/Common/Minimal/QueueSet.c for an example using this
  * function.
@@ -1605,8 +1889,8 @@ portBASE_TYPE xQueueAddToSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSet
  * is included.
  *
  * @return If the queue or semaphore was successfully removed from the queue set
- * then pdPASS is returned.  If the queue was not in the queue set, or the
- * queue (or semaphore) was not empty, then pdFAIL is returned.
+ * then pdPASS is returned.  If the queue was not in the queue set then pdFAIL
+ * is returned.
  */
 portBASE_TYPE xQueueRemoveFromSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet ) PRIVILEGED_FUNCTION;
 
@@ -1627,9 +1911,10 @@ portBASE_TYPE xQueueRemoveFromSet( xQueueSetMemberHandle xQueueOrSemaphore, xQue
  * Note 2:  Blocking on a queue set that contains a mutex will not cause the
  * mutex holder to inherit the priority of the blocked task.
  *
- * Note 3:  A receive (in the case of a queue) or take (in the case of a
- * semaphore) operation must not be performed on a member of a queue set unless
- * a call to xQueueSelectFromSet() has first returned a handle to that set member.
+ * Note 3:  The member returned is still ready when the task next selects from
+ * the set unless the task has emptied it, so the task can read one item or all
+ * the items the member contains.  Members that are ready are returned in turn,
+ * so a member that always contains data does not starve the others.
  *
  * @param xQueueSet The queue set on which the task will (potentially) block.
  *
@@ -1651,6 +1936,130 @@ xQueueSetMemberHandle xQueueSelectFromSet( xQueueSetHandle xQueueSet, portTickTy
  */
 xQueueSetMemberHandle xQueueSelectFromSetFromISR( xQueueSetHandle xQueueSet ) PRIVILEGED_FUNCTION;
 
+/*
+ * Zero copy queues pass items by reference rather than by copy.  The queue
+ * owns a fixed pool of uxQueueLength slots, each uxItemSize bytes long.  A
+ * sender obtains an empty slot with pvQueueAcquireSlot(), writes the item
+ * directly into the slot, then passes the slot to the receivers with
+ * xQueueCommitSlot().  A receiver obtains the oldest committed slot with
+ * pvQueueReceiveSlot(), reads the item in place, then returns the slot to the
+ * pool with vQueueReleaseSlot().  No item is copied, so the cost of queuing
+ * an item does not depend on its size.
+ *
+ * A zero copy queue has a single sender and a single receiver, which can each
+ * be a task or an interrupt.  Where more than one task sends to (or receives
+ * from) the same zero copy queue, the calls must be made from inside a
+ * critical section or while holding a mutex.  Each side holds at most one slot
+ * at a time: pvQueueAcquireSlot() returns the same slot until that slot is
+ * committed, and pvQueueReceiveSlot() returns the same slot until that slot is
+ * released.  A slot must not be accessed by a side after it has been
+ * committed or released.  The sender and the receiver only need a critical
+ * section when one must block or unblock the other.
+ *
+ * configUSE_ZERO_COPY_QUEUES must be set to 1 in FreeRTOSConfig.h for the zero
+ * copy queue API functions to be available.  Zero copy queues use direct to
+ * task notifications, so configUSE_TASK_NOTIFICATIONS must also be set to 1.
+ *
+ * @param uxQueueLength The number of slots in the queue.
+ *
+ * @param uxItemSize The size, in bytes, of each slot.  Each slot is aligned to
+ * portBYTE_ALIGNMENT so can hold a structure of any type.
+ *
+ * @return If the queue is created then a handle to the queue is returned.
+ * Otherwise NULL is returned.
+ */
+xZeroCopyQueueHandle xQueueCreateZeroCopy( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Delete a zero copy queue, freeing the slots with it.  No slot of the queue
+ * may be used after the queue has been deleted, and no task may be blocked on
+ * the queue when it is deleted.
+ */
+void vQueueDeleteZeroCopy( xZeroCopyQueueHandle xQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Obtain an empty slot from a zero copy queue.  Calling pvQueueAcquireSlot()
+ * again before the slot has been committed returns the same slot.
+ *
+ * @param xQueue The queue from which the slot is taken.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for a slot to become free should all the slots be in use.
+ *
+ * @return A pointer to the slot, or NULL if no slot became free before the
+ * block time expired.
+ */
+void *pvQueueAcquireSlot( xZeroCopyQueueHandle xQueue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * A version of pvQueueAcquireSlot() that can be used from an ISR.  Returns
+ * NULL if no slot is free.
+ */
+void *pvQueueAcquireSlotFromISR( xZeroCopyQueueHandle xQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Pass a slot obtained from pvQueueAcquireSlot() to the receiver.  Slots are
+ * received in the order in which they were committed.  This function never
+ * blocks.
+ *
+ * @param xQueue The queue from which the slot was acquired.
+ *
+ * @param pvSlot The slot, as returned by pvQueueAcquireSlot().
+ *
+ * @return pdPASS.
+ */
+portBASE_TYPE xQueueCommitSlot( xZeroCopyQueueHandle xQueue, void *pvSlot ) PRIVILEGED_FUNCTION;
+
+/*
+ * A version of xQueueCommitSlot() that can be used from an ISR.
+ * *pxHigherPriorityTaskWoken is set to pdTRUE if committing the slot unblocked
+ * a task that has a priority above the interrupted task.
+ */
+portBASE_TYPE xQueueCommitSlotFromISR( xZeroCopyQueueHandle xQueue, void *pvSlot, portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Obtain the oldest committed slot from a zero copy queue.
+ *
+ * @param xQueue The queue from which the slot is received.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for a slot to be committed should none be available.
+ *
+ * @return A pointer to the slot, or NULL if no slot was committed before the
+ * block time expired.  The slot must be returned with vQueueReleaseSlot() once
+ * the item it holds has been consumed.  Calling pvQueueReceiveSlot() again
+ * before then returns the same slot.
+ */
+void *pvQueueReceiveSlot( xZeroCopyQueueHandle xQueue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * A version of pvQueueReceiveSlot() that can be used from an ISR.  Returns
+ * NULL if no slot has been committed.
+ */
+void *pvQueueReceiveSlotFromISR( xZeroCopyQueueHandle xQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return a received slot to the pool of free slots so it can be acquired
+ * again.
+ *
+ * @param xQueue The queue to which the slot belongs.
+ *
+ * @param pvSlot The slot, as returned by pvQueueReceiveSlot().
+ */
+void vQueueReleaseSlot( xZeroCopyQueueHandle xQueue, void *pvSlot ) PRIVILEGED_FUNCTION;
+
+/*
+ * A version of vQueueReleaseSlot() that can be used from an ISR.
+ * *pxHigherPriorityTaskWoken is set to pdTRUE if releasing the slot unblocked
+ * a task that has a priority above the interrupted task.
+ */
+void vQueueReleaseSlotFromISR( xZeroCopyQueueHandle xQueue, void *pvSlot, portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the number of slots that have been committed but not yet released.
+ */
+unsigned portBASE_TYPE uxQueueSlotsWaiting( const xZeroCopyQueueHandle xQueue ) PRIVILEGED_FUNCTION;
+
 /* Not public API functions. */
 void vQueueWaitForMessageRestricted( xQueueHandle xQueue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
 portBASE_TYPE xQueueGenericReset( xQueueHandle xQueue, portBASE_TYPE xNewQueue ) PRIVILEGED_FUNCTION;
@@ -73,6 +73,11 @@
 
 typedef xQueueHandle xSemaphoreHandle;
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	/* Memory in which a semaphore or mutex is created without using the heap. */
+	typedef xStaticQueueType xStaticSemaphoreType;
+#endif
+
 #define semBINARY_SEMAPHORE_QUEUE_LENGTH	( ( unsigned char ) 1U )
 #define semSEMAPHORE_QUEUE_ITEM_LENGTH		( ( unsigned char ) 0U )
 #define semGIVE_BLOCK_TIME					( ( portTickType ) 0U )
@@ -125,6 +130,38 @@ typedef xQueueHandle xSemaphoreHandle;
 		}																																		\
 	}
 
+/**
+ * semphr. h
+ * <pre>vSemaphoreCreateBinaryStatic( xSemaphoreHandle xSemaphore, xStaticSemaphoreType *pxSemaphoreBuffer )</pre>
+ *
+ * As vSemaphoreCreateBinary(), but the semaphore is created in
+ * pxSemaphoreBuffer, so the heap is not used.  configSUPPORT_STATIC_ALLOCATION
+ * must be set to 1 in FreeRTOSConfig.h for this macro to be available.
+ *
+ * Example usage:
+ <pre>
+ xSemaphoreHandle xSemaphore;
+ static xStaticSemaphoreType xSemaphoreBuffer;
+
+ void vATask( void * pvParameters )
+ {
+    vSemaphoreCreateBinaryStatic( xSemaphore, &xSemaphoreBuffer );
+ }
+ </pre>
+ * \defgroup vSemaphoreCreateBinaryStatic vSemaphoreCreateBinaryStatic
+ * \ingroup Semaphores
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#define vSemaphoreCreateBinaryStatic( xSemaphore, pxSemaphoreBuffer )																		\
+		{																																		\
+			( xSemaphore ) = xQueueGenericCreateStatic( ( unsigned portBASE_TYPE ) 1, semSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, ( pxSemaphoreBuffer ), queueQUEUE_TYPE_BINARY_SEMAPHORE );	\
+			if( ( xSemaphore ) != NULL )																										\
+			{																																	\
+				( void ) xSemaphoreGive( ( xSemaphore ) );																						\
+			}																																	\
+		}
+#endif
+
 /**
  * semphr. h
  * <pre>xSemaphoreTake( 
@@ -633,6 +670,94 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreCreateMutex() xQueueCreateMutex( queueQUEUE_TYPE_MUTEX )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateMutexStatic( xStaticSemaphoreType *pxMutexBuffer )</pre>
+ *
+ * As xSemaphoreCreateMutex(), but the mutex is created in pxMutexBuffer, so
+ * the heap is not used.  configSUPPORT_STATIC_ALLOCATION must be set to 1 in
+ * FreeRTOSConfig.h for this macro to be available.
+ *
+ * @return Handle to the created mutex, or NULL if pxMutexBuffer is NULL.
+ *
+ * \defgroup xSemaphoreCreateMutexStatic xSemaphoreCreateMutexStatic
+ * \ingroup Semaphores
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#define xSemaphoreCreateMutexStatic( pxMutexBuffer ) xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
+#endif
+
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateCeilingMutex( unsigned portBASE_TYPE uxCeilingPriority )</pre>
+ *
+ * <i>Macro</i> that creates a mutex that uses the immediate priority ceiling
+ * protocol in place of priority inheritance.  configUSE_CEILING_MUTEXES must
+ * be set to 1 in FreeRTOSConfig.h for this macro to be available.
+ *
+ * A task that takes the mutex is raised to uxCeilingPriority as it takes it,
+ * and returns to its previous priority when it gives the mutex back.  No task
+ * that could take the mutex can run while it is held, so a task that blocks
+ * on the mutex can only be delayed by the one section of code that holds it,
+ * and the holder never has to be found and raised at the time a task blocks.
+ *
+ * uxCeilingPriority must be at least the priority of every task that takes
+ * the mutex.  Tasks that never take the mutex and have a priority above the
+ * ceiling are not delayed by it.  If a task holds more than one ceiling mutex
+ * at a time it must give them back in the reverse of the order it took them.
+ *
+ * Like the mutexes created by xSemaphoreCreateMutex(), the mutex is accessed
+ * using the xSemaphoreTake() and xSemaphoreGive() macros, must always be given
+ * back by the task that took it, and cannot be used from an interrupt.
+ *
+ * @param uxCeilingPriority The priority at which the holder of the mutex runs.
+ *
+ * @return Handle to the created mutex, or NULL if the mutex could not be
+ * created.
+ *
+ * Example usage:
+ <pre>
+ #define I2C_TASK_PRIORITY	( tskIDLE_PRIORITY + 2 )
+
+ xSemaphoreHandle xI2CMutex;
+
+ void vATask( void * pvParameters )
+ {
+    // Every task that uses the I2C bus runs at I2C_TASK_PRIORITY or below.
+    xI2CMutex = xSemaphoreCreateCeilingMutex( I2C_TASK_PRIORITY );
+
+    if( xI2CMutex != NULL )
+    {
+        // The task runs at I2C_TASK_PRIORITY from here...
+        xSemaphoreTake( xI2CMutex, portMAX_DELAY );
+
+        // ... until here.
+        xSemaphoreGive( xI2CMutex );
+    }
+ }
+ </pre>
+ * \defgroup xSemaphoreCreateCeilingMutex xSemaphoreCreateCeilingMutex
+ * \ingroup Semaphores
+ */
+#define xSemaphoreCreateCeilingMutex( uxCeilingPriority ) xQueueCreateCeilingMutex( ( uxCeilingPriority ) )
+
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateCeilingMutexStatic( unsigned portBASE_TYPE uxCeilingPriority, xStaticSemaphoreType *pxMutexBuffer )</pre>
+ *
+ * As xSemaphoreCreateCeilingMutex(), but the mutex is created in
+ * pxMutexBuffer, so the heap is not used.  configSUPPORT_STATIC_ALLOCATION
+ * must also be set to 1 in FreeRTOSConfig.h for this macro to be available.
+ *
+ * @return Handle to the created mutex, or NULL if pxMutexBuffer is NULL.
+ *
+ * \defgroup xSemaphoreCreateCeilingMutexStatic xSemaphoreCreateCeilingMutexStatic
+ * \ingroup Semaphores
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#define xSemaphoreCreateCeilingMutexStatic( uxCeilingPriority, pxMutexBuffer ) xQueueCreateCeilingMutexStatic( ( uxCeilingPriority ), ( pxMutexBuffer ) )
+#endif
+
 
 /**
  * semphr. h
@@ -688,6 +813,23 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreCreateRecursiveMutex() xQueueCreateMutex( queueQUEUE_TYPE_RECURSIVE_MUTEX )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateRecursiveMutexStatic( xStaticSemaphoreType *pxMutexBuffer )</pre>
+ *
+ * As xSemaphoreCreateRecursiveMutex(), but the mutex is created in
+ * pxMutexBuffer, so the heap is not used.  configSUPPORT_STATIC_ALLOCATION
+ * must be set to 1 in FreeRTOSConfig.h for this macro to be available.
+ *
+ * @return Handle to the created mutex, or NULL if pxMutexBuffer is NULL.
+ *
+ * \defgroup xSemaphoreCreateRecursiveMutexStatic xSemaphoreCreateRecursiveMutexStatic
+ * \ingroup Semaphores
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#define xSemaphoreCreateRecursiveMutexStatic( pxMutexBuffer ) xQueueCreateMutexStatic( queueQUEUE_TYPE_RECURSIVE_MUTEX, ( pxMutexBuffer ) )
+#endif
+
 /**
  * semphr. h
  * <pre>xSemaphoreHandle xSemaphoreCreateCounting( unsigned portBASE_TYPE uxMaxCount, unsigned portBASE_TYPE uxInitialCount )</pre>
@@ -751,6 +893,24 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreCreateCounting( uxMaxCount, uxInitialCount ) xQueueCreateCountingSemaphore( ( uxMaxCount ), ( uxInitialCount ) )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateCountingStatic( unsigned portBASE_TYPE uxMaxCount, unsigned portBASE_TYPE uxInitialCount, xStaticSemaphoreType *pxSemaphoreBuffer )</pre>
+ *
+ * As xSemaphoreCreateCounting(), but the semaphore is created in
+ * pxSemaphoreBuffer, so the heap is not used.  configSUPPORT_STATIC_ALLOCATION
+ * must be set to 1 in FreeRTOSConfig.h for this macro to be available.
+ *
+ * @return Handle to the created semaphore, or NULL if pxSemaphoreBuffer is
+ * NULL or uxMaxCount is 0.
+ *
+ * \defgroup xSemaphoreCreateCountingStatic xSemaphoreCreateCountingStatic
+ * \ingroup Semaphores
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#define xSemaphoreCreateCountingStatic( uxMaxCount, uxInitialCount, pxSemaphoreBuffer ) xQueueCreateCountingSemaphoreStatic( ( uxMaxCount ), ( uxInitialCount ), ( pxSemaphoreBuffer ) )
+#endif
+
 /**
  * semphr. h
  * <pre>void vSemaphoreDelete( xSemaphoreHandle xSemaphore );</pre>
@@ -780,6 +940,24 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreGetMutexHolder( xSemaphore ) xQueueGetMutexHolder( ( xSemaphore ) )
 
+/**
+ * semphr.h
+ * <pre>void vSemaphoreGetMutexStats( xSemaphoreHandle xMutex, xMutexStatsType *pxStats, portBASE_TYPE xReset );</pre>
+ *
+ * Reads the longest time xMutex has been held, and the longest time a task
+ * has waited to take it, into *pxStats.  If xReset is pdTRUE both are then
+ * set back to zero, so the next read covers the time since this read.
+ * configUSE_CEILING_MUTEXES must be set to 1 in FreeRTOSConfig.h for this
+ * macro to be available.  It can be used with every type of mutex, but not
+ * with other types of semaphore.
+ *
+ * The times are in the units of the run time stats counter if
+ * configGENERATE_RUN_TIME_STATS is set to 1, otherwise they are in ticks.  The
+ * times are recorded as the mutex is taken and given, so the scheduler is not
+ * suspended to read them.
+ */
+#define vSemaphoreGetMutexStats( xMutex, pxStats, xReset ) vQueueGetMutexStats( ( xQueueHandle ) ( xMutex ), ( pxStats ), ( xReset ) )
+
 #endif /* SEMAPHORE_H */
 
 
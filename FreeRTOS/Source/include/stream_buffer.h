@@ -0,0 +1,358 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include stream_buffer.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Type by which stream buffers are referenced.  For example, a call to
+ * xStreamBufferCreate() returns an xStreamBufferHandle variable that can then
+ * be used as a parameter to xStreamBufferSend(), xStreamBufferReceive(), etc.
+ */
+typedef void * xStreamBufferHandle;
+
+/* Passed to xStreamBufferSetTerminator() to stop a terminating character
+from unblocking the reading task. */
+#define sbNO_TERMINATOR		( ( portBASE_TYPE ) -1 )
+
+/**
+ * stream_buffer.h
+ * <pre>
+ xStreamBufferHandle xStreamBufferCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+ </pre>
+ *
+ * Creates a new stream buffer.  A stream buffer passes a continuous stream of
+ * bytes from a single writer to a single reader, for example from an
+ * interrupt service routine to a task.  Unlike a queue, bytes are not
+ * written or read one item at a time, and neither writing nor reading
+ * uses a critical section unless a task has to be unblocked.
+ *
+ * Stream buffers assume there is only one writer and only one reader.  It
+ * is safe for the writer and the reader to be different tasks or interrupts,
+ * but not for multiple tasks or interrupts to write to, or read from, the
+ * same stream buffer.  A task blocked on a stream buffer is unblocked using
+ * a task notification, so configUSE_TASK_NOTIFICATIONS must be 1.
+ *
+ * @param xBufferSizeBytes The total number of bytes the stream buffer will be
+ * able to hold at any one time.
+ *
+ * @param xTriggerLevelBytes The number of bytes that must be in the stream
+ * buffer before a task that is blocked waiting for data is unblocked.  A
+ * trigger level of 1 unblocks the task as soon as any data arrives.  A larger
+ * trigger level lets the reader process the data in blocks instead of
+ * waking for every byte.  See also xStreamBufferSetTerminator().
+ *
+ * @return If the stream buffer is created successfully then a handle to the
+ * created stream buffer is returned.  If there was not enough heap memory
+ * available to create the stream buffer then NULL is returned.
+ *
+ * \defgroup xStreamBufferCreate xStreamBufferCreate
+ * \ingroup StreamBufferManagement
+ */
+#define xStreamBufferCreate( xBufferSizeBytes, xTriggerLevelBytes ) xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), pdFALSE )
+
+/**
+ * stream_buffer.h
+ * <pre>
+ size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portTickType xTicksToWait );
+ </pre>
+ *
+ * Sends bytes to a stream buffer from a task.  Use xStreamBufferSendFromISR()
+ * to write to a stream buffer from an interrupt service routine.
+ *
+ * If there is not enough space for all the bytes the task writes as many as
+ * will fit, then blocks for up to xTicksToWait ticks for the reader to make
+ * space for the remainder.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to which a stream is
+ * being sent.
+ *
+ * @param pvTxData A pointer to the buffer that holds the bytes to be copied
+ * into the stream buffer.
+ *
+ * @param xDataLengthBytes The maximum number of bytes to copy from pvTxData
+ * into the stream buffer.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in
+ * the Blocked state to wait for space to become available.
+ *
+ * @return The number of bytes written to the stream buffer.  This is less
+ * than xDataLengthBytes if the call timed out before all the bytes could be
+ * written.
+ *
+ * \defgroup xStreamBufferSend xStreamBufferSend
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portBASE_TYPE *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * Interrupt safe version of xStreamBufferSend().  Never blocks.  Writing
+ * all the bytes received by one interrupt with a single call is more
+ * efficient than writing them one at a time.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to which a stream is
+ * being sent.
+ *
+ * @param pvTxData A pointer to the data that is to be copied into the stream
+ * buffer.
+ *
+ * @param xDataLengthBytes The maximum number of bytes to copy from pvTxData
+ * into the stream buffer.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if writing the data unblocked
+ * a task that has a priority above the priority of the currently running
+ * task, in which case a context switch should be requested before the
+ * interrupt is exited.
+ *
+ * @return The number of bytes actually written to the stream buffer, which
+ * will be less than xDataLengthBytes if the stream buffer did not have
+ * enough free space for all the bytes to be written.
+ *
+ * \defgroup xStreamBufferSendFromISR xStreamBufferSendFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portTickType xTicksToWait );
+ </pre>
+ *
+ * Receives bytes from a stream buffer.  Use xStreamBufferReceiveFromISR() to
+ * read from a stream buffer from an interrupt service routine.
+ *
+ * If the stream buffer is empty the task will block for up to xTicksToWait
+ * ticks.  It is unblocked when the number of bytes in the stream buffer
+ * reaches the trigger level, or when the terminating character set by
+ * xStreamBufferSetTerminator() is written, whichever happens first.  If the
+ * stream buffer already contains data the call returns immediately, even
+ * if there are fewer bytes than the trigger level.
+ *
+ * @param xStreamBuffer The handle of the stream buffer from which bytes are to
+ * be received.
+ *
+ * @param pvRxData A pointer to the buffer into which the received bytes will
+ * be copied.
+ *
+ * @param xBufferLengthBytes The length of the buffer pointed to by pvRxData.
+ * This sets the maximum number of bytes to receive in one call.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in
+ * the Blocked state to wait for data to become available.
+ *
+ * @return The number of bytes actually read from the stream buffer, which
+ * will be less than xBufferLengthBytes if the call to xStreamBufferReceive()
+ * timed out before xBufferLengthBytes were available.
+ *
+ * \defgroup xStreamBufferReceive xStreamBufferReceive
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portBASE_TYPE *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * An interrupt safe version of xStreamBufferReceive(), for example for use by
+ * a transmit interrupt that takes bytes written by a task.  Never blocks.
+ *
+ * @param xStreamBuffer The handle of the stream buffer from which a stream
+ * is being received.
+ *
+ * @param pvRxData A pointer to the buffer into which the received bytes are
+ * copied.
+ *
+ * @param xBufferLengthBytes The length of the buffer pointed to by pvRxData.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if reading the data made
+ * space for a task that was blocked waiting to write, and that task has a
+ * priority above the priority of the currently running task.
+ *
+ * @return The number of bytes read from the stream buffer, if any.
+ *
+ * \defgroup xStreamBufferReceiveFromISR xStreamBufferReceiveFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ void vStreamBufferDelete( xStreamBufferHandle xStreamBuffer );
+ </pre>
+ *
+ * Deletes a stream buffer that was previously created using a call to
+ * xStreamBufferCreate().  A task must not be blocked on the stream buffer
+ * when it is deleted.
+ *
+ * \defgroup vStreamBufferDelete vStreamBufferDelete
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferDelete( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ portBASE_TYPE xStreamBufferReset( xStreamBufferHandle xStreamBuffer );
+ </pre>
+ *
+ * Discards the contents of a stream buffer.  A stream buffer can only be
+ * reset if there are no tasks blocked waiting to either send to or receive
+ * from the stream buffer.
+ *
+ * @return pdPASS if the stream buffer was reset, otherwise pdFAIL.
+ *
+ * \defgroup xStreamBufferReset xStreamBufferReset
+ * \ingroup StreamBufferManagement
+ */
+portBASE_TYPE xStreamBufferReset( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ size_t xStreamBufferBytesAvailable( xStreamBufferHandle xStreamBuffer );
+ size_t xStreamBufferSpacesAvailable( xStreamBufferHandle xStreamBuffer );
+ </pre>
+ *
+ * Query the number of bytes that can be read from, and the number of bytes
+ * that can be written to, a stream buffer.  Can be called from tasks and
+ * interrupts.
+ *
+ * \defgroup xStreamBufferBytesAvailable xStreamBufferBytesAvailable
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferBytesAvailable( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferSpacesAvailable( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ portBASE_TYPE xStreamBufferSetTriggerLevel( xStreamBufferHandle xStreamBuffer, size_t xTriggerLevel );
+ </pre>
+ *
+ * Changes the trigger level set when the stream buffer was created.
+ *
+ * @return pdPASS if the trigger level was changed, or pdFAIL if
+ * xTriggerLevel is larger than the stream buffer.  A trigger level of 0 is
+ * treated as a trigger level of 1.
+ *
+ * \defgroup xStreamBufferSetTriggerLevel xStreamBufferSetTriggerLevel
+ * \ingroup StreamBufferManagement
+ */
+portBASE_TYPE xStreamBufferSetTriggerLevel( xStreamBufferHandle xStreamBuffer, size_t xTriggerLevel ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ void vStreamBufferSetTerminator( xStreamBufferHandle xStreamBuffer, portBASE_TYPE xTerminator );
+ </pre>
+ *
+ * Sets a byte value that unblocks a reading task as soon as it is written,
+ * even if the number of bytes in the stream buffer is below the trigger
+ * level.  This allows a task that processes a line at a time, such as a
+ * command line interpreter, to use a large trigger level without lines
+ * being delayed.
+ *
+ * @param xTerminator The terminating byte value, 0 to 255, or
+ * sbNO_TERMINATOR to disable the terminator (the default).
+ *
+ * \defgroup vStreamBufferSetTerminator vStreamBufferSetTerminator
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferSetTerminator( xStreamBufferHandle xStreamBuffer, portBASE_TYPE xTerminator ) PRIVILEGED_FUNCTION;
+
+/*
+ * Generic version of the stream buffer creation function, which is in turn
+ * called by the xStreamBufferCreate() and xMessageBufferCreate() macros.
+ */
+xStreamBufferHandle xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, portBASE_TYPE xIsMessageBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Use xMessageBufferNextLengthBytes() instead.
+ */
+size_t xStreamBufferNextMessageLengthBytes( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !defined( STREAM_BUFFER_H ) */
+
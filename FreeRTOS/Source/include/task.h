@@ -137,6 +137,10 @@ typedef struct xTASK_PARAMTERS
 	xMemoryRegion xRegions[ portNUM_CONFIGURABLE_REGIONS ];
 } xTaskParameters;
 
+/* The number of windows over which the processor load of each task is
+averaged when configUSE_CPU_LOAD is set to 1. */
+#define tskCPU_LOAD_WINDOWS			3
+
 /* Used with the uxTaskGetSystemState() function to return the state of each task
 in the system. */
 typedef struct xTASK_STATUS
@@ -147,10 +151,126 @@ typedef struct xTASK_STATUS
 	eTaskState eCurrentState;					/* The state in which the task existed when the structure was populated. */
 	unsigned portBASE_TYPE uxCurrentPriority;	/* The priority at which the task was running (may be inherited) when the structure was populated. */
 	unsigned portBASE_TYPE uxBasePriority;		/* The priority to which the task will return if the task's current priority has been inherited to avoid unbounded priority inversion when obtaining a mutex.  Only valid if configUSE_MUTEXES is defined as 1 in FreeRTOSConfig.h. */
-	unsigned long ulRunTimeCounter;				/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
+	configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;	/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
+	unsigned long ulLongestRunTime;				/* The longest time, as defined by the run time stats clock, for which the task has run without another task running, including the current run of the running task.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
+	unsigned short usCPULoad[ tskCPU_LOAD_WINDOWS ];	/* The task's share of the processor in tenths of a percent, averaged over about 1, 10 and 60 seconds.  Only valid when configUSE_CPU_LOAD is defined as 1 in FreeRTOSConfig.h. */
 	unsigned short usStackHighWaterMark;		/* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } xTaskStatusType;
 
+/* Used with the uxTaskGetSnapshot() function to return the counters of each
+task in the system without suspending the scheduler. */
+typedef struct xTASK_SNAPSHOT
+{
+	xTaskHandle xHandle;								/* The handle of the task to which the rest of the information in the structure relates. */
+	signed char pcTaskName[ configMAX_TASK_NAME_LEN ];	/* A copy of the task's name, so it remains valid if the task is deleted. */
+	unsigned portBASE_TYPE uxCurrentPriority;			/* The priority at which the task was running (may be inherited) when the snapshot was taken. */
+	unsigned portBASE_TYPE uxBasePriority;				/* The priority to which the task will return when it disinherits a priority.  Equal to uxCurrentPriority if configUSE_MUTEXES is not defined as 1 in FreeRTOSConfig.h. */
+	configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;		/* The total run time allocated to the task up to the last time it was switched out.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
+	unsigned long ulLongestRunTime;						/* As the ulLongestRunTime member of xTaskStatusType. */
+	unsigned portBASE_TYPE xTaskNumber;					/* As the xTaskNumber member of xTaskStatusType.  Only valid when configUSE_TRACE_FACILITY is defined as 1 in FreeRTOSConfig.h. */
+	unsigned short usStackHighWaterMark;				/* The stack high water mark when it was last measured by the idle task, which measures one task each time around its loop.  Only valid when configUSE_TRACE_FACILITY or INCLUDE_uxTaskGetStackHighWaterMark is defined as 1 in FreeRTOSConfig.h. */
+} xTaskSnapshotType;
+
+/* The first byte of every frame written by xTaskGetStatsStream(), and the
+types of frame.  See xTaskGetStatsStream() for the layout of each frame. */
+#define tskSTATS_FRAME_SYNC			( ( unsigned char ) 0xA5 )
+#define tskSTATS_FRAME_REPORT		( ( unsigned char ) 0x01 )
+#define tskSTATS_FRAME_TASK			( ( unsigned char ) 0x02 )
+#define tskSTATS_FRAME_NAME			( ( unsigned char ) 0x03 )
+
+/* The bytes of a frame that are not payload - the sync byte, the type, the
+payload length and the checksum - and the payload length of each type of
+frame.  A name frame is no longer than tskSTATS_NAME_PAYLOAD. */
+#define tskSTATS_FRAME_OVERHEAD		( 4U )
+#define tskSTATS_REPORT_PAYLOAD		( 7U )
+#define tskSTATS_TASK_PAYLOAD		( 10U )
+#define tskSTATS_NAME_PAYLOAD		( 2U + ( unsigned ) configMAX_TASK_NAME_LEN )
+
+/* The length of the frame that starts at pucFrame. */
+#define tskSTATS_FRAME_SIZE( pucFrame ) ( ( size_t ) ( pucFrame )[ 2 ] + ( size_t ) tskSTATS_FRAME_OVERHEAD )
+
+/* A buffer of this many bytes holds a report on uxTasks tasks, whichever task
+names it contains. */
+#define tskSTATS_STREAM_BUFFER_SIZE( uxTasks ) ( ( size_t ) ( tskSTATS_FRAME_OVERHEAD + tskSTATS_REPORT_PAYLOAD ) + ( ( size_t ) ( uxTasks ) * ( size_t ) ( ( 2U * tskSTATS_FRAME_OVERHEAD ) + tskSTATS_TASK_PAYLOAD + tskSTATS_NAME_PAYLOAD ) ) )
+
+/* Used with the xTaskGetStatsStream() function to hold what was reported last
+time, so the next report need only contain what has changed.  Set every member
+to zero before the first report. */
+typedef struct xTASK_STATS_STREAM
+{
+	unsigned short usSequence;									/* The sequence number of the next report, so the host can tell when a report has been lost. */
+	portBASE_TYPE xResendNames;									/* Set to pdTRUE to send the name of every task in the next report, for example when a host connects.  Otherwise a name is only sent for a task that was not in the previous report. */
+	configRUN_TIME_COUNTER_TYPE ulTotalRunTime;					/* The total run time at the previous report. */
+	unsigned portBASE_TYPE uxTasks;								/* The number of tasks held in the following arrays. */
+	unsigned portBASE_TYPE uxTaskNumber[ configSTATS_STREAM_TASKS ];	/* The xTaskNumber of each task in the previous report. */
+	configRUN_TIME_COUNTER_TYPE ulRunTime[ configSTATS_STREAM_TASKS ];	/* The run time of each task at the previous report. */
+} xTaskStatsStreamType;
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/*
+	 * Memory in which xTaskCreateStatic() creates a task.  The task control
+	 * block is private to tasks.c, so this structure only has the same size
+	 * and alignment.  Its members must not be accessed, and it must be
+	 * updated whenever a member is added to the task control block.
+	 */
+	typedef struct xSTATIC_TCB
+	{
+		void *pvDummy1;
+		#if ( portUSING_MPU_WRAPPERS == 1 )
+			xMPU_SETTINGS xDummy2;
+		#endif
+		xListItem xDummy3[ 2 ];
+		unsigned portBASE_TYPE uxDummy4;
+		void *pvDummy5;
+		signed char ucDummy6[ configMAX_TASK_NAME_LEN ];
+		#if ( portSTACK_GROWTH > 0 )
+			void *pvDummy7;
+		#endif
+		#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+			unsigned portBASE_TYPE uxDummy8;
+		#endif
+		#if ( configUSE_TRACE_FACILITY == 1 )
+			unsigned portBASE_TYPE uxDummy9[ 2 ];
+		#endif
+		#if ( configUSE_MUTEXES == 1 )
+			unsigned portBASE_TYPE uxDummy10;
+		#endif
+		#if ( configUSE_CEILING_MUTEXES == 1 )
+			unsigned portBASE_TYPE uxDummy10a;
+		#endif
+		#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+			void *pvDummy11;
+		#endif
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+			configRUN_TIME_COUNTER_TYPE xDummy12a;
+			unsigned long ulDummy12b;
+		#endif
+		#if ( configUSE_CPU_LOAD == 1 )
+			unsigned long ulDummy12c[ 2 + tskCPU_LOAD_WINDOWS ];
+		#endif
+		#if ( configUSE_TASK_SNAPSHOT == 1 )
+			void *pvDummy13;
+		#endif
+		#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+			unsigned long ulDummy14;
+			unsigned char ucDummy15;
+		#endif
+		#if ( configUSE_EDF_SCHEDULING == 1 )
+			portTickType xDummy16[ 4 ];
+			unsigned portBASE_TYPE uxDummy17;
+		#endif
+		#if ( configUSE_NEWLIB_REENTRANT == 1 )
+			struct _reent xDummy18;
+		#endif
+		#if ( configUSE_TASK_POOL == 1 )
+			unsigned short usDummy18a;
+		#endif
+		unsigned char ucDummy19;
+	} xStaticTaskType;
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -159,6 +279,16 @@ typedef enum
 	eNoTasksWaitingTimeout	/* No tasks are waiting for a timeout so it is safe to enter a sleep mode that can only be exited by an external interrupt. */
 } eSleepModeStatus;
 
+/* Actions that can be performed when xTaskNotify() is called. */
+typedef enum
+{
+	eNoAction = 0,				/* Notify the task without updating its notification value. */
+	eSetBits,					/* Set bits in the task's notification value. */
+	eIncrement,					/* Increment the task's notification value. */
+	eSetValueWithOverwrite,		/* Set the task's notification value to a specific value even if the previous value has not yet been read by the task. */
+	eSetValueWithoutOverwrite	/* Set the task's notification value if the previous value has been read by the task. */
+} eNotifyAction;
+
 
 /*
  * Defines the priority used by the idle task.  This must not be modified.
@@ -381,6 +511,56 @@ xTaskHandle xHandle;
  */
 #define xTaskCreateRestricted( x, pxCreatedTask ) xTaskGenericCreate( ((x)->pvTaskCode), ((x)->pcName), ((x)->usStackDepth), ((x)->pvParameters), ((x)->uxPriority), (pxCreatedTask), ((x)->puxStackBuffer), ((x)->xRegions) )
 
+/**
+ * task. h
+ *<pre>
+ portBASE_TYPE xTaskCreateStatic(
+							  pdTASK_CODE pvTaskCode,
+							  const char * const pcName,
+							  unsigned short usStackDepth,
+							  void *pvParameters,
+							  unsigned portBASE_TYPE uxPriority,
+							  xTaskHandle *pvCreatedTask,
+							  portSTACK_TYPE * const puxStackBuffer,
+							  xStaticTaskType * const pxTaskBuffer
+						  );</pre>
+ *
+ * As xTaskCreate(), but the task control block and the stack are placed in
+ * memory provided by the application, so the heap is not used.  The memory
+ * must remain valid until the task has been deleted and the idle task has run.
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * @param puxStackBuffer An array of at least usStackDepth portSTACK_TYPE
+ * variables, to be used as the stack of the task.
+ *
+ * @param pxTaskBuffer The memory in which the task control block is created.
+ *
+ * @return pdPASS if the task was created and added to a ready list, otherwise
+ * an error code defined in the file projdefs.h.
+ *
+ * Example usage:
+   <pre>
+ #define STACK_SIZE 200
+
+ static xStaticTaskType xTaskBuffer;
+ static portSTACK_TYPE xStack[ STACK_SIZE ];
+
+ void vOtherFunction( void )
+ {
+ xTaskHandle xHandle;
+
+	 // Create the task without using the heap.
+	 xTaskCreateStatic( vTaskCode, "NAME", STACK_SIZE, NULL, tskIDLE_PRIORITY, &xHandle, xStack, &xTaskBuffer );
+ }
+   </pre>
+ * \defgroup xTaskCreateStatic xTaskCreateStatic
+ * \ingroup Tasks
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	signed portBASE_TYPE xTaskCreateStatic( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE * const puxStackBuffer, xStaticTaskType * const pxTaskBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  *<pre>
@@ -583,6 +763,99 @@ void vTaskDelay( portTickType xTicksToDelay ) PRIVILEGED_FUNCTION;
  */
 void vTaskDelayUntil( portTickType * const pxPreviousWakeTime, portTickType xTimeIncrement ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>void vTaskSetPeriodicDeadline( xTaskHandle xTask, portTickType xPeriod, portTickType xRelativeDeadline );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Make xTask a periodic task that is scheduled earliest deadline first.  The
+ * task must have been created at configEDF_PRIORITY.  Its first job is
+ * released now, and each later job is released xPeriod ticks after the one
+ * before it.  Each job must complete, by calling vTaskWaitForNextPeriod(),
+ * within xRelativeDeadline ticks of its release.
+ *
+ * Of the tasks that are ready to run at configEDF_PRIORITY, the task whose
+ * current job has the earliest deadline is always the one that runs.  Tasks
+ * at configEDF_PRIORITY that have not been given a deadline only run when no
+ * task that has been given a deadline is ready, and share the processor time
+ * between them as normal.  Tasks at higher priorities always preempt tasks at
+ * configEDF_PRIORITY.
+ *
+ * @param xTask Handle of the task.  Passing a NULL handle sets the deadline
+ * of the calling task.
+ *
+ * @param xPeriod The time, in ticks, between the releases of each job.
+ *
+ * @param xRelativeDeadline The time, in ticks, from the release of a job to
+ * its deadline.  This is normally equal to xPeriod.
+ *
+ * Example usage:
+   <pre>
+ void vStepTask( void * pvParameters )
+ {
+	 // Run every 4 ticks, completing each step within 2 ticks.
+	 vTaskSetPeriodicDeadline( NULL, 4, 2 );
+
+	 for( ;; )
+	 {
+		 // Perform the step here.
+
+		 // Wait for the next period.
+		 vTaskWaitForNextPeriod();
+	 }
+ }
+   </pre>
+ * \defgroup vTaskSetPeriodicDeadline vTaskSetPeriodicDeadline
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+	void vTaskSetPeriodicDeadline( xTaskHandle xTask, portTickType xPeriod, portTickType xRelativeDeadline ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>void vTaskWaitForNextPeriod( void );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Called by a task that has been given a deadline by
+ * vTaskSetPeriodicDeadline() to mark the end of its current job.  If the job
+ * has completed after its deadline the task's deadline miss count is
+ * incremented.  The task then blocks until its next job is released.  If the
+ * next job has already been released, because the job that has just
+ * completed overran, the task continues immediately with the deadline of the
+ * next job.
+ *
+ * \defgroup vTaskWaitForNextPeriod vTaskWaitForNextPeriod
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+	void vTaskWaitForNextPeriod( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>unsigned portBASE_TYPE uxTaskGetDeadlineMisses( xTaskHandle xTask );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xTask Handle of the task to be queried.  Passing a NULL handle
+ * results in the count of the calling task being returned.
+ *
+ * @return The number of jobs of xTask that have completed after their
+ * deadline since vTaskSetPeriodicDeadline() was last called for the task.
+ *
+ * \defgroup uxTaskGetDeadlineMisses uxTaskGetDeadlineMisses
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+	unsigned portBASE_TYPE uxTaskGetDeadlineMisses( xTaskHandle xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * <pre>unsigned portBASE_TYPE uxTaskPriorityGet( xTaskHandle xTask );</pre>
@@ -1153,6 +1426,13 @@ xTaskHandle xTaskGetIdleTaskHandle( void );
  * of run time consumed by the task.  See the xTaskStatusType structure
  * definition in this file for the full member list.
  *
+ * If configUSE_CPU_LOAD is set to 1 in FreeRTOSConfig.h the kernel also keeps
+ * an exponentially decayed average of the run time of each task, and of all
+ * tasks, over windows of about 1, 10 and 60 seconds, updated every 100ms.  The
+ * usCPULoad member reports the share of the processor each task used within
+ * each window, so a task that is using the processor now can be told apart
+ * from one that used it in the past.
+ *
  * NOTE:  This function is intended for debugging use only as its use results in
  * the scheduler remaining suspended for an extended period.
  *
@@ -1186,7 +1466,7 @@ xTaskHandle xTaskGetIdleTaskHandle( void );
 	{
 	xTaskStatusType *pxTaskStatusArray;
 	volatile unsigned portBASE_TYPE uxArraySize, x;
-	unsigned long ulTotalRunTime, ulStatsAsPercentage;
+	configRUN_TIME_COUNTER_TYPE ulTotalRunTime, ulStatsAsPercentage;
 
 		// Make sure the write buffer does not contain a string.
 		*pcWriteBuffer = 0x00;
@@ -1240,7 +1520,48 @@ xTaskHandle xTaskGetIdleTaskHandle( void );
 	}
 	</pre>
  */
-unsigned portBASE_TYPE uxTaskGetSystemState( xTaskStatusType *pxTaskStatusArray, unsigned portBASE_TYPE uxArraySize, unsigned long *pulTotalRunTime );
+unsigned portBASE_TYPE uxTaskGetSystemState( xTaskStatusType *pxTaskStatusArray, unsigned portBASE_TYPE uxArraySize, configRUN_TIME_COUNTER_TYPE *pulTotalRunTime );
+
+/**
+ * task. h
+ * <PRE>unsigned portBASE_TYPE uxTaskGetSnapshot( xTaskSnapshotType *pxSnapshotArray, unsigned portBASE_TYPE uxArraySize, configRUN_TIME_COUNTER_TYPE *pulTotalRunTime );</PRE>
+ *
+ * configUSE_TASK_SNAPSHOT must be defined as 1 in FreeRTOSConfig.h for
+ * uxTaskGetSnapshot() to be available.
+ *
+ * uxTaskGetSnapshot() populates an xTaskSnapshotType structure for each task
+ * in the system, as uxTaskGetSystemState() does, but without suspending the
+ * scheduler or disabling interrupts.  The kernel keeps a table of
+ * configTASK_SNAPSHOT_SLOTS entries that it updates as each task is created,
+ * deleted, changes priority and is switched out.  Each entry carries a sequence
+ * number that changes whenever the entry is written, and uxTaskGetSnapshot()
+ * copies an entry again if its sequence number changed during the copy, so
+ * the members of each structure are consistent with each other.  Tasks
+ * created while every entry was in use are not reported.
+ *
+ * The task state is not reported, as maintaining it would add to every list
+ * operation.  The stack high water mark is measured by the idle task, so it
+ * is only as recent as the last time the idle task reached the task.  Use
+ * uxTaskGetSystemState() if either must be current.
+ *
+ * @param pxSnapshotArray A pointer to an array of xTaskSnapshotType
+ * structures.  An array of configTASK_SNAPSHOT_SLOTS structures is always
+ * large enough.
+ *
+ * @param uxArraySize The number of xTaskSnapshotType structures in the
+ * array.
+ *
+ * @param pulTotalRunTime If configGENERATE_RUN_TIME_STATS is set to 1 in
+ * FreeRTOSConfig.h then *pulTotalRunTime is set to the total run time, as
+ * defined by the run time stats clock, read after the array is populated.
+ * pulTotalRunTime can be set to NULL to omit the total run time information.
+ *
+ * @return The number of xTaskSnapshotType structures that were populated.
+ *
+ * \defgroup uxTaskGetSnapshot uxTaskGetSnapshot
+ * \ingroup TaskUtils
+ */
+unsigned portBASE_TYPE uxTaskGetSnapshot( xTaskSnapshotType *pxSnapshotArray, unsigned portBASE_TYPE uxArraySize, configRUN_TIME_COUNTER_TYPE *pulTotalRunTime );
 
 /**
  * task. h
@@ -1301,8 +1622,10 @@ void vTaskList( signed char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
  * value respectively.  The counter should be at least 10 times the frequency of
  * the tick count.
  *
- * NOTE 1: This function will disable interrupts for its duration.  It is
- * not intended for normal application runtime use but as a debug aid.
+ * NOTE 1: This function will disable interrupts for its duration, unless
+ * configUSE_TASK_SNAPSHOT is defined as 1, in which case it reads the table
+ * maintained for uxTaskGetSnapshot() instead.  It is not intended for normal
+ * application runtime use but as a debug aid.
  *
  * Setting configGENERATE_RUN_TIME_STATS to 1 will result in a total
  * accumulated execution time being stored for each task.  The resolution
@@ -1310,7 +1633,9 @@ void vTaskList( signed char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
  * configured by the portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() macro.
  * Calling vTaskGetRunTimeStats() writes the total execution time of each
  * task into a buffer, both as an absolute count value and as a percentage
- * of the total system execution time.
+ * of the total system execution time.  The absolute value is written as an
+ * unsigned long, so only its low bits are written if configRUN_TIME_COUNTER_TYPE
+ * is wider, but the percentage is calculated from the full value.
  *
  * NOTE 2:
  *
@@ -1343,6 +1668,317 @@ void vTaskList( signed char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
  */
 void vTaskGetRunTimeStats( signed char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <PRE>size_t xTaskGetStatsStream( xTaskStatsStreamType *pxStream, unsigned char *pucBuffer, size_t xBufferSize );</PRE>
+ *
+ * configUSE_TRACE_FACILITY and configUSE_STATS_STREAM must both be defined as
+ * 1 for this function to be available.
+ *
+ * Writes a report on the state of each task as a sequence of binary frames,
+ * for a host to decode and format.  The report holds what vTaskList() and
+ * vTaskGetRunTimeStats() would write between them, in less than half the
+ * bytes once the task names have been sent, and without calling sprintf().
+ * The run time reported for each task is the run time it has used since the
+ * previous report written through the same pxStream, so no percentage needs
+ * to be calculated on the target.
+ *
+ * Every frame has the layout:
+ *
+ *   tskSTATS_FRAME_SYNC, type, payload length, payload..., checksum
+ *
+ * The checksum is chosen so the sum of the type, length, payload and checksum
+ * bytes is zero modulo 256.  A host that loses its place skips bytes until it
+ * finds a sync byte that starts a frame with a correct checksum, so bytes
+ * added between frames by a line based transport are ignored.  Fields wider
+ * than one byte are sent least significant byte first.  The payloads are:
+ *
+ *   tskSTATS_FRAME_REPORT - the report sequence number (2 bytes), the number
+ *   of task frames that follow (1 byte), and the total run time since the
+ *   previous report (4 bytes).
+ *
+ *   tskSTATS_FRAME_NAME - the task number (2 bytes), then the task name
+ *   without its terminating null.  Sent before the task frame of a task that
+ *   was not in the previous report, or of every task if pxStream->xResendNames
+ *   is pdTRUE.
+ *
+ *   tskSTATS_FRAME_TASK - the task number (2 bytes), its eTaskState (1 byte),
+ *   its priority (1 byte), its stack high water mark in words (2 bytes), and
+ *   the run time it has used since the previous report (4 bytes).
+ *
+ * The task that calls xTaskGetStatsStream() is reported as eRunning.  Run
+ * times that do not fit in 4 bytes are sent as 0xffffffff.  If more than
+ * configSTATS_STREAM_TASKS tasks exist, the tasks that do not fit in pxStream
+ * are reported each time as if they were new, with their name and their total
+ * run time.  A report holds at most 255 tasks.
+ *
+ * NOTE: If configUSE_TASK_SNAPSHOT is 1 the report is built from the task
+ * snapshot, so the scheduler is not suspended.  The state of each task is then
+ * read in a short critical section of its own, and the stack high water marks
+ * are those last measured by the idle task (see uxTaskGetSnapshot()).
+ * Otherwise the scheduler is suspended while the task states are collected,
+ * as uxTaskGetSystemState() does.  It must only be called by one task for
+ * each pxStream.
+ *
+ * @param pxStream Holds what was reported last time.  Set every member to zero
+ * before the first report.
+ *
+ * @param pucBuffer The buffer into which the frames are written.
+ *
+ * @param xBufferSize The size of pucBuffer in bytes.  Nothing is written
+ * unless this is at least tskSTATS_STREAM_BUFFER_SIZE() of the number of
+ * tasks.
+ *
+ * @return The number of bytes written, or zero if pucBuffer was too small or
+ * there was not enough heap to collect the task states.
+ *
+ * Example usage:
+   <pre>
+	static xTaskStatsStreamType xStream;
+	static unsigned char ucReport[ tskSTATS_STREAM_BUFFER_SIZE( 8 ) ];
+
+	void vSendStats( void )
+	{
+	size_t xLength, xOffset;
+
+		xLength = xTaskGetStatsStream( &xStream, ucReport, sizeof( ucReport ) );
+
+		// Send one frame at a time, so each frame is written to the UART in
+		// one piece.
+		for( xOffset = 0; xOffset < xLength; xOffset += tskSTATS_FRAME_SIZE( &( ucReport[ xOffset ] ) ) )
+		{
+			vSendBytes( &( ucReport[ xOffset ] ), tskSTATS_FRAME_SIZE( &( ucReport[ xOffset ] ) ) );
+		}
+	}
+   </pre>
+ *
+ * \defgroup xTaskGetStatsStream xTaskGetStatsStream
+ * \ingroup TaskUtils
+ */
+size_t xTaskGetStatsStream( xTaskStatsStreamType *pxStream, unsigned char *pucBuffer, size_t xBufferSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction );</PRE>
+ *
+ * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
+ * function to be available.
+ *
+ * Each task has a 32-bit notification value that is initialised to zero when
+ * the task is created.  A task notification is an event sent directly to a
+ * task that can unblock the receiving task, and optionally update the
+ * receiving task's notification value.  Sending a notification does not
+ * require a queue, semaphore or event group to be created first, and no data
+ * is copied through a queue storage area, so notifying a task is both faster
+ * and uses less RAM than giving a binary semaphore or writing to a queue that
+ * holds a single item.
+ *
+ * A task can use xTaskNotifyWait() to [optionally] block to wait for a
+ * notification to be pending, or ulTaskNotifyTake() to [optionally] block
+ * to wait for its notification value to have a non-zero value.  The task
+ * does not consume any CPU time while it is in the Blocked state.
+ *
+ * A notification sent to a task will remain pending until it is cleared by
+ * the task calling xTaskNotifyWait() or ulTaskNotifyTake().  If the task was
+ * already in the Blocked state to wait for a notification when the
+ * notification arrives then the task will automatically be removed from the
+ * Blocked state (unblocked) and the notification cleared.
+ *
+ * Only one notification can be pending at a time, so a task notification
+ * can only be used when there is exactly one task that receives the event.
+ *
+ * @param xTaskToNotify The handle of the task being notified.
+ *
+ * @param ulValue Data that can be sent with the notification.  How the data
+ * is used depends on the value of the eAction parameter.
+ *
+ * @param eAction Specifies how the notification updates the task's
+ * notification value, if at all.  Valid values for eAction are as follows:
+ *
+ * eSetBits -
+ * The task's notification value is bitwise ORed with ulValue.  xTaskNotify()
+ * always returns pdPASS in this case.
+ *
+ * eIncrement -
+ * The task's notification value is incremented.  ulValue is not used and
+ * xTaskNotify() always returns pdPASS in this case.
+ *
+ * eSetValueWithOverwrite -
+ * The task's notification value is set to the value of ulValue, even if the
+ * task being notified had not yet processed the previous notification.
+ * xTaskNotify() always returns pdPASS in this case.
+ *
+ * eSetValueWithoutOverwrite -
+ * If the task being notified did not already have a notification pending then
+ * the task's notification value is set to ulValue and xTaskNotify() will
+ * return pdPASS.  If the task being notified already had a notification
+ * pending then no action is performed and pdFAIL is returned.
+ *
+ * eNoAction -
+ * The task receives a notification without its notification value being
+ * updated.  ulValue is not used and xTaskNotify() always returns pdPASS in
+ * this case.
+ *
+ * @return Dependent on the value of eAction.  See the description of the
+ * eAction parameter.
+ *
+ * \defgroup xTaskNotify xTaskNotify
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * A version of xTaskNotify() that can be used from an interrupt service
+ * routine (ISR).
+ *
+ * @param xTaskToNotify The handle of the task being notified.
+ *
+ * @param ulValue Data that can be sent with the notification.
+ *
+ * @param eAction Specifies how the notification updates the task's
+ * notification value, if at all.  See xTaskNotify().
+ *
+ * @param pxHigherPriorityTaskWoken xTaskNotifyFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if sending the notification caused the
+ * task to which the notification was sent to leave the Blocked state, and the
+ * unblocked task has a priority higher than the currently running task.  If
+ * xTaskNotifyFromISR() sets this value to pdTRUE then a context switch should
+ * be requested before the interrupt is exited.
+ *
+ * @return Dependent on the value of eAction.  See xTaskNotify().
+ *
+ * \defgroup xTaskNotifyFromISR xTaskNotifyFromISR
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait );</PRE>
+ *
+ * Waits, with an optional timeout, for the calling task to receive a
+ * notification.  If a notification is already pending when
+ * xTaskNotifyWait() is called then the function returns immediately.
+ *
+ * @param ulBitsToClearOnEntry Bits that are set in ulBitsToClearOnEntry will
+ * be cleared in the calling task's notification value before the task checks
+ * to see if any notifications are pending, and only if no notifications are
+ * pending.  Setting ulBitsToClearOnEntry to ULONG_MAX (0xffffffffUL) clears
+ * the notification value to 0.
+ *
+ * @param ulBitsToClearOnExit If a notification is pending or received before
+ * the calling task exits xTaskNotifyWait() then the task's notification value
+ * (see xTaskNotify()) is passed out using pulNotificationValue, then any bits
+ * set in ulBitsToClearOnExit are cleared in the task's notification value.
+ *
+ * @param pulNotificationValue Used to pass out the task's notification value
+ * before any bits are cleared due to ulBitsToClearOnExit.  Set to NULL if the
+ * value is not required.
+ *
+ * @param xTicksToWait The maximum amount of time that the task should wait in
+ * the Blocked state for a notification to be received.  Setting xTicksToWait
+ * to portMAX_DELAY will cause the task to wait indefinitely, provided
+ * INCLUDE_vTaskSuspend is set to 1.
+ *
+ * @return pdTRUE if a notification was received (including notifications that
+ * were already pending when xTaskNotifyWait was called), or pdFALSE if the
+ * call timed out.
+ *
+ * \defgroup xTaskNotifyWait xTaskNotifyWait
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotifyGive( xTaskHandle xTaskToNotify );</PRE>
+ *
+ * A simplified version of xTaskNotify() for when the notification value is
+ * used as a light weight counting or binary semaphore.  The receiving task
+ * should use ulTaskNotifyTake() rather than xTaskNotifyWait().
+ *
+ * xTaskNotifyGive() is a macro that calls xTaskNotify() with the eAction
+ * parameter set to eIncrement.
+ *
+ * @param xTaskToNotify The handle of the task being notified.
+ *
+ * @return xTaskNotifyGive() always returns pdPASS.
+ *
+ * \defgroup xTaskNotifyGive xTaskNotifyGive
+ * \ingroup TaskNotifications
+ */
+#define xTaskNotifyGive( xTaskToNotify ) xTaskNotify( ( xTaskToNotify ), 0UL, eIncrement )
+
+/**
+ * task. h
+ * <PRE>void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * A version of xTaskNotifyGive() that can be called from an interrupt service
+ * routine (ISR).  It is faster than xTaskNotifyFromISR() because it does not
+ * have to decode an action or return a value.
+ *
+ * @param xTaskToNotify The handle of the task being notified.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the notification
+ * caused a task with a priority higher than the currently running task to
+ * leave the Blocked state, in which case a context switch should be requested
+ * before the interrupt is exited.
+ *
+ * \defgroup vTaskNotifyGiveFromISR vTaskNotifyGiveFromISR
+ * \ingroup TaskNotifications
+ */
+void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait );</PRE>
+ *
+ * The counterpart of xTaskNotifyGive() and vTaskNotifyGiveFromISR(), for
+ * when the notification value is used in place of a binary or counting
+ * semaphore.  The calling task waits, with an optional timeout, for its
+ * notification value to be non-zero.
+ *
+ * @param xClearCountOnExit If xClearCountOnExit is pdFALSE then the task's
+ * notification value is decremented when the function exits, so the value
+ * acts like a counting semaphore.  If xClearCountOnExit is not pdFALSE then
+ * the task's notification value is cleared to zero when the function exits,
+ * so the value acts like a binary semaphore.
+ *
+ * @param xTicksToWait The maximum amount of time that the task should wait in
+ * the Blocked state for the task's notification value to be greater than
+ * zero.
+ *
+ * @return The task's notification value before it is decremented or cleared.
+ * Zero means the call timed out.
+ *
+ * \defgroup ulTaskNotifyTake ulTaskNotifyTake
+ * \ingroup TaskNotifications
+ */
+unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotifyStateClear( xTaskHandle xTask );</PRE>
+ *
+ * Clears a notification that is pending for a task that is not waiting for
+ * it, without changing the task's notification value.  Kernel objects that
+ * block using notifications call it before they wait, so a notification left
+ * over from an earlier wait that timed out does not end the new wait early.
+ *
+ * @param xTask The handle of the task whose pending notification is cleared.
+ * Pass NULL to clear the pending notification of the calling task.
+ *
+ * @return pdTRUE if a notification was pending and has been cleared, otherwise
+ * pdFALSE.
+ *
+ * \defgroup xTaskNotifyStateClear xTaskNotifyStateClear
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskNotifyStateClear( xTaskHandle xTask ) PRIVILEGED_FUNCTION;
+
 /*-----------------------------------------------------------
  * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
  *----------------------------------------------------------*/
@@ -1419,6 +2055,37 @@ void vTaskPlaceOnEventListRestricted( xList * const pxEventList, portTickType xT
  */
 signed portBASE_TYPE xTaskRemoveFromEventList( const xList * const pxEventList ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.
+ *
+ * The event groups implementation uses these two functions in place of
+ * vTaskPlaceOnEventList() and xTaskRemoveFromEventList().  The event list is
+ * not sorted by priority, because every task waiting on an event group is
+ * checked each time bits are set.  While a task waits, xItemValue (the bits it
+ * is waiting for) replaces the priority held in its event list item.
+ * xTaskRemoveFromUnorderedEventList() removes the task that owns
+ * pxEventListItem, storing xItemValue (the bits that unblocked it) in the
+ * item, and returns pdTRUE if that task has a priority above the calling task.
+ * In that case the switch to the unblocked task happens when the scheduler is
+ * resumed.
+ */
+void vTaskPlaceOnUnorderedEventList( xList * pxEventList, portTickType xItemValue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xTaskRemoveFromUnorderedEventList( xListItem * pxEventListItem, portTickType xItemValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Returns the value stored in the event list item of the calling task, then
+ * restores the item to the value used to sort event lists by priority.  Used
+ * by a task that has been unblocked from an event group to learn the bits
+ * that unblocked it.
+ */
+portTickType uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
@@ -1469,12 +2136,37 @@ void vTaskPriorityInherit( xTaskHandle const pxMutexHolder ) PRIVILEGED_FUNCTION
  */
 void vTaskPriorityDisinherit( xTaskHandle const pxMutexHolder ) PRIVILEGED_FUNCTION;
 
+/*
+ * Raises the calling task to uxCeilingPriority, unless it already runs at or
+ * above that priority, as it takes a ceiling mutex.  Returns the ceiling the
+ * task held before, which is passed to xTaskPriorityLeaveCeiling() when the
+ * mutex is given back.  Called from a critical section.
+ */
+unsigned portBASE_TYPE uxTaskPriorityEnterCeiling( unsigned portBASE_TYPE uxCeilingPriority ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the holder of a ceiling mutex to the priority it would have had if
+ * it had not taken the mutex.  Returns pdTRUE if the priority of the holder
+ * was lowered, in which case a higher priority task might now be able to run.
+ * Called from a critical section.
+ */
+portBASE_TYPE xTaskPriorityLeaveCeiling( xTaskHandle const pxMutexHolder, unsigned portBASE_TYPE uxCeilingPriority, unsigned portBASE_TYPE uxPreviousCeiling ) PRIVILEGED_FUNCTION;
+
 /*
  * Generic version of the task creation function which is in turn called by the
  * xTaskCreate() and xTaskCreateRestricted() macros.
  */
 signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions ) PRIVILEGED_FUNCTION;
 
+/*
+ * Provided by the application when configSUPPORT_STATIC_ALLOCATION is 1 to
+ * supply the memory used by the idle task.  *pusIdleTaskStackSize is set to
+ * the number of portSTACK_TYPE variables in *ppxIdleTaskStackBuffer.
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	void vApplicationGetIdleTaskMemory( xStaticTaskType **ppxIdleTaskTCBBuffer, portSTACK_TYPE **ppxIdleTaskStackBuffer, unsigned short *pusIdleTaskStackSize );
+#endif
+
 /*
  * Get the uxTCBNumber assigned to the task referenced by the xTask parameter.
  */
@@ -1510,6 +2202,25 @@ void vTaskStepTick( portTickType xTicksToJump );
  */
 eSleepModeStatus eTaskConfirmSleepModeStatus( void );
 
+/*
+ * Returns the tick count in *pxTickCount, and in *pulTimestamp the value that
+ * configTIMER_HISTOGRAM_TIMESTAMP() had when the tick count last changed.  The
+ * two are read together, so are consistent with each other.  Used by the timer
+ * service task to measure how late timer callbacks execute.  Only available if
+ * configUSE_TIMER_HISTOGRAMS is set to 1.
+ */
+void vTaskGetTickTimestamp( portTickType *pxTickCount, unsigned long *pulTimestamp ) PRIVILEGED_FUNCTION;
+
+/*
+ * Frees the TCBs and stacks of deleted tasks that are kept for reuse when
+ * configUSE_TASK_POOL is set to 1.  Called by pvPortMalloc() when the heap
+ * cannot satisfy an allocation, as the memory might be held by the pool, so
+ * the pool never costs the application heap it would otherwise have had.
+ * Returns pdTRUE if anything was freed.  Must not be called from an
+ * interrupt.
+ */
+portBASE_TYPE xTaskFlushTaskPool( void ) PRIVILEGED_FUNCTION;
+
 #ifdef __cplusplus
 }
 #endif
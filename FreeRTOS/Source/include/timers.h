@@ -81,7 +81,9 @@ extern "C" {
 
 /* IDs for commands that can be sent/received on the timer queue.  These are to
 be used solely through the macros that make up the public software timer API,
-as defined below. */
+as defined below.  Commands that have a negative ID are not applied to a
+timer. */
+#define tmrCOMMAND_EXECUTE_CALLBACK			( ( portBASE_TYPE ) -1 )
 #define tmrCOMMAND_START					( ( portBASE_TYPE ) 0 )
 #define tmrCOMMAND_STOP						( ( portBASE_TYPE ) 1 )
 #define tmrCOMMAND_CHANGE_PERIOD			( ( portBASE_TYPE ) 2 )
@@ -102,6 +104,56 @@ typedef void * xTimerHandle;
 /* Define the prototype to which timer callback functions must conform. */
 typedef void (*tmrTIMER_CALLBACK)( xTimerHandle xTimer );
 
+/* Define the prototype to which functions used with the
+xTimerPendFunctionCallFromISR() function must conform. */
+typedef void (*tmrPENDED_FUNCTION)( void *pvParameter1, unsigned long ulParameter2 );
+
+#if ( configUSE_TIMER_HISTOGRAMS == 1 )
+
+	/* Used with the xTimerGetHistogram() function to return how late the
+	callback of a timer executed, and how long it took to execute, each time
+	the timer expired.  Bucket 0 counts times of 0, bucket n counts times of at
+	least 2^(n-1) and less than 2^n, and the last bucket also counts every
+	longer time.  Times are in units of configTIMER_HISTOGRAM_TIMESTAMP(). */
+	typedef struct xTIMER_HISTOGRAM
+	{
+		unsigned long ulCallbacks;										/* The number of times the callback executed. */
+		unsigned long ulMaxLatency;										/* The latest the callback executed, relative to the tick at which the timer expired. */
+		unsigned long ulMaxExecution;									/* The longest the callback took to execute. */
+		unsigned long ulLatency[ configTIMER_HISTOGRAM_BUCKETS ];		/* How late the callback executed. */
+		unsigned long ulExecution[ configTIMER_HISTOGRAM_BUCKETS ];		/* How long the callback took to execute. */
+	} xTimerHistogram;
+
+#endif /* configUSE_TIMER_HISTOGRAMS */
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/*
+	 * Memory in which xTimerCreateStatic() creates a timer.  The timer
+	 * structure is private to timers.c, so this structure only has the same
+	 * size and alignment.  Its members must not be accessed, and it must be
+	 * updated whenever a member is added to the timer structure.
+	 */
+	typedef struct xSTATIC_TIMER
+	{
+		void *pvDummy1;
+		xListItem xDummy2;
+		portTickType xDummy3;
+		unsigned portBASE_TYPE uxDummy4;
+		void *pvDummy5;
+		tmrTIMER_CALLBACK pxDummy6;
+		unsigned char ucDummy7;
+		#if ( configUSE_TIMER_HISTOGRAMS == 1 )
+			unsigned portBASE_TYPE uxDummy8;
+			xTimerHistogram xDummy9;
+		#endif
+		#if ( INCLUDE_xTimerGetTimerByName == 1 )
+			void *pvDummy10;
+		#endif
+	} xStaticTimerType;
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
 /**
  * xTimerHandle xTimerCreate( 	const signed char *pcTimerName,
  * 								portTickType xTimerPeriodInTicks,
@@ -232,6 +284,28 @@ typedef void (*tmrTIMER_CALLBACK)( xTimerHandle xTimer );
  */
 xTimerHandle xTimerCreate( const signed char * const pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void * pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction ) PRIVILEGED_FUNCTION;
 
+/**
+ * xTimerHandle xTimerCreateStatic( const signed char *pcTimerName,
+ * 									portTickType xTimerPeriodInTicks,
+ * 									unsigned portBASE_TYPE uxAutoReload,
+ * 									void * pvTimerID,
+ * 									tmrTIMER_CALLBACK pxCallbackFunction,
+ * 									xStaticTimerType *pxTimerBuffer );
+ *
+ * As xTimerCreate(), but the timer is created in memory provided by the
+ * application, so the heap is not used.  The memory must remain valid until
+ * the timer has been deleted.  configSUPPORT_STATIC_ALLOCATION must be set to
+ * 1 in FreeRTOSConfig.h for this function to be available.
+ *
+ * @param pxTimerBuffer The memory in which the timer is created.
+ *
+ * @return A handle to the created timer, or NULL if pxTimerBuffer is NULL or
+ * xTimerPeriodInTicks is 0.
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xTimerHandle xTimerCreateStatic( const signed char * const pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void * pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction, xStaticTimerType *pxTimerBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * void *pvTimerGetTimerID( xTimerHandle xTimer );
  *
@@ -300,6 +374,71 @@ portBASE_TYPE xTimerIsTimerActive( xTimerHandle xTimer ) PRIVILEGED_FUNCTION;
  */
 xTaskHandle xTimerGetTimerDaemonTaskHandle( void );
 
+/**
+ * portBASE_TYPE xTimerGetHistogram( xTimerHandle xTimer, xTimerHistogram *pxHistogram );
+ *
+ * configUSE_TIMER_HISTOGRAMS must be defined as 1 in FreeRTOSConfig.h for
+ * xTimerGetHistogram() to be available.
+ *
+ * Each time a timer expires the timer service task records how late the
+ * callback executed, measured from the tick at which the timer expired, and
+ * how long the callback took to execute.  xTimerGetHistogram() copies the
+ * histograms of a timer into *pxHistogram without suspending the scheduler or
+ * disabling interrupts.  The timer service task increments a sequence number
+ * before and after it updates the histograms, and the copy is taken again if
+ * the sequence number changed while it was being taken, so the counts are
+ * consistent with each other.
+ *
+ * The latency includes the time taken by the callbacks of other timers that
+ * expired at the same time, and the time for which the timer service task was
+ * prevented from running by higher priority tasks or by the scheduler being
+ * suspended, so it shows how evenly a periodic timer's callback executes.
+ *
+ * @param xTimer The timer being queried.
+ *
+ * @param pxHistogram A pointer to the structure into which the histograms are
+ * copied.
+ *
+ * @return pdPASS.
+ */
+#if ( configUSE_TIMER_HISTOGRAMS == 1 )
+	portBASE_TYPE xTimerGetHistogram( xTimerHandle xTimer, xTimerHistogram *pxHistogram ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void vTimerClearHistogram( xTimerHandle xTimer );
+ *
+ * configUSE_TIMER_HISTOGRAMS must be defined as 1 in FreeRTOSConfig.h for
+ * vTimerClearHistogram() to be available.
+ *
+ * Sets every count in the histograms of a timer back to 0, so they can be
+ * collected over a chosen interval.
+ *
+ * @param xTimer The timer whose histograms are cleared.
+ */
+#if ( configUSE_TIMER_HISTOGRAMS == 1 )
+	void vTimerClearHistogram( xTimerHandle xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * xTimerHandle xTimerGetTimerByName( const signed char *pcTimerName );
+ *
+ * INCLUDE_xTimerGetTimerByName must be set to 1 in FreeRTOSConfig.h for
+ * xTimerGetTimerByName() to be available.
+ *
+ * Finds a timer by the text name it was given when it was created, so, for
+ * example, a monitoring task can read the histograms of a timer created by
+ * another module.  Every timer is kept in a list for the purpose, which is
+ * searched with the scheduler suspended, so the time taken grows with the
+ * number of timers.  Must not be called from an interrupt.
+ *
+ * @param pcTimerName The name of the timer to find.
+ *
+ * @return The handle of the first timer found with the name, or NULL if no
+ * timer that has not been deleted has the name.
+ */
+xTimerHandle xTimerGetTimerByName( const signed char *pcTimerName ) PRIVILEGED_FUNCTION;
+
 /**
  * portBASE_TYPE xTimerStart( xTimerHandle xTimer, portTickType xBlockTime );
  *
@@ -943,11 +1082,82 @@ xTaskHandle xTimerGetTimerDaemonTaskHandle( void );
  */
 #define xTimerResetFromISR( xTimer, pxHigherPriorityTaskWoken ) xTimerGenericCommand( ( xTimer ), tmrCOMMAND_START, ( xTaskGetTickCountFromISR() ), ( pxHigherPriorityTaskWoken ), 0U )
 
+/**
+ * portBASE_TYPE xTimerPendFunctionCallFromISR( tmrPENDED_FUNCTION xFunctionToPend,
+ *                                              void *pvParameter1,
+ *                                              unsigned long ulParameter2,
+ *                                              signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ *
+ * Used from application interrupt service routines to defer the execution of a
+ * function to the RTOS daemon task (the timer service task, hence this function
+ * is implemented in timers.c and is prefixed with 'Timer').
+ *
+ * Ideally an interrupt service routine (ISR) is kept as short as possible, but
+ * sometimes an ISR either has a lot of processing to do, or needs to perform
+ * processing that is not deterministic.  In these cases
+ * xTimerPendFunctionCallFromISR() can be used to defer processing of a
+ * function to the RTOS daemon task.
+ *
+ * INCLUDE_xTimerPendFunctionCall must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * @param xFunctionToPend The function to execute from the timer service/
+ * daemon task.  The function must conform to the tmrPENDED_FUNCTION prototype.
+ *
+ * @param pvParameter1 The value of the callback function's first parameter.
+ * The parameter has a void * type to allow it to be used to pass any type.
+ * For example, unsigned longs can be cast to a void *, or the void * can be
+ * used to point to a structure.
+ *
+ * @param ulParameter2 The value of the callback function's second parameter.
+ *
+ * @param pxHigherPriorityTaskWoken As mentioned above, calling this function
+ * will result in a message being sent to the timer daemon task.  If the
+ * priority of the timer daemon task (which is set using
+ * configTIMER_TASK_PRIORITY in FreeRTOSConfig.h) is higher than the priority of
+ * the currently running task (the task the interrupt interrupted) then
+ * *pxHigherPriorityTaskWoken will be set to pdTRUE within
+ * xTimerPendFunctionCallFromISR(), indicating that a context switch should be
+ * requested before the interrupt exits.  For that reason
+ * *pxHigherPriorityTaskWoken must be initialised to pdFALSE.
+ *
+ * @return pdPASS is returned if the message was successfully sent to the
+ * timer daemon task, otherwise pdFALSE is returned (the timer command queue
+ * was full).
+ */
+portBASE_TYPE xTimerPendFunctionCallFromISR( tmrPENDED_FUNCTION xFunctionToPend, void *pvParameter1, unsigned long ulParameter2, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * portBASE_TYPE xTimerPendFunctionCall( tmrPENDED_FUNCTION xFunctionToPend,
+ *                                       void *pvParameter1,
+ *                                       unsigned long ulParameter2,
+ *                                       portTickType xTicksToWait );
+ *
+ * Used to defer the execution of a function to the RTOS daemon task from a
+ * task.  As xTimerPendFunctionCallFromISR(), except that the calling task can
+ * block for up to xTicksToWait ticks to wait for space in the timer command
+ * queue.
+ *
+ * @return pdPASS is returned if the message was successfully sent to the
+ * timer daemon task, otherwise pdFALSE is returned.
+ */
+portBASE_TYPE xTimerPendFunctionCall( tmrPENDED_FUNCTION xFunctionToPend, void *pvParameter1, unsigned long ulParameter2, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
  */
 portBASE_TYPE xTimerCreateTimerTask( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Provided by the application when configSUPPORT_STATIC_ALLOCATION and
+ * configUSE_TIMERS are both 1 to supply the memory used by the timer service
+ * task.  *pusTimerTaskStackSize is set to the number of portSTACK_TYPE
+ * variables in *ppxTimerTaskStackBuffer.
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	void vApplicationGetTimerTaskMemory( xStaticTaskType **ppxTimerTaskTCBBuffer, portSTACK_TYPE **ppxTimerTaskStackBuffer, unsigned short *pusTimerTaskStackSize );
+#endif
 portBASE_TYPE xTimerGenericCommand( xTimerHandle xTimer, portBASE_TYPE xCommandID, portTickType xOptionalValue, signed portBASE_TYPE *pxHigherPriorityTaskWoken, portTickType xBlockTime ) PRIVILEGED_FUNCTION;
 
 #ifdef __cplusplus
@@ -0,0 +1,639 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the Linux (POSIX)
+ * simulator port.
+ *
+ * All tasks run on a single host thread.  Each task has its own ucontext and
+ * its own host allocated stack.  The tick is generated by a POSIX timer that
+ * signals the scheduler thread, and the yield and any application defined
+ * interrupts are delivered as a second signal.  Masking interrupts therefore
+ * means blocking those two signals, and context switches are only ever
+ * performed from the signal handler - the same way the PIC32MX port only
+ * switches from the core software interrupt.
+ *----------------------------------------------------------*/
+
+#ifndef _GNU_SOURCE
+	#define _GNU_SOURCE
+#endif
+
+/* Standard includes. */
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if ( configUSE_HR_TIMERS == 1 )
+	#include "hrtimers.h"
+#endif
+
+#ifndef __linux__
+	#error This port is designed to run on a Linux host.
+#endif
+
+/* The signals used to simulate the tick interrupt and all other interrupts. */
+#define portSIGNAL_TICK				SIGALRM
+#define portSIGNAL_INTERRUPT		SIGUSR1
+
+/* Tasks execute on host stacks rather than on the stack allocated by the
+kernel, as the host C library can require far more stack than a task on the
+target would be given. */
+#ifndef configHOST_STACK_SIZE
+	#define configHOST_STACK_SIZE	( 64 * 1024 )
+#endif
+
+/* The simulated high resolution counter starts 100ms before it wraps, so the
+wrap is exercised shortly after the first high resolution timer is created. */
+#define portHRTIMER_COUNTS_BEFORE_WRAP	( 100000UL * portHRTIMER_COUNTS_PER_US )
+#define portHRTIMER_COUNT_MASK			( 0xffffffffUL )
+#define portHRTIMER_HALF_RANGE			( 0x80000000UL )
+
+/* Older C libraries do not name the thread id member of struct sigevent. */
+#ifndef sigev_notify_thread_id
+	#define sigev_notify_thread_id	_sigev_un._tid
+#endif
+
+/* The execution context of a task.  A pointer to this structure is stored at
+the top of the stack allocated by the kernel, so it is the value pointed to by
+pxTopOfStack, the first member of the TCB. */
+typedef struct xTHREAD_CONTEXT
+{
+	ucontext_t xContext;
+	void *pvHostStack;
+	pdTASK_CODE pxCode;
+	void *pvParameters;
+} xThreadContext;
+
+#define portTCB_TO_THREAD_CONTEXT( pvTCB )	( ( xThreadContext * ) ( **( ( portSTACK_TYPE ** ) ( pvTCB ) ) ) )
+
+/*-----------------------------------------------------------*/
+
+/* The TCB of the running task, maintained by tasks.c. */
+extern void * volatile pxCurrentTCB;
+
+/* The set of signals blocked while interrupts are masked. */
+static sigset_t xSimulatedInterruptMask;
+
+/* The host thread that runs the scheduler, and the context it was in when
+xPortStartScheduler() was called so vPortEndScheduler() can return there. */
+static pthread_t xSchedulerThread;
+static ucontext_t xSchedulerContext;
+static volatile portBASE_TYPE xSchedulerStarted = pdFALSE;
+
+/* Simulated interrupt state.  Bits are set in ulPendingInterrupts by
+vPortGenerateSimulatedInterrupt(), which can run on any host thread. */
+static volatile unsigned long ulPendingInterrupts = 0UL;
+static portBASE_TYPE ( *pxInterruptHandlers[ portMAX_INTERRUPTS ] )( void ) = { NULL };
+
+#if ( portCRITICAL_NESTING_IN_TCB == 0 )
+
+	/* The critical section nesting depth.  It is not 0 until the first task
+	starts, so critical sections used while the application is being set up
+	leave interrupts masked. */
+	volatile unsigned portBASE_TYPE uxCriticalNesting = 0xaaaaaaaaUL;
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
+
+/* The timer that generates the tick. */
+static timer_t xTickTimer;
+static portBASE_TYPE xTickTimerCreated = pdFALSE;
+
+/* The time at which the application started, used as the run time stats
+clock base. */
+static struct timespec xStartTime = { 0, 0 };
+
+#if ( configUSE_HR_TIMERS == 1 )
+
+	/* The host thread that simulates the compare channel of the high
+	resolution counter, and the compare value it is waiting for. */
+	static pthread_t xHRTimerThread;
+	static pthread_mutex_t xHRTimerMutex = PTHREAD_MUTEX_INITIALIZER;
+	static pthread_cond_t xHRTimerCondition;
+	static unsigned long ulHRTimerCompare = 0UL;
+	static portBASE_TYPE xHRTimerCompareEnabled = pdFALSE;
+
+	/* The time at which the simulated counter started. */
+	static struct timespec xHRTimerStartTime = { 0, 0 };
+
+#endif /* configUSE_HR_TIMERS */
+
+/*
+ * The entry point of every task.  Unmasks interrupts, which are masked while
+ * the context switch into a new task is performed, then calls the task
+ * function.
+ */
+static void prvTaskEntry( void );
+
+/*
+ * Handler for both simulated interrupt signals.  Services every pending
+ * simulated interrupt then, if any handler requested it, selects and switches
+ * to the next task.
+ */
+static void prvSimulatedInterruptHandler( int iSignal );
+
+/*
+ * The kernel's own simulated interrupt handlers.
+ */
+static portBASE_TYPE prvProcessYieldInterrupt( void );
+static portBASE_TYPE prvProcessTickInterrupt( void );
+
+#if ( configUSE_HR_TIMERS == 1 )
+
+	/*
+	 * The host thread that raises portINTERRUPT_HRTIMER when the simulated
+	 * counter reaches the compare value, and the handler of that interrupt.
+	 */
+	static void *prvHRTimerThread( void *pvParameters );
+	static portBASE_TYPE prvProcessHRTimerInterrupt( void );
+
+#endif /* configUSE_HR_TIMERS */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+portSTACK_TYPE *pxPortInitialiseStack( portSTACK_TYPE *pxTopOfStack, pdTASK_CODE pxCode, void *pvParameters )
+{
+xThreadContext *pxThread;
+
+	pxThread = ( xThreadContext * ) malloc( sizeof( xThreadContext ) );
+	configASSERT( pxThread );
+	memset( pxThread, 0x00, sizeof( xThreadContext ) );
+
+	pxThread->pvHostStack = malloc( configHOST_STACK_SIZE );
+	configASSERT( pxThread->pvHostStack );
+	pxThread->pxCode = pxCode;
+	pxThread->pvParameters = pvParameters;
+
+	getcontext( &( pxThread->xContext ) );
+	pxThread->xContext.uc_stack.ss_sp = pxThread->pvHostStack;
+	pxThread->xContext.uc_stack.ss_size = configHOST_STACK_SIZE;
+	pxThread->xContext.uc_link = NULL;
+
+	/* The task is first entered from the signal handler, so it starts with
+	interrupts masked.  prvTaskEntry() unmasks them. */
+	pxThread->xContext.uc_sigmask = xSimulatedInterruptMask;
+	makecontext( &( pxThread->xContext ), prvTaskEntry, 0 );
+
+	*pxTopOfStack = ( portSTACK_TYPE ) pxThread;
+
+	return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+void vPortCleanUpTCB( void *pxTCB )
+{
+xThreadContext *pxThread = portTCB_TO_THREAD_CONTEXT( pxTCB );
+
+	/* Only called by the idle task for tasks that have already been deleted,
+	so the host stack being freed is never the one in use. */
+	free( pxThread->pvHostStack );
+	free( pxThread );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Setup a timer for a regular tick.  A POSIX timer is used that signals the
+ * scheduler thread directly, so host threads created by the application never
+ * receive the tick.  The function is declared weak so an application writer
+ * can supply a different tick source.
+ */
+__attribute__(( weak )) void vApplicationSetupTickTimerInterrupt( void )
+{
+struct sigevent xEvent;
+struct itimerspec xPeriod;
+
+	memset( &xEvent, 0x00, sizeof( xEvent ) );
+	xEvent.sigev_notify = SIGEV_THREAD_ID;
+	xEvent.sigev_signo = portSIGNAL_TICK;
+	xEvent.sigev_notify_thread_id = ( pid_t ) syscall( SYS_gettid );
+
+	if( timer_create( CLOCK_MONOTONIC, &xEvent, &xTickTimer ) == 0 )
+	{
+		xTickTimerCreated = pdTRUE;
+
+		xPeriod.it_interval.tv_sec = 0;
+		xPeriod.it_interval.tv_nsec = 1000000000L / configTICK_RATE_HZ;
+		xPeriod.it_value = xPeriod.it_interval;
+		timer_settime( xTickTimer, 0, &xPeriod, NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortStartScheduler( void )
+{
+struct sigaction xAction;
+sigset_t xOriginalMask;
+xThreadContext *pxFirstThread;
+
+	xSchedulerThread = pthread_self();
+
+	/* Install the kernel's own interrupt handlers. */
+	vPortSetInterruptHandler( portINTERRUPT_YIELD, prvProcessYieldInterrupt );
+	vPortSetInterruptHandler( portINTERRUPT_TICK, prvProcessTickInterrupt );
+
+	/* Anything pended before the scheduler started is stale. */
+	ulPendingInterrupts = 0UL;
+
+	/* Both signals are masked while either handler runs, as an interrupt on
+	the target masks interrupts at or below its own priority. */
+	memset( &xAction, 0x00, sizeof( xAction ) );
+	xAction.sa_handler = prvSimulatedInterruptHandler;
+	xAction.sa_mask = xSimulatedInterruptMask;
+	xAction.sa_flags = SA_RESTART;
+	sigaction( portSIGNAL_TICK, &xAction, NULL );
+	sigaction( portSIGNAL_INTERRUPT, &xAction, NULL );
+
+	/* Interrupts will already be masked, but make sure they stay masked
+	until the first task unmasks them. */
+	pthread_sigmask( SIG_BLOCK, &xSimulatedInterruptMask, &xOriginalMask );
+
+	/* Setup the timer to generate the tick. */
+	vApplicationSetupTickTimerInterrupt();
+
+	#if ( portCRITICAL_NESTING_IN_TCB == 0 )
+	{
+		/* The first task starts outside of any critical section. */
+		uxCriticalNesting = 0;
+	}
+	#endif /* portCRITICAL_NESTING_IN_TCB */
+
+	/* Kick off the highest priority task that has been created so far. */
+	xSchedulerStarted = pdTRUE;
+	pxFirstThread = portTCB_TO_THREAD_CONTEXT( pxCurrentTCB );
+	swapcontext( &xSchedulerContext, &( pxFirstThread->xContext ) );
+
+	/* Only get here if a task calls vTaskEndScheduler(). */
+	xSchedulerStarted = pdFALSE;
+	pthread_sigmask( SIG_SETMASK, &xOriginalMask, NULL );
+
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	/* Stop the tick then return to the context that started the
+	scheduler. */
+	if( xTickTimerCreated != pdFALSE )
+	{
+		timer_delete( xTickTimer );
+		xTickTimerCreated = pdFALSE;
+	}
+
+	vPortDisableInterrupts();
+	setcontext( &xSchedulerContext );
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetInterruptHandler( unsigned long ulInterruptNumber, portBASE_TYPE ( *pxHandler )( void ) )
+{
+	configASSERT( ulInterruptNumber < portMAX_INTERRUPTS );
+
+	if( ulInterruptNumber < portMAX_INTERRUPTS )
+	{
+		pxInterruptHandlers[ ulInterruptNumber ] = pxHandler;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortGenerateSimulatedInterrupt( unsigned long ulInterruptNumber )
+{
+	configASSERT( ulInterruptNumber < portMAX_INTERRUPTS );
+
+	if( ulInterruptNumber < portMAX_INTERRUPTS )
+	{
+		__atomic_fetch_or( &ulPendingInterrupts, 1UL << ulInterruptNumber, __ATOMIC_SEQ_CST );
+
+		/* If interrupts are masked on the scheduler thread the signal remains
+		pending until they are unmasked again. */
+		if( xSchedulerStarted != pdFALSE )
+		{
+			pthread_kill( xSchedulerThread, portSIGNAL_INTERRUPT );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	pthread_sigmask( SIG_BLOCK, &xSimulatedInterruptMask, NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	pthread_sigmask( SIG_UNBLOCK, &xSimulatedInterruptMask, NULL );
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxPortSetInterruptMaskFromISR( void )
+{
+sigset_t xPreviousMask;
+
+	pthread_sigmask( SIG_BLOCK, &xSimulatedInterruptMask, &xPreviousMask );
+
+	/* Return whether interrupts were already masked. */
+	return ( unsigned portBASE_TYPE ) sigismember( &xPreviousMask, portSIGNAL_INTERRUPT );
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMaskFromISR( unsigned portBASE_TYPE uxSavedStatusRegister )
+{
+	if( uxSavedStatusRegister == 0 )
+	{
+		vPortEnableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulPortGetRunTimeCounterValue( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+	return ( unsigned long ) ( ( ( xNow.tv_sec - xStartTime.tv_sec ) * 1000000L ) + ( ( xNow.tv_nsec - xStartTime.tv_nsec ) / 1000L ) );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HR_TIMERS == 1 )
+
+	void vPortHRTimerSetup( void )
+	{
+	pthread_condattr_t xAttributes;
+
+		pthread_condattr_init( &xAttributes );
+		pthread_condattr_setclock( &xAttributes, CLOCK_MONOTONIC );
+		pthread_cond_init( &xHRTimerCondition, &xAttributes );
+		pthread_condattr_destroy( &xAttributes );
+
+		clock_gettime( CLOCK_MONOTONIC, &xHRTimerStartTime );
+		vPortSetInterruptHandler( portINTERRUPT_HRTIMER, prvProcessHRTimerInterrupt );
+		pthread_create( &xHRTimerThread, NULL, prvHRTimerThread, NULL );
+	}
+	/*-----------------------------------------------------------*/
+
+	unsigned long ulPortHRTimerGetCount( void )
+	{
+	struct timespec xNow;
+	long long llNanoseconds;
+
+		clock_gettime( CLOCK_MONOTONIC, &xNow );
+		llNanoseconds = ( ( long long ) ( xNow.tv_sec - xHRTimerStartTime.tv_sec ) * 1000000000LL ) + ( long long ) ( xNow.tv_nsec - xHRTimerStartTime.tv_nsec );
+
+		return ( ( unsigned long ) ( llNanoseconds / ( 1000LL / ( long long ) portHRTIMER_COUNTS_PER_US ) ) - portHRTIMER_COUNTS_BEFORE_WRAP ) & portHRTIMER_COUNT_MASK;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortHRTimerSetCompare( unsigned long ulCompareCount )
+	{
+		pthread_mutex_lock( &xHRTimerMutex );
+		{
+			ulHRTimerCompare = ulCompareCount & portHRTIMER_COUNT_MASK;
+			xHRTimerCompareEnabled = pdTRUE;
+			pthread_cond_signal( &xHRTimerCondition );
+		}
+		pthread_mutex_unlock( &xHRTimerMutex );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortHRTimerClearCompare( void )
+	{
+		pthread_mutex_lock( &xHRTimerMutex );
+		{
+			xHRTimerCompareEnabled = pdFALSE;
+		}
+		pthread_mutex_unlock( &xHRTimerMutex );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void *prvHRTimerThread( void *pvParameters )
+	{
+	struct timespec xWakeTime;
+	unsigned long ulRemaining;
+	long long llNanoseconds;
+
+		( void ) pvParameters;
+
+		/* Simulated interrupts are only ever handled by the scheduler
+		thread. */
+		pthread_sigmask( SIG_BLOCK, &xSimulatedInterruptMask, NULL );
+
+		pthread_mutex_lock( &xHRTimerMutex );
+
+		for( ;; )
+		{
+			if( xHRTimerCompareEnabled == pdFALSE )
+			{
+				pthread_cond_wait( &xHRTimerCondition, &xHRTimerMutex );
+				continue;
+			}
+
+			ulRemaining = ( ulHRTimerCompare - ulPortHRTimerGetCount() ) & portHRTIMER_COUNT_MASK;
+
+			if( ( ulRemaining == 0UL ) || ( ulRemaining >= portHRTIMER_HALF_RANGE ) )
+			{
+				if( xSchedulerStarted != pdFALSE )
+				{
+					/* The count has reached the compare value.  As on the
+					hardware, there is one interrupt per match, and the
+					interrupt reprograms the compare value. */
+					xHRTimerCompareEnabled = pdFALSE;
+					vPortGenerateSimulatedInterrupt( portINTERRUPT_HRTIMER );
+					continue;
+				}
+
+				/* An interrupt raised before the scheduler started would be
+				discarded, so poll until it has. */
+				ulRemaining = 1000UL * portHRTIMER_COUNTS_PER_US;
+			}
+
+			/* Wait until the count reaches the compare value, or the compare
+			value changes. */
+			clock_gettime( CLOCK_MONOTONIC, &xWakeTime );
+			llNanoseconds = ( long long ) xWakeTime.tv_nsec + ( ( long long ) ulRemaining * ( 1000LL / ( long long ) portHRTIMER_COUNTS_PER_US ) );
+			xWakeTime.tv_sec += ( time_t ) ( llNanoseconds / 1000000000LL );
+			xWakeTime.tv_nsec = ( long ) ( llNanoseconds % 1000000000LL );
+			pthread_cond_timedwait( &xHRTimerCondition, &xHRTimerMutex, &xWakeTime );
+		}
+
+		return NULL;
+	}
+	/*-----------------------------------------------------------*/
+
+	static portBASE_TYPE prvProcessHRTimerInterrupt( void )
+	{
+		return xHRTimerProcessCompare();
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HR_TIMERS */
+
+static void prvTaskEntry( void )
+{
+xThreadContext *pxThread = portTCB_TO_THREAD_CONTEXT( pxCurrentTCB );
+
+	vPortEnableInterrupts();
+
+	pxThread->pxCode( pxThread->pvParameters );
+
+	/* Tasks must not return from their implementing function. */
+	configASSERT( pdFALSE );
+
+	#if ( INCLUDE_vTaskDelete == 1 )
+	{
+		vTaskDelete( NULL );
+	}
+	#endif
+
+	for( ;; )
+	{
+		portYIELD();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSimulatedInterruptHandler( int iSignal )
+{
+unsigned long ulPending, ulInterruptNumber;
+portBASE_TYPE xSwitchRequired = pdFALSE;
+void *pvPreviousTCB;
+int iSavedErrno = errno;
+
+	if( iSignal == portSIGNAL_TICK )
+	{
+		__atomic_fetch_or( &ulPendingInterrupts, 1UL << portINTERRUPT_TICK, __ATOMIC_SEQ_CST );
+	}
+
+	ulPending = __atomic_exchange_n( &ulPendingInterrupts, 0UL, __ATOMIC_SEQ_CST );
+
+	for( ulInterruptNumber = 0UL; ulPending != 0UL; ulInterruptNumber++ )
+	{
+		if( ( ulPending & ( 1UL << ulInterruptNumber ) ) != 0UL )
+		{
+			ulPending &= ~( 1UL << ulInterruptNumber );
+
+			if( pxInterruptHandlers[ ulInterruptNumber ] != NULL )
+			{
+				if( pxInterruptHandlers[ ulInterruptNumber ]() != pdFALSE )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+			}
+		}
+	}
+
+	if( xSwitchRequired != pdFALSE )
+	{
+		pvPreviousTCB = pxCurrentTCB;
+		vTaskSwitchContext();
+
+		if( pvPreviousTCB != pxCurrentTCB )
+		{
+			/* The context saved here is resumed, still inside this handler,
+			when the task is next selected. */
+			swapcontext( &( portTCB_TO_THREAD_CONTEXT( pvPreviousTCB )->xContext ), &( portTCB_TO_THREAD_CONTEXT( pxCurrentTCB )->xContext ) );
+		}
+	}
+
+	errno = iSavedErrno;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvProcessYieldInterrupt( void )
+{
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvProcessTickInterrupt( void )
+{
+	return xTaskIncrementTick();
+}
+/*-----------------------------------------------------------*/
+
+/* The mask must be valid before the first task is created, and the run time
+clock before the run time stats are configured, both of which happen before
+xPortStartScheduler() is called. */
+static void __attribute__(( constructor )) prvInitialisePort( void )
+{
+	sigemptyset( &xSimulatedInterruptMask );
+	sigaddset( &xSimulatedInterruptMask, portSIGNAL_TICK );
+	sigaddset( &xSimulatedInterruptMask, portSIGNAL_INTERRUPT );
+
+	clock_gettime( CLOCK_MONOTONIC, &xStartTime );
+}
+
@@ -0,0 +1,258 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * Port specific definitions.
+ *
+ * The settings in this file configure FreeRTOS correctly for the
+ * given hardware and compiler.
+ *
+ * These settings should not be altered.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions. */
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	unsigned long
+#define portBASE_TYPE	long
+
+/* The tick count is kept at 32 bits, as it is on the PIC32MX, so the overflow
+behaviour exercised on the host matches the target. */
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef unsigned portSHORT portTickType;
+	#define portMAX_DELAY ( portTickType ) 0xffff
+#else
+	typedef unsigned int portTickType;
+	#define portMAX_DELAY ( portTickType ) 0xffffffff
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portBYTE_ALIGNMENT			8
+#define portSTACK_GROWTH			-1
+#define portTICK_RATE_MS			( ( portTickType ) 1000 / configTICK_RATE_HZ )
+/*-----------------------------------------------------------*/
+
+/* Simulated interrupts.  Interrupt numbers 0 to 2 are used by the kernel,
+the remaining numbers can be installed by the application using
+vPortSetInterruptHandler() and raised from any host thread using
+vPortGenerateSimulatedInterrupt(). */
+#define portMAX_INTERRUPTS			( ( unsigned long ) 32 )
+#define portINTERRUPT_YIELD			( 0UL )
+#define portINTERRUPT_TICK			( 1UL )
+#define portINTERRUPT_HRTIMER		( 2UL )
+
+/*
+ * Install the handler for a simulated interrupt.  The handler runs with all
+ * simulated interrupts masked and returns pdTRUE if a context switch is
+ * required on exit.
+ */
+void vPortSetInterruptHandler( unsigned long ulInterruptNumber, portBASE_TYPE ( *pxHandler )( void ) );
+
+/*
+ * Raise a simulated interrupt.  This can be called from a task, from a
+ * simulated interrupt or from a host thread that is not under the control of
+ * the kernel (for example a thread that models a UART peripheral).
+ */
+void vPortGenerateSimulatedInterrupt( unsigned long ulInterruptNumber );
+/*-----------------------------------------------------------*/
+
+/* Critical section management.  Simulated interrupts are delivered as
+signals to the host thread that runs the scheduler, so masking interrupts
+means blocking those signals. */
+extern void vPortDisableInterrupts( void );
+extern void vPortEnableInterrupts( void );
+#define portDISABLE_INTERRUPTS()	vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()		vPortEnableInterrupts()
+
+/* Critical sections are inlined, and the nesting depth is held in a port
+variable rather than in the TCB of the running task.  As on the PIC32MX port, tasks are
+only switched from the signal handler, which cannot run inside a critical
+section, so the depth is always 0 when a task is switched out.  Define
+portCRITICAL_NESTING_IN_TCB as 1 to use the kernel's out of line functions
+instead. */
+#ifndef portCRITICAL_NESTING_IN_TCB
+	#define portCRITICAL_NESTING_IN_TCB	0
+#endif
+
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+	extern void vTaskEnterCritical( void );
+	extern void vTaskExitCritical( void );
+	#define portENTER_CRITICAL()		vTaskEnterCritical()
+	#define portEXIT_CRITICAL()			vTaskExitCritical()
+
+#else /* portCRITICAL_NESTING_IN_TCB */
+
+	extern volatile unsigned portBASE_TYPE uxCriticalNesting;
+
+	#define portENTER_CRITICAL()			\
+	{										\
+		portDISABLE_INTERRUPTS();			\
+		uxCriticalNesting++;				\
+	}
+
+	#define portEXIT_CRITICAL()				\
+	{										\
+		uxCriticalNesting--;				\
+		if( uxCriticalNesting == 0 )		\
+		{									\
+			portENABLE_INTERRUPTS();		\
+		}									\
+	}
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
+
+extern unsigned portBASE_TYPE uxPortSetInterruptMaskFromISR( void );
+extern void vPortClearInterruptMaskFromISR( unsigned portBASE_TYPE );
+#define portSET_INTERRUPT_MASK_FROM_ISR() uxPortSetInterruptMaskFromISR()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedStatusRegister ) vPortClearInterruptMaskFromISR( uxSavedStatusRegister )
+
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	/* Each bitmap holds 32 priorities.  If configMAX_PRIORITIES is greater
+	than 32 the kernel keeps a bitmap for each group of 32 priorities, and
+	records the groups that contain ready tasks in a further bitmap. */
+	#define portREADY_PRIORITY_BITS		32
+
+	/* Check the configuration.  configMAX_PRIORITIES must be a plain number,
+	without a cast, for the preprocessor to evaluate it. */
+	#if( configMAX_PRIORITIES > ( portREADY_PRIORITY_BITS * portREADY_PRIORITY_BITS ) )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 1024.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+	#endif
+
+	/* Store/clear the ready priorities in a bit map. */
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+	/*-----------------------------------------------------------*/
+
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31 - __builtin_clz( ( unsigned int ) ( uxReadyPriorities ) ) )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+/*-----------------------------------------------------------*/
+
+/* Task utilities. */
+
+/* A yield pends the yield interrupt, exactly as the PIC32MX port pends the
+core software interrupt.  The switch therefore happens as soon as interrupts
+are unmasked, which may be at the end of the current critical section. */
+#define portYIELD()					vPortGenerateSimulatedInterrupt( portINTERRUPT_YIELD )
+
+#define portNOP()					__asm volatile( "nop" )
+
+/* Tasks run on stacks allocated from the host, so the stack given to the
+kernel only has to hold the context record.  Release the host stack when the
+TCB is freed. */
+extern void vPortCleanUpTCB( void *pxTCB );
+#define portCLEAN_UP_TCB( pxTCB )	vPortCleanUpTCB( pxTCB )
+
+/* Free running microsecond count since the scheduler started.  Useful as the
+run time stats clock and for timing measurements made by the host demos. */
+unsigned long ulPortGetRunTimeCounterValue( void );
+
+/* The counter used by the high resolution timers is simulated from the host
+monotonic clock at 10MHz, and its compare channel by a host thread that raises
+portINTERRUPT_HRTIMER. */
+#define portHRTIMER_COUNTS_PER_US	( 10UL )
+
+/* Atomic compare and swap, used by the deferred calls of deferred.c.
+Evaluates to non-zero if *pulTarget held ulExpected and was set to ulNew. */
+#define portCOMPARE_AND_SWAP( pulTarget, ulExpected, ulNew )	__sync_bool_compare_and_swap( ( pulTarget ), ( ulExpected ), ( ulNew ) )
+
+/* Full memory barrier, as the simulated interrupts run on other host
+threads. */
+#define portMEMORY_BARRIER()	__sync_synchronize()
+
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+/*-----------------------------------------------------------*/
+
+#define portEND_SWITCHING_ISR( xSwitchRequired )	if( xSwitchRequired )	\
+													{						\
+														portYIELD();		\
+													}
+#define portYIELD_FROM_ISR( xSwitchRequired )		portEND_SWITCHING_ISR( xSwitchRequired )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
+
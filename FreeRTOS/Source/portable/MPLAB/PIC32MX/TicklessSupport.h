@@ -0,0 +1,162 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef TICKLESS_SUPPORT_H
+#define TICKLESS_SUPPORT_H
+
+/*
+ * Timer arithmetic used by vPortSuppressTicksAndSleep() in port.c.  Nothing in
+ * this file accesses the hardware, so the same code can be run on a host
+ * against a model of Timer1.
+ *
+ * Timer1 counts up from 0, and returns to 0 on the count after it matches
+ * PR1.  The tick interrupt runs when it returns to 0, so PR1 + 1 is always
+ * the count at which the tick period that is in progress ends.  To suppress
+ * the tick, PR1 is moved on by a whole number of tick periods, then moved
+ * back to end on the first tick boundary after the processor wakes.  TMR1 is
+ * never written, as writing it while the timer is running loses part of a
+ * count, so the tick count does not drift however often the tick is
+ * suppressed.
+ *
+ * The tick period that is in progress does not always start at 0.  If the
+ * processor wakes early, and no task is unblocked, the tick can be suppressed
+ * again before the period that was shortened on waking has ended.
+ */
+
+/* If the tick boundary at which the period must end is closer than this many
+counts when the processor wakes, TMR1 might pass it before PR1 is written.
+The period is then ended at the following tick boundary instead. */
+#define portTICKLESS_MARGIN_COUNTS	( 4UL )
+
+/*
+ * The value of TMR1 at the start of the tick period that ends when TMR1
+ * matches ulPeriod.
+ */
+#define portTICKLESS_TICK_START( ulPeriod, ulCountsPerTick )	( ( ( unsigned long ) ( ulPeriod ) + 1UL ) - ( unsigned long ) ( ulCountsPerTick ) )
+
+/*
+ * The value to write to PR1 for the timer period to end ulTicks tick periods
+ * after the tick period that started at ulTickStart.
+ */
+#define portTICKLESS_PERIOD( ulTickStart, ulCountsPerTick, ulTicks )	( ( unsigned long ) ( ulTickStart ) + ( ( ( unsigned long ) ( ulTicks ) * ( unsigned long ) ( ulCountsPerTick ) ) - 1UL ) )
+
+/*
+ * The most tick periods, from the tick period that started at ulTickStart,
+ * that fit in the 16-bit timer.
+ */
+#define portTICKLESS_MAX_TICKS( ulTickStart, ulCountsPerTick )	( ( 0x10000UL - ( unsigned long ) ( ulTickStart ) ) / ( unsigned long ) ( ulCountsPerTick ) )
+
+/*
+ * Called when the processor wakes before the lengthened period has ended.
+ * ulTimerCount is the value of TMR1, and ulTickStart is the value of TMR1 at
+ * the start of the tick period that was in progress when the tick was
+ * suppressed.  ulIdleTicks is the number of tick periods the period was
+ * lengthened to.
+ *
+ * Returns the number of complete tick periods by which to step the tick
+ * count.  The tick interrupt at the end of the tick period that is now in
+ * progress counts the remaining tick.  *pulNewPeriod is set to the value to
+ * write to PR1 to end the period on that tick boundary, or 0 if the period
+ * already ends there.
+ */
+static inline unsigned long ulPortTicklessCompleteTicks( unsigned long ulTimerCount, unsigned long ulTickStart, unsigned long ulCountsPerTick, unsigned long ulIdleTicks, unsigned long *pulNewPeriod )
+{
+unsigned long ulCountsElapsed, ulCompleteTicks;
+
+	/* The tick can be suppressed in the last few counts of a tick period
+	that has already been counted, in which case TMR1 has not yet reached the
+	start of the period being suppressed. */
+	if( ulTimerCount > ulTickStart )
+	{
+		ulCountsElapsed = ulTimerCount - ulTickStart;
+	}
+	else
+	{
+		ulCountsElapsed = 0UL;
+	}
+
+	ulCompleteTicks = ulCountsElapsed / ulCountsPerTick;
+	*pulNewPeriod = 0UL;
+
+	if( ( ulCompleteTicks + 1UL ) < ulIdleTicks )
+	{
+		/* If the boundary is too close to be sure of writing PR1 before TMR1
+		reaches it, count the tick period that is about to end now and end
+		the timer period at the next boundary instead. */
+		if( ( ( ( ulCompleteTicks + 1UL ) * ulCountsPerTick ) - ulCountsElapsed ) <= portTICKLESS_MARGIN_COUNTS )
+		{
+			ulCompleteTicks++;
+		}
+
+		if( ( ulCompleteTicks + 1UL ) < ulIdleTicks )
+		{
+			*pulNewPeriod = portTICKLESS_PERIOD( ulTickStart, ulCountsPerTick, ulCompleteTicks + 1UL );
+		}
+	}
+
+	return ulCompleteTicks;
+}
+
+#endif /* TICKLESS_SUPPORT_H */
+
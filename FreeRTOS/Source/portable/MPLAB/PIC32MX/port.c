@@ -74,10 +74,21 @@
 #include "FreeRTOS.h"
 #include "task.h"
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+	#include "TicklessSupport.h"
+#endif
+
+#if ( configUSE_HR_TIMERS == 1 )
+	#include "hrtimers.h"
+#endif
+
 /* Hardware specifics. */
 #define portTIMER_PRESCALE	8
 #define portPRESCALE_BITS	1
 
+/* The number of Timer1 counts in one tick period. */
+#define portTIMER_COUNTS_PER_TICK		( ( configPERIPHERAL_CLOCK_HZ / portTIMER_PRESCALE ) / configTICK_RATE_HZ )
+
 /* Bits within various registers. */
 #define portIE_BIT						( 0x00000001 )
 #define portEXL_BIT						( 0x00000002 )
@@ -94,6 +105,22 @@ the first task is being restored. */
 	#define configTICK_INTERRUPT_VECTOR _TIMER_1_VECTOR
 #endif
 
+#if ( configUSE_TICKLESS_IDLE == 1 ) && ( configTICK_INTERRUPT_VECTOR != _TIMER_1_VECTOR )
+	#error The tickless idle implementation reprograms Timer 1, so configTICK_INTERRUPT_VECTOR must be _TIMER_1_VECTOR when configUSE_TICKLESS_IDLE is 1.
+#endif
+
+/* The high resolution timers use Timer2 and Timer3 as one free running 32 bit
+counter, and output compare 1 as the compare channel.  The compare interrupt
+calls the API, so its priority cannot be above
+configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+#ifndef configHRTIMER_INTERRUPT_PRIORITY
+	#define configHRTIMER_INTERRUPT_PRIORITY configMAX_SYSCALL_INTERRUPT_PRIORITY
+#endif
+
+#if ( configUSE_HR_TIMERS == 1 ) && ( configHRTIMER_INTERRUPT_PRIORITY > configMAX_SYSCALL_INTERRUPT_PRIORITY )
+	#error configHRTIMER_INTERRUPT_PRIORITY must not be above configMAX_SYSCALL_INTERRUPT_PRIORITY.
+#endif
+
 /* Records the interrupt nesting depth.  This starts at one as it will be
 decremented to 0 when the first task starts. */
 volatile unsigned portBASE_TYPE uxInterruptNesting = 0x01;
@@ -101,6 +128,15 @@ volatile unsigned portBASE_TYPE uxInterruptNesting = 0x01;
 /* Stores the task stack pointer when a switch is made to use the system stack. */
 unsigned portBASE_TYPE uxSavedTaskStackPointer = 0;
 
+#if ( portCRITICAL_NESTING_IN_TCB == 0 )
+
+	/* The critical section nesting depth.  It is not 0 until the first task
+	starts, so critical sections used while the application is being set up
+	leave interrupts masked. */
+	volatile unsigned portBASE_TYPE uxCriticalNesting = 0xaaaaaaaaUL;
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
+
 /* The stack used by interrupt service routines that cause a context switch. */
 portSTACK_TYPE xISRStack[ configISR_STACK_SIZE ] = { 0 };
 
@@ -124,6 +160,18 @@ extern void __attribute__( (interrupt(ipl1), vector( configTICK_INTERRUPT_VECTOR
  */
 void __attribute__( (interrupt(ipl1), vector(_CORE_SOFTWARE_0_VECTOR))) vPortYieldISR( void );
 
+#if ( configUSE_HR_TIMERS == 1 )
+
+	/*
+	 * The output compare 1 interrupt handler that drives the high resolution
+	 * timers.  As with the tick, the handler is written in assembly so the IPL
+	 * setting has no effect.  The interrupt priority is set by
+	 * vPortHRTimerSetup().
+	 */
+	extern void __attribute__( (interrupt(ipl1), vector(_OUTPUT_COMPARE_1_VECTOR))) vPortHRTimerInterruptHandler( void );
+
+#endif /* configUSE_HR_TIMERS */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -220,6 +268,13 @@ extern void *pxCurrentTCB;
 	disabled by the time we get here. */
 	vApplicationSetupTickTimerInterrupt();
 
+	#if ( portCRITICAL_NESTING_IN_TCB == 0 )
+	{
+		/* The first task starts outside of any critical section. */
+		uxCriticalNesting = 0;
+	}
+	#endif /* portCRITICAL_NESTING_IN_TCB */
+
 	/* Kick off the highest priority task that has been created so far.
 	Its stack location is loaded into uxSavedTaskStackPointer. */
 	uxSavedTaskStackPointer = *( unsigned portBASE_TYPE * ) pxCurrentTCB;
@@ -234,6 +289,15 @@ void vPortIncrementTick( void )
 {
 unsigned portBASE_TYPE uxSavedStatus;
 
+	#if ( configUSE_TICKLESS_IDLE == 1 )
+	{
+		/* The period might have been lengthened while the tick was
+		suppressed.  TMR1 has just returned to 0, so the tick period can be
+		put back without losing any time. */
+		PR1 = portTIMER_COUNTS_PER_TICK - 1UL;
+	}
+	#endif
+
 	uxSavedStatus = uxPortSetInterruptMaskFromISR();
 	{
 		if( xTaskIncrementTick() != pdFALSE )
@@ -249,6 +313,106 @@ unsigned portBASE_TYPE uxSavedStatus;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+	void vPortSuppressTicksAndSleep( portTickType xExpectedIdleTime )
+	{
+	unsigned long ulTickStart, ulMaxTicks, ulTimerCount, ulCompleteTickPeriods, ulNewPeriod;
+	portTickType xModifiableIdleTime;
+
+		/* Disable all interrupts, not just those at or below
+		configMAX_SYSCALL_INTERRUPT_PRIORITY, so nothing can delay the timer
+		being reprogrammed.  Timer1 is left running throughout. */
+		asm volatile ( "di" );
+		asm volatile ( "ehb" );
+
+		if( ( eTaskConfirmSleepModeStatus() == eAbortSleep ) || ( IFS0bits.T1IF != 0 ) )
+		{
+			/* A task was made ready, or a tick is waiting to be processed,
+			since the idle time was calculated.  Don't sleep. */
+			asm volatile ( "ei" );
+		}
+		else
+		{
+			/* The tick period in progress ends when TMR1 matches PR1, but
+			does not start at 0 if the processor woke early from a previous
+			sleep.  The period of the timer cannot be made longer than will
+			fit in PR1. */
+			ulTickStart = portTICKLESS_TICK_START( PR1, portTIMER_COUNTS_PER_TICK );
+			ulMaxTicks = portTICKLESS_MAX_TICKS( ulTickStart, portTIMER_COUNTS_PER_TICK );
+			if( ( unsigned long ) xExpectedIdleTime > ulMaxTicks )
+			{
+				xExpectedIdleTime = ( portTickType ) ulMaxTicks;
+			}
+
+			/* Lengthen the tick period that is in progress so it ends
+			xExpectedIdleTime tick periods after it started. */
+			PR1 = portTICKLESS_PERIOD( ulTickStart, portTIMER_COUNTS_PER_TICK, xExpectedIdleTime );
+
+			if( IFS0bits.T1IF != 0 )
+			{
+				/* The tick period ended before PR1 was written, so TMR1 is
+				already counting towards the lengthened period from the start
+				of the next tick.  Put the tick period back, which is safe as
+				TMR1 has only just returned to 0, and let the tick interrupt
+				run. */
+				PR1 = portTIMER_COUNTS_PER_TICK - 1UL;
+				asm volatile ( "ei" );
+			}
+			else
+			{
+				/* Allow the application to define some pre-sleep processing,
+				and to skip the wait instruction by setting
+				xModifiableIdleTime to 0. */
+				xModifiableIdleTime = xExpectedIdleTime;
+				configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+				if( xModifiableIdleTime > 0 )
+				{
+					/* Enter Idle mode.  The peripheral bus clock, and so
+					Timer1, keeps running provided OSCCONbits.SLPEN is clear,
+					which is its reset value.  The core leaves the wait state
+					when an interrupt is requested even though interrupts are
+					disabled, then the interrupt is taken when they are
+					enabled below. */
+					asm volatile ( "wait" );
+				}
+				configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+				/* TMR1 is read before the interrupt flag is tested, so a
+				period that ends between the two is seen as having ended. */
+				ulTimerCount = TMR1;
+
+				if( IFS0bits.T1IF != 0 )
+				{
+					/* The lengthened period ended.  The tick interrupt will
+					count the last tick period and put the tick period back,
+					so step the tick count by one less. */
+					ulCompleteTickPeriods = ( unsigned long ) xExpectedIdleTime - 1UL;
+				}
+				else
+				{
+					/* Something other than the tick interrupt woke the
+					processor.  End the period on the next tick boundary
+					instead. */
+					ulCompleteTickPeriods = ulPortTicklessCompleteTicks( ulTimerCount, ulTickStart, portTIMER_COUNTS_PER_TICK, ( unsigned long ) xExpectedIdleTime, &ulNewPeriod );
+
+					if( ulNewPeriod != 0UL )
+					{
+						PR1 = ulNewPeriod;
+					}
+				}
+
+				vTaskStepTick( ( portTickType ) ulCompleteTickPeriods );
+
+				/* Let the interrupt that ended the sleep run. */
+				asm volatile ( "ei" );
+			}
+		}
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
 unsigned portBASE_TYPE uxPortSetInterruptMaskFromISR( void )
 {
 unsigned portBASE_TYPE uxSavedStatusRegister;
@@ -273,6 +437,83 @@ void vPortClearInterruptMaskFromISR( unsigned portBASE_TYPE uxSavedStatusRegiste
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_HR_TIMERS == 1 )
+
+	void vPortHRTimerSetup( void )
+	{
+		/* Timer2 and Timer3 form a 32 bit counter clocked from the peripheral
+		bus clock with no prescale.  It is never written once started. */
+		T2CON = 0x0000;
+		T3CON = 0x0000;
+		T2CONbits.T32 = 1;
+		TMR2 = 0UL;
+		PR2 = 0xffffffffUL;
+
+		/* Output compare 1 compares OC1R against the full 32 bit count.  The
+		toggle mode is used only because it requests an interrupt on every
+		match, but the OC1 pin toggles too so must not be used for anything
+		else. */
+		OC1CON = 0x0000;
+		OC1CONbits.OC32 = 1;
+		OC1CONbits.OCTSEL = 0;
+		OC1CONbits.OCM = 3;
+		OC1R = 0UL;
+
+		IPC1CLR = _IPC1_OC1IP_MASK;
+		IPC1SET = ( configHRTIMER_INTERRUPT_PRIORITY << _IPC1_OC1IP_POSITION );
+		IFS0CLR = _IFS0_OC1IF_MASK;
+		IEC0CLR = _IEC0_OC1IE_MASK;
+
+		OC1CONbits.ON = 1;
+		T2CONbits.TON = 1;
+	}
+	/*-----------------------------------------------------------*/
+
+	unsigned long ulPortHRTimerGetCount( void )
+	{
+		return TMR2;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortHRTimerSetCompare( unsigned long ulCompareCount )
+	{
+		OC1R = ulCompareCount;
+		IEC0SET = _IEC0_OC1IE_MASK;
+
+		/* A compare value the count has already passed would not match again
+		for 2^32 counts, so request the interrupt now.  If the count reaches
+		the compare value while this test is made the flag is set twice, which
+		still results in one interrupt. */
+		if( ( TMR2 - ulCompareCount ) < 0x80000000UL )
+		{
+			IFS0SET = _IFS0_OC1IF_MASK;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortHRTimerClearCompare( void )
+	{
+		IEC0CLR = _IEC0_OC1IE_MASK;
+		IFS0CLR = _IFS0_OC1IF_MASK;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortHRTimerCompare( void )
+	{
+		/* The flag is cleared first, as it is set again if the compare
+		channel is reprogrammed with a time that has already passed. */
+		IFS0CLR = _IFS0_OC1IF_MASK;
+
+		if( xHRTimerProcessCompare() != pdFALSE )
+		{
+			/* Pend a context switch. */
+			_CP0_BIS_CAUSE( portCORE_SW_0 );
+		}
+	}
+
+#endif /* configUSE_HR_TIMERS */
+/*-----------------------------------------------------------*/
+
 
 
 
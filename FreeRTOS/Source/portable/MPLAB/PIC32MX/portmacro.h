@@ -104,6 +104,19 @@ extern "C" {
 #define portBYTE_ALIGNMENT			8
 #define portSTACK_GROWTH			-1
 #define portTICK_RATE_MS			( ( portTickType ) 1000 / configTICK_RATE_HZ )		
+
+/* The high resolution timers count the unprescaled peripheral bus clock. */
+#define portHRTIMER_COUNTS_PER_US	( ( unsigned long ) configPERIPHERAL_CLOCK_HZ / 1000000UL )
+
+/* Atomic compare and swap, used by the deferred calls of deferred.c.  The
+compiler implements it with the LL and SC instructions of the M4K core, so it
+does not need to mask interrupts.  Evaluates to non-zero if *pulTarget held
+ulExpected and was set to ulNew. */
+#define portCOMPARE_AND_SWAP( pulTarget, ulExpected, ulNew )	__sync_bool_compare_and_swap( ( pulTarget ), ( ulExpected ), ( ulNew ) )
+
+/* The M4K core executes loads and stores in program order, so only the
+compiler has to be stopped from reordering them. */
+#define portMEMORY_BARRIER()	__asm volatile( "" ::: "memory" )
 /*-----------------------------------------------------------*/
 
 /* Critical section management. */
@@ -157,11 +170,44 @@ unsigned long ulStatus;													\
 }
 
 
-extern void vTaskEnterCritical( void );
-extern void vTaskExitCritical( void );
-#define portCRITICAL_NESTING_IN_TCB	1
-#define portENTER_CRITICAL()		vTaskEnterCritical()
-#define portEXIT_CRITICAL()			vTaskExitCritical()
+/* Critical sections are inlined, and the nesting depth is held in a port
+variable rather than in the TCB of the running task.  The yield interrupt runs at
+configKERNEL_INTERRUPT_PRIORITY, which a critical section masks, so a task is
+only ever switched out when the nesting depth is 0 and the depth does not need
+to be saved as part of the task context.  Define
+portCRITICAL_NESTING_IN_TCB as 1 to use the kernel's out of line functions
+instead. */
+#ifndef portCRITICAL_NESTING_IN_TCB
+	#define portCRITICAL_NESTING_IN_TCB	0
+#endif
+
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+	extern void vTaskEnterCritical( void );
+	extern void vTaskExitCritical( void );
+	#define portENTER_CRITICAL()		vTaskEnterCritical()
+	#define portEXIT_CRITICAL()			vTaskExitCritical()
+
+#else /* portCRITICAL_NESTING_IN_TCB */
+
+	extern volatile unsigned portBASE_TYPE uxCriticalNesting;
+
+	#define portENTER_CRITICAL()			\
+	{										\
+		portDISABLE_INTERRUPTS();			\
+		uxCriticalNesting++;				\
+	}
+
+	#define portEXIT_CRITICAL()				\
+	{										\
+		uxCriticalNesting--;				\
+		if( uxCriticalNesting == 0 )		\
+		{									\
+			portENABLE_INTERRUPTS();		\
+		}									\
+	}
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
 
 extern unsigned portBASE_TYPE uxPortSetInterruptMaskFromISR();
 extern void vPortClearInterruptMaskFromISR( unsigned portBASE_TYPE );
@@ -170,9 +216,15 @@ extern void vPortClearInterruptMaskFromISR( unsigned portBASE_TYPE );
 
 #if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
 
-	/* Check the configuration. */
-	#if( configMAX_PRIORITIES > 32 )
-		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+	/* Each bitmap holds 32 priorities.  If configMAX_PRIORITIES is greater
+	than 32 the kernel keeps a bitmap for each group of 32 priorities, and
+	records the groups that contain ready tasks in a further bitmap. */
+	#define portREADY_PRIORITY_BITS		32
+
+	/* Check the configuration.  configMAX_PRIORITIES must be a plain number,
+	without a cast, for the preprocessor to evaluate it. */
+	#if( configMAX_PRIORITIES > ( portREADY_PRIORITY_BITS * portREADY_PRIORITY_BITS ) )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 1024.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
 	#endif
 
 	/* Store/clear the ready priorities in a bit map. */
@@ -181,9 +233,12 @@ extern void vPortClearInterruptMaskFromISR( unsigned portBASE_TYPE );
 
 	/*-----------------------------------------------------------*/
 
-	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31 - _clz( ( uxReadyPriorities ) ) )
+	/* XC32 compiles __builtin_clz() to the MIPS32 clz instruction at every
+	optimisation level.  uxReadyPriorities is never 0 as the idle task is
+	always ready. */
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31 - __builtin_clz( ( unsigned long ) ( uxReadyPriorities ) ) )
 
-#endif /* taskRECORD_READY_PRIORITY */
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
 /*-----------------------------------------------------------*/
 
@@ -207,6 +262,12 @@ unsigned long ulCause;							\
 
 #define portNOP()	asm volatile ( 	"nop" )
 
+/* Tickless idle/low power functionality. */
+#if configUSE_TICKLESS_IDLE == 1
+	extern void vPortSuppressTicksAndSleep( portTickType xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* Task function macros as described on the FreeRTOS.org WEB site. */
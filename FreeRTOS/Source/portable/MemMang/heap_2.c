@@ -91,6 +91,12 @@ task.h is included from an application file. */
  */
 static void prvHeapInit( void );
 
+/*
+ * Allocates xWantedSize bytes from the heap, returning NULL if the heap cannot
+ * satisfy the request.
+ */
+static void *prvHeapAllocate( size_t xWantedSize );
+
 /* Allocate the memory for the heap. */
 static unsigned char ucHeap[ configTOTAL_HEAP_SIZE ];
 
@@ -143,6 +149,37 @@ size_t xBlockSize;																	\
 
 void *pvPortMalloc( size_t xWantedSize )
 {
+void *pvReturn;
+
+	pvReturn = prvHeapAllocate( xWantedSize );
+
+	#if( configUSE_TASK_POOL == 1 )
+	{
+		/* The memory might be held by the TCBs and stacks of deleted tasks
+		that the kernel keeps for reuse.  If so free them and try again. */
+		if( ( pvReturn == NULL ) && ( xTaskFlushTaskPool() != pdFALSE ) )
+		{
+			pvReturn = prvHeapAllocate( xWantedSize );
+		}
+	}
+	#endif
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+	}
+	#endif
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvHeapAllocate( size_t xWantedSize )
+{
 xBlockLink *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
 static portBASE_TYPE xHeapHasBeenInitialised = pdFALSE;
 void *pvReturn = NULL;
@@ -217,16 +254,6 @@ void *pvReturn = NULL;
 	}
 	xTaskResumeAll();
 
-	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
-	{
-		if( pvReturn == NULL )
-		{
-			extern void vApplicationMallocFailedHook( void );
-			vApplicationMallocFailedHook();
-		}
-	}
-	#endif
-
 	return pvReturn;
 }
 /*-----------------------------------------------------------*/
@@ -86,17 +86,30 @@ task.h is included from an application file. */
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/*
+ * Allocates xWantedSize bytes from the heap, returning NULL if the heap cannot
+ * satisfy the request.
+ */
+static void *prvHeapAllocate( size_t xWantedSize );
+
 /*-----------------------------------------------------------*/
 
 void *pvPortMalloc( size_t xWantedSize )
 {
 void *pvReturn;
 
-	vTaskSuspendAll();
+	pvReturn = prvHeapAllocate( xWantedSize );
+
+	#if( configUSE_TASK_POOL == 1 )
 	{
-		pvReturn = malloc( xWantedSize );
+		/* The memory might be held by the TCBs and stacks of deleted tasks
+		that the kernel keeps for reuse.  If so free them and try again. */
+		if( ( pvReturn == NULL ) && ( xTaskFlushTaskPool() != pdFALSE ) )
+		{
+			pvReturn = prvHeapAllocate( xWantedSize );
+		}
 	}
-	xTaskResumeAll();
+	#endif
 
 	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
 	{
@@ -107,6 +120,20 @@ void *pvReturn;
 		}
 	}
 	#endif
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvHeapAllocate( size_t xWantedSize )
+{
+void *pvReturn;
+
+	vTaskSuspendAll();
+	{
+		pvReturn = malloc( xWantedSize );
+	}
+	xTaskResumeAll();
 	
 	return pvReturn;
 }
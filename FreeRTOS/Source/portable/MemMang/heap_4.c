@@ -118,6 +118,12 @@ static void prvInsertBlockIntoFreeList( xBlockLink *pxBlockToInsert );
  */
 static void prvHeapInit( void );
 
+/*
+ * Allocates xWantedSize bytes from the heap, returning NULL if the heap cannot
+ * satisfy the request.
+ */
+static void *prvHeapAllocate( size_t xWantedSize );
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -144,6 +150,37 @@ static size_t xBlockAllocatedBit = 0;
 
 void *pvPortMalloc( size_t xWantedSize )
 {
+void *pvReturn;
+
+	pvReturn = prvHeapAllocate( xWantedSize );
+
+	#if( configUSE_TASK_POOL == 1 )
+	{
+		/* The memory might be held by the TCBs and stacks of deleted tasks
+		that the kernel keeps for reuse.  If so free them and try again. */
+		if( ( pvReturn == NULL ) && ( xTaskFlushTaskPool() != pdFALSE ) )
+		{
+			pvReturn = prvHeapAllocate( xWantedSize );
+		}
+	}
+	#endif
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+	}
+	#endif
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvHeapAllocate( size_t xWantedSize )
+{
 xBlockLink *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
 void *pvReturn = NULL;
 
@@ -232,16 +269,6 @@ void *pvReturn = NULL;
 	}
 	xTaskResumeAll();
 
-	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
-	{
-		if( pvReturn == NULL )
-		{
-			extern void vApplicationMallocFailedHook( void );
-			vApplicationMallocFailedHook();
-		}
-	}
-	#endif
-
 	return pvReturn;
 }
 /*-----------------------------------------------------------*/
@@ -104,6 +104,12 @@ structure member). */
 #define uxQueueType						pcHead
 #define queueQUEUE_IS_MUTEX				NULL
 
+/* A queue set does not store items.  The storage area of a set holds the list
+of its members that may be ready, its uxMessagesWaiting member holds the length
+of that list, and tasks blocked in xQueueSelectFromSet() wait in its
+xTasksWaitingToReceive list. */
+#define queueSET_READY_LIST( pxQueueSet )	( ( xList * ) ( pxQueueSet )->pcHead )
+
 /* Semaphores do not actually store or copy data, so have an item size of
 zero. */
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH ( ( unsigned portBASE_TYPE ) 0 )
@@ -143,12 +149,51 @@ typedef struct QueueDefinition
 	#endif
 
 	#if ( configUSE_QUEUE_SETS == 1 )
-		struct QueueDefinition *pxQueueSetContainer;
+		struct QueueDefinition *pxQueueSetContainer;	/*< The set the queue or semaphore is a member of, or NULL. */
+		xListItem xQueueSetItem;					/*< Links a member into the ready list of its set. */
+	#endif
+
+	#if ( configUSE_CEILING_MUTEXES == 1 )
+		unsigned portBASE_TYPE uxCeilingPriority;	/*< The priority at which the holder of a ceiling mutex runs, or tskIDLE_PRIORITY if the mutex is not a ceiling mutex. */
+		unsigned portBASE_TYPE uxPreviousCeiling;	/*< The ceiling the holder of a ceiling mutex held before it took the mutex, to which it returns when it gives the mutex. */
+		unsigned long ulTakenTime;					/*< The time at which the holder took the mutex. */
+		unsigned long ulMaxHoldTime;				/*< The longest time the mutex has been held. */
+		unsigned long ulMaxWaitTime;				/*< The longest time a task has waited for the mutex. */
+	#endif
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucStaticallyAllocated;		/*< Set to pdTRUE if the queue was created in memory provided by the application, so must not be freed when the queue is deleted. */
 	#endif
 
 } xQUEUE;
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	/*
+	 * Definition of a zero copy queue.  Items are written and read in place in
+	 * a ring of slots, so only the ownership of a slot passes between the
+	 * sender and the receiver.  There is one sender and one receiver, and each
+	 * index is only written by one of them, so neither needs a critical
+	 * section unless it has to block or unblock the other.
+	 *
+	 * The indexes run from 0 to ( 2 * uxLength ) - 1 so a full ring can be
+	 * told apart from an empty ring without leaving a slot unused.
+	 */
+	typedef struct ZeroCopyQueueDefinition
+	{
+		volatile unsigned portBASE_TYPE uxHead;			/*< Index of the slot the sender fills next.  Only written by the sender. */
+		volatile unsigned portBASE_TYPE uxTail;			/*< Index of the slot the receiver reads next.  Only written by the receiver. */
+		signed char *pcSlots;							/*< Points to the first slot.  The slots follow the structure in the same allocation. */
+		size_t xSlotSize;								/*< The item size rounded up to the port byte alignment. */
+		unsigned portBASE_TYPE uxLength;				/*< The number of slots. */
+		volatile xTaskHandle xTaskWaitingToAcquire;		/*< The sender, if it is blocked waiting for a free slot, otherwise NULL. */
+		volatile xTaskHandle xTaskWaitingToReceive;		/*< The receiver, if it is blocked waiting for a committed slot, otherwise NULL. */
+	} xZERO_COPY_QUEUE;
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
 /*
  * The queue registry is just a means for kernel aware debuggers to locate
  * queue structures.  It has no other purpose so is an optional component.
@@ -206,12 +251,123 @@ static void prvCopyDataToQueue( xQUEUE *pxQueue, const void *pvItemToQueue, port
  */
 static void prvCopyDataFromQueue( xQUEUE * const pxQueue, const void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copies as many of uxCount items as there is space for to the back of a
+ * queue, or as many of uxCount items as are available out of the front of a
+ * queue.  The items are copied with at most two calls to memcpy(), one each
+ * side of the point at which the queue storage area wraps.
+ *
+ * @return The number of items copied.
+ */
+static unsigned portBASE_TYPE prvCopyItemsToQueue( xQUEUE * const pxQueue, const signed char *pcItems, unsigned portBASE_TYPE uxCount ) PRIVILEGED_FUNCTION;
+static unsigned portBASE_TYPE prvCopyItemsFromQueue( xQUEUE * const pxQueue, signed char *pcBuffer, unsigned portBASE_TYPE uxCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock a waiting task for each of uxCount items added to, or removed from,
+ * a queue, for as long as tasks are waiting.  Must be called from a critical
+ * section, or from an ISR when the queue is not locked.
+ *
+ * @return pdTRUE if a task that has a priority above the calling task was
+ * unblocked, otherwise pdFALSE.
+ */
+static portBASE_TYPE prvUnblockReceivers( xQUEUE * const pxQueue, unsigned portBASE_TYPE uxCount ) PRIVILEGED_FUNCTION;
+static portBASE_TYPE prvUnblockSenders( xQUEUE * const pxQueue, unsigned portBASE_TYPE uxCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Initialise a queue structure that has just been allocated, or provided by
+ * the application, to hold a queue that stores its items in pcQueueStorage.
+ */
+static void prvInitialiseNewQueue( xQUEUE *pxNewQueue, unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, signed char *pcQueueStorage, unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_MUTEXES == 1 )
+	/*
+	 * Initialise a queue structure that has just been allocated, or provided
+	 * by the application, to hold a mutex, and give the mutex.
+	 */
+	static void prvInitialiseMutex( xQUEUE *pxNewQueue, unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_CEILING_MUTEXES == 1 )
+	/*
+	 * Returns the time used for the mutex statistics, which is the run time
+	 * stats counter if configGENERATE_RUN_TIME_STATS is 1, otherwise the tick
+	 * count.
+	 */
+	static unsigned long prvGetMutexTime( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called from a critical section as the calling task takes pxMutex, after
+	 * the task has been recorded as the mutex holder.  Raises the task to the
+	 * ceiling of a ceiling mutex, and if xWaited is pdTRUE records the time
+	 * the task has waited since ulWaitStart.
+	 */
+	static void prvMutexTaken( xQUEUE * const pxMutex, portBASE_TYPE xWaited, unsigned long ulWaitStart ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called from a critical section as the holder gives pxMutex back, before
+	 * the holder is cleared.  Records the time the mutex was held, and
+	 * returns the holder of a ceiling mutex to its previous priority.
+	 */
+	static void prvMutexGiven( xQUEUE * const pxMutex ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Records the time a task has waited for pxMutex, from ulWaitStart until
+	 * ulNow, if it is the longest wait so far.
+	 */
+	static void prvMutexWaitEnded( xQUEUE * const pxMutex, unsigned long ulWaitStart, unsigned long ulNow ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_QUEUE_SETS == 1 )
 	/*
-	 * Checks to see if a queue is a member of a queue set, and if so, notifies
-	 * the queue set that the queue contains data.
+	 * Notifies the queue set that contains pxQueue that the queue contains
+	 * data, by adding the queue to the ready list of the set if it is not
+	 * already there.  Must be called from a critical section or with
+	 * interrupts masked.
+	 */
+	static portBASE_TYPE prvNotifyQueueSetContainer( xQUEUE * const pxQueue ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns the next member of the ready list of pxQueueSet that contains
+	 * data, or NULL if there is none.  Members found to be empty are removed
+	 * from the ready list.  Must be called from a critical section or with
+	 * interrupts masked.
+	 */
+	static xQUEUE *prvGetReadyMember( xQUEUE * const pxQueueSet ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Removes pxQueue from the ready list of its set, if it is in the list.
+	 * Must be called from a critical section or with interrupts masked.
+	 */
+	static void prvRemoveReadyMember( xQUEUE * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	/*
+	 * The number of committed slots that have not yet been released, and the
+	 * number of slots that can be acquired.
+	 */
+	static unsigned portBASE_TYPE prvCommittedSlots( const xZERO_COPY_QUEUE * const pxQueue ) PRIVILEGED_FUNCTION;
+	static unsigned portBASE_TYPE prvFreeSlots( const xZERO_COPY_QUEUE * const pxQueue ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns a pointer to the slot at index uxIndex, and the index that
+	 * follows uxIndex.
+	 */
+	static void *prvSlotAt( const xZERO_COPY_QUEUE * const pxQueue, unsigned portBASE_TYPE uxIndex ) PRIVILEGED_FUNCTION;
+	static unsigned portBASE_TYPE prvNextSlotIndex( const xZERO_COPY_QUEUE * const pxQueue, unsigned portBASE_TYPE uxIndex ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Block the calling task until pxAvailable() reports a slot, or
+	 * xTicksToWait expires.  *pxWaitingTask is set so the other side knows to
+	 * notify the task.
 	 */
-	static portBASE_TYPE prvNotifyQueueSetContainer( const xQUEUE * const pxQueue, portBASE_TYPE xCopyPosition ) PRIVILEGED_FUNCTION;
+	static void prvWaitForSlot( const xZERO_COPY_QUEUE * const pxQueue, volatile xTaskHandle *pxWaitingTask, unsigned portBASE_TYPE ( *pxAvailable )( const xZERO_COPY_QUEUE * const pxQueue ), portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Unblock the task recorded in *pxWaitingTask, if any.
+	 */
+	static void prvNotifySlotWaiter( volatile xTaskHandle *pxWaitingTask ) PRIVILEGED_FUNCTION;
+	static void prvNotifySlotWaiterFromISR( volatile xTaskHandle *pxWaitingTask, portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 #endif
 
 /*-----------------------------------------------------------*/
@@ -284,12 +440,9 @@ xQueueHandle xQueueGenericCreate( unsigned portBASE_TYPE uxQueueLength, unsigned
 {
 xQUEUE *pxNewQueue;
 size_t xQueueSizeInBytes;
+signed char *pcQueueStorage;
 xQueueHandle xReturn = NULL;
 
-	/* Remove compiler warnings about unused parameters should
-	configUSE_TRACE_FACILITY not be set to 1. */
-	( void ) ucQueueType;
-
 	/* Allocate the new queue structure. */
 	if( uxQueueLength > ( unsigned portBASE_TYPE ) 0 )
 	{
@@ -300,28 +453,16 @@ xQueueHandle xReturn = NULL;
 			longer than asked for to make wrap checking easier/faster. */
 			xQueueSizeInBytes = ( size_t ) ( uxQueueLength * uxItemSize ) + ( size_t ) 1; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
-			pxNewQueue->pcHead = ( signed char * ) pvPortMalloc( xQueueSizeInBytes );
-			if( pxNewQueue->pcHead != NULL )
+			pcQueueStorage = ( signed char * ) pvPortMalloc( xQueueSizeInBytes );
+			if( pcQueueStorage != NULL )
 			{
-				/* Initialise the queue members as described above where the
-				queue type is defined. */
-				pxNewQueue->uxLength = uxQueueLength;
-				pxNewQueue->uxItemSize = uxItemSize;
-				( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
-
-				#if ( configUSE_TRACE_FACILITY == 1 )
+				#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 				{
-					pxNewQueue->ucQueueType = ucQueueType;
+					pxNewQueue->ucStaticallyAllocated = pdFALSE;
 				}
-				#endif /* configUSE_TRACE_FACILITY */
-
-				#if( configUSE_QUEUE_SETS == 1 )
-				{
-					pxNewQueue->pxQueueSetContainer = NULL;
-				}
-				#endif /* configUSE_QUEUE_SETS */
+				#endif
 
-				traceQUEUE_CREATE( pxNewQueue );
+				prvInitialiseNewQueue( pxNewQueue, uxQueueLength, uxItemSize, pcQueueStorage, ucQueueType );
 				xReturn = pxNewQueue;
 			}
 			else
@@ -338,58 +479,122 @@ xQueueHandle xReturn = NULL;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xQueueHandle xQueueGenericCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorage, xStaticQueueType *pxStaticQueue, unsigned char ucQueueType )
+	{
+	xQUEUE *pxNewQueue = NULL;
+	signed char *pcQueueStorage = ( signed char * ) pucQueueStorage;
+
+		/* If this fails xStaticQueueType has not been kept in step with the
+		queue structure. */
+		configASSERT( sizeof( xStaticQueueType ) == sizeof( xQUEUE ) );
+
+		/* Items are copied into the storage area, so it can only be omitted
+		if the items have no size. */
+		configASSERT( ( pucQueueStorage != NULL ) || ( uxItemSize == ( unsigned portBASE_TYPE ) 0 ) );
+
+		if( ( pxStaticQueue != NULL ) && ( uxQueueLength > ( unsigned portBASE_TYPE ) 0 ) )
+		{
+			pxNewQueue = ( xQUEUE * ) pxStaticQueue;
+			pxNewQueue->ucStaticallyAllocated = pdTRUE;
+
+			if( pcQueueStorage == NULL )
+			{
+				/* A NULL pcHead would mark the queue as a mutex, so point it
+				at the queue structure instead.  Nothing is ever copied to or
+				from it. */
+				pcQueueStorage = ( signed char * ) pxNewQueue;
+			}
+
+			prvInitialiseNewQueue( pxNewQueue, uxQueueLength, uxItemSize, pcQueueStorage, ucQueueType );
+		}
+		else
+		{
+			traceQUEUE_CREATE_FAILED( ucQueueType );
+		}
+
+		configASSERT( pxNewQueue );
+
+		return pxNewQueue;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewQueue( xQUEUE *pxNewQueue, unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, signed char *pcQueueStorage, unsigned char ucQueueType )
+{
+	/* Remove compiler warnings about unused parameters should
+	configUSE_TRACE_FACILITY not be set to 1. */
+	( void ) ucQueueType;
+
+	/* Initialise the queue members as described above where the queue type
+	is defined. */
+	pxNewQueue->pcHead = pcQueueStorage;
+	pxNewQueue->uxLength = uxQueueLength;
+	pxNewQueue->uxItemSize = uxItemSize;
+	( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
+
+	#if ( configUSE_TRACE_FACILITY == 1 )
+	{
+		pxNewQueue->ucQueueType = ucQueueType;
+	}
+	#endif /* configUSE_TRACE_FACILITY */
+
+	#if( configUSE_QUEUE_SETS == 1 )
+	{
+		pxNewQueue->pxQueueSetContainer = NULL;
+		vListInitialiseItem( &( pxNewQueue->xQueueSetItem ) );
+		listSET_LIST_ITEM_OWNER( &( pxNewQueue->xQueueSetItem ), pxNewQueue );
+	}
+	#endif /* configUSE_QUEUE_SETS */
+
+	traceQUEUE_CREATE( pxNewQueue );
+}
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 
 	xQueueHandle xQueueCreateMutex( unsigned char ucQueueType )
 	{
 	xQUEUE *pxNewQueue;
 
-		/* Prevent compiler warnings about unused parameters if
-		configUSE_TRACE_FACILITY does not equal 1. */
-		( void ) ucQueueType;
-
 		/* Allocate the new queue structure. */
 		pxNewQueue = ( xQUEUE * ) pvPortMalloc( sizeof( xQUEUE ) );
 		if( pxNewQueue != NULL )
 		{
-			/* Information required for priority inheritance. */
-			pxNewQueue->pxMutexHolder = NULL;
-			pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
-
-			/* Queues used as a mutex no data is actually copied into or out
-			of the queue. */
-			pxNewQueue->pcWriteTo = NULL;
-			pxNewQueue->u.pcReadFrom = NULL;
-
-			/* Each mutex has a length of 1 (like a binary semaphore) and
-			an item size of 0 as nothing is actually copied into or out
-			of the mutex. */
-			pxNewQueue->uxMessagesWaiting = ( unsigned portBASE_TYPE ) 0U;
-			pxNewQueue->uxLength = ( unsigned portBASE_TYPE ) 1U;
-			pxNewQueue->uxItemSize = ( unsigned portBASE_TYPE ) 0U;
-			pxNewQueue->xRxLock = queueUNLOCKED;
-			pxNewQueue->xTxLock = queueUNLOCKED;
-
-			#if ( configUSE_TRACE_FACILITY == 1 )
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
-				pxNewQueue->ucQueueType = ucQueueType;
+				pxNewQueue->ucStaticallyAllocated = pdFALSE;
 			}
 			#endif
 
-			#if ( configUSE_QUEUE_SETS == 1 )
-			{
-				pxNewQueue->pxQueueSetContainer = NULL;
-			}
-			#endif
+			prvInitialiseMutex( pxNewQueue, ucQueueType );
+		}
+		else
+		{
+			traceCREATE_MUTEX_FAILED();
+		}
+
+		configASSERT( pxNewQueue );
+		return pxNewQueue;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
 
-			/* Ensure the event queues start with the correct state. */
-			vListInitialise( &( pxNewQueue->xTasksWaitingToSend ) );
-			vListInitialise( &( pxNewQueue->xTasksWaitingToReceive ) );
+#if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	xQueueHandle xQueueCreateMutexStatic( unsigned char ucQueueType, xStaticQueueType *pxStaticQueue )
+	{
+	xQUEUE *pxNewQueue = ( xQUEUE * ) pxStaticQueue;
 
-			traceCREATE_MUTEX( pxNewQueue );
+		configASSERT( sizeof( xStaticQueueType ) == sizeof( xQUEUE ) );
 
-			/* Start with the semaphore in the expected state. */
-			( void ) xQueueGenericSend( pxNewQueue, NULL, ( portTickType ) 0U, queueSEND_TO_BACK );
+		if( pxNewQueue != NULL )
+		{
+			pxNewQueue->ucStaticallyAllocated = pdTRUE;
+			prvInitialiseMutex( pxNewQueue, ucQueueType );
 		}
 		else
 		{
@@ -400,9 +605,215 @@ xQueueHandle xReturn = NULL;
 		return pxNewQueue;
 	}
 
+#endif /* ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CEILING_MUTEXES == 1 )
+
+	xQueueHandle xQueueCreateCeilingMutex( unsigned portBASE_TYPE uxCeilingPriority )
+	{
+	xQueueHandle xMutex;
+
+		configASSERT( uxCeilingPriority < configMAX_PRIORITIES );
+
+		xMutex = xQueueCreateMutex( queueQUEUE_TYPE_CEILING_MUTEX );
+
+		if( xMutex != NULL )
+		{
+			( ( xQUEUE * ) xMutex )->uxCeilingPriority = uxCeilingPriority;
+		}
+
+		return xMutex;
+	}
+
+#endif /* configUSE_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_CEILING_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	xQueueHandle xQueueCreateCeilingMutexStatic( unsigned portBASE_TYPE uxCeilingPriority, xStaticQueueType *pxStaticQueue )
+	{
+	xQueueHandle xMutex;
+
+		configASSERT( uxCeilingPriority < configMAX_PRIORITIES );
+
+		xMutex = xQueueCreateMutexStatic( queueQUEUE_TYPE_CEILING_MUTEX, pxStaticQueue );
+
+		if( xMutex != NULL )
+		{
+			( ( xQUEUE * ) xMutex )->uxCeilingPriority = uxCeilingPriority;
+		}
+
+		return xMutex;
+	}
+
+#endif /* ( configUSE_CEILING_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	static void prvInitialiseMutex( xQUEUE *pxNewQueue, unsigned char ucQueueType )
+	{
+		/* Prevent compiler warnings about unused parameters if
+		configUSE_TRACE_FACILITY does not equal 1. */
+		( void ) ucQueueType;
+
+		/* Information required for priority inheritance. */
+		pxNewQueue->pxMutexHolder = NULL;
+		pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
+
+		/* Queues used as a mutex no data is actually copied into or out
+		of the queue. */
+		pxNewQueue->pcWriteTo = NULL;
+		pxNewQueue->u.pcReadFrom = NULL;
+
+		/* Each mutex has a length of 1 (like a binary semaphore) and
+		an item size of 0 as nothing is actually copied into or out
+		of the mutex. */
+		pxNewQueue->uxMessagesWaiting = ( unsigned portBASE_TYPE ) 0U;
+		pxNewQueue->uxLength = ( unsigned portBASE_TYPE ) 1U;
+		pxNewQueue->uxItemSize = ( unsigned portBASE_TYPE ) 0U;
+		pxNewQueue->xRxLock = queueUNLOCKED;
+		pxNewQueue->xTxLock = queueUNLOCKED;
+
+		#if ( configUSE_TRACE_FACILITY == 1 )
+		{
+			pxNewQueue->ucQueueType = ucQueueType;
+		}
+		#endif
+
+		#if ( configUSE_QUEUE_SETS == 1 )
+		{
+			pxNewQueue->pxQueueSetContainer = NULL;
+			vListInitialiseItem( &( pxNewQueue->xQueueSetItem ) );
+			listSET_LIST_ITEM_OWNER( &( pxNewQueue->xQueueSetItem ), pxNewQueue );
+		}
+		#endif
+
+		#if ( configUSE_CEILING_MUTEXES == 1 )
+		{
+			/* xQueueCreateCeilingMutex() sets the ceiling of a ceiling mutex
+			after it has been initialised. */
+			pxNewQueue->uxCeilingPriority = tskIDLE_PRIORITY;
+			pxNewQueue->uxPreviousCeiling = tskIDLE_PRIORITY;
+			pxNewQueue->ulTakenTime = 0UL;
+			pxNewQueue->ulMaxHoldTime = 0UL;
+			pxNewQueue->ulMaxWaitTime = 0UL;
+		}
+		#endif
+
+		/* Ensure the event queues start with the correct state. */
+		vListInitialise( &( pxNewQueue->xTasksWaitingToSend ) );
+		vListInitialise( &( pxNewQueue->xTasksWaitingToReceive ) );
+
+		traceCREATE_MUTEX( pxNewQueue );
+
+		/* Start with the semaphore in the expected state. */
+		( void ) xQueueGenericSend( pxNewQueue, NULL, ( portTickType ) 0U, queueSEND_TO_BACK );
+	}
+
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_CEILING_MUTEXES == 1 )
+
+	static unsigned long prvGetMutexTime( void )
+	{
+	unsigned long ulTime;
+
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+				portALT_GET_RUN_TIME_COUNTER_VALUE( ulTime );
+			#else
+				ulTime = ( unsigned long ) portGET_RUN_TIME_COUNTER_VALUE();
+			#endif
+		}
+		#else
+		{
+			ulTime = ( unsigned long ) xTaskGetTickCount();
+		}
+		#endif
+
+		return ulTime;
+	}
+
+#endif /* configUSE_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CEILING_MUTEXES == 1 )
+
+	static void prvMutexTaken( xQUEUE * const pxMutex, portBASE_TYPE xWaited, unsigned long ulWaitStart )
+	{
+	unsigned long ulNow;
+
+		ulNow = prvGetMutexTime();
+
+		if( xWaited != pdFALSE )
+		{
+			prvMutexWaitEnded( pxMutex, ulWaitStart, ulNow );
+		}
+
+		pxMutex->ulTakenTime = ulNow;
+
+		/* The holder is only NULL if the mutex is taken before any task has
+		been created. */
+		if( ( pxMutex->uxCeilingPriority != tskIDLE_PRIORITY ) && ( pxMutex->pxMutexHolder != NULL ) )
+		{
+			pxMutex->uxPreviousCeiling = uxTaskPriorityEnterCeiling( pxMutex->uxCeilingPriority );
+		}
+	}
+
+#endif /* configUSE_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CEILING_MUTEXES == 1 )
+
+	static void prvMutexGiven( xQUEUE * const pxMutex )
+	{
+	unsigned long ulHoldTime;
+
+		/* The holder is NULL when the mutex is given as it is created. */
+		if( pxMutex->pxMutexHolder != NULL )
+		{
+			ulHoldTime = prvGetMutexTime() - pxMutex->ulTakenTime;
+
+			if( ulHoldTime > pxMutex->ulMaxHoldTime )
+			{
+				pxMutex->ulMaxHoldTime = ulHoldTime;
+			}
+
+			if( pxMutex->uxCeilingPriority != tskIDLE_PRIORITY )
+			{
+				if( xTaskPriorityLeaveCeiling( ( void * ) pxMutex->pxMutexHolder, pxMutex->uxCeilingPriority, pxMutex->uxPreviousCeiling ) != pdFALSE )
+				{
+					/* No task that could take the mutex was able to run while
+					it was held, so a task that was readied while the holder
+					ran at the ceiling might now have a higher priority than
+					the holder.  Yes it is ok to do this from within the
+					critical section - the kernel takes care of that. */
+					portYIELD_WITHIN_API();
+				}
+			}
+		}
+	}
+
+#endif /* configUSE_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CEILING_MUTEXES == 1 )
+
+	static void prvMutexWaitEnded( xQUEUE * const pxMutex, unsigned long ulWaitStart, unsigned long ulNow )
+	{
+		if( ( ulNow - ulWaitStart ) > pxMutex->ulMaxWaitTime )
+		{
+			pxMutex->ulMaxWaitTime = ulNow - ulWaitStart;
+		}
+	}
+
+#endif /* configUSE_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
 
 	void* xQueueGetMutexHolder( xQueueHandle xSemaphore )
@@ -433,6 +844,36 @@ xQueueHandle xReturn = NULL;
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_CEILING_MUTEXES == 1 )
+
+	void vQueueGetMutexStats( xQueueHandle xMutex, xMutexStatsType *pxStats, portBASE_TYPE xReset )
+	{
+	xQUEUE * const pxMutex = ( xQUEUE * ) xMutex;
+
+		configASSERT( pxMutex );
+		configASSERT( pxStats );
+		configASSERT( pxMutex->uxQueueType == queueQUEUE_IS_MUTEX );
+
+		/* The statistics are only written from critical sections, so the
+		critical section ensures the two values are read, and reset, as a
+		pair. */
+		taskENTER_CRITICAL();
+		{
+			pxStats->ulMaxHoldTime = pxMutex->ulMaxHoldTime;
+			pxStats->ulMaxWaitTime = pxMutex->ulMaxWaitTime;
+
+			if( xReset != pdFALSE )
+			{
+				pxMutex->ulMaxHoldTime = 0UL;
+				pxMutex->ulMaxWaitTime = 0UL;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_RECURSIVE_MUTEXES == 1 )
 
 	portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle xMutex )
@@ -550,13 +991,39 @@ xQueueHandle xReturn = NULL;
 #endif /* configUSE_COUNTING_SEMAPHORES */
 /*-----------------------------------------------------------*/
 
-signed portBASE_TYPE xQueueGenericSend( xQueueHandle xQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition )
-{
-signed portBASE_TYPE xEntryTimeSet = pdFALSE;
-xTimeOutType xTimeOut;
-xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 
-	configASSERT( pxQueue );
+	xQueueHandle xQueueCreateCountingSemaphoreStatic( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount, xStaticQueueType *pxStaticQueue )
+	{
+	xQueueHandle xHandle;
+
+		xHandle = xQueueGenericCreateStatic( uxCountValue, queueSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, pxStaticQueue, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+
+		if( xHandle != NULL )
+		{
+			( ( xQUEUE * ) xHandle )->uxMessagesWaiting = uxInitialCount;
+
+			traceCREATE_COUNTING_SEMAPHORE();
+		}
+		else
+		{
+			traceCREATE_COUNTING_SEMAPHORE_FAILED();
+		}
+
+		configASSERT( xHandle );
+		return xHandle;
+	}
+
+#endif /* ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xQueueGenericSend( xQueueHandle xQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition )
+{
+signed portBASE_TYPE xEntryTimeSet = pdFALSE;
+xTimeOutType xTimeOut;
+xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+
+	configASSERT( pxQueue );
 	configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U ) ) );
 	configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
 
@@ -580,11 +1047,11 @@ xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 				{
 					if( pxQueue->pxQueueSetContainer != NULL )
 					{
-						if( prvNotifyQueueSetContainer( pxQueue, xCopyPosition ) == pdTRUE )
+						if( prvNotifyQueueSetContainer( pxQueue ) == pdTRUE )
 						{
-							/* The queue is a member of a queue set, and posting
-							to the queue set caused a higher priority task to
-							unblock. A context switch is required. */
+							/* The queue is a member of a queue set, and making
+							the queue ready in the set caused a higher priority
+							task to unblock. A context switch is required. */
 							portYIELD_WITHIN_API();
 						}
 					}
@@ -796,6 +1263,9 @@ xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 	xTimeOutType xTimeOut;
 	signed char *pcOriginalReadPosition;
 	xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+	#if ( configUSE_CEILING_MUTEXES == 1 )
+		unsigned long ulWaitStart = 0UL;
+	#endif
 
 		configASSERT( pxQueue );
 		configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U ) ) );
@@ -825,6 +1295,12 @@ xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 								/* Record the information required to implement
 								priority inheritance should it become necessary. */
 								pxQueue->pxMutexHolder = ( signed char * ) xTaskGetCurrentTaskHandle();
+
+								#if ( configUSE_CEILING_MUTEXES == 1 )
+								{
+									prvMutexTaken( pxQueue, xEntryTimeSet, ulWaitStart );
+								}
+								#endif
 							}
 						}
 						#endif
@@ -875,6 +1351,12 @@ xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 					{
 						vTaskSetTimeOutState( &xTimeOut );
 						xEntryTimeSet = pdTRUE;
+
+						#if ( configUSE_CEILING_MUTEXES == 1 )
+						{
+							ulWaitStart = prvGetMutexTime();
+						}
+						#endif
 					}
 				}
 			}
@@ -907,6 +1389,17 @@ xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 				}
 				else
 				{
+					#if ( configUSE_CEILING_MUTEXES == 1 )
+					{
+						/* A wait that times out counts towards the longest
+						wait. */
+						if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+						{
+							prvMutexWaitEnded( pxQueue, ulWaitStart, prvGetMutexTime() );
+						}
+					}
+					#endif
+
 					taskEXIT_CRITICAL();
 					traceQUEUE_RECEIVE_FAILED( pxQueue );
 					return errQUEUE_EMPTY;
@@ -967,11 +1460,11 @@ xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 				{
 					if( pxQueue->pxQueueSetContainer != NULL )
 					{
-						if( prvNotifyQueueSetContainer( pxQueue, xCopyPosition ) == pdTRUE )
+						if( prvNotifyQueueSetContainer( pxQueue ) == pdTRUE )
 						{
-							/* The queue is a member of a queue set, and posting
-							to the queue set caused a higher priority task to
-							unblock.  A context switch is required. */
+							/* The queue is a member of a queue set, and making
+							the queue ready in the set caused a higher priority
+							task to unblock.  A context switch is required. */
 							if( pxHigherPriorityTaskWoken != NULL )
 							{
 								*pxHigherPriorityTaskWoken = pdTRUE;
@@ -1038,6 +1531,9 @@ signed portBASE_TYPE xEntryTimeSet = pdFALSE;
 xTimeOutType xTimeOut;
 signed char *pcOriginalReadPosition;
 xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+#if ( configUSE_CEILING_MUTEXES == 1 )
+	unsigned long ulWaitStart = 0UL;
+#endif
 
 	configASSERT( pxQueue );
 	configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U ) ) );
@@ -1074,6 +1570,12 @@ xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 							/* Record the information required to implement
 							priority inheritance should it become necessary. */
 							pxQueue->pxMutexHolder = ( signed char * ) xTaskGetCurrentTaskHandle(); /*lint !e961 Cast is not redundant as xTaskHandle is a typedef. */
+
+							#if ( configUSE_CEILING_MUTEXES == 1 )
+							{
+								prvMutexTaken( pxQueue, xEntryTimeSet, ulWaitStart );
+							}
+							#endif
 						}
 					}
 					#endif
@@ -1127,6 +1629,12 @@ xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 					configure the timeout structure. */
 					vTaskSetTimeOutState( &xTimeOut );
 					xEntryTimeSet = pdTRUE;
+
+					#if ( configUSE_CEILING_MUTEXES == 1 )
+					{
+						ulWaitStart = prvGetMutexTime();
+					}
+					#endif
 				}
 				else
 				{
@@ -1180,6 +1688,21 @@ xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 		{
 			prvUnlockQueue( pxQueue );
 			( void ) xTaskResumeAll();
+
+			#if ( configUSE_CEILING_MUTEXES == 1 )
+			{
+				/* A wait that times out counts towards the longest wait. */
+				if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+				{
+					taskENTER_CRITICAL();
+					{
+						prvMutexWaitEnded( pxQueue, ulWaitStart, prvGetMutexTime() );
+					}
+					taskEXIT_CRITICAL();
+				}
+			}
+			#endif
+
 			traceQUEUE_RECEIVE_FAILED( pxQueue );
 			return errQUEUE_EMPTY;
 		}
@@ -1315,753 +1838,1766 @@ xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 }
 /*-----------------------------------------------------------*/
 
-unsigned portBASE_TYPE uxQueueMessagesWaiting( const xQueueHandle xQueue )
+unsigned portBASE_TYPE xQueueSendMultiple( xQueueHandle xQueue, const void * const pvItemsToQueue, unsigned portBASE_TYPE uxItemCount, portTickType xTicksToWait )
 {
-unsigned portBASE_TYPE uxReturn;
+signed portBASE_TYPE xEntryTimeSet = pdFALSE;
+xTimeOutType xTimeOut;
+unsigned portBASE_TYPE uxSent = ( unsigned portBASE_TYPE ) 0, uxCopied;
+const signed char * const pcItems = ( const signed char * ) pvItemsToQueue;
+xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 
-	configASSERT( xQueue );
+	configASSERT( pxQueue );
+	configASSERT( pvItemsToQueue );
 
-	taskENTER_CRITICAL();
-		uxReturn = ( ( xQUEUE * ) xQueue )->uxMessagesWaiting;
-	taskEXIT_CRITICAL();
+	/* Semaphores and mutexes do not hold items. */
+	configASSERT( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U );
 
-	return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+	/* This function relaxes the coding standard somewhat to allow return
+	statements within the function itself.  This is done in the interest
+	of execution time efficiency. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			/* Copy as many of the remaining items as there is room for, then
+			decide once whether the copy requires a context switch. */
+			uxCopied = prvCopyItemsToQueue( pxQueue, &( pcItems[ ( size_t ) uxSent * ( size_t ) pxQueue->uxItemSize ] ), uxItemCount - uxSent );
 
-unsigned portBASE_TYPE uxQueueMessagesWaitingFromISR( const xQueueHandle xQueue )
-{
-unsigned portBASE_TYPE uxReturn;
+			if( uxCopied > ( unsigned portBASE_TYPE ) 0 )
+			{
+				traceQUEUE_SEND( pxQueue );
+				uxSent += uxCopied;
 
-	configASSERT( xQueue );
+				if( prvUnblockReceivers( pxQueue, uxCopied ) != pdFALSE )
+				{
+					/* Yes it is ok to do this from within the critical
+					section - the kernel takes care of that. */
+					portYIELD_WITHIN_API();
+				}
+			}
 
-	uxReturn = ( ( xQUEUE * ) xQueue )->uxMessagesWaiting;
+			if( uxSent == uxItemCount )
+			{
+				taskEXIT_CRITICAL();
+				return uxSent;
+			}
+			else if( xTicksToWait == ( portTickType ) 0 )
+			{
+				/* The queue is full and no block time is specified (or the
+				block time has expired) so leave now. */
+				taskEXIT_CRITICAL();
+				traceQUEUE_SEND_FAILED( pxQueue );
+				return uxSent;
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				vTaskSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+			}
+			else
+			{
+				/* Entry time was already set. */
+			}
+		}
+		taskEXIT_CRITICAL();
 
-	return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+		/* Interrupts and other tasks can send to and receive from the queue
+		now the critical section has been exited. */
 
-void vQueueDelete( xQueueHandle xQueue )
-{
-xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
 
-	configASSERT( pxQueue );
+		/* Update the timeout state to see if it has expired yet. */
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueFull( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
 
-	traceQUEUE_DELETE( pxQueue );
-	#if ( configQUEUE_REGISTRY_SIZE > 0 )
-	{
-		vQueueUnregisterQueue( pxQueue );
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+			}
+			else
+			{
+				/* Try again. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* The timeout has expired. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+			traceQUEUE_SEND_FAILED( pxQueue );
+			return uxSent;
+		}
 	}
-	#endif
-	vPortFree( pxQueue->pcHead );
-	vPortFree( pxQueue );
 }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
-
-	unsigned char ucQueueGetQueueNumber( xQueueHandle xQueue )
-	{
-		return ( ( xQUEUE * ) xQueue )->ucQueueNumber;
-	}
-
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_TRACE_FACILITY == 1 )
-
-	void vQueueSetQueueNumber( xQueueHandle xQueue, unsigned char ucQueueNumber )
-	{
-		( ( xQUEUE * ) xQueue )->ucQueueNumber = ucQueueNumber;
-	}
+unsigned portBASE_TYPE xQueueSendMultipleFromISR( xQueueHandle xQueue, const void * const pvItemsToQueue, unsigned portBASE_TYPE uxItemCount, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+unsigned portBASE_TYPE uxCopied;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+	configASSERT( pxQueue );
+	configASSERT( pvItemsToQueue );
+	configASSERT( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U );
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+	/* See the comments in xQueueGenericSendFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-	unsigned char ucQueueGetQueueType( xQueueHandle xQueue )
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 	{
-		return ( ( xQUEUE * ) xQueue )->ucQueueType;
-	}
+		uxCopied = prvCopyItemsToQueue( pxQueue, ( const signed char * ) pvItemsToQueue, uxItemCount );
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
-
-static void prvCopyDataToQueue( xQUEUE *pxQueue, const void *pvItemToQueue, portBASE_TYPE xPosition )
-{
-	if( pxQueue->uxItemSize == ( unsigned portBASE_TYPE ) 0 )
-	{
-		#if ( configUSE_MUTEXES == 1 )
+		if( uxCopied > ( unsigned portBASE_TYPE ) 0 )
 		{
-			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+			traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+			/* If the queue is locked we do not alter the event list.  This
+			will be done when the queue is unlocked later. */
+			if( pxQueue->xTxLock == queueUNLOCKED )
 			{
-				/* The mutex is no longer being held. */
-				vTaskPriorityDisinherit( ( void * ) pxQueue->pxMutexHolder );
-				pxQueue->pxMutexHolder = NULL;
+				if( prvUnblockReceivers( pxQueue, uxCopied ) != pdFALSE )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+				}
+			}
+			else
+			{
+				/* Increase the lock count by the number of items so the task
+				that unlocks the queue can unblock a receiver for each. */
+				pxQueue->xTxLock += ( signed portBASE_TYPE ) uxCopied;
 			}
-		}
-		#endif /* configUSE_MUTEXES */
-	}
-	else if( xPosition == queueSEND_TO_BACK )
-	{
-		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0. */
-		pxQueue->pcWriteTo += pxQueue->uxItemSize;
-		if( pxQueue->pcWriteTo >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
-		{
-			pxQueue->pcWriteTo = pxQueue->pcHead;
-		}
-	}
-	else
-	{
-		( void ) memcpy( ( void * ) pxQueue->u.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-		pxQueue->u.pcReadFrom -= pxQueue->uxItemSize;
-		if( pxQueue->u.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
-		{
-			pxQueue->u.pcReadFrom = ( pxQueue->pcTail - pxQueue->uxItemSize );
 		}
 
-		if( xPosition == queueOVERWRITE )
+		if( uxCopied < uxItemCount )
 		{
-			if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0 )
-			{
-				/* An item is not being added but overwritten, so subtract
-				one from the recorded number of items in the queue so when
-				one is added again below the number of recorded items remains
-				correct. */
-				--( pxQueue->uxMessagesWaiting );
-			}
+			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
 		}
 	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-	++( pxQueue->uxMessagesWaiting );
+	return uxCopied;
 }
 /*-----------------------------------------------------------*/
 
-static void prvCopyDataFromQueue( xQUEUE * const pxQueue, const void * const pvBuffer )
+unsigned portBASE_TYPE xQueueReceiveMultiple( xQueueHandle xQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, portTickType xTicksToWait )
 {
-	if( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX )
+signed portBASE_TYPE xEntryTimeSet = pdFALSE;
+xTimeOutType xTimeOut;
+unsigned portBASE_TYPE uxCopied;
+xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( pvBuffer );
+	configASSERT( uxMaxItems > ( unsigned portBASE_TYPE ) 0U );
+	configASSERT( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U );
+
+	/* This function relaxes the coding standard somewhat to allow return
+	statements within the function itself.  This is done in the interest
+	of execution time efficiency. */
+	for( ;; )
 	{
-		pxQueue->u.pcReadFrom += pxQueue->uxItemSize;
-		if( pxQueue->u.pcReadFrom >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+		taskENTER_CRITICAL();
 		{
-			pxQueue->u.pcReadFrom = pxQueue->pcHead;
-		}
-		( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0. */
-	}
-}
-/*-----------------------------------------------------------*/
+			if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0 )
+			{
+				traceQUEUE_RECEIVE( pxQueue );
 
-static void prvUnlockQueue( xQUEUE *pxQueue )
-{
-	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
+				uxCopied = prvCopyItemsFromQueue( pxQueue, ( signed char * ) pvBuffer, uxMaxItems );
 
-	/* The lock counts contains the number of extra data items placed or
-	removed from the queue while the queue was locked.  When a queue is
-	locked items can be added or removed, but the event lists cannot be
-	updated. */
-	taskENTER_CRITICAL();
-	{
-		/* See if data was added to the queue while it was locked. */
-		while( pxQueue->xTxLock > queueLOCKED_UNMODIFIED )
-		{
-			/* Data was posted while the queue was locked.  Are any tasks
-			blocked waiting for data to become available? */
-			#if ( configUSE_QUEUE_SETS == 1 )
-			{
-				if( pxQueue->pxQueueSetContainer != NULL )
-				{
-					if( prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK ) == pdTRUE )
-					{
-						/* The queue is a member of a queue set, and posting to
-						the queue set caused a higher priority task to unblock.
-						A context switch is required. */
-						vTaskMissedYield();
-					}
-				}
-				else
+				if( prvUnblockSenders( pxQueue, uxCopied ) != pdFALSE )
 				{
-					/* Tasks that are removed from the event list will get added to
-					the pending ready list as the scheduler is still suspended. */
-					if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-					{
-						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-						{
-							/* The task waiting has a higher priority so record that a
-							context	switch is required. */
-							vTaskMissedYield();
-						}
-					}
-					else
-					{
-						break;
-					}
+					portYIELD_WITHIN_API();
 				}
+
+				taskEXIT_CRITICAL();
+				return uxCopied;
 			}
-			#else /* configUSE_QUEUE_SETS */
+			else
 			{
-				/* Tasks that are removed from the event list will get added to
-				the pending ready list as the scheduler is still suspended. */
-				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+				if( xTicksToWait == ( portTickType ) 0 )
 				{
-					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-					{
-						/* The task waiting has a higher priority so record that a
-						context	switch is required. */
-						vTaskMissedYield();
-					}
+					/* The queue was empty and no block time is specified (or
+					the block time has expired) so leave now. */
+					taskEXIT_CRITICAL();
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return ( unsigned portBASE_TYPE ) 0;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
 				}
 				else
 				{
-					break;
+					/* Entry time was already set. */
 				}
 			}
-			#endif /* configUSE_QUEUE_SETS */
-
-			--( pxQueue->xTxLock );
 		}
+		taskEXIT_CRITICAL();
 
-		pxQueue->xTxLock = queueUNLOCKED;
-	}
-	taskEXIT_CRITICAL();
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
 
-	/* Do the same for the Rx lock. */
-	taskENTER_CRITICAL();
-	{
-		while( pxQueue->xRxLock > queueLOCKED_UNMODIFIED )
+		/* Update the timeout state to see if it has expired yet. */
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
 		{
-			if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
 			{
-				if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+
+				if( xTaskResumeAll() == pdFALSE )
 				{
-					vTaskMissedYield();
+					portYIELD_WITHIN_API();
 				}
-
-				--( pxQueue->xRxLock );
 			}
 			else
 			{
-				break;
+				/* Try again. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
 			}
 		}
-
-		pxQueue->xRxLock = queueUNLOCKED;
+		else
+		{
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+			traceQUEUE_RECEIVE_FAILED( pxQueue );
+			return ( unsigned portBASE_TYPE ) 0;
+		}
 	}
-	taskEXIT_CRITICAL();
 }
 /*-----------------------------------------------------------*/
 
-static signed portBASE_TYPE prvIsQueueEmpty( const xQUEUE *pxQueue )
+unsigned portBASE_TYPE xQueueReceiveMultipleFromISR( xQueueHandle xQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
 {
-signed portBASE_TYPE xReturn;
+unsigned portBASE_TYPE uxCopied;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 
-	taskENTER_CRITICAL();
+	configASSERT( pxQueue );
+	configASSERT( pvBuffer );
+	configASSERT( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U );
+
+	/* See the comments in xQueueReceiveFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 	{
-		if( pxQueue->uxMessagesWaiting == ( unsigned portBASE_TYPE )  0 )
+		uxCopied = prvCopyItemsFromQueue( pxQueue, ( signed char * ) pvBuffer, uxMaxItems );
+
+		if( uxCopied > ( unsigned portBASE_TYPE ) 0 )
 		{
-			xReturn = pdTRUE;
+			traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+			/* If the queue is locked the event list will not be modified.
+			Instead increase the lock count by the number of items so the task
+			that unlocks the queue can unblock a sender for each. */
+			if( pxQueue->xRxLock == queueUNLOCKED )
+			{
+				if( prvUnblockSenders( pxQueue, uxCopied ) != pdFALSE )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+				}
+			}
+			else
+			{
+				pxQueue->xRxLock += ( signed portBASE_TYPE ) uxCopied;
+			}
 		}
 		else
 		{
-			xReturn = pdFALSE;
+			traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
 		}
 	}
-	taskEXIT_CRITICAL();
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-	return xReturn;
+	return uxCopied;
 }
 /*-----------------------------------------------------------*/
 
-signed portBASE_TYPE xQueueIsQueueEmptyFromISR( const xQueueHandle xQueue )
+unsigned portBASE_TYPE uxQueueMessagesWaiting( const xQueueHandle xQueue )
 {
-signed portBASE_TYPE xReturn;
+unsigned portBASE_TYPE uxReturn;
 
 	configASSERT( xQueue );
-	if( ( ( xQUEUE * ) xQueue )->uxMessagesWaiting == ( unsigned portBASE_TYPE ) 0 )
-	{
-		xReturn = pdTRUE;
-	}
-	else
-	{
-		xReturn = pdFALSE;
-	}
 
-	return xReturn;
-} /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
+	taskENTER_CRITICAL();
+		uxReturn = ( ( xQUEUE * ) xQueue )->uxMessagesWaiting;
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
 /*-----------------------------------------------------------*/
 
-static signed portBASE_TYPE prvIsQueueFull( const xQUEUE *pxQueue )
+unsigned portBASE_TYPE uxQueueMessagesWaitingFromISR( const xQueueHandle xQueue )
 {
-signed portBASE_TYPE xReturn;
+unsigned portBASE_TYPE uxReturn;
 
-	taskENTER_CRITICAL();
+	configASSERT( xQueue );
+
+	uxReturn = ( ( xQUEUE * ) xQueue )->uxMessagesWaiting;
+
+	return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( xQueueHandle xQueue )
+{
+xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+
+	configASSERT( pxQueue );
+
+	traceQUEUE_DELETE( pxQueue );
+	#if ( configUSE_QUEUE_SETS == 1 )
 	{
-		if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
-		{
-			xReturn = pdTRUE;
-		}
-		else
+		/* A member must not be left in the ready list of its set. */
+		if( pxQueue->pxQueueSetContainer != NULL )
 		{
-			xReturn = pdFALSE;
+			taskENTER_CRITICAL();
+			{
+				prvRemoveReadyMember( pxQueue );
+			}
+			taskEXIT_CRITICAL();
 		}
 	}
-	taskEXIT_CRITICAL();
+	#endif
+	#if ( configQUEUE_REGISTRY_SIZE > 0 )
+	{
+		vQueueUnregisterQueue( pxQueue );
+	}
+	#endif
 
-	return xReturn;
+	/* Memory provided by the application when the queue was created is not
+	freed. */
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		if( pxQueue->ucStaticallyAllocated == pdFALSE )
+	#endif
+	{
+		vPortFree( pxQueue->pcHead );
+		vPortFree( pxQueue );
+	}
 }
 /*-----------------------------------------------------------*/
 
-signed portBASE_TYPE xQueueIsQueueFullFromISR( const xQueueHandle xQueue )
-{
-signed portBASE_TYPE xReturn;
+#if ( configUSE_TRACE_FACILITY == 1 )
 
-	configASSERT( xQueue );
-	if( ( ( xQUEUE * ) xQueue )->uxMessagesWaiting == ( ( xQUEUE * ) xQueue )->uxLength )
+	unsigned char ucQueueGetQueueNumber( xQueueHandle xQueue )
 	{
-		xReturn = pdTRUE;
+		return ( ( xQUEUE * ) xQueue )->ucQueueNumber;
 	}
-	else
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	void vQueueSetQueueNumber( xQueueHandle xQueue, unsigned char ucQueueNumber )
 	{
-		xReturn = pdFALSE;
+		( ( xQUEUE * ) xQueue )->ucQueueNumber = ucQueueNumber;
 	}
 
-	return xReturn;
-} /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
+#endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_CO_ROUTINES == 1 )
+#if ( configUSE_TRACE_FACILITY == 1 )
 
-	signed portBASE_TYPE xQueueCRSend( xQueueHandle xQueue, const void *pvItemToQueue, portTickType xTicksToWait )
+	unsigned char ucQueueGetQueueType( xQueueHandle xQueue )
 	{
-	signed portBASE_TYPE xReturn;
-	xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+		return ( ( xQUEUE * ) xQueue )->ucQueueType;
+	}
 
-		/* If the queue is already full we may have to block.  A critical section
-		is required to prevent an interrupt removing something from the queue
-		between the check to see if the queue is full and blocking on the queue. */
-		portDISABLE_INTERRUPTS();
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+static void prvCopyDataToQueue( xQUEUE *pxQueue, const void *pvItemToQueue, portBASE_TYPE xPosition )
+{
+	if( pxQueue->uxItemSize == ( unsigned portBASE_TYPE ) 0 )
+	{
+		#if ( configUSE_MUTEXES == 1 )
 		{
-			if( prvIsQueueFull( pxQueue ) != pdFALSE )
+			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
 			{
-				/* The queue is full - do we want to block or just leave without
-				posting? */
-				if( xTicksToWait > ( portTickType ) 0 )
+				#if ( configUSE_CEILING_MUTEXES == 1 )
 				{
-					/* As this is called from a coroutine we cannot block directly, but
-					return indicating that we need to block. */
-					vCoRoutineAddToDelayedList( xTicksToWait, &( pxQueue->xTasksWaitingToSend ) );
-					portENABLE_INTERRUPTS();
-					return errQUEUE_BLOCKED;
-				}
-				else
-				{
-					portENABLE_INTERRUPTS();
-					return errQUEUE_FULL;
+					prvMutexGiven( pxQueue );
 				}
+				#endif
+
+				/* The mutex is no longer being held. */
+				vTaskPriorityDisinherit( ( void * ) pxQueue->pxMutexHolder );
+				pxQueue->pxMutexHolder = NULL;
 			}
 		}
-		portENABLE_INTERRUPTS();
+		#endif /* configUSE_MUTEXES */
+	}
+	else if( xPosition == queueSEND_TO_BACK )
+	{
+		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0. */
+		pxQueue->pcWriteTo += pxQueue->uxItemSize;
+		if( pxQueue->pcWriteTo >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+		{
+			pxQueue->pcWriteTo = pxQueue->pcHead;
+		}
+	}
+	else
+	{
+		( void ) memcpy( ( void * ) pxQueue->u.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		pxQueue->u.pcReadFrom -= pxQueue->uxItemSize;
+		if( pxQueue->u.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+		{
+			pxQueue->u.pcReadFrom = ( pxQueue->pcTail - pxQueue->uxItemSize );
+		}
+
+		if( xPosition == queueOVERWRITE )
+		{
+			if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0 )
+			{
+				/* An item is not being added but overwritten, so subtract
+				one from the recorded number of items in the queue so when
+				one is added again below the number of recorded items remains
+				correct. */
+				--( pxQueue->uxMessagesWaiting );
+			}
+		}
+	}
+
+	++( pxQueue->uxMessagesWaiting );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyDataFromQueue( xQUEUE * const pxQueue, const void * const pvBuffer )
+{
+	if( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX )
+	{
+		pxQueue->u.pcReadFrom += pxQueue->uxItemSize;
+		if( pxQueue->u.pcReadFrom >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+		{
+			pxQueue->u.pcReadFrom = pxQueue->pcHead;
+		}
+		( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0. */
+	}
+}
+/*-----------------------------------------------------------*/
+
+static unsigned portBASE_TYPE prvCopyItemsToQueue( xQUEUE * const pxQueue, const signed char *pcItems, unsigned portBASE_TYPE uxCount )
+{
+size_t xBytes, xBytesToEnd;
+
+	if( uxCount > ( pxQueue->uxLength - pxQueue->uxMessagesWaiting ) )
+	{
+		uxCount = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+	}
+
+	xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+	xBytesToEnd = ( size_t ) ( pxQueue->pcTail - pxQueue->pcWriteTo );
+
+	if( xBytes < xBytesToEnd )
+	{
+		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xBytes );
+		pxQueue->pcWriteTo += xBytes;
+	}
+	else
+	{
+		/* The items reach the end of the storage area, so the rest are
+		written from the start of the storage area. */
+		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xBytesToEnd );
+		( void ) memcpy( ( void * ) pxQueue->pcHead, ( const void * ) &( pcItems[ xBytesToEnd ] ), xBytes - xBytesToEnd );
+		pxQueue->pcWriteTo = pxQueue->pcHead + ( xBytes - xBytesToEnd );
+	}
+
+	pxQueue->uxMessagesWaiting += uxCount;
+
+	return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned portBASE_TYPE prvCopyItemsFromQueue( xQUEUE * const pxQueue, signed char *pcBuffer, unsigned portBASE_TYPE uxCount )
+{
+size_t xBytes, xBytesToEnd;
+signed char *pcReadFrom;
+
+	if( uxCount > pxQueue->uxMessagesWaiting )
+	{
+		uxCount = pxQueue->uxMessagesWaiting;
+	}
+
+	if( uxCount > ( unsigned portBASE_TYPE ) 0 )
+	{
+		/* u.pcReadFrom points to the last item read, not the next. */
+		pcReadFrom = pxQueue->u.pcReadFrom + pxQueue->uxItemSize;
+		if( pcReadFrom >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+		{
+			pcReadFrom = pxQueue->pcHead;
+		}
+
+		xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+		xBytesToEnd = ( size_t ) ( pxQueue->pcTail - pcReadFrom );
+
+		if( xBytes <= xBytesToEnd )
+		{
+			( void ) memcpy( ( void * ) pcBuffer, ( const void * ) pcReadFrom, xBytes );
+			pxQueue->u.pcReadFrom = pcReadFrom + ( xBytes - pxQueue->uxItemSize );
+		}
+		else
+		{
+			( void ) memcpy( ( void * ) pcBuffer, ( const void * ) pcReadFrom, xBytesToEnd );
+			( void ) memcpy( ( void * ) &( pcBuffer[ xBytesToEnd ] ), ( const void * ) pxQueue->pcHead, xBytes - xBytesToEnd );
+			pxQueue->u.pcReadFrom = pxQueue->pcHead + ( ( xBytes - xBytesToEnd ) - pxQueue->uxItemSize );
+		}
+
+		pxQueue->uxMessagesWaiting -= uxCount;
+	}
+
+	return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvUnblockReceivers( xQUEUE * const pxQueue, unsigned portBASE_TYPE uxCount )
+{
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	#if ( configUSE_QUEUE_SETS == 1 )
+	{
+		if( pxQueue->pxQueueSetContainer != NULL )
+		{
+			/* The set only records that the queue contains data, however
+			many items were added.  As for single items, tasks blocked on
+			the member itself are not unblocked. */
+			if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+			{
+				xHigherPriorityTaskWoken = pdTRUE;
+			}
+
+			uxCount = ( unsigned portBASE_TYPE ) 0;
+		}
+	}
+	#endif /* configUSE_QUEUE_SETS */
+
+	while( ( uxCount > ( unsigned portBASE_TYPE ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+	{
+		if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+		{
+			xHigherPriorityTaskWoken = pdTRUE;
+		}
+
+		uxCount--;
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvUnblockSenders( xQUEUE * const pxQueue, unsigned portBASE_TYPE uxCount )
+{
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	while( ( uxCount > ( unsigned portBASE_TYPE ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+	{
+		if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+		{
+			xHigherPriorityTaskWoken = pdTRUE;
+		}
+
+		uxCount--;
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUnlockQueue( xQUEUE *pxQueue )
+{
+	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
+
+	/* The lock counts contains the number of extra data items placed or
+	removed from the queue while the queue was locked.  When a queue is
+	locked items can be added or removed, but the event lists cannot be
+	updated. */
+	taskENTER_CRITICAL();
+	{
+		/* See if data was added to the queue while it was locked. */
+		while( pxQueue->xTxLock > queueLOCKED_UNMODIFIED )
+		{
+			/* Data was posted while the queue was locked.  Are any tasks
+			blocked waiting for data to become available? */
+			#if ( configUSE_QUEUE_SETS == 1 )
+			{
+				if( pxQueue->pxQueueSetContainer != NULL )
+				{
+					if( prvNotifyQueueSetContainer( pxQueue ) == pdTRUE )
+					{
+						/* The queue is a member of a queue set, and making the
+						queue ready in the set caused a higher priority task to
+						unblock.  A context switch is required. */
+						vTaskMissedYield();
+					}
+
+					/* One notification covers every item posted while the
+					queue was locked. */
+					break;
+				}
+				else
+				{
+					/* Tasks that are removed from the event list will get added to
+					the pending ready list as the scheduler is still suspended. */
+					if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+					{
+						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+						{
+							/* The task waiting has a higher priority so record that a
+							context	switch is required. */
+							vTaskMissedYield();
+						}
+					}
+					else
+					{
+						break;
+					}
+				}
+			}
+			#else /* configUSE_QUEUE_SETS */
+			{
+				/* Tasks that are removed from the event list will get added to
+				the pending ready list as the scheduler is still suspended. */
+				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+				{
+					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+					{
+						/* The task waiting has a higher priority so record that a
+						context	switch is required. */
+						vTaskMissedYield();
+					}
+				}
+				else
+				{
+					break;
+				}
+			}
+			#endif /* configUSE_QUEUE_SETS */
+
+			--( pxQueue->xTxLock );
+		}
+
+		pxQueue->xTxLock = queueUNLOCKED;
+	}
+	taskEXIT_CRITICAL();
+
+	/* Do the same for the Rx lock. */
+	taskENTER_CRITICAL();
+	{
+		while( pxQueue->xRxLock > queueLOCKED_UNMODIFIED )
+		{
+			if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+			{
+				if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+				{
+					vTaskMissedYield();
+				}
+
+				--( pxQueue->xRxLock );
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		pxQueue->xRxLock = queueUNLOCKED;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static signed portBASE_TYPE prvIsQueueEmpty( const xQUEUE *pxQueue )
+{
+signed portBASE_TYPE xReturn;
+
+	taskENTER_CRITICAL();
+	{
+		if( pxQueue->uxMessagesWaiting == ( unsigned portBASE_TYPE )  0 )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xQueueIsQueueEmptyFromISR( const xQueueHandle xQueue )
+{
+signed portBASE_TYPE xReturn;
+
+	configASSERT( xQueue );
+	if( ( ( xQUEUE * ) xQueue )->uxMessagesWaiting == ( unsigned portBASE_TYPE ) 0 )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+} /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
+/*-----------------------------------------------------------*/
+
+static signed portBASE_TYPE prvIsQueueFull( const xQUEUE *pxQueue )
+{
+signed portBASE_TYPE xReturn;
+
+	taskENTER_CRITICAL();
+	{
+		if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xQueueIsQueueFullFromISR( const xQueueHandle xQueue )
+{
+signed portBASE_TYPE xReturn;
+
+	configASSERT( xQueue );
+	if( ( ( xQUEUE * ) xQueue )->uxMessagesWaiting == ( ( xQUEUE * ) xQueue )->uxLength )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+} /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CO_ROUTINES == 1 )
+
+	signed portBASE_TYPE xQueueCRSend( xQueueHandle xQueue, const void *pvItemToQueue, portTickType xTicksToWait )
+	{
+	signed portBASE_TYPE xReturn;
+	xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+
+		/* If the queue is already full we may have to block.  A critical section
+		is required to prevent an interrupt removing something from the queue
+		between the check to see if the queue is full and blocking on the queue. */
+		portDISABLE_INTERRUPTS();
+		{
+			if( prvIsQueueFull( pxQueue ) != pdFALSE )
+			{
+				/* The queue is full - do we want to block or just leave without
+				posting? */
+				if( xTicksToWait > ( portTickType ) 0 )
+				{
+					/* As this is called from a coroutine we cannot block directly, but
+					return indicating that we need to block. */
+					vCoRoutineAddToDelayedList( xTicksToWait, &( pxQueue->xTasksWaitingToSend ) );
+					portENABLE_INTERRUPTS();
+					return errQUEUE_BLOCKED;
+				}
+				else
+				{
+					portENABLE_INTERRUPTS();
+					return errQUEUE_FULL;
+				}
+			}
+		}
+		portENABLE_INTERRUPTS();
+
+		portDISABLE_INTERRUPTS();
+		{
+			if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+			{
+				/* There is room in the queue, copy the data into the queue. */
+				prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK );
+				xReturn = pdPASS;
+
+				/* Were any co-routines waiting for data to become available? */
+				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+				{
+					/* In this instance the co-routine could be placed directly
+					into the ready list as we are within a critical section.
+					Instead the same pending ready list mechanism is used as if
+					the event were caused from within an interrupt. */
+					if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+					{
+						/* The co-routine waiting has a higher priority so record
+						that a yield might be appropriate. */
+						xReturn = errQUEUE_YIELD;
+					}
+				}
+			}
+			else
+			{
+				xReturn = errQUEUE_FULL;
+			}
+		}
+		portENABLE_INTERRUPTS();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_CO_ROUTINES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CO_ROUTINES == 1 )
+
+	signed portBASE_TYPE xQueueCRReceive( xQueueHandle xQueue, void *pvBuffer, portTickType xTicksToWait )
+	{
+	signed portBASE_TYPE xReturn;
+	xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+
+		/* If the queue is already empty we may have to block.  A critical section
+		is required to prevent an interrupt adding something to the queue
+		between the check to see if the queue is empty and blocking on the queue. */
+		portDISABLE_INTERRUPTS();
+		{
+			if( pxQueue->uxMessagesWaiting == ( unsigned portBASE_TYPE ) 0 )
+			{
+				/* There are no messages in the queue, do we want to block or just
+				leave with nothing? */
+				if( xTicksToWait > ( portTickType ) 0 )
+				{
+					/* As this is a co-routine we cannot block directly, but return
+					indicating that we need to block. */
+					vCoRoutineAddToDelayedList( xTicksToWait, &( pxQueue->xTasksWaitingToReceive ) );
+					portENABLE_INTERRUPTS();
+					return errQUEUE_BLOCKED;
+				}
+				else
+				{
+					portENABLE_INTERRUPTS();
+					return errQUEUE_FULL;
+				}
+			}
+		}
+		portENABLE_INTERRUPTS();
+
+		portDISABLE_INTERRUPTS();
+		{
+			if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0 )
+			{
+				/* Data is available from the queue. */
+				pxQueue->u.pcReadFrom += pxQueue->uxItemSize;
+				if( pxQueue->u.pcReadFrom >= pxQueue->pcTail )
+				{
+					pxQueue->u.pcReadFrom = pxQueue->pcHead;
+				}
+				--( pxQueue->uxMessagesWaiting );
+				( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+
+				xReturn = pdPASS;
+
+				/* Were any co-routines waiting for space to become available? */
+				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+				{
+					/* In this instance the co-routine could be placed directly
+					into the ready list as we are within a critical section.
+					Instead the same pending ready list mechanism is used as if
+					the event were caused from within an interrupt. */
+					if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+					{
+						xReturn = errQUEUE_YIELD;
+					}
+				}
+			}
+			else
+			{
+				xReturn = pdFAIL;
+			}
+		}
+		portENABLE_INTERRUPTS();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_CO_ROUTINES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CO_ROUTINES == 1 )
+
+	signed portBASE_TYPE xQueueCRSendFromISR( xQueueHandle xQueue, const void *pvItemToQueue, signed portBASE_TYPE xCoRoutinePreviouslyWoken )
+	{
+	xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+
+		/* Cannot block within an ISR so if there is no space on the queue then
+		exit without doing anything. */
+		if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+		{
+			prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK );
+
+			/* We only want to wake one co-routine per ISR, so check that a
+			co-routine has not already been woken. */
+			if( xCoRoutinePreviouslyWoken == pdFALSE )
+			{
+				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+				{
+					if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+					{
+						return pdTRUE;
+					}
+				}
+			}
+		}
+
+		return xCoRoutinePreviouslyWoken;
+	}
+
+#endif /* configUSE_CO_ROUTINES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CO_ROUTINES == 1 )
+
+	signed portBASE_TYPE xQueueCRReceiveFromISR( xQueueHandle xQueue, void *pvBuffer, signed portBASE_TYPE *pxCoRoutineWoken )
+	{
+	signed portBASE_TYPE xReturn;
+	xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+
+		/* We cannot block from an ISR, so check there is data available. If
+		not then just leave without doing anything. */
+		if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0 )
+		{
+			/* Copy the data from the queue. */
+			pxQueue->u.pcReadFrom += pxQueue->uxItemSize;
+			if( pxQueue->u.pcReadFrom >= pxQueue->pcTail )
+			{
+				pxQueue->u.pcReadFrom = pxQueue->pcHead;
+			}
+			--( pxQueue->uxMessagesWaiting );
+			( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+
+			if( ( *pxCoRoutineWoken ) == pdFALSE )
+			{
+				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+				{
+					if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+					{
+						*pxCoRoutineWoken = pdTRUE;
+					}
+				}
+			}
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_CO_ROUTINES */
+/*-----------------------------------------------------------*/
+
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+
+	void vQueueAddToRegistry( xQueueHandle xQueue, signed char *pcQueueName )
+	{
+	unsigned portBASE_TYPE ux;
+
+		/* See if there is an empty space in the registry.  A NULL name denotes
+		a free slot. */
+		for( ux = ( unsigned portBASE_TYPE ) 0U; ux < ( unsigned portBASE_TYPE ) configQUEUE_REGISTRY_SIZE; ux++ )
+		{
+			if( xQueueRegistry[ ux ].pcQueueName == NULL )
+			{
+				/* Store the information on this queue. */
+				xQueueRegistry[ ux ].pcQueueName = pcQueueName;
+				xQueueRegistry[ ux ].xHandle = xQueue;
+				break;
+			}
+		}
+	}
+
+#endif /* configQUEUE_REGISTRY_SIZE */
+/*-----------------------------------------------------------*/
+
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+
+	void vQueueUnregisterQueue( xQueueHandle xQueue )
+	{
+	unsigned portBASE_TYPE ux;
+
+		/* See if the handle of the queue being unregistered in actually in the
+		registry. */
+		for( ux = ( unsigned portBASE_TYPE ) 0U; ux < ( unsigned portBASE_TYPE ) configQUEUE_REGISTRY_SIZE; ux++ )
+		{
+			if( xQueueRegistry[ ux ].xHandle == xQueue )
+			{
+				/* Set the name to NULL to show that this slot if free again. */
+				xQueueRegistry[ ux ].pcQueueName = NULL;
+				break;
+			}
+		}
+
+	} /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
+
+#endif /* configQUEUE_REGISTRY_SIZE */
+/*-----------------------------------------------------------*/
 
-		portDISABLE_INTERRUPTS();
+#if ( configUSE_TIMERS == 1 )
+
+	void vQueueWaitForMessageRestricted( xQueueHandle xQueue, portTickType xTicksToWait )
+	{
+	xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+
+		/* This function should not be called by application code hence the
+		'Restricted' in its name.  It is not part of the public API.  It is
+		designed for use by kernel code, and has special calling requirements.
+		It can result in vListInsert() being called on a list that can only
+		possibly ever have one item in it, so the list will be fast, but even
+		so it should be called with the scheduler locked and not from a critical
+		section. */
+
+		/* Only do anything if there are no messages in the queue.  This function
+		will not actually cause the task to block, just place it on a blocked
+		list.  It will not block until the scheduler is unlocked - at which
+		time a yield will be performed.  If an item is added to the queue while
+		the queue is locked, and the calling task blocks on the queue, then the
+		calling task will be immediately unblocked when the queue is unlocked. */
+		prvLockQueue( pxQueue );
+		if( pxQueue->uxMessagesWaiting == ( unsigned portBASE_TYPE ) 0U )
 		{
-			if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+			/* There is nothing in the queue, block for the specified period. */
+			vTaskPlaceOnEventListRestricted( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+		}
+		prvUnlockQueue( pxQueue );
+	}
+
+#endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	xQueueSetHandle xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength )
+	{
+	xQUEUE *pxQueueSet;
+
+		/* The set holds a list of its ready members, not an event for each
+		item, so its size does not depend on the length of its members. */
+		( void ) uxEventQueueLength;
+
+		pxQueueSet = ( xQUEUE * ) xQueueGenericCreate( ( unsigned portBASE_TYPE ) 1, ( unsigned portBASE_TYPE ) sizeof( xList ), queueQUEUE_TYPE_SET );
+
+		if( pxQueueSet != NULL )
+		{
+			vListInitialise( queueSET_READY_LIST( pxQueueSet ) );
+		}
+
+		return ( xQueueSetHandle ) pxQueueSet;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	portBASE_TYPE xQueueAddToSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet )
+	{
+	portBASE_TYPE xReturn;
+	xQUEUE * const pxQueueOrSemaphore = ( xQUEUE * ) xQueueOrSemaphore;
+
+		taskENTER_CRITICAL();
+		{
+			if( pxQueueOrSemaphore->pxQueueSetContainer != NULL )
 			{
-				/* There is room in the queue, copy the data into the queue. */
-				prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK );
-				xReturn = pdPASS;
+				/* Cannot add a queue/semaphore to more than one queue set. */
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				pxQueueOrSemaphore->pxQueueSetContainer = ( xQUEUE * ) xQueueSet;
 
-				/* Were any co-routines waiting for data to become available? */
-				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+				/* A queue that already contains data, or a semaphore that is
+				already available, is ready as soon as it is added. */
+				if( pxQueueOrSemaphore->uxMessagesWaiting != ( unsigned portBASE_TYPE ) 0 )
 				{
-					/* In this instance the co-routine could be placed directly
-					into the ready list as we are within a critical section.
-					Instead the same pending ready list mechanism is used as if
-					the event were caused from within an interrupt. */
-					if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+					if( prvNotifyQueueSetContainer( pxQueueOrSemaphore ) == pdTRUE )
 					{
-						/* The co-routine waiting has a higher priority so record
-						that a yield might be appropriate. */
-						xReturn = errQUEUE_YIELD;
+						portYIELD_WITHIN_API();
 					}
 				}
+
+				xReturn = pdPASS;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	portBASE_TYPE xQueueRemoveFromSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet )
+	{
+	portBASE_TYPE xReturn;
+	xQUEUE * const pxQueueOrSemaphore = ( xQUEUE * ) xQueueOrSemaphore;
+
+		taskENTER_CRITICAL();
+		{
+			if( pxQueueOrSemaphore->pxQueueSetContainer != ( xQUEUE * ) xQueueSet )
+			{
+				/* The queue was not a member of the set. */
+				xReturn = pdFAIL;
 			}
 			else
 			{
-				xReturn = errQUEUE_FULL;
+				/* The queue is no longer contained in the set, so must not be
+				returned by xQueueSelectFromSet(). */
+				prvRemoveReadyMember( pxQueueOrSemaphore );
+				pxQueueOrSemaphore->pxQueueSetContainer = NULL;
+				xReturn = pdPASS;
 			}
 		}
-		portENABLE_INTERRUPTS();
+		taskEXIT_CRITICAL();
 
 		return xReturn;
-	}
+	} /*lint !e818 xQueueSet could not be declared as pointing to const as it is a typedef. */
 
-#endif /* configUSE_CO_ROUTINES */
+#endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_CO_ROUTINES == 1 )
+#if ( configUSE_QUEUE_SETS == 1 )
 
-	signed portBASE_TYPE xQueueCRReceive( xQueueHandle xQueue, void *pvBuffer, portTickType xTicksToWait )
+	xQueueSetMemberHandle xQueueSelectFromSet( xQueueSetHandle xQueueSet, portTickType xBlockTimeTicks )
 	{
-	signed portBASE_TYPE xReturn;
-	xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+	signed portBASE_TYPE xEntryTimeSet = pdFALSE;
+	xTimeOutType xTimeOut;
+	xQUEUE * const pxQueueSet = ( xQUEUE * ) xQueueSet;
+	xQUEUE *pxMember;
 
-		/* If the queue is already empty we may have to block.  A critical section
-		is required to prevent an interrupt adding something to the queue
-		between the check to see if the queue is empty and blocking on the queue. */
-		portDISABLE_INTERRUPTS();
+		configASSERT( pxQueueSet );
+
+		/* This function relaxes the coding standard somewhat to allow return
+		statements within the function itself.  This is done in the interest
+		of execution time efficiency. */
+
+		for( ;; )
 		{
-			if( pxQueue->uxMessagesWaiting == ( unsigned portBASE_TYPE ) 0 )
+			taskENTER_CRITICAL();
 			{
-				/* There are no messages in the queue, do we want to block or just
-				leave with nothing? */
-				if( xTicksToWait > ( portTickType ) 0 )
+				pxMember = prvGetReadyMember( pxQueueSet );
+
+				if( pxMember != NULL )
 				{
-					/* As this is a co-routine we cannot block directly, but return
-					indicating that we need to block. */
-					vCoRoutineAddToDelayedList( xTicksToWait, &( pxQueue->xTasksWaitingToReceive ) );
-					portENABLE_INTERRUPTS();
-					return errQUEUE_BLOCKED;
+					traceQUEUE_RECEIVE( pxQueueSet );
+
+					/* The member stays in the ready list until it is found to
+					be empty, so any other task selecting from the set is
+					unblocked to look for a ready member itself. */
+					if( listLIST_IS_EMPTY( &( pxQueueSet->xTasksWaitingToReceive ) ) == pdFALSE )
+					{
+						if( xTaskRemoveFromEventList( &( pxQueueSet->xTasksWaitingToReceive ) ) == pdTRUE )
+						{
+							portYIELD_WITHIN_API();
+						}
+					}
+
+					taskEXIT_CRITICAL();
+					return ( xQueueSetMemberHandle ) pxMember;
+				}
+				else if( xBlockTimeTicks == ( portTickType ) 0 )
+				{
+					/* No member was ready and no block time is specified (or
+					the block time has expired) so leave now. */
+					taskEXIT_CRITICAL();
+					traceQUEUE_RECEIVE_FAILED( pxQueueSet );
+					return NULL;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
 				}
 				else
 				{
-					portENABLE_INTERRUPTS();
-					return errQUEUE_FULL;
+					/* Entry time was already set. */
 				}
 			}
-		}
-		portENABLE_INTERRUPTS();
+			taskEXIT_CRITICAL();
 
-		portDISABLE_INTERRUPTS();
-		{
-			if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0 )
+			/* Members can become ready now the critical section has been
+			exited.  They are added to the ready list while the set is
+			locked, but the event list of the set is only updated when the
+			set is unlocked. */
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueueSet );
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xBlockTimeTicks ) == pdFALSE )
 			{
-				/* Data is available from the queue. */
-				pxQueue->u.pcReadFrom += pxQueue->uxItemSize;
-				if( pxQueue->u.pcReadFrom >= pxQueue->pcTail )
+				if( prvIsQueueEmpty( pxQueueSet ) != pdFALSE )
 				{
-					pxQueue->u.pcReadFrom = pxQueue->pcHead;
+					traceBLOCKING_ON_QUEUE_RECEIVE( pxQueueSet );
+					vTaskPlaceOnEventList( &( pxQueueSet->xTasksWaitingToReceive ), xBlockTimeTicks );
+					prvUnlockQueue( pxQueueSet );
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
 				}
-				--( pxQueue->uxMessagesWaiting );
-				( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+				else
+				{
+					/* Try again. */
+					prvUnlockQueue( pxQueueSet );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				prvUnlockQueue( pxQueueSet );
+				( void ) xTaskResumeAll();
+				traceQUEUE_RECEIVE_FAILED( pxQueueSet );
+				return NULL;
+			}
+		}
+	}
 
-				xReturn = pdPASS;
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
 
-				/* Were any co-routines waiting for space to become available? */
-				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	xQueueSetMemberHandle xQueueSelectFromSetFromISR( xQueueSetHandle xQueueSet )
+	{
+	xQUEUE *pxMember;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+		configASSERT( xQueueSet );
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			pxMember = prvGetReadyMember( ( xQUEUE * ) xQueueSet );
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return ( xQueueSetMemberHandle ) pxMember;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	static portBASE_TYPE prvNotifyQueueSetContainer( xQUEUE * const pxQueue )
+	{
+	xQUEUE *pxQueueSetContainer = pxQueue->pxQueueSetContainer;
+	portBASE_TYPE xReturn = pdFALSE;
+
+		configASSERT( pxQueueSetContainer );
+
+		/* Nothing needs doing if the queue is already in the ready list, so
+		the cost does not depend on the number of items posted or on the
+		number of members in the set. */
+		if( listIS_CONTAINED_WITHIN( NULL, &( pxQueue->xQueueSetItem ) ) != pdFALSE )
+		{
+			traceQUEUE_SEND( pxQueueSetContainer );
+
+			/* Added behind the members that are already ready, so members
+			are selected in the order they became ready. */
+			vListInsertEnd( queueSET_READY_LIST( pxQueueSetContainer ), &( pxQueue->xQueueSetItem ) );
+			++( pxQueueSetContainer->uxMessagesWaiting );
+
+			/* If the set is locked a task is blocking on it, and the event
+			list of the set cannot be altered.  The task that unlocks the set
+			will see the lock count and unblock a waiting task. */
+			if( pxQueueSetContainer->xTxLock == queueUNLOCKED )
+			{
+				if( listLIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
 				{
-					/* In this instance the co-routine could be placed directly
-					into the ready list as we are within a critical section.
-					Instead the same pending ready list mechanism is used as if
-					the event were caused from within an interrupt. */
-					if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+					if( xTaskRemoveFromEventList( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
 					{
-						xReturn = errQUEUE_YIELD;
+						/* The task waiting has a higher priority */
+						xReturn = pdTRUE;
 					}
 				}
 			}
 			else
 			{
-				xReturn = pdFAIL;
+				++( pxQueueSetContainer->xTxLock );
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	static xQUEUE *prvGetReadyMember( xQUEUE * const pxQueueSet )
+	{
+	xList * const pxReadyList = queueSET_READY_LIST( pxQueueSet );
+	xQUEUE *pxMember = NULL;
+
+		/* Walking the list returns the ready members in turn, so a member
+		that always contains data cannot starve the others.  A member is not
+		removed when it is read, only when it is found here to be empty, so
+		each member added to the list costs at most one extra pass of this
+		loop. */
+		while( listLIST_IS_EMPTY( pxReadyList ) == pdFALSE )
+		{
+			listGET_OWNER_OF_NEXT_ENTRY( pxMember, pxReadyList );
+
+			if( pxMember->uxMessagesWaiting != ( unsigned portBASE_TYPE ) 0 )
+			{
+				break;
 			}
+
+			prvRemoveReadyMember( pxMember );
+			pxMember = NULL;
+		}
+
+		return pxMember;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	static void prvRemoveReadyMember( xQUEUE * const pxQueue )
+	{
+		if( listIS_CONTAINED_WITHIN( NULL, &( pxQueue->xQueueSetItem ) ) == pdFALSE )
+		{
+			( void ) uxListRemove( &( pxQueue->xQueueSetItem ) );
+			--( pxQueue->pxQueueSetContainer->uxMessagesWaiting );
+		}
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	xZeroCopyQueueHandle xQueueCreateZeroCopy( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize )
+	{
+	xZERO_COPY_QUEUE *pxQueue;
+	size_t xHeaderSize, xSlotSize;
+
+		configASSERT( uxQueueLength > ( unsigned portBASE_TYPE ) 0 );
+		configASSERT( uxItemSize > ( unsigned portBASE_TYPE ) 0 );
+
+		/* The slots follow the structure, and each slot is aligned so it can
+		hold any type. */
+		xHeaderSize = ( sizeof( xZERO_COPY_QUEUE ) + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		xSlotSize = ( ( size_t ) uxItemSize + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+		pxQueue = ( xZERO_COPY_QUEUE * ) pvPortMalloc( xHeaderSize + ( xSlotSize * ( size_t ) uxQueueLength ) );
+
+		if( pxQueue != NULL )
+		{
+			pxQueue->uxHead = ( unsigned portBASE_TYPE ) 0;
+			pxQueue->uxTail = ( unsigned portBASE_TYPE ) 0;
+			pxQueue->pcSlots = ( ( signed char * ) pxQueue ) + xHeaderSize;
+			pxQueue->xSlotSize = xSlotSize;
+			pxQueue->uxLength = uxQueueLength;
+			pxQueue->xTaskWaitingToAcquire = NULL;
+			pxQueue->xTaskWaitingToReceive = NULL;
 		}
-		portENABLE_INTERRUPTS();
 
-		return xReturn;
+		configASSERT( pxQueue );
+
+		return ( xZeroCopyQueueHandle ) pxQueue;
 	}
 
-#endif /* configUSE_CO_ROUTINES */
+#endif /* configUSE_ZERO_COPY_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_CO_ROUTINES == 1 )
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
 
-	signed portBASE_TYPE xQueueCRSendFromISR( xQueueHandle xQueue, const void *pvItemToQueue, signed portBASE_TYPE xCoRoutinePreviouslyWoken )
+	void vQueueDeleteZeroCopy( xZeroCopyQueueHandle xQueue )
 	{
-	xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+		configASSERT( xQueue );
 
-		/* Cannot block within an ISR so if there is no space on the queue then
-		exit without doing anything. */
-		if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+		vPortFree( ( void * ) xQueue );
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	void *pvQueueAcquireSlot( xZeroCopyQueueHandle xQueue, portTickType xTicksToWait )
+	{
+	xZERO_COPY_QUEUE * const pxQueue = ( xZERO_COPY_QUEUE * ) xQueue;
+	void *pvSlot = NULL;
+
+		configASSERT( pxQueue );
+
+		if( ( prvFreeSlots( pxQueue ) == ( unsigned portBASE_TYPE ) 0 ) && ( xTicksToWait > ( portTickType ) 0 ) )
 		{
-			prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK );
+			prvWaitForSlot( pxQueue, &( pxQueue->xTaskWaitingToAcquire ), prvFreeSlots, xTicksToWait );
+		}
 
-			/* We only want to wake one co-routine per ISR, so check that a
-			co-routine has not already been woken. */
-			if( xCoRoutinePreviouslyWoken == pdFALSE )
-			{
-				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-				{
-					if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-					{
-						return pdTRUE;
-					}
-				}
-			}
+		if( prvFreeSlots( pxQueue ) > ( unsigned portBASE_TYPE ) 0 )
+		{
+			pvSlot = prvSlotAt( pxQueue, pxQueue->uxHead );
 		}
 
-		return xCoRoutinePreviouslyWoken;
+		return pvSlot;
 	}
 
-#endif /* configUSE_CO_ROUTINES */
+#endif /* configUSE_ZERO_COPY_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_CO_ROUTINES == 1 )
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
 
-	signed portBASE_TYPE xQueueCRReceiveFromISR( xQueueHandle xQueue, void *pvBuffer, signed portBASE_TYPE *pxCoRoutineWoken )
+	void *pvQueueAcquireSlotFromISR( xZeroCopyQueueHandle xQueue )
 	{
-	signed portBASE_TYPE xReturn;
-	xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+	xZERO_COPY_QUEUE * const pxQueue = ( xZERO_COPY_QUEUE * ) xQueue;
+	void *pvSlot = NULL;
 
-		/* We cannot block from an ISR, so check there is data available. If
-		not then just leave without doing anything. */
-		if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0 )
+		configASSERT( pxQueue );
+
+		if( prvFreeSlots( pxQueue ) > ( unsigned portBASE_TYPE ) 0 )
 		{
-			/* Copy the data from the queue. */
-			pxQueue->u.pcReadFrom += pxQueue->uxItemSize;
-			if( pxQueue->u.pcReadFrom >= pxQueue->pcTail )
-			{
-				pxQueue->u.pcReadFrom = pxQueue->pcHead;
-			}
-			--( pxQueue->uxMessagesWaiting );
-			( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+			pvSlot = prvSlotAt( pxQueue, pxQueue->uxHead );
+		}
 
-			if( ( *pxCoRoutineWoken ) == pdFALSE )
-			{
-				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
-				{
-					if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
-					{
-						*pxCoRoutineWoken = pdTRUE;
-					}
-				}
-			}
+		return pvSlot;
+	}
 
-			xReturn = pdPASS;
-		}
-		else
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	portBASE_TYPE xQueueCommitSlot( xZeroCopyQueueHandle xQueue, void *pvSlot )
+	{
+	xZERO_COPY_QUEUE * const pxQueue = ( xZERO_COPY_QUEUE * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( prvFreeSlots( pxQueue ) > ( unsigned portBASE_TYPE ) 0 );
+		configASSERT( pvSlot == prvSlotAt( pxQueue, pxQueue->uxHead ) );
+
+		/* The slot is passed to the receiver by moving the head past it.  The
+		writes to the slot are not volatile, so a barrier is needed to keep
+		them ahead of the store to the head. */
+		portMEMORY_BARRIER();
+		pxQueue->uxHead = prvNextSlotIndex( pxQueue, pxQueue->uxHead );
+
+		if( pxQueue->xTaskWaitingToReceive != NULL )
 		{
-			xReturn = pdFAIL;
+			prvNotifySlotWaiter( &( pxQueue->xTaskWaitingToReceive ) );
 		}
 
-		return xReturn;
+		return pdPASS;
 	}
 
-#endif /* configUSE_CO_ROUTINES */
+#endif /* configUSE_ZERO_COPY_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configQUEUE_REGISTRY_SIZE > 0 )
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
 
-	void vQueueAddToRegistry( xQueueHandle xQueue, signed char *pcQueueName )
+	portBASE_TYPE xQueueCommitSlotFromISR( xZeroCopyQueueHandle xQueue, void *pvSlot, portBASE_TYPE *pxHigherPriorityTaskWoken )
 	{
-	unsigned portBASE_TYPE ux;
+	xZERO_COPY_QUEUE * const pxQueue = ( xZERO_COPY_QUEUE * ) xQueue;
 
-		/* See if there is an empty space in the registry.  A NULL name denotes
-		a free slot. */
-		for( ux = ( unsigned portBASE_TYPE ) 0U; ux < ( unsigned portBASE_TYPE ) configQUEUE_REGISTRY_SIZE; ux++ )
+		configASSERT( pxQueue );
+		configASSERT( prvFreeSlots( pxQueue ) > ( unsigned portBASE_TYPE ) 0 );
+		configASSERT( pvSlot == prvSlotAt( pxQueue, pxQueue->uxHead ) );
+
+		portMEMORY_BARRIER();
+		pxQueue->uxHead = prvNextSlotIndex( pxQueue, pxQueue->uxHead );
+
+		/* Interrupts only need to be masked if there is a receiver to
+		unblock. */
+		if( pxQueue->xTaskWaitingToReceive != NULL )
 		{
-			if( xQueueRegistry[ ux ].pcQueueName == NULL )
-			{
-				/* Store the information on this queue. */
-				xQueueRegistry[ ux ].pcQueueName = pcQueueName;
-				xQueueRegistry[ ux ].xHandle = xQueue;
-				break;
-			}
+			prvNotifySlotWaiterFromISR( &( pxQueue->xTaskWaitingToReceive ), pxHigherPriorityTaskWoken );
 		}
+
+		return pdPASS;
 	}
 
-#endif /* configQUEUE_REGISTRY_SIZE */
+#endif /* configUSE_ZERO_COPY_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configQUEUE_REGISTRY_SIZE > 0 )
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
 
-	void vQueueUnregisterQueue( xQueueHandle xQueue )
+	void *pvQueueReceiveSlot( xZeroCopyQueueHandle xQueue, portTickType xTicksToWait )
 	{
-	unsigned portBASE_TYPE ux;
+	xZERO_COPY_QUEUE * const pxQueue = ( xZERO_COPY_QUEUE * ) xQueue;
+	void *pvSlot = NULL;
 
-		/* See if the handle of the queue being unregistered in actually in the
-		registry. */
-		for( ux = ( unsigned portBASE_TYPE ) 0U; ux < ( unsigned portBASE_TYPE ) configQUEUE_REGISTRY_SIZE; ux++ )
+		configASSERT( pxQueue );
+
+		if( ( prvCommittedSlots( pxQueue ) == ( unsigned portBASE_TYPE ) 0 ) && ( xTicksToWait > ( portTickType ) 0 ) )
 		{
-			if( xQueueRegistry[ ux ].xHandle == xQueue )
-			{
-				/* Set the name to NULL to show that this slot if free again. */
-				xQueueRegistry[ ux ].pcQueueName = NULL;
-				break;
-			}
+			prvWaitForSlot( pxQueue, &( pxQueue->xTaskWaitingToReceive ), prvCommittedSlots, xTicksToWait );
 		}
 
-	} /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
+		if( prvCommittedSlots( pxQueue ) > ( unsigned portBASE_TYPE ) 0 )
+		{
+			pvSlot = prvSlotAt( pxQueue, pxQueue->uxTail );
+		}
 
-#endif /* configQUEUE_REGISTRY_SIZE */
+		return pvSlot;
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TIMERS == 1 )
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
 
-	void vQueueWaitForMessageRestricted( xQueueHandle xQueue, portTickType xTicksToWait )
+	void *pvQueueReceiveSlotFromISR( xZeroCopyQueueHandle xQueue )
 	{
-	xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+	xZERO_COPY_QUEUE * const pxQueue = ( xZERO_COPY_QUEUE * ) xQueue;
+	void *pvSlot = NULL;
 
-		/* This function should not be called by application code hence the
-		'Restricted' in its name.  It is not part of the public API.  It is
-		designed for use by kernel code, and has special calling requirements.
-		It can result in vListInsert() being called on a list that can only
-		possibly ever have one item in it, so the list will be fast, but even
-		so it should be called with the scheduler locked and not from a critical
-		section. */
+		configASSERT( pxQueue );
 
-		/* Only do anything if there are no messages in the queue.  This function
-		will not actually cause the task to block, just place it on a blocked
-		list.  It will not block until the scheduler is unlocked - at which
-		time a yield will be performed.  If an item is added to the queue while
-		the queue is locked, and the calling task blocks on the queue, then the
-		calling task will be immediately unblocked when the queue is unlocked. */
-		prvLockQueue( pxQueue );
-		if( pxQueue->uxMessagesWaiting == ( unsigned portBASE_TYPE ) 0U )
+		if( prvCommittedSlots( pxQueue ) > ( unsigned portBASE_TYPE ) 0 )
 		{
-			/* There is nothing in the queue, block for the specified period. */
-			vTaskPlaceOnEventListRestricted( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+			pvSlot = prvSlotAt( pxQueue, pxQueue->uxTail );
 		}
-		prvUnlockQueue( pxQueue );
+
+		return pvSlot;
 	}
 
-#endif /* configUSE_TIMERS */
+#endif /* configUSE_ZERO_COPY_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_QUEUE_SETS == 1 )
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
 
-	xQueueSetHandle xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength )
+	void vQueueReleaseSlot( xZeroCopyQueueHandle xQueue, void *pvSlot )
 	{
-	xQueueSetHandle pxQueue;
+	xZERO_COPY_QUEUE * const pxQueue = ( xZERO_COPY_QUEUE * ) xQueue;
 
-		pxQueue = xQueueGenericCreate( uxEventQueueLength, sizeof( xQUEUE * ), queueQUEUE_TYPE_SET );
+		configASSERT( pxQueue );
+		configASSERT( prvCommittedSlots( pxQueue ) > ( unsigned portBASE_TYPE ) 0 );
+		configASSERT( pvSlot == prvSlotAt( pxQueue, pxQueue->uxTail ) );
+
+		/* Release the slot to the sender only after the reads from it are
+		complete. */
+		portMEMORY_BARRIER();
+		pxQueue->uxTail = prvNextSlotIndex( pxQueue, pxQueue->uxTail );
 
-		return pxQueue;
+		if( pxQueue->xTaskWaitingToAcquire != NULL )
+		{
+			prvNotifySlotWaiter( &( pxQueue->xTaskWaitingToAcquire ) );
+		}
 	}
 
-#endif /* configUSE_QUEUE_SETS */
+#endif /* configUSE_ZERO_COPY_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_QUEUE_SETS == 1 )
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
 
-	portBASE_TYPE xQueueAddToSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet )
+	void vQueueReleaseSlotFromISR( xZeroCopyQueueHandle xQueue, void *pvSlot, portBASE_TYPE *pxHigherPriorityTaskWoken )
 	{
-	portBASE_TYPE xReturn;
+	xZERO_COPY_QUEUE * const pxQueue = ( xZERO_COPY_QUEUE * ) xQueue;
 
-		if( ( ( xQUEUE * ) xQueueOrSemaphore )->pxQueueSetContainer != NULL )
+		configASSERT( pxQueue );
+		configASSERT( prvCommittedSlots( pxQueue ) > ( unsigned portBASE_TYPE ) 0 );
+		configASSERT( pvSlot == prvSlotAt( pxQueue, pxQueue->uxTail ) );
+
+		portMEMORY_BARRIER();
+		pxQueue->uxTail = prvNextSlotIndex( pxQueue, pxQueue->uxTail );
+
+		/* Interrupts only need to be masked if there is a sender to
+		unblock. */
+		if( pxQueue->xTaskWaitingToAcquire != NULL )
 		{
-			/* Cannot add a queue/semaphore to more than one queue set. */
-			xReturn = pdFAIL;
+			prvNotifySlotWaiterFromISR( &( pxQueue->xTaskWaitingToAcquire ), pxHigherPriorityTaskWoken );
 		}
-		else if( ( ( xQUEUE * ) xQueueOrSemaphore )->uxMessagesWaiting != ( unsigned portBASE_TYPE ) 0 )
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	unsigned portBASE_TYPE uxQueueSlotsWaiting( const xZeroCopyQueueHandle xQueue )
+	{
+		configASSERT( xQueue );
+
+		return prvCommittedSlots( ( const xZERO_COPY_QUEUE * ) xQueue );
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	static unsigned portBASE_TYPE prvCommittedSlots( const xZERO_COPY_QUEUE * const pxQueue )
+	{
+	unsigned portBASE_TYPE uxHead = pxQueue->uxHead, uxTail = pxQueue->uxTail;
+
+		if( uxHead < uxTail )
 		{
-			/* Cannot add a queue/semaphore to a queue set if there are already
-			items in the queue/semaphore. */
-			xReturn = pdFAIL;
+			uxHead += ( unsigned portBASE_TYPE ) 2 * pxQueue->uxLength;
 		}
-		else
+
+		return uxHead - uxTail;
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	static unsigned portBASE_TYPE prvFreeSlots( const xZERO_COPY_QUEUE * const pxQueue )
+	{
+		return pxQueue->uxLength - prvCommittedSlots( pxQueue );
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	static void *prvSlotAt( const xZERO_COPY_QUEUE * const pxQueue, unsigned portBASE_TYPE uxIndex )
+	{
+		if( uxIndex >= pxQueue->uxLength )
 		{
-			taskENTER_CRITICAL();
-			{
-				( ( xQUEUE * ) xQueueOrSemaphore )->pxQueueSetContainer = xQueueSet;
-			}
-			taskEXIT_CRITICAL();
-			xReturn = pdPASS;
+			uxIndex -= pxQueue->uxLength;
 		}
 
-		return xReturn;
+		return ( void * ) &( pxQueue->pcSlots[ pxQueue->xSlotSize * ( size_t ) uxIndex ] );
 	}
 
-#endif /* configUSE_QUEUE_SETS */
+#endif /* configUSE_ZERO_COPY_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_QUEUE_SETS == 1 )
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
 
-	portBASE_TYPE xQueueRemoveFromSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet )
+	static unsigned portBASE_TYPE prvNextSlotIndex( const xZERO_COPY_QUEUE * const pxQueue, unsigned portBASE_TYPE uxIndex )
 	{
-	portBASE_TYPE xReturn;
-	xQUEUE * const pxQueueOrSemaphore = ( xQUEUE * ) xQueueOrSemaphore;
+		uxIndex++;
 
-		if( pxQueueOrSemaphore->pxQueueSetContainer != xQueueSet )
+		if( uxIndex >= ( ( unsigned portBASE_TYPE ) 2 * pxQueue->uxLength ) )
 		{
-			/* The queue was not a member of the set. */
-			xReturn = pdFAIL;
+			uxIndex = ( unsigned portBASE_TYPE ) 0;
 		}
-		else if( pxQueueOrSemaphore->uxMessagesWaiting != ( unsigned portBASE_TYPE ) 0 )
+
+		return uxIndex;
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	static void prvWaitForSlot( const xZERO_COPY_QUEUE * const pxQueue, volatile xTaskHandle *pxWaitingTask, unsigned portBASE_TYPE ( *pxAvailable )( const xZERO_COPY_QUEUE * const pxQueue ), portTickType xTicksToWait )
+	{
+	portBASE_TYPE xMustBlock;
+
+		taskENTER_CRITICAL();
 		{
-			/* It is dangerous to remove a queue from a set when the queue is
-			not empty because the queue set will still hold pending events for
-			the queue. */
-			xReturn = pdFAIL;
+			/* The other side cannot run while the condition is checked and the
+			waiting task recorded, so a notification cannot be missed. */
+			xMustBlock = ( pxAvailable( pxQueue ) == ( unsigned portBASE_TYPE ) 0 );
+
+			if( xMustBlock != pdFALSE )
+			{
+				/* Discard any notification left over from an earlier wait
+				that timed out as the other side was notifying it.  Only the
+				pending state is cleared, so a notification value the
+				application uses for its own purposes is left alone. */
+				( void ) xTaskNotifyStateClear( NULL );
+
+				configASSERT( *pxWaitingTask == NULL );
+				*pxWaitingTask = xTaskGetCurrentTaskHandle();
+			}
 		}
-		else
+		taskEXIT_CRITICAL();
+
+		if( xMustBlock != pdFALSE )
 		{
+			/* The other side notifies with eNoAction, and no bits are
+			cleared here, so the notification value is not touched. */
+			( void ) xTaskNotifyWait( 0UL, 0UL, NULL, xTicksToWait );
+
+			/* Clear the reference in case the wait timed out.  The other side
+			may be in the middle of notifying from an interrupt, so the
+			reference is cleared with interrupts masked. */
 			taskENTER_CRITICAL();
 			{
-				/* The queue is no longer contained in the set. */
-				pxQueueOrSemaphore->pxQueueSetContainer = NULL;
+				*pxWaitingTask = NULL;
 			}
 			taskEXIT_CRITICAL();
-			xReturn = pdPASS;
 		}
-
-		return xReturn;
-	} /*lint !e818 xQueueSet could not be declared as pointing to const as it is a typedef. */
-
-#endif /* configUSE_QUEUE_SETS */
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_QUEUE_SETS == 1 )
-
-	xQueueSetMemberHandle xQueueSelectFromSet( xQueueSetHandle xQueueSet, portTickType xBlockTimeTicks )
-	{
-	xQueueSetMemberHandle xReturn = NULL;
-
-		( void ) xQueueGenericReceive( ( xQueueHandle ) xQueueSet, &xReturn, xBlockTimeTicks, pdFALSE ); /*lint !e961 Casting from one typedef to another is not redundant. */
-		return xReturn;
 	}
 
-#endif /* configUSE_QUEUE_SETS */
+#endif /* configUSE_ZERO_COPY_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_QUEUE_SETS == 1 )
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
 
-	xQueueSetMemberHandle xQueueSelectFromSetFromISR( xQueueSetHandle xQueueSet )
+	static void prvNotifySlotWaiter( volatile xTaskHandle *pxWaitingTask )
 	{
-	xQueueSetMemberHandle xReturn = NULL;
-
-		( void ) xQueueReceiveFromISR( ( xQueueHandle ) xQueueSet, &xReturn, NULL ); /*lint !e961 Casting from one typedef to another is not redundant. */
-		return xReturn;
+		taskENTER_CRITICAL();
+		{
+			/* Check again, as the task may have timed out. */
+			if( *pxWaitingTask != NULL )
+			{
+				( void ) xTaskNotify( *pxWaitingTask, 0UL, eNoAction );
+				*pxWaitingTask = NULL;
+			}
+		}
+		taskEXIT_CRITICAL();
 	}
 
-#endif /* configUSE_QUEUE_SETS */
+#endif /* configUSE_ZERO_COPY_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_QUEUE_SETS == 1 )
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
 
-	static portBASE_TYPE prvNotifyQueueSetContainer( const xQUEUE * const pxQueue, portBASE_TYPE xCopyPosition )
+	static void prvNotifySlotWaiterFromISR( volatile xTaskHandle *pxWaitingTask, portBASE_TYPE *pxHigherPriorityTaskWoken )
 	{
-	xQUEUE *pxQueueSetContainer = pxQueue->pxQueueSetContainer;
-	portBASE_TYPE xReturn = pdFALSE;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
 
-		configASSERT( pxQueueSetContainer );
-		configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
-
-		if( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength )
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 		{
-			traceQUEUE_SEND( pxQueueSetContainer );
-			/* The data copies is the handle of the queue that contains data. */
-			prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, xCopyPosition );
-			if( listLIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
+			/* Check again, as the task may have timed out. */
+			if( *pxWaitingTask != NULL )
 			{
-				if( xTaskRemoveFromEventList( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
-				{
-					/* The task waiting has a higher priority */
-					xReturn = pdTRUE;
-				}
+				( void ) xTaskNotifyFromISR( *pxWaitingTask, 0UL, eNoAction, pxHigherPriorityTaskWoken );
+				*pxWaitingTask = NULL;
 			}
 		}
-
-		return xReturn;
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 	}
 
-#endif /* configUSE_QUEUE_SETS */
+#endif /* configUSE_ZERO_COPY_QUEUES */
 
@@ -0,0 +1,808 @@
+/*
+    FreeRTOS V7.5.2 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to include direct to task notifications, which stream buffers use to block and
+unblock tasks.  This #if is closed at the very bottom of this file.  If you want
+to include stream buffers then ensure configUSE_TASK_NOTIFICATIONS is set to 1
+in FreeRTOSConfig.h. */
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+/*
+ * Definition of a stream buffer.
+ *
+ * The buffer is a ring of xLength bytes, one more than the capacity requested
+ * when the stream buffer was created, so xHead == xTail always means empty.
+ * Only the writer updates xHead and only the reader updates xTail, and each
+ * index is only advanced after the bytes it covers have been copied, so the
+ * writer and the reader never need a critical section to move data.  A
+ * critical section is only used when a task has to block, or a blocked task
+ * has to be unblocked.
+ *
+ * A message buffer is a stream buffer in which each message is preceded by
+ * its length, held in a configMESSAGE_BUFFER_LENGTH_TYPE.  A message and its
+ * length are published by a single update of xHead, so the reader never sees
+ * part of a message.
+ */
+typedef struct StreamBufferDefinition
+{
+	volatile size_t xTail;					/*< Index of the next byte to read.  Only written by the reader. */
+	volatile size_t xHead;					/*< Index of the next byte to write.  Only written by the writer. */
+	size_t xLength;							/*< The size of the ring, one more than the capacity of the stream buffer. */
+	size_t xTriggerLevelBytes;				/*< The number of bytes that must be in the buffer before a blocked reader is unblocked. */
+	portBASE_TYPE xTerminator;				/*< A byte that unblocks the reader when written, or sbNO_TERMINATOR. */
+	portBASE_TYPE xIsMessageBuffer;			/*< pdTRUE if the buffer holds length prefixed messages rather than a stream of bytes. */
+	volatile xTaskHandle xTaskWaitingToReceive;	/*< The reader, if it is blocked waiting for data, otherwise NULL. */
+	volatile xTaskHandle xTaskWaitingToSend;	/*< The writer, if it is blocked waiting for space, otherwise NULL. */
+	unsigned char *pucBuffer;				/*< Points to the ring storage area, which follows the structure. */
+} xSTREAM_BUFFER;
+
+/* The number of bytes used to store the length of each message in a message
+buffer. */
+#define sbBYTES_TO_STORE_MESSAGE_LENGTH		( sizeof( configMESSAGE_BUFFER_LENGTH_TYPE ) )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The number of bytes that can be read from, or written to, the ring.  Each
+ * reads both indexes once, so can be used by either side without a critical
+ * section.
+ */
+static size_t prvBytesInBuffer( const xSTREAM_BUFFER * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+static size_t prvSpaceInBuffer( const xSTREAM_BUFFER * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy xCount bytes into, or out of, the ring starting at index xIndex,
+ * wrapping at the end of the storage area.  Return the index that follows the
+ * last byte copied.  The caller must first check there is enough space or
+ * data, and is responsible for publishing the returned index.
+ */
+static size_t prvCopyToRing( xSTREAM_BUFFER * const pxStreamBuffer, size_t xIndex, const unsigned char *pucData, size_t xCount ) PRIVILEGED_FUNCTION;
+static size_t prvCopyFromRing( const xSTREAM_BUFFER * const pxStreamBuffer, size_t xIndex, unsigned char *pucData, size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy up to xCount bytes into, or out of, the ring, then publish the new
+ * index.  Return the number of bytes copied.
+ */
+static size_t prvWriteBytes( xSTREAM_BUFFER * const pxStreamBuffer, const unsigned char *pucData, size_t xCount ) PRIVILEGED_FUNCTION;
+static size_t prvReadBytes( xSTREAM_BUFFER * const pxStreamBuffer, unsigned char *pucData, size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Write a message and its length if there is space for both, or read the next
+ * message if it fits in xBufferLength bytes.  Return the length of the
+ * message, or 0 if nothing was written or read.
+ */
+static size_t prvWriteMessage( xSTREAM_BUFFER * const pxStreamBuffer, const unsigned char *pucData, size_t xLength ) PRIVILEGED_FUNCTION;
+static size_t prvReadMessage( xSTREAM_BUFFER * const pxStreamBuffer, unsigned char *pucData, size_t xBufferLength ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the length of the next message in a message buffer without removing
+ * it, or 0 if the message buffer is empty.
+ */
+static size_t prvNextMessageLength( const xSTREAM_BUFFER * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the writer after bytes have been written.  Returns pdTRUE if the
+ * blocked reader, if any, should be unblocked: the trigger level has been
+ * reached or the terminating byte was among the bytes just written.
+ */
+static portBASE_TYPE prvReaderShouldWake( const xSTREAM_BUFFER * const pxStreamBuffer, const unsigned char *pucData, size_t xWritten ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock the task referenced by *pxWaitingTask, if any, and clear the
+ * reference.  The task version is for use from tasks, the ISR version from
+ * interrupts.
+ */
+static void prvNotifyWaitingTask( volatile xTaskHandle *pxWaitingTask ) PRIVILEGED_FUNCTION;
+static void prvNotifyWaitingTaskFromISR( volatile xTaskHandle *pxWaitingTask, portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Block the calling task until it is notified by the other side of the stream
+ * buffer or xTicksToWait expires, unless pxAvailable() already returns at
+ * least xRequired.  The calling task's handle is held in *pxWaitingTask while
+ * it is blocked.
+ */
+static void prvWaitForOtherSide( const xSTREAM_BUFFER * const pxStreamBuffer, volatile xTaskHandle *pxWaitingTask, size_t ( *pxAvailable )( const xSTREAM_BUFFER * const pxStreamBuffer ), size_t xRequired, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+xStreamBufferHandle xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, portBASE_TYPE xIsMessageBuffer )
+{
+xSTREAM_BUFFER *pxStreamBuffer = NULL;
+
+	configASSERT( xBufferSizeBytes > ( size_t ) 0 );
+	configASSERT( xTriggerLevelBytes <= xBufferSizeBytes );
+
+	/* A reader blocked on a message buffer is unblocked by every message. */
+	if( ( xTriggerLevelBytes == ( size_t ) 0 ) || ( xIsMessageBuffer != pdFALSE ) )
+	{
+		xTriggerLevelBytes = ( size_t ) 1;
+	}
+
+	/* The structure and the ring are allocated in one block.  The ring is one
+	byte larger than requested so a full buffer can be distinguished from an
+	empty buffer. */
+	if( ( xBufferSizeBytes > ( size_t ) 0 ) && ( xTriggerLevelBytes <= xBufferSizeBytes ) )
+	{
+		pxStreamBuffer = ( xSTREAM_BUFFER * ) pvPortMalloc( sizeof( xSTREAM_BUFFER ) + xBufferSizeBytes + ( size_t ) 1 );
+	}
+
+	if( pxStreamBuffer != NULL )
+	{
+		pxStreamBuffer->pucBuffer = ( ( unsigned char * ) pxStreamBuffer ) + sizeof( xSTREAM_BUFFER );
+		pxStreamBuffer->xLength = xBufferSizeBytes + ( size_t ) 1;
+		pxStreamBuffer->xHead = ( size_t ) 0;
+		pxStreamBuffer->xTail = ( size_t ) 0;
+		pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
+		pxStreamBuffer->xTerminator = sbNO_TERMINATOR;
+		pxStreamBuffer->xIsMessageBuffer = xIsMessageBuffer;
+		pxStreamBuffer->xTaskWaitingToReceive = NULL;
+		pxStreamBuffer->xTaskWaitingToSend = NULL;
+
+		traceSTREAM_BUFFER_CREATE( pxStreamBuffer );
+	}
+	else
+	{
+		traceSTREAM_BUFFER_CREATE_FAILED();
+	}
+
+	return ( xStreamBufferHandle ) pxStreamBuffer;
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferDelete( xStreamBufferHandle xStreamBuffer )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+	traceSTREAM_BUFFER_DELETE( pxStreamBuffer );
+
+	vPortFree( pxStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xStreamBufferReset( xStreamBufferHandle xStreamBuffer )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+portBASE_TYPE xReturn = pdFAIL;
+
+	configASSERT( pxStreamBuffer );
+
+	taskENTER_CRITICAL();
+	{
+		if( ( pxStreamBuffer->xTaskWaitingToReceive == NULL ) && ( pxStreamBuffer->xTaskWaitingToSend == NULL ) )
+		{
+			pxStreamBuffer->xHead = ( size_t ) 0;
+			pxStreamBuffer->xTail = ( size_t ) 0;
+			traceSTREAM_BUFFER_RESET( pxStreamBuffer );
+			xReturn = pdPASS;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xStreamBufferSetTriggerLevel( xStreamBufferHandle xStreamBuffer, size_t xTriggerLevel )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+portBASE_TYPE xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	if( xTriggerLevel == ( size_t ) 0 )
+	{
+		xTriggerLevel = ( size_t ) 1;
+	}
+
+	if( xTriggerLevel < pxStreamBuffer->xLength )
+	{
+		pxStreamBuffer->xTriggerLevelBytes = xTriggerLevel;
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferSetTerminator( xStreamBufferHandle xStreamBuffer, portBASE_TYPE xTerminator )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pxStreamBuffer->xIsMessageBuffer == pdFALSE );
+	configASSERT( ( xTerminator == sbNO_TERMINATOR ) || ( ( xTerminator >= 0 ) && ( xTerminator <= 0xff ) ) );
+
+	pxStreamBuffer->xTerminator = xTerminator;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferBytesAvailable( xStreamBufferHandle xStreamBuffer )
+{
+	configASSERT( xStreamBuffer );
+	return prvBytesInBuffer( ( xSTREAM_BUFFER * ) xStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSpacesAvailable( xStreamBufferHandle xStreamBuffer )
+{
+	configASSERT( xStreamBuffer );
+	return prvSpaceInBuffer( ( xSTREAM_BUFFER * ) xStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferNextMessageLengthBytes( xStreamBufferHandle xStreamBuffer )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pxStreamBuffer->xIsMessageBuffer != pdFALSE );
+
+	return prvNextMessageLength( pxStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portTickType xTicksToWait )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+const unsigned char *pucData = ( const unsigned char * ) pvTxData;
+size_t xWritten, xTotalWritten = ( size_t ) 0, xRequiredSpace = ( size_t ) 1;
+xTimeOutType xTimeOut;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pvTxData );
+
+	if( pxStreamBuffer->xIsMessageBuffer != pdFALSE )
+	{
+		/* A message is only written once there is space for all of it.  A
+		message that could never fit is rejected rather than waited for. */
+		xRequiredSpace = xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+		if( xRequiredSpace >= pxStreamBuffer->xLength )
+		{
+			traceSTREAM_BUFFER_SEND_FAILED( pxStreamBuffer );
+			return ( size_t ) 0;
+		}
+	}
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		if( pxStreamBuffer->xIsMessageBuffer != pdFALSE )
+		{
+			xWritten = prvWriteMessage( pxStreamBuffer, pucData, xDataLengthBytes );
+		}
+		else
+		{
+			xWritten = prvWriteBytes( pxStreamBuffer, &( pucData[ xTotalWritten ] ), xDataLengthBytes - xTotalWritten );
+		}
+
+		if( xWritten > ( size_t ) 0 )
+		{
+			traceSTREAM_BUFFER_SEND( pxStreamBuffer, xWritten );
+
+			if( ( pxStreamBuffer->xTaskWaitingToReceive != NULL ) && ( prvReaderShouldWake( pxStreamBuffer, &( pucData[ xTotalWritten ] ), xWritten ) != pdFALSE ) )
+			{
+				prvNotifyWaitingTask( &( pxStreamBuffer->xTaskWaitingToReceive ) );
+			}
+
+			xTotalWritten += xWritten;
+		}
+
+		if( xTotalWritten >= xDataLengthBytes )
+		{
+			break;
+		}
+
+		/* The buffer is full, or too full for the message.  Wait for the
+		reader to make space, unless the block time has expired. */
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+		{
+			traceSTREAM_BUFFER_SEND_FAILED( pxStreamBuffer );
+			break;
+		}
+
+		traceBLOCKING_ON_STREAM_BUFFER_SEND( pxStreamBuffer );
+		prvWaitForOtherSide( pxStreamBuffer, &( pxStreamBuffer->xTaskWaitingToSend ), prvSpaceInBuffer, xRequiredSpace, xTicksToWait );
+	}
+
+	return xTotalWritten;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xWritten;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pvTxData );
+
+	if( pxStreamBuffer->xIsMessageBuffer != pdFALSE )
+	{
+		xWritten = prvWriteMessage( pxStreamBuffer, ( const unsigned char * ) pvTxData, xDataLengthBytes );
+	}
+	else
+	{
+		xWritten = prvWriteBytes( pxStreamBuffer, ( const unsigned char * ) pvTxData, xDataLengthBytes );
+	}
+
+	/* Interrupts only need to be masked if there is a reader to unblock. */
+	if( ( xWritten > ( size_t ) 0 ) && ( pxStreamBuffer->xTaskWaitingToReceive != NULL ) )
+	{
+		if( prvReaderShouldWake( pxStreamBuffer, ( const unsigned char * ) pvTxData, xWritten ) != pdFALSE )
+		{
+			prvNotifyWaitingTaskFromISR( &( pxStreamBuffer->xTaskWaitingToReceive ), pxHigherPriorityTaskWoken );
+		}
+	}
+
+	traceSTREAM_BUFFER_SEND_FROM_ISR( pxStreamBuffer, xWritten );
+
+	return xWritten;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portTickType xTicksToWait )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xReceived;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pvRxData );
+
+	if( ( prvBytesInBuffer( pxStreamBuffer ) == ( size_t ) 0 ) && ( xTicksToWait > ( portTickType ) 0 ) )
+	{
+		traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( pxStreamBuffer );
+		prvWaitForOtherSide( pxStreamBuffer, &( pxStreamBuffer->xTaskWaitingToReceive ), prvBytesInBuffer, ( size_t ) 1, xTicksToWait );
+	}
+
+	if( pxStreamBuffer->xIsMessageBuffer != pdFALSE )
+	{
+		xReceived = prvReadMessage( pxStreamBuffer, ( unsigned char * ) pvRxData, xBufferLengthBytes );
+	}
+	else
+	{
+		xReceived = prvReadBytes( pxStreamBuffer, ( unsigned char * ) pvRxData, xBufferLengthBytes );
+	}
+
+	if( xReceived > ( size_t ) 0 )
+	{
+		traceSTREAM_BUFFER_RECEIVE( pxStreamBuffer, xReceived );
+
+		if( pxStreamBuffer->xTaskWaitingToSend != NULL )
+		{
+			prvNotifyWaitingTask( &( pxStreamBuffer->xTaskWaitingToSend ) );
+		}
+	}
+	else
+	{
+		traceSTREAM_BUFFER_RECEIVE_FAILED( pxStreamBuffer );
+	}
+
+	return xReceived;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xReceived;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pvRxData );
+
+	if( pxStreamBuffer->xIsMessageBuffer != pdFALSE )
+	{
+		xReceived = prvReadMessage( pxStreamBuffer, ( unsigned char * ) pvRxData, xBufferLengthBytes );
+	}
+	else
+	{
+		xReceived = prvReadBytes( pxStreamBuffer, ( unsigned char * ) pvRxData, xBufferLengthBytes );
+	}
+
+	/* Interrupts only need to be masked if there is a writer to unblock. */
+	if( ( xReceived > ( size_t ) 0 ) && ( pxStreamBuffer->xTaskWaitingToSend != NULL ) )
+	{
+		prvNotifyWaitingTaskFromISR( &( pxStreamBuffer->xTaskWaitingToSend ), pxHigherPriorityTaskWoken );
+	}
+
+	traceSTREAM_BUFFER_RECEIVE_FROM_ISR( pxStreamBuffer, xReceived );
+
+	return xReceived;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvBytesInBuffer( const xSTREAM_BUFFER * const pxStreamBuffer )
+{
+size_t xCount;
+
+	xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
+	xCount -= pxStreamBuffer->xTail;
+
+	if( xCount >= pxStreamBuffer->xLength )
+	{
+		xCount -= pxStreamBuffer->xLength;
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvSpaceInBuffer( const xSTREAM_BUFFER * const pxStreamBuffer )
+{
+size_t xSpace;
+
+	/* One byte of the ring is always left empty. */
+	xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
+	xSpace -= pxStreamBuffer->xHead;
+	xSpace -= ( size_t ) 1;
+
+	if( xSpace >= pxStreamBuffer->xLength )
+	{
+		xSpace -= pxStreamBuffer->xLength;
+	}
+
+	return xSpace;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCopyToRing( xSTREAM_BUFFER * const pxStreamBuffer, size_t xIndex, const unsigned char *pucData, size_t xCount )
+{
+size_t xFirst;
+
+	/* Copy up to the end of the storage area, then from the start. */
+	xFirst = pxStreamBuffer->xLength - xIndex;
+
+	if( xFirst > xCount )
+	{
+		xFirst = xCount;
+	}
+
+	memcpy( ( void * ) &( pxStreamBuffer->pucBuffer[ xIndex ] ), ( const void * ) pucData, xFirst );
+
+	if( xCount > xFirst )
+	{
+		memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirst ] ), xCount - xFirst );
+	}
+
+	xIndex += xCount;
+
+	if( xIndex >= pxStreamBuffer->xLength )
+	{
+		xIndex -= pxStreamBuffer->xLength;
+	}
+
+	return xIndex;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCopyFromRing( const xSTREAM_BUFFER * const pxStreamBuffer, size_t xIndex, unsigned char *pucData, size_t xCount )
+{
+size_t xFirst;
+
+	/* Copy up to the end of the storage area, then from the start. */
+	xFirst = pxStreamBuffer->xLength - xIndex;
+
+	if( xFirst > xCount )
+	{
+		xFirst = xCount;
+	}
+
+	memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xIndex ] ), xFirst );
+
+	if( xCount > xFirst )
+	{
+		memcpy( ( void * ) &( pucData[ xFirst ] ), ( const void * ) pxStreamBuffer->pucBuffer, xCount - xFirst );
+	}
+
+	xIndex += xCount;
+
+	if( xIndex >= pxStreamBuffer->xLength )
+	{
+		xIndex -= pxStreamBuffer->xLength;
+	}
+
+	return xIndex;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteBytes( xSTREAM_BUFFER * const pxStreamBuffer, const unsigned char *pucData, size_t xCount )
+{
+size_t xSpace, xHead;
+
+	xSpace = prvSpaceInBuffer( pxStreamBuffer );
+
+	if( xCount > xSpace )
+	{
+		xCount = xSpace;
+	}
+
+	if( xCount > ( size_t ) 0 )
+	{
+		/* Only once xHead is updated can the reader see the new bytes, so
+		the copy must be complete before it is.  The copy is not volatile, so
+		a barrier is needed to keep it ahead of the store to xHead. */
+		xHead = prvCopyToRing( pxStreamBuffer, pxStreamBuffer->xHead, pucData, xCount );
+		portMEMORY_BARRIER();
+		pxStreamBuffer->xHead = xHead;
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadBytes( xSTREAM_BUFFER * const pxStreamBuffer, unsigned char *pucData, size_t xCount )
+{
+size_t xAvailable, xTail;
+
+	xAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+	if( xCount > xAvailable )
+	{
+		xCount = xAvailable;
+	}
+
+	if( xCount > ( size_t ) 0 )
+	{
+		/* Release the space to the writer only after the bytes have been
+		copied out. */
+		xTail = prvCopyFromRing( pxStreamBuffer, pxStreamBuffer->xTail, pucData, xCount );
+		portMEMORY_BARRIER();
+		pxStreamBuffer->xTail = xTail;
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteMessage( xSTREAM_BUFFER * const pxStreamBuffer, const unsigned char *pucData, size_t xLength )
+{
+configMESSAGE_BUFFER_LENGTH_TYPE xHeader = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xLength;
+size_t xHead;
+
+	/* The length must be representable in the length field, and the message
+	is only written if there is space for all of it. */
+	if( ( xLength == ( size_t ) 0 ) || ( ( size_t ) xHeader != xLength ) || ( prvSpaceInBuffer( pxStreamBuffer ) < ( xLength + sbBYTES_TO_STORE_MESSAGE_LENGTH ) ) )
+	{
+		xLength = ( size_t ) 0;
+	}
+	else
+	{
+		xHead = prvCopyToRing( pxStreamBuffer, pxStreamBuffer->xHead, ( const unsigned char * ) &xHeader, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+		xHead = prvCopyToRing( pxStreamBuffer, xHead, pucData, xLength );
+
+		/* The length and the message become visible to the reader together,
+		once both have been copied. */
+		portMEMORY_BARRIER();
+		pxStreamBuffer->xHead = xHead;
+	}
+
+	return xLength;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadMessage( xSTREAM_BUFFER * const pxStreamBuffer, unsigned char *pucData, size_t xBufferLength )
+{
+configMESSAGE_BUFFER_LENGTH_TYPE xHeader;
+size_t xLength = ( size_t ) 0, xTail;
+
+	/* The writer publishes a length and its message together, so if the
+	length is present so is the message. */
+	if( prvBytesInBuffer( pxStreamBuffer ) >= sbBYTES_TO_STORE_MESSAGE_LENGTH )
+	{
+		xTail = prvCopyFromRing( pxStreamBuffer, pxStreamBuffer->xTail, ( unsigned char * ) &xHeader, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+		xLength = ( size_t ) xHeader;
+
+		/* A message that does not fit in the caller's buffer is left where
+		it is so it can be read with a larger buffer. */
+		if( xLength <= xBufferLength )
+		{
+			xTail = prvCopyFromRing( pxStreamBuffer, xTail, pucData, xLength );
+			portMEMORY_BARRIER();
+			pxStreamBuffer->xTail = xTail;
+		}
+		else
+		{
+			xLength = ( size_t ) 0;
+		}
+	}
+
+	return xLength;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvNextMessageLength( const xSTREAM_BUFFER * const pxStreamBuffer )
+{
+configMESSAGE_BUFFER_LENGTH_TYPE xHeader = ( configMESSAGE_BUFFER_LENGTH_TYPE ) 0;
+
+	if( prvBytesInBuffer( pxStreamBuffer ) >= sbBYTES_TO_STORE_MESSAGE_LENGTH )
+	{
+		( void ) prvCopyFromRing( pxStreamBuffer, pxStreamBuffer->xTail, ( unsigned char * ) &xHeader, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+	}
+
+	return ( size_t ) xHeader;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvReaderShouldWake( const xSTREAM_BUFFER * const pxStreamBuffer, const unsigned char *pucData, size_t xWritten )
+{
+portBASE_TYPE xReturn = pdFALSE;
+
+	if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+	{
+		xReturn = pdTRUE;
+	}
+	else if( pxStreamBuffer->xTerminator != sbNO_TERMINATOR )
+	{
+		if( memchr( ( const void * ) pucData, ( int ) pxStreamBuffer->xTerminator, xWritten ) != NULL )
+		{
+			xReturn = pdTRUE;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyWaitingTask( volatile xTaskHandle *pxWaitingTask )
+{
+	taskENTER_CRITICAL();
+	{
+		/* Check again, as the task may have timed out. */
+		if( *pxWaitingTask != NULL )
+		{
+			( void ) xTaskNotify( *pxWaitingTask, 0UL, eNoAction );
+			*pxWaitingTask = NULL;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyWaitingTaskFromISR( volatile xTaskHandle *pxWaitingTask, portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		/* Check again, as the task may have timed out. */
+		if( *pxWaitingTask != NULL )
+		{
+			( void ) xTaskNotifyFromISR( *pxWaitingTask, 0UL, eNoAction, pxHigherPriorityTaskWoken );
+			*pxWaitingTask = NULL;
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForOtherSide( const xSTREAM_BUFFER * const pxStreamBuffer, volatile xTaskHandle *pxWaitingTask, size_t ( *pxAvailable )( const xSTREAM_BUFFER * const pxStreamBuffer ), size_t xRequired, portTickType xTicksToWait )
+{
+portBASE_TYPE xMustBlock;
+
+	taskENTER_CRITICAL();
+	{
+		/* The other side cannot run while the condition is checked and the
+		waiting task recorded, so a notification cannot be missed. */
+		xMustBlock = ( pxAvailable( pxStreamBuffer ) < xRequired );
+
+		if( xMustBlock != pdFALSE )
+		{
+			/* Discard any notification left over from an earlier wait that
+			timed out as the other side was notifying it.  Only the pending
+			state is cleared, so a notification value the application uses
+			for its own purposes is left alone. */
+			( void ) xTaskNotifyStateClear( NULL );
+
+			configASSERT( *pxWaitingTask == NULL );
+			*pxWaitingTask = xTaskGetCurrentTaskHandle();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xMustBlock != pdFALSE )
+	{
+		/* The other side notifies with eNoAction, and no bits are cleared
+		here, so the notification value is not touched. */
+		( void ) xTaskNotifyWait( 0UL, 0UL, NULL, xTicksToWait );
+
+		/* Clear the reference in case the wait timed out.  The other side may
+		be in the middle of notifying from an interrupt, so the reference is
+		cleared with interrupts masked. */
+		taskENTER_CRITICAL();
+		{
+			*pxWaitingTask = NULL;
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include direct to task notifications.  If you want to include stream
+buffers then ensure configUSE_TASK_NOTIFICATIONS is set to 1 in
+FreeRTOSConfig.h. */
+#endif /* configUSE_TASK_NOTIFICATIONS == 1 */
+
+
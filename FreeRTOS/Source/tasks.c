@@ -77,6 +77,10 @@ task.h is included from an application file. */
 #include "timers.h"
 #include "StackMacros.h"
 
+#if ( configUSE_DEFERRED_CALLS == 1 )
+	#include "deferred.h"
+#endif
+
 #if configGENERATE_RUN_TIME_STATS == 1
 	#include "IntQueueTimer.h"
 	extern volatile unsigned long ulHighFrequencyTimerTicks;
@@ -104,11 +108,110 @@ privileged Vs unprivileged linkage and placement. */
 	#endif /* INCLUDE_vTaskSuspend */
 #endif /* configUSE_TICKLESS_IDLE */
 
+#if configUSE_TIMING_WHEEL == 1
+	#if ( configTIMING_WHEEL_SIZE & ( configTIMING_WHEEL_SIZE - 1 ) ) != 0
+		#error configTIMING_WHEEL_SIZE must be a power of 2
+	#endif
+	#if ( configUSE_16_BIT_TICKS == 1 ) && ( configTIMING_WHEEL_SIZE > 128 )
+		#error configTIMING_WHEEL_SIZE squared must fit within the tick count
+	#endif
+#endif /* configUSE_TIMING_WHEEL */
+
 /*
  * Defines the size, in words, of the stack allocated to the idle task.
  */
 #define tskIDLE_STACK_SIZE	configMINIMAL_STACK_SIZE
 
+/*
+ * The value of the event list item of a task normally holds the priority of
+ * the task, so event lists can be sorted in priority order.  When the task is
+ * blocked on an event group the item value instead holds the bits the task is
+ * waiting for, and this bit is set so the value is not overwritten when the
+ * priority of the task changes.
+ */
+#if configUSE_16_BIT_TICKS == 1
+	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x8000U
+#else
+	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x80000000UL
+#endif
+
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+	/*
+	 * The timing wheel has two levels.  The first has one slot per tick, the
+	 * second one slot per configTIMING_WHEEL_SIZE ticks.
+	 */
+	#define tskTIMING_WHEEL_LEVELS	( 2 )
+	#define tskTIMING_WHEEL_MASK	( ( portTickType ) configTIMING_WHEEL_SIZE - ( portTickType ) 1 )
+	#define tskTIMING_WHEEL_SPAN	( ( portTickType ) configTIMING_WHEEL_SIZE * ( portTickType ) configTIMING_WHEEL_SIZE )
+
+	/* Is pxList one of the timing wheel slots? */
+	#define tskIS_TIMING_WHEEL_LIST( pxList ) ( ( ( pxList ) >= &( xTimingWheel[ 0 ][ 0 ] ) ) && ( ( pxList ) <= &( xTimingWheel[ tskTIMING_WHEEL_LEVELS - 1 ][ configTIMING_WHEEL_SIZE - 1 ] ) ) )
+
+#endif /* configUSE_TIMING_WHEEL */
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	/* Values that can be assigned to the ucNotifyState member of the TCB. */
+	#define taskNOT_WAITING_NOTIFICATION	( ( unsigned char ) 0 )
+	#define taskWAITING_NOTIFICATION		( ( unsigned char ) 1 )
+	#define taskNOTIFICATION_RECEIVED		( ( unsigned char ) 2 )
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+
+#if ( configUSE_CPU_LOAD == 1 )
+
+	/* The run time accumulated by a task, or by all tasks, in periods of
+	tskCPU_LOAD_PERIOD_TICKS ticks, and its exponentially decayed average over
+	each load window.  The averages are brought up to date, lazily, when run
+	time is next added or when they are read, so a task that does not run
+	costs nothing. */
+	typedef struct tskCPU_LOAD
+	{
+		unsigned long ulPeriod;							/*< The period in which ulPeriodRunTime was accumulated. */
+		unsigned long ulPeriodRunTime;					/*< The run time accumulated during ulPeriod. */
+		unsigned long ulLoad[ tskCPU_LOAD_WINDOWS ];	/*< The average run time per period over each window, up to the start of ulPeriod. */
+	} tskCPULoad;
+
+	/* The length of a load period, and the fixed point factor by which the
+	average of each window decays each period - exp( -0.1s / window ) for
+	windows of 1s, 10s and 60s. */
+	#define tskCPU_LOAD_PERIOD_TICKS	( ( portTickType ) configTICK_RATE_HZ / ( portTickType ) 10U )
+	#define tskCPU_LOAD_SHIFT			( 16 )
+	#define tskCPU_LOAD_ONE				( 1UL << tskCPU_LOAD_SHIFT )
+	#define tskCPU_LOAD_DECAY_1S		( 59299UL )
+	#define tskCPU_LOAD_DECAY_10S		( 64884UL )
+	#define tskCPU_LOAD_DECAY_60S		( 65427UL )
+
+#endif /* configUSE_CPU_LOAD */
+
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+
+	/* An entry in the table read by uxTaskGetSnapshot().  uxSequence is
+	incremented before and after xSnapshot is written, so it is odd while a
+	write is in progress, and a reader can tell if its copy of xSnapshot was
+	overwritten while it was being taken. */
+	typedef struct tskSNAPSHOT_SLOT
+	{
+		unsigned portBASE_TYPE uxSequence;
+		xTaskSnapshotType xSnapshot;
+	} tskSnapshotSlot;
+
+#endif /* configUSE_TASK_SNAPSHOT */
+
+#if ( configUSE_TASK_POOL == 1 )
+
+	/* The TCBs of deleted tasks that have stacks of one depth, kept so a task
+	created with a stack of that depth can reuse one without using the heap.
+	A bucket whose list is empty can be given a different depth. */
+	typedef struct tskTASK_POOL_BUCKET
+	{
+		unsigned short usStackDepth;	/*< The depth of the stacks of the TCBs in xTCBs, or 0 if the bucket has not been used. */
+		xList xTCBs;					/*< The TCBs, linked by their xGenericListItem. */
+	} tskTaskPoolBucket;
+
+#endif /* configUSE_TASK_POOL */
+
 /*
  * Task control block.  A task control block (TCB) is allocated for each task,
  * and stores task state information, including a pointer to the task's context
@@ -145,12 +248,38 @@ typedef struct tskTaskControlBlock
 		unsigned portBASE_TYPE uxBasePriority;	/*< The priority last assigned to the task - used by the priority inheritance mechanism. */
 	#endif
 
+	#if ( configUSE_CEILING_MUTEXES == 1 )
+		unsigned portBASE_TYPE uxCeilingPriority;	/*< The highest ceiling of the ceiling mutexes the task holds, or tskIDLE_PRIORITY if it holds none.  The task does not run below this priority. */
+	#endif
+
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 		pdTASK_HOOK_CODE pxTaskTag;
 	#endif
 
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
-		unsigned long ulRunTimeCounter;			/*< Stores the amount of time the task has spent in the Running state. */
+		configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
+		unsigned long ulLongestRunTime;			/*< Stores the longest time the task has run without another task running. */
+	#endif
+
+	#if ( configUSE_CPU_LOAD == 1 )
+		tskCPULoad xCPULoad;					/*< The run time of the task averaged over each load window. */
+	#endif
+
+	#if ( configUSE_TASK_SNAPSHOT == 1 )
+		volatile tskSnapshotSlot *pxSnapshotSlot;	/*< The entry of the snapshot table that holds a copy of this task's counters, or NULL if the table was full when the task was created. */
+	#endif
+
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		volatile unsigned long ulNotifiedValue;	/*< The value sent to the task by xTaskNotify() and friends. */
+		volatile unsigned char ucNotifyState;	/*< One of the taskNOT_WAITING_NOTIFICATION, taskWAITING_NOTIFICATION or taskNOTIFICATION_RECEIVED values. */
+	#endif
+
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		portTickType xPeriod;					/*< The time between the releases of the task's jobs, or 0 if the task has not been given a deadline. */
+		portTickType xRelativeDeadline;			/*< The time from the release of a job to its deadline. */
+		portTickType xReleaseTime;				/*< The time at which the current job was released. */
+		portTickType xAbsoluteDeadline;			/*< The deadline of the current job.  The ready list at configEDF_PRIORITY is ordered by this value. */
+		unsigned portBASE_TYPE uxDeadlineMisses;	/*< The number of jobs that have completed after their deadline. */
 	#endif
 
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
@@ -164,6 +293,14 @@ typedef struct tskTaskControlBlock
 		struct _reent xNewLib_reent;
 	#endif
 
+	#if ( configUSE_TASK_POOL == 1 )
+		unsigned short usStackDepth;			/*< The depth of the stack the kernel allocated for the task, or 0 if the stack was provided by the application.  Only a task with a non-zero depth is kept for reuse when it is deleted. */
+	#endif
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucStaticallyAllocated;	/*< Set to pdTRUE if the TCB and stack were provided by the application, so must not be freed when the task is deleted. */
+	#endif
+
 } tskTCB;
 
 
@@ -188,6 +325,19 @@ PRIVILEGED_DATA static xList * volatile pxDelayedTaskList;				/*< Points to the
 PRIVILEGED_DATA static xList * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
 PRIVILEGED_DATA static xList xPendingReadyList;							/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+	/* Blocked tasks due within configTIMING_WHEEL_SIZE ticks are held in the
+	first level of the wheel, in the slot for their wake time.  Tasks due within
+	configTIMING_WHEEL_SIZE squared ticks are held in the second level, in the
+	slot for their wake time divided by configTIMING_WHEEL_SIZE, and are
+	cascaded into the first level at the start of that window.  Only tasks
+	blocked for longer than the span of the wheel use pxDelayedTaskList and
+	pxOverflowDelayedTaskList. */
+	PRIVILEGED_DATA static xList xTimingWheel[ tskTIMING_WHEEL_LEVELS ][ configTIMING_WHEEL_SIZE ];
+
+#endif
+
 #if ( INCLUDE_vTaskDelete == 1 )
 
 	PRIVILEGED_DATA static xList xTasksWaitingTermination;				/*< Tasks that have been deleted - but the their memory not yet freed. */
@@ -219,10 +369,51 @@ PRIVILEGED_DATA static volatile portBASE_TYPE xNumOfOverflows 					= ( portBASE_
 PRIVILEGED_DATA static unsigned portBASE_TYPE uxTaskNumber 						= ( unsigned portBASE_TYPE ) 0U;
 PRIVILEGED_DATA static volatile portTickType xNextTaskUnblockTime				= portMAX_DELAY;
 
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+	/* When there are more priorities than the port's ready priority bitmap
+	holds, uxTopReadyPriority records which groups of portREADY_PRIORITY_BITS
+	priorities contain a ready task, and uxReadyPriorities[] records the ready
+	priorities within each group. */
+	#if ( configMAX_PRIORITIES > portREADY_PRIORITY_BITS )
+		#define taskREADY_PRIORITY_GROUPS	( ( configMAX_PRIORITIES + portREADY_PRIORITY_BITS - 1 ) / portREADY_PRIORITY_BITS )
+		PRIVILEGED_DATA static volatile unsigned portBASE_TYPE uxReadyPriorities[ taskREADY_PRIORITY_GROUPS ];
+	#endif
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
-	PRIVILEGED_DATA static unsigned long ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
-	PRIVILEGED_DATA static unsigned long ulTotalRunTime = 0UL;			/*< Holds the total amount of execution time as defined by the run time counter clock. */
+	PRIVILEGED_DATA static volatile unsigned long ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time the run time of the running task was accumulated. */
+	PRIVILEGED_DATA static unsigned long ulTotalRunTime = 0UL;			/*< Holds the value of the timer/counter when it was last read. */
+	PRIVILEGED_DATA static volatile unsigned long ulTaskRunStartTime = 0UL;		/*< Holds the value of the timer/counter when a task other than the previous task was last switched in. */
+	PRIVILEGED_DATA static volatile configRUN_TIME_COUNTER_TYPE xRunTimeTotal = 0;	/*< Holds the total amount of execution time accumulated up to ulTaskSwitchedInTime. */
+
+#endif
+
+#if ( configUSE_CPU_LOAD == 1 )
+
+	PRIVILEGED_DATA static unsigned long ulCPULoadPeriod = 0UL;			/*< Counts load periods. */
+	PRIVILEGED_DATA static portTickType xTicksToCPULoadPeriod = tskCPU_LOAD_PERIOD_TICKS;	/*< The number of ticks until the next load period starts. */
+	PRIVILEGED_DATA static tskCPULoad xCPULoadTotal;					/*< The run time of all tasks averaged over each load window. */
+
+#endif
+
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+
+	PRIVILEGED_DATA static volatile tskSnapshotSlot xSnapshotSlots[ configTASK_SNAPSHOT_SLOTS ];	/*< The table read by uxTaskGetSnapshot().  An entry with a NULL handle is not in use. */
+
+#endif
+
+#if ( configUSE_TASK_POOL == 1 )
+
+	PRIVILEGED_DATA static tskTaskPoolBucket xTaskPool[ configTASK_POOL_DEPTHS ];	/*< The TCBs and stacks of deleted tasks, kept for reuse. */
+
+#endif
+
+#if ( configUSE_TIMER_HISTOGRAMS == 1 )
+
+	PRIVILEGED_DATA static volatile unsigned long ulTickTimestamp = 0UL;	/*< configTIMER_HISTOGRAM_TIMESTAMP() when xTickCount last changed. */
 
 #endif
 
@@ -246,6 +437,38 @@ PRIVILEGED_DATA static volatile portTickType xNextTaskUnblockTime				= portMAX_D
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	/* Tick times are compared allowing for overflow, so xTimeA is before
+	xTimeB if it is less than half the range of portTickType behind it. */
+	#define taskTIME_IS_BEFORE( xTimeA, xTimeB ) ( ( portTickType ) ( ( xTimeA ) - ( xTimeB ) ) > ( portMAX_DELAY >> 1 ) )
+
+	/* The ready list at configEDF_PRIORITY holds the tasks that have been
+	given a deadline in deadline order, followed by any other tasks.  If the
+	task at the head of the list has a deadline it has the earliest deadline,
+	so is selected.  Otherwise there are only tasks without a deadline, and
+	they are selected in turn as at any other priority. */
+	#define taskSELECT_FROM_READY_LIST( uxPriority )																	\
+	{																													\
+		if( ( ( uxPriority ) == configEDF_PRIORITY ) &&																\
+			( ( ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ configEDF_PRIORITY ] ) ) )->xPeriod != ( portTickType ) 0 ) ) \
+		{																												\
+			pxCurrentTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ configEDF_PRIORITY ] ) );		\
+		}																												\
+		else																											\
+		{																												\
+			listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) );						\
+		}																												\
+	}
+
+#else /* configUSE_EDF_SCHEDULING */
+
+	#define taskSELECT_FROM_READY_LIST( uxPriority ) listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
@@ -275,16 +498,16 @@ PRIVILEGED_DATA static volatile portTickType xNextTaskUnblockTime				= portMAX_D
 																														\
 		/* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of										\
 		the	same priority get an equal share of the processor time. */													\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopReadyPriority ] ) );						\
+		taskSELECT_FROM_READY_LIST( uxTopReadyPriority );																\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
 	/*-----------------------------------------------------------*/
 
-	/* Define away taskRESET_READY_PRIORITY() and portRESET_READY_PRIORITY() as
+	/* Define away taskRESET_READY_PRIORITY() and taskCLEAR_READY_PRIORITY() as
 	they are only required when a port optimised method of task selection is
 	being used. */
 	#define taskRESET_READY_PRIORITY( uxPriority )
-	#define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )
+	#define taskCLEAR_READY_PRIORITY( uxPriority )
 
 #else /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
@@ -292,8 +515,45 @@ PRIVILEGED_DATA static volatile portTickType xNextTaskUnblockTime				= portMAX_D
 	performed in a way that is tailored to the particular microcontroller
 	architecture being used. */
 
-	/* A port optimised version is provided.  Call the port defined macros. */
-	#define taskRECORD_READY_PRIORITY( uxPriority )	portRECORD_READY_PRIORITY( uxPriority, uxTopReadyPriority )
+	#if ( configMAX_PRIORITIES <= portREADY_PRIORITY_BITS )
+
+		/* A port optimised version is provided.  Call the port defined macros.
+		taskCLEAR_READY_PRIORITY() must only be called when the ready list of
+		uxPriority is empty. */
+		#define taskRECORD_READY_PRIORITY( uxPriority )	portRECORD_READY_PRIORITY( uxPriority, uxTopReadyPriority )
+		#define taskCLEAR_READY_PRIORITY( uxPriority )	portRESET_READY_PRIORITY( ( uxPriority ), uxTopReadyPriority )
+		#define taskGET_HIGHEST_PRIORITY( uxTopPriority )	portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority )
+
+	#else /* configMAX_PRIORITIES */
+
+		/* The port defined macros are used on two levels of bitmap.  The
+		highest group that contains a ready task is found first, then the
+		highest ready priority within that group. */
+		#define taskRECORD_READY_PRIORITY( uxPriority )																	\
+		{																												\
+			portRECORD_READY_PRIORITY( ( uxPriority ) % portREADY_PRIORITY_BITS, uxReadyPriorities[ ( uxPriority ) / portREADY_PRIORITY_BITS ] );	\
+			portRECORD_READY_PRIORITY( ( uxPriority ) / portREADY_PRIORITY_BITS, uxTopReadyPriority );					\
+		}
+
+		#define taskCLEAR_READY_PRIORITY( uxPriority )																	\
+		{																												\
+			portRESET_READY_PRIORITY( ( uxPriority ) % portREADY_PRIORITY_BITS, uxReadyPriorities[ ( uxPriority ) / portREADY_PRIORITY_BITS ] );		\
+			if( uxReadyPriorities[ ( uxPriority ) / portREADY_PRIORITY_BITS ] == ( unsigned portBASE_TYPE ) 0 )			\
+			{																											\
+				portRESET_READY_PRIORITY( ( uxPriority ) / portREADY_PRIORITY_BITS, uxTopReadyPriority );				\
+			}																											\
+		}
+
+		#define taskGET_HIGHEST_PRIORITY( uxTopPriority )																\
+		{																												\
+		unsigned portBASE_TYPE uxTopGroup;																				\
+																														\
+			portGET_HIGHEST_PRIORITY( uxTopGroup, uxTopReadyPriority );													\
+			portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities[ uxTopGroup ] );									\
+			uxTopPriority += uxTopGroup * portREADY_PRIORITY_BITS;														\
+		}
+
+	#endif /* configMAX_PRIORITIES */
 
 	/*-----------------------------------------------------------*/
 
@@ -302,9 +562,9 @@ PRIVILEGED_DATA static volatile portTickType xNextTaskUnblockTime				= portMAX_D
 	unsigned portBASE_TYPE uxTopPriority;															\
 																									\
 		/* Find the highest priority queue that contains ready tasks. */							\
-		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );								\
+		taskGET_HIGHEST_PRIORITY( uxTopPriority );													\
 		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
+		taskSELECT_FROM_READY_LIST( uxTopPriority );												\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 	/*-----------------------------------------------------------*/
@@ -316,7 +576,7 @@ PRIVILEGED_DATA static volatile portTickType xNextTaskUnblockTime				= portMAX_D
 	{																								\
 		if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == 0 )				\
 		{																							\
-			portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );						\
+			taskCLEAR_READY_PRIORITY( ( uxPriority ) );												\
 		}																							\
 	}
 
@@ -362,12 +622,31 @@ count overflows. */
 
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * the task.  It is inserted at the end of the list, except at
+ * configEDF_PRIORITY where the list is kept in deadline order.
  */
-#define prvAddTaskToReadyList( pxTCB )																				\
-	traceMOVED_TASK_TO_READY_STATE( pxTCB )																			\
-	taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );																\
-	vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xGenericListItem ) )
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	#define prvAddTaskToReadyList( pxTCB )																			\
+		traceMOVED_TASK_TO_READY_STATE( pxTCB )																		\
+		taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );															\
+		if( ( pxTCB )->uxPriority == configEDF_PRIORITY )															\
+		{																											\
+			prvAddTaskToDeadlineReadyList( pxTCB );																	\
+		}																											\
+		else																										\
+		{																											\
+			vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xGenericListItem ) );	\
+		}
+
+#else /* configUSE_EDF_SCHEDULING */
+
+	#define prvAddTaskToReadyList( pxTCB )																			\
+		traceMOVED_TASK_TO_READY_STATE( pxTCB )																		\
+		taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );															\
+		vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xGenericListItem ) )
+
+#endif /* configUSE_EDF_SCHEDULING */
 /*-----------------------------------------------------------*/
 
 /*
@@ -378,6 +657,61 @@ count overflows. */
  */
 #define prvGetTCBFromHandle( pxHandle ) ( ( ( pxHandle ) == NULL ) ? ( tskTCB * ) pxCurrentTCB : ( tskTCB * ) ( pxHandle ) )
 
+/*
+ * The priority a mutex holder returns to when it disinherits a priority.  A
+ * task that still holds a ceiling mutex returns to the ceiling rather than
+ * to its base priority if the ceiling is the higher of the two.
+ */
+#if ( configUSE_CEILING_MUTEXES == 1 )
+	#define taskUNINHERITED_PRIORITY( pxTCB )	( ( ( pxTCB )->uxCeilingPriority > ( pxTCB )->uxBasePriority ) ? ( pxTCB )->uxCeilingPriority : ( pxTCB )->uxBasePriority )
+#else
+	#define taskUNINHERITED_PRIORITY( pxTCB )	( ( pxTCB )->uxBasePriority )
+#endif
+
+/*
+ * Copy the priorities, or the run time counters, of the task represented by
+ * pxTCB into its entry of the snapshot table.  Entries are only written from
+ * a critical section or from the context switch, so a write is never
+ * interrupted by a reader.  The entries are volatile, so the compiler keeps
+ * the writes between the two increments of the sequence number.
+ */
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+
+	#if ( configUSE_MUTEXES == 1 )
+		#define taskBASE_PRIORITY( pxTCB )	( ( pxTCB )->uxBasePriority )
+	#else
+		#define taskBASE_PRIORITY( pxTCB )	( ( pxTCB )->uxPriority )
+	#endif
+
+	#define taskSNAPSHOT_PRIORITIES( pxTCB )												\
+	{																						\
+		if( ( pxTCB )->pxSnapshotSlot != NULL )												\
+		{																					\
+			( ( pxTCB )->pxSnapshotSlot->uxSequence )++;									\
+			( pxTCB )->pxSnapshotSlot->xSnapshot.uxCurrentPriority = ( pxTCB )->uxPriority;	\
+			( pxTCB )->pxSnapshotSlot->xSnapshot.uxBasePriority = taskBASE_PRIORITY( pxTCB );	\
+			( ( pxTCB )->pxSnapshotSlot->uxSequence )++;									\
+		}																					\
+	}
+
+	#define taskSNAPSHOT_RUN_TIME( pxTCB )													\
+	{																						\
+		if( ( pxTCB )->pxSnapshotSlot != NULL )												\
+		{																					\
+			( ( pxTCB )->pxSnapshotSlot->uxSequence )++;									\
+			( pxTCB )->pxSnapshotSlot->xSnapshot.ulRunTimeCounter = ( pxTCB )->ulRunTimeCounter;	\
+			( pxTCB )->pxSnapshotSlot->xSnapshot.ulLongestRunTime = ( pxTCB )->ulLongestRunTime;	\
+			( ( pxTCB )->pxSnapshotSlot->uxSequence )++;									\
+		}																					\
+	}
+
+#else /* configUSE_TASK_SNAPSHOT */
+
+	#define taskSNAPSHOT_PRIORITIES( pxTCB )
+	#define taskSNAPSHOT_RUN_TIME( pxTCB )
+
+#endif /* configUSE_TASK_SNAPSHOT */
+
 /* Callback function prototypes. --------------------------*/
 extern void vApplicationStackOverflowHook( xTaskHandle xTask, signed char *pcTaskName );
 extern void vApplicationTickHook( void );
@@ -422,24 +756,232 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters );
 
 #endif
 
+#if ( configUSE_TASK_POOL == 1 )
+
+	/*
+	 * Removes and returns a TCB with a stack usStackDepth deep from the pool,
+	 * or returns NULL if the pool does not hold one.
+	 */
+	static tskTCB *prvTakeFromTaskPool( unsigned short usStackDepth ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Adds the TCB of a deleted task to the pool.  Returns pdFALSE, and leaves
+	 * the TCB to be freed, if the stack was not allocated by the kernel or the
+	 * pool has no room for a stack of its depth.
+	 */
+	static portBASE_TYPE prvReturnToTaskPool( tskTCB *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TASK_POOL */
+
 /*
  * Used only by the idle task.  This checks to see if anything has been placed
- * in the list of tasks waiting to be deleted.  If so the task is cleaned up
- * and its TCB deleted.
+ * in the list of tasks waiting to be deleted.  If so the tasks are cleaned up,
+ * up to configIDLE_RECLAIM_BATCH at a time, and their TCBs deleted.
  */
 static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
 
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	/*
+	 * Add the time since the run time counter was last read to the run time
+	 * of the running task, and to the total run time.
+	 */
+	static void prvAccountRunTime( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns the total run time of all tasks, including the running task, up
+	 * to now.  Neither the scheduler nor interrupts need to be disabled.
+	 */
+	static configRUN_TIME_COUNTER_TYPE prvGetTotalRunTime( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns the longer of ulLongestRunTime and the time for which the running
+	 * task has run so far without another task running.  ulLongestRunTime is
+	 * only updated when a task is switched out, so this is used to report the
+	 * longest run time of the running task.
+	 */
+	static unsigned long prvGetRunningTaskLongestRunTime( unsigned long ulLongestRunTime ) PRIVILEGED_FUNCTION;
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+
+#if ( configUSE_CPU_LOAD == 1 )
+
+	/*
+	 * Called with each tick, or after the tick has been suppressed for
+	 * xTicks ticks, to start a new load period when one is due.
+	 */
+	static void prvCPULoadStep( portTickType xTicks ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Fold the run time accumulated in an earlier period into the averages of
+	 * pxLoad, and decay them for each later period, so pxLoad is up to date
+	 * with the current period.
+	 */
+	static void prvCPULoadAdvance( tskCPULoad *pxLoad ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns ulLoad multiplied by the fixed point ulFactor raised to the power
+	 * ulPeriods.
+	 */
+	static unsigned long prvCPULoadDecay( unsigned long ulLoad, unsigned long ulFactor, unsigned long ulPeriods ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_CPU_LOAD */
+
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+
+	/*
+	 * Give a newly created task an entry in the snapshot table, if one is
+	 * free, and take the entry back when the task is deleted.  Both must be
+	 * called from a critical section.
+	 */
+	static void prvSnapshotAddTask( tskTCB *pxTCB ) PRIVILEGED_FUNCTION;
+	static void prvSnapshotRemoveTask( tskTCB *pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Copy an entry of the snapshot table into *pxSnapshot, again if it was
+	 * written during the copy.
+	 */
+	static void prvSnapshotCopySlot( volatile tskSnapshotSlot *pxSlot, xTaskSnapshotType *pxSnapshot ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TASK_SNAPSHOT */
+
+#if ( ( configUSE_TASK_SNAPSHOT == 1 ) && ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) )
+
+	/*
+	 * Used only by the idle task.  Measures the stack high water mark of the
+	 * task in the next entry of the snapshot table, so each pass of the idle
+	 * loop measures one task.
+	 */
+	static void prvSnapshotMeasureStack( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( ( INCLUDE_eTaskGetState == 1 ) || ( ( configUSE_STATS_STREAM == 1 ) && ( configUSE_TASK_SNAPSHOT == 1 ) ) )
+
+	/*
+	 * Returns the state of a task that is not running, given the list that
+	 * references its generic list item.
+	 */
+	static eTaskState prvTaskStateFromList( const xList *pxStateList ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( ( configCHECK_FOR_STACK_OVERFLOW > 2 ) && ( configSTACK_GUARD_SCAN_PERIOD > 0 ) )
+
+	/*
+	 * Used only by the idle task.  Checks every guard word at the end of the
+	 * stack of every task, once each configSTACK_GUARD_SCAN_PERIOD ticks, and
+	 * calls the stack overflow hook for each task that has written to one.
+	 */
+	static void prvCheckTaskStacks( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Checks the guard words of each task referenced from pxList.  The list
+	 * is only read, so the index used to share time between tasks of equal
+	 * priority is not moved.
+	 */
+	static void prvCheckStacksWithinSingleList( xList *pxList ) PRIVILEGED_FUNCTION;
+
+#endif /* configCHECK_FOR_STACK_OVERFLOW */
+
 /*
  * The currently executing task is entering the Blocked state.  Add the task to
  * either the current or the overflow delayed task list.
  */
 static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+	/*
+	 * Place a blocked task into the timing wheel slot for its wake time.  The
+	 * wake time must be less than tskTIMING_WHEEL_SPAN ticks after xTimeNow.
+	 * This is constant time, as the task is inserted at the end of an unsorted
+	 * slot.
+	 */
+	static void prvTimingWheelInsert( xListItem *pxListItem, portTickType xTimeToWake, portTickType xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called each time the tick count reaches a multiple of
+	 * configTIMING_WHEEL_SIZE.  Moves the tasks held in the second level slot
+	 * for the window that is starting into the first level and, each time the
+	 * whole wheel has turned, moves tasks that have come within the span of the
+	 * wheel out of pxDelayedTaskList.
+	 */
+	static void prvTimingWheelCascade( portTickType xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Return the earliest time at which the tick interrupt might have to move
+	 * or unblock a task held in the timing wheel or the delayed lists.  Walks
+	 * every slot so is only used to calculate the expected idle time.
+	 */
+	#if ( configUSE_TICKLESS_IDLE != 0 )
+
+		static portTickType prvTimingWheelNextUnblockTime( void ) PRIVILEGED_FUNCTION;
+
+	#endif
+
+#endif /* configUSE_TIMING_WHEEL */
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	/*
+	 * Move the calling task out of the ready list and into the Blocked state to
+	 * wait for a notification.  The task is not placed on an event list as the
+	 * notification is sent directly to its TCB.  Must be called from a critical
+	 * section.
+	 */
+	static void prvBlockCurrentTaskForNotification( portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Update the notification value of pxTCB as described by eAction.  Returns
+	 * pdFAIL if eAction is eSetValueWithoutOverwrite and a notification was
+	 * already pending, otherwise pdPASS.
+	 */
+	static portBASE_TYPE prvUpdateNotifiedValue( tskTCB *pxTCB, unsigned long ulValue, eNotifyAction eAction, unsigned char ucOriginalNotifyState ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by the task being notified, from a critical section, once it
+	 * either has a notification or will not block.  Consume the notification
+	 * and return the value to pass back from ulTaskNotifyTake() or
+	 * xTaskNotifyWait() respectively.
+	 */
+	static unsigned long prvTakeNotifiedValue( portBASE_TYPE xClearCountOnExit ) PRIVILEGED_FUNCTION;
+	static portBASE_TYPE prvReceiveNotification( unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	/*
+	 * Insert pxTCB into the ready list at configEDF_PRIORITY.  A task that
+	 * has been given a deadline is inserted after the tasks whose deadline is
+	 * not later than its own, and before every task that has not been given a
+	 * deadline.  A task that has not been given a deadline is inserted at the
+	 * end of the list.
+	 */
+	static void prvAddTaskToDeadlineReadyList( tskTCB *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_EDF_SCHEDULING */
+
 /*
  * Allocates memory from the heap for a TCB and associated stack.  Checks the
- * allocation was successful.
+ * allocation was successful.  If pxTCBBuffer is not NULL the TCB is placed in
+ * pxTCBBuffer and the stack in puxStackBuffer instead, and nothing is
+ * allocated.  If configUSE_TASK_POOL is 1 the TCB and stack of a deleted task
+ * are reused in preference to the heap.
+ */
+static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer, tskTCB *pxTCBBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Allocates memory from the heap for a TCB and, unless puxStackBuffer is
+ * provided, for its stack.  Returns NULL if either allocation fails.
+ */
+static tskTCB *prvAllocateTCBAndStackFromHeap( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Creates a task for xTaskGenericCreate() and xTaskCreateStatic().
  */
-static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer ) PRIVILEGED_FUNCTION;
+static signed portBASE_TYPE prvTaskCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions, tskTCB *pxTCBBuffer ) PRIVILEGED_FUNCTION;
 
 /*
  * Fills an xTaskStatusType structure with information on each task that is
@@ -455,6 +997,40 @@ static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TY
 
 #endif
 
+/*
+ * Completes the xTaskGetStatsStream() frame that starts at pucFrame, the
+ * ucLength byte payload of which has already been written, and returns the
+ * position of the next frame.
+ */
+#if ( configUSE_STATS_STREAM == 1 )
+
+	static unsigned char *prvEndStatsFrame( unsigned char *pucFrame, unsigned char ucType, unsigned char ucLength ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Fills pxTaskStatusArray for xTaskGetStatsStream() from the task snapshot,
+ * using pxSnapshotArray to hold the copies of the snapshot entries that the
+ * task names point into.  Each task's state is read in a critical section of
+ * its own, so the scheduler is not suspended.
+ */
+#if ( ( configUSE_STATS_STREAM == 1 ) && ( configUSE_TASK_SNAPSHOT == 1 ) )
+
+	static unsigned portBASE_TYPE prvGetSnapshotSystemState( xTaskStatusType *pxTaskStatusArray, xTaskSnapshotType *pxSnapshotArray, unsigned portBASE_TYPE uxArraySize, configRUN_TIME_COUNTER_TYPE *pulTotalRunTime ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Changes the priority at which the holder of a ceiling mutex runs, moving it
+ * to the ready list for its new priority if it is in the ready state.  Must be
+ * called from a critical section.
+ */
+#if ( configUSE_CEILING_MUTEXES == 1 )
+
+	static void prvSetMutexHolderPriority( tskTCB * const pxTCB, unsigned portBASE_TYPE uxNewPriority ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * When a task is created, the stack of the task is filled with a known value.
  * This function determines the 'high water mark' of the task stack by
@@ -482,6 +1058,29 @@ static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TY
 #endif
 
 signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions )
+{
+	return prvTaskCreate( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, puxStackBuffer, xRegions, NULL );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	signed portBASE_TYPE xTaskCreateStatic( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE * const puxStackBuffer, xStaticTaskType * const pxTaskBuffer )
+	{
+		configASSERT( puxStackBuffer );
+		configASSERT( pxTaskBuffer );
+
+		/* If this fails xStaticTaskType has not been kept in step with the
+		TCB. */
+		configASSERT( sizeof( xStaticTaskType ) == sizeof( tskTCB ) );
+
+		return prvTaskCreate( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, puxStackBuffer, NULL, ( tskTCB * ) pxTaskBuffer );
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static signed portBASE_TYPE prvTaskCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions, tskTCB *pxTCBBuffer )
 {
 signed portBASE_TYPE xReturn;
 tskTCB * pxNewTCB;
@@ -491,7 +1090,7 @@ tskTCB * pxNewTCB;
 
 	/* Allocate the memory required by the TCB and stack for the new task,
 	checking that the allocation was successful. */
-	pxNewTCB = prvAllocateTCBAndStack( usStackDepth, puxStackBuffer );
+	pxNewTCB = prvAllocateTCBAndStack( usStackDepth, puxStackBuffer, pxTCBBuffer );
 
 	if( pxNewTCB != NULL )
 	{
@@ -603,6 +1202,12 @@ tskTCB * pxNewTCB;
 				pxNewTCB->uxTCBNumber = uxTaskNumber;
 			}
 			#endif /* configUSE_TRACE_FACILITY */
+
+			#if ( configUSE_TASK_SNAPSHOT == 1 )
+			{
+				prvSnapshotAddTask( pxNewTCB );
+			}
+			#endif /* configUSE_TASK_SNAPSHOT */
 			traceTASK_CREATE( pxNewTCB );
 
 			prvAddTaskToReadyList( pxNewTCB );
@@ -663,6 +1268,12 @@ tskTCB * pxNewTCB;
 
 			vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xGenericListItem ) );
 
+			#if ( configUSE_TASK_SNAPSHOT == 1 )
+			{
+				prvSnapshotRemoveTask( pxTCB );
+			}
+			#endif /* configUSE_TASK_SNAPSHOT */
+
 			/* Increment the ucTasksDeleted variable so the idle task knows
 			there is a task that has been deleted and that it should therefore
 			check the xTasksWaitingTermination list. */
@@ -744,9 +1355,9 @@ tskTCB * pxNewTCB;
 				if( uxListRemove( &( pxCurrentTCB->xGenericListItem ) ) == ( unsigned portBASE_TYPE ) 0 )
 				{
 					/* The current task must be in a ready list, so there is
-					no need to check, and the port reset macro can be called
+					no need to check, and the ready priority can be cleared
 					directly. */
-					portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+					taskCLEAR_READY_PRIORITY( pxCurrentTCB->uxPriority );
 				}
 
 				prvAddCurrentTaskToDelayedList( xTimeToWake );
@@ -797,9 +1408,9 @@ tskTCB * pxNewTCB;
 				if( uxListRemove( &( pxCurrentTCB->xGenericListItem ) ) == ( unsigned portBASE_TYPE ) 0 )
 				{
 					/* The current task must be in a ready list, so there is
-					no need to check, and the port reset macro can be called
+					no need to check, and the ready priority can be cleared
 					directly. */
-					portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+					taskCLEAR_READY_PRIORITY( pxCurrentTCB->uxPriority );
 				}
 				prvAddCurrentTaskToDelayedList( xTimeToWake );
 			}
@@ -817,69 +1428,232 @@ tskTCB * pxNewTCB;
 #endif /* INCLUDE_vTaskDelay */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_eTaskGetState == 1 )
+#if ( configUSE_EDF_SCHEDULING == 1 )
 
-	eTaskState eTaskGetState( xTaskHandle xTask )
+	void vTaskSetPeriodicDeadline( xTaskHandle xTask, portTickType xPeriod, portTickType xRelativeDeadline )
 	{
-	eTaskState eReturn;
-	xList *pxStateList;
-	const tskTCB * const pxTCB = ( tskTCB * ) xTask;
+	tskTCB *pxTCB;
 
-		if( pxTCB == pxCurrentTCB )
-		{
-			/* The task calling this function is querying its own state. */
-			eReturn = eRunning;
-		}
-		else
+		configASSERT( xPeriod > ( portTickType ) 0U );
+		configASSERT( xRelativeDeadline > ( portTickType ) 0U );
+
+		taskENTER_CRITICAL();
 		{
-			taskENTER_CRITICAL();
+			/* If null is passed in here then we are setting the deadline of
+			the calling task. */
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			/* Only tasks at configEDF_PRIORITY are scheduled by deadline. */
+			#if ( configUSE_MUTEXES == 1 )
 			{
-				pxStateList = ( xList * ) listLIST_ITEM_CONTAINER( &( pxTCB->xGenericListItem ) );
+				configASSERT( pxTCB->uxBasePriority == configEDF_PRIORITY );
 			}
-			taskEXIT_CRITICAL();
-
-			if( ( pxStateList == pxDelayedTaskList ) || ( pxStateList == pxOverflowDelayedTaskList ) )
+			#else
 			{
-				/* The task being queried is referenced from one of the Blocked
-				lists. */
-				eReturn = eBlocked;
+				configASSERT( pxTCB->uxPriority == configEDF_PRIORITY );
 			}
-
-			#if ( INCLUDE_vTaskSuspend == 1 )
-				else if( pxStateList == &xSuspendedTaskList )
-				{
-					/* The task being queried is referenced from the suspended
-					list. */
-					eReturn = eSuspended;
-				}
 			#endif
 
-			#if ( INCLUDE_vTaskDelete == 1 )
-				else if( pxStateList == &xTasksWaitingTermination )
+			/* The first job is released now. */
+			pxTCB->xPeriod = xPeriod;
+			pxTCB->xRelativeDeadline = xRelativeDeadline;
+			pxTCB->xReleaseTime = xTickCount;
+			pxTCB->xAbsoluteDeadline = xTickCount + xRelativeDeadline;
+			pxTCB->uxDeadlineMisses = ( unsigned portBASE_TYPE ) 0U;
+
+			/* If the task is ready it has to be moved to its place in
+			deadline order, after which a different task might have the
+			earliest deadline.  The list is not empty after the task is
+			inserted again, so the ready priority does not need resetting. */
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ configEDF_PRIORITY ] ), &( pxTCB->xGenericListItem ) ) != pdFALSE )
+			{
+				( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+				prvAddTaskToReadyList( pxTCB );
+
+				if( ( xSchedulerRunning != pdFALSE ) && ( pxCurrentTCB->uxPriority == configEDF_PRIORITY ) )
 				{
-					/* The task being queried is referenced from the deleted
-					tasks list. */
-					eReturn = eDeleted;
+					portYIELD_WITHIN_API();
 				}
-			#endif
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
 
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	void vTaskWaitForNextPeriod( void )
+	{
+	portBASE_TYPE xAlreadyYielded;
+
+		/* The calling task must have been given a deadline. */
+		configASSERT( pxCurrentTCB->xPeriod != ( portTickType ) 0U );
+
+		vTaskSuspendAll();
+		{
+			/* Minor optimisation.  The tick count cannot change in this
+			block. */
+			const portTickType xConstTickCount = xTickCount;
+
+			/* The current job has completed.  It completed late if the tick
+			in which it had to complete has already ended. */
+			if( taskTIME_IS_BEFORE( xConstTickCount, pxCurrentTCB->xAbsoluteDeadline ) == pdFALSE )
+			{
+				( pxCurrentTCB->uxDeadlineMisses )++;
+				traceTASK_DEADLINE_MISSED( pxCurrentTCB );
+			}
+
+			/* Work out the release time and deadline of the next job. */
+			pxCurrentTCB->xReleaseTime += pxCurrentTCB->xPeriod;
+			pxCurrentTCB->xAbsoluteDeadline = pxCurrentTCB->xReleaseTime + pxCurrentTCB->xRelativeDeadline;
+
+			/* We must remove ourselves from the ready list before adding
+			ourselves to the blocked list as the same list item is used for
+			both lists.  If the next job has already been released the task is
+			removed anyway, so it can be inserted again in its new place in
+			deadline order. */
+			if( uxListRemove( &( pxCurrentTCB->xGenericListItem ) ) == ( unsigned portBASE_TYPE ) 0 )
+			{
+				/* The current task must be in a ready list, so there is
+				no need to check, and the ready priority can be cleared
+				directly. */
+				taskCLEAR_READY_PRIORITY( pxCurrentTCB->uxPriority );
+			}
+
+			if( taskTIME_IS_BEFORE( xConstTickCount, pxCurrentTCB->xReleaseTime ) != pdFALSE )
+			{
+				traceTASK_DELAY_UNTIL();
+				prvAddCurrentTaskToDelayedList( pxCurrentTCB->xReleaseTime );
+			}
 			else
 			{
-				/* If the task is not in any other state, it must be in the
-				Ready (including pending ready) state. */
-				eReturn = eReady;
+				prvAddTaskToReadyList( pxCurrentTCB );
 			}
 		}
+		xAlreadyYielded = xTaskResumeAll();
 
-		return eReturn;
+		/* Force a reschedule if xTaskResumeAll has not already done so, we may
+		have put ourselves to sleep, or no longer have the earliest
+		deadline. */
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
 	}
 
-#endif /* INCLUDE_eTaskGetState */
+#endif /* configUSE_EDF_SCHEDULING */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_uxTaskPriorityGet == 1 )
+#if ( configUSE_EDF_SCHEDULING == 1 )
 
-	unsigned portBASE_TYPE uxTaskPriorityGet( xTaskHandle xTask )
+	unsigned portBASE_TYPE uxTaskGetDeadlineMisses( xTaskHandle xTask )
+	{
+	tskTCB *pxTCB;
+	unsigned portBASE_TYPE uxReturn;
+
+		taskENTER_CRITICAL();
+		{
+			/* If null is passed in here then we are querying the calling
+			task. */
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxReturn = pxTCB->uxDeadlineMisses;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_eTaskGetState == 1 ) || ( ( configUSE_STATS_STREAM == 1 ) && ( configUSE_TASK_SNAPSHOT == 1 ) ) )
+
+	static eTaskState prvTaskStateFromList( const xList *pxStateList )
+	{
+	eTaskState eReturn;
+
+		if( ( pxStateList == pxDelayedTaskList ) || ( pxStateList == pxOverflowDelayedTaskList ) )
+		{
+			/* The task being queried is referenced from one of the Blocked
+			lists. */
+			eReturn = eBlocked;
+		}
+
+		#if ( configUSE_TIMING_WHEEL == 1 )
+			else if( tskIS_TIMING_WHEEL_LIST( pxStateList ) )
+			{
+				/* The task being queried is referenced from one of the
+				timing wheel slots, so is also Blocked. */
+				eReturn = eBlocked;
+			}
+		#endif
+
+		#if ( INCLUDE_vTaskSuspend == 1 )
+			else if( pxStateList == &xSuspendedTaskList )
+			{
+				/* The task being queried is referenced from the suspended
+				list. */
+				eReturn = eSuspended;
+			}
+		#endif
+
+		#if ( INCLUDE_vTaskDelete == 1 )
+			else if( pxStateList == &xTasksWaitingTermination )
+			{
+				/* The task being queried is referenced from the deleted
+				tasks list. */
+				eReturn = eDeleted;
+			}
+		#endif
+
+		else
+		{
+			/* If the task is not in any other state, it must be in the
+			Ready (including pending ready) state. */
+			eReturn = eReady;
+		}
+
+		return eReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_eTaskGetState == 1 )
+
+	eTaskState eTaskGetState( xTaskHandle xTask )
+	{
+	eTaskState eReturn;
+	xList *pxStateList;
+	const tskTCB * const pxTCB = ( tskTCB * ) xTask;
+
+		if( pxTCB == pxCurrentTCB )
+		{
+			/* The task calling this function is querying its own state. */
+			eReturn = eRunning;
+		}
+		else
+		{
+			taskENTER_CRITICAL();
+			{
+				pxStateList = ( xList * ) listLIST_ITEM_CONTAINER( &( pxTCB->xGenericListItem ) );
+			}
+			taskEXIT_CRITICAL();
+
+			eReturn = prvTaskStateFromList( pxStateList );
+		}
+
+		return eReturn;
+	}
+
+#endif /* INCLUDE_eTaskGetState */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskPriorityGet == 1 )
+
+	unsigned portBASE_TYPE uxTaskPriorityGet( xTaskHandle xTask )
 	{
 	tskTCB *pxTCB;
 	unsigned portBASE_TYPE uxReturn;
@@ -986,6 +1760,17 @@ tskTCB * pxNewTCB;
 
 					/* The base priority gets set whatever. */
 					pxTCB->uxBasePriority = uxNewPriority;
+
+					#if ( configUSE_CEILING_MUTEXES == 1 )
+					{
+						/* A task that holds a ceiling mutex does not run
+						below the ceiling, whatever its base priority. */
+						if( pxTCB->uxPriority < pxTCB->uxCeilingPriority )
+						{
+							pxTCB->uxPriority = pxTCB->uxCeilingPriority;
+						}
+					}
+					#endif
 				}
 				#else
 				{
@@ -993,7 +1778,14 @@ tskTCB * pxNewTCB;
 				}
 				#endif
 
-				listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( portTickType ) configMAX_PRIORITIES - ( portTickType ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				taskSNAPSHOT_PRIORITIES( pxTCB );
+
+				/* Only reset the event list item value if the value is not
+				being used for anything else. */
+				if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( portTickType ) configMAX_PRIORITIES - ( portTickType ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				}
 
 				/* If the task is in the blocked or suspended list we need do
 				nothing more than change it's priority variable. However, if
@@ -1007,9 +1799,9 @@ tskTCB * pxNewTCB;
 					if( uxListRemove( &( pxTCB->xGenericListItem ) ) == ( unsigned portBASE_TYPE ) 0 )
 					{
 						/* It is known that the task is in its ready list so
-						there is no need to check again and the port level
-						reset macro can be called directly. */
-						portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
+						there is no need to check again and the ready priority
+						can be cleared directly. */
+						taskCLEAR_READY_PRIORITY( uxPriorityUsedOnEntry );
 					}
 					prvAddTaskToReadyList( pxTCB );
 				}
@@ -1228,7 +2020,27 @@ void vTaskStartScheduler( void )
 portBASE_TYPE xReturn;
 
 	/* Add the idle task at the lowest priority. */
-	#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+	xStaticTaskType *pxIdleTaskTCBBuffer = NULL;
+	portSTACK_TYPE *pxIdleTaskStackBuffer = NULL;
+	unsigned short usIdleTaskStackSize = tskIDLE_STACK_SIZE;
+
+		/* The memory used by the idle task is provided by the application, so
+		the scheduler can be started without using the heap. */
+		vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &usIdleTaskStackSize );
+
+		#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+		{
+			xReturn = xTaskCreateStatic( prvIdleTask, ( signed char * ) "IDLE", usIdleTaskStackSize, ( void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), &xIdleTaskHandle, pxIdleTaskStackBuffer, pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+		}
+		#else
+		{
+			xReturn = xTaskCreateStatic( prvIdleTask, ( signed char * ) "IDLE", usIdleTaskStackSize, ( void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), NULL, pxIdleTaskStackBuffer, pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+		}
+		#endif /* INCLUDE_xTaskGetIdleTaskHandle */
+	}
+	#elif ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
 	{
 		/* Create the idle task, storing its handle in xIdleTaskHandle so it can
 		be returned by the xTaskGetIdleTaskHandle() function. */
@@ -1239,7 +2051,7 @@ portBASE_TYPE xReturn;
 		/* Create the idle task without storing its handle. */
 		xReturn = xTaskCreate( prvIdleTask, ( signed char * ) "IDLE", tskIDLE_STACK_SIZE, ( void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), NULL );  /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
 	}
-	#endif /* INCLUDE_xTaskGetIdleTaskHandle */
+	#endif /* configSUPPORT_STATIC_ALLOCATION */
 
 	#if ( configUSE_TIMERS == 1 )
 	{
@@ -1250,6 +2062,15 @@ portBASE_TYPE xReturn;
 	}
 	#endif /* configUSE_TIMERS */
 
+	#if ( configUSE_DEFERRED_CALLS == 1 )
+	{
+		if( xReturn == pdPASS )
+		{
+			xReturn = xDeferredCallCreateWorkers();
+		}
+	}
+	#endif /* configUSE_DEFERRED_CALLS */
+
 	if( xReturn == pdPASS )
 	{
 		/* Interrupts are turned off here, to ensure a tick does not occur
@@ -1265,6 +2086,18 @@ portBASE_TYPE xReturn;
 		xSchedulerRunning = pdTRUE;
 		xTickCount = ( portTickType ) 0U;
 
+		#if ( configUSE_EDF_SCHEDULING == 1 )
+		{
+			/* pxCurrentTCB is the last task created at the highest priority,
+			which at configEDF_PRIORITY need not be the task with the earliest
+			deadline. */
+			if( pxCurrentTCB->uxPriority == configEDF_PRIORITY )
+			{
+				taskSELECT_FROM_READY_LIST( configEDF_PRIORITY );
+			}
+		}
+		#endif /* configUSE_EDF_SCHEDULING */
+
 		/* If configGENERATE_RUN_TIME_STATS is defined then the following
 		macro must be defined to configure the timer/counter used to generate
 		the run time counter time base. */
@@ -1330,6 +2163,14 @@ void vTaskSuspendAll( void )
 		}
 		else
 		{
+			#if ( configUSE_TIMING_WHEEL == 1 )
+			{
+				/* xNextTaskUnblockTime is not maintained by the tick when the
+				timing wheel is used, so calculate it now. */
+				xNextTaskUnblockTime = prvTimingWheelNextUnblockTime();
+			}
+			#endif
+
 			xReturn = xNextTaskUnblockTime - xTickCount;
 		}
 
@@ -1478,7 +2319,7 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 
 #if ( configUSE_TRACE_FACILITY == 1 )
 
-	unsigned portBASE_TYPE uxTaskGetSystemState( xTaskStatusType *pxTaskStatusArray, unsigned portBASE_TYPE uxArraySize, unsigned long *pulTotalRunTime )
+	unsigned portBASE_TYPE uxTaskGetSystemState( xTaskStatusType *pxTaskStatusArray, unsigned portBASE_TYPE uxArraySize, configRUN_TIME_COUNTER_TYPE *pulTotalRunTime )
 	{
 	unsigned portBASE_TYPE uxTask = 0, uxQueue = configMAX_PRIORITIES;
 
@@ -1501,6 +2342,20 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 				uxTask += prvListTaskWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( xList * ) pxDelayedTaskList, eBlocked );
 				uxTask += prvListTaskWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( xList * ) pxOverflowDelayedTaskList, eBlocked );
 
+				#if ( configUSE_TIMING_WHEEL == 1 )
+				{
+				unsigned portBASE_TYPE uxLevel, uxSlot;
+
+					for( uxLevel = 0U; uxLevel < ( unsigned portBASE_TYPE ) tskTIMING_WHEEL_LEVELS; uxLevel++ )
+					{
+						for( uxSlot = 0U; uxSlot < ( unsigned portBASE_TYPE ) configTIMING_WHEEL_SIZE; uxSlot++ )
+						{
+							uxTask += prvListTaskWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xTimingWheel[ uxLevel ][ uxSlot ] ), eBlocked );
+						}
+					}
+				}
+				#endif /* configUSE_TIMING_WHEEL */
+
 				#if( INCLUDE_vTaskDelete == 1 )
 				{
 					/* Fill in an xTaskStatusType structure with information on
@@ -1521,7 +2376,7 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 				{
 					if( pulTotalRunTime != NULL )
 					{
-						*pulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+						*pulTotalRunTime = prvGetTotalRunTime();
 					}
 				}
 				#else
@@ -1542,6 +2397,52 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 #endif /* configUSE_TRACE_FACILITY */
 /*----------------------------------------------------------*/
 
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+
+	unsigned portBASE_TYPE uxTaskGetSnapshot( xTaskSnapshotType *pxSnapshotArray, unsigned portBASE_TYPE uxArraySize, configRUN_TIME_COUNTER_TYPE *pulTotalRunTime )
+	{
+	unsigned portBASE_TYPE uxSlot, uxTask = 0;
+
+		for( uxSlot = 0; ( uxSlot < ( unsigned portBASE_TYPE ) configTASK_SNAPSHOT_SLOTS ) && ( uxTask < uxArraySize ); uxSlot++ )
+		{
+			prvSnapshotCopySlot( &( xSnapshotSlots[ uxSlot ] ), &( pxSnapshotArray[ uxTask ] ) );
+
+			/* Was the entry in use? */
+			if( pxSnapshotArray[ uxTask ].xHandle != NULL )
+			{
+				#if ( configGENERATE_RUN_TIME_STATS == 1 )
+				{
+					/* The running task's current run has not ended yet. */
+					if( pxSnapshotArray[ uxTask ].xHandle == ( xTaskHandle ) pxCurrentTCB )
+					{
+						pxSnapshotArray[ uxTask ].ulLongestRunTime = prvGetRunningTaskLongestRunTime( pxSnapshotArray[ uxTask ].ulLongestRunTime );
+					}
+				}
+				#endif /* configGENERATE_RUN_TIME_STATS */
+
+				uxTask++;
+			}
+		}
+
+		if( pulTotalRunTime != NULL )
+		{
+			#if ( configGENERATE_RUN_TIME_STATS == 1 )
+			{
+				*pulTotalRunTime = prvGetTotalRunTime();
+			}
+			#else
+			{
+				*pulTotalRunTime = 0;
+			}
+			#endif
+		}
+
+		return uxTask;
+	}
+
+#endif /* configUSE_TASK_SNAPSHOT */
+/*----------------------------------------------------------*/
+
 #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
 
 	xTaskHandle xTaskGetIdleTaskHandle( void )
@@ -1567,7 +2468,69 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 		was suppressed.  Note this does *not* call the tick hook function for
 		each stepped tick. */
 		configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
-		xTickCount += xTicksToJump;
+
+		#if ( configUSE_TIMING_WHEEL == 1 )
+		{
+		tskTCB *pxTCB;
+		xList *pxSlot;
+		portTickType xTicksToBoundary, xTicksRemaining = xTicksToJump;
+
+			/* The cascades the tick would have performed during the jump
+			must still be performed, as the tasks they move fall due after the
+			jump. */
+			while( xTicksRemaining > ( portTickType ) 0U )
+			{
+				xTicksToBoundary = ( portTickType ) configTIMING_WHEEL_SIZE - ( xTickCount & tskTIMING_WHEEL_MASK );
+
+				if( xTicksRemaining < xTicksToBoundary )
+				{
+					xTickCount += xTicksRemaining;
+					xTicksRemaining = 0U;
+				}
+				else
+				{
+					xTickCount += xTicksToBoundary;
+					xTicksRemaining -= xTicksToBoundary;
+
+					if( xTickCount == ( portTickType ) 0U )
+					{
+						taskSWITCH_DELAYED_LISTS();
+					}
+
+					prvTimingWheelCascade( xTickCount );
+				}
+			}
+
+			/* The slot for the tick count reached was never visited by the
+			tick.  Tasks held in it are due now, so move them to the next slot
+			to be unblocked by the next tick - which is when they would have
+			been unblocked had the delayed lists been used. */
+			pxSlot = &( xTimingWheel[ 0 ][ xTickCount & tskTIMING_WHEEL_MASK ] );
+			while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+			{
+				pxTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+				( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+				vListInsertEnd( &( xTimingWheel[ 0 ][ ( xTickCount + ( portTickType ) 1U ) & tskTIMING_WHEEL_MASK ] ), &( pxTCB->xGenericListItem ) );
+			}
+		}
+		#else
+		{
+			xTickCount += xTicksToJump;
+		}
+		#endif /* configUSE_TIMING_WHEEL */
+
+		#if ( configUSE_TIMER_HISTOGRAMS == 1 )
+		{
+			ulTickTimestamp = configTIMER_HISTOGRAM_TIMESTAMP();
+		}
+		#endif /* configUSE_TIMER_HISTOGRAMS */
+
+		#if ( configUSE_CPU_LOAD == 1 )
+		{
+			prvCPULoadStep( xTicksToJump );
+		}
+		#endif /* configUSE_CPU_LOAD */
+
 		traceINCREASE_TICK_COUNT( xTicksToJump );
 	}
 
@@ -1577,19 +2540,38 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 portBASE_TYPE xTaskIncrementTick( void )
 {
 tskTCB * pxTCB;
-portTickType xItemValue;
 portBASE_TYPE xSwitchRequired = pdFALSE;
+#if ( configUSE_TIMING_WHEEL == 0 )
+	portTickType xItemValue;
+#endif
 
 	/* Called by the portable layer each time a tick interrupt occurs.
 	Increments the tick then checks to see if the new tick value will cause any
 	tasks to be unblocked. */
 	traceTASK_INCREMENT_TICK( xTickCount );
+
+	/* Check the stack of the running task, if the stack is checked on the tick
+	rather than on each context switch. */
+	taskTICK_CHECK_FOR_STACK_OVERFLOW();
+
 	if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
 	{
 		/* Increment the RTOS tick, switching the delayed and overflowed
 		delayed lists if it wraps to 0. */
 		++xTickCount;
 
+		#if ( configUSE_TIMER_HISTOGRAMS == 1 )
+		{
+			ulTickTimestamp = configTIMER_HISTOGRAM_TIMESTAMP();
+		}
+		#endif /* configUSE_TIMER_HISTOGRAMS */
+
+		#if ( configUSE_CPU_LOAD == 1 )
+		{
+			prvCPULoadStep( ( portTickType ) 1U );
+		}
+		#endif /* configUSE_CPU_LOAD */
+
 		{
 			/* Minor optimisation.  The tick count cannot change in this
 			block. */
@@ -1600,6 +2582,49 @@ portBASE_TYPE xSwitchRequired = pdFALSE;
 				taskSWITCH_DELAYED_LISTS();
 			}
 
+			#if ( configUSE_TIMING_WHEEL == 1 )
+			{
+			xList * const pxSlot = &( xTimingWheel[ 0 ][ xConstTickCount & tskTIMING_WHEEL_MASK ] );
+
+				if( ( xConstTickCount & tskTIMING_WHEEL_MASK ) == ( portTickType ) 0U )
+				{
+					prvTimingWheelCascade( xConstTickCount );
+				}
+
+				/* Every task in the slot for this tick is due now, so wake times
+				need not be inspected and the cost depends only on the number of
+				tasks being unblocked. */
+				while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+				{
+					pxTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+					( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+
+					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+					{
+						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+					}
+
+					prvAddTaskToReadyList( pxTCB );
+
+					#if (  configUSE_PREEMPTION == 1 )
+					{
+						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						{
+							xSwitchRequired = pdTRUE;
+						}
+					}
+					#endif /* configUSE_PREEMPTION */
+				}
+
+				/* xNextTaskUnblockTime is only calculated when the expected idle
+				time is needed.  Make sure it never falls behind the tick count. */
+				if( xConstTickCount >= xNextTaskUnblockTime )
+				{
+					xNextTaskUnblockTime = portMAX_DELAY;
+				}
+			}
+			#else /* configUSE_TIMING_WHEEL */
+
 			/* See if this tick has made a timeout expire.  Tasks are stored in the
 			queue in the order of their wake time - meaning once one tasks has been
 			found whose block time has not expired there is no need not look any
@@ -1667,6 +2692,8 @@ portBASE_TYPE xSwitchRequired = pdFALSE;
 					}
 				}
 			}
+
+			#endif /* configUSE_TIMING_WHEEL */
 		}
 
 		/* Tasks of equal priority to the currently running task will share
@@ -1806,28 +2833,17 @@ void vTaskSwitchContext( void )
 	}
 	else
 	{
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+			tskTCB * const pxPreviousTCB = pxCurrentTCB;
+		#endif
+
 		traceTASK_SWITCHED_OUT();
 
 		#if ( configGENERATE_RUN_TIME_STATS == 1 )
 		{
-				#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-					portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
-				#else
-					ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-				#endif
-
-				/* Add the amount of time the task has been running to the
-				accumulated	time so far.  The time the task started running was
-				stored in ulTaskSwitchedInTime.  Note that there is no overflow
-				protection here	so count values are only valid until the timer
-				overflows.  The guard against negative values is to protect
-				against suspect run time stat counter implementations - which
-				are provided by the application, not the kernel. */
-				if( ulTotalRunTime > ulTaskSwitchedInTime )
-				{
-					pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
-				}
-				ulTaskSwitchedInTime = ulTotalRunTime;
+			/* Add the amount of time the task has been running to the
+			accumulated time so far. */
+			prvAccountRunTime();
 		}
 		#endif /* configGENERATE_RUN_TIME_STATS */
 
@@ -1836,6 +2852,23 @@ void vTaskSwitchContext( void )
 
 		taskSELECT_HIGHEST_PRIORITY_TASK();
 
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			/* If a different task was selected the task that was running
+			has stopped running, so its continuous run time is known. */
+			if( pxCurrentTCB != pxPreviousTCB )
+			{
+				if( ( ulTotalRunTime - ulTaskRunStartTime ) > pxPreviousTCB->ulLongestRunTime )
+				{
+					pxPreviousTCB->ulLongestRunTime = ulTotalRunTime - ulTaskRunStartTime;
+					taskSNAPSHOT_RUN_TIME( pxPreviousTCB );
+				}
+
+				ulTaskRunStartTime = ulTotalRunTime;
+			}
+		}
+		#endif /* configGENERATE_RUN_TIME_STATS */
+
 		traceTASK_SWITCHED_IN();
 
 		#if ( configUSE_NEWLIB_REENTRANT == 1 )
@@ -1869,8 +2902,8 @@ portTickType xTimeToWake;
 	if( uxListRemove( &( pxCurrentTCB->xGenericListItem ) ) == ( unsigned portBASE_TYPE ) 0 )
 	{
 		/* The current task must be in a ready list, so there is no need to
-		check, and the port reset macro can be called directly. */
-		portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+		check, and the ready priority can be cleared directly. */
+		taskCLEAR_READY_PRIORITY( pxCurrentTCB->uxPriority );
 	}
 
 	#if ( INCLUDE_vTaskSuspend == 1 )
@@ -1927,8 +2960,8 @@ portTickType xTimeToWake;
 		if( uxListRemove( &( pxCurrentTCB->xGenericListItem ) ) == ( unsigned portBASE_TYPE ) 0 )
 		{
 			/* The current task must be in a ready list, so there is no need to
-			check, and the port reset macro can be called directly. */
-			portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+			check, and the ready priority can be cleared directly. */
+			taskCLEAR_READY_PRIORITY( pxCurrentTCB->uxPriority );
 		}
 
 		/* Calculate the time at which the task should be woken if the event does
@@ -1993,35 +3026,151 @@ portBASE_TYPE xReturn;
 }
 /*-----------------------------------------------------------*/
 
-void vTaskSetTimeOutState( xTimeOutType * const pxTimeOut )
-{
-	configASSERT( pxTimeOut );
-	pxTimeOut->xOverflowCount = xNumOfOverflows;
-	pxTimeOut->xTimeOnEntering = xTickCount;
-}
-/*-----------------------------------------------------------*/
-
-portBASE_TYPE xTaskCheckForTimeOut( xTimeOutType * const pxTimeOut, portTickType * const pxTicksToWait )
+void vTaskPlaceOnUnorderedEventList( xList * pxEventList, portTickType xItemValue, portTickType xTicksToWait )
 {
-portBASE_TYPE xReturn;
+portTickType xTimeToWake;
 
-	configASSERT( pxTimeOut );
-	configASSERT( pxTicksToWait );
+	configASSERT( pxEventList );
 
-	taskENTER_CRITICAL();
+	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+	the event groups implementation. */
+	configASSERT( uxSchedulerSuspended != ( unsigned portBASE_TYPE ) pdFALSE );
+
+	/* Store the item value in the event list item.  It is safe to access the
+	event list item here as interrupts won't access the event list item of a
+	task that is not in the Blocked state. */
+	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+	/* Place the event list item of the TCB at the end of the appropriate event
+	list.  It is safe to access the event list here because it is part of an
+	event group implementation - and interrupts don't access event groups
+	directly (instead they access them indirectly by pending function calls to
+	the task level). */
+	vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+	/* The task must be removed from the ready list before it is added to the
+	blocked list.  Exclusive access can be assured to the ready list as the
+	scheduler is locked. */
+	if( uxListRemove( &( pxCurrentTCB->xGenericListItem ) ) == ( unsigned portBASE_TYPE ) 0 )
 	{
-		/* Minor optimisation.  The tick count cannot change in this block. */
-		const portTickType xConstTickCount = xTickCount;
+		/* The current task must be in a ready list, so there is no need to
+		check, and the ready priority can be cleared directly. */
+		taskCLEAR_READY_PRIORITY( pxCurrentTCB->uxPriority );
+	}
 
-		#if ( INCLUDE_vTaskSuspend == 1 )
-			/* If INCLUDE_vTaskSuspend is set to 1 and the block time specified is
-			the maximum block time then the task should block indefinitely, and
-			therefore never time out. */
-			if( *pxTicksToWait == portMAX_DELAY )
-			{
-				xReturn = pdFALSE;
-			}
-			else /* We are not blocking indefinitely, perform the checks below. */
+	#if ( INCLUDE_vTaskSuspend == 1 )
+	{
+		if( xTicksToWait == portMAX_DELAY )
+		{
+			/* Add the task to the suspended task list instead of a delayed task
+			list to ensure it is not woken by a timing event.  It will block
+			indefinitely. */
+			vListInsertEnd( &xSuspendedTaskList, &( pxCurrentTCB->xGenericListItem ) );
+		}
+		else
+		{
+			/* Calculate the time at which the task should be woken if the event
+			does not occur.  This may overflow but this doesn't matter. */
+			xTimeToWake = xTickCount + xTicksToWait;
+			prvAddCurrentTaskToDelayedList( xTimeToWake );
+		}
+	}
+	#else /* INCLUDE_vTaskSuspend */
+	{
+			/* Calculate the time at which the task should be woken if the event does
+			not occur.  This may overflow but this doesn't matter. */
+			xTimeToWake = xTickCount + xTicksToWait;
+			prvAddCurrentTaskToDelayedList( xTimeToWake );
+	}
+	#endif /* INCLUDE_vTaskSuspend */
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xTaskRemoveFromUnorderedEventList( xListItem * pxEventListItem, portTickType xItemValue )
+{
+tskTCB *pxUnblockedTCB;
+signed portBASE_TYPE xReturn;
+
+	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+	the event groups implementation. */
+	configASSERT( uxSchedulerSuspended != ( unsigned portBASE_TYPE ) pdFALSE );
+
+	/* Store the new item value in the event list. */
+	listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+	/* Remove the task from the list of tasks waiting on the event group.
+	Interrupts do not access event groups. */
+	pxUnblockedTCB = ( tskTCB * ) listGET_LIST_ITEM_OWNER( pxEventListItem );
+	configASSERT( pxUnblockedTCB );
+	( void ) uxListRemove( pxEventListItem );
+
+	/* Remove the task from the delayed list and add it to the ready list.  The
+	scheduler is suspended so interrupts will not be accessing the ready
+	lists. */
+	( void ) uxListRemove( &( pxUnblockedTCB->xGenericListItem ) );
+	prvAddTaskToReadyList( pxUnblockedTCB );
+
+	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	{
+		/* Return true if the task removed from the event list has
+		a higher priority than the calling task.  The task was added
+		straight to the ready list, so xTaskResumeAll() would not otherwise
+		know to switch to it when the scheduler is resumed. */
+		xReturn = pdTRUE;
+		xYieldPending = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portTickType uxTaskResetEventItemValue( void )
+{
+portTickType uxReturn;
+
+	uxReturn = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) );
+
+	/* Reset the event list item to its normal value - so it can be used with
+	queues and semaphores. */
+	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( portTickType ) configMAX_PRIORITIES - ( portTickType ) pxCurrentTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskSetTimeOutState( xTimeOutType * const pxTimeOut )
+{
+	configASSERT( pxTimeOut );
+	pxTimeOut->xOverflowCount = xNumOfOverflows;
+	pxTimeOut->xTimeOnEntering = xTickCount;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xTaskCheckForTimeOut( xTimeOutType * const pxTimeOut, portTickType * const pxTicksToWait )
+{
+portBASE_TYPE xReturn;
+
+	configASSERT( pxTimeOut );
+	configASSERT( pxTicksToWait );
+
+	taskENTER_CRITICAL();
+	{
+		/* Minor optimisation.  The tick count cannot change in this block. */
+		const portTickType xConstTickCount = xTickCount;
+
+		#if ( INCLUDE_vTaskSuspend == 1 )
+			/* If INCLUDE_vTaskSuspend is set to 1 and the block time specified is
+			the maximum block time then the task should block indefinitely, and
+			therefore never time out. */
+			if( *pxTicksToWait == portMAX_DELAY )
+			{
+				xReturn = pdFALSE;
+			}
+			else /* We are not blocking indefinitely, perform the checks below. */
 		#endif
 
 		if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
@@ -2115,6 +3264,22 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 		/* See if any tasks have been deleted. */
 		prvCheckTasksWaitingTermination();
 
+		#if ( ( configCHECK_FOR_STACK_OVERFLOW > 2 ) && ( configSTACK_GUARD_SCAN_PERIOD > 0 ) )
+		{
+			/* See if any task has written to the guard words at the end of
+			its stack. */
+			prvCheckTaskStacks();
+		}
+		#endif /* configCHECK_FOR_STACK_OVERFLOW */
+
+		#if ( ( configUSE_TASK_SNAPSHOT == 1 ) && ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) )
+		{
+			/* Refresh the stack high water mark of the next task in the
+			snapshot table. */
+			prvSnapshotMeasureStack();
+		}
+		#endif
+
 		#if ( configUSE_PREEMPTION == 0 )
 		{
 			/* If we are not using preemption we keep forcing a task switch to
@@ -2236,6 +3401,22 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 #endif /* configUSE_TICKLESS_IDLE */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMER_HISTOGRAMS == 1 )
+
+	void vTaskGetTickTimestamp( portTickType *pxTickCount, unsigned long *pulTimestamp )
+	{
+		/* The tick interrupt writes both, so read them with it masked. */
+		taskENTER_CRITICAL();
+		{
+			*pxTickCount = xTickCount;
+			*pulTimestamp = ulTickTimestamp;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TIMER_HISTOGRAMS */
+/*-----------------------------------------------------------*/
+
 static void prvInitialiseTCBVariables( tskTCB *pxTCB, const signed char * const pcName, unsigned portBASE_TYPE uxPriority, const xMemoryRegion * const xRegions, unsigned short usStackDepth )
 {
 unsigned portBASE_TYPE x;
@@ -2272,6 +3453,12 @@ unsigned portBASE_TYPE x;
 	}
 	#endif /* configUSE_MUTEXES */
 
+	#if ( configUSE_CEILING_MUTEXES == 1 )
+	{
+		pxTCB->uxCeilingPriority = tskIDLE_PRIORITY;
+	}
+	#endif /* configUSE_CEILING_MUTEXES */
+
 	vListInitialiseItem( &( pxTCB->xGenericListItem ) );
 	vListInitialiseItem( &( pxTCB->xEventListItem ) );
 
@@ -2297,10 +3484,41 @@ unsigned portBASE_TYPE x;
 
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
 	{
-		pxTCB->ulRunTimeCounter = 0UL;
+		pxTCB->ulRunTimeCounter = 0;
+		pxTCB->ulLongestRunTime = 0UL;
 	}
 	#endif /* configGENERATE_RUN_TIME_STATS */
 
+	#if ( configUSE_CPU_LOAD == 1 )
+	{
+		( void ) memset( ( void * ) &( pxTCB->xCPULoad ), 0x00, sizeof( pxTCB->xCPULoad ) );
+		pxTCB->xCPULoad.ulPeriod = ulCPULoadPeriod;
+	}
+	#endif /* configUSE_CPU_LOAD */
+
+	#if ( configUSE_TASK_SNAPSHOT == 1 )
+	{
+		pxTCB->pxSnapshotSlot = NULL;
+	}
+	#endif /* configUSE_TASK_SNAPSHOT */
+
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+	{
+		pxTCB->ulNotifiedValue = 0UL;
+		pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+	}
+	#endif /* configUSE_TASK_NOTIFICATIONS */
+
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+	{
+		pxTCB->xPeriod = ( portTickType ) 0U;
+		pxTCB->xRelativeDeadline = ( portTickType ) 0U;
+		pxTCB->xReleaseTime = ( portTickType ) 0U;
+		pxTCB->xAbsoluteDeadline = ( portTickType ) 0U;
+		pxTCB->uxDeadlineMisses = ( unsigned portBASE_TYPE ) 0U;
+	}
+	#endif /* configUSE_EDF_SCHEDULING */
+
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 	{
 		vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, pxTCB->pxStack, usStackDepth );
@@ -2349,12 +3567,38 @@ unsigned portBASE_TYPE uxPriority;
 	vListInitialise( &xDelayedTaskList2 );
 	vListInitialise( &xPendingReadyList );
 
+	#if ( configUSE_TIMING_WHEEL == 1 )
+	{
+	unsigned portBASE_TYPE uxLevel, uxSlot;
+
+		for( uxLevel = 0U; uxLevel < ( unsigned portBASE_TYPE ) tskTIMING_WHEEL_LEVELS; uxLevel++ )
+		{
+			for( uxSlot = 0U; uxSlot < ( unsigned portBASE_TYPE ) configTIMING_WHEEL_SIZE; uxSlot++ )
+			{
+				vListInitialise( &( xTimingWheel[ uxLevel ][ uxSlot ] ) );
+			}
+		}
+	}
+	#endif /* configUSE_TIMING_WHEEL */
+
 	#if ( INCLUDE_vTaskDelete == 1 )
 	{
 		vListInitialise( &xTasksWaitingTermination );
 	}
 	#endif /* INCLUDE_vTaskDelete */
 
+	#if ( configUSE_TASK_POOL == 1 )
+	{
+	unsigned portBASE_TYPE uxBucket;
+
+		for( uxBucket = 0U; uxBucket < ( unsigned portBASE_TYPE ) configTASK_POOL_DEPTHS; uxBucket++ )
+		{
+			xTaskPool[ uxBucket ].usStackDepth = 0U;
+			vListInitialise( &( xTaskPool[ uxBucket ].xTCBs ) );
+		}
+	}
+	#endif /* configUSE_TASK_POOL */
+
 	#if ( INCLUDE_vTaskSuspend == 1 )
 	{
 		vListInitialise( &xSuspendedTaskList );
@@ -2372,30 +3616,37 @@ static void prvCheckTasksWaitingTermination( void )
 {
 	#if ( INCLUDE_vTaskDelete == 1 )
 	{
-		portBASE_TYPE xListIsEmpty;
+	tskTCB *pxTCBs[ configIDLE_RECLAIM_BATCH ];
+	unsigned portBASE_TYPE uxTCBs, uxTCB;
 
-		/* ucTasksDeleted is used to prevent vTaskSuspendAll() being called
-		too often in the idle task. */
+		/* uxTasksDeleted is used to prevent a critical section being entered
+		too often in the idle task.  It is only changed in a critical section,
+		together with xTasksWaitingTermination, so the list is not empty while
+		it is non-zero. */
 		while( uxTasksDeleted > ( unsigned portBASE_TYPE ) 0U )
 		{
-			vTaskSuspendAll();
-				xListIsEmpty = listLIST_IS_EMPTY( &xTasksWaitingTermination );
-			( void ) xTaskResumeAll();
+			/* Take a batch of tasks from the list in one critical section,
+			rather than entering one for each task.  The batch is limited so
+			the time spent with interrupts masked is bounded however many tasks
+			were deleted. */
+			uxTCBs = 0U;
 
-			if( xListIsEmpty == pdFALSE )
+			taskENTER_CRITICAL();
 			{
-				tskTCB *pxTCB;
-
-				taskENTER_CRITICAL();
+				while( ( uxTCBs < ( unsigned portBASE_TYPE ) configIDLE_RECLAIM_BATCH ) && ( uxTasksDeleted > ( unsigned portBASE_TYPE ) 0U ) )
 				{
-					pxTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) );
-					( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+					pxTCBs[ uxTCBs ] = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) );
+					( void ) uxListRemove( &( pxTCBs[ uxTCBs ]->xGenericListItem ) );
 					--uxCurrentNumberOfTasks;
 					--uxTasksDeleted;
+					uxTCBs++;
 				}
-				taskEXIT_CRITICAL();
+			}
+			taskEXIT_CRITICAL();
 
-				prvDeleteTCB( pxTCB );
+			for( uxTCB = 0U; uxTCB < uxTCBs; uxTCB++ )
+			{
+				prvDeleteTCB( pxTCBs[ uxTCB ] );
 			}
 		}
 	}
@@ -2403,535 +3654,2188 @@ static void prvCheckTasksWaitingTermination( void )
 }
 /*-----------------------------------------------------------*/
 
-static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake )
-{
-	/* The list item will be inserted in wake time order. */
-	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xGenericListItem ), xTimeToWake );
+#if ( ( configCHECK_FOR_STACK_OVERFLOW > 2 ) && ( configSTACK_GUARD_SCAN_PERIOD > 0 ) )
 
-	if( xTimeToWake < xTickCount )
+	static void prvCheckTaskStacks( void )
 	{
-		/* Wake time has overflowed.  Place this item in the overflow list. */
-		vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xGenericListItem ) );
+	static portTickType xLastCheckTime = ( portTickType ) 0U;
+	unsigned portBASE_TYPE uxQueue;
+
+		/* It is not desirable to suspend then resume the scheduler on each
+		iteration of the idle task, so a preliminary test of the tick count is
+		performed without the scheduler suspended.  The result is not
+		necessarily valid. */
+		if( ( portTickType ) ( xTickCount - xLastCheckTime ) >= ( portTickType ) configSTACK_GUARD_SCAN_PERIOD )
+		{
+			vTaskSuspendAll();
+			{
+				/* The tick count cannot change while the scheduler is
+				suspended. */
+				if( ( portTickType ) ( xTickCount - xLastCheckTime ) >= ( portTickType ) configSTACK_GUARD_SCAN_PERIOD )
+				{
+					xLastCheckTime = xTickCount;
+
+					for( uxQueue = ( unsigned portBASE_TYPE ) 0U; uxQueue < ( unsigned portBASE_TYPE ) configMAX_PRIORITIES; uxQueue++ )
+					{
+						prvCheckStacksWithinSingleList( &( pxReadyTasksLists[ uxQueue ] ) );
+					}
+
+					prvCheckStacksWithinSingleList( ( xList * ) pxDelayedTaskList );
+					prvCheckStacksWithinSingleList( ( xList * ) pxOverflowDelayedTaskList );
+
+					#if ( configUSE_TIMING_WHEEL == 1 )
+					{
+					unsigned portBASE_TYPE uxLevel, uxSlot;
+
+						for( uxLevel = 0U; uxLevel < ( unsigned portBASE_TYPE ) tskTIMING_WHEEL_LEVELS; uxLevel++ )
+						{
+							for( uxSlot = 0U; uxSlot < ( unsigned portBASE_TYPE ) configTIMING_WHEEL_SIZE; uxSlot++ )
+							{
+								prvCheckStacksWithinSingleList( &( xTimingWheel[ uxLevel ][ uxSlot ] ) );
+							}
+						}
+					}
+					#endif /* configUSE_TIMING_WHEEL */
+
+					#if ( INCLUDE_vTaskSuspend == 1 )
+					{
+						prvCheckStacksWithinSingleList( &xSuspendedTaskList );
+					}
+					#endif
+
+					/* Tasks in xPendingReadyList are referenced by their event
+					list item, so are also in one of the lists above.  Deleted
+					tasks are not checked. */
+				}
+			}
+			( void ) xTaskResumeAll();
+		}
 	}
-	else
+	/*-----------------------------------------------------------*/
+
+	static void prvCheckStacksWithinSingleList( xList *pxList )
 	{
-		/* The wake time has not overflowed, so we can use the current block list. */
-		vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xGenericListItem ) );
+	const xListItem *pxIterator;
+	const xListItem *pxEnd = listGET_END_MARKER( pxList );
+	tskTCB *pxTCB;
+	portSTACK_TYPE *pxGuard;
+	unsigned portBASE_TYPE uxWord;
 
-		/* If the task entering the blocked state was placed at the head of the
-		list of blocked tasks then xNextTaskUnblockTime needs to be updated
-		too. */
-		if( xTimeToWake < xNextTaskUnblockTime )
+		for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != pxEnd; pxIterator = listGET_NEXT( pxIterator ) )
 		{
-			xNextTaskUnblockTime = xTimeToWake;
+			pxTCB = ( tskTCB * ) listGET_LIST_ITEM_OWNER( pxIterator );
+			pxGuard = taskSTACK_GUARD( pxTCB );
+
+			for( uxWord = ( unsigned portBASE_TYPE ) 0U; uxWord < ( unsigned portBASE_TYPE ) taskSTACK_GUARD_WORDS; uxWord++ )
+			{
+				if( pxGuard[ uxWord ] != taskSTACK_FILL_WORD )
+				{
+					vApplicationStackOverflowHook( ( xTaskHandle ) pxTCB, pxTCB->pcTaskName );
+					break;
+				}
+			}
 		}
 	}
-}
-/*-----------------------------------------------------------*/
 
-static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer )
-{
-tskTCB *pxNewTCB;
+#endif /* configCHECK_FOR_STACK_OVERFLOW */
+/*-----------------------------------------------------------*/
 
-	/* Allocate space for the TCB.  Where the memory comes from depends on
-	the implementation of the port malloc function. */
-	pxNewTCB = ( tskTCB * ) pvPortMalloc( sizeof( tskTCB ) );
+#if ( configUSE_TASK_SNAPSHOT == 1 )
 
-	if( pxNewTCB != NULL )
+	static void prvSnapshotAddTask( tskTCB *pxTCB )
 	{
-		/* Allocate space for the stack used by the task being created.
-		The base of the stack memory stored in the TCB so the task can
-		be deleted later if required. */
-		pxNewTCB->pxStack = ( portSTACK_TYPE * ) pvPortMallocAligned( ( ( ( size_t ) usStackDepth ) * sizeof( portSTACK_TYPE ) ), puxStackBuffer ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+	unsigned portBASE_TYPE uxSlot, x;
+	volatile tskSnapshotSlot *pxSlot;
 
-		if( pxNewTCB->pxStack == NULL )
+		for( uxSlot = 0; uxSlot < ( unsigned portBASE_TYPE ) configTASK_SNAPSHOT_SLOTS; uxSlot++ )
 		{
-			/* Could not allocate the stack.  Delete the allocated TCB. */
-			vPortFree( pxNewTCB );
-			pxNewTCB = NULL;
+			pxSlot = &( xSnapshotSlots[ uxSlot ] );
+
+			if( pxSlot->xSnapshot.xHandle == NULL )
+			{
+				( pxSlot->uxSequence )++;
+				{
+					pxSlot->xSnapshot.xHandle = ( xTaskHandle ) pxTCB;
+
+					for( x = ( unsigned portBASE_TYPE ) 0; x < ( unsigned portBASE_TYPE ) configMAX_TASK_NAME_LEN; x++ )
+					{
+						pxSlot->xSnapshot.pcTaskName[ x ] = pxTCB->pcTaskName[ x ];
+					}
+
+					pxSlot->xSnapshot.uxCurrentPriority = pxTCB->uxPriority;
+					pxSlot->xSnapshot.uxBasePriority = taskBASE_PRIORITY( pxTCB );
+					pxSlot->xSnapshot.ulRunTimeCounter = 0;
+					pxSlot->xSnapshot.ulLongestRunTime = 0UL;
+
+					#if ( configUSE_TRACE_FACILITY == 1 )
+					{
+						pxSlot->xSnapshot.xTaskNumber = pxTCB->uxTCBNumber;
+					}
+					#else
+					{
+						pxSlot->xSnapshot.xTaskNumber = 0U;
+					}
+					#endif
+
+					/* Until the idle task measures the stack, all of it bar
+					the initial context is unused. */
+					#if ( portSTACK_GROWTH > 0 )
+					{
+						pxSlot->xSnapshot.usStackHighWaterMark = ( unsigned short ) ( pxTCB->pxEndOfStack - pxTCB->pxTopOfStack );
+					}
+					#else
+					{
+						pxSlot->xSnapshot.usStackHighWaterMark = ( unsigned short ) ( pxTCB->pxTopOfStack - pxTCB->pxStack );
+					}
+					#endif
+				}
+				( pxSlot->uxSequence )++;
+
+				pxTCB->pxSnapshotSlot = pxSlot;
+				break;
+			}
 		}
-		else
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvSnapshotRemoveTask( tskTCB *pxTCB )
+	{
+	volatile tskSnapshotSlot *pxSlot = pxTCB->pxSnapshotSlot;
+
+		if( pxSlot != NULL )
 		{
-			/* Just to help debugging. */
-			( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) usStackDepth * sizeof( portSTACK_TYPE ) );
+			( pxSlot->uxSequence )++;
+			pxSlot->xSnapshot.xHandle = NULL;
+			( pxSlot->uxSequence )++;
+
+			pxTCB->pxSnapshotSlot = NULL;
 		}
 	}
+	/*-----------------------------------------------------------*/
 
-	return pxNewTCB;
-}
+	static void prvSnapshotCopySlot( volatile tskSnapshotSlot *pxSlot, xTaskSnapshotType *pxSnapshot )
+	{
+	unsigned portBASE_TYPE uxSequence;
+
+		/* Copy the entry until the copy was not overlapped by a write.  A write
+		cannot be interrupted by this task, so on a single core the sequence
+		number is never seen to be odd, but it is checked anyway in case the
+		entry is read from another core or by a debugger. */
+		do
+		{
+			uxSequence = pxSlot->uxSequence;
+			*pxSnapshot = pxSlot->xSnapshot;
+		} while( ( ( uxSequence & ( unsigned portBASE_TYPE ) 1U ) != 0U ) || ( uxSequence != pxSlot->uxSequence ) );
+	}
+
+#endif /* configUSE_TASK_SNAPSHOT */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( ( configUSE_TASK_SNAPSHOT == 1 ) && ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) )
 
-	static unsigned portBASE_TYPE prvListTaskWithinSingleList( xTaskStatusType *pxTaskStatusArray, xList *pxList, eTaskState eState )
+	static void prvSnapshotMeasureStack( void )
 	{
-	volatile tskTCB *pxNextTCB, *pxFirstTCB;
-	unsigned portBASE_TYPE uxTask = 0;
+	static unsigned portBASE_TYPE uxNextSlot = 0U;
+	volatile tskSnapshotSlot *pxSlot = &( xSnapshotSlots[ uxNextSlot ] );
+	tskTCB *pxTCB;
+	unsigned short usHighWaterMark;
 
-		if( listCURRENT_LIST_LENGTH( pxList ) > ( unsigned portBASE_TYPE ) 0 )
+		uxNextSlot++;
+		if( uxNextSlot >= ( unsigned portBASE_TYPE ) configTASK_SNAPSHOT_SLOTS )
 		{
-			listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList );
+			uxNextSlot = 0U;
+		}
 
-			/* Populate an xTaskStatusType structure within the
-			pxTaskStatusArray array for each task that is referenced from
-			pxList.  See the definition of xTaskStatusType in task.h for the
-			meaning of each xTaskStatusType structure member. */
-			do
-			{
-				listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList );
+		pxTCB = ( tskTCB * ) pxSlot->xSnapshot.xHandle;
 
-				pxTaskStatusArray[ uxTask ].xHandle = ( xTaskHandle ) pxNextTCB;
-				pxTaskStatusArray[ uxTask ].pcTaskName = ( const signed char * ) &( pxNextTCB->pcTaskName [ 0 ] );
-				pxTaskStatusArray[ uxTask ].xTaskNumber = pxNextTCB->uxTCBNumber;
-				pxTaskStatusArray[ uxTask ].eCurrentState = eState;
-				pxTaskStatusArray[ uxTask ].uxCurrentPriority = pxNextTCB->uxPriority;
+		if( pxTCB != NULL )
+		{
+			/* The stack is measured outside of a critical section.  Even if
+			the task is deleted meanwhile its stack is not freed, as only the
+			idle task frees the memory of deleted tasks. */
+			#if ( portSTACK_GROWTH > 0 )
+			{
+				usHighWaterMark = prvTaskCheckFreeStackSpace( ( unsigned char * ) pxTCB->pxEndOfStack );
+			}
+			#else
+			{
+				usHighWaterMark = prvTaskCheckFreeStackSpace( ( unsigned char * ) pxTCB->pxStack );
+			}
+			#endif
 
-				#if ( configUSE_MUTEXES == 1 )
-				{
-					pxTaskStatusArray[ uxTask ].uxBasePriority = pxNextTCB->uxBasePriority;
-				}
-				#else
+			taskENTER_CRITICAL();
+			{
+				/* Only write the entry if it still belongs to the task. */
+				if( pxSlot->xSnapshot.xHandle == ( xTaskHandle ) pxTCB )
 				{
-					pxTaskStatusArray[ uxTask ].uxBasePriority = 0;
+					( pxSlot->uxSequence )++;
+					pxSlot->xSnapshot.usStackHighWaterMark = usHighWaterMark;
+					( pxSlot->uxSequence )++;
 				}
-				#endif
+			}
+			taskEXIT_CRITICAL();
+		}
+	}
 
-				#if ( configGENERATE_RUN_TIME_STATS == 1 )
-				{
-					pxTaskStatusArray[ uxTask ].ulRunTimeCounter = pxNextTCB->ulRunTimeCounter;
-				}
-				#else
-				{
-					pxTaskStatusArray[ uxTask ].ulRunTimeCounter = 0;
-				}
-				#endif
+#endif
+/*-----------------------------------------------------------*/
 
-				#if ( portSTACK_GROWTH > 0 )
-				{
-					ppxTaskStatusArray[ uxTask ].usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( unsigned char * ) pxNextTCB->pxEndOfStack );
-				}
-				#else
-				{
-					pxTaskStatusArray[ uxTask ].usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( unsigned char * ) pxNextTCB->pxStack );
-				}
-				#endif
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
 
-				uxTask++;
+	static void prvAccountRunTime( void )
+	{
+	unsigned long ulRunTime;
 
-			} while( pxNextTCB != pxFirstTCB );
+		#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+			portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+		#else
+			ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+		#endif
+
+		/* The subtraction is unsigned, so the time is correct across a wrap of
+		the counter, provided the counter wraps at the width of an unsigned
+		long and is read at least once per wrap.  The run time accumulated
+		from these times is of configRUN_TIME_COUNTER_TYPE, so does not wrap
+		with the counter. */
+		ulRunTime = ulTotalRunTime - ulTaskSwitchedInTime;
+		pxCurrentTCB->ulRunTimeCounter += ulRunTime;
+
+		/* The total is updated before ulTaskSwitchedInTime, see
+		prvGetTotalRunTime(). */
+		xRunTimeTotal += ulRunTime;
+		ulTaskSwitchedInTime = ulTotalRunTime;
+
+		#if ( configUSE_CPU_LOAD == 1 )
+		{
+			prvCPULoadAdvance( &( pxCurrentTCB->xCPULoad ) );
+			pxCurrentTCB->xCPULoad.ulPeriodRunTime += ulRunTime;
+
+			prvCPULoadAdvance( &xCPULoadTotal );
+			xCPULoadTotal.ulPeriodRunTime += ulRunTime;
 		}
+		#endif /* configUSE_CPU_LOAD */
 
-		return uxTask;
+		taskSNAPSHOT_RUN_TIME( pxCurrentTCB );
 	}
+	/*-----------------------------------------------------------*/
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+	static configRUN_TIME_COUNTER_TYPE prvGetTotalRunTime( void )
+	{
+	configRUN_TIME_COUNTER_TYPE xTotal;
+	unsigned long ulSwitchedInTime, ulNow;
+
+		/* prvAccountRunTime() cannot be interrupted by the calling task, and
+		changes ulTaskSwitchedInTime after the total, so if
+		ulTaskSwitchedInTime is the same after the total is read as before, the
+		total was not changed while it was being read. */
+		do
+		{
+			ulSwitchedInTime = ulTaskSwitchedInTime;
+			xTotal = xRunTimeTotal;
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+				portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+			#else
+				ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+			#endif
+		} while( ulSwitchedInTime != ulTaskSwitchedInTime );
 
-	static unsigned short prvTaskCheckFreeStackSpace( const unsigned char * pucStackByte )
+		return xTotal + ( configRUN_TIME_COUNTER_TYPE ) ( ulNow - ulSwitchedInTime );
+	}
+	/*-----------------------------------------------------------*/
+
+	static unsigned long prvGetRunningTaskLongestRunTime( unsigned long ulLongestRunTime )
 	{
-	register unsigned short usCount = 0U;
+	unsigned long ulRunStartTime, ulNow;
 
-		while( *pucStackByte == tskSTACK_FILL_BYTE )
+		/* As prvGetTotalRunTime(), vTaskSwitchContext() cannot be interrupted
+		by the calling task, so if ulTaskRunStartTime is the same after the
+		counter is read as before, no other task ran in between. */
+		do
 		{
-			pucStackByte -= portSTACK_GROWTH;
-			usCount++;
-		}
+			ulRunStartTime = ulTaskRunStartTime;
 
-		usCount /= sizeof( portSTACK_TYPE );
+			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+				portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+			#else
+				ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+			#endif
+		} while( ulRunStartTime != ulTaskRunStartTime );
 
-		return usCount;
+		if( ( ulNow - ulRunStartTime ) > ulLongestRunTime )
+		{
+			ulLongestRunTime = ulNow - ulRunStartTime;
+		}
+
+		return ulLongestRunTime;
 	}
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) */
+#endif /* configGENERATE_RUN_TIME_STATS */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+#if ( configUSE_CPU_LOAD == 1 )
 
-	unsigned portBASE_TYPE uxTaskGetStackHighWaterMark( xTaskHandle xTask )
+	static void prvCPULoadStep( portTickType xTicks )
 	{
-	tskTCB *pxTCB;
-	unsigned char *pcEndOfStack;
-	unsigned portBASE_TYPE uxReturn;
-
-		pxTCB = prvGetTCBFromHandle( xTask );
-
-		#if portSTACK_GROWTH < 0
+		if( xTicks >= xTicksToCPULoadPeriod )
 		{
-			pcEndOfStack = ( unsigned char * ) pxTCB->pxStack;
+			/* The running task's time so far belongs to the period that is
+			ending. */
+			prvAccountRunTime();
+
+			xTicks -= xTicksToCPULoadPeriod;
+			ulCPULoadPeriod += 1UL + ( unsigned long ) ( xTicks / tskCPU_LOAD_PERIOD_TICKS );
+			xTicksToCPULoadPeriod = tskCPU_LOAD_PERIOD_TICKS - ( xTicks % tskCPU_LOAD_PERIOD_TICKS );
 		}
-		#else
+		else
 		{
-			pcEndOfStack = ( unsigned char * ) pxTCB->pxEndOfStack;
+			xTicksToCPULoadPeriod -= xTicks;
 		}
-		#endif
+	}
+	/*-----------------------------------------------------------*/
 
-		uxReturn = ( unsigned portBASE_TYPE ) prvTaskCheckFreeStackSpace( pcEndOfStack );
+	static void prvCPULoadAdvance( tskCPULoad *pxLoad )
+	{
+	static const unsigned long ulDecay[ tskCPU_LOAD_WINDOWS ] = { tskCPU_LOAD_DECAY_1S, tskCPU_LOAD_DECAY_10S, tskCPU_LOAD_DECAY_60S };
+	unsigned long ulPeriods, ulLoad;
+	unsigned portBASE_TYPE uxWindow;
 
-		return uxReturn;
-	}
+		ulPeriods = ulCPULoadPeriod - pxLoad->ulPeriod;
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
-/*-----------------------------------------------------------*/
+		if( ulPeriods != 0UL )
+		{
+			for( uxWindow = 0U; uxWindow < ( unsigned portBASE_TYPE ) tskCPU_LOAD_WINDOWS; uxWindow++ )
+			{
+				/* Fold in the period in which the run time was accumulated,
+				then decay the average for each period since, in which no run
+				time was accumulated. */
+				ulLoad = ( unsigned long ) ( ( ( ( unsigned long long ) pxLoad->ulLoad[ uxWindow ] * ( unsigned long long ) ulDecay[ uxWindow ] ) + ( ( unsigned long long ) pxLoad->ulPeriodRunTime * ( unsigned long long ) ( tskCPU_LOAD_ONE - ulDecay[ uxWindow ] ) ) ) >> tskCPU_LOAD_SHIFT );
+				pxLoad->ulLoad[ uxWindow ] = prvCPULoadDecay( ulLoad, ulDecay[ uxWindow ], ulPeriods - 1UL );
+			}
 
-#if ( INCLUDE_vTaskDelete == 1 )
+			pxLoad->ulPeriod = ulCPULoadPeriod;
+			pxLoad->ulPeriodRunTime = 0UL;
+		}
+	}
+	/*-----------------------------------------------------------*/
 
-	static void prvDeleteTCB( tskTCB *pxTCB )
+	static unsigned long prvCPULoadDecay( unsigned long ulLoad, unsigned long ulFactor, unsigned long ulPeriods )
 	{
-		/* This call is required specifically for the TriCore port.  It must be
-		above the vPortFree() calls.  The call is also used by ports/demos that
-		want to allocate and clean RAM statically. */
-		portCLEAN_UP_TCB( pxTCB );
+		/* Square and multiply, so the time taken grows with the logarithm of
+		the number of periods.  The factor is less than tskCPU_LOAD_ONE, so
+		squaring it does not overflow. */
+		while( ( ulPeriods != 0UL ) && ( ulLoad != 0UL ) )
+		{
+			if( ( ulPeriods & 1UL ) != 0UL )
+			{
+				ulLoad = ( unsigned long ) ( ( ( unsigned long long ) ulLoad * ( unsigned long long ) ulFactor ) >> tskCPU_LOAD_SHIFT );
+			}
 
-		/* Free up the memory allocated by the scheduler for the task.  It is up to
-		the task to free any memory allocated at the application level. */
-		vPortFreeAligned( pxTCB->pxStack );
-		vPortFree( pxTCB );
+			ulFactor = ( ulFactor * ulFactor ) >> tskCPU_LOAD_SHIFT;
+			ulPeriods >>= 1;
+		}
+
+		return ulLoad;
 	}
 
-#endif /* INCLUDE_vTaskDelete */
+#endif /* configUSE_CPU_LOAD */
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake )
+{
+	/* The list item will be inserted in wake time order. */
+	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xGenericListItem ), xTimeToWake );
 
-	xTaskHandle xTaskGetCurrentTaskHandle( void )
+	#if ( configUSE_TIMING_WHEEL == 1 )
+	/* Tasks due within the span of the timing wheel do not need a sorted
+	insert. */
+	if( ( portTickType ) ( xTimeToWake - xTickCount ) < tskTIMING_WHEEL_SPAN )
 	{
-	xTaskHandle xReturn;
-
-		/* A critical section is not required as this is not called from
-		an interrupt and the current TCB will always be the same for any
-		individual execution thread. */
-		xReturn = pxCurrentTCB;
-
-		return xReturn;
+		prvTimingWheelInsert( &( pxCurrentTCB->xGenericListItem ), xTimeToWake, xTickCount );
+	}
+	else
+	#endif /* configUSE_TIMING_WHEEL */
+	if( xTimeToWake < xTickCount )
+	{
+		/* Wake time has overflowed.  Place this item in the overflow list. */
+		vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xGenericListItem ) );
 	}
+	else
+	{
+		/* The wake time has not overflowed, so we can use the current block list. */
+		vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xGenericListItem ) );
 
-#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
+		/* If the task entering the blocked state was placed at the head of the
+		list of blocked tasks then xNextTaskUnblockTime needs to be updated
+		too. */
+		if( xTimeToWake < xNextTaskUnblockTime )
+		{
+			xNextTaskUnblockTime = xTimeToWake;
+		}
+	}
+}
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+#if ( configUSE_TIMING_WHEEL == 1 )
 
-	portBASE_TYPE xTaskGetSchedulerState( void )
+	static void prvTimingWheelInsert( xListItem *pxListItem, portTickType xTimeToWake, portTickType xTimeNow )
 	{
-	portBASE_TYPE xReturn;
+	const portTickType xTicksToWait = xTimeToWake - xTimeNow;
+	xList *pxSlot;
 
-		if( xSchedulerRunning == pdFALSE )
+		if( xTicksToWait < ( portTickType ) configTIMING_WHEEL_SIZE )
 		{
-			xReturn = taskSCHEDULER_NOT_STARTED;
+			if( xTicksToWait == ( portTickType ) 0U )
+			{
+				/* The slot for xTimeNow has already been processed.  Use the
+				next slot, so the task is unblocked by the next tick as it
+				would be by the delayed lists. */
+				xTimeToWake++;
+			}
+
+			pxSlot = &( xTimingWheel[ 0 ][ xTimeToWake & tskTIMING_WHEEL_MASK ] );
 		}
 		else
 		{
-			if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
-			{
-				xReturn = taskSCHEDULER_RUNNING;
-			}
-			else
-			{
-				xReturn = taskSCHEDULER_SUSPENDED;
-			}
+			pxSlot = &( xTimingWheel[ 1 ][ ( xTimeToWake / ( portTickType ) configTIMING_WHEEL_SIZE ) & tskTIMING_WHEEL_MASK ] );
 		}
 
-		return xReturn;
+		/* The slots are not sorted, and are never walked using pxIndex, so
+		this inserts at the end of the slot. */
+		vListInsertEnd( pxSlot, pxListItem );
 	}
+	/*-----------------------------------------------------------*/
 
-#endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_MUTEXES == 1 )
-
-	void vTaskPriorityInherit( xTaskHandle const pxMutexHolder )
+	static void prvTimingWheelCascade( portTickType xTimeNow )
 	{
-	tskTCB * const pxTCB = ( tskTCB * ) pxMutexHolder;
+	tskTCB *pxTCB;
+	xList * const pxSlot = &( xTimingWheel[ 1 ][ ( xTimeNow / ( portTickType ) configTIMING_WHEEL_SIZE ) & tskTIMING_WHEEL_MASK ] );
 
-		/* If the mutex was given back by an interrupt while the queue was
-		locked then the mutex holder might now be NULL. */
-		if( pxMutexHolder != NULL )
+		/* Once per turn of the whole wheel, move the tasks that are now due
+		within its span out of the sorted delayed list.  Tasks in the overflow
+		list are not due until after pxDelayedTaskList has been switched. */
+		if( ( xTimeNow & ( tskTIMING_WHEEL_SPAN - ( portTickType ) 1U ) ) == ( portTickType ) 0U )
 		{
-			if( pxTCB->uxPriority < pxCurrentTCB->uxPriority )
+			while( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
 			{
-				/* Adjust the mutex holder state to account for its new priority. */
-				listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( portTickType ) configMAX_PRIORITIES - ( portTickType ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-
-				/* If the task being modified is in the ready state it will need to
-				be moved into a new list. */
-				if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xGenericListItem ) ) != pdFALSE )
-				{
-					if( uxListRemove( &( pxTCB->xGenericListItem ) ) == ( unsigned portBASE_TYPE ) 0 )
-					{
-						taskRESET_READY_PRIORITY( pxTCB->uxPriority );
-					}
+				pxTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
 
-					/* Inherit the priority before being moved into the new list. */
-					pxTCB->uxPriority = pxCurrentTCB->uxPriority;
-					prvAddTaskToReadyList( pxTCB );
-				}
-				else
+				if( ( portTickType ) ( listGET_LIST_ITEM_VALUE( &( pxTCB->xGenericListItem ) ) - xTimeNow ) >= tskTIMING_WHEEL_SPAN )
 				{
-					/* Just inherit the priority. */
-					pxTCB->uxPriority = pxCurrentTCB->uxPriority;
+					/* The list is sorted, so no later task can be due within
+					the span either. */
+					break;
 				}
 
-				traceTASK_PRIORITY_INHERIT( pxTCB, pxCurrentTCB->uxPriority );
+				( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+				prvTimingWheelInsert( &( pxTCB->xGenericListItem ), listGET_LIST_ITEM_VALUE( &( pxTCB->xGenericListItem ) ), xTimeNow );
 			}
 		}
+
+		/* Every task in the second level slot for the window that is starting
+		is due within the window, so belongs in the first level. */
+		while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+		{
+			pxTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+			( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+			vListInsertEnd( &( xTimingWheel[ 0 ][ listGET_LIST_ITEM_VALUE( &( pxTCB->xGenericListItem ) ) & tskTIMING_WHEEL_MASK ] ), &( pxTCB->xGenericListItem ) );
+		}
 	}
+	/*-----------------------------------------------------------*/
 
-#endif /* configUSE_MUTEXES */
-/*-----------------------------------------------------------*/
+	#if ( configUSE_TICKLESS_IDLE != 0 )
 
-#if ( configUSE_MUTEXES == 1 )
+		static portTickType prvTimingWheelNextUnblockTime( void )
+		{
+		const portTickType xTimeNow = xTickCount;
+		portTickType xTicks, xTicksToWait, xNextTicksToWait = portMAX_DELAY, xReturn;
+		const tskTCB *pxTCB;
 
-	void vTaskPriorityDisinherit( xTaskHandle const pxMutexHolder )
-	{
-	tskTCB * const pxTCB = ( tskTCB * ) pxMutexHolder;
+			/* Tasks in the first level are due exactly at the time of their
+			slot, so the first occupied slot gives the earliest. */
+			for( xTicks = ( portTickType ) 1U; xTicks < ( portTickType ) configTIMING_WHEEL_SIZE; xTicks++ )
+			{
+				if( listLIST_IS_EMPTY( &( xTimingWheel[ 0 ][ ( xTimeNow + xTicks ) & tskTIMING_WHEEL_MASK ] ) ) == pdFALSE )
+				{
+					xNextTicksToWait = xTicks;
+					break;
+				}
+			}
 
-		if( pxMutexHolder != NULL )
-		{
-			if( pxTCB->uxPriority != pxTCB->uxBasePriority )
+			/* Tasks in the second level must be cascaded at the start of their
+			window, which is therefore the latest the tick can be suppressed
+			until. */
+			for( xTicks = ( portTickType ) 1U; xTicks <= ( portTickType ) configTIMING_WHEEL_SIZE; xTicks++ )
 			{
-				/* We must be the running task to be able to give the mutex back.
-				Remove ourselves from the ready list we currently appear in. */
-				if( uxListRemove( &( pxTCB->xGenericListItem ) ) == ( unsigned portBASE_TYPE ) 0 )
+				if( listLIST_IS_EMPTY( &( xTimingWheel[ 1 ][ ( ( xTimeNow / ( portTickType ) configTIMING_WHEEL_SIZE ) + xTicks ) & tskTIMING_WHEEL_MASK ] ) ) == pdFALSE )
 				{
-					taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+					xTicksToWait = ( ( ( xTimeNow / ( portTickType ) configTIMING_WHEEL_SIZE ) + xTicks ) * ( portTickType ) configTIMING_WHEEL_SIZE ) - xTimeNow;
+
+					if( xTicksToWait < xNextTicksToWait )
+					{
+						xNextTicksToWait = xTicksToWait;
+					}
+
+					break;
 				}
+			}
 
-				/* Disinherit the priority before adding the task into the new
-				ready list. */
-				traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
-				pxTCB->uxPriority = pxTCB->uxBasePriority;
-				listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( portTickType ) configMAX_PRIORITIES - ( portTickType ) pxTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-				prvAddTaskToReadyList( pxTCB );
+			/* Tasks beyond the span of the wheel. */
+			if( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
+			{
+				pxTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
+				xTicksToWait = listGET_LIST_ITEM_VALUE( &( pxTCB->xGenericListItem ) ) - xTimeNow;
+
+				if( xTicksToWait < xNextTicksToWait )
+				{
+					xNextTicksToWait = xTicksToWait;
+				}
 			}
+
+			/* As with the delayed lists, never look beyond the tick count
+			overflowing, as the lists are switched by the tick. */
+			if( xNextTicksToWait > ( portMAX_DELAY - xTimeNow ) )
+			{
+				xReturn = portMAX_DELAY;
+			}
+			else
+			{
+				xReturn = xTimeNow + xNextTicksToWait;
+			}
+
+			return xReturn;
 		}
-	}
 
-#endif /* configUSE_MUTEXES */
+	#endif /* configUSE_TICKLESS_IDLE */
+
+#endif /* configUSE_TIMING_WHEEL */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer, tskTCB *pxTCBBuffer )
+{
+tskTCB *pxNewTCB;
 
-	void vTaskEnterCritical( void )
+	if( pxTCBBuffer != NULL )
 	{
-		portDISABLE_INTERRUPTS();
+		/* The TCB and stack were provided by the application, so nothing is
+		allocated. */
+		pxNewTCB = pxTCBBuffer;
+		pxNewTCB->pxStack = puxStackBuffer;
 
-		if( xSchedulerRunning != pdFALSE )
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 		{
-			( pxCurrentTCB->uxCriticalNesting )++;
+			pxNewTCB->ucStaticallyAllocated = pdTRUE;
 		}
+		#endif /* configSUPPORT_STATIC_ALLOCATION */
 	}
+	else
+	{
+		pxNewTCB = NULL;
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
-/*-----------------------------------------------------------*/
-
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
-
-	void vTaskExitCritical( void )
-	{
-		if( xSchedulerRunning != pdFALSE )
+		#if ( configUSE_TASK_POOL == 1 )
 		{
-			if( pxCurrentTCB->uxCriticalNesting > 0U )
+			/* Reuse the TCB and stack of a deleted task that had a stack of
+			the same depth, if the pool holds one. */
+			if( puxStackBuffer == NULL )
 			{
-				( pxCurrentTCB->uxCriticalNesting )--;
+				pxNewTCB = prvTakeFromTaskPool( usStackDepth );
+			}
+		}
+		#endif /* configUSE_TASK_POOL */
 
-				if( pxCurrentTCB->uxCriticalNesting == 0U )
+		if( pxNewTCB == NULL )
+		{
+			pxNewTCB = prvAllocateTCBAndStackFromHeap( usStackDepth, puxStackBuffer );
+
+			#if ( configUSE_TASK_POOL == 1 )
+			{
+				/* The memory the heap needs might be held by the pool for
+				stacks of other depths.  The heaps provided with the kernel
+				flush the pool themselves, but others might not. */
+				if( ( pxNewTCB == NULL ) && ( xTaskFlushTaskPool() != pdFALSE ) )
 				{
-					portENABLE_INTERRUPTS();
+					pxNewTCB = prvAllocateTCBAndStackFromHeap( usStackDepth, puxStackBuffer );
 				}
 			}
+			#endif /* configUSE_TASK_POOL */
+		}
+
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+			if( pxNewTCB != NULL )
+			{
+				pxNewTCB->ucStaticallyAllocated = pdFALSE;
+			}
 		}
+		#endif /* configSUPPORT_STATIC_ALLOCATION */
 	}
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+	#if ( configUSE_TASK_POOL == 1 )
+	{
+		/* Only a stack the kernel allocated can be reused by another task. */
+		if( pxNewTCB != NULL )
+		{
+			if( puxStackBuffer == NULL )
+			{
+				pxNewTCB->usStackDepth = usStackDepth;
+			}
+			else
+			{
+				pxNewTCB->usStackDepth = 0U;
+			}
+		}
+	}
+	#endif /* configUSE_TASK_POOL */
+
+	if( pxNewTCB != NULL )
+	{
+		/* Just to help debugging. */
+		( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) usStackDepth * sizeof( portSTACK_TYPE ) );
+	}
+
+	return pxNewTCB;
+}
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS == 1 ) )
+static tskTCB *prvAllocateTCBAndStackFromHeap( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer )
+{
+tskTCB *pxNewTCB;
 
-	void vTaskList( signed char *pcWriteBuffer )
-	{
-	xTaskStatusType *pxTaskStatusArray;
-	volatile unsigned portBASE_TYPE uxArraySize, x;
-	char cStatus;
+	/* Allocate space for the TCB.  Where the memory comes from depends on
+	the implementation of the port malloc function. */
+	pxNewTCB = ( tskTCB * ) pvPortMalloc( sizeof( tskTCB ) );
 
-		/*
-		 * PLEASE NOTE:
-		 *
-		 * This function is provided for convenience only, and is used by many
-		 * of the demo applications.  Do not consider it to be part of the
-		 * scheduler.
-		 *
-		 * vTaskList() calls uxTaskGetSystemState(), then formats part of the
-		 * uxTaskGetSystemState() output into a human readable table that
-		 * displays task names, states and stack usage.
-		 *
-		 * vTaskList() has a dependency on the sprintf() C library function that
-		 * might bloat the code size, use a lot of stack, and provide different
-		 * results on different platforms.  An alternative, tiny, third party,
-		 * and limited functionality implementation of sprintf() is provided in
-		 * many of the FreeRTOS/Demo sub-directories in a file called
-		 * printf-stdarg.c (note printf-stdarg.c does not provide a full
-		 * snprintf() implementation!).
-		 *
-		 * It is recommended that production systems call uxTaskGetSystemState()
-		 * directly to get access to raw stats data, rather than indirectly
-		 * through a call to vTaskList().
-		 */
+	if( pxNewTCB != NULL )
+	{
+		/* Allocate space for the stack used by the task being created.
+		The base of the stack memory stored in the TCB so the task can
+		be deleted later if required. */
+		pxNewTCB->pxStack = ( portSTACK_TYPE * ) pvPortMallocAligned( ( ( ( size_t ) usStackDepth ) * sizeof( portSTACK_TYPE ) ), puxStackBuffer ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
+		if( pxNewTCB->pxStack == NULL )
+		{
+			/* Could not allocate the stack.  Delete the allocated TCB. */
+			vPortFree( pxNewTCB );
+			pxNewTCB = NULL;
+		}
+	}
 
-		/* Make sure the write buffer does not contain a string. */
-		*pcWriteBuffer = 0x00;
+	return pxNewTCB;
+}
+/*-----------------------------------------------------------*/
 
-		/* Take a snapshot of the number of tasks in case it changes while this
-		function is executing. */
-		uxArraySize = uxCurrentNumberOfTasks;
+#if ( configUSE_TASK_POOL == 1 )
 
-		/* Allocate an array index for each task. */
-		pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( xTaskStatusType ) );
+	static tskTCB *prvTakeFromTaskPool( unsigned short usStackDepth )
+	{
+	tskTCB *pxTCB = NULL;
+	unsigned portBASE_TYPE uxBucket;
 
-		if( pxTaskStatusArray != NULL )
+		taskENTER_CRITICAL();
 		{
-			/* Generate the (binary) data. */
-			uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, NULL );
-
-			/* Create a human readable table from the binary data. */
-			for( x = 0; x < uxArraySize; x++ )
+			for( uxBucket = 0U; uxBucket < ( unsigned portBASE_TYPE ) configTASK_POOL_DEPTHS; uxBucket++ )
 			{
-				switch( pxTaskStatusArray[ x ].eCurrentState )
+				if( xTaskPool[ uxBucket ].usStackDepth == usStackDepth )
 				{
-				case eReady:		cStatus = tskREADY_CHAR;
-									break;
+					if( listLIST_IS_EMPTY( &( xTaskPool[ uxBucket ].xTCBs ) ) == pdFALSE )
+					{
+						pxTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( &( xTaskPool[ uxBucket ].xTCBs ) );
+						( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+					}
 
-				case eBlocked:		cStatus = tskBLOCKED_CHAR;
-									break;
+					/* No other bucket holds this depth. */
+					break;
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
 
-				case eSuspended:	cStatus = tskSUSPENDED_CHAR;
-									break;
+		return pxTCB;
+	}
 
-				case eDeleted:		cStatus = tskDELETED_CHAR;
-									break;
+#endif /* configUSE_TASK_POOL */
+/*-----------------------------------------------------------*/
 
-				default:			/* Should not get here, but it is included
-									to prevent static checking errors. */
-									cStatus = 0x00;
-									break;
+#if ( configUSE_TASK_POOL == 1 )
+
+	static portBASE_TYPE prvReturnToTaskPool( tskTCB *pxTCB )
+	{
+	portBASE_TYPE xReturn = pdFALSE;
+	tskTaskPoolBucket *pxBucket = NULL;
+	unsigned portBASE_TYPE uxBucket;
+
+		if( pxTCB->usStackDepth != 0U )
+		{
+			taskENTER_CRITICAL();
+			{
+				/* Use the bucket that holds this depth, or else the first
+				bucket that is empty. */
+				for( uxBucket = 0U; uxBucket < ( unsigned portBASE_TYPE ) configTASK_POOL_DEPTHS; uxBucket++ )
+				{
+					if( xTaskPool[ uxBucket ].usStackDepth == pxTCB->usStackDepth )
+					{
+						pxBucket = &( xTaskPool[ uxBucket ] );
+						break;
+					}
+					else if( ( pxBucket == NULL ) && ( listLIST_IS_EMPTY( &( xTaskPool[ uxBucket ].xTCBs ) ) != pdFALSE ) )
+					{
+						pxBucket = &( xTaskPool[ uxBucket ] );
+					}
 				}
 
-				sprintf( ( char * ) pcWriteBuffer, ( char * ) "%s\t\t%c\t%u\t%u\t%u\r\n", pxTaskStatusArray[ x ].pcTaskName, cStatus, ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber );
-				pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+				if( pxBucket != NULL )
+				{
+					if( listCURRENT_LIST_LENGTH( &( pxBucket->xTCBs ) ) < ( unsigned portBASE_TYPE ) configTASK_POOL_LENGTH )
+					{
+						pxBucket->usStackDepth = pxTCB->usStackDepth;
+						vListInsertEnd( &( pxBucket->xTCBs ), &( pxTCB->xGenericListItem ) );
+						xReturn = pdTRUE;
+					}
+				}
 			}
-
-			/* Free the array again. */
-			vPortFree( pxTaskStatusArray );
+			taskEXIT_CRITICAL();
 		}
+
+		return xReturn;
 	}
 
-#endif /* configUSE_TRACE_FACILITY */
-/*----------------------------------------------------------*/
+#endif /* configUSE_TASK_POOL */
+/*-----------------------------------------------------------*/
 
-#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS == 1 ) )
+#if ( configUSE_TASK_POOL == 1 )
 
-	void vTaskGetRunTimeStats( signed char *pcWriteBuffer )
+	portBASE_TYPE xTaskFlushTaskPool( void )
 	{
-	xTaskStatusType *pxTaskStatusArray;
-	volatile unsigned portBASE_TYPE uxArraySize, x;
-	unsigned long ulTotalTime, ulStatsAsPercentage;
+	portBASE_TYPE xReturn = pdFALSE;
+	unsigned portBASE_TYPE uxBucket;
+	tskTCB *pxTCB;
 
-		/*
-		 * PLEASE NOTE:
-		 *
-		 * This function is provided for convenience only, and is used by many
-		 * of the demo applications.  Do not consider it to be part of the
-		 * scheduler.
-		 *
-		 * vTaskGetRunTimeStats() calls uxTaskGetSystemState(), then formats part
-		 * of the uxTaskGetSystemState() output into a human readable table that
-		 * displays the amount of time each task has spent in the Running state
-		 * in both absolute and percentage terms.
-		 *
-		 * vTaskGetRunTimeStats() has a dependency on the sprintf() C library
-		 * function that might bloat the code size, use a lot of stack, and
-		 * provide different results on different platforms.  An alternative,
-		 * tiny, third party, and limited functionality implementation of
-		 * sprintf() is provided in many of the FreeRTOS/Demo sub-directories in
-		 * a file called printf-stdarg.c (note printf-stdarg.c does not provide
-		 * a full snprintf() implementation!).
-		 *
-		 * It is recommended that production systems call uxTaskGetSystemState()
-		 * directly to get access to raw stats data, rather than indirectly
-		 * through a call to vTaskGetRunTimeStats().
-		 */
+		for( uxBucket = 0U; uxBucket < ( unsigned portBASE_TYPE ) configTASK_POOL_DEPTHS; uxBucket++ )
+		{
+			do
+			{
+				pxTCB = prvTakeFromTaskPool( xTaskPool[ uxBucket ].usStackDepth );
 
-		/* Make sure the write buffer does not contain a string. */
-		*pcWriteBuffer = 0x00;
+				if( pxTCB != NULL )
+				{
+					vPortFreeAligned( pxTCB->pxStack );
+					vPortFree( pxTCB );
+					xReturn = pdTRUE;
+				}
+			} while( pxTCB != NULL );
+		}
 
-		/* Take a snapshot of the number of tasks in case it changes while this
-		function is executing. */
-		uxArraySize = uxCurrentNumberOfTasks;
+		return xReturn;
+	}
 
-		/* Allocate an array index for each task. */
-		pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( xTaskStatusType ) );
+#endif /* configUSE_TASK_POOL */
+/*-----------------------------------------------------------*/
 
-		if( pxTaskStatusArray != NULL )
-		{
-			/* Generate the (binary) data. */
-			uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, &ulTotalTime );
+#if ( configUSE_EDF_SCHEDULING == 1 )
 
-			/* For percentage calculations. */
-			ulTotalTime /= 100UL;
+	static void prvAddTaskToDeadlineReadyList( tskTCB *pxTCB )
+	{
+	xList * const pxList = &( pxReadyTasksLists[ configEDF_PRIORITY ] );
+	xListItem * const pxNewListItem = &( pxTCB->xGenericListItem );
+	xListItem *pxIterator;
+	tskTCB *pxOtherTCB;
 
-			/* Avoid divide by zero errors. */
-			if( ulTotalTime > 0 )
-			{
-				/* Create a human readable table from the binary data. */
-				for( x = 0; x < uxArraySize; x++ )
-				{
-					/* What percentage of the total run time has the task used?
-					This will always be rounded down to the nearest integer.
-					ulTotalRunTimeDiv100 has already been divided by 100. */
-					ulStatsAsPercentage = pxTaskStatusArray[ x ].ulRunTimeCounter / ulTotalTime;
+		/* The end marker is used as the position to insert before when the
+		new item is to go at the end of the list. */
+		pxIterator = ( xListItem * ) listGET_END_MARKER( pxList ); /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
 
-					if( ulStatsAsPercentage > 0UL )
-					{
-						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
-						{
-							sprintf( ( char * ) pcWriteBuffer, ( char * ) "%s\t\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].pcTaskName, pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
-						}
-						#else
-						{
-							/* sizeof( int ) == sizeof( long ) so a smaller
-							printf() library can be used. */
-							sprintf( ( char * ) pcWriteBuffer, ( char * ) "%s\t\t%u\t\t%u%%\r\n", pxTaskStatusArray[ x ].pcTaskName, ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned int ) ulStatsAsPercentage );
-						}
-						#endif
-					}
-					else
-					{
-						/* If the percentage is zero here then the task has
-						consumed less than 1% of the total run time. */
-						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
-						{
-							sprintf( ( char * ) pcWriteBuffer, ( char * ) "%s\t\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].pcTaskName, pxTaskStatusArray[ x ].ulRunTimeCounter );
-						}
-						#else
-						{
-							/* sizeof( int ) == sizeof( long ) so a smaller
-							printf() library can be used. */
-							sprintf( ( char * ) pcWriteBuffer, ( char * ) "%s\t\t%u\t\t<1%%\r\n", pxTaskStatusArray[ x ].pcTaskName, ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter );
-						}
-						#endif
-					}
+		if( pxTCB->xPeriod != ( portTickType ) 0U )
+		{
+			/* The item value is not used to order the list, as deadlines must
+			be compared allowing for overflow, but holding the deadline in it
+			helps debugging. */
+			listSET_LIST_ITEM_VALUE( pxNewListItem, pxTCB->xAbsoluteDeadline );
+
+			/* Find the first task that either has a later deadline, or has no
+			deadline.  Tasks with the same deadline run in the order in which
+			they became ready. */
+			for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != listGET_END_MARKER( pxList ); pxIterator = listGET_NEXT( pxIterator ) ) /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+			{
+				pxOtherTCB = ( tskTCB * ) listGET_LIST_ITEM_OWNER( pxIterator );
 
-					pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+				if( ( pxOtherTCB->xPeriod == ( portTickType ) 0U ) || ( taskTIME_IS_BEFORE( pxTCB->xAbsoluteDeadline, pxOtherTCB->xAbsoluteDeadline ) != pdFALSE ) )
+				{
+					break;
 				}
 			}
-
-			/* Free the array again. */
-			vPortFree( pxTaskStatusArray );
 		}
+
+		/* Insert the new item before pxIterator, as vListInsert() does. */
+		pxNewListItem->pxNext = pxIterator;
+		pxNewListItem->pxPrevious = pxIterator->pxPrevious;
+		pxIterator->pxPrevious->pxNext = pxNewListItem;
+		pxIterator->pxPrevious = pxNewListItem;
+		pxNewListItem->pvContainer = ( void * ) pxList;
+
+		( pxList->uxNumberOfItems )++;
 	}
 
-#endif /* configGENERATE_RUN_TIME_STATS */
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
 
+	static unsigned portBASE_TYPE prvListTaskWithinSingleList( xTaskStatusType *pxTaskStatusArray, xList *pxList, eTaskState eState )
+	{
+	volatile tskTCB *pxNextTCB, *pxFirstTCB;
+	unsigned portBASE_TYPE uxTask = 0;
+
+		if( listCURRENT_LIST_LENGTH( pxList ) > ( unsigned portBASE_TYPE ) 0 )
+		{
+			listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList );
+
+			/* Populate an xTaskStatusType structure within the
+			pxTaskStatusArray array for each task that is referenced from
+			pxList.  See the definition of xTaskStatusType in task.h for the
+			meaning of each xTaskStatusType structure member. */
+			do
+			{
+				listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList );
+
+				pxTaskStatusArray[ uxTask ].xHandle = ( xTaskHandle ) pxNextTCB;
+				pxTaskStatusArray[ uxTask ].pcTaskName = ( const signed char * ) &( pxNextTCB->pcTaskName [ 0 ] );
+				pxTaskStatusArray[ uxTask ].xTaskNumber = pxNextTCB->uxTCBNumber;
+				pxTaskStatusArray[ uxTask ].eCurrentState = eState;
+				pxTaskStatusArray[ uxTask ].uxCurrentPriority = pxNextTCB->uxPriority;
+
+				#if ( configUSE_MUTEXES == 1 )
+				{
+					pxTaskStatusArray[ uxTask ].uxBasePriority = pxNextTCB->uxBasePriority;
+				}
+				#else
+				{
+					pxTaskStatusArray[ uxTask ].uxBasePriority = 0;
+				}
+				#endif
+
+				#if ( configGENERATE_RUN_TIME_STATS == 1 )
+				{
+					pxTaskStatusArray[ uxTask ].ulRunTimeCounter = pxNextTCB->ulRunTimeCounter;
+					pxTaskStatusArray[ uxTask ].ulLongestRunTime = pxNextTCB->ulLongestRunTime;
+
+					/* The running task's current run has not ended yet. */
+					if( pxNextTCB == pxCurrentTCB )
+					{
+						pxTaskStatusArray[ uxTask ].ulLongestRunTime = prvGetRunningTaskLongestRunTime( pxNextTCB->ulLongestRunTime );
+					}
+				}
+				#else
+				{
+					pxTaskStatusArray[ uxTask ].ulRunTimeCounter = 0;
+					pxTaskStatusArray[ uxTask ].ulLongestRunTime = 0UL;
+				}
+				#endif
+
+				#if ( configUSE_CPU_LOAD == 1 )
+				{
+				tskCPULoad xTaskLoad = pxNextTCB->xCPULoad, xTotalLoad = xCPULoadTotal;
+				unsigned portBASE_TYPE uxWindow;
+
+					/* Bring copies of the averages up to date, as the task
+					might not have run for some time. */
+					prvCPULoadAdvance( &xTaskLoad );
+					prvCPULoadAdvance( &xTotalLoad );
+
+					for( uxWindow = 0U; uxWindow < ( unsigned portBASE_TYPE ) tskCPU_LOAD_WINDOWS; uxWindow++ )
+					{
+						if( xTotalLoad.ulLoad[ uxWindow ] > xTaskLoad.ulLoad[ uxWindow ] )
+						{
+							pxTaskStatusArray[ uxTask ].usCPULoad[ uxWindow ] = ( unsigned short ) ( ( ( unsigned long long ) xTaskLoad.ulLoad[ uxWindow ] * 1000ULL ) / ( unsigned long long ) xTotalLoad.ulLoad[ uxWindow ] );
+						}
+						else if( xTotalLoad.ulLoad[ uxWindow ] > 0UL )
+						{
+							/* The task is the only task that has run. */
+							pxTaskStatusArray[ uxTask ].usCPULoad[ uxWindow ] = ( unsigned short ) 1000U;
+						}
+						else
+						{
+							pxTaskStatusArray[ uxTask ].usCPULoad[ uxWindow ] = ( unsigned short ) 0U;
+						}
+					}
+				}
+				#else
+				{
+					( void ) memset( ( void * ) pxTaskStatusArray[ uxTask ].usCPULoad, 0x00, sizeof( pxTaskStatusArray[ uxTask ].usCPULoad ) );
+				}
+				#endif /* configUSE_CPU_LOAD */
+
+				#if ( portSTACK_GROWTH > 0 )
+				{
+					ppxTaskStatusArray[ uxTask ].usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( unsigned char * ) pxNextTCB->pxEndOfStack );
+				}
+				#else
+				{
+					pxTaskStatusArray[ uxTask ].usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( unsigned char * ) pxNextTCB->pxStack );
+				}
+				#endif
+
+				uxTask++;
+
+			} while( pxNextTCB != pxFirstTCB );
+		}
+
+		return uxTask;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+
+	static unsigned short prvTaskCheckFreeStackSpace( const unsigned char * pucStackByte )
+	{
+	register unsigned short usCount = 0U;
+
+		while( *pucStackByte == tskSTACK_FILL_BYTE )
+		{
+			pucStackByte -= portSTACK_GROWTH;
+			usCount++;
+		}
+
+		usCount /= sizeof( portSTACK_TYPE );
+
+		return usCount;
+	}
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+
+	unsigned portBASE_TYPE uxTaskGetStackHighWaterMark( xTaskHandle xTask )
+	{
+	tskTCB *pxTCB;
+	unsigned char *pcEndOfStack;
+	unsigned portBASE_TYPE uxReturn;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		#if portSTACK_GROWTH < 0
+		{
+			pcEndOfStack = ( unsigned char * ) pxTCB->pxStack;
+		}
+		#else
+		{
+			pcEndOfStack = ( unsigned char * ) pxTCB->pxEndOfStack;
+		}
+		#endif
+
+		uxReturn = ( unsigned portBASE_TYPE ) prvTaskCheckFreeStackSpace( pcEndOfStack );
+
+		return uxReturn;
+	}
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskDelete == 1 )
+
+	static void prvDeleteTCB( tskTCB *pxTCB )
+	{
+		/* This call is required specifically for the TriCore port.  It must be
+		above the vPortFree() calls.  The call is also used by ports/demos that
+		want to allocate and clean RAM statically. */
+		portCLEAN_UP_TCB( pxTCB );
+
+		/* Free up the memory allocated by the scheduler for the task.  It is up to
+		the task to free any memory allocated at the application level.  The
+		TCB and stack of a task created by xTaskCreateStatic() belong to the
+		application. */
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			if( pxTCB->ucStaticallyAllocated == pdFALSE )
+		#endif /* configSUPPORT_STATIC_ALLOCATION */
+		{
+			/* Keep the TCB and stack for the next task created with a stack
+			of the same depth, if the pool has room. */
+			#if ( configUSE_TASK_POOL == 1 )
+				if( prvReturnToTaskPool( pxTCB ) == pdFALSE )
+			#endif /* configUSE_TASK_POOL */
+			{
+				vPortFreeAligned( pxTCB->pxStack );
+				vPortFree( pxTCB );
+			}
+		}
+	}
+
+#endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configUSE_TASK_NOTIFICATIONS == 1 ) )
+
+	xTaskHandle xTaskGetCurrentTaskHandle( void )
+	{
+	xTaskHandle xReturn;
+
+		/* A critical section is not required as this is not called from
+		an interrupt and the current TCB will always be the same for any
+		individual execution thread. */
+		xReturn = pxCurrentTCB;
+
+		return xReturn;
+	}
+
+#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configUSE_TASK_NOTIFICATIONS == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+
+	portBASE_TYPE xTaskGetSchedulerState( void )
+	{
+	portBASE_TYPE xReturn;
+
+		if( xSchedulerRunning == pdFALSE )
+		{
+			xReturn = taskSCHEDULER_NOT_STARTED;
+		}
+		else
+		{
+			if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
+			{
+				xReturn = taskSCHEDULER_RUNNING;
+			}
+			else
+			{
+				xReturn = taskSCHEDULER_SUSPENDED;
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	void vTaskPriorityInherit( xTaskHandle const pxMutexHolder )
+	{
+	tskTCB * const pxTCB = ( tskTCB * ) pxMutexHolder;
+
+		/* If the mutex was given back by an interrupt while the queue was
+		locked then the mutex holder might now be NULL. */
+		if( pxMutexHolder != NULL )
+		{
+			if( pxTCB->uxPriority < pxCurrentTCB->uxPriority )
+			{
+				/* Adjust the mutex holder state to account for its new
+				priority.  Only reset the event list item value if the value is
+				not being used for anything else. */
+				if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( portTickType ) configMAX_PRIORITIES - ( portTickType ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				}
+
+				/* If the task being modified is in the ready state it will need to
+				be moved into a new list. */
+				if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xGenericListItem ) ) != pdFALSE )
+				{
+					if( uxListRemove( &( pxTCB->xGenericListItem ) ) == ( unsigned portBASE_TYPE ) 0 )
+					{
+						taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+					}
+
+					/* Inherit the priority before being moved into the new list. */
+					pxTCB->uxPriority = pxCurrentTCB->uxPriority;
+					prvAddTaskToReadyList( pxTCB );
+				}
+				else
+				{
+					/* Just inherit the priority. */
+					pxTCB->uxPriority = pxCurrentTCB->uxPriority;
+				}
+
+				taskSNAPSHOT_PRIORITIES( pxTCB );
+
+				traceTASK_PRIORITY_INHERIT( pxTCB, pxCurrentTCB->uxPriority );
+			}
+		}
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	void vTaskPriorityDisinherit( xTaskHandle const pxMutexHolder )
+	{
+	tskTCB * const pxTCB = ( tskTCB * ) pxMutexHolder;
+
+		if( pxMutexHolder != NULL )
+		{
+			if( pxTCB->uxPriority != taskUNINHERITED_PRIORITY( pxTCB ) )
+			{
+				/* We must be the running task to be able to give the mutex back.
+				Remove ourselves from the ready list we currently appear in. */
+				if( uxListRemove( &( pxTCB->xGenericListItem ) ) == ( unsigned portBASE_TYPE ) 0 )
+				{
+					taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+				}
+
+				/* Disinherit the priority before adding the task into the new
+				ready list. */
+				traceTASK_PRIORITY_DISINHERIT( pxTCB, taskUNINHERITED_PRIORITY( pxTCB ) );
+				pxTCB->uxPriority = taskUNINHERITED_PRIORITY( pxTCB );
+				taskSNAPSHOT_PRIORITIES( pxTCB );
+
+				/* Only reset the event list item value if the value is not
+				being used for anything else. */
+				if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( portTickType ) configMAX_PRIORITIES - ( portTickType ) pxTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				}
+				prvAddTaskToReadyList( pxTCB );
+			}
+		}
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CEILING_MUTEXES == 1 )
+
+	unsigned portBASE_TYPE uxTaskPriorityEnterCeiling( unsigned portBASE_TYPE uxCeilingPriority )
+	{
+	unsigned portBASE_TYPE uxPreviousCeiling;
+
+		/* A task that takes the mutex with a base priority above the ceiling
+		could be kept waiting by a holder running below its own priority. */
+		configASSERT( pxCurrentTCB->uxBasePriority <= uxCeilingPriority );
+
+		uxPreviousCeiling = pxCurrentTCB->uxCeilingPriority;
+
+		if( uxCeilingPriority > uxPreviousCeiling )
+		{
+			pxCurrentTCB->uxCeilingPriority = uxCeilingPriority;
+
+			/* The running task is being raised, so it remains the highest
+			priority task able to run and no yield is required. */
+			if( pxCurrentTCB->uxPriority < uxCeilingPriority )
+			{
+				traceTASK_PRIORITY_INHERIT( pxCurrentTCB, uxCeilingPriority );
+				prvSetMutexHolderPriority( pxCurrentTCB, uxCeilingPriority );
+			}
+		}
+
+		return uxPreviousCeiling;
+	}
+
+#endif /* configUSE_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CEILING_MUTEXES == 1 )
+
+	portBASE_TYPE xTaskPriorityLeaveCeiling( xTaskHandle const pxMutexHolder, unsigned portBASE_TYPE uxCeilingPriority, unsigned portBASE_TYPE uxPreviousCeiling )
+	{
+	tskTCB * const pxTCB = ( tskTCB * ) pxMutexHolder;
+	unsigned portBASE_TYPE uxNewPriority, uxPriority;
+	portBASE_TYPE xYieldRequired = pdFALSE;
+
+		if( pxMutexHolder != NULL )
+		{
+			pxTCB->uxCeilingPriority = uxPreviousCeiling;
+			uxNewPriority = taskUNINHERITED_PRIORITY( pxTCB );
+
+			/* A priority above the ceiling can only have been inherited
+			through another mutex the task holds, and is kept until that mutex
+			is given back. */
+			if( ( pxTCB->uxPriority <= uxCeilingPriority ) && ( pxTCB->uxPriority != uxNewPriority ) )
+			{
+				uxPriority = pxTCB->uxPriority;
+
+				traceTASK_PRIORITY_DISINHERIT( pxTCB, uxNewPriority );
+				prvSetMutexHolderPriority( pxTCB, uxNewPriority );
+
+				/* Lowering the priority of the holder, which is the running
+				task, only requires a yield if a task is ready at one of the
+				priorities it has dropped below.  Often none is, as no task
+				that could take the mutex can run while it is held, so the
+				ready lists are checked rather than always yielding. */
+				while( uxPriority > uxNewPriority )
+				{
+					if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxPriority ] ) ) == pdFALSE )
+					{
+						xYieldRequired = pdTRUE;
+						break;
+					}
+
+					uxPriority--;
+				}
+			}
+		}
+
+		return xYieldRequired;
+	}
+
+#endif /* configUSE_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CEILING_MUTEXES == 1 )
+
+	static void prvSetMutexHolderPriority( tskTCB * const pxTCB, unsigned portBASE_TYPE uxNewPriority )
+	{
+		/* Only reset the event list item value if the value is not being used
+		for anything else. */
+		if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+		{
+			listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( portTickType ) configMAX_PRIORITIES - ( portTickType ) uxNewPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		}
+
+		/* If the task is in the ready state it needs to be moved into the
+		list for its new priority. */
+		if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xGenericListItem ) ) != pdFALSE )
+		{
+			if( uxListRemove( &( pxTCB->xGenericListItem ) ) == ( unsigned portBASE_TYPE ) 0 )
+			{
+				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+			}
+
+			pxTCB->uxPriority = uxNewPriority;
+			prvAddTaskToReadyList( pxTCB );
+		}
+		else
+		{
+			pxTCB->uxPriority = uxNewPriority;
+		}
+
+		taskSNAPSHOT_PRIORITIES( pxTCB );
+	}
+
+#endif /* configUSE_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+	void vTaskEnterCritical( void )
+	{
+		portDISABLE_INTERRUPTS();
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			( pxCurrentTCB->uxCriticalNesting )++;
+		}
+	}
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
+/*-----------------------------------------------------------*/
+
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+	void vTaskExitCritical( void )
+	{
+		if( xSchedulerRunning != pdFALSE )
+		{
+			if( pxCurrentTCB->uxCriticalNesting > 0U )
+			{
+				( pxCurrentTCB->uxCriticalNesting )--;
+
+				if( pxCurrentTCB->uxCriticalNesting == 0U )
+				{
+					portENABLE_INTERRUPTS();
+				}
+			}
+		}
+	}
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS == 1 ) )
+
+	void vTaskList( signed char *pcWriteBuffer )
+	{
+	xTaskStatusType *pxTaskStatusArray;
+	volatile unsigned portBASE_TYPE uxArraySize, x;
+	char cStatus;
+
+		/*
+		 * PLEASE NOTE:
+		 *
+		 * This function is provided for convenience only, and is used by many
+		 * of the demo applications.  Do not consider it to be part of the
+		 * scheduler.
+		 *
+		 * vTaskList() calls uxTaskGetSystemState(), then formats part of the
+		 * uxTaskGetSystemState() output into a human readable table that
+		 * displays task names, states and stack usage.
+		 *
+		 * vTaskList() has a dependency on the sprintf() C library function that
+		 * might bloat the code size, use a lot of stack, and provide different
+		 * results on different platforms.  An alternative, tiny, third party,
+		 * and limited functionality implementation of sprintf() is provided in
+		 * many of the FreeRTOS/Demo sub-directories in a file called
+		 * printf-stdarg.c (note printf-stdarg.c does not provide a full
+		 * snprintf() implementation!).
+		 *
+		 * It is recommended that production systems call uxTaskGetSystemState()
+		 * directly to get access to raw stats data, rather than indirectly
+		 * through a call to vTaskList().
+		 */
+
+
+		/* Make sure the write buffer does not contain a string. */
+		*pcWriteBuffer = 0x00;
+
+		/* Take a snapshot of the number of tasks in case it changes while this
+		function is executing. */
+		uxArraySize = uxCurrentNumberOfTasks;
+
+		/* Allocate an array index for each task. */
+		pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( xTaskStatusType ) );
+
+		if( pxTaskStatusArray != NULL )
+		{
+			/* Generate the (binary) data. */
+			uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, NULL );
+
+			/* Create a human readable table from the binary data. */
+			for( x = 0; x < uxArraySize; x++ )
+			{
+				switch( pxTaskStatusArray[ x ].eCurrentState )
+				{
+				case eReady:		cStatus = tskREADY_CHAR;
+									break;
+
+				case eBlocked:		cStatus = tskBLOCKED_CHAR;
+									break;
+
+				case eSuspended:	cStatus = tskSUSPENDED_CHAR;
+									break;
+
+				case eDeleted:		cStatus = tskDELETED_CHAR;
+									break;
+
+				default:			/* Should not get here, but it is included
+									to prevent static checking errors. */
+									cStatus = 0x00;
+									break;
+				}
+
+				sprintf( ( char * ) pcWriteBuffer, ( char * ) "%s\t\t%c\t%u\t%u\t%u\r\n", pxTaskStatusArray[ x ].pcTaskName, cStatus, ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber );
+				pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+			}
+
+			/* Free the array again. */
+			vPortFree( pxTaskStatusArray );
+		}
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*----------------------------------------------------------*/
+
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS == 1 ) )
+
+	void vTaskGetRunTimeStats( signed char *pcWriteBuffer )
+	{
+	#if ( configUSE_TASK_SNAPSHOT == 1 )
+		xTaskSnapshotType *pxTaskStatusArray;
+	#else
+		xTaskStatusType *pxTaskStatusArray;
+	#endif
+	volatile unsigned portBASE_TYPE uxArraySize, x;
+	configRUN_TIME_COUNTER_TYPE ulTotalTime, ulStatsAsPercentage;
+
+		/*
+		 * PLEASE NOTE:
+		 *
+		 * This function is provided for convenience only, and is used by many
+		 * of the demo applications.  Do not consider it to be part of the
+		 * scheduler.
+		 *
+		 * vTaskGetRunTimeStats() calls uxTaskGetSystemState(), then formats part
+		 * of the uxTaskGetSystemState() output into a human readable table that
+		 * displays the amount of time each task has spent in the Running state
+		 * in both absolute and percentage terms.
+		 *
+		 * vTaskGetRunTimeStats() has a dependency on the sprintf() C library
+		 * function that might bloat the code size, use a lot of stack, and
+		 * provide different results on different platforms.  An alternative,
+		 * tiny, third party, and limited functionality implementation of
+		 * sprintf() is provided in many of the FreeRTOS/Demo sub-directories in
+		 * a file called printf-stdarg.c (note printf-stdarg.c does not provide
+		 * a full snprintf() implementation!).
+		 *
+		 * It is recommended that production systems call uxTaskGetSystemState()
+		 * directly to get access to raw stats data, rather than indirectly
+		 * through a call to vTaskGetRunTimeStats().
+		 */
+
+		/* Make sure the write buffer does not contain a string. */
+		*pcWriteBuffer = 0x00;
+
+		#if ( configUSE_TASK_SNAPSHOT == 1 )
+		{
+			/* The snapshot table does not suspend the scheduler to be read, so
+			is used in place of uxTaskGetSystemState() when it is available. */
+			uxArraySize = configTASK_SNAPSHOT_SLOTS;
+			pxTaskStatusArray = pvPortMalloc( configTASK_SNAPSHOT_SLOTS * sizeof( xTaskSnapshotType ) );
+		}
+		#else
+		{
+			/* Take a snapshot of the number of tasks in case it changes while
+			this function is executing. */
+			uxArraySize = uxCurrentNumberOfTasks;
+
+			/* Allocate an array index for each task. */
+			pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( xTaskStatusType ) );
+		}
+		#endif /* configUSE_TASK_SNAPSHOT */
+
+		if( pxTaskStatusArray != NULL )
+		{
+			/* Generate the (binary) data. */
+			#if ( configUSE_TASK_SNAPSHOT == 1 )
+			{
+				uxArraySize = uxTaskGetSnapshot( pxTaskStatusArray, uxArraySize, &ulTotalTime );
+			}
+			#else
+			{
+				uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, &ulTotalTime );
+			}
+			#endif /* configUSE_TASK_SNAPSHOT */
+
+			/* For percentage calculations. */
+			ulTotalTime /= 100UL;
+
+			/* Avoid divide by zero errors. */
+			if( ulTotalTime > 0 )
+			{
+				/* Create a human readable table from the binary data. */
+				for( x = 0; x < uxArraySize; x++ )
+				{
+					/* What percentage of the total run time has the task used?
+					This will always be rounded down to the nearest integer.
+					ulTotalRunTimeDiv100 has already been divided by 100. */
+					ulStatsAsPercentage = pxTaskStatusArray[ x ].ulRunTimeCounter / ulTotalTime;
+
+					if( ulStatsAsPercentage > 0UL )
+					{
+						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
+						{
+							sprintf( ( char * ) pcWriteBuffer, ( char * ) "%s\t\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].pcTaskName, ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned long ) ulStatsAsPercentage );
+						}
+						#else
+						{
+							/* sizeof( int ) == sizeof( long ) so a smaller
+							printf() library can be used. */
+							sprintf( ( char * ) pcWriteBuffer, ( char * ) "%s\t\t%u\t\t%u%%\r\n", pxTaskStatusArray[ x ].pcTaskName, ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned int ) ulStatsAsPercentage );
+						}
+						#endif
+					}
+					else
+					{
+						/* If the percentage is zero here then the task has
+						consumed less than 1% of the total run time. */
+						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
+						{
+							sprintf( ( char * ) pcWriteBuffer, ( char * ) "%s\t\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].pcTaskName, ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter );
+						}
+						#else
+						{
+							/* sizeof( int ) == sizeof( long ) so a smaller
+							printf() library can be used. */
+							sprintf( ( char * ) pcWriteBuffer, ( char * ) "%s\t\t%u\t\t<1%%\r\n", pxTaskStatusArray[ x ].pcTaskName, ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter );
+						}
+						#endif
+					}
+
+					pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+				}
+			}
+
+			/* Free the array again. */
+			vPortFree( pxTaskStatusArray );
+		}
+	}
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STATS_STREAM == 1 )
+
+	/* Frame fields are written least significant byte first, whatever the
+	byte order of the processor. */
+	#define taskSTATS_PUT_16( pucField, xValue )										\
+	{																					\
+		( pucField )[ 0 ] = ( unsigned char ) ( xValue );								\
+		( pucField )[ 1 ] = ( unsigned char ) ( ( xValue ) >> 8 );						\
+	}
+
+	#define taskSTATS_PUT_32( pucField, ulValue )										\
+	{																					\
+		taskSTATS_PUT_16( ( pucField ), ( ulValue ) );									\
+		taskSTATS_PUT_16( &( ( pucField )[ 2 ] ), ( ( ulValue ) >> 16 ) );			\
+	}
+
+	/* Run times that do not fit in the 4 byte field are sent as 0xffffffff.
+	The shift is made in two steps as configRUN_TIME_COUNTER_TYPE might only be
+	32 bits wide. */
+	#define taskSTATS_RUN_TIME( ulRunTime ) ( ( ( ( ( ulRunTime ) >> 16 ) >> 16 ) != 0U ) ? 0xffffffffUL : ( unsigned long ) ( ulRunTime ) )
+
+	size_t xTaskGetStatsStream( xTaskStatsStreamType *pxStream, unsigned char *pucBuffer, size_t xBufferSize )
+	{
+	xTaskStatusType *pxTaskStatusArray;
+	size_t xArrayBytes;
+	unsigned portBASE_TYPE uxArraySize, x, uxPrevious;
+	configRUN_TIME_COUNTER_TYPE ulTotalTime, ulRunTime;
+	unsigned long ulField;
+	unsigned char *pucFrame = pucBuffer, *pucPayload;
+	size_t xNameLength, xReturn = 0;
+
+		configASSERT( pxStream );
+		configASSERT( pucBuffer );
+
+		/* Take a snapshot of the number of tasks in case it changes while this
+		function is executing. */
+		uxArraySize = uxCurrentNumberOfTasks;
+
+		if( xBufferSize >= tskSTATS_STREAM_BUFFER_SIZE( uxArraySize ) )
+		{
+			#if ( configUSE_TASK_SNAPSHOT == 1 )
+			{
+				/* The copies of the snapshot entries are held after the
+				status structures. */
+				xArrayBytes = ( size_t ) uxArraySize * ( sizeof( xTaskStatusType ) + sizeof( xTaskSnapshotType ) );
+			}
+			#else
+			{
+				xArrayBytes = ( size_t ) uxArraySize * sizeof( xTaskStatusType );
+			}
+			#endif /* configUSE_TASK_SNAPSHOT */
+
+			pxTaskStatusArray = pvPortMalloc( xArrayBytes );
+
+			if( pxTaskStatusArray != NULL )
+			{
+				#if ( configGENERATE_RUN_TIME_STATS == 1 )
+				{
+					/* The calling task has been running since it was last
+					switched in.  Add that time to its run time now, so the
+					run times reported add up to the total. */
+					taskENTER_CRITICAL();
+					{
+						prvAccountRunTime();
+					}
+					taskEXIT_CRITICAL();
+				}
+				#endif /* configGENERATE_RUN_TIME_STATS */
+
+				#if ( configUSE_TASK_SNAPSHOT == 1 )
+				{
+					/* Generate the (binary) data from the snapshot table, so
+					the scheduler is not suspended.  Tasks created since the
+					number of tasks was read might not be reported until the
+					next report. */
+					uxArraySize = prvGetSnapshotSystemState( pxTaskStatusArray, ( xTaskSnapshotType * ) &( pxTaskStatusArray[ uxArraySize ] ), uxArraySize, &ulTotalTime );
+				}
+				#else
+				{
+					/* Generate the (binary) data.  No tasks are returned if a
+					task was created since the number of tasks was read. */
+					uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, &ulTotalTime );
+				}
+				#endif /* configUSE_TASK_SNAPSHOT */
+
+				if( uxArraySize > ( unsigned portBASE_TYPE ) 0xffU )
+				{
+					uxArraySize = ( unsigned portBASE_TYPE ) 0xffU;
+				}
+
+				if( uxArraySize > ( unsigned portBASE_TYPE ) 0U )
+				{
+					pucPayload = &( pucFrame[ 3 ] );
+					taskSTATS_PUT_16( &( pucPayload[ 0 ] ), pxStream->usSequence );
+					pucPayload[ 2 ] = ( unsigned char ) uxArraySize;
+					ulField = taskSTATS_RUN_TIME( ulTotalTime - pxStream->ulTotalRunTime );
+					taskSTATS_PUT_32( &( pucPayload[ 3 ] ), ulField );
+					pucFrame = prvEndStatsFrame( pucFrame, tskSTATS_FRAME_REPORT, ( unsigned char ) tskSTATS_REPORT_PAYLOAD );
+
+					for( x = 0; x < uxArraySize; x++ )
+					{
+						/* Was the task in the previous report? */
+						for( uxPrevious = 0; uxPrevious < pxStream->uxTasks; uxPrevious++ )
+						{
+							if( pxStream->uxTaskNumber[ uxPrevious ] == pxTaskStatusArray[ x ].xTaskNumber )
+							{
+								break;
+							}
+						}
+
+						ulRunTime = pxTaskStatusArray[ x ].ulRunTimeCounter;
+
+						if( uxPrevious < pxStream->uxTasks )
+						{
+							ulRunTime -= pxStream->ulRunTime[ uxPrevious ];
+						}
+
+						/* The host only needs the name of a task it has not
+						seen before. */
+						if( ( uxPrevious == pxStream->uxTasks ) || ( pxStream->xResendNames != pdFALSE ) )
+						{
+							xNameLength = strlen( ( const char * ) pxTaskStatusArray[ x ].pcTaskName );
+							pucPayload = &( pucFrame[ 3 ] );
+							taskSTATS_PUT_16( &( pucPayload[ 0 ] ), pxTaskStatusArray[ x ].xTaskNumber );
+							memcpy( ( void * ) &( pucPayload[ 2 ] ), ( const void * ) pxTaskStatusArray[ x ].pcTaskName, xNameLength );
+							pucFrame = prvEndStatsFrame( pucFrame, tskSTATS_FRAME_NAME, ( unsigned char ) ( 2U + xNameLength ) );
+						}
+
+						/* uxTaskGetSystemState() finds the calling task in a
+						ready list. */
+						if( pxTaskStatusArray[ x ].xHandle == ( xTaskHandle ) pxCurrentTCB )
+						{
+							pxTaskStatusArray[ x ].eCurrentState = eRunning;
+						}
+
+						pucPayload = &( pucFrame[ 3 ] );
+						taskSTATS_PUT_16( &( pucPayload[ 0 ] ), pxTaskStatusArray[ x ].xTaskNumber );
+						pucPayload[ 2 ] = ( unsigned char ) pxTaskStatusArray[ x ].eCurrentState;
+						pucPayload[ 3 ] = ( unsigned char ) pxTaskStatusArray[ x ].uxCurrentPriority;
+						taskSTATS_PUT_16( &( pucPayload[ 4 ] ), pxTaskStatusArray[ x ].usStackHighWaterMark );
+						ulField = taskSTATS_RUN_TIME( ulRunTime );
+						taskSTATS_PUT_32( &( pucPayload[ 6 ] ), ulField );
+						pucFrame = prvEndStatsFrame( pucFrame, tskSTATS_FRAME_TASK, ( unsigned char ) tskSTATS_TASK_PAYLOAD );
+					}
+
+					/* Remember the run times reported, so the next report can
+					send the run time used since this one. */
+					if( uxArraySize > ( unsigned portBASE_TYPE ) configSTATS_STREAM_TASKS )
+					{
+						pxStream->uxTasks = ( unsigned portBASE_TYPE ) configSTATS_STREAM_TASKS;
+					}
+					else
+					{
+						pxStream->uxTasks = uxArraySize;
+					}
+
+					for( x = 0; x < pxStream->uxTasks; x++ )
+					{
+						pxStream->uxTaskNumber[ x ] = pxTaskStatusArray[ x ].xTaskNumber;
+						pxStream->ulRunTime[ x ] = pxTaskStatusArray[ x ].ulRunTimeCounter;
+					}
+
+					pxStream->ulTotalRunTime = ulTotalTime;
+					pxStream->usSequence++;
+					pxStream->xResendNames = pdFALSE;
+
+					xReturn = ( size_t ) ( pucFrame - pucBuffer );
+				}
+
+				/* Free the array again. */
+				vPortFree( pxTaskStatusArray );
+			}
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static unsigned char *prvEndStatsFrame( unsigned char *pucFrame, unsigned char ucType, unsigned char ucLength )
+	{
+	unsigned char ucSum, x;
+
+		pucFrame[ 0 ] = tskSTATS_FRAME_SYNC;
+		pucFrame[ 1 ] = ucType;
+		pucFrame[ 2 ] = ucLength;
+		ucSum = ( unsigned char ) ( ucType + ucLength );
+
+		for( x = 0U; x < ucLength; x++ )
+		{
+			ucSum = ( unsigned char ) ( ucSum + pucFrame[ 3U + x ] );
+		}
+
+		/* Make the sum of every byte after the sync byte zero. */
+		pucFrame[ 3U + ucLength ] = ( unsigned char ) ( 0U - ucSum );
+
+		return &( pucFrame[ tskSTATS_FRAME_OVERHEAD + ucLength ] );
+	}
+	/*-----------------------------------------------------------*/
+
+	#if ( configUSE_TASK_SNAPSHOT == 1 )
+
+		static unsigned portBASE_TYPE prvGetSnapshotSystemState( xTaskStatusType *pxTaskStatusArray, xTaskSnapshotType *pxSnapshotArray, unsigned portBASE_TYPE uxArraySize, configRUN_TIME_COUNTER_TYPE *pulTotalRunTime )
+		{
+		unsigned portBASE_TYPE uxSlot, uxTask = 0;
+		volatile tskSnapshotSlot *pxSlot;
+		xTaskSnapshotType *pxSnapshot;
+		tskTCB *pxTCB;
+
+			for( uxSlot = 0; ( uxSlot < ( unsigned portBASE_TYPE ) configTASK_SNAPSHOT_SLOTS ) && ( uxTask < uxArraySize ); uxSlot++ )
+			{
+				pxSlot = &( xSnapshotSlots[ uxSlot ] );
+				pxSnapshot = &( pxSnapshotArray[ uxTask ] );
+				prvSnapshotCopySlot( pxSlot, pxSnapshot );
+				pxTCB = ( tskTCB * ) pxSnapshot->xHandle;
+
+				/* Was the entry in use? */
+				if( pxTCB != NULL )
+				{
+					pxTaskStatusArray[ uxTask ].xHandle = pxSnapshot->xHandle;
+					pxTaskStatusArray[ uxTask ].pcTaskName = ( const signed char * ) &( pxSnapshot->pcTaskName[ 0 ] );
+					pxTaskStatusArray[ uxTask ].xTaskNumber = pxSnapshot->xTaskNumber;
+					pxTaskStatusArray[ uxTask ].uxCurrentPriority = pxSnapshot->uxCurrentPriority;
+					pxTaskStatusArray[ uxTask ].uxBasePriority = pxSnapshot->uxBasePriority;
+					pxTaskStatusArray[ uxTask ].ulRunTimeCounter = pxSnapshot->ulRunTimeCounter;
+					pxTaskStatusArray[ uxTask ].ulLongestRunTime = pxSnapshot->ulLongestRunTime;
+					pxTaskStatusArray[ uxTask ].usStackHighWaterMark = pxSnapshot->usStackHighWaterMark;
+					( void ) memset( ( void * ) pxTaskStatusArray[ uxTask ].usCPULoad, 0x00, sizeof( pxTaskStatusArray[ uxTask ].usCPULoad ) );
+
+					/* The entry is released by vTaskDelete() before the TCB
+					can be freed, so the TCB is only read if the entry still
+					holds the same task. */
+					taskENTER_CRITICAL();
+					{
+						if( ( pxSlot->xSnapshot.xHandle != pxSnapshot->xHandle ) || ( pxSlot->xSnapshot.xTaskNumber != pxSnapshot->xTaskNumber ) )
+						{
+							pxTaskStatusArray[ uxTask ].eCurrentState = eDeleted;
+						}
+						else if( pxTCB == pxCurrentTCB )
+						{
+							pxTaskStatusArray[ uxTask ].eCurrentState = eRunning;
+
+							#if ( configGENERATE_RUN_TIME_STATS == 1 )
+							{
+								/* The running task's current run has not
+								ended yet. */
+								pxTaskStatusArray[ uxTask ].ulLongestRunTime = prvGetRunningTaskLongestRunTime( pxTaskStatusArray[ uxTask ].ulLongestRunTime );
+							}
+							#endif /* configGENERATE_RUN_TIME_STATS */
+						}
+						else
+						{
+							pxTaskStatusArray[ uxTask ].eCurrentState = prvTaskStateFromList( ( xList * ) listLIST_ITEM_CONTAINER( &( pxTCB->xGenericListItem ) ) );
+						}
+					}
+					taskEXIT_CRITICAL();
+
+					uxTask++;
+				}
+			}
+
+			#if ( configGENERATE_RUN_TIME_STATS == 1 )
+			{
+				*pulTotalRunTime = prvGetTotalRunTime();
+			}
+			#else
+			{
+				*pulTotalRunTime = 0;
+			}
+			#endif
+
+			return uxTask;
+		}
+
+	#endif /* configUSE_TASK_SNAPSHOT */
+
+#endif /* configUSE_STATS_STREAM */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	static void prvBlockCurrentTaskForNotification( portTickType xTicksToWait )
+	{
+		/* We must remove ourselves from the ready list before adding ourselves
+		to the blocked list as the same list item is used for both lists. */
+		if( uxListRemove( &( pxCurrentTCB->xGenericListItem ) ) == ( unsigned portBASE_TYPE ) 0 )
+		{
+			/* The current task must be in a ready list, so there is no need to
+			check, and the ready priority can be cleared directly. */
+			taskCLEAR_READY_PRIORITY( pxCurrentTCB->uxPriority );
+		}
+
+		#if ( INCLUDE_vTaskSuspend == 1 )
+		{
+			if( xTicksToWait == portMAX_DELAY )
+			{
+				/* Add the task to the suspended task list instead of a delayed
+				task list to ensure it is not woken by a timing event.  It will
+				block indefinitely. */
+				vListInsertEnd( &xSuspendedTaskList, &( pxCurrentTCB->xGenericListItem ) );
+			}
+			else
+			{
+				/* The wake time may overflow but this doesn't matter. */
+				prvAddCurrentTaskToDelayedList( xTickCount + xTicksToWait );
+			}
+		}
+		#else /* INCLUDE_vTaskSuspend */
+		{
+			prvAddCurrentTaskToDelayedList( xTickCount + xTicksToWait );
+		}
+		#endif /* INCLUDE_vTaskSuspend */
+	}
+	/*-----------------------------------------------------------*/
+
+	static portBASE_TYPE prvUpdateNotifiedValue( tskTCB *pxTCB, unsigned long ulValue, eNotifyAction eAction, unsigned char ucOriginalNotifyState )
+	{
+	portBASE_TYPE xReturn = pdPASS;
+
+		switch( eAction )
+		{
+			case eSetBits	:
+				pxTCB->ulNotifiedValue |= ulValue;
+				break;
+
+			case eIncrement	:
+				( pxTCB->ulNotifiedValue )++;
+				break;
+
+			case eSetValueWithOverwrite	:
+				pxTCB->ulNotifiedValue = ulValue;
+				break;
+
+			case eSetValueWithoutOverwrite :
+				if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
+				{
+					pxTCB->ulNotifiedValue = ulValue;
+				}
+				else
+				{
+					/* The value could not be written to the task. */
+					xReturn = pdFAIL;
+				}
+				break;
+
+			case eNoAction :
+			default :
+				/* The task is being notified without its notify value being
+				updated. */
+				break;
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static unsigned long prvTakeNotifiedValue( portBASE_TYPE xClearCountOnExit )
+	{
+	unsigned long ulReturn;
+
+		traceTASK_NOTIFY_TAKE();
+		ulReturn = pxCurrentTCB->ulNotifiedValue;
+
+		if( ulReturn != 0UL )
+		{
+			if( xClearCountOnExit != pdFALSE )
+			{
+				pxCurrentTCB->ulNotifiedValue = 0UL;
+			}
+			else
+			{
+				pxCurrentTCB->ulNotifiedValue = ulReturn - 1UL;
+			}
+		}
+
+		pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+
+		return ulReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait )
+	{
+	unsigned long ulReturn = 0UL;
+	portBASE_TYPE xBlocked = pdFALSE;
+
+		taskENTER_CRITICAL();
+		{
+			/* Only block if the notification count is not already non-zero,
+			otherwise the count can be taken without a second critical
+			section. */
+			if( ( pxCurrentTCB->ulNotifiedValue == 0UL ) && ( xTicksToWait > ( portTickType ) 0 ) )
+			{
+				/* Mark this task as waiting for a notification. */
+				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+
+				traceTASK_NOTIFY_TAKE_BLOCK();
+				prvBlockCurrentTaskForNotification( xTicksToWait );
+				xBlocked = pdTRUE;
+
+				/* All ports are written to allow a yield in a critical
+				section (some will yield immediately, others wait until the
+				critical section exits) - but it is not something that
+				application code should ever do. */
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				ulReturn = prvTakeNotifiedValue( xClearCountOnExit );
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xBlocked != pdFALSE )
+		{
+			/* The task has either been notified or timed out. */
+			taskENTER_CRITICAL();
+			{
+				ulReturn = prvTakeNotifiedValue( xClearCountOnExit );
+			}
+			taskEXIT_CRITICAL();
+		}
+
+		return ulReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static portBASE_TYPE prvReceiveNotification( unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue )
+	{
+	portBASE_TYPE xReturn;
+
+		traceTASK_NOTIFY_WAIT();
+
+		if( pulNotificationValue != NULL )
+		{
+			/* Output the current notification value, which may or may not
+			have changed. */
+			*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+		}
+
+		/* If ucNotifyState is not taskNOTIFICATION_RECEIVED then either no
+		notification was pending and the task did not block, or the task
+		unblocked because of a timeout. */
+		if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+		{
+			/* A notification was not received. */
+			xReturn = pdFALSE;
+		}
+		else
+		{
+			/* A notification was already pending or a notification was
+			received while the task was waiting. */
+			pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+			xReturn = pdTRUE;
+		}
+
+		pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait )
+	{
+	portBASE_TYPE xReturn = pdFALSE, xBlocked = pdFALSE;
+
+		taskENTER_CRITICAL();
+		{
+			/* Only block if a notification is not already pending. */
+			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			{
+				/* Clear bits in the task's notification value as bits may get
+				set by the notifying task or interrupt.  This can be used to
+				clear the value to zero. */
+				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+
+				if( xTicksToWait > ( portTickType ) 0 )
+				{
+					/* Mark this task as waiting for a notification. */
+					pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+
+					traceTASK_NOTIFY_WAIT_BLOCK();
+					prvBlockCurrentTaskForNotification( xTicksToWait );
+					xBlocked = pdTRUE;
+					portYIELD_WITHIN_API();
+				}
+			}
+
+			if( xBlocked == pdFALSE )
+			{
+				xReturn = prvReceiveNotification( ulBitsToClearOnExit, pulNotificationValue );
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xBlocked != pdFALSE )
+		{
+			/* The task has either been notified or timed out. */
+			taskENTER_CRITICAL();
+			{
+				xReturn = prvReceiveNotification( ulBitsToClearOnExit, pulNotificationValue );
+			}
+			taskEXIT_CRITICAL();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	portBASE_TYPE xTaskNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction )
+	{
+	tskTCB * const pxTCB = ( tskTCB * ) xTaskToNotify;
+	portBASE_TYPE xReturn;
+	unsigned char ucOriginalNotifyState;
+
+		configASSERT( xTaskToNotify );
+
+		taskENTER_CRITICAL();
+		{
+			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+
+			xReturn = prvUpdateNotifiedValue( pxTCB, ulValue, eAction, ucOriginalNotifyState );
+
+			traceTASK_NOTIFY();
+
+			/* If the task is in the blocked state specifically to wait for a
+			notification then unblock it now. */
+			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+			{
+				/* The task should not have been on an event list. */
+				configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+				/* As we are in a critical section we can access the ready
+				lists even if the scheduler is suspended. */
+				( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+				prvAddTaskToReadyList( pxTCB );
+
+				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				{
+					/* The notified task has a priority above the currently
+					executing task so a yield is required. */
+					portYIELD_WITHIN_API();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	portBASE_TYPE xTaskNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	tskTCB * const pxTCB = ( tskTCB * ) xTaskToNotify;
+	portBASE_TYPE xReturn;
+	unsigned char ucOriginalNotifyState;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+		configASSERT( xTaskToNotify );
+
+		/* See the comment in xTaskResumeFromISR(). */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+
+			xReturn = prvUpdateNotifiedValue( pxTCB, ulValue, eAction, ucOriginalNotifyState );
+
+			traceTASK_NOTIFY_FROM_ISR();
+
+			/* If the task is in the blocked state specifically to wait for a
+			notification then unblock it now. */
+			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+			{
+				/* The task should not have been on an event list. */
+				configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+				if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
+				{
+					( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+					prvAddTaskToReadyList( pxTCB );
+				}
+				else
+				{
+					/* The delayed and ready lists cannot be accessed, so hold
+					this task pending until the scheduler is resumed. */
+					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+				}
+
+				if( ( pxTCB->uxPriority > pxCurrentTCB->uxPriority ) && ( pxHigherPriorityTaskWoken != NULL ) )
+				{
+					/* The notified task has a priority above the currently
+					executing task so a yield is required. */
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	tskTCB * const pxTCB = ( tskTCB * ) xTaskToNotify;
+	unsigned char ucOriginalNotifyState;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+		configASSERT( xTaskToNotify );
+
+		/* See the comment in xTaskResumeFromISR(). */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+
+			/* 'Giving' is equivalent to incrementing a count in a counting
+			semaphore. */
+			( pxTCB->ulNotifiedValue )++;
+
+			traceTASK_NOTIFY_GIVE_FROM_ISR();
+
+			/* If the task is in the blocked state specifically to wait for a
+			notification then unblock it now. */
+			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+			{
+				/* The task should not have been on an event list. */
+				configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+				if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
+				{
+					( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+					prvAddTaskToReadyList( pxTCB );
+				}
+				else
+				{
+					/* The delayed and ready lists cannot be accessed, so hold
+					this task pending until the scheduler is resumed. */
+					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+				}
+
+				if( ( pxTCB->uxPriority > pxCurrentTCB->uxPriority ) && ( pxHigherPriorityTaskWoken != NULL ) )
+				{
+					/* The notified task has a priority above the currently
+					executing task so a yield is required. */
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+	/*-----------------------------------------------------------*/
+
+	portBASE_TYPE xTaskNotifyStateClear( xTaskHandle xTask )
+	{
+	tskTCB *pxTCB;
+	portBASE_TYPE xReturn;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		taskENTER_CRITICAL();
+		{
+			if( pxTCB->ucNotifyState == taskNOTIFICATION_RECEIVED )
+			{
+				pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				xReturn = pdFALSE;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
 
+#endif /* configUSE_TASK_NOTIFICATIONS */
 
@@ -64,6 +64,7 @@
 
 /* Standard includes. */
 #include <stdlib.h>
+#include <string.h>
 
 /* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
 all the API functions to use the MPU wrappers.  That should only be done when
@@ -91,6 +92,55 @@ configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
 /* Misc definitions. */
 #define tmrNO_DELAY		( portTickType ) 0U
 
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+	#if ( configTIMER_WHEEL_SIZE & ( configTIMER_WHEEL_SIZE - 1 ) ) != 0
+		#error configTIMER_WHEEL_SIZE must be a power of 2
+	#endif
+	#if ( configUSE_16_BIT_TICKS == 1 ) && ( configTIMER_WHEEL_SIZE > 128 )
+		#error configTIMER_WHEEL_SIZE squared must fit within the tick count
+	#endif
+
+	/*
+	 * The timer wheel has two levels.  The first has one slot per tick, the
+	 * second one slot per configTIMER_WHEEL_SIZE ticks.
+	 */
+	#define tmrWHEEL_LEVELS		( 2 )
+	#define tmrWHEEL_MASK		( ( portTickType ) configTIMER_WHEEL_SIZE - ( portTickType ) 1 )
+	#define tmrWHEEL_SPAN		( ( portTickType ) configTIMER_WHEEL_SIZE * ( portTickType ) configTIMER_WHEEL_SIZE )
+
+	/* Is pxList one of the slots in the first level? */
+	#define tmrIS_FIRST_LEVEL_SLOT( pxList ) ( ( ( pxList ) >= &( xTimerWheel[ 0 ][ 0 ] ) ) && ( ( pxList ) <= &( xTimerWheel[ 0 ][ configTIMER_WHEEL_SIZE - 1 ] ) ) )
+
+#endif /* configUSE_TIMER_WHEEL */
+
+#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+
+	#if ( configUSE_TIMER_WHEEL != 1 )
+		#error configUSE_TIMER_DIRECT_COMMANDS requires configUSE_TIMER_WHEEL to be set to 1
+	#endif
+
+	/* Sent to the timer service task only to unblock it, when a command
+	applied directly makes a timer expire before the task is due to unblock. */
+	#define tmrCOMMAND_WAKE				( ( portBASE_TYPE ) -2 )
+
+	/* The values returned by prvApplyCommandDirectly(). */
+	#define tmrDIRECT_NOT_APPLIED		( ( portBASE_TYPE ) 0 )
+	#define tmrDIRECT_APPLIED			( ( portBASE_TYPE ) 1 )
+	#define tmrDIRECT_APPLIED_WAKE		( ( portBASE_TYPE ) 2 )
+
+	/* Other tasks and interrupts update the wheel too, so the timer service
+	task only updates it from within a critical section. */
+	#define tmrENTER_WHEEL_CRITICAL()	taskENTER_CRITICAL()
+	#define tmrEXIT_WHEEL_CRITICAL()	taskEXIT_CRITICAL()
+
+#else
+
+	#define tmrENTER_WHEEL_CRITICAL()
+	#define tmrEXIT_WHEEL_CRITICAL()
+
+#endif /* configUSE_TIMER_DIRECT_COMMANDS */
+
 /* The definition of the timers themselves. */
 typedef struct tmrTimerControl
 {
@@ -100,31 +150,118 @@ typedef struct tmrTimerControl
 	unsigned portBASE_TYPE	uxAutoReload;		/*<< Set to pdTRUE if the timer should be automatically restarted once expired.  Set to pdFALSE if the timer is, in effect, a one shot timer. */
 	void 					*pvTimerID;			/*<< An ID to identify the timer.  This allows the timer to be identified when the same callback is used for multiple timers. */
 	tmrTIMER_CALLBACK		pxCallbackFunction;	/*<< The function that will be called when the timer expires. */
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char		ucStaticallyAllocated;	/*<< Set to pdTRUE if the timer was created in memory provided by the application, so must not be freed when the timer is deleted. */
+	#endif
+	#if ( configUSE_TIMER_HISTOGRAMS == 1 )
+		volatile unsigned portBASE_TYPE uxHistogramSequence;	/*<< Incremented before and after xHistogram is written, so it is odd while a write is in progress. */
+		xTimerHistogram		xHistogram;			/*<< How late the callback executed, and how long it took, each time the timer expired. */
+	#endif
+	#if ( INCLUDE_xTimerGetTimerByName == 1 )
+		struct tmrTimerControl *pxNextTimer;	/*<< The next timer in the list of timers searched by xTimerGetTimerByName(). */
+	#endif
 } xTIMER;
 
-/* The definition of messages that can be sent and received on the timer
-queue. */
-typedef struct tmrTimerQueueMessage
+/* The definition of messages that can be sent and received on the timer queue.
+Two types of message can be queued - messages that manipulate a software timer,
+and messages that request the execution of a non-timer related callback.  The
+two message types are defined in two separate structures, xTIMER_PARAMETERS
+and xCALLBACK_PARAMETERS respectively. */
+typedef struct tmrTimerParameters
 {
-	portBASE_TYPE			xMessageID;			/*<< The command being sent to the timer service task. */
 	portTickType			xMessageValue;		/*<< An optional value used by a subset of commands, for example, when changing the period of a timer. */
 	xTIMER *				pxTimer;			/*<< The timer to which the command will be applied. */
+} xTIMER_PARAMETERS;
+
+typedef struct tmrCallbackParameters
+{
+	tmrPENDED_FUNCTION		pxCallbackFunction;	/* << The callback function to execute. */
+	void *					pvParameter1;		/* << The value that will be used as the callback functions first parameter. */
+	unsigned long			ulParameter2;		/* << The value that will be used as the callback functions second parameter. */
+} xCALLBACK_PARAMETERS;
+
+/* The structure that contains the two message types, along with an identifier
+that is used to determine which message type is valid. */
+typedef struct tmrTimerQueueMessage
+{
+	portBASE_TYPE			xMessageID;			/*<< The command being sent to the timer service task. */
+	union
+	{
+		xTIMER_PARAMETERS xTimerParameters;
+
+		/* Don't include xCallbackParameters if it is not going to be used as
+		it makes the structure (and therefore the timer queue) larger. */
+		#if ( INCLUDE_xTimerPendFunctionCall == 1 )
+			xCALLBACK_PARAMETERS xCallbackParameters;
+		#endif /* INCLUDE_xTimerPendFunctionCall */
+	} u;
 } xTIMER_MESSAGE;
 
 /*lint -e956 A manual analysis and inspection has been used to determine which
 static variables must be declared volatile. */
 
-/* The list in which active timers are stored.  Timers are referenced in expire
-time order, with the nearest expiry time at the front of the list.  Only the
-timer service task is allowed to access xActiveTimerList. */
-PRIVILEGED_DATA static xList xActiveTimerList1;
-PRIVILEGED_DATA static xList xActiveTimerList2;
-PRIVILEGED_DATA static xList *pxCurrentTimerList;
-PRIVILEGED_DATA static xList *pxOverflowTimerList;
+#if ( configUSE_TIMER_WHEEL == 0 )
+
+	/* The list in which active timers are stored.  Timers are referenced in
+	expire time order, with the nearest expiry time at the front of the list.
+	Only the timer service task is allowed to access xActiveTimerList. */
+	PRIVILEGED_DATA static xList xActiveTimerList1;
+	PRIVILEGED_DATA static xList xActiveTimerList2;
+	PRIVILEGED_DATA static xList *pxCurrentTimerList;
+	PRIVILEGED_DATA static xList *pxOverflowTimerList;
+
+#else
+
+	/* Active timers due within configTIMER_WHEEL_SIZE ticks of xWheelTime are
+	held in the first level of the wheel, in the slot for their expiry time.
+	All other active timers are held in the second level, in the slot for
+	their expiry time divided by configTIMER_WHEEL_SIZE, and are moved into the
+	first level at the start of the window in which they expire.  A timer due
+	more than a whole turn of the second level away stays where it is until the
+	window in which it expires starts.  Slots are not sorted, so a timer is
+	started, stopped or reloaded in constant time however many timers are
+	active.  Expiry times are only compared relative to xWheelTime, so the tick
+	count overflowing needs no special handling.  Only the timer service task
+	is allowed to access the wheel, unless configUSE_TIMER_DIRECT_COMMANDS is
+	1, in which case it is only accessed from within a critical section. */
+	PRIVILEGED_DATA static xList xTimerWheel[ tmrWHEEL_LEVELS ][ configTIMER_WHEEL_SIZE ];
+	PRIVILEGED_DATA static portTickType xWheelTime = ( portTickType ) 0U;	/*< The time up to which the wheel has been processed.  Every timer in the wheel expires after it. */
+	PRIVILEGED_DATA static unsigned portBASE_TYPE uxWheelTimers = 0U;		/*< The number of timers in the wheel. */
+	PRIVILEGED_DATA static unsigned portBASE_TYPE uxFirstLevelTimers = 0U;	/*< The number of those timers in the first level. */
+
+#endif /* configUSE_TIMER_WHEEL */
+
+#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+
+	/* A command is only applied directly while no command sent to the timer
+	service task earlier is still waiting to be applied, so commands to the
+	same timer take effect in the order they were issued. */
+	PRIVILEGED_DATA static volatile unsigned portBASE_TYPE uxQueuedTimerCommands = 0U;
+
+	/* Incremented each time a command is applied directly.  The timer service
+	task does not block if it has changed since the task found the next expire
+	time, as the next expire time might then be sooner. */
+	PRIVILEGED_DATA static volatile unsigned portBASE_TYPE uxDirectTimerCommands = 0U;
+	PRIVILEGED_DATA static unsigned portBASE_TYPE uxDirectTimerCommandsSeen = 0U;
+
+	/* Set while the timer service task is blocked until xDaemonWakeTime, so a
+	command applied directly can tell if the task must be unblocked early. */
+	PRIVILEGED_DATA static volatile portBASE_TYPE xDaemonBlocked = pdFALSE;
+	PRIVILEGED_DATA static volatile portTickType xDaemonWakeTime = ( portTickType ) 0U;
+
+#endif /* configUSE_TIMER_DIRECT_COMMANDS */
 
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static xQueueHandle xTimerQueue = NULL;
 
+#if ( INCLUDE_xTimerGetTimerByName == 1 )
+
+	/* Every timer that has been created and not deleted, most recently created
+	first.  Only accessed with the scheduler suspended. */
+	PRIVILEGED_DATA static xTIMER *pxTimerNameList = NULL;
+
+#endif
+
 #if ( INCLUDE_xTimerGetTimerDaemonTaskHandle == 1 )
 
 	PRIVILEGED_DATA static xTaskHandle xTimerTaskHandle = NULL;
@@ -141,6 +278,43 @@ PRIVILEGED_DATA static xQueueHandle xTimerQueue = NULL;
  */
 static void prvCheckForValidListAndQueue( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Initialise a timer structure that has just been allocated, or provided by
+ * the application.
+ */
+static void prvInitialiseNewTimer( xTIMER *pxNewTimer, const signed char * const pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_TIMER_HISTOGRAMS == 1 )
+
+	/*
+	 * Call the callback of a timer that expired at xExpiryTime, and record how
+	 * late it was called and how long it took in the histograms of the timer.
+	 */
+	static void prvExecuteCallback( xTIMER *pxTimer, portTickType xExpiryTime ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns the histogram bucket that counts ulTime.
+	 */
+	static unsigned portBASE_TYPE prvHistogramBucket( unsigned long ulTime ) PRIVILEGED_FUNCTION;
+
+	#define tmrEXECUTE_CALLBACK( pxTimer, xExpiryTime )	prvExecuteCallback( ( pxTimer ), ( xExpiryTime ) )
+
+#else
+
+	#define tmrEXECUTE_CALLBACK( pxTimer, xExpiryTime )	( pxTimer )->pxCallbackFunction( ( xTimerHandle ) ( pxTimer ) )
+
+#endif /* configUSE_TIMER_HISTOGRAMS */
+
+#if ( INCLUDE_xTimerGetTimerByName == 1 )
+
+	/*
+	 * Remove a timer that is being deleted from the list searched by
+	 * xTimerGetTimerByName().
+	 */
+	static void prvRemoveTimerName( xTIMER *pxTimer ) PRIVILEGED_FUNCTION;
+
+#endif /* INCLUDE_xTimerGetTimerByName */
+
 /*
  * The timer service task (daemon).  Timer functionality is controlled by this
  * task.  Other tasks communicate with the timer service task using the
@@ -160,17 +334,66 @@ static void	prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
  */
 static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xNextExpiryTime, portTickType xTimeNow, portTickType xCommandTime ) PRIVILEGED_FUNCTION;
 
-/*
- * An active timer has reached its expire time.  Reload the timer if it is an
- * auto reload timer, then call its callback.
- */
-static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow ) PRIVILEGED_FUNCTION;
-
-/*
- * The tick count has overflowed.  Switch the timer lists after ensuring the
- * current timer list does not still reference some timers.
- */
-static void prvSwitchTimerLists( portTickType xLastTime ) PRIVILEGED_FUNCTION;
+#if ( configUSE_TIMER_WHEEL == 0 )
+
+	/*
+	 * An active timer has reached its expire time.  Reload the timer if it is
+	 * an auto reload timer, then call its callback.
+	 */
+	static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The tick count has overflowed.  Switch the timer lists after ensuring the
+	 * current timer list does not still reference some timers.
+	 */
+	static void prvSwitchTimerLists( portTickType xLastTime ) PRIVILEGED_FUNCTION;
+
+#else
+
+	/*
+	 * Place an active timer into the wheel slot for its expiry time, which
+	 * must be after xWheelTime.
+	 */
+	static void prvTimerWheelInsert( xTIMER *pxTimer, portTickType xExpiryTime ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Remove an active timer from the wheel.
+	 */
+	static void prvTimerWheelRemove( xTIMER *pxTimer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Advance xWheelTime to xTimeNow one tick at a time, moving timers from
+	 * the second level into the first at the start of each window, and
+	 * processing each timer that expires in the order it expires.  Ticks in
+	 * which no timer can expire are skipped.
+	 */
+	static void prvTimerWheelAdvance( portTickType xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * One step of prvTimerWheelAdvance(), which is called from a critical
+	 * section if commands can be applied directly.  Either removes a timer
+	 * that has expired from the wheel, reloading it if it is an auto reload
+	 * timer, and sets *ppxExpiredTimer to the timer, or moves xWheelTime on,
+	 * and sets *ppxExpiredTimer to NULL.  Returns pdFALSE once xWheelTime has
+	 * reached xTimeNow and no timer remains to be processed.
+	 */
+	static portBASE_TYPE prvTimerWheelStep( portTickType xTimeNow, xTIMER **ppxExpiredTimer ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_WHEEL */
+
+#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+
+	/*
+	 * Apply a start, reset, stop or change period command to the wheel from
+	 * within a critical section, rather than send it to the timer service task.
+	 * Returns tmrDIRECT_NOT_APPLIED if the command must be sent to the timer
+	 * service task instead, in which case it is counted as queued, or
+	 * tmrDIRECT_APPLIED_WAKE if the timer service task must be unblocked to
+	 * process the timer sooner than it would otherwise.
+	 */
+	static portBASE_TYPE prvApplyCommandDirectly( xTIMER *pxTimer, portBASE_TYPE xCommandID, portTickType xOptionalValue, portBASE_TYPE xFromISR ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_DIRECT_COMMANDS */
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
@@ -206,7 +429,28 @@ portBASE_TYPE xReturn = pdFAIL;
 
 	if( xTimerQueue != NULL )
 	{
-		#if ( INCLUDE_xTimerGetTimerDaemonTaskHandle == 1 )
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+		xStaticTaskType *pxTimerTaskTCBBuffer = NULL;
+		portSTACK_TYPE *pxTimerTaskStackBuffer = NULL;
+		unsigned short usTimerTaskStackSize = ( unsigned short ) configTIMER_TASK_STACK_DEPTH;
+
+			/* The memory used by the timer service task is provided by the
+			application, so the scheduler can be started without using the
+			heap. */
+			vApplicationGetTimerTaskMemory( &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &usTimerTaskStackSize );
+
+			#if ( INCLUDE_xTimerGetTimerDaemonTaskHandle == 1 )
+			{
+				xReturn = xTaskCreateStatic( prvTimerTask, ( const signed char * ) "Tmr Svc", usTimerTaskStackSize, NULL, ( ( unsigned portBASE_TYPE ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT, &xTimerTaskHandle, pxTimerTaskStackBuffer, pxTimerTaskTCBBuffer );
+			}
+			#else
+			{
+				xReturn = xTaskCreateStatic( prvTimerTask, ( const signed char * ) "Tmr Svc", usTimerTaskStackSize, NULL, ( ( unsigned portBASE_TYPE ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT, NULL, pxTimerTaskStackBuffer, pxTimerTaskTCBBuffer );
+			}
+			#endif
+		}
+		#elif ( INCLUDE_xTimerGetTimerDaemonTaskHandle == 1 )
 		{
 			/* Create the timer task, storing its handle in xTimerTaskHandle so
 			it can be returned by the xTimerGetTimerDaemonTaskHandle() function. */
@@ -240,19 +484,13 @@ xTIMER *pxNewTimer;
 		pxNewTimer = ( xTIMER * ) pvPortMalloc( sizeof( xTIMER ) );
 		if( pxNewTimer != NULL )
 		{
-			/* Ensure the infrastructure used by the timer service task has been
-			created/initialised. */
-			prvCheckForValidListAndQueue();
-
-			/* Initialise the timer structure members using the function parameters. */
-			pxNewTimer->pcTimerName = pcTimerName;
-			pxNewTimer->xTimerPeriodInTicks = xTimerPeriodInTicks;
-			pxNewTimer->uxAutoReload = uxAutoReload;
-			pxNewTimer->pvTimerID = pvTimerID;
-			pxNewTimer->pxCallbackFunction = pxCallbackFunction;
-			vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxNewTimer->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif
 
-			traceTIMER_CREATE( pxNewTimer );
+			prvInitialiseNewTimer( pxNewTimer, pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction );
 		}
 		else
 		{
@@ -264,10 +502,79 @@ xTIMER *pxNewTimer;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xTimerHandle xTimerCreateStatic( const signed char * const pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction, xStaticTimerType *pxTimerBuffer )
+	{
+	xTIMER *pxNewTimer = NULL;
+
+		/* If this fails xStaticTimerType has not been kept in step with the
+		timer structure. */
+		configASSERT( sizeof( xStaticTimerType ) == sizeof( xTIMER ) );
+		configASSERT( pxTimerBuffer );
+		configASSERT( ( xTimerPeriodInTicks > 0 ) );
+
+		if( ( pxTimerBuffer != NULL ) && ( xTimerPeriodInTicks != ( portTickType ) 0U ) )
+		{
+			pxNewTimer = ( xTIMER * ) pxTimerBuffer;
+			pxNewTimer->ucStaticallyAllocated = pdTRUE;
+			prvInitialiseNewTimer( pxNewTimer, pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction );
+		}
+		else
+		{
+			traceTIMER_CREATE_FAILED();
+		}
+
+		return ( xTimerHandle ) pxNewTimer;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewTimer( xTIMER *pxNewTimer, const signed char * const pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction )
+{
+	/* Ensure the infrastructure used by the timer service task has been
+	created/initialised. */
+	prvCheckForValidListAndQueue();
+
+	/* Initialise the timer structure members using the function parameters. */
+	pxNewTimer->pcTimerName = pcTimerName;
+	pxNewTimer->xTimerPeriodInTicks = xTimerPeriodInTicks;
+	pxNewTimer->uxAutoReload = uxAutoReload;
+	pxNewTimer->pvTimerID = pvTimerID;
+	pxNewTimer->pxCallbackFunction = pxCallbackFunction;
+	vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
+
+	#if ( configUSE_TIMER_HISTOGRAMS == 1 )
+	{
+		pxNewTimer->uxHistogramSequence = ( unsigned portBASE_TYPE ) 0U;
+		memset( ( void * ) &( pxNewTimer->xHistogram ), 0x00, sizeof( xTimerHistogram ) );
+	}
+	#endif /* configUSE_TIMER_HISTOGRAMS */
+
+	#if ( INCLUDE_xTimerGetTimerByName == 1 )
+	{
+		vTaskSuspendAll();
+		{
+			pxNewTimer->pxNextTimer = pxTimerNameList;
+			pxTimerNameList = pxNewTimer;
+		}
+		( void ) xTaskResumeAll();
+	}
+	#endif /* INCLUDE_xTimerGetTimerByName */
+
+	traceTIMER_CREATE( pxNewTimer );
+}
+/*-----------------------------------------------------------*/
+
 portBASE_TYPE xTimerGenericCommand( xTimerHandle xTimer, portBASE_TYPE xCommandID, portTickType xOptionalValue, signed portBASE_TYPE *pxHigherPriorityTaskWoken, portTickType xBlockTime )
 {
 portBASE_TYPE xReturn = pdFAIL;
 xTIMER_MESSAGE xMessage;
+#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+	portBASE_TYPE xDirect;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+#endif
 
 	/* Send a message to the timer service task to perform a particular action
 	on a particular timer definition. */
@@ -275,24 +582,73 @@ xTIMER_MESSAGE xMessage;
 	{
 		/* Send a command to the timer service task to start the xTimer timer. */
 		xMessage.xMessageID = xCommandID;
-		xMessage.xMessageValue = xOptionalValue;
-		xMessage.pxTimer = ( xTIMER * ) xTimer;
+		xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
+		xMessage.u.xTimerParameters.pxTimer = ( xTIMER * ) xTimer;
 
-		if( pxHigherPriorityTaskWoken == NULL )
+		#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+		{
+			xDirect = prvApplyCommandDirectly( ( xTIMER * ) xTimer, xCommandID, xOptionalValue, ( pxHigherPriorityTaskWoken != NULL ) ? pdTRUE : pdFALSE );
+
+			if( xDirect == tmrDIRECT_APPLIED_WAKE )
+			{
+				/* The command has been applied, so the message only unblocks
+				the timer service task.  If the queue is full the task will
+				unblock anyway, so there is no need to wait for space. */
+				xMessage.xMessageID = tmrCOMMAND_WAKE;
+				xBlockTime = tmrNO_DELAY;
+			}
+		}
+		#endif /* configUSE_TIMER_DIRECT_COMMANDS */
+
+		#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+			if( xDirect != tmrDIRECT_APPLIED )
+		#endif
 		{
-			if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+			if( pxHigherPriorityTaskWoken == NULL )
 			{
-				xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xBlockTime );
+				if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+				{
+					xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xBlockTime );
+				}
+				else
+				{
+					xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+				}
 			}
 			else
 			{
-				xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+				xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
 			}
 		}
-		else
+
+		#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
 		{
-			xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+			if( xDirect != tmrDIRECT_NOT_APPLIED )
+			{
+				xReturn = pdPASS;
+			}
+			else if( xReturn == pdFAIL )
+			{
+				/* The command was counted as queued but was not sent. */
+				if( pxHigherPriorityTaskWoken == NULL )
+				{
+					taskENTER_CRITICAL();
+					{
+						uxQueuedTimerCommands--;
+					}
+					taskEXIT_CRITICAL();
+				}
+				else
+				{
+					uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+					{
+						uxQueuedTimerCommands--;
+					}
+					portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+				}
+			}
 		}
+		#endif /* configUSE_TIMER_DIRECT_COMMANDS */
 
 		traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
 	}
@@ -314,6 +670,8 @@ xTIMER_MESSAGE xMessage;
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMER_WHEEL == 0 )
+
 static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow )
 {
 xTIMER *pxTimer;
@@ -346,8 +704,10 @@ portBASE_TYPE xResult;
 	}
 
 	/* Call the timer callback. */
-	pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+	tmrEXECUTE_CALLBACK( pxTimer, xNextExpireTime );
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static void prvTimerTask( void *pvParameters )
@@ -389,12 +749,22 @@ portBASE_TYPE xTimerListsWereSwitched;
 		xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
 		if( xTimerListsWereSwitched == pdFALSE )
 		{
+			#if ( configUSE_TIMER_WHEEL == 1 )
+			/* Times in the wheel are compared relative to xWheelTime, as the
+			tick count might have overflowed since it was last sampled. */
+			if( ( xListWasEmpty == pdFALSE ) && ( ( portTickType ) ( xNextExpireTime - xWheelTime ) <= ( portTickType ) ( xTimeNow - xWheelTime ) ) )
+			{
+				( void ) xTaskResumeAll();
+				prvTimerWheelAdvance( xTimeNow );
+			}
+			#else
 			/* The tick count has not overflowed, has the timer expired? */
 			if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
 			{
 				( void ) xTaskResumeAll();
 				prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
 			}
+			#endif /* configUSE_TIMER_WHEEL */
 			else
 			{
 				/* The tick count has not overflowed, and the next expire
@@ -403,7 +773,45 @@ portBASE_TYPE xTimerListsWereSwitched;
 				received - whichever comes first.  The following line cannot
 				be reached unless xNextExpireTime > xTimeNow, except in the
 				case when the current timer list is empty. */
-				vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ) );
+				#if ( configUSE_TIMER_WHEEL == 1 )
+				{
+				portBASE_TYPE xBlock = pdTRUE;
+
+					#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+					{
+						/* If a command has been applied directly since the
+						next expire time was found, a timer might now expire
+						sooner, so find the next expire time again rather than
+						block.  Otherwise a command applied directly from now
+						on unblocks this task if it has to. */
+						taskENTER_CRITICAL();
+						{
+							if( uxDirectTimerCommands == uxDirectTimerCommandsSeen )
+							{
+								xDaemonWakeTime = ( xListWasEmpty == pdFALSE ) ? xNextExpireTime : ( xTimeNow + portMAX_DELAY );
+								xDaemonBlocked = pdTRUE;
+							}
+							else
+							{
+								xBlock = pdFALSE;
+							}
+						}
+						taskEXIT_CRITICAL();
+					}
+					#endif /* configUSE_TIMER_DIRECT_COMMANDS */
+
+					/* With no active timers there is nothing to wake for
+					until a command is received. */
+					if( xBlock != pdFALSE )
+					{
+						vQueueWaitForMessageRestricted( xTimerQueue, ( xListWasEmpty == pdFALSE ) ? ( xNextExpireTime - xTimeNow ) : portMAX_DELAY );
+					}
+				}
+				#else
+				{
+					vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ) );
+				}
+				#endif /* configUSE_TIMER_WHEEL */
 
 				if( xTaskResumeAll() == pdFALSE )
 				{
@@ -413,6 +821,13 @@ portBASE_TYPE xTimerListsWereSwitched;
 					to block. */
 					portYIELD_WITHIN_API();
 				}
+
+				#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+				{
+					/* Also cleared by a command that unblocks this task. */
+					xDaemonBlocked = pdFALSE;
+				}
+				#endif /* configUSE_TIMER_DIRECT_COMMANDS */
 			}
 		}
 		else
@@ -434,16 +849,74 @@ portTickType xNextExpireTime;
 	this task to unblock when the tick count overflows, at which point the
 	timer lists will be switched and the next expiry time can be
 	re-assessed.  */
-	*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-	if( *pxListWasEmpty == pdFALSE )
+	#if ( configUSE_TIMER_WHEEL == 1 )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+	portTickType xTicks, xTicksToExpire = tmrWHEEL_SPAN;
+
+		#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+		{
+			/* The wheel is searched outside of a critical section.  A command
+			applied directly from now on is noticed before this task blocks. */
+			taskENTER_CRITICAL();
+			{
+				uxDirectTimerCommandsSeen = uxDirectTimerCommands;
+			}
+			taskEXIT_CRITICAL();
+		}
+		#endif /* configUSE_TIMER_DIRECT_COMMANDS */
+
+		/* The wheel has work to do at the time of the first occupied slot in
+		the first level, or at the start of the first window that has an
+		occupied slot in the second level.  Both searches are bounded by the
+		size of the wheel, not by the number of active timers. */
+		*pxListWasEmpty = ( uxWheelTimers == 0U ) ? pdTRUE : pdFALSE;
+
+		if( uxFirstLevelTimers != 0U )
+		{
+			for( xTicks = ( portTickType ) 1U; xTicks <= ( portTickType ) configTIMER_WHEEL_SIZE; xTicks++ )
+			{
+				if( listLIST_IS_EMPTY( &( xTimerWheel[ 0 ][ ( xWheelTime + xTicks ) & tmrWHEEL_MASK ] ) ) == pdFALSE )
+				{
+					xTicksToExpire = xTicks;
+					break;
+				}
+			}
+		}
+
+		if( uxWheelTimers != uxFirstLevelTimers )
+		{
+			for( xTicks = ( portTickType ) 1U; xTicks <= ( portTickType ) configTIMER_WHEEL_SIZE; xTicks++ )
+			{
+				if( listLIST_IS_EMPTY( &( xTimerWheel[ 1 ][ ( ( xWheelTime / ( portTickType ) configTIMER_WHEEL_SIZE ) + xTicks ) & tmrWHEEL_MASK ] ) ) == pdFALSE )
+				{
+					xTicks = ( ( ( xWheelTime / ( portTickType ) configTIMER_WHEEL_SIZE ) + xTicks ) * ( portTickType ) configTIMER_WHEEL_SIZE ) - xWheelTime;
+
+					if( xTicks < xTicksToExpire )
+					{
+						xTicksToExpire = xTicks;
+					}
+
+					break;
+				}
+			}
+		}
+
+		xNextExpireTime = xWheelTime + xTicksToExpire;
 	}
-	else
+	#else
 	{
-		/* Ensure the task unblocks when the tick count rolls over. */
-		xNextExpireTime = ( portTickType ) 0U;
+		*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+		if( *pxListWasEmpty == pdFALSE )
+		{
+			xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		}
+		else
+		{
+			/* Ensure the task unblocks when the tick count rolls over. */
+			xNextExpireTime = ( portTickType ) 0U;
+		}
 	}
+	#endif /* configUSE_TIMER_WHEEL */
 
 	return xNextExpireTime;
 }
@@ -452,21 +925,32 @@ portTickType xNextExpireTime;
 static portTickType prvSampleTimeNow( portBASE_TYPE *pxTimerListsWereSwitched )
 {
 portTickType xTimeNow;
-PRIVILEGED_DATA static portTickType xLastTime = ( portTickType ) 0U; /*lint !e956 Variable is only accessible to one task. */
 
 	xTimeNow = xTaskGetTickCount();
 
-	if( xTimeNow < xLastTime )
-	{
-		prvSwitchTimerLists( xLastTime );
-		*pxTimerListsWereSwitched = pdTRUE;
-	}
-	else
+	#if ( configUSE_TIMER_WHEEL == 1 )
 	{
+		/* The wheel does not use separate lists for times after the tick
+		count overflows. */
 		*pxTimerListsWereSwitched = pdFALSE;
 	}
+	#else
+	{
+	PRIVILEGED_DATA static portTickType xLastTime = ( portTickType ) 0U; /*lint !e956 Variable is only accessible to one task. */
+
+		if( xTimeNow < xLastTime )
+		{
+			prvSwitchTimerLists( xLastTime );
+			*pxTimerListsWereSwitched = pdTRUE;
+		}
+		else
+		{
+			*pxTimerListsWereSwitched = pdFALSE;
+		}
 
-	xLastTime = xTimeNow;
+		xLastTime = xTimeNow;
+	}
+	#endif /* configUSE_TIMER_WHEEL */
 
 	return xTimeNow;
 }
@@ -479,6 +963,32 @@ portBASE_TYPE xProcessTimerNow = pdFALSE;
 	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
 	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
 
+	#if ( configUSE_TIMER_WHEEL == 1 )
+	/* Has the expiry time elapsed between the command to start/reset a timer
+	was issued, and the time the command was processed?  The subtraction
+	allows for the tick count overflowing in between. */
+	if( ( portTickType ) ( xTimeNow - xCommandTime ) >= pxTimer->xTimerPeriodInTicks )
+	{
+		xProcessTimerNow = pdTRUE;
+	}
+	else
+	{
+		/* An empty wheel has nothing left to process, so is moved to the
+		present.  Otherwise the daemon has processed the wheel within a turn
+		of the second level, so xWheelTime is never so far behind that an
+		expiry time relative to it overflows. */
+		tmrENTER_WHEEL_CRITICAL();
+		{
+			if( uxWheelTimers == 0U )
+			{
+				xWheelTime = xTimeNow;
+			}
+
+			prvTimerWheelInsert( pxTimer, xNextExpiryTime );
+		}
+		tmrEXIT_WHEEL_CRITICAL();
+	}
+	#else
 	if( xNextExpiryTime <= xTimeNow )
 	{
 		/* Has the expiry time elapsed between the command to start/reset a
@@ -508,11 +1018,268 @@ portBASE_TYPE xProcessTimerNow = pdFALSE;
 			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
 		}
 	}
+	#endif /* configUSE_TIMER_WHEEL */
 
 	return xProcessTimerNow;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+	static void prvTimerWheelInsert( xTIMER *pxTimer, portTickType xExpiryTime )
+	{
+	xList *pxSlot;
+
+		listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xExpiryTime );
+
+		if( ( portTickType ) ( xExpiryTime - xWheelTime ) < ( portTickType ) configTIMER_WHEEL_SIZE )
+		{
+			pxSlot = &( xTimerWheel[ 0 ][ xExpiryTime & tmrWHEEL_MASK ] );
+			uxFirstLevelTimers++;
+		}
+		else
+		{
+			pxSlot = &( xTimerWheel[ 1 ][ ( xExpiryTime / ( portTickType ) configTIMER_WHEEL_SIZE ) & tmrWHEEL_MASK ] );
+		}
+
+		/* The slots are not sorted, and are never walked using pxIndex, so
+		this inserts at the end of the slot. */
+		vListInsertEnd( pxSlot, &( pxTimer->xTimerListItem ) );
+		uxWheelTimers++;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTimerWheelRemove( xTIMER *pxTimer )
+	{
+		if( tmrIS_FIRST_LEVEL_SLOT( ( xList * ) pxTimer->xTimerListItem.pvContainer ) )
+		{
+			uxFirstLevelTimers--;
+		}
+
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+		uxWheelTimers--;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTimerWheelAdvance( portTickType xTimeNow )
+	{
+	portBASE_TYPE xMoreToDo;
+	portTickType xExpiryTime;
+	xTIMER *pxTimer;
+
+		do
+		{
+			/* Each step takes a bounded time, so is short enough to be taken
+			from within a critical section.  Timer callbacks are called outside
+			of it.  A timer returned by a step expired at xWheelTime. */
+			tmrENTER_WHEEL_CRITICAL();
+			{
+				xMoreToDo = prvTimerWheelStep( xTimeNow, &pxTimer );
+				xExpiryTime = xWheelTime;
+			}
+			tmrEXIT_WHEEL_CRITICAL();
+
+			if( pxTimer != NULL )
+			{
+				tmrEXECUTE_CALLBACK( pxTimer, xExpiryTime );
+			}
+		} while( xMoreToDo != pdFALSE );
+	}
+	/*-----------------------------------------------------------*/
+
+	static portBASE_TYPE prvTimerWheelStep( portTickType xTimeNow, xTIMER **ppxExpiredTimer )
+	{
+	portTickType xTicksToWindow, xWindow;
+	xListItem *pxItem, *pxNextItem;
+	xList *pxSlot;
+	xTIMER *pxTimer;
+
+		*ppxExpiredTimer = NULL;
+
+		/* Every timer in the first level slot for xWheelTime expires at
+		xWheelTime.  A timer that is reloaded, or started, is due at least one
+		tick after xWheelTime, so is never placed into this slot. */
+		pxSlot = &( xTimerWheel[ 0 ][ xWheelTime & tmrWHEEL_MASK ] );
+
+		if( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+		{
+			pxTimer = ( xTIMER * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+			prvTimerWheelRemove( pxTimer );
+			traceTIMER_EXPIRED( pxTimer );
+
+			/* An auto reload timer is reloaded relative to the time it
+			expired, not the time it is processed, so it does not drift.  If it
+			is due again before xTimeNow it is processed again in a later
+			step. */
+			if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
+			{
+				prvTimerWheelInsert( pxTimer, xWheelTime + pxTimer->xTimerPeriodInTicks );
+			}
+
+			*ppxExpiredTimer = pxTimer;
+			return pdTRUE;
+		}
+
+		if( xWheelTime == xTimeNow )
+		{
+			return pdFALSE;
+		}
+
+		if( uxWheelTimers == 0U )
+		{
+			/* Nothing left to process. */
+			xWheelTime = xTimeNow;
+			return pdFALSE;
+		}
+
+		if( uxFirstLevelTimers == 0U )
+		{
+			/* No timer can expire before the start of the next window, so skip
+			to the tick before it, or to xTimeNow if that is sooner. */
+			xTicksToWindow = ( ( portTickType ) configTIMER_WHEEL_SIZE - ( xWheelTime & tmrWHEEL_MASK ) ) - ( portTickType ) 1U;
+
+			if( xTicksToWindow >= ( portTickType ) ( xTimeNow - xWheelTime ) )
+			{
+				xWheelTime = xTimeNow;
+				return pdFALSE;
+			}
+
+			xWheelTime += xTicksToWindow;
+		}
+
+		xWheelTime++;
+
+		if( ( xWheelTime & tmrWHEEL_MASK ) == ( portTickType ) 0U )
+		{
+			/* A window is starting.  Move the timers that expire within it
+			from its second level slot into the first level.  Timers due in a
+			later turn of the wheel stay where they are. */
+			xWindow = xWheelTime / ( portTickType ) configTIMER_WHEEL_SIZE;
+			pxSlot = &( xTimerWheel[ 1 ][ xWindow & tmrWHEEL_MASK ] );
+			pxItem = listGET_HEAD_ENTRY( pxSlot );
+
+			while( pxItem != listGET_END_MARKER( pxSlot ) )
+			{
+				pxNextItem = listGET_NEXT( pxItem );
+
+				if( ( portTickType ) ( listGET_LIST_ITEM_VALUE( pxItem ) - xWheelTime ) < ( portTickType ) configTIMER_WHEEL_SIZE )
+				{
+					( void ) uxListRemove( pxItem );
+					vListInsertEnd( &( xTimerWheel[ 0 ][ listGET_LIST_ITEM_VALUE( pxItem ) & tmrWHEEL_MASK ] ), pxItem );
+					uxFirstLevelTimers++;
+				}
+
+				pxItem = pxNextItem;
+			}
+		}
+
+		return pdTRUE;
+	}
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+
+	static portBASE_TYPE prvApplyCommandDirectly( xTIMER *pxTimer, portBASE_TYPE xCommandID, portTickType xOptionalValue, portBASE_TYPE xFromISR )
+	{
+	portBASE_TYPE xResult = tmrDIRECT_NOT_APPLIED;
+	unsigned portBASE_TYPE uxSavedInterruptStatus = 0U;
+	portTickType xTimeNow, xExpiryTime = ( portTickType ) 0U;
+
+		if( xFromISR != pdFALSE )
+		{
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			xTimeNow = xTaskGetTickCountFromISR();
+		}
+		else
+		{
+			taskENTER_CRITICAL();
+			xTimeNow = xTaskGetTickCount();
+		}
+
+		/* xWheelTime is only kept up to date while the wheel holds a timer,
+		so a timer is only added to an empty wheel by the timer service
+		task. */
+		if( ( uxQueuedTimerCommands == 0U ) && ( uxWheelTimers != 0U ) )
+		{
+			switch( xCommandID )
+			{
+				case tmrCOMMAND_START :
+					/* A timer that has expired since the command was issued is
+					left for the timer service task to process. */
+					if( ( portTickType ) ( xTimeNow - xOptionalValue ) < pxTimer->xTimerPeriodInTicks )
+					{
+						xExpiryTime = xOptionalValue + pxTimer->xTimerPeriodInTicks;
+						xResult = tmrDIRECT_APPLIED;
+					}
+					break;
+
+				case tmrCOMMAND_STOP :
+					xResult = tmrDIRECT_APPLIED;
+					break;
+
+				case tmrCOMMAND_CHANGE_PERIOD :
+					configASSERT( ( xOptionalValue > 0 ) );
+					pxTimer->xTimerPeriodInTicks = xOptionalValue;
+					xExpiryTime = xTimeNow + xOptionalValue;
+					xResult = tmrDIRECT_APPLIED;
+					break;
+
+				default :
+					/* The memory of a deleted timer is freed by the timer
+					service task. */
+					break;
+			}
+
+			if( xResult != tmrDIRECT_NOT_APPLIED )
+			{
+				traceTIMER_COMMAND_RECEIVED( pxTimer, xCommandID, xOptionalValue );
+
+				if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
+				{
+					prvTimerWheelRemove( pxTimer );
+				}
+
+				if( xCommandID != tmrCOMMAND_STOP )
+				{
+					/* The expiry time is after xTimeNow, so after xWheelTime
+					too. */
+					listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+					prvTimerWheelInsert( pxTimer, xExpiryTime );
+
+					if( ( xDaemonBlocked != pdFALSE ) && ( ( portTickType ) ( xExpiryTime - xTimeNow ) < ( portTickType ) ( xDaemonWakeTime - xTimeNow ) ) )
+					{
+						/* The timer service task would unblock too late. */
+						xDaemonBlocked = pdFALSE;
+						xResult = tmrDIRECT_APPLIED_WAKE;
+					}
+				}
+
+				uxDirectTimerCommands++;
+			}
+		}
+
+		if( xResult == tmrDIRECT_NOT_APPLIED )
+		{
+			uxQueuedTimerCommands++;
+		}
+
+		if( xFromISR != pdFALSE )
+		{
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			taskEXIT_CRITICAL();
+		}
+
+		return xResult;
+	}
+
+#endif /* configUSE_TIMER_DIRECT_COMMANDS */
+/*-----------------------------------------------------------*/
+
 static void	prvProcessReceivedCommands( void )
 {
 xTIMER_MESSAGE xMessage;
@@ -522,15 +1289,57 @@ portTickType xTimeNow;
 
 	while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
 	{
-		pxTimer = xMessage.pxTimer;
+		#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+		{
+			/* The message only unblocked this task.  The next expire time is
+			found again before the task next blocks. */
+			if( xMessage.xMessageID == tmrCOMMAND_WAKE )
+			{
+				continue;
+			}
+		}
+		#endif /* configUSE_TIMER_DIRECT_COMMANDS */
+
+		#if ( INCLUDE_xTimerPendFunctionCall == 1 )
+		{
+			/* Negative commands are pended function calls rather than timer
+			commands. */
+			if( xMessage.xMessageID < ( portBASE_TYPE ) 0 )
+			{
+				const xCALLBACK_PARAMETERS * const pxCallback = &( xMessage.u.xCallbackParameters );
+
+				/* The timer uses the xCallbackParameters member to request a
+				callback be executed.  Check the callback is not NULL. */
+				configASSERT( pxCallback );
+
+				/* Call the function. */
+				pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
+				continue;
+			}
+		}
+		#endif /* INCLUDE_xTimerPendFunctionCall */
+
+		pxTimer = xMessage.u.xTimerParameters.pxTimer;
 
 		if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
 		{
 			/* The timer is in a list, remove it. */
-			( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+			#if ( configUSE_TIMER_WHEEL == 1 )
+			{
+				tmrENTER_WHEEL_CRITICAL();
+				{
+					prvTimerWheelRemove( pxTimer );
+				}
+				tmrEXIT_WHEEL_CRITICAL();
+			}
+			#else
+			{
+				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+			}
+			#endif /* configUSE_TIMER_WHEEL */
 		}
 
-		traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.xMessageValue );
+		traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
 
 		/* In this case the xTimerListsWereSwitched parameter is not used, but 
 		it must be present in the function call.  prvSampleTimeNow() must be 
@@ -544,15 +1353,15 @@ portTickType xTimeNow;
 		{
 			case tmrCOMMAND_START :
 				/* Start or restart a timer. */
-				if( prvInsertTimerInActiveList( pxTimer,  xMessage.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.xMessageValue ) == pdTRUE )
+				if( prvInsertTimerInActiveList( pxTimer,  xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) == pdTRUE )
 				{
 					/* The timer expired before it was added to the active timer
 					list.  Process it now. */
-					pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+					tmrEXECUTE_CALLBACK( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks );
 
 					if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
 					{
-						xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xMessage.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
+						xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
 						configASSERT( xResult );
 						( void ) xResult;
 					}
@@ -565,25 +1374,51 @@ portTickType xTimeNow;
 				break;
 
 			case tmrCOMMAND_CHANGE_PERIOD :
-				pxTimer->xTimerPeriodInTicks = xMessage.xMessageValue;
+				pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
 				configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
 				( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
 				break;
 
 			case tmrCOMMAND_DELETE :
+				#if ( INCLUDE_xTimerGetTimerByName == 1 )
+				{
+					prvRemoveTimerName( pxTimer );
+				}
+				#endif /* INCLUDE_xTimerGetTimerByName */
+
 				/* The timer has already been removed from the active list,
-				just free up the memory. */
-				vPortFree( pxTimer );
+				just free up the memory, unless it was provided by the
+				application. */
+				#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+					if( pxTimer->ucStaticallyAllocated == pdFALSE )
+				#endif
+				{
+					vPortFree( pxTimer );
+				}
 				break;
 
 			default	:
 				/* Don't expect to get here. */
 				break;
 		}
+
+		#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+		{
+			/* Commands can be applied directly again once no queued command
+			remains to be applied. */
+			taskENTER_CRITICAL();
+			{
+				uxQueuedTimerCommands--;
+			}
+			taskEXIT_CRITICAL();
+		}
+		#endif /* configUSE_TIMER_DIRECT_COMMANDS */
 	}
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMER_WHEEL == 0 )
+
 static void prvSwitchTimerLists( portTickType xLastTime )
 {
 portTickType xNextExpireTime, xReloadTime;
@@ -609,7 +1444,7 @@ portBASE_TYPE xResult;
 		/* Execute its callback, then send a command to restart the timer if
 		it is an auto-reload timer.  It cannot be restarted here as the lists
 		have not yet been switched. */
-		pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+		tmrEXECUTE_CALLBACK( pxTimer, xNextExpireTime );
 
 		if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
 		{
@@ -639,6 +1474,8 @@ portBASE_TYPE xResult;
 	pxCurrentTimerList = pxOverflowTimerList;
 	pxOverflowTimerList = pxTemp;
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static void prvCheckForValidListAndQueue( void )
@@ -650,11 +1487,41 @@ static void prvCheckForValidListAndQueue( void )
 	{
 		if( xTimerQueue == NULL )
 		{
-			vListInitialise( &xActiveTimerList1 );
-			vListInitialise( &xActiveTimerList2 );
-			pxCurrentTimerList = &xActiveTimerList1;
-			pxOverflowTimerList = &xActiveTimerList2;
-			xTimerQueue = xQueueCreate( ( unsigned portBASE_TYPE ) configTIMER_QUEUE_LENGTH, sizeof( xTIMER_MESSAGE ) );
+			#if ( configUSE_TIMER_WHEEL == 1 )
+			{
+			unsigned portBASE_TYPE uxLevel, uxSlot;
+
+				for( uxLevel = 0U; uxLevel < ( unsigned portBASE_TYPE ) tmrWHEEL_LEVELS; uxLevel++ )
+				{
+					for( uxSlot = 0U; uxSlot < ( unsigned portBASE_TYPE ) configTIMER_WHEEL_SIZE; uxSlot++ )
+					{
+						vListInitialise( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+					}
+				}
+			}
+			#else
+			{
+				vListInitialise( &xActiveTimerList1 );
+				vListInitialise( &xActiveTimerList2 );
+				pxCurrentTimerList = &xActiveTimerList1;
+				pxOverflowTimerList = &xActiveTimerList2;
+			}
+			#endif /* configUSE_TIMER_WHEEL */
+
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				/* The timer queue is created without using the heap, as are
+				the timer service task and the idle task. */
+				PRIVILEGED_DATA static xStaticQueueType xStaticTimerQueue;
+				PRIVILEGED_DATA static unsigned char ucStaticTimerQueueStorage[ configTIMER_QUEUE_LENGTH * sizeof( xTIMER_MESSAGE ) ];
+
+				xTimerQueue = xQueueCreateStatic( ( unsigned portBASE_TYPE ) configTIMER_QUEUE_LENGTH, sizeof( xTIMER_MESSAGE ), ucStaticTimerQueueStorage, &xStaticTimerQueue );
+			}
+			#else
+			{
+				xTimerQueue = xQueueCreate( ( unsigned portBASE_TYPE ) configTIMER_QUEUE_LENGTH, sizeof( xTIMER_MESSAGE ) );
+			}
+			#endif
 		}
 	}
 	taskEXIT_CRITICAL();
@@ -688,6 +1555,209 @@ xTIMER *pxTimer = ( xTIMER * ) xTimer;
 }
 /*-----------------------------------------------------------*/
 
+#if ( INCLUDE_xTimerPendFunctionCall == 1 )
+
+	portBASE_TYPE xTimerPendFunctionCallFromISR( tmrPENDED_FUNCTION xFunctionToPend, void *pvParameter1, unsigned long ulParameter2, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	xTIMER_MESSAGE xMessage;
+	portBASE_TYPE xReturn;
+
+		/* Complete the message with the function parameters and post it to the
+		daemon task. */
+		xMessage.xMessageID = tmrCOMMAND_EXECUTE_CALLBACK;
+		xMessage.u.xCallbackParameters.pxCallbackFunction = xFunctionToPend;
+		xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
+		xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
+
+		xReturn = xQueueSendFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+
+		tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
+
+		return xReturn;
+	}
+
+#endif /* INCLUDE_xTimerPendFunctionCall */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xTimerPendFunctionCall == 1 )
+
+	portBASE_TYPE xTimerPendFunctionCall( tmrPENDED_FUNCTION xFunctionToPend, void *pvParameter1, unsigned long ulParameter2, portTickType xTicksToWait )
+	{
+	xTIMER_MESSAGE xMessage;
+	portBASE_TYPE xReturn;
+
+		/* This function can only be called after a timer has been created or
+		after the scheduler has been started because, until then, the timer
+		queue does not exist. */
+		configASSERT( xTimerQueue );
+
+		/* Complete the message with the function parameters and post it to the
+		daemon task. */
+		xMessage.xMessageID = tmrCOMMAND_EXECUTE_CALLBACK;
+		xMessage.u.xCallbackParameters.pxCallbackFunction = xFunctionToPend;
+		xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
+		xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
+
+		xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+
+		tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
+
+		return xReturn;
+	}
+
+#endif /* INCLUDE_xTimerPendFunctionCall */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMER_HISTOGRAMS == 1 )
+
+	portBASE_TYPE xTimerGetHistogram( xTimerHandle xTimer, xTimerHistogram *pxHistogram )
+	{
+	xTIMER * const pxTimer = ( xTIMER * ) xTimer;
+	unsigned portBASE_TYPE uxSequence;
+
+		configASSERT( xTimer );
+		configASSERT( pxHistogram );
+
+		/* Copy the histograms until the copy was not overlapped by a write.
+		The timer service task writes them from within a critical section, so
+		the sequence number is never seen to be odd on a single core, but the
+		timer service task can preempt the copy. */
+		do
+		{
+			uxSequence = pxTimer->uxHistogramSequence;
+			memcpy( ( void * ) pxHistogram, ( void * ) &( pxTimer->xHistogram ), sizeof( xTimerHistogram ) );
+		} while( ( ( uxSequence & ( unsigned portBASE_TYPE ) 1U ) != 0U ) || ( uxSequence != pxTimer->uxHistogramSequence ) );
+
+		return pdPASS;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTimerClearHistogram( xTimerHandle xTimer )
+	{
+	xTIMER * const pxTimer = ( xTIMER * ) xTimer;
+
+		configASSERT( xTimer );
+
+		taskENTER_CRITICAL();
+		{
+			( pxTimer->uxHistogramSequence )++;
+			memset( ( void * ) &( pxTimer->xHistogram ), 0x00, sizeof( xTimerHistogram ) );
+			( pxTimer->uxHistogramSequence )++;
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvExecuteCallback( xTIMER *pxTimer, portTickType xExpiryTime )
+	{
+	portTickType xTickCount;
+	unsigned long ulTickTimestamp, ulStartTime, ulLatency, ulExecution;
+	unsigned portBASE_TYPE uxLatencyBucket, uxExecutionBucket;
+
+		vTaskGetTickTimestamp( &xTickCount, &ulTickTimestamp );
+		ulStartTime = configTIMER_HISTOGRAM_TIMESTAMP();
+
+		pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+
+		ulExecution = configTIMER_HISTOGRAM_TIMESTAMP() - ulStartTime;
+
+		/* The timer expired on the tick that took the tick count to
+		xExpiryTime.  The time of that tick is found from the time of the
+		latest tick, and the number of ticks in between. */
+		ulLatency = ( ulStartTime - ulTickTimestamp ) + ( ( unsigned long ) ( portTickType ) ( xTickCount - xExpiryTime ) * ( unsigned long ) configTIMER_HISTOGRAM_COUNTS_PER_TICK );
+
+		uxLatencyBucket = prvHistogramBucket( ulLatency );
+		uxExecutionBucket = prvHistogramBucket( ulExecution );
+
+		taskENTER_CRITICAL();
+		{
+			( pxTimer->uxHistogramSequence )++;
+
+			( pxTimer->xHistogram.ulCallbacks )++;
+			( pxTimer->xHistogram.ulLatency[ uxLatencyBucket ] )++;
+			( pxTimer->xHistogram.ulExecution[ uxExecutionBucket ] )++;
+
+			if( ulLatency > pxTimer->xHistogram.ulMaxLatency )
+			{
+				pxTimer->xHistogram.ulMaxLatency = ulLatency;
+			}
+
+			if( ulExecution > pxTimer->xHistogram.ulMaxExecution )
+			{
+				pxTimer->xHistogram.ulMaxExecution = ulExecution;
+			}
+
+			( pxTimer->uxHistogramSequence )++;
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	static unsigned portBASE_TYPE prvHistogramBucket( unsigned long ulTime )
+	{
+	unsigned portBASE_TYPE uxBucket = ( unsigned portBASE_TYPE ) 0U;
+
+		/* The bucket is the number of significant bits in ulTime, limited to
+		the last bucket. */
+		while( ( ulTime != 0UL ) && ( uxBucket < ( ( unsigned portBASE_TYPE ) configTIMER_HISTOGRAM_BUCKETS - ( unsigned portBASE_TYPE ) 1U ) ) )
+		{
+			ulTime >>= 1UL;
+			uxBucket++;
+		}
+
+		return uxBucket;
+	}
+
+#endif /* configUSE_TIMER_HISTOGRAMS */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xTimerGetTimerByName == 1 )
+
+	xTimerHandle xTimerGetTimerByName( const signed char *pcTimerName )
+	{
+	xTIMER *pxTimer;
+
+		configASSERT( pcTimerName );
+
+		/* Timers are only deleted by the timer service task, which cannot run
+		while the scheduler is suspended. */
+		vTaskSuspendAll();
+		{
+			for( pxTimer = pxTimerNameList; pxTimer != NULL; pxTimer = pxTimer->pxNextTimer )
+			{
+				if( ( pxTimer->pcTimerName != NULL ) && ( strcmp( ( const char * ) pxTimer->pcTimerName, ( const char * ) pcTimerName ) == 0 ) )
+				{
+					break;
+				}
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return ( xTimerHandle ) pxTimer;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvRemoveTimerName( xTIMER *pxTimer )
+	{
+	xTIMER **ppxLink;
+
+		vTaskSuspendAll();
+		{
+			for( ppxLink = &pxTimerNameList; *ppxLink != NULL; ppxLink = &( ( *ppxLink )->pxNextTimer ) )
+			{
+				if( *ppxLink == pxTimer )
+				{
+					*ppxLink = pxTimer->pxNextTimer;
+					break;
+				}
+			}
+		}
+		( void ) xTaskResumeAll();
+	}
+
+#endif /* INCLUDE_xTimerGetTimerByName */
+/*-----------------------------------------------------------*/
+
 /* This entire source file will be skipped if the application is not configured
 to include software timer functionality.  If you want to include software timer
 functionality then ensure configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
@@ -82,13 +82,13 @@
  *----------------------------------------------------------*/
 
 #define configUSE_PREEMPTION			1
-#define configUSE_PORT_OPTIMISED_TASK_SELECTION	0   /* Do not use for MPLAB X */
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION	1
 #define configUSE_IDLE_HOOK			1
 #define configUSE_TICK_HOOK			0
 #define configTICK_RATE_HZ			( ( portTickType ) 1000 )
 #define configCPU_CLOCK_HZ			( ( unsigned long ) 80000000UL )  
 #define configPERIPHERAL_CLOCK_HZ		( ( unsigned long ) 10000000UL )
-#define configMAX_PRIORITIES			( ( unsigned portBASE_TYPE ) 5 )
+#define configMAX_PRIORITIES			( 5 )	/* No cast, it is tested by the preprocessor. */
 #define configMINIMAL_STACK_SIZE		( 256 )
 #define configISR_STACK_SIZE			( 512 )
 #define configTOTAL_HEAP_SIZE			( ( size_t ) 28000 )
@@ -96,7 +96,7 @@
 #define configUSE_16_BIT_TICKS			0
 #define configIDLE_SHOULD_YIELD			1
 #define configUSE_MUTEXES			1
-#define configCHECK_FOR_STACK_OVERFLOW          2
+#define configCHECK_FOR_STACK_OVERFLOW          3
 #define configQUEUE_REGISTRY_SIZE		0
 
 /* **************** FreeRTOS V7.5.2 ************ */
@@ -106,6 +106,12 @@
 #define configUSE_COUNTING_SEMAPHORES		0
 /*************************************************/
 
+/* The EEPROM block is passed to the check task by reference. */
+#define configUSE_ZERO_COPY_QUEUES		1
+
+/* The EEPROM mutex runs its holder at a fixed ceiling priority. */
+#define configUSE_CEILING_MUTEXES		1
+
 /* ******************* Cerebot 32MX7cK MPLABX *******************************/
 /* The following definitions are required for generating run time statistics */
     #define configGENERATE_RUN_TIME_STATS	0
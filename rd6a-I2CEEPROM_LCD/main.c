@@ -49,11 +49,14 @@
 
 // #define EEPROM_ADDRESS 	(BYTE) 0x50
 
-/* The priorities of the various application tasks. */
+/* The priorities of the various application tasks.  The data generator runs
+ * below the checker, so the EEPROM ceiling raises it while it writes. */
+#define mainGEN_TASK_PRIORITY	( tskIDLE_PRIORITY + 3 )
 #define mainCHECK_TASK_PRIORITY	( tskIDLE_PRIORITY + 4 )
 
 /* queue to pass counter back and forth */
-xQueueHandle QTask_EEPROM_W2R, QTask_EEPROM_R2W; 	
+xZeroCopyQueueHandle QTask_EEPROM_W2R;
+xQueueHandle QTask_EEPROM_R2W; 	
 xQueueHandle xQ_Button;
 xSemaphoreHandle xLCD_semaphore;    /* Protect access to LCD resource */
 xSemaphoreHandle xI2C_semaphore;    /* Protect access to EEPROM resource */
@@ -87,7 +90,7 @@ unsigned long ulStatus1 = pdPASS;
 /* Beware  - prvCheckTask uses sprintf so could require more stack. */
     ulStatus1 &= xTaskCreate( prvData_Gen, (signed char *) "GEN_DATA",
                               configMINIMAL_STACK_SIZE, NULL,
-                              mainCHECK_TASK_PRIORITY, NULL );
+                              mainGEN_TASK_PRIORITY, NULL );
     ulStatus1 &= xTaskCreate( prvData_Chk, (signed char *) "CHK_DATA",
                               configMINIMAL_STACK_SIZE, NULL,
                               mainCHECK_TASK_PRIORITY, NULL );
@@ -95,15 +98,20 @@ unsigned long ulStatus1 = pdPASS;
                               configMINIMAL_STACK_SIZE, NULL,
                               tskIDLE_PRIORITY, NULL );
 
-/* Semaphores guard access to I2C and LCD */
+/* Semaphores guard access to I2C and LCD. The EEPROM is held for the whole
+ * of a multi-millisecond write, so its mutex is a ceiling mutex: the holder
+ * runs at the priority of the highest priority EEPROM user, CHK_DATA, until
+ * it gives the mutex back.  While GEN_DATA writes, CHK_DATA cannot preempt it
+ * only to block on the mutex, and no task in between can delay the write. */
     xLCD_semaphore = xSemaphoreCreateMutex();
-    xI2C_semaphore = xSemaphoreCreateMutex();
+    xI2C_semaphore = xSemaphoreCreateCeilingMutex(mainCHECK_TASK_PRIORITY);
 
 /* Continue only id semaphores successfully created */
     if(xLCD_semaphore != NULL && xI2C_semaphore != NULL && ulStatus1 == pdPASS )
     {
-/* Create buffer for sending block of data to store in EEPROM */
-        QTask_EEPROM_W2R = xQueueCreate(1, sizeof(EEPROM_packet));
+/* Create buffer for sending block of data to store in EEPROM.  The packet
+ * is filled and checked in place, so it is never copied between tasks. */
+        QTask_EEPROM_W2R = xQueueCreateZeroCopy(1, sizeof(EEPROM_packet));
 
 /* create buffer for LCD message*/
 	QTask_EEPROM_R2W = xQueueCreate(1, LCD_MSG_SIZE);
@@ -137,14 +145,17 @@ unsigned long ulStatus1 = pdPASS;
  *                  LEDH is used for idle task timing only. LEDA is used to time
  *                  the data generation task. LEDB is used Used to time EEPROM
  *                  write operation.
+ *
+ *                  The data is generated directly in a packet slot taken from
+ *                  the zero copy queue. The slot is owned by this task until it
+ *                  is committed to the check task.
   * END DESCRIPTION *****************************************************/
 static void prvData_Gen( void *pvParameters )
 {
 char msg[32]; 
 int signal;
-EEPROM_packet ee_prom;
+EEPROM_packet *ee_prom;
 I2C_RESULT i2c_result = FALSE;
-static char data_set[MEM_BLK_DATA_SIZE];
 int mem_address;
 int i, len;
 unsigned int x;
@@ -158,6 +169,9 @@ unsigned int x;
         PORTSetBits(IOPORT_B, LEDB);
 	len = MEM_BLK_DATA_SIZE;
 
+/* Take an empty packet to build the data set in */
+        ee_prom = (EEPROM_packet *) pvQueueAcquireSlot(QTask_EEPROM_W2R, portMAX_DELAY);
+
 /* Generate random data - Spec 2.c. */
 	srand((unsigned int)ReadCoreTimer());	
 	for(i=0; i< len; i++)
@@ -167,7 +181,7 @@ unsigned int x;
             {
 		x = -x;
             }
-            data_set[i] = (unsigned char) (x % 256);
+            ee_prom->data[i] = (unsigned char) (x % 256);
         }
 
 /* Generate random address - Spec 2.c. */
@@ -181,7 +195,7 @@ unsigned int x;
 /*  Write EEPROM data - Spec 2.f.  */
         PORTClearBits(IOPORT_B, LEDH); /* Used for idle task timing only */
         i2c_result = I2CWrtiteEEPROM(EEPROM_I2C_BUS, EEPROM_ADDRESS,
-                                    mem_address, (BYTE *) data_set, len);
+                                    mem_address, (BYTE *) ee_prom->data, len);
 /* Clear LED C  - Spec 2.g. */
         PORTClearBits(IOPORT_B, LEDC); /* Used to time EEPROM write operation */
 /* Give EEPROM mutes semaphore - Spec 2.h. */
@@ -190,11 +204,10 @@ unsigned int x;
 
 /* Send array data to Data Check task - Spec 2.f. */
 /* Program data structure */
-        ee_prom.mem_addr = mem_address;
-        ee_prom.num_bytes = len;
-        ee_prom.data_ptr = (char *) data_set;
+        ee_prom->mem_addr = mem_address;
+        ee_prom->num_bytes = len;
 /* Send check packet to EEPROM Read task Spec 2.h. */
-        xQueueSend(QTask_EEPROM_W2R, &ee_prom, portMAX_DELAY);
+        xQueueCommitSlot(QTask_EEPROM_W2R, ee_prom);
         PORTClearBits(IOPORT_B, LEDH); /* Used for idle task timing only */
 
 /* Clear LED B  - Spec 2.i. */
@@ -233,19 +246,22 @@ unsigned int x;
  * RETURN VALUE:    None
  * NOTES:           LEDH is used for idle task timing only. LEDC is used to time
  *                  the read memory task.
+ *
+ *                  The packet is checked in the queue slot it was generated
+ *                  in, and the slot is released once the compare is done.
  * END DESCRIPTION *****************************************************/
 static void prvData_Chk( void *pvParameters )
 {
 I2C_RESULT i2c_result = FALSE;
 static BYTE data_rd[MEM_BLK_DATA_SIZE];
-EEPROM_packet ee_prom;
+EEPROM_packet *ee_prom;
 int equal_flag;
 char msg[32], report[10]; 
 
     for( ;; )
     {
 /* Waits for message from data generator - Spec 3.a */
-        xQueueReceive(QTask_EEPROM_W2R, &ee_prom, portMAX_DELAY);
+        ee_prom = (EEPROM_packet *) pvQueueReceiveSlot(QTask_EEPROM_W2R, portMAX_DELAY);
         PORTClearBits(IOPORT_B, LEDH); /* Used for idle task timing only */
 
 /* Turns on LCD D - Spec 3.b. */
@@ -256,7 +272,7 @@ char msg[32], report[10];
         PORTClearBits(IOPORT_B, LEDH); /* Used for idle task timing only */
 
 /* Writes starting address to LCD - Spec 3.d. */
-        sprintf(msg,"\f0X%04x - %5d", ee_prom.mem_addr, ee_prom.num_bytes );
+        sprintf(msg,"\f0X%04x - %5d", ee_prom->mem_addr, ee_prom->num_bytes );
         putsLCD(msg);
 /* Turns off LCD D - Spec 3.e. */
         PORTClearBits(IOPORT_B, LEDD); /* Used for idle task timing only */
@@ -273,8 +289,8 @@ char msg[32], report[10];
         PORTClearBits(IOPORT_B, LEDH); /* Used for idle task timing only */
 
 /* Reads EEPROM data - Spec 3.i. */
-        i2c_result = I2CReadEEPROM(EEPROM_I2C_BUS, EEPROM_ADDRESS,  ee_prom.mem_addr,
-                                    data_rd, ee_prom.num_bytes);
+        i2c_result = I2CReadEEPROM(EEPROM_I2C_BUS, EEPROM_ADDRESS,  ee_prom->mem_addr,
+                                    data_rd, ee_prom->num_bytes);
 /* Gives back EEPRORM mutex semaphore - Spec 3.j. */
         xSemaphoreGive(xI2C_semaphore);
         PORTClearBits(IOPORT_B, LEDH); /* Used for idle task timing only */
@@ -289,12 +305,14 @@ char msg[32], report[10];
         }
         else
         {
-            equal_flag = memcmp(ee_prom.data_ptr, data_rd,  ee_prom.num_bytes);
+            equal_flag = memcmp(ee_prom->data, data_rd,  ee_prom->num_bytes);
             if(equal_flag != 0)
                 sprintf(report,"FAILED");
             else
                 sprintf(report,"PASSED");
         }
+/* Return the packet so the next data set can be generated in it */
+        vQueueReleaseSlot(QTask_EEPROM_W2R, ee_prom);
 /* Turns on LED D - Spec 3.m. */
         PORTSetBits(IOPORT_B, LEDD);  /* LEDD is used to time the LCD write */
 
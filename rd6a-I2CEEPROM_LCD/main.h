@@ -26,7 +26,7 @@
     {
         unsigned int mem_addr;
         unsigned int num_bytes;
-        char *data_ptr;         /* A pointer to the string to be displayed. */
+        char data[MEM_BLK_DATA_SIZE];   /* The block written to the EEPROM. */
     } EEPROM_packet;
 #endif
 
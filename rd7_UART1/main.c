@@ -31,6 +31,7 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
+#include "message_buffer.h"
 #include "semphr.h"
 
 /* Files to support Application  */
@@ -79,9 +79,9 @@
     #define UART_Q_LEN	120
 
 /* Global variables are declared only once. */
-/* Global queues for  sending and receiving UART text strings. */
-    xQueueHandle xLineForTx;
-    xQueueHandle xLineForRx;
+/* Global message buffers for sending and receiving UART text strings. */
+    xMessageBufferHandle xLineForTx;
+    xMessageBufferHandle xLineForRx;
 
 #endif
 
@@ -93,4 +93,7 @@ portBASE_TYPE uCreateUARTTasks( unsigned portBASE_TYPE uxPriority,
 void vSerialGetLineTask( void *pvParameters  );
 void vSerialLineSendTask( void *pvParameters );
 
+/* Send a text string to the UART from any task */
+portBASE_TYPE xSerialPutLine( const char *pcLine, portTickType xTicksToWait );
+
 /* End of serial.h */
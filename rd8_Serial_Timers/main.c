@@ -42,6 +42,7 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
+#include "message_buffer.h"
 #include "timers.h"
 
 /* Files to support Application  */
@@ -126,7 +127,7 @@ unsigned long tick;
     PORTToggleBits(IOPORT_G, LED1);     /* Toggle LED1 on chipKIT board */
     tick = xTaskGetTickCount();
     sprintf(TxMsg,"vRegTest1 %ld \n\r", tick);
-    xQueueSend( xLineForTx, TxMsg, 0);
+    xSerialPutLine( TxMsg, 0 );
 } /* End of prvReportTicks */
 
 /* prvTestTask2 Function Description ***************************************
@@ -24,6 +24,9 @@
 #include "FreeRTOS.h"
 #include "queue.h"
 #include "task.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
 
 /* Application include files. */
 #include "serial.h"
@@ -32,9 +35,26 @@
 #define serSET_FLAG     ( 1 )
 #define serCLR_FLAG     ( 0 )
 
-/* The queues used to communicate between UART Line tasks and ISR's. */
-static xQueueHandle xRxedChars; 
-static xQueueHandle xTxedChars; 
+/* Receive stream buffer settings. The receive task is woken when
+ * serRX_TRIGGER_LEVEL characters or a CR have been received, rather than for
+ * every character. The block time collects lines that do not end in CR. */
+#define serRX_TRIGGER_LEVEL ( 16 )
+#define serRX_BLOCK_TIME    ( 20 / portTICK_RATE_MS )
+#define serRX_FIFO_DEPTH    ( 8 )   /* Size of the UART receive FIFO */
+
+/* The stream buffers used to communicate between UART Line tasks and ISR's.
+ * Each has one writer and one reader, so characters are passed without
+ * locking a queue for every character. */
+static xStreamBufferHandle xRxedChars;
+static xStreamBufferHandle xTxedChars;
+
+/* Size of the message buffer that passes lines to the send task. Each line
+ * uses only its own length plus a length field, so several short lines fit
+ * where a queue would reserve UART_Q_LEN characters for each. */
+#define serLINE_BUFFER_SIZE ( 2 * UART_Q_LEN )
+
+/* Serialises the tasks that write lines to xLineForTx. */
+static xSemaphoreHandle xLineForTxMutex;
 
 static xComPortHandle xSerialPortInit( unsigned long ulWantedBaud,
                                         unsigned portBASE_TYPE uxQueueLength );
@@ -91,21 +111,20 @@ xComPortHandle xSerialPortInit( unsigned long ulWantedBaud,
 unsigned short usBRG;	/* Constant determine by BAUD rate */
 
 /* Create the queues used by Send and Received tasks */
-/* Queue to pass characters from UART interrupt handler to the receive line
- * task - UART_Q_LEN x 1 char*/
-    xRxedChars = xQueueCreate( uxQueueLength*sizeof( signed char ),
-                        ( unsigned portBASE_TYPE ) sizeof( signed char ) );
-
-/* Queue to pass characters string characters form send taskto UART
- * interrupt handler - UART_Q_LEN  x 1 char */
+/* Stream buffer to pass characters from UART interrupt handler to the receive
+ * line task - UART_Q_LEN chars. A CR wakes the receive task immediately. */
+    xRxedChars = xStreamBufferCreate( uxQueueLength*sizeof( signed char ),
+                                        serRX_TRIGGER_LEVEL );
+    vStreamBufferSetTerminator( xRxedChars, '\r' );
 
-    xTxedChars = xQueueCreate( (UART_Q_LEN*sizeof( signed char )+1),
-                        ( unsigned portBASE_TYPE ) sizeof( signed char ) );
+/* Stream buffer to pass string characters form send task to UART
+ * interrupt handler - UART_Q_LEN chars plus a RETURN */
+    xTxedChars = xStreamBufferCreate( (UART_Q_LEN*sizeof( signed char )+1), 1 );
 
-/* Queue to pass characters from receive line task to the send task -
- * 1 X UART_Q_LEN chars */
-    xLineForTx = xQueueCreate( sizeof( signed char ),
-                ( unsigned portBASE_TYPE ) UART_Q_LEN*sizeof( signed char ) );
+/* Message buffer to pass lines from the receive line task, and other tasks,
+ * to the send task - serLINE_BUFFER_SIZE chars including length fields */
+    xLineForTx = xMessageBufferCreate( serLINE_BUFFER_SIZE );
+    xLineForTxMutex = xSemaphoreCreateMutex();
 
 /* Configure the UART and interrupts. */
     usBRG = (unsigned short)(( (float)configPERIPHERAL_CLOCK_HZ / ( (float)4 \
@@ -123,6 +142,46 @@ unsigned short usBRG;	/* Constant determine by BAUD rate */
     return NULL;
 } /* End of xSerialPortInitMinimal */
 
+/* xSerialPutLine Function Description ****************************************
+ * SYNTAX:          portBASE_TYPE xSerialPutLine( const char *pcLine,
+ *                                              portTickType xTicksToWait );
+ * KEYWORDS:        UART, serial, communications, send, line
+ * DESCRIPTION:     Passes a null terminated text string to the line send
+ *                  task. Only the characters of the string are copied into
+ *                  the xLineForTx message buffer, not all UART_Q_LEN characters
+ *                  as a queue item would.
+ * PARAMETER 1:     pointer to the null terminated text string
+ * PARAMETER 2:     maximum time to wait for the message buffer, in ticks
+ * RETURN VALUE:    pdPASS if the string was passed, pdFAIL if timed out
+ * NOTES:           A message buffer must only have one writer at a time, so
+ *                  writers are serialised by a mutex. This function can be
+ *                  called from any task but not from an ISR. Strings longer
+ *                  than UART_Q_LEN characters are truncated.
+ * END DESCRIPTION ***********************************************************/
+portBASE_TYPE xSerialPutLine( const char *pcLine, portTickType xTicksToWait )
+{
+size_t xLength;
+portBASE_TYPE xReturn = pdFAIL;
+
+    xLength = strlen( pcLine );
+    if( xLength > UART_Q_LEN )
+    {
+        xLength = UART_Q_LEN;
+    }
+
+    if( xSemaphoreTake( xLineForTxMutex, xTicksToWait ) == pdPASS )
+    {
+        if( xMessageBufferSend( xLineForTx, pcLine, xLength,
+                                xTicksToWait ) == xLength )
+        {
+            xReturn = pdPASS;
+        }
+        xSemaphoreGive( xLineForTxMutex );
+    }
+
+    return xReturn;
+} /* End of xSerialPutLine */
+
 /* vSerialGetLineTask Function Description ***********************************
  * SYNTAX:      void vSerialGetLineTask( void *pvParameters  );
  * KEYWORDS:    UART, serial, text, communications, receive, task
@@ -149,34 +208,42 @@ void vSerialGetLineTask( void *pvParameters  )
 ( void ) pvParameters;
 char Rx_Message[UART_Q_LEN]; 	// Line queue buffer
 int Rx_Msg_idx;					// String array index.
+char Rx_Chars[serRX_TRIGGER_LEVEL];  /* Characters from the ISR */
+size_t Rx_Count, Rx_Idx;
 
     strcpy(Rx_Message,"\n\rUART test ready to receive text.\n\r");
-    xQueueSend( xLineForTx, Rx_Message, portMAX_DELAY );
+    xSerialPutLine( Rx_Message, portMAX_DELAY );
 
     Rx_Msg_idx = 0;
-/* Get the next character from the buffer.  Return false if no characters
- * are available or arrive before xBlockTime expires. */
     for(;;)
     {
-        xQueueReceive( xRxedChars, &Rx_Message[Rx_Msg_idx], portMAX_DELAY );
-        if(Rx_Message[Rx_Msg_idx] == '\r' ||
-            Rx_Message[Rx_Msg_idx]== '\n' ||
-            Rx_Msg_idx == UART_Q_LEN-1 )
-	{  /* Complete line received */
-            if(UART_Q_LEN > Rx_Msg_idx + 3) /* Add CR and LF is buffer space */
+/* Wait for characters from the UART interrupt handler. The task is woken
+ * when serRX_TRIGGER_LEVEL characters or a CR have been received, or the
+ * block time expires. */
+        Rx_Count = xStreamBufferReceive( xRxedChars, Rx_Chars,
+                                        sizeof( Rx_Chars ), serRX_BLOCK_TIME );
+
+        for( Rx_Idx = 0; Rx_Idx < Rx_Count; Rx_Idx++ )
+        {
+            Rx_Message[Rx_Msg_idx] = Rx_Chars[Rx_Idx];
+            if(Rx_Message[Rx_Msg_idx] == '\r' ||
+                Rx_Message[Rx_Msg_idx]== '\n' ||
+                Rx_Msg_idx == UART_Q_LEN-1 )
+            {  /* Complete line received */
+                if(UART_Q_LEN > Rx_Msg_idx + 3) /* Add CR and LF is buffer space */
+                {
+                    Rx_Message[Rx_Msg_idx++] = '\n';    /* Add LF to string  */
+                    Rx_Message[Rx_Msg_idx++] = '\r';    /* Add CR to string  */
+                }
+                Rx_Message[Rx_Msg_idx] = 0; /* Add null termination */
+                Rx_Msg_idx = 0;             /* Reset string index */
+/* Send message to line send task */
+                xSerialPutLine( Rx_Message, portMAX_DELAY );
+            }
+            else
             {
-                Rx_Message[Rx_Msg_idx++] = '\n'; /* Add LF to string  */
-                Rx_Message[Rx_Msg_idx++] = '\r'; /* Add CR to string  */
+                Rx_Msg_idx++;               /* Advance string index */
             }
-            Rx_Message[Rx_Msg_idx] = 0; /* Add null termination */
-            Rx_Msg_idx = 0;		/* Reset string index */
-/* Send message to line send task */
-//          xQueueSend( xLineForTx, &Rx_Message[Rx_Msg_idx], portMAX_DELAY );
-            xQueueSend( xLineForTx, Rx_Message, portMAX_DELAY );
-        }
-        else
-        {
-            Rx_Msg_idx++; 	/* Advance string index */
         }
     }
 } /* End of vSerialGetLineTask */
@@ -185,9 +252,9 @@ int Rx_Msg_idx;					// String array index.
  * SYNTAX:          void vSerialLineSendTask( void *pvParameters );
  * KEYWORDS:        UART, serial, communications, send, task
  * DESCRIPTION:     This task receives a string of text and or ASCII
- *                  control characters and fills a single character queue,
- *                  xTxedChars, that has a depth of UART_Q_LEN and a width of 1.
- *                  After this [UART_Q_LEN x 1] queue has been filled,
+ *                  control characters and copies it to the stream buffer
+ *                  xTxedChars, that holds UART_Q_LEN characters plus a RETURN.
+ *                  After the string has been copied,
  *                  the UART transmit interrupt is enabled and the interrupt
  *                  flag is set to initiate the first transmit interrupt. The
  *                  UART interrupt takes the characters one at a time off
@@ -209,17 +276,13 @@ char CR = '\r';
 
     for(;;)
     {
-/* Wait for message */
-        xQueueReceive( xLineForTx, &Tx_Message, portMAX_DELAY );
-        Tx_Msg_idx = 0;		/* Initialize transmit index */
+/* Wait for message. Only the characters of the line are copied. */
+        Tx_Msg_idx = xMessageBufferReceive( xLineForTx, Tx_Message,
+                                        sizeof( Tx_Message ), portMAX_DELAY );
 
-/* Fill queue with characters until end of string or maximum queue width */
-        while(Tx_Message[Tx_Msg_idx] && (Tx_Msg_idx < UART_Q_LEN) )
-        {
-            xQueueSend( xTxedChars, &Tx_Message[Tx_Msg_idx], portMAX_DELAY );
-            Tx_Msg_idx++;
-        }
-        xQueueSend( xTxedChars, &CR, portMAX_DELAY ); /* Add RETURN to queue */
+/* Copy the string to the stream buffer in one call, then add a RETURN */
+        xStreamBufferSend( xTxedChars, Tx_Message, Tx_Msg_idx, portMAX_DELAY );
+        xStreamBufferSend( xTxedChars, &CR, 1, portMAX_DELAY );
 
         if( xTxHasEnded )			/* Start transmit interrupts */
         {
@@ -236,13 +299,13 @@ char CR = '\r';
  * KEYWORDS:        UART, serial, communications, interrupt handler
  * DESCRIPTION:     This function is the single UART ISR that handles
  *                  both transmit and receive interrupts.  If a character is
- *                  received, it is immediately send using a queue to the
- *                  that task that assembles the characters into a text string.
+ *                  received, it is immediately send using a stream buffer to
+ *                  the task that assembles the characters into a text string.
  *                  If a Tx interrupt is generated, the Tx buffer status is
  *                  checked.if found to be full, the Tx interrupt flag is
- *                  cleared. If Tx buffer is empty, the queue is check for a
- *                  character waiting to be sent.  If no character is waiting
- *                  in the queue, the Tx interrupts are disabled and the Tx
+ *                  cleared. If Tx buffer is empty, the stream buffer is check
+ *                  for a character waiting to be sent.  If no character is
+ *                  waiting, the Tx interrupts are disabled and the Tx
  *                  interrupt flag is cleared.
  * PARAMETERS:      None
  * RETURN VALUE:    None
@@ -252,6 +315,8 @@ char CR = '\r';
 void __ISR(_UART_1_VECTOR, ipl2) vU1InterruptHandler(void)
 {
 static char cChar;
+static char cRxChars[serRX_FIFO_DEPTH];
+static unsigned char ucRxCount;
 static portBASE_TYPE xHigherPriorityTaskWoken;
 
     xHigherPriorityTaskWoken = pdFALSE;	/* No higher priority tasks */
@@ -259,13 +324,17 @@ static portBASE_TYPE xHigherPriorityTaskWoken;
 /* Are any Rx interrupts pending? */
     if( mU1RXGetIntFlag() )
     {
+/* Empty the receive FIFO, then pass the characters to the receive task with
+ * a single write to the stream buffer. */
         while( U1STAbits.URXDA )
         {
-/* Retrieve the received character and place it in the queue of
- * received characters. */
-	
-            cChar = U1RXREG;
-            xQueueSendFromISR( xRxedChars, &cChar, &xHigherPriorityTaskWoken );
+            ucRxCount = 0;
+            while( U1STAbits.URXDA && ( ucRxCount < serRX_FIFO_DEPTH ) )
+            {
+                cRxChars[ucRxCount++] = U1RXREG;
+            }
+            xStreamBufferSendFromISR( xRxedChars, cRxChars, ucRxCount,
+                                        &xHigherPriorityTaskWoken );
         }
         mU1RXClearIntFlag();
     }
@@ -275,15 +344,15 @@ static portBASE_TYPE xHigherPriorityTaskWoken;
     {
         while( !( U1STAbits.UTXBF ) )
         {
-            if( xQueueReceiveFromISR( xTxedChars, &cChar,
-                                  &xHigherPriorityTaskWoken ) == pdTRUE )
+            if( xStreamBufferReceiveFromISR( xTxedChars, &cChar, 1,
+                                  &xHigherPriorityTaskWoken ) == 1 )
             {
 /* Send the next character queued for Tx. */
                 U1TXREG = cChar;
             }
             else
             {
-/* Queue empty, nothing to send. */
+/* Stream buffer empty, nothing to send. */
                 DisableIntU1TX;		/* Disable interrupts */
                 xTxHasEnded = pdTRUE;	/*Flag signals that Tx interrupts must
                                          * be enabled */
@@ -82,13 +82,13 @@
  *----------------------------------------------------------*/
 
 #define configUSE_PREEMPTION			1
-#define configUSE_PORT_OPTIMISED_TASK_SELECTION	0   /* Do not use for MPLAB X */
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION	1
 #define configUSE_IDLE_HOOK			1
 #define configUSE_TICK_HOOK			0
 #define configTICK_RATE_HZ			( ( portTickType ) 1000 )
 #define configCPU_CLOCK_HZ			( ( unsigned long ) 80000000UL )  
 #define configPERIPHERAL_CLOCK_HZ		( ( unsigned long ) 10000000UL )
-#define configMAX_PRIORITIES			( ( unsigned portBASE_TYPE ) 5 )
+#define configMAX_PRIORITIES			( 5 )	/* No cast, it is tested by the preprocessor. */
 #define configMINIMAL_STACK_SIZE		( 256 )
 #define configISR_STACK_SIZE			( 512 )
 #define configTOTAL_HEAP_SIZE			( ( size_t ) 28000 )
@@ -96,7 +96,7 @@
 #define configUSE_16_BIT_TICKS			0
 #define configIDLE_SHOULD_YIELD			1
 #define configUSE_MUTEXES			1
-#define configCHECK_FOR_STACK_OVERFLOW          2
+#define configCHECK_FOR_STACK_OVERFLOW          3
 #define configQUEUE_REGISTRY_SIZE		0
 
 /* **************** FreeRTOS V7.5.2 ************ */
@@ -133,6 +133,25 @@
 #define configTIMER_TASK_STACK_DEPTH	( configMINIMAL_STACK_SIZE * 2 )
 /*************************************************/
 
+/* Step the motor from a high resolution timer, so the step period is not
+limited to whole ticks.  The timer uses Timer 2/3 and output compare 1, so the
+OC1 pin (RD0) must be left free. */
+#define configUSE_HR_TIMERS				1
+
+/* When configUSE_HR_TIMERS is 0 the motor is stepped from a software timer.
+Change its period without a round trip through the timer service task each
+time the motor speed changes. */
+#define configUSE_TIMER_WHEEL			1
+#define configUSE_TIMER_DIRECT_COMMANDS	1
+
+/* Record how late, and for how long, the software timer callbacks execute, so
+the smoothness of the stepping can be checked when configUSE_HR_TIMERS is 0.
+The times are in counts of the 40 MHz core timer, so 24 buckets are needed to
+reach beyond a 1ms tick. */
+#define configUSE_TIMER_HISTOGRAMS		1
+#define configTIMER_HISTOGRAM_BUCKETS	24
+#define configTIMER_HISTOGRAM_TIMESTAMP()	( ( unsigned long ) _CP0_GET_COUNT() )
+#define configTIMER_HISTOGRAM_COUNTS_PER_TICK	( configCPU_CLOCK_HZ / 2UL / configTICK_RATE_HZ )
 
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
@@ -144,6 +163,7 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelayUntil			1
 #define INCLUDE_vTaskDelay			1
 #define INCLUDE_uxTaskGetStackHighWaterMark	1
+#define INCLUDE_xTimerGetTimerByName		1
 
 
 /* **************** FreeRTOS V7.5.2 ************ */
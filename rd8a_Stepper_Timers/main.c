@@ -63,11 +63,11 @@ portBASE_TYPE pdStatus1 = pdPASS;
                             configMINIMAL_STACK_SIZE,
                             NULL, tskIDLE_PRIORITY, NULL );
 
- /* Starting the stepper motor task will assign the queue handle for sending
-  * motor operating parameters the the stepper motor control task. The
-  * returned status indicates the success or failure of creating the stepper
-  * motor task and the queue. */
-    pdStatus1 &= xStartSTEPPERTask(&smQueueHandle);
+ /* Start the stepper motor task and its timer. Motor operating parameters
+  * are sent to the task using vSendSTEPPERParams. The returned status
+  * indicates the success or failure of creating the stepper motor task and
+  * the timer. */
+    pdStatus1 &= xStartSTEPPERTask();
 
     if(pdStatus1 == pdPASS)
     {
@@ -111,7 +111,7 @@ xSTEPPER_PARAMS sm_params;
                         &sm_params.Stepper_Direction);
 
 /* Update stepper motor operating mode and direction */
-        xQueueSend(smQueueHandle, &sm_params, portMAX_DELAY);
+        vSendSTEPPERParams(&sm_params);
 
 /* CLear button Change Notice flag */
         INTClearFlag(INT_CN);
@@ -125,7 +125,7 @@ xSTEPPER_PARAMS sm_params;
  * DESCRIPTION: Assigns state inputs for stepper motor control
  * Parameter 1: Button inputs
  * Parameter 2: Stepping mode variable pointer --> Full Step==2 or Half Step==1
- * Parameter 3: Stepping rate variable pointer --> Period in ms to delay for
+ * Parameter 3: Stepping rate variable pointer --> Period in us to delay for
  *                                                 making a step.
  * Parameter 4:	Stepping direction variable pointer -->Either CW==+1 or CCW==-1
  * RETURN VALUE:  none
@@ -136,22 +136,22 @@ static void decode_buttons(int switch_state, int *mode,
     switch(switch_state)    // Decode switch state
     {
         case (!BTN2 & !BTN1):
-            *period = MSperREV_HS/5/2;	// Full step, CW, 5 RPM
+            *period = USperREV_HS/5/2;	// Full step, CW, 5 RPM
             *mode = FULLSTEP;
             *direction = CW;
             break;
       	case BTN2:              
-            *period = MSperREV_HS/10;  // Half step, CCW, 10 RPM
+            *period = USperREV_HS/10;  // Half step, CCW, 10 RPM
             *mode = HALFSTEP;
             *direction = CW;
             break;
       	case BTN1:				
-            *period = MSperREV_HS/20;  	// Half step, CCW, 2 RPM
+            *period = USperREV_HS/20;  	// Half step, CCW, 2 RPM
             *mode = FULLSTEP;
             *direction = CCW;
             break;
       	case (BTN1 | BTN2):		
-            *period = MSperREV_HS/10/2;  // Full step, CW, 10 RPM -
+            *period = USperREV_HS/10/2;  // Full step, CW, 10 RPM -
             *mode = FULLSTEP;
             *direction = CCW;
             break;
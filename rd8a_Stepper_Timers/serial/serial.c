@@ -29,6 +29,7 @@ an example of an efficient driver. */
 #define serCLR_FLAG						( 0 )
 
 #define UART_Q_LEN			80
+#define serRX_FIFO_DEPTH	( 8 )	// Size of the UART receive FIFO
 
 /* The queues used to communicate between tasks and ISR's. */
 static xQueueHandle xRxedChars; 
@@ -172,6 +173,8 @@ SYNTAX:			void xSerialLineSendTask( void *pvParameters );
 KEYWORDS:		UART, serial, communications, send, task
 DESCRIPTION:	This task recieves a string of text ond or ASCII
 				control characters and fills a single character queue.
+				The characters of the string and a RETURN are posted with
+				one call to xQueueSendMultiple().
 				After the queue has been filled, the UART transmit interrupt
 				is enabled and the interrupt flag is set in initiate
 				transmit interrupts.
@@ -183,9 +186,8 @@ END DESCRIPTION *****************************************************/
 void xSerialLineSendTask( void *pvParameters )
 {
 ( void ) pvParameters;
-char Tx_Message[UART_Q_LEN];	// Line queue buffer
+char Tx_Message[UART_Q_LEN+1];	// Line queue buffer plus RETURN
 int Tx_Msg_idx; 				// String array index.
-char CR = '\r';
 
 	for(;;)
 	{
@@ -193,13 +195,15 @@ char CR = '\r';
 		xQueueReceive( xLineForTx, &Tx_Message, portMAX_DELAY );
 		Tx_Msg_idx = 0;		// Initialize transmit index
 
-// Fill queue with characters until end of string or maximum queue width
-		while(Tx_Message[Tx_Msg_idx] && (Tx_Msg_idx < UART_Q_LEN) )	
+// Find the end of string or maximum queue width
+		while( (Tx_Msg_idx < UART_Q_LEN) && Tx_Message[Tx_Msg_idx] )
 		{
-			xQueueSend( xTxedChars, &Tx_Message[Tx_Msg_idx], portMAX_DELAY );
 			Tx_Msg_idx++;
 		}
-		xQueueSend( xTxedChars, &CR, portMAX_DELAY );	// Add RETURN to queue
+		Tx_Message[Tx_Msg_idx++] = '\r';		// Add RETURN to the string
+
+// Fill queue with the characters and the RETURN in one batch
+		xQueueSendMultiple( xTxedChars, Tx_Message, Tx_Msg_idx, portMAX_DELAY );
 
 		if( xTxHasEnded )				// Start transmit interrupts
 		{
@@ -215,9 +219,10 @@ vU1InterruptHandler
 SYNTAX:			void vU1InterruptHandler( void );
 KEYWORDS:		UART, serial, communications, interrupt handler
 DESCRIPTION:	This function is the single UART ISR that handles
-				both transmit and receive interrupts.  If a character is
-				received, it is immediately send using a queue to the
-				that task that assembles the characters into a text string.
+				both transmit and receive interrupts.  If characters are
+				received, the receive FIFO is emptied and the characters
+				are sent with one call to xQueueSendMultipleFromISR() to
+				the task that assembles the characters into a text string.
 				If a Tx interrupt is generated, the Tx buffer status is checked.
 				if found to be full, the Tx interrupt flag is cleared. If 
 				Tx buffer is empty, the queue is check for a character 
@@ -231,6 +236,8 @@ END DESCRIPTION *****************************************************/
 void vU1InterruptHandler( void )
 {
 static char cChar;
+static char cRxChars[serRX_FIFO_DEPTH];
+static unsigned char ucRxCount;
 static portBASE_TYPE xHigherPriorityTaskWoken;
 
 	xHigherPriorityTaskWoken = pdFALSE;	// No higher priority tasks
@@ -241,10 +248,14 @@ static portBASE_TYPE xHigherPriorityTaskWoken;
 
 		while( U1STAbits.URXDA )
 		{
-			// Retrieve the received character and place it in 
-			// the queue of received characters. 
-			cChar = U1RXREG;
-			xQueueSendFromISR( xRxedChars, &cChar, &xHigherPriorityTaskWoken );
+			// Empty the receive FIFO, then place the characters in
+			// the queue of received characters with a single post.
+			ucRxCount = 0;
+			while( U1STAbits.URXDA && ( ucRxCount < serRX_FIFO_DEPTH ) )
+			{
+				cRxChars[ucRxCount++] = U1RXREG;
+			}
+			xQueueSendMultipleFromISR( xRxedChars, cRxChars, ucRxCount, &xHigherPriorityTaskWoken );
 		}
 		mU1RXClearIntFlag();
 	}
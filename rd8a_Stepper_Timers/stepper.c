@@ -13,6 +13,25 @@
  *
  *              The stepper motor step interval is changes using the
  *              xTimerChangePeriod statement in the prvStepperStep task.
+ *              configUSE_TIMER_DIRECT_COMMANDS lets that change be
+ *              applied to the running timer from within a short critical
+ *              section, rather than queued for the timer service task.
+ *
+ *              The timer callback and the buttons task signal the step
+ *              task with direct to task notifications rather than a
+ *              binary semaphore and a one item queue.  Each event sets
+ *              its own bit in the step task's notification value, and
+ *              the motor parameters are passed through a shared
+ *              variable, so no queue storage or copying is needed.
+ *
+ *              When configUSE_HR_TIMERS is 1 the step is instead taken
+ *              directly by the callback of a high resolution timer,
+ *              from the compare interrupt.  The step period is then set
+ *              to the microsecond rather than rounded to whole ticks, so
+ *              the motor can be stepped faster than 1 kHz, and a step is
+ *              not delayed by the tasks.  The step task only applies new
+ *              parameters, using xHRTimerChangePeriod, which measures the
+ *              new period from the last step.
  * 
  *****************************************************************************/
 
@@ -22,57 +41,81 @@
 /* FreeRTOS included files */
 #include "FreeRTOS.h"
 #include "task.h"
-#include "queue.h"
-#include "semphr.h"
 #include "timers.h"
+#if ( configUSE_HR_TIMERS == 1 )
+    #include "hrtimers.h"
+#endif
 
 /* Reference design included files */
 #include "chipKIT_Pro_MX7.h"
 #include "stepper.h"
 
+/* Notification bits sent to the stepper motor step task */
+#define SM_TAKE_STEP    0x01UL  /* Timer signal to take a step */
+#define SM_NEW_PARAMS   0x02UL  /* sm_new_params has been updated */
+
 /* Communications between tasks within this file */
-static xSemaphoreHandle take_step;  /* Timer signal to take a step */
+static xTaskHandle StepHandle;      /* Step task - receives notifications */
+#if ( configUSE_HR_TIMERS == 1 )
+static xHRTimerHandle T1Handle;     /* High resolution timer handle */
+#else
 static xTimerHandle T1Handle;       /* Timer handle */
+#endif
+static xSTEPPER_PARAMS sm_new_params;   /* Latest parameters from buttons */
+static xSTEPPER_PARAMS sm_params;   /* Parameters used to take each step */
 
 /* Timer function to initiate a motor step */
+#if ( configUSE_HR_TIMERS == 1 )
+static void vStepperCallBack(xHRTimerHandle T1Handle);
+#else
 static void vStepperCallBack(xTimerHandle T1Handle);
+#endif
 
 /* Moves the motor a single step  */
 static void prvStepperStep(void * data);
 
+/* Writes the next step code to the motor */
+static void prvTakeStep(void);
+
 /* xStartSTEPPERTask Function Description ************************************
- * SYNTAX:      xQueueHandle xStartSTEPPERTask( void );
- * KEYWORDS:    Stepper Motor, Queue, semaphore
- * DESCRIPTION: Creates the stepper motor step task, a queue for
- *              communicating parameters to the stepper motor step
- *              task, and a binary semaphore for indicating when to
- *              take a step. The timer task is also created and 
- *              started by this function.
+ * SYNTAX:      portBASE_TYPE xStartSTEPPERTask( void );
+ * KEYWORDS:    Stepper Motor, task notification
+ * DESCRIPTION: Creates the stepper motor step task. The task is
+ *              signaled to take a step, and sent new operating
+ *              parameters, using task notifications. The timer task
+ *              is also created and started by this function.
  * PARAMETERS:	None
- * RETURN VALUE: QueueHandle
+ * RETURN VALUE: pdPASS if the task and timer were created
  * NOTES:       None
  * END DESCRIPTION *****************************************************/
-portBASE_TYPE xStartSTEPPERTask( xQueueHandle *qHandle  )
+portBASE_TYPE xStartSTEPPERTask( void )
 {
 portBASE_TYPE pdStatus = pdPASS;
 long timer_id = 100; 	/* This parameter identified the timer that initiates
                          * the callback */
 
-/* This queue communicate the stepper motor parameters from the read buttons
- * task to the stepper task */
-    *qHandle = xQueueCreate( 1, sizeof( xSTEPPER_PARAMS ));
-
-/* This semiphore indicates when it is time to take a step */
-    vSemaphoreCreateBinary( take_step);
+/* Initial SM settings until a button is pressed the first time */
+    sm_new_params.Stepper_period = RPM_15;
+    sm_new_params.Stepper_Direction = 1;
+    sm_new_params.Stepper_Mode = 1;
 
 /* Sets Port B for stepper motor outputs */
     PORTSetPinsDigitalOut(IOPORT_B, SM_COILS);
     PORTClearBits(IOPORT_B, SM_COILS);
 
-/* Add the stepper motor task to the scheduler */
+/* Add the stepper motor task to the scheduler. The handle is needed to
+ * send notifications to the task. */
     pdStatus &= xTaskCreate( prvStepperStep, ( signed char * ) "STEPPER",
-                configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 3, NULL );
-
+                configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 3,
+                &StepHandle );
+
+#if ( configUSE_HR_TIMERS == 1 )
+/* Create a high resolution timer whose callback takes the step from the
+ * compare interrupt. The step task starts it at the initial step rate. */
+    T1Handle = xHRTimerCreate((const signed char *) "TIMER1",
+                            vStepperCallBack, &timer_id, pdFALSE);
+    pdStatus &= (T1Handle != NULL);
+#else
 /* Creat a timer handle for the 1ms interval callback function */
     T1Handle = xTimerCreate((const signed char *) "TIMER1",
                             (portTickType) (1000/ portTICK_RATE_MS) ,
@@ -81,51 +124,94 @@ long timer_id = 100; 	/* This parameter identified the timer that initiates
 
 /* Start this timer */
     pdStatus &= xTimerStart(T1Handle, 0);
+#endif
 
     return pdStatus;    /* Return the initialization success status */
 } /************************ End of xStartSTEPPERTask ***********************/
 
+/* vSendSTEPPERParams FUNCTION DESCRIPTION ***********************************
+ * SYNTAX:          void vSendSTEPPERParams( const xSTEPPER_PARAMS *params );
+ * KEYWORDS:        Stepper motor parameters, task notification
+ * DESCRIPTION:     Passes new operating parameters to the stepper motor step
+ *                  task. The parameters are copied to a shared variable and
+ *                  the step task is notified that they have changed. The
+ *                  step task applies them as soon as it runs.
+ * PARAMETER 1:     pointer to the new stepper motor parameters
+ * RETURN VALUE:    None
+ * NOTES:           Only the latest parameters are kept.
+ * END DESCRIPTION **********************************************************/
+void vSendSTEPPERParams( const xSTEPPER_PARAMS *params )
+{
+    taskENTER_CRITICAL();
+    sm_new_params = *params;
+    taskEXIT_CRITICAL();
+
+    xTaskNotify(StepHandle, SM_NEW_PARAMS, eSetBits);
+} /************************ End of vSendSTEPPERParams ***********************/
+
 /* prvStepperStep FUNCTION DESCRIPTION ***************************************
  * SYNTAX:          static void prvStepperStep( void *pdata );
  * KEYWORDS:        Stepper motor step task
- * DESCRIPTION:     This task is blocked by a binary semaphore that is given in
- *                  the vStepperCallBack function. This task also checks if the
- *                  queue from the buttons task is updating the operating
+ * DESCRIPTION:     This task is blocked waiting for a task notification that
+ *                  is sent by the vStepperCallBack function. This task also
+ *                  checks if the buttons task has updated the operating
  *                  parameters for mode and direction.
  * PARAMETER 1:     pointer to a void type for passing task parameters
  * RETURN VALUE:    None
  * NOTES:           The stepper motor speed is not controlled from this task.
- *                  LEDB is toggled each step
+ *                  When configUSE_HR_TIMERS is 1 the steps are taken by
+ *                  vStepperCallBack, and this task only applies parameters.
  * END DESCRIPTION **********************************************************/
 static void prvStepperStep( void *pdata )
 {
-xSTEPPER_PARAMS sm_params;	/* Buffer to receive the SM parameters */
-const unsigned char step_code[8] = {0x0A,0x08,0x09,0x01,0x05,0x04,0x06,0x02};
-unsigned int step_ptr = 0; // Initialize pointer only on power up
-unsigned int sm_output;
-
-/* Initial SM settings until a button is pressed the first time */
-    sm_params.Stepper_period = RPM_15;
-    sm_params.Stepper_Direction = 1;
-    sm_params.Stepper_Mode = 1;
-
-/* Set the timer interval for the initial stepper motor operating step rate */
-    xTimerChangePeriod(T1Handle,sm_params.Stepper_period/portTICK_RATE_MS,0);
+unsigned long events = SM_NEW_PARAMS;  /* Apply the initial settings first */
 
     while(1)
     {
- /* Wait for Timer to give the binary semaphore to take a step */
-        xSemaphoreTake(take_step, portMAX_DELAY);
-
-	LATBINV = LEDB;     /* Signal step */
-/* Accept update from queue if any */
- 	if(uxQueueMessagesWaiting(smQueueHandle)>0)
+/* Accept update from buttons task if any. The critical section also holds
+ * off the high resolution timer interrupt, so a step never sees a partly
+ * updated set of parameters. */
+ 	if(events & SM_NEW_PARAMS)
         {
-/* Update SM Parameters. */
-            xQueueReceive(smQueueHandle, &sm_params, 0);
+            taskENTER_CRITICAL();
+            sm_params = sm_new_params;
+            taskEXIT_CRITICAL();
+#if ( configUSE_HR_TIMERS == 1 )
+/* Starts the timer the first time, then keeps the phase of the steps */
+            xHRTimerChangePeriod(T1Handle, sm_params.Stepper_period);
+#else
             xTimerChangePeriod(T1Handle,
-                        sm_params.Stepper_period/portTICK_RATE_MS, 0);
+                        (sm_params.Stepper_period/1000)/portTICK_RATE_MS, 0);
+#endif
 	}
+
+        if(events & SM_TAKE_STEP)
+        {
+            prvTakeStep();
+        }
+
+ /* Wait for Timer to notify this task to take a step. Any update from the
+  * buttons task is collected at the same time. */
+        xTaskNotifyWait(0, SM_TAKE_STEP | SM_NEW_PARAMS, &events, portMAX_DELAY);
+    }
+} /************************* End of prvStepperStep **************************/
+
+/* prvTakeStep FUNCTION DESCRIPTION ******************************************
+ * SYNTAX:          static void prvTakeStep( void );
+ * KEYWORDS:        Stepper motor step
+ * DESCRIPTION:     Advances the motor one step in the direction and mode
+ *                  given by sm_params. Called by the step task, or from the
+ *                  compare interrupt when configUSE_HR_TIMERS is 1.
+ * RETURN VALUE:    None
+ * NOTES:           LEDB is toggled each step
+ * END DESCRIPTION **********************************************************/
+static void prvTakeStep( void )
+{
+static const unsigned char step_code[8] = {0x0A,0x08,0x09,0x01,0x05,0x04,0x06,0x02};
+static unsigned int step_ptr = 0; // Initialize pointer only on power up
+unsigned int sm_output;
+
+	LATBINV = LEDB;     /* Signal step */
         step_ptr += (sm_params.Stepper_Direction * sm_params.Stepper_Mode);
 
 /* Force step_ptr to be modulo 8 */
@@ -135,27 +221,35 @@ unsigned int sm_output;
  * align the bits to the port-pin connections */
         sm_output = ((unsigned int) step_code[step_ptr]) << SM_SHIFT;
 
-/* Write code to stepper IO using an unprotected read modify write operation */
-        PORTWrite(IOPORT_B, ((LATB & ~((unsigned int)STEPPER_MASK)))\
-                            | sm_output);
-    }
-} /************************* End of prvStepperStep **************************/
+/* Invert only the coil outputs that change. A single write to LATBINV
+ * cannot disturb the other port B pins, even from an interrupt. */
+        LATBINV = (LATB ^ sm_output) & ((unsigned int)STEPPER_MASK);
+} /************************** End of prvTakeStep ****************************/
 
 /* vStepperCallBack FUNCTION DESCRIPTION *************************************
  * SYNTAX:          static void vStepperCallBack(xTimerHandle timerhandle);
  * KEYWORDS:        Timer call back function
  * DESCRIPTION:     The timer call back function is accessed by the RTOS Timer.
- *                  The only thing that happens here is to give a blocking
- *                  semaphore to the SM step task.
+ *                  The only thing that happens here is to notify the SM
+ *                  step task that it is time to take a step.
  *                  to stepper motor task
  * PARAMETER 1:     xTimerHandle timerhandle identifies the particular timer
  *                  that is calling this function it is not used for this
  *                  reference design.
  * RETURN VALUE:    None
+ * NOTES:           When configUSE_HR_TIMERS is 1 this is called from the
+ *                  compare interrupt and takes the step itself.
  * END DESCRIPTION **********************************************************/
+#if ( configUSE_HR_TIMERS == 1 )
+static void vStepperCallBack(xHRTimerHandle timerhandle)
+{
+    prvTakeStep();
+}
+#else
 static void vStepperCallBack(xTimerHandle timerhandle)
 {
-    xSemaphoreGive(take_step);	/* Allow step to be taken */
-} /************************ End of vStepperCallBack *************************/
+    xTaskNotify(StepHandle, SM_TAKE_STEP, eSetBits); /* Allow step to be taken */
+}
+#endif /************************ End of vStepperCallBack *********************/
 
 /*----------------------------- End of stepper.c  --------------------------*/
@@ -16,15 +16,16 @@
     {
 	int Stepper_Direction;
 	int Stepper_Mode;
-	int Stepper_period;
+	int Stepper_period;     /* Step period in microseconds */
     } xSTEPPER_PARAMS;
 
 /* *******  Stepper motor definitions ****** */
     #define HALF_STEPS_PER_REV	200
 
-/* Constant defines the conversion factor from RPM to number of ms per
- * revolution. */
-    #define MSperREV_HS 	60000/HALF_STEPS_PER_REV
+/* Constant defines the conversion factor from RPM to number of us per
+ * half step. The step period is in microseconds so the motor can be
+ * stepped faster than the 1 ms tick. */
+    #define USperREV_HS 	60000000/HALF_STEPS_PER_REV
 
 /* Stepper motor control bits */
     #define STEPPER_MASK    (unsigned int) (BIT_7|BIT_8|BIT_9|BIT_10)
@@ -35,18 +36,18 @@
     #define MOTOR_OFF       0
 
 /* Initial speed */
-    #define RPM_15          MSperREV_HS * FULLSTEP / 15; /* = 40 ms/step */
+    #define RPM_15          USperREV_HS * FULLSTEP / 15; /* = 40 ms/step */
 
 /* Bit allignment for stepper moto coded to IO port */
     #define SM_SHIFT        7   /* Shift constant for stepper motor codes */
 
-/*Communicates control parametes from buttons to stepper motor control */
-    xQueueHandle smQueueHandle;  /* Global variable */
-
 #endif
 
-/* Initializes stepper motor task and queue */
-portBASE_TYPE xStartSTEPPERTask( xQueueHandle *qHandle ); /* Global function */
+/* Initializes stepper motor task and timer */
+portBASE_TYPE xStartSTEPPERTask( void ); /* Global function */
+
+/*Communicates control parametes from buttons to stepper motor control */
+void vSendSTEPPERParams( const xSTEPPER_PARAMS *params ); /* Global function */
 
 /* End of stepper.h */
 
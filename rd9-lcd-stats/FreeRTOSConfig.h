@@ -82,13 +82,13 @@
  *----------------------------------------------------------*/
 
 #define configUSE_PREEMPTION			1
-#define configUSE_PORT_OPTIMISED_TASK_SELECTION	0   /* Do not use for MPLAB X */
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION	1
 #define configUSE_IDLE_HOOK			1
 #define configUSE_TICK_HOOK			0
 #define configTICK_RATE_HZ			( ( portTickType ) 1000 )
 #define configCPU_CLOCK_HZ			( ( unsigned long ) 80000000UL )  
 #define configPERIPHERAL_CLOCK_HZ		( ( unsigned long ) 10000000UL )
-#define configMAX_PRIORITIES			( ( unsigned portBASE_TYPE ) 5 )
+#define configMAX_PRIORITIES			( 5 )	/* No cast, it is tested by the preprocessor. */
 #define configMINIMAL_STACK_SIZE		( 256 )
 #define configISR_STACK_SIZE			( 512 )
 #define configTOTAL_HEAP_SIZE			( ( size_t ) 28000 )
@@ -96,9 +96,14 @@
 #define configUSE_16_BIT_TICKS			0
 #define configIDLE_SHOULD_YIELD			1
 #define configUSE_MUTEXES			1
-#define configCHECK_FOR_STACK_OVERFLOW          2
+#define configCHECK_FOR_STACK_OVERFLOW          3
 #define configQUEUE_REGISTRY_SIZE		0
 
+/* Tickless idle is left off.  The 10 kHz Timer4 interrupt that drives the run
+time statistics, and the 1 kHz Timer3 interrupt, would wake the processor
+before a single tick could be suppressed. */
+#define configUSE_TICKLESS_IDLE			0
+
 /* **************** FreeRTOS V7.5.2 ************ */
 #define configUSE_RECURSIVE_MUTEXES		0
 #define configUSE_MALLOC_FAILED_HOOK		0
@@ -112,9 +117,22 @@
 
     #if configGENERATE_RUN_TIME_STATS == 1
         #define configUSE_TRACE_FACILITY                1
-	#define configUSE_STATS_FORMATTING_FUNCTIONS    1
+	#define configUSE_STATS_FORMATTING_FUNCTIONS    0
 	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() (ulHighFrequencyTimerTicks = 0UL)
 	#define portGET_RUN_TIME_COUNTER_VALUE() ulHighFrequencyTimerTicks
+	/* ulHighFrequencyTimerTicks is 32 bits, so the totals are kept in 64
+	bits.  Each task's load is also averaged over 1, 10 and 60 seconds. */
+	#define configRUN_TIME_COUNTER_TYPE	unsigned long long
+	#define configUSE_CPU_LOAD		1
+	/* The statistics are sent as binary frames for a host to format, so
+	the text formatting functions are left out. */
+	#define configUSE_STATS_STREAM		1
+	/* The stream is built from the task snapshot, so sending a report
+	does not suspend the scheduler.  There are nine tasks, with an entry for
+	each and some spare: Check1, Check2, LCD, COMTx, COMRx, the deferred
+	call workers DCW0 and DCW1, the idle task and the timer task. */
+	#define configUSE_TASK_SNAPSHOT		1
+	#define configTASK_SNAPSHOT_SLOTS	12
     #else
         #define configUSE_TRACE_FACILITY        0
 	#define configUSE_STATS_FORMATTING_FUNCTIONS    0
@@ -127,12 +145,21 @@
 
 /* **************** FreeRTOS V7.5.2 ************ */
 /* Software timer definitions. */
-#define configUSE_TIMERS			0   /* If timers are used */
+#define configUSE_TIMERS			1   /* If timers are used */
 #define configTIMER_TASK_PRIORITY		( 2 )
 #define configTIMER_QUEUE_LENGTH		5
 #define configTIMER_TASK_STACK_DEPTH	( configMINIMAL_STACK_SIZE * 2 )
 /*************************************************/
 
+/* The UART ISR defers setting the Tx idle event bit to a deferred call worker
+task rather than to the timer daemon task.  Tier 0 runs at priority 4 and tier 1
+at priority 3.  The calls are timed with the 40 MHz core timer, as the 10 kHz
+run time stats clock is too coarse to measure them. */
+#define configUSE_DEFERRED_CALLS		1
+#define configDEFERRED_CALL_TIERS		2
+#define configDEFERRED_CALL_QUEUE_LENGTH	8
+#define configDEFERRED_CALL_TIMESTAMP()		( ( unsigned long ) _CP0_GET_COUNT() )
+
 
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
@@ -144,6 +171,7 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelayUntil			1
 #define INCLUDE_vTaskDelay			1
 #define INCLUDE_uxTaskGetStackHighWaterMark	1
+#define INCLUDE_xTimerPendFunctionCall		1   /* Used by event groups */
 
 
 /* **************** FreeRTOS V7.5.2 ************ */
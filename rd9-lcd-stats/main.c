@@ -19,7 +19,9 @@
  * 		is empty.
  *
  * 		When BTN2 is pressed, the statics are sent to the
- * 		serial terminal using a serial Tx queue one line at a time.
+ * 		serial port as binary frames written by
+ * 		xTaskGetStatsStream().  The statsdecode program built by
+ * 		the Posix_GCC project prints them as a table on the host.
  *
  *  Note:   1. FreeRTOSConfig.h must be modified so that the following define
  *            statement in line 111 is set to a 1.
@@ -33,9 +35,9 @@
  *                  extern volatile unsigned long ulHighFrequencyTimerTicks;
  *              #endif
  *
- *          3. A function is required to read the formated statistics buffer
- *             and transfer this text to the UART. See the function
- *             void vReportStatics(void) shown below.
+ *          3. configUSE_STATS_STREAM must be set to 1 in FreeRTOSConfig.h.
+ *             The frames of each report are passed to the UART one at a
+ *             time. See the function void vReportStatics(void) shown below.
  *
  *****************************************************************************/
 
@@ -48,6 +50,7 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
+#include "message_buffer.h"
 
 /* Files to support Application */
 #include "chipKIT_Pro_MX7.h"
@@ -65,6 +68,11 @@
 /* The priorities of the various application tasks. */
 #define mainCHECK_TASK_PRIORITY  ( tskIDLE_PRIORITY + 1 )
 
+/* The most tasks a statistics report can hold. There are nine: Check1,
+ * Check2, LCD, COMTx, COMRx, the deferred call workers DCW0 and DCW1, the
+ * idle task and the timer task. */
+#define mainMAX_REPORTED_TASKS  ( 12 )
+
 xQueueHandle QTask_1_2, QTask_2_1;  /* queue to pass counter back and forth */
 xQueueHandle xlcdQueueHandle;       /* LCD queue */
 
@@ -139,7 +147,7 @@ static char msg[40];
 static xLCDMessage LCD_msg;
 
     strcpy(msg, "\n\rStatistics test ready\n\r");
-    xQueueSend( CommTxQueueHandle, msg, portMAX_DELAY );
+    xSerialPutLine( msg, portMAX_DELAY );
 
     LCD_msg.xMinDisplayTime = 1000 / portTICK_RATE_MS;
     LCD_msg.pcMessage = msg;
@@ -182,9 +190,9 @@ static int pingpong;
         vTaskDelay( 250 / portTICK_RATE_MS ); /* Delay 1/4 second */
         if(PORTG & BTN2)
         {
-            while(uxQueueMessagesWaiting( CommTxQueueHandle)!=0);
+            vSerialWaitForTxIdle();
             vReportStatics();
-            while(uxQueueMessagesWaiting( CommTxQueueHandle)!=0);
+            vSerialWaitForTxIdle();
             while(PORTG & BTN2)
             {
                 taskYIELD();
@@ -197,48 +205,35 @@ static int pingpong;
  * SYNTAX:          static void vReportStatics(void);
  * KEYWORDS:        Statics
  * DESCRIPTION:     Collects RTOS run time statics and sends a report in
- *                  text readable form to the UART
+ *                  binary form to the UART
  * PARAMETERS:      None
  * RETURN VALUE:    None
  * NOTES:           This is a blocking function and will remain here until
- *                  the report has been completely sent. The data must be
- *                  read from the queue before the next line of text is
- *                  transferred into the Txbuffer.
+ *                  the report has been completely sent. The report holds
+ *                  the state, priority, stack high water mark and run time
+ *                  since the previous report of each task, in under half
+ *                  the bytes of the text tables, and no sprintf
+ *                  formatting is done on the target. Each frame is passed
+ *                  to the line send task as one message, so the CR the
+ *                  task adds falls between frames, where the host decoder
+ *                  ignores it. Task names are only sent in the first
+ *                  report and for tasks created since the previous one.
  * END DESCRIPTION *****************************************************/
 
 static void vReportStatics(void)
 {
-#define _LF_    0x0a    /* ASCII line feed  */
-signed char cBuffer[256];  /* Must be sized to contain report (175) */
-char Tx_Message[UART_Q_LEN];
-int buffer_idx = 0;
-int line_idx = 0;
-int buffer_count;
-
-    strcpy(Tx_Message, "\n\rApplication Task Run Time Statistics\n\r");
-    xQueueSend( CommTxQueueHandle, Tx_Message, portMAX_DELAY );
-    while(uxQueueMessagesWaiting( CommTxQueueHandle)!=0);
-    vTaskGetRunTimeStats(cBuffer);
+static xTaskStatsStreamType xStatsStream;   /* Zero before the first report */
+static unsigned char ucReport[tskSTATS_STREAM_BUFFER_SIZE(mainMAX_REPORTED_TASKS)];
+size_t xLength, xOffset, xFrameSize;
+
     LATBSET = LEDA;
-    while(cBuffer[buffer_idx] != 0)
+    xLength = xTaskGetStatsStream( &xStatsStream, ucReport, sizeof(ucReport) );
+    for(xOffset = 0; xOffset < xLength; xOffset += xFrameSize)
     {
-        do
-        {
-            Tx_Message[line_idx++] = cBuffer[buffer_idx++];
-        } while((cBuffer[buffer_idx] != 0) && (cBuffer[buffer_idx-1] != _LF_)
-                 && (line_idx < UART_Q_LEN-1));
-
-        Tx_Message[line_idx] = 0;
-	    xQueueSend( CommTxQueueHandle, Tx_Message, portMAX_DELAY );
-        do
-        {
-            buffer_count = uxQueueMessagesWaiting(CommTxQueueHandle);
-        } while(buffer_count!=0);
-        line_idx = 0;
+        xFrameSize = tskSTATS_FRAME_SIZE( &ucReport[xOffset] );
+        xSerialPutBytes( &ucReport[xOffset], xFrameSize, portMAX_DELAY );
     }
-    strcpy(Tx_Message, "\n\r");
-    xQueueSend( CommTxQueueHandle, Tx_Message, portMAX_DELAY );
-    while(uxQueueMessagesWaiting( CommTxQueueHandle)!=0);
+    vSerialWaitForTxIdle();
     LATBCLR = LEDA;
 }
 /*------------------ End of main for RD9  --------------------------*/
@@ -35,17 +35,57 @@
 #include "FreeRTOS.h"
 #include "queue.h"
 #include "task.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+#include "event_groups.h"
+
+#if ( configUSE_DEFERRED_CALLS == 1 )
+    #include "deferred.h"
+#endif
 
 /* Applicationm include files. */
 #include "serial.h"
 
-/* The queues used to communicate between tasks and ISR's. */
-static xQueueHandle xRxedChars;
-static xQueueHandle xTxedChars;
+/* Receive stream buffer settings. The receive task is woken when
+ * serRX_TRIGGER_LEVEL characters or a CR have been received, rather than for
+ * every character. The block time collects lines that do not end in CR. */
+#define serRX_TRIGGER_LEVEL ( 16 )
+#define serRX_BLOCK_TIME    ( 20 / portTICK_RATE_MS )
+#define serRX_FIFO_DEPTH    ( 8 )   /* Size of the UART receive FIFO */
+
+/* The stream buffers used to communicate between tasks and ISR's. Each has
+ * one writer and one reader, so characters are passed without locking a
+ * queue for every character. */
+static xStreamBufferHandle xRxedChars;
+static xStreamBufferHandle xTxedChars;
+
+/* Size of the message buffers that pass lines to and from the line tasks.
+ * Each line uses only its own length plus a length field, so several short
+ * lines fit where a queue would reserve UART_Q_LEN characters for each. */
+#define serLINE_BUFFER_SIZE ( 2 * UART_Q_LEN )
+
+/* Serialises the tasks that write lines to CommTxQueueHandle. */
+static xSemaphoreHandle xCommTxMutex;
 
 /* Flag used to indicate the tx status. */
 static portBASE_TYPE xTxHasEnded;
 
+/* Event bits used to let tasks block until the UART has finished sending,
+ * instead of polling the transmit buffers. serTX_IDLE_BIT is set by the UART
+ * ISR when the Tx stream buffer is found empty. Setting the bit is deferred
+ * to a task, so the ISR never walks the list of waiting tasks. With
+ * configUSE_DEFERRED_CALLS set to 1 the bit is set by the most urgent
+ * deferred call worker, or by the timer daemon task if that worker's ring is
+ * full. Otherwise it is set by the timer daemon task. */
+static xEventGroupHandle xSerialEvents;
+#define serTX_IDLE_BIT      ( 0x01 )
+
+#if ( configUSE_DEFERRED_CALLS == 1 )
+    #define serDEFERRED_CALL_TIER   ( 0 )
+    static void prvSetTxIdleBit( void *pvParameter1, unsigned long ulParameter2 );
+#endif
+
 /*--------------------------------------------------------------------------*/
 
 void xSerialGetCharTask( void *pvParameters  );
@@ -100,23 +140,27 @@ xComPortHandle xSerialPortInit( unsigned long ulWantedBaud,
 {
 unsigned short usBRG;	// Constant determine by BAUD rate
 
-/* Create the queues used by Send and Received tasks Queue to pass characters
- * from UART interrupt handler to the receive line task - UART_Q_LEN x 1 char */
-    xRxedChars = xQueueCreate( uxQueueLength,
-                        ( unsigned portBASE_TYPE ) sizeof( signed char ) );
+/* Create the stream buffers used by Send and Received tasks. Stream buffer
+ * to pass characters from UART interrupt handler to the receive line task -
+ * UART_Q_LEN chars. A CR wakes the receive task immediately. */
+    xRxedChars = xStreamBufferCreate( uxQueueLength, serRX_TRIGGER_LEVEL );
+    vStreamBufferSetTerminator( xRxedChars, '\r' );
+
+/* Stream buffer to pass string characters form send task to UART
+ * interrupt handler - Q_LEN chars plus a RETURN */
+    xTxedChars = xStreamBufferCreate( (UART_Q_LEN*sizeof( signed char )+1), 1 );
 
-/* Queue to pass characters string characters form send task to UART 
- * interrupt handler - Q_LEN char x 1 */
-    xTxedChars = xQueueCreate( (UART_Q_LEN*sizeof( signed char )+1),
-			( unsigned portBASE_TYPE ) sizeof( signed char ) );
+/* Message buffers to pass lines from the receive line task, and other
+ * tasks, to the send task, and to the serial input processing task -
+ * serLINE_BUFFER_SIZE chars including length fields */
+   CommTxQueueHandle = xMessageBufferCreate( serLINE_BUFFER_SIZE );
+   xCommTxMutex = xSemaphoreCreateMutex();
 
-/* Queue to pass characters from receive line task to the send task
- * - Q_LEN x 1 char */
-   CommTxQueueHandle = xQueueCreate( 5,
-		( unsigned portBASE_TYPE ) UART_Q_LEN*sizeof( signed char ) );
+   CommRxQueueHandle = xMessageBufferCreate( serLINE_BUFFER_SIZE );
 
-   CommRxQueueHandle = xQueueCreate( 5,
-                ( unsigned portBASE_TYPE ) UART_Q_LEN*sizeof( signed char ) );
+/* Nothing has been sent yet, so the transmitter is idle. */
+   xSerialEvents = xEventGroupCreate();
+   xEventGroupSetBits( xSerialEvents, serTX_IDLE_BIT );
 
 // Configure the UART and interrupts.
     usBRG = (unsigned short)(( (float)configPERIPHERAL_CLOCK_HZ \
@@ -136,6 +180,104 @@ unsigned short usBRG;	// Constant determine by BAUD rate
     return NULL;
 } /* End of xSerialPortInitMinima */
 
+/* xSerialPutLine Function Description ****************************************
+ * SYNTAX:          portBASE_TYPE xSerialPutLine( const char *pcLine,
+ *                                              portTickType xTicksToWait );
+ * KEYWORDS:        UART, serial, communications, send, line
+ * DESCRIPTION:     Passes a null terminated text string to the line send
+ *                  task. Only the characters of the string are copied into
+ *                  the CommTxQueueHandle message buffer, not all UART_Q_LEN
+ *                  characters as a queue item would.
+ * PARAMETER 1:     pointer to the null terminated text string
+ * PARAMETER 2:     maximum time to wait for the message buffer, in ticks
+ * RETURN VALUE:    pdPASS if the string was passed, pdFAIL if timed out
+ * NOTES:           This function can be called from any task but not
+ *                  from an ISR. Strings longer than UART_Q_LEN characters
+ *                  are truncated.
+ * END DESCRIPTION ***********************************************************/
+portBASE_TYPE xSerialPutLine( const char *pcLine, portTickType xTicksToWait )
+{
+size_t xLength;
+
+    xLength = strlen( pcLine );
+    if( xLength > UART_Q_LEN )
+    {
+        xLength = UART_Q_LEN;
+    }
+
+    return xSerialPutBytes( pcLine, xLength, xTicksToWait );
+} /* End of xSerialPutLine */
+
+/* xSerialPutBytes Function Description ***************************************
+ * SYNTAX:          portBASE_TYPE xSerialPutBytes( const void *pvData,
+ *                                              size_t xLength,
+ *                                              portTickType xTicksToWait );
+ * KEYWORDS:        UART, serial, communications, send, binary
+ * DESCRIPTION:     Passes xLength bytes, which may include nulls, to the
+ *                  line send task as one message.
+ * PARAMETER 1:     pointer to the bytes to send
+ * PARAMETER 2:     the number of bytes to send, at most UART_Q_LEN
+ * PARAMETER 3:     maximum time to wait for the message buffer, in ticks
+ * RETURN VALUE:    pdPASS if the bytes were passed, pdFAIL if timed out
+ * NOTES:           A message buffer must only have one writer at a time, so
+ *                  writers are serialised by a mutex. The line send task
+ *                  adds a RETURN after each message, so binary data must be
+ *                  framed so the receiver can ignore it. This function can
+ *                  be called from any task but not from an ISR.
+ * END DESCRIPTION ***********************************************************/
+portBASE_TYPE xSerialPutBytes( const void *pvData, size_t xLength,
+                                portTickType xTicksToWait )
+{
+portBASE_TYPE xReturn = pdFAIL;
+
+    configASSERT( xLength <= UART_Q_LEN );
+
+    if( xSemaphoreTake( xCommTxMutex, xTicksToWait ) == pdPASS )
+    {
+        if( xMessageBufferSend( CommTxQueueHandle, pvData, xLength,
+                                xTicksToWait ) == xLength )
+        {
+            xReturn = pdPASS;
+        }
+        xSemaphoreGive( xCommTxMutex );
+    }
+
+    return xReturn;
+} /* End of xSerialPutBytes */
+
+/* vSerialWaitForTxIdle Function Description **********************************
+ * SYNTAX:          void vSerialWaitForTxIdle( void );
+ * KEYWORDS:        UART, serial, communications, send, wait, idle
+ * DESCRIPTION:     Blocks the calling task until every line passed to
+ *                  xSerialPutLine has been handed to the UART. The task
+ *                  waits on serTX_IDLE_BIT rather than polling the message
+ *                  buffer, so it uses no processor time while it waits.
+ * PARAMETERS:      None
+ * RETURN VALUE:    None
+ * NOTES:           The bit is cleared before the buffers are checked, so an
+ *                  ISR that empties the buffers after the check always
+ *                  wakes the task. The bit is set whenever the Tx stream
+ *                  buffer empties, which may happen while lines are still
+ *                  waiting in CommTxQueueHandle, so the buffers are checked
+ *                  again after each wake. Must not be called from an ISR.
+ * END DESCRIPTION ***********************************************************/
+void vSerialWaitForTxIdle( void )
+{
+    for( ;; )
+    {
+        xEventGroupClearBits( xSerialEvents, serTX_IDLE_BIT );
+
+        if( ( xMessageBufferIsEmpty( CommTxQueueHandle ) != pdFALSE ) &&
+            ( xStreamBufferBytesAvailable( xTxedChars ) == 0 ) )
+        {
+            break;
+        }
+
+        xEventGroupWaitBits( xSerialEvents, serTX_IDLE_BIT, pdFALSE, pdTRUE,
+                                portMAX_DELAY );
+    }
+} /* End of vSerialWaitForTxIdle */
+
 /* xSerialGetCharTask Function Description ************************************
  * SYNTAX:          void xSerialGetCharTask( void *pvParameters  );
  * KEYWORDS:        UART, serial, communications, receive, task
@@ -155,40 +297,48 @@ void xSerialGetLineTask( void *pvParameters  )
 ( void ) pvParameters;
 char Rx_Message[UART_Q_LEN]; 	/* Line queue buffer */
 int Rx_Msg_idx;			/* String array index. */
+char Rx_Chars[serRX_TRIGGER_LEVEL];	/* Characters from the ISR */
+size_t Rx_Count, Rx_Idx;
 
     strcpy(Rx_Message,"\n\rUART 1 ready to receive text data.\n\r");
-    xQueueSend( CommTxQueueHandle, &Rx_Message, portMAX_DELAY );
+    xSerialPutLine( Rx_Message, portMAX_DELAY );
 
     Rx_Msg_idx = 0;
-/* Get the next character from the buffer.  Return false if no characters
- * are available or arrive before xBlockTime expires. */
     for(;;)
     {
-	xQueueReceive( xRxedChars, &Rx_Message[Rx_Msg_idx], portMAX_DELAY );
-	if(Rx_Message[Rx_Msg_idx] == '\r' ||
-                        Rx_Message[Rx_Msg_idx]== '\n' ||
-			Rx_Msg_idx == UART_Q_LEN-1 )
-        { /* Complete line received */
-            if(UART_Q_LEN - 3 > Rx_Msg_idx) /* Add CR and LF */
-            {
-                Rx_Message[Rx_Msg_idx++] = '\n';
-                Rx_Message[Rx_Msg_idx++] = '\r';
-            }
-            Rx_Message[Rx_Msg_idx] = 0;     /* Add null termination */
-
-            Rx_Msg_idx = 0;                 /* Reset string index */
+/* Wait for characters from the UART interrupt handler. The task is woken
+ * when serRX_TRIGGER_LEVEL characters or a CR have been received, or the
+ * block time expires. */
+        Rx_Count = xStreamBufferReceive( xRxedChars, Rx_Chars,
+                                        sizeof( Rx_Chars ), serRX_BLOCK_TIME );
+
+        for( Rx_Idx = 0; Rx_Idx < Rx_Count; Rx_Idx++ )
+        {
+            Rx_Message[Rx_Msg_idx] = Rx_Chars[Rx_Idx];
+            if(Rx_Message[Rx_Msg_idx] == '\r' ||
+                            Rx_Message[Rx_Msg_idx]== '\n' ||
+                            Rx_Msg_idx == UART_Q_LEN-1 )
+            { /* Complete line received */
+                if(UART_Q_LEN - 3 > Rx_Msg_idx) /* Add CR and LF */
+                {
+                    Rx_Message[Rx_Msg_idx++] = '\n';
+                    Rx_Message[Rx_Msg_idx++] = '\r';
+                }
+                Rx_Message[Rx_Msg_idx] = 0;     /* Add null termination */
+
+                Rx_Msg_idx = 0;                 /* Reset string index */
 /*  Send message to line send task to display back on the terminal */
-            xQueueSend( CommTxQueueHandle, &Rx_Message[Rx_Msg_idx],\
-                        portMAX_DELAY );
+                xSerialPutLine( Rx_Message, portMAX_DELAY );
 
 /* Send message to the serial input porcessing task */
-            xQueueSend( CommRxQueueHandle, &Rx_Message[Rx_Msg_idx],\
-                        portMAX_DELAY );
-	}
-	else
-	{
-            Rx_Msg_idx++; 	/* Advance string index */
-	}
+                xMessageBufferSend( CommRxQueueHandle, Rx_Message,\
+                            strlen( Rx_Message ), portMAX_DELAY );
+            }
+            else
+            {
+                Rx_Msg_idx++; 	/* Advance string index */
+            }
+        }
     }
 } /* End of xSerialGetCharTask */
 
@@ -196,8 +346,8 @@ int Rx_Msg_idx;			/* String array index. */
  * SYNTAX:          void xSerialLineSendTask( void *pvParameters );
  * KEYWORDS:        UART, serial, communications, send, task
  * DESCRIPTION:     This task recieves a string of text ond or ASCII
- *                  control characters and fills a single character queue.
- *                  After the queue has been filled, the UART transmit interrupt
+ *                  control characters and copies it to the stream buffer.
+ *                  After the string has been copied, the UART transmit interrupt
  *                  is enabled and the interrupt flag is set in initiate
  *                  transmit interrupts.
  * PARAMETER 1:     pointer to data passed from scheduler
@@ -214,17 +364,13 @@ char CR = '\r';
 
     for(;;)
     {
-/* Wait for message */
-	xQueueReceive( CommTxQueueHandle, &Tx_Message, portMAX_DELAY );
-	Tx_Msg_idx = 0;		/* Initialize transmit index */
+/* Wait for message. Only the characters of the line are copied. */
+	Tx_Msg_idx = xMessageBufferReceive( CommTxQueueHandle, Tx_Message,
+                                        sizeof( Tx_Message ), portMAX_DELAY );
 
-/* Fill queue with characters until end of string or maximum queue width */
-	while(Tx_Message[Tx_Msg_idx] && (Tx_Msg_idx < UART_Q_LEN) )
-	{
-            xQueueSend( xTxedChars, &Tx_Message[Tx_Msg_idx], portMAX_DELAY );
-            Tx_Msg_idx++;
-	}
-	xQueueSend( xTxedChars, &CR, portMAX_DELAY ); /* Add RETURN to queue*/
+/* Copy the string to the stream buffer in one call, then add a RETURN */
+	xStreamBufferSend( xTxedChars, Tx_Message, Tx_Msg_idx, portMAX_DELAY );
+	xStreamBufferSend( xTxedChars, &CR, 1, portMAX_DELAY );
 
 	if( xTxHasEnded )			/* Start transmit interrupts */
 	{
@@ -241,14 +387,14 @@ char CR = '\r';
  * KEYWORDS:        UART, serial, communications, interrupt handler
  * DESCRIPTION:     This function is the single UART ISR that handles
  *                  both transmit and receive interrupts.  If a character is
- *                  received, it is immediately send using a queue to the
- *                  that task that assembles the characters into a text string.
+ *                  received, it is immediately send using a stream buffer to
+ *                  the task that assembles the characters into a text string.
  *                  If a Tx interrupt is generated, the Tx buffer status is
  *                  checked. If found to be full, the Tx interrupt flag is
- *                  cleared. If Tx buffer is empty, the queue is check for a
- *                  character waiting to be sent.  If no character is waiting
- *                  in the queue, the Tx interrupts are disabled and the Tx
- *                  interrupt flag is cleared.
+ *                  cleared. If Tx buffer is empty, the stream buffer is check
+ *                  for a character waiting to be sent.  If no character is
+ *                  waiting, the Tx interrupts are disabled, the Tx
+ *                  interrupt flag is cleared and serTX_IDLE_BIT is set.
  * PARAMETERS:      None
  * RETURN VALUE:    None
  * NOTES:           Local variables are declared as static to conserve
@@ -257,6 +403,8 @@ char CR = '\r';
 void __ISR(_UART_1_VECTOR, ipl3) vU1InterruptHandler( void )
 {
 static char cChar;
+static char cRxChars[serRX_FIFO_DEPTH];
+static unsigned char ucRxCount;
 static portBASE_TYPE xHigherPriorityTaskWoken;
 
     xHigherPriorityTaskWoken = pdFALSE;	/* No higher priority tasks */
@@ -264,12 +412,17 @@ static portBASE_TYPE xHigherPriorityTaskWoken;
 /* Are any Rx interrupts pending? */
     if( mU1RXGetIntFlag() )
     {
+/* Empty the receive FIFO, then pass the characters to the receive task with
+ * a single write to the stream buffer. */
         while( U1STAbits.URXDA )
 	{
-/* Retrieve the received character and place it in the queue of
- * received characters.*/
-            cChar = U1RXREG;
-            xQueueSendFromISR( xRxedChars, &cChar, &xHigherPriorityTaskWoken );
+            ucRxCount = 0;
+            while( U1STAbits.URXDA && ( ucRxCount < serRX_FIFO_DEPTH ) )
+            {
+                cRxChars[ucRxCount++] = U1RXREG;
+            }
+            xStreamBufferSendFromISR( xRxedChars, cRxChars, ucRxCount,
+                                        &xHigherPriorityTaskWoken );
 	}
 	mU1RXClearIntFlag();
     }
@@ -279,19 +432,36 @@ static portBASE_TYPE xHigherPriorityTaskWoken;
     {
         while( !( U1STAbits.UTXBF ) )
 	{
-            if( xQueueReceiveFromISR( xTxedChars, &cChar,
-                                &xHigherPriorityTaskWoken ) == pdTRUE )
+            if( xStreamBufferReceiveFromISR( xTxedChars, &cChar, 1,
+                                &xHigherPriorityTaskWoken ) == 1 )
             {
 /* Send the next character queued for Tx. */
 		U1TXREG = cChar;
             }
             else
             {
-/* Queue empty, nothing to send. */
+/* Stream buffer empty, nothing to send. */
 		DisableIntU1TX;		/* Disable interrupts */
 
 /* Flag signals that Tx interrupts must be enabled */
 		xTxHasEnded = pdTRUE;	
+
+/* Wake any task waiting for the transmitter to go idle. A task sets the
+ * bit, so the time spent here does not depend on the number of waiting
+ * tasks. */
+#if ( configUSE_DEFERRED_CALLS == 1 )
+		if( xDeferredCallPendFromISR( serDEFERRED_CALL_TIER, prvSetTxIdleBit,
+                        NULL, 0UL, &xHigherPriorityTaskWoken ) != pdPASS )
+		{
+/* The tier 0 ring is full. Have the timer daemon set the bit instead, so
+ * the waiting tasks are not left blocked. */
+		    xEventGroupSetBitsFromISR( xSerialEvents, serTX_IDLE_BIT,
+                                            &xHigherPriorityTaskWoken );
+		}
+#else
+		xEventGroupSetBitsFromISR( xSerialEvents, serTX_IDLE_BIT,
+                                            &xHigherPriorityTaskWoken );
+#endif
 		break; // from while
             }
 	}
@@ -301,4 +471,24 @@ static portBASE_TYPE xHigherPriorityTaskWoken;
     portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
 } /* End of vU1InterruptHandler */
 
+#if ( configUSE_DEFERRED_CALLS == 1 )
+/* prvSetTxIdleBit Function Description **************************************
+ * SYNTAX:          static void prvSetTxIdleBit( void *pvParameter1,
+ *                                          unsigned long ulParameter2 );
+ * KEYWORDS:        UART, serial, deferred call, idle
+ * DESCRIPTION:     Sets serTX_IDLE_BIT on behalf of vU1InterruptHandler,
+ *                  waking every task waiting in vSerialWaitForTxIdle.
+ * PARAMETERS:      Not used
+ * RETURN VALUE:    None
+ * NOTES:           Executes in the tier 0 deferred call worker task.
+ * END DESCRIPTION ***********************************************************/
+static void prvSetTxIdleBit( void *pvParameter1, unsigned long ulParameter2 )
+{
+    ( void ) pvParameter1;
+    ( void ) ulParameter2;
+
+    xEventGroupSetBits( xSerialEvents, serTX_IDLE_BIT );
+} /* End of prvSetTxIdleBit */
+#endif
+
 /* End of serial.c */
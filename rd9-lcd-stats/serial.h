@@ -74,8 +74,8 @@
     #define serCLR_FLAG		( 0 )
 
     #define UART_Q_LEN		120
-    xQueueHandle CommTxQueueHandle; /* Queue for sending UART messages */
-    xQueueHandle CommRxQueueHandle; /* Queue for receiving UART messages */
+    xMessageBufferHandle CommTxQueueHandle; /* Sending UART messages */
+    xMessageBufferHandle CommRxQueueHandle; /* Receiving UART messages */
 
 #endif
 
@@ -84,6 +84,10 @@ portBASE_TYPE xStartUARTTasks( unsigned portBASE_TYPE uxPriority,
                                 unsigned long ulBaudRate );
 void xSerialGetLineTask( void *pvParameters  );
 void xSerialSendLineTask( void *pvParameters );
+portBASE_TYPE xSerialPutLine( const char *pcLine, portTickType xTicksToWait );
+portBASE_TYPE xSerialPutBytes( const void *pvData, size_t xLength,
+                                portTickType xTicksToWait );
+void vSerialWaitForTxIdle( void );
 xComPortHandle xSerialPortInit( unsigned long ulWantedBaud,
                                 unsigned portBASE_TYPE uxQueueLength );
 